@@ -0,0 +1,196 @@
+#include "app_start.h"
+#include "ao_profile.h"
+#include "app_event_pools.h"
+#include "blinky.h"
+#include "box_to_box.h"
+#include "bsp.h"
+#include "config.h"
+#include "log_com.h"
+#include "pc_com.h"
+#include "director.h"
+#include "event_watermarks.h"
+#include "fram.h"
+#include "posted_signals.h"
+#include "qpc.h"
+#include "shared_i2c.h"
+#include "shared_i2c_events.h"
+#include "usb.h"
+#include <assert.h>
+#include <stddef.h>
+
+/**************************************************************************************************\
+* Private type definitions
+\**************************************************************************************************/
+
+// QP Priorities for Active Objects must be unique
+// Lower number is lower priority
+// 0 is reserved, lowest available is 1
+typedef enum
+{
+    AO_RESERVED = 0U,
+    AO_PRIO_BLINKY,
+    AO_PRIO_PC_COM,
+    AO_PRIO_CONFIG,
+    AO_PRIO_FRAM,
+    AO_PRIO_LOG_COM,
+    AO_PRIO_DIRECTOR,
+    AO_PRIO_SHARED_I2C2,
+    AO_PRIO_BOX_TO_BOX,
+    AO_PRIO_USB,
+} AO_Priority_T;
+
+static_assert(QF_MAX_EPOOL >= 3U, "QF_MAX_EPOOL too small for the small, medium and large pools");
+static_assert(APP_SMALL_POOL_BLOCKS > 0U, "no event in the small pool");
+static_assert(APP_MEDIUM_POOL_BLOCKS > 0U, "no event in the medium pool");
+static_assert(APP_LARGE_POOL_BLOCKS > 0U, "no event in the large pool");
+
+/**************************************************************************************************\
+* Private memory declarations
+\**************************************************************************************************/
+
+extern const QActive *AO_SharedI2C2; // constructed in BSP_Init
+
+// the AOs by priority, as the ao-profile command and PC_COM name them
+static const char *const ao_names[] = {
+    [AO_PRIO_BLINKY]      = "blinky",
+    [AO_PRIO_PC_COM]      = "pc_com",
+    [AO_PRIO_CONFIG]      = "config",
+    [AO_PRIO_FRAM]        = "fram",
+    [AO_PRIO_LOG_COM]     = "log_com",
+    [AO_PRIO_DIRECTOR]    = "director",
+    [AO_PRIO_SHARED_I2C2] = "shared_i2c2",
+    [AO_PRIO_BOX_TO_BOX]  = "box_to_box",
+    [AO_PRIO_USB]         = "usb",
+};
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+/**
+ ***************************************************************************************************
+ * @brief   Initialize the event pools and publish-subscribe, then construct and start the AOs.
+ *          Call after QF_init() and BSP_Init(), then QF_run().
+ **************************************************************************************************/
+void App_Start(void)
+{
+    // initialize event pools, smallest events first
+    static QF_MPOOL_EL(Small_Pool_Event_T) smallPoolSto[APP_SMALL_POOL_BLOCKS];
+    QF_poolInit(smallPoolSto, sizeof(smallPoolSto), sizeof(smallPoolSto[0]));
+
+    static QF_MPOOL_EL(Medium_Pool_Event_T) mediumPoolSto[APP_MEDIUM_POOL_BLOCKS];
+    QF_poolInit(mediumPoolSto, sizeof(mediumPoolSto), sizeof(mediumPoolSto[0]));
+
+    static QF_MPOOL_EL(Large_Pool_Event_T) largePoolSto[APP_LARGE_POOL_BLOCKS];
+    QF_poolInit(largePoolSto, sizeof(largePoolSto), sizeof(largePoolSto[0]));
+
+    // initialize publish-subscribe
+    static QSubscrList subscrSto[PUBSUB_MAX_SIG];
+    QActive_psInit(subscrSto, Q_DIM(subscrSto));
+
+    // instantiate and start AOs/threads...
+
+    static QEvt const *blinkyQueueSto[10];
+    Blinky_ctor();
+    QACTIVE_START(
+        AO_Blinky,
+        AO_PRIO_BLINKY,        // QP prio. of the AO
+        blinkyQueueSto,        // event queue storage
+        Q_DIM(blinkyQueueSto), // queue length [events]
+        (void *) 0,
+        0U,          // no stack storage
+        (void *) 0); // no initialization param
+
+    static QEvt const *shared_i2c2_QueueSto[10];
+    QACTIVE_START(
+        AO_SharedI2C2,
+        AO_PRIO_SHARED_I2C2,         // QP prio. of the AO
+        shared_i2c2_QueueSto,        // event queue storage
+        Q_DIM(shared_i2c2_QueueSto), // queue length [events]
+        (void *) 0,                  // stack storage (not used in QK)
+        0U,                          // stack size [bytes] (not used in QK)
+        (void *) 0);                 // no initialization param
+
+    static QEvt const *pc_com_QueueSto[10];
+    PC_COM_ctor(BSP_Get_Serial_IO_Interface_USB0(), Box_To_Box_Get_Tunnel_IO());
+    QACTIVE_START(
+        AO_PC_COM,
+        AO_PRIO_PC_COM,         // QP prio. of the AO
+        pc_com_QueueSto,        // event queue storage
+        Q_DIM(pc_com_QueueSto), // queue length [events]
+        (void *) 0,             // stack storage (not used in QK)
+        0U,                     // stack size [bytes] (not used in QK)
+        (void *) 0);            // no initialization param
+
+    static QEvt const *log_com_QueueSto[20];
+    LogCom_ctor(BSP_Get_Serial_IO_Interface_USB1());
+    QACTIVE_START(
+        AO_LogCom,
+        AO_PRIO_LOG_COM,         // QP prio. of the AO
+        log_com_QueueSto,        // event queue storage
+        Q_DIM(log_com_QueueSto), // queue length [events]
+        (void *) 0,              // stack storage (not used in QK)
+        0U,                      // stack size [bytes] (not used in QK)
+        (void *) 0);             // no initialization param
+
+    static QEvt const *config_QueueSto[10];
+    Config_ctor();
+    QACTIVE_START(
+        AO_Config,
+        AO_PRIO_CONFIG,         // QP prio. of the AO
+        config_QueueSto,        // event queue storage
+        Q_DIM(config_QueueSto), // queue length [events]
+        (void *) 0,
+        0U,
+        (void *) 0);
+
+    static QEvt const *fram_QueueSto[10];
+    Fram_ctor(BSP_Get_I2C_Write_FRAM(), BSP_Get_I2C_Memory_Read_FRAM());
+    QACTIVE_START(
+        AO_Fram,
+        AO_PRIO_FRAM,         // QP prio. of the AO
+        fram_QueueSto,        // event queue storage
+        Q_DIM(fram_QueueSto), // queue length [events]
+        (void *) 0,
+        0U,
+        (void *) 0);
+
+    static QEvt const *box_to_box_QueueSto[20];
+    Box_To_Box_ctor();
+    QACTIVE_START(
+        AO_BOX_TO_BOX,
+        AO_PRIO_BOX_TO_BOX,         // QP prio. of the AO
+        box_to_box_QueueSto,        // event queue storage
+        Q_DIM(box_to_box_QueueSto), // queue length [events]
+        (void *) 0,                 // stack storage (not used in QK)
+        0U,                         // stack size [bytes] (not used in QK)
+        (void *) 0);                // no initialization param
+
+    static QEvt const *directorQueueSto[10];
+    Director_ctor();
+    QACTIVE_START(
+        AO_DIRECTOR,
+        AO_PRIO_DIRECTOR,        // QP prio. of the AO
+        directorQueueSto,        // event queue storage
+        Q_DIM(directorQueueSto), // queue length [events]
+        (void *) 0,
+        0U,          // no stack storage
+        (void *) 0); // no initialization param
+
+    static QEvt const *usb_QueueSto[10];
+    USB_ctor();
+    QACTIVE_START(
+        AO_USB,
+        AO_PRIO_USB,         // QP prio. of the AO
+        usb_QueueSto,        // event queue storage
+        Q_DIM(usb_QueueSto), // queue length [events]
+        (void *) 0,          // stack storage (not used in QK)
+        0U,                  // stack size [bytes] (not used in QK)
+        (void *) 0);         // no initialization param
+
+    // time every AO's run to completion steps from here on
+    AO_Profile_Start(ao_names, Q_DIM(ao_names));
+
+    // watch the event pools and every AO's queue for how close they come to running out
+    Event_Watermarks_Start(ao_names, Q_DIM(ao_names));
+}
@@ -0,0 +1,23 @@
+#ifndef APP_START_H_
+#define APP_START_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************************************************\
+* Public prototypes
+\**************************************************************************************************/
+
+/**
+ ***************************************************************************************************
+ * @brief   Event pools, publish-subscribe and every AO of the application, started the same way on
+ *          the board (main.c) and in the host simulation (sim/)
+ **************************************************************************************************/
+void App_Start(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // APP_START_H_
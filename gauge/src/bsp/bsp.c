@@ -1,4 +1,7 @@
 #include "bsp.h" // Board Support Package
+#include "can_bit_timing.h"
+#include "can_messages.h"
+#include "cpu_load.h"
 #include "halt_if_debugging.h"
 #include "i2c_bus_stm32.h"
 #include "main.h"
@@ -21,14 +24,29 @@ Q_DEFINE_THIS_MODULE("bsp.c")
 #define SHARED_I2C_BUS_2_DEFERRED_QUEUE_LEN 3
 #define AVREF                               2.895
 
+// FDCAN timestamp counter unit in nominal bit times, its 16 bits wrap after 466 ms at 2.25 Mbit/s
+#define CAN_TIMESTAMP_PRESCALER 16U
+
+// writes remembered for the TX event FIFO, more than the 3 TX buffers
+#define CAN_TX_STAMPS 8U
+
 /**************************************************************************************************\
 * Private type definitions
 \**************************************************************************************************/
 
+// when a frame went to the TX FIFO, matched up with its TX event by the message marker
+typedef struct
+{
+    uint8_t marker;
+    uint16_t timestamp; // FDCAN timestamp counter
+    uint64_t write_us;  // BSP_Get_Microseconds(), for writes older than the counter wraps
+} CAN_Tx_Stamp_T;
+
 /**************************************************************************************************\
 * Private prototypes
 \**************************************************************************************************/
 
+static uint64_t can_timestamp_tick_ns(void);
 static uint16_t USB0_TransmitData(const uint8_t *data_ptr, const uint16_t data_len);
 static uint16_t USB0_ReceiveData(uint8_t *data_ptr, const uint16_t max_data_len);
 static void USB0_RegisterDataReadyCB(Serial_IO_Data_Ready_Callback cb, void *cb_data);
@@ -67,6 +85,9 @@ extern DAC_HandleTypeDef hdac3;
 extern OPAMP_HandleTypeDef hopamp1;
 extern TIM_HandleTypeDef htim8;
 extern FDCAN_HandleTypeDef hfdcan2; // defined in main.c by cubeMX
+static bool s_can_brs;              // frames go out with the data phase at CAN_DATA_BITRATE_BPS
+static CAN_Tx_Stamp_T s_can_tx_stamps[CAN_TX_STAMPS]; // indexed by message marker
+static uint8_t s_can_tx_marker;                       // marker of the next frame written
 static I2C_Bus_T s_i2c_bus2;
 
 static SharedI2C_T SharedI2C_Bus2;
@@ -199,16 +220,144 @@ int32_t BSP_CAN_Write_Msg(const CAN_Message_T *msg)
     TxHeader.TxFrameType         = FDCAN_DATA_FRAME;
     TxHeader.DataLength          = (uint32_t) msg->dlc;
     TxHeader.ErrorStateIndicator = FDCAN_ESI_ACTIVE;
-    TxHeader.BitRateSwitch       = FDCAN_BRS_OFF;
+    TxHeader.BitRateSwitch       = s_can_brs ? FDCAN_BRS_ON : FDCAN_BRS_OFF;
     TxHeader.FDFormat            = FDCAN_FD_CAN;
-    TxHeader.TxEventFifoControl  = FDCAN_NO_TX_EVENTS;
-    TxHeader.MessageMarker       = 0;
+    TxHeader.TxEventFifoControl  = FDCAN_STORE_TX_EVENTS;
+    TxHeader.MessageMarker       = s_can_tx_marker;
+
+    // stamped before the request, the frame can start as soon as it is added
+    CAN_Tx_Stamp_T *stamp = &s_can_tx_stamps[s_can_tx_marker % CAN_TX_STAMPS];
+    stamp->marker         = s_can_tx_marker;
+    stamp->timestamp      = HAL_FDCAN_GetTimestampCounter(&hfdcan2);
+    stamp->write_us       = BSP_Get_Microseconds();
 
     retval = HAL_FDCAN_AddMessageToTxFifoQ(&hfdcan2, &TxHeader, msg->data);
+    if (retval == HAL_OK)
+    {
+        s_can_tx_marker++;
+    }
 
     return (int32_t) retval;
 }
 
+void BSP_CAN_Get_Bus_Status(CAN_Bus_Status_T *status)
+{
+    FDCAN_ProtocolStatusTypeDef protocol_status;
+    FDCAN_ErrorCountersTypeDef error_counters;
+
+    // PSR and ECR
+    HAL_FDCAN_GetProtocolStatus(&hfdcan2, &protocol_status);
+    HAL_FDCAN_GetErrorCounters(&hfdcan2, &error_counters);
+
+    if (protocol_status.BusOff)
+    {
+        status->state = CAN_BUS_STATE_OFF;
+    }
+    else if (protocol_status.ErrorPassive)
+    {
+        status->state = CAN_BUS_STATE_PASSIVE;
+    }
+    else if (protocol_status.Warning)
+    {
+        status->state = CAN_BUS_STATE_WARNING;
+    }
+    else
+    {
+        status->state = CAN_BUS_STATE_ACTIVE;
+    }
+
+    // reading ECR clears CEL and reading PSR resets LEC and DLEC to "no change", the
+    // FDCAN_PROTOCOL_ERROR_* codes are the CAN_ERROR_* values
+    status->tx_errors       = (uint8_t) error_counters.TxErrorCnt;
+    status->rx_errors       = (uint8_t) error_counters.RxErrorCnt;
+    status->errors_logged   = (uint8_t) error_counters.ErrorLogging;
+    status->last_error      = (CAN_Error_Code_T) protocol_status.LastErrorCode;
+    status->data_last_error = (CAN_Error_Code_T) protocol_status.DataLastErrorCode;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Take the oldest event out of the TX event FIFO, false if it is empty. The time the
+ *          frame waited is measured with the FDCAN timestamp counter, from the write to the start
+ *          of frame the FDCAN stored with the event.
+ **************************************************************************************************/
+bool BSP_CAN_Read_Tx_Event(CAN_Tx_Event_T *event)
+{
+    FDCAN_TxEventFifoTypeDef tx_event;
+
+    if (HAL_FDCAN_GetTxEvent(&hfdcan2, &tx_event) != HAL_OK)
+    {
+        return false;
+    }
+
+    event->id      = tx_event.Identifier;
+    event->dlc     = tx_event.DataLength;
+    event->sent_us = CAN_TIMESTAMP_UNKNOWN;
+
+    const CAN_Tx_Stamp_T *stamp = &s_can_tx_stamps[tx_event.MessageMarker % CAN_TX_STAMPS];
+    if (stamp->marker != (uint8_t) tx_event.MessageMarker)
+    {
+        // overwritten by later writes, the event was read too late
+        event->queued_us = CAN_TX_QUEUED_UNKNOWN;
+        return true;
+    }
+
+    uint64_t tick_ns     = can_timestamp_tick_ns();
+    uint64_t wrap_us     = (tick_ns * 0x10000U) / 1000U;
+    uint64_t elapsed_us  = BSP_Get_Microseconds() - stamp->write_us;
+    uint16_t queued_tick = (uint16_t) (tx_event.TxTimestamp - stamp->timestamp);
+
+    if (elapsed_us >= wrap_us)
+    {
+        // the counter may have wrapped, all we know is the frame started before now
+        event->queued_us = (uint32_t) elapsed_us;
+        return true;
+    }
+
+    event->queued_us = (uint32_t) ((queued_tick * tick_ns) / 1000U);
+    event->sent_us   = stamp->write_us + event->queued_us;
+    return true;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Place an FDCAN timestamp (RX element or TX event) on the BSP_Get_Microseconds() clock.
+ *          The counter wraps after 466 ms, the frame must be more recent than that.
+ **************************************************************************************************/
+uint64_t BSP_CAN_Timestamp_To_Us(uint16_t timestamp)
+{
+    uint16_t now_tick = (uint16_t) HAL_FDCAN_GetTimestampCounter(&hfdcan2);
+    uint64_t now_us   = BSP_Get_Microseconds();
+    uint16_t ticks    = (uint16_t) (now_tick - timestamp);
+
+    return now_us - ((ticks * can_timestamp_tick_ns()) / 1000U);
+}
+
+void BSP_CAN_Get_Bit_Rates(CAN_Bit_Rates_T *rates)
+{
+    rates->nominal_bps = CAN_KERNEL_CLOCK_HZ /
+                         (hfdcan2.Init.NominalPrescaler *
+                          (1U + hfdcan2.Init.NominalTimeSeg1 + hfdcan2.Init.NominalTimeSeg2));
+    rates->data_bps = s_can_brs ? CAN_DATA_BITRATE_BPS : rates->nominal_bps;
+    rates->brs      = s_can_brs;
+}
+
+void BSP_CAN_Disable_Bit_Rate_Switch(void)
+{
+    s_can_brs = false;
+
+    // frames already in the TX buffers would keep retrying with BRS, the queue has newer values
+    (void) HAL_FDCAN_AbortTxRequest(
+        &hfdcan2, FDCAN_TX_BUFFER0 | FDCAN_TX_BUFFER1 | FDCAN_TX_BUFFER2);
+}
+
+void BSP_CAN_Bus_Recover(void)
+{
+    // on bus-off the FDCAN sets CCCR.INIT and stops, clearing it starts the recovery sequence.
+    // The HAL state stays busy throughout, so the filters and notifications are kept.
+    CLEAR_BIT(hfdcan2.Instance->CCCR, FDCAN_CCCR_INIT);
+}
+
 /**
  ***************************************************************************************************
  * @brief   QP Assert handler
@@ -273,7 +422,9 @@ void SysTick_Handler(void)
 {
     QK_ISR_ENTRY();
     HAL_IncTick();
-    QTIMEEVT_TICK(0U); // process time events for primary clock rate
+    (void) BSP_Get_Cycle_Count_64(); // keep the 64-bit cycle count from missing a CYCCNT wrap
+    CPU_Load_Tick();                 // close a CPU load window every 100 ms
+    QTIMEEVT_TICK(0U);               // process time events for primary clock rate
     QK_ISR_EXIT();
 }
 
@@ -301,18 +452,65 @@ void BSP_CAN_Bus_Init(void)
 {
     FDCAN_FilterTypeDef sFilterConfig;
     HAL_StatusTypeDef retval;
+    uint32_t filter_index = 0U;
+
+    Q_ASSERT(HAL_RCCEx_GetPeriphCLKFreq(RCC_PERIPHCLK_FDCAN) == CAN_KERNEL_CLOCK_HZ);
+
+#if CAN_DATA_BITRATE_BPS != 0
+    // CubeMX only sets up the nominal rate, re-initialise with the data phase timing before any
+    // filter is configured since this clears the message RAM layout
+    hfdcan2.Init.FrameFormat       = FDCAN_FRAME_FD_BRS;
+    hfdcan2.Init.DataPrescaler     = CAN_DATA_PRESCALER;
+    hfdcan2.Init.DataSyncJumpWidth = CAN_DATA_SYNC_JUMP_W;
+    hfdcan2.Init.DataTimeSeg1      = CAN_DATA_TIME_SEG1;
+    hfdcan2.Init.DataTimeSeg2      = CAN_DATA_TIME_SEG2;
+
+    retval = HAL_FDCAN_Init(&hfdcan2);
+    Q_ASSERT(retval == HAL_OK);
 
-    // Configure Rx filter
-    sFilterConfig.IdType       = FDCAN_STANDARD_ID;
-    sFilterConfig.FilterIndex  = 0;
-    sFilterConfig.FilterType   = FDCAN_FILTER_MASK;
-    sFilterConfig.FilterConfig = FDCAN_FILTER_TO_RXFIFO0;
-    sFilterConfig.FilterID1    = 0x00000001U; // id = don't care
-    sFilterConfig.FilterID2    = 0x00000000U; // mask = allow all (don't compare any ID)
+    retval = HAL_FDCAN_ConfigTxDelayCompensation(
+        &hfdcan2, CAN_DATA_TDC_OFFSET, CAN_DATA_TDC_FILTER);
+    Q_ASSERT(retval == HAL_OK);
+
+    retval = HAL_FDCAN_EnableTxDelayCompensation(&hfdcan2);
+    Q_ASSERT(retval == HAL_OK);
+
+    s_can_brs = true;
+#endif
 
-    retval = HAL_FDCAN_ConfigFilter(&hfdcan2, &sFilterConfig);
+    // time base of the TX event (and RX) timestamps, in units of CAN_TIMESTAMP_PRESCALER bits
+    retval = HAL_FDCAN_ConfigTimestampCounter(&hfdcan2, FDCAN_TIMESTAMP_PRESC_16);
     Q_ASSERT(retval == HAL_OK);
 
+    retval = HAL_FDCAN_EnableTimestampCounter(&hfdcan2, FDCAN_TIMESTAMP_INTERNAL);
+    Q_ASSERT(retval == HAL_OK);
+
+    // Configure Rx filters, one exact match element per message this board accepts. High priority
+    // messages get FIFO0 to themselves, everything else shares FIFO1.
+    for (uint32_t i = 0U; i < CAN_MSG_COUNT; i++)
+    {
+        if ((CAN_Msg_Info[i].rx_boards & CAN_RX_THIS_BOARD) == 0U)
+        {
+            continue;
+        }
+
+        Q_ASSERT(filter_index < hfdcan2.Init.StdFiltersNbr);
+
+        sFilterConfig.IdType       = FDCAN_STANDARD_ID;
+        sFilterConfig.FilterIndex  = filter_index;
+        sFilterConfig.FilterType   = FDCAN_FILTER_MASK;
+        sFilterConfig.FilterConfig = (CAN_Msg_Info[i].rx_prio == CAN_RX_PRIO_HIGH)
+                                         ? FDCAN_FILTER_TO_RXFIFO0
+                                         : FDCAN_FILTER_TO_RXFIFO1;
+        sFilterConfig.FilterID1    = CAN_Msg_Info[i].id;
+        sFilterConfig.FilterID2    = 0x7FFU; // mask = compare every ID bit
+
+        retval = HAL_FDCAN_ConfigFilter(&hfdcan2, &sFilterConfig);
+        Q_ASSERT(retval == HAL_OK);
+
+        filter_index++;
+    }
+
     // Configure global filter:
     // Filter all remote frames with STD and EXT ID
     // Reject non matching frames with STD ID and EXT ID
@@ -324,7 +522,12 @@ void BSP_CAN_Bus_Init(void)
     retval = HAL_FDCAN_Start(&hfdcan2);
     Q_ASSERT(retval == HAL_OK);
 
-    retval = HAL_FDCAN_ActivateNotification(&hfdcan2, FDCAN_IT_RX_FIFO0_NEW_MESSAGE, 0);
+    retval = HAL_FDCAN_ActivateNotification(
+        &hfdcan2,
+        FDCAN_IT_RX_FIFO0_NEW_MESSAGE | FDCAN_IT_RX_FIFO0_MESSAGE_LOST |
+            FDCAN_IT_RX_FIFO1_NEW_MESSAGE | FDCAN_IT_RX_FIFO1_MESSAGE_LOST | FDCAN_IT_TX_COMPLETE |
+            FDCAN_IT_BUS_OFF | FDCAN_IT_ERROR_PASSIVE,
+        FDCAN_TX_BUFFER0 | FDCAN_TX_BUFFER1 | FDCAN_TX_BUFFER2);
     Q_ASSERT(retval == HAL_OK);
 }
 
@@ -364,6 +567,14 @@ void BSP_Init(void)
     // initialize TinyUSB device stack on configured roothub port
     tud_init(BOARD_TUD_RHPORT);
 
+    BSP_Cycle_Counter_Init();
+    CPU_Load_Start();
+#if CPU_LOAD_WFI
+    // keep the core clock, and with it the DWT cycle counter the timestamps and the CPU load run
+    // on, going through the idle loop's sleeps
+    DBGMCU->CR |= DBGMCU_CR_DBG_SLEEP;
+#endif
+
     // --- Start DAC1 external outputs ---
     retval = HAL_DAC_Start(&hdac1, DAC_CHANNEL_1); // DAC1_OUT1
     Q_ASSERT(retval == HAL_OK);
@@ -445,7 +656,22 @@ void QF_onCleanup(void)
 }
 //............................................................................
 void QK_onIdle(void)
-{ // called with interrupts DISABLED, see NOTE01
+{ // called with interrupts enabled, over and over while no AO has events to process
+    QF_INT_DISABLE();
+    uint32_t start = BSP_Get_Cycle_Count();
+
+#if CPU_LOAD_WFI
+    // BASEPRI masks the QF-aware interrupts, which then wouldn't wake the core. With PRIMASK set
+    // instead the next interrupt wakes it, but is only taken once its sleep is counted.
+    __disable_irq();
+    QF_INT_ENABLE();
+    __WFI();
+    CPU_Load_Idle(start, BSP_Get_Cycle_Count());
+    __enable_irq();
+#else
+    CPU_Load_Idle(start, start);
+    QF_INT_ENABLE();
+#endif
 }
 
 /*****************************************************************************
@@ -523,6 +749,18 @@ static I2C_Return_T BSP_I2C_Memory_Read_FRAM(
         cb_data);
 }
 
+/**
+ ***************************************************************************************************
+ * @brief   Length of an FDCAN timestamp counter tick, CAN_TIMESTAMP_PRESCALER nominal bit times
+ **************************************************************************************************/
+static uint64_t can_timestamp_tick_ns(void)
+{
+    CAN_Bit_Rates_T rates;
+
+    BSP_CAN_Get_Bit_Rates(&rates);
+    return (CAN_TIMESTAMP_PRESCALER * 1000000000ULL) / rates.nominal_bps;
+}
+
 /**
  ***************************************************************************************************
  *  @brief   Functions for USB
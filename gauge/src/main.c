@@ -22,81 +22,16 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 
-#include "blinky.h"
-#include "box_to_box.h"
+#include "app_start.h"
 #include "bsp.h"
-#include "config.h"
-#include "log_com.h"
-#include "pc_com.h"
-#include "director.h"
-#include "fram.h"
-#include "posted_signals.h"
 #include "qpc.h"
 #include "reset.h"
-#include "shared_i2c.h"
-#include "shared_i2c_events.h"
-#include "usb.h"
-#include <stdbool.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
 
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
 /* USER CODE BEGIN PTD */
 
-// QP Priorities for Active Objects must be unique
-// Lower number is lower priority
-// 0 is reserved, lowest available is 1
-typedef enum
-{
-    AO_RESERVED = 0U,
-    AO_PRIO_BLINKY,
-    AO_PRIO_PC_COM,
-    AO_PRIO_CONFIG,
-    AO_PRIO_FRAM,
-    AO_PRIO_LOG_COM,
-    AO_PRIO_DIRECTOR,
-    AO_PRIO_SHARED_I2C2,
-    AO_PRIO_BOX_TO_BOX,
-    AO_PRIO_USB,
-} AO_Priority_T;
-
-extern const QActive *AO_SharedI2C2;
-
-typedef struct
-{
-    union
-    {
-        QEvt base_event;
-        FloatEvent_T float_event;
-    } small_messages;
-} SmallMessageUnion_T;
-typedef struct
-{
-    union
-    {
-        QEvt someMultipleQEvt[4];
-        PCCOMPrintEvent_T pc_com_print_event;
-        PCCOMCliDataEvent_T pc_com_cli_data_event;
-        DebugForceFaultEvent_T fault_event;
-        FramReadReqEvent_T fram_read_req_event;
-        ConfigEntryChangedEvent_T config_entry_changed_event;
-    } medium_messages;
-} MediumMessageUnion_T;
-typedef struct
-{
-    union
-    {
-        QEvt base_event;
-        FaultGeneratedEvent_T fault_event;
-        CAN_Message_Received_Event_T can_event;
-        FramReadRespEvent_T fram_read_resp_event;
-        FramWriteReqEvent_T fram_write_req_event;
-    } large_messages;
-} LongMessageUnion_T;
-
 /* USER CODE END PTD */
 
 /* Private define ------------------------------------------------------------*/
@@ -193,127 +128,7 @@ int main(void)
     (void) priority; // be sure to set your QP aware interrupt priority in Cube MX to at least this
 
     BSP_Init();
-
-    size_t smallsize  = sizeof(SmallMessageUnion_T);
-    size_t mediumsize = sizeof(MediumMessageUnion_T);
-    size_t largesize  = sizeof(LongMessageUnion_T);
-    (void) smallsize;
-    (void) mediumsize;
-    (void) largesize;
-
-    // initialize event pools
-    static QF_MPOOL_EL(SmallMessageUnion_T) smlPoolSto[10];
-    QF_poolInit(smlPoolSto, sizeof(smlPoolSto), sizeof(smlPoolSto[0]));
-
-    static QF_MPOOL_EL(MediumMessageUnion_T) mediumPoolSto[20];
-    QF_poolInit(mediumPoolSto, sizeof(mediumPoolSto), sizeof(mediumPoolSto[0]));
-
-    static QF_MPOOL_EL(LongMessageUnion_T) longPoolSto[20];
-    QF_poolInit(longPoolSto, sizeof(longPoolSto), sizeof(longPoolSto[0]));
-
-    // initialize publish-subscribe
-    static QSubscrList subscrSto[PUBSUB_MAX_SIG];
-    QActive_psInit(subscrSto, Q_DIM(subscrSto));
-
-    // instantiate and start AOs/threads...
-
-    static QEvt const *blinkyQueueSto[10];
-    Blinky_ctor();
-    QACTIVE_START(
-        AO_Blinky,
-        AO_PRIO_BLINKY,        // QP prio. of the AO
-        blinkyQueueSto,        // event queue storage
-        Q_DIM(blinkyQueueSto), // queue length [events]
-        (void *) 0,
-        0U,          // no stack storage
-        (void *) 0); // no initialization param
-
-    static QEvt const *shared_i2c2_QueueSto[10];
-    QACTIVE_START(
-        AO_SharedI2C2,
-        AO_PRIO_SHARED_I2C2,         // QP prio. of the AO
-        shared_i2c2_QueueSto,        // event queue storage
-        Q_DIM(shared_i2c2_QueueSto), // queue length [events]
-        (void *) 0,                  // stack storage (not used in QK)
-        0U,                          // stack size [bytes] (not used in QK)
-        (void *) 0);                 // no initialization param
-
-    static QEvt const *pc_com_QueueSto[10];
-    PC_COM_ctor(BSP_Get_Serial_IO_Interface_USB0());
-    QACTIVE_START(
-        AO_PC_COM,
-        AO_PRIO_PC_COM,         // QP prio. of the AO
-        pc_com_QueueSto,        // event queue storage
-        Q_DIM(pc_com_QueueSto), // queue length [events]
-        (void *) 0,             // stack storage (not used in QK)
-        0U,                     // stack size [bytes] (not used in QK)
-        (void *) 0);            // no initialization param
-
-    static QEvt const *log_com_QueueSto[20];
-    LogCom_ctor(BSP_Get_Serial_IO_Interface_USB1());
-    QACTIVE_START(
-        AO_LogCom,
-        AO_PRIO_LOG_COM,         // QP prio. of the AO
-        log_com_QueueSto,        // event queue storage
-        Q_DIM(log_com_QueueSto), // queue length [events]
-        (void *) 0,              // stack storage (not used in QK)
-        0U,                      // stack size [bytes] (not used in QK)
-        (void *) 0);             // no initialization param
-
-    static QEvt const *config_QueueSto[10];
-    Config_ctor();
-    QACTIVE_START(
-        AO_Config,
-        AO_PRIO_CONFIG,         // QP prio. of the AO
-        config_QueueSto,        // event queue storage
-        Q_DIM(config_QueueSto), // queue length [events]
-        (void *) 0,
-        0U,
-        (void *) 0);
-
-    static QEvt const *fram_QueueSto[10];
-    Fram_ctor(BSP_Get_I2C_Write_FRAM(), BSP_Get_I2C_Memory_Read_FRAM());
-    QACTIVE_START(
-        AO_Fram,
-        AO_PRIO_FRAM,         // QP prio. of the AO
-        fram_QueueSto,        // event queue storage
-        Q_DIM(fram_QueueSto), // queue length [events]
-        (void *) 0,
-        0U,
-        (void *) 0);
-
-    static QEvt const *box_to_box_QueueSto[20];
-    Box_To_Box_ctor();
-    QACTIVE_START(
-        AO_BOX_TO_BOX,
-        AO_PRIO_BOX_TO_BOX,         // QP prio. of the AO
-        box_to_box_QueueSto,        // event queue storage
-        Q_DIM(box_to_box_QueueSto), // queue length [events]
-        (void *) 0,                 // stack storage (not used in QK)
-        0U,                         // stack size [bytes] (not used in QK)
-        (void *) 0);                // no initialization param
-
-    static QEvt const *directorQueueSto[10];
-    Director_ctor();
-    QACTIVE_START(
-        AO_DIRECTOR,
-        AO_PRIO_DIRECTOR,        // QP prio. of the AO
-        directorQueueSto,        // event queue storage
-        Q_DIM(directorQueueSto), // queue length [events]
-        (void *) 0,
-        0U,          // no stack storage
-        (void *) 0); // no initialization param
-
-    static QEvt const *usb_QueueSto[10];
-    USB_ctor();
-    QACTIVE_START(
-        AO_USB,
-        AO_PRIO_USB,         // QP prio. of the AO
-        usb_QueueSto,        // event queue storage
-        Q_DIM(usb_QueueSto), // queue length [events]
-        (void *) 0,          // stack storage (not used in QK)
-        0U,                  // stack size [bytes] (not used in QK)
-        (void *) 0);         // no initialization param
+    App_Start(); // event pools, publish-subscribe and the AOs
 
     return QF_run(); // run the QF application
                      /* USER CODE END 2 */
@@ -501,9 +316,9 @@ static void MX_FDCAN2_Init(void)
     hfdcan2.Init.DataSyncJumpWidth    = 1;
     hfdcan2.Init.DataTimeSeg1         = 13;
     hfdcan2.Init.DataTimeSeg2         = 2;
-    hfdcan2.Init.StdFiltersNbr        = 1;
+    hfdcan2.Init.StdFiltersNbr        = 8;
     hfdcan2.Init.ExtFiltersNbr        = 0;
-    hfdcan2.Init.TxFifoQueueMode      = FDCAN_TX_FIFO_OPERATION;
+    hfdcan2.Init.TxFifoQueueMode      = FDCAN_TX_QUEUE_OPERATION;
     if (HAL_FDCAN_Init(&hfdcan2) != HAL_OK)
     {
         Error_Handler();
@@ -1,11 +1,17 @@
 #include "cli_commands.h"
 #include "blinky.h"
+#include "box_to_box.h"
 #include "bsp.h"
 #include "bsp_manual.h"
+#include "can_messages.h"
+#include "can_rx_ring.h"
 #include "cli_manual_commands.h"
+#include "cli_shared_commands.h"
 #include "config.h"
+#include "director.h"
 #include "interfaces/gpio.h"
 #include "interfaces/i2c_bus.h"
+#include "kernel_bench.h"
 #include "pc_com.h"
 #include "posted_signals.h"
 #include "qpc.h"
@@ -34,10 +40,21 @@ static void on_cli_config_list(EmbeddedCli *cli, char *args, void *context);
 static void on_cli_config_read(EmbeddedCli *cli, char *args, void *context);
 static void on_cli_config_set(EmbeddedCli *cli, char *args, void *context);
 static void on_cli_config_save(EmbeddedCli *cli, char *args, void *context);
+static void on_cli_can_rx_stats(EmbeddedCli *cli, char *args, void *context);
+static size_t bench_temperature_lookup(uint32_t i);
+static size_t bench_pressure_lookup(uint32_t i);
 static bool is_numeric(const char *s);
 static bool is_positive_numeric(const char *s);
 static void lowercase(const char *src, char *dst, unsigned max_len);
 
+// The bench command's gauge calibration lookups, swept over each gauge's range
+static volatile float bench_sink;
+
+static const Kernel_Bench_T gauge_kernels[] = {
+    {"gauge-temperature", NULL, bench_temperature_lookup},
+    {"gauge-pressure", NULL, bench_pressure_lookup},
+};
+
 static CliCommandBinding cli_cmd_list[] = {
     (CliCommandBinding) {
         "toggle-led",                     // command name (spaces are not allowed)
@@ -137,6 +154,14 @@ static CliCommandBinding cli_cmd_list[] = {
         NULL,
         on_bootloader,
     },
+
+    (CliCommandBinding) {
+        "can-rx-stats",
+        "Print CAN frame counters, what the filters accept, the tunnel and motor clock sync",
+        false,
+        NULL,
+        on_cli_can_rx_stats,
+    },
 };
 
 void CLI_AddCommands(EmbeddedCli *cli)
@@ -145,6 +170,7 @@ void CLI_AddCommands(EmbeddedCli *cli)
     {
         embeddedCliAddBinding(cli, cli_cmd_list[i]);
     }
+    CLI_Shared_AddCommands(cli, gauge_kernels, DIMENSION_OF(gauge_kernels));
 }
 
 static void on_bootloader(EmbeddedCli *cli, char *args, void *context)
@@ -156,6 +182,144 @@ static void on_bootloader(EmbeddedCli *cli, char *args, void *context)
     Reset_RequestBootloader();
 }
 
+static void on_cli_can_rx_stats(EmbeddedCli *cli, char *args, void *context)
+{
+    (void) args;
+    (void) context;
+
+    char print_buffer[CLI_PRINT_BUFFER_SIZE] = {0};
+    Box_To_Box_Stats_T stats;
+    CAN_Rx_Ring_Stats_T ring_stats;
+    uint32_t high_prio_ids = 0U;
+    uint32_t low_prio_ids  = 0U;
+
+    Box_To_Box_Get_Stats(&stats);
+    CAN_Rx_Ring_Get_Stats(&ring_stats);
+
+    for (uint32_t i = 0U; i < CAN_MSG_COUNT; i++)
+    {
+        if ((CAN_Msg_Info[i].rx_boards & CAN_RX_THIS_BOARD) == 0U)
+        {
+            continue;
+        }
+        if (CAN_Msg_Info[i].rx_prio == CAN_RX_PRIO_HIGH)
+        {
+            high_prio_ids++;
+        }
+        else
+        {
+            low_prio_ids++;
+        }
+    }
+
+    snprintf(
+        print_buffer,
+        sizeof(print_buffer),
+        "filters accept %lu of %lu IDs (FIFO0 %lu, FIFO1 %lu), the rest is rejected in hardware",
+        (unsigned long) (high_prio_ids + low_prio_ids),
+        (unsigned long) CAN_MSG_COUNT,
+        (unsigned long) high_prio_ids,
+        (unsigned long) low_prio_ids);
+    embeddedCliPrint(cli, print_buffer);
+
+    snprintf(
+        print_buffer,
+        sizeof(print_buffer),
+        "rx handled %lu, unhandled %lu, motor data %lu (lost %lu)",
+        (unsigned long) stats.rx_handled,
+        (unsigned long) stats.rx_unhandled,
+        (unsigned long) stats.motor_data_received,
+        (unsigned long) stats.motor_data_lost);
+    embeddedCliPrint(cli, print_buffer);
+
+    snprintf(
+        print_buffer,
+        sizeof(print_buffer),
+        "rx ring %lu frames, %lu events, high water %lu/%lu, overflows %lu, fifo lost %lu",
+        (unsigned long) ring_stats.frames,
+        (unsigned long) ring_stats.notifies,
+        (unsigned long) ring_stats.high_water,
+        (unsigned long) CAN_RX_RING_LENGTH,
+        (unsigned long) ring_stats.overflows,
+        (unsigned long) ring_stats.fifo_lost);
+    embeddedCliPrint(cli, print_buffer);
+
+    CAN_Bit_Rates_T rates;
+    BSP_CAN_Get_Bit_Rates(&rates);
+    snprintf(
+        print_buffer,
+        sizeof(print_buffer),
+        "bit rate %lu/%lu kbit/s (BRS %s, %lu fallbacks), load %u.%u%% (%u.%u%% without BRS)",
+        (unsigned long) (rates.nominal_bps / 1000U),
+        (unsigned long) (rates.data_bps / 1000U),
+        rates.brs ? "on" : "off",
+        (unsigned long) stats.brs_fallbacks,
+        (unsigned) (stats.bus_load / 10U),
+        (unsigned) (stats.bus_load % 10U),
+        (unsigned) (stats.bus_load_nominal / 10U),
+        (unsigned) (stats.bus_load_nominal % 10U));
+    embeddedCliPrint(cli, print_buffer);
+
+    CAN_Transport_Stats_T tunnel;
+    Box_To_Box_Get_Tunnel_Stats(&tunnel);
+    snprintf(
+        print_buffer,
+        sizeof(print_buffer),
+        "tunnel tx %lu packets (%lu dropped, %lu refused), %lu segments, %lu retransmits",
+        (unsigned long) tunnel.messages_sent,
+        (unsigned long) tunnel.messages_dropped,
+        (unsigned long) tunnel.messages_refused,
+        (unsigned long) tunnel.segments_sent,
+        (unsigned long) tunnel.retransmits);
+    embeddedCliPrint(cli, print_buffer);
+    snprintf(
+        print_buffer,
+        sizeof(print_buffer),
+        "tunnel rx %lu packets (%lu lost, %lu unread), %lu segments (%lu ignored), %lu acks",
+        (unsigned long) tunnel.messages_received,
+        (unsigned long) tunnel.messages_lost,
+        (unsigned long) tunnel.messages_unread,
+        (unsigned long) tunnel.segments_received,
+        (unsigned long) tunnel.segments_ignored,
+        (unsigned long) tunnel.acks_sent);
+    embeddedCliPrint(cli, print_buffer);
+
+    Time_Sync_T sync;
+    Box_To_Box_Get_Time_Sync(&sync);
+    if (!sync.synced)
+    {
+        embeddedCliPrint(cli, "motor clock not synced yet");
+        return;
+    }
+
+    snprintf(
+        print_buffer,
+        sizeof(print_buffer),
+        "motor clock %+ld ms from ours, drift %+ld ppb, round trip %ld us, %lu exchanges "
+        "(%lu rejected, %lu steps)",
+        (long) (sync.offset_us / 1000),
+        (long) sync.drift_ppb,
+        (long) sync.round_trip_us,
+        (unsigned long) sync.exchanges,
+        (unsigned long) sync.rejected,
+        (unsigned long) sync.steps);
+    embeddedCliPrint(cli, print_buffer);
+}
+
+// 0 to 127 C, past the end of the table
+static size_t bench_temperature_lookup(uint32_t i)
+{
+    bench_sink = Director_Temperature_To_Gauge_Volts((float) (i & 0x7FU));
+    return 0U;
+}
+
+// 0 to 127 psi, most of the table
+static size_t bench_pressure_lookup(uint32_t i)
+{
+    bench_sink = Director_Pressure_To_Gauge_Volts((float) (i & 0x7FU));
+    return 0U;
+}
+
 static void on_cli_toggle_led(EmbeddedCli *cli, char *args, void *context)
 {
     // statically allocated and const event to post to the Blinky active object
@@ -227,17 +227,26 @@ void on_cli_motor_data_publish(EmbeddedCli *cli, char *args, void *context)
         return;
     }
 
-    MotorDataEvent_T *event = Q_NEW(MotorDataEvent_T, PUBSUB_MOTOR_DATA_SIG);
+    MotorDataEvent_T *event = EVENT_CATALOGUE_NEW(
+        PUBSUB_POOL_EVENTS, MotorDataEvent_T, PUBSUB_MOTOR_DATA_SIG);
     event->temperature      = temperature;
     event->pressure         = pressure;
     event->tachometer       = tachometer;
     event->vbat             = vbat;
+    event->vbat_min         = vbat;
+    event->vbat_max         = vbat;
     event->engine_minutes   = engine_minutes;
     event->start            = start;
     event->neutral          = neutral;
     event->buzzer           = buzzer;
     event->temp_good        = temp_good;
     event->pres_good        = pres_good;
+    event->timestamp_us     = BSP_Get_Microseconds();
+
+    // the values are fresh from the command line
+    event->temperature_age_us = 0U;
+    event->pressure_age_us    = 0U;
+    event->updated            = MOTOR_DATA_UPDATED_ALL;
 
     QACTIVE_POST(AO_DIRECTOR, &event->super, NULL);
 
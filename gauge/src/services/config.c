@@ -3,6 +3,7 @@
 #include "log_com.h"
 #include "posted_signals.h"
 #include "pubsub_signals.h"
+#include <assert.h>
 #include <string.h>
 
 Q_DEFINE_THIS_MODULE("config")
@@ -273,7 +274,8 @@ static QState Config_loading(Config *const me, QEvt const *const e)
     switch (e->sig)
     {
         case Q_ENTRY_SIG: {
-            FramReadReqEvent_T *read_req_evt = Q_NEW(FramReadReqEvent_T, POSTED_FRAM_READ_REQ_SIG);
+            FramReadReqEvent_T *read_req_evt = EVENT_CATALOGUE_NEW(
+                FRAM_POOL_EVENTS, FramReadReqEvent_T, POSTED_FRAM_READ_REQ_SIG);
             read_req_evt->requester          = &me->super;
             QACTIVE_POST(AO_Fram, &read_req_evt->super, &me->super);
             status = Q_HANDLED();
@@ -351,7 +353,8 @@ static QState Config_busy_saving(Config *const me, QEvt const *const e)
     switch (e->sig)
     {
         case Q_ENTRY_SIG: {
-            FramWriteReqEvent_T *write_evt = Q_NEW(FramWriteReqEvent_T, POSTED_FRAM_WRITE_REQ_SIG);
+            FramWriteReqEvent_T *write_evt = EVENT_CATALOGUE_NEW(
+                FRAM_POOL_EVENTS, FramWriteReqEvent_T, POSTED_FRAM_WRITE_REQ_SIG);
             write_evt->requester           = &me->super;
 
             for (unsigned i = 0; i < CFG_ID_NUM_IDS; i++)
@@ -387,8 +390,8 @@ static QState Config_busy_saving(Config *const me, QEvt const *const e)
 
 static void Config_PublishEntryChanged(ConfigID_T id)
 {
-    ConfigEntryChangedEvent_T *event = Q_NEW(
-        ConfigEntryChangedEvent_T, PUBSUB_CONFIG_ENTRY_CHANGED_SIG);
+    ConfigEntryChangedEvent_T *event = EVENT_CATALOGUE_NEW(
+        CONFIG_POOL_EVENTS, ConfigEntryChangedEvent_T, PUBSUB_CONFIG_ENTRY_CHANGED_SIG);
     event->id = id;
     QACTIVE_PUBLISH(&event->super, AO_Config);
 }
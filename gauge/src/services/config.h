@@ -1,6 +1,7 @@
 #ifndef CONFIG_H_
 #define CONFIG_H_
 
+#include "event_catalogue.h"
 #include "qpc.h"
 #include <stdbool.h>
 #include <stdint.h>
@@ -25,6 +26,9 @@ typedef struct
     ConfigID_T id;
 } ConfigEntryChangedEvent_T;
 
+// pool events, see event_catalogue.h; Config_SetDefaultAll() publishes every entry at once
+#define CONFIG_POOL_EVENTS(X) X(ConfigEntryChangedEvent_T, CFG_ID_NUM_IDS + 1U)
+
 extern QActive *const AO_Config;
 
 void Config_ctor(void);
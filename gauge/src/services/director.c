@@ -71,8 +71,6 @@ static QState initial(Director *const me, void const *const par);
 static QState top(Director *const me, QEvt const *const e);
 static float lookup_gauge_voltage(
     const GaugeMapPoint_T *map, size_t map_len, float input_value);
-static float map_temperature_to_voltage(float temperature_c);
-static float map_pressure_to_voltage(float pressure_psi);
 
 /**************************************************************************************************\
 * Public functions
@@ -85,6 +83,25 @@ void Director_ctor(void)
     QTimeEvt_ctorX(&me->timeEvt, &me->super, POLL_TIMEOUT_SIG, 0U);
 }
 
+/**
+ ***************************************************************************************************
+ * @brief   The DAC volts that show temperature_c on the temperature gauge, interpolated between
+ *          the points of its calibration table and held at its ends
+ **************************************************************************************************/
+float Director_Temperature_To_Gauge_Volts(float temperature_c)
+{
+    return lookup_gauge_voltage(s_temp_gauge_map, Q_DIM(s_temp_gauge_map), temperature_c);
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   The same for pressure_psi on the pressure gauge
+ **************************************************************************************************/
+float Director_Pressure_To_Gauge_Volts(float pressure_psi)
+{
+    return lookup_gauge_voltage(s_pressure_gauge_map, Q_DIM(s_pressure_gauge_map), pressure_psi);
+}
+
 /**************************************************************************************************\
 * HSM
 \**************************************************************************************************/
@@ -106,15 +123,16 @@ static QState top(Director *const me, QEvt const *const e)
     switch (e->sig)
     {
         case Q_ENTRY_SIG: {
-            BSP_Gauge_SetPressure_V(map_pressure_to_voltage(0.0f));
-            BSP_Gauge_SetTemperature_V(map_temperature_to_voltage(25.0f));
+            BSP_Gauge_SetPressure_V(Director_Pressure_To_Gauge_Volts(0.0f));
+            BSP_Gauge_SetTemperature_V(Director_Temperature_To_Gauge_Volts(25.0f));
             BSP_Gauge_SetOpAmpRef_V(1.78f);
 
             BSP_RpmGauge_SetPFM_RPM(0U);
 
             BSP_Set_Backlight(false);
 
-            QEvt *evt = Q_NEW(QEvt, PUBSUB_BOX_TO_BOX_STARTUP_SIG);
+            QEvt *evt = EVENT_CATALOGUE_NEW(
+                PUBSUB_POOL_EVENTS, QEvt, PUBSUB_BOX_TO_BOX_STARTUP_SIG);
             QACTIVE_PUBLISH(evt, &me->super);
 
             status = Q_HANDLED();
@@ -124,8 +142,8 @@ static QState top(Director *const me, QEvt const *const e)
         case PUBSUB_MOTOR_DATA_SIG: {
             const MotorDataEvent_T *evt = Q_EVT_CAST(MotorDataEvent_T);
 
-            BSP_Gauge_SetPressure_V(map_pressure_to_voltage(evt->pressure));
-            BSP_Gauge_SetTemperature_V(map_temperature_to_voltage(evt->temperature));
+            BSP_Gauge_SetPressure_V(Director_Pressure_To_Gauge_Volts(evt->pressure));
+            BSP_Gauge_SetTemperature_V(Director_Temperature_To_Gauge_Volts(evt->temperature));
             BSP_RpmGauge_SetPFM_RPM((uint32_t) evt->tachometer);
 
             status = Q_HANDLED();
@@ -181,13 +199,3 @@ static float lookup_gauge_voltage(
 
     return map[map_len - 1U].output_volts;
 }
-
-static float map_temperature_to_voltage(float temperature_c)
-{
-    return lookup_gauge_voltage(s_temp_gauge_map, Q_DIM(s_temp_gauge_map), temperature_c);
-}
-
-static float map_pressure_to_voltage(float pressure_psi)
-{
-    return lookup_gauge_voltage(s_pressure_gauge_map, Q_DIM(s_pressure_gauge_map), pressure_psi);
-}
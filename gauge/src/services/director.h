@@ -24,6 +24,10 @@ typedef struct
 // Constructor
 void Director_ctor(void);
 
+// Gauge calibration, engineering units to DAC volts
+float Director_Temperature_To_Gauge_Volts(float temperature_c);
+float Director_Pressure_To_Gauge_Volts(float pressure_psi);
+
 #ifdef __cplusplus
 }
 #endif
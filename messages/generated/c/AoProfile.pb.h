@@ -0,0 +1,113 @@
+/* Automatically generated nanopb header */
+/* Generated by nanopb-0.4.9-dev */
+
+#ifndef PB_AOPROFILE_PB_H_INCLUDED
+#define PB_AOPROFILE_PB_H_INCLUDED
+#include <pb.h>
+
+#if PB_PROTO_HEADER_VERSION != 40
+#error Regenerate this file with the current version of nanopb generator.
+#endif
+
+/* Struct definitions */
+/* Fixed bucket histogram, as CanHistogram. Bucket 0 holds values below 2^shift, every following
+ bucket is twice as wide as the one before and the last one holds everything above. */
+typedef struct _RtcHistogram {
+    pb_size_t buckets_count;
+    uint32_t buckets[10];
+    uint32_t shift;
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+} RtcHistogram;
+
+/* Run to completion steps of one active object, or of the events of one signal range, in DWT
+ cycles. A step preempted by a higher priority AO doesn't count that AO's cycles; interrupts
+ are counted in. */
+typedef struct _RtcProfile {
+    char name[12];
+    uint32_t id; /* the AO's priority, or the first signal of the range */
+    RtcHistogram cycles;
+} RtcProfile;
+
+/* AO_PROFILE_REQ carries no message. The board answers with an AO_PROFILE_RESP of its AOs and a
+ SIGNAL_PROFILE_RESP of the signal ranges, each holding the ones that ran since the last reset. */
+typedef struct _RtcProfileResp {
+    uint32_t milliseconds_tick;
+    pb_size_t profiles_count;
+    RtcProfile profiles[16];
+} RtcProfileResp;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Initializer values for message structs */
+#define RtcHistogram_init_default                {0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, 0, 0, 0, 0}
+#define RtcProfile_init_default                  {"", 0, RtcHistogram_init_default}
+#define RtcProfileResp_init_default              {0, 0, {RtcProfile_init_default, RtcProfile_init_default, RtcProfile_init_default, RtcProfile_init_default, RtcProfile_init_default, RtcProfile_init_default, RtcProfile_init_default, RtcProfile_init_default, RtcProfile_init_default, RtcProfile_init_default, RtcProfile_init_default, RtcProfile_init_default, RtcProfile_init_default, RtcProfile_init_default, RtcProfile_init_default, RtcProfile_init_default}}
+#define RtcHistogram_init_zero                   {0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, 0, 0, 0, 0}
+#define RtcProfile_init_zero                     {"", 0, RtcHistogram_init_zero}
+#define RtcProfileResp_init_zero                 {0, 0, {RtcProfile_init_zero, RtcProfile_init_zero, RtcProfile_init_zero, RtcProfile_init_zero, RtcProfile_init_zero, RtcProfile_init_zero, RtcProfile_init_zero, RtcProfile_init_zero, RtcProfile_init_zero, RtcProfile_init_zero, RtcProfile_init_zero, RtcProfile_init_zero, RtcProfile_init_zero, RtcProfile_init_zero, RtcProfile_init_zero, RtcProfile_init_zero}}
+
+/* Field tags (for use in manual encoding/decoding) */
+#define RtcHistogram_buckets_tag                 1
+#define RtcHistogram_shift_tag                   2
+#define RtcHistogram_count_tag                   3
+#define RtcHistogram_min_tag                     4
+#define RtcHistogram_max_tag                     5
+#define RtcHistogram_sum_tag                     6
+#define RtcProfile_name_tag                      1
+#define RtcProfile_id_tag                        2
+#define RtcProfile_cycles_tag                    3
+#define RtcProfileResp_milliseconds_tick_tag     1
+#define RtcProfileResp_profiles_tag              2
+
+/* Struct field encoding specification for nanopb */
+#define RtcHistogram_FIELDLIST(X, a) \
+X(a, STATIC,   REPEATED, UINT32,   buckets,           1) \
+X(a, STATIC,   REQUIRED, UINT32,   shift,             2) \
+X(a, STATIC,   REQUIRED, UINT32,   count,             3) \
+X(a, STATIC,   REQUIRED, UINT32,   min,               4) \
+X(a, STATIC,   REQUIRED, UINT32,   max,               5) \
+X(a, STATIC,   REQUIRED, UINT64,   sum,               6)
+#define RtcHistogram_CALLBACK NULL
+#define RtcHistogram_DEFAULT NULL
+
+#define RtcProfile_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, STRING,   name,              1) \
+X(a, STATIC,   REQUIRED, UINT32,   id,                2) \
+X(a, STATIC,   REQUIRED, MESSAGE,  cycles,            3)
+#define RtcProfile_CALLBACK NULL
+#define RtcProfile_DEFAULT NULL
+#define RtcProfile_cycles_MSGTYPE RtcHistogram
+
+#define RtcProfileResp_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   milliseconds_tick,   1) \
+X(a, STATIC,   REPEATED, MESSAGE,  profiles,          2)
+#define RtcProfileResp_CALLBACK NULL
+#define RtcProfileResp_DEFAULT NULL
+#define RtcProfileResp_profiles_MSGTYPE RtcProfile
+
+extern const pb_msgdesc_t RtcHistogram_msg;
+extern const pb_msgdesc_t RtcProfile_msg;
+extern const pb_msgdesc_t RtcProfileResp_msg;
+
+/* Defines for backwards compatibility with code written before nanopb-0.4.0 */
+#define RtcHistogram_fields &RtcHistogram_msg
+#define RtcProfile_fields &RtcProfile_msg
+#define RtcProfileResp_fields &RtcProfileResp_msg
+
+/* Maximum encoded size of messages (where known) */
+#define AOPROFILE_PB_H_MAX_SIZE                  RtcProfileResp_size
+#define RtcHistogram_size                        95
+#define RtcProfile_size                          116
+#define RtcProfileResp_size                      1894
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,18 @@
+/* Automatically generated nanopb constant definitions */
+/* Generated by nanopb-0.4.9-dev */
+
+#include "CanStats.pb.h"
+#if PB_PROTO_HEADER_VERSION != 40
+#error Regenerate this file with the current version of nanopb generator.
+#endif
+
+PB_BIND(CanHistogram, CanHistogram, AUTO)
+
+
+PB_BIND(CanIdStats, CanIdStats, AUTO)
+
+
+PB_BIND(CanStatsResp, CanStatsResp, AUTO)
+
+
+
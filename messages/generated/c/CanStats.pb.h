@@ -0,0 +1,138 @@
+/* Automatically generated nanopb header */
+/* Generated by nanopb-0.4.9-dev */
+
+#ifndef PB_CANSTATS_PB_H_INCLUDED
+#define PB_CANSTATS_PB_H_INCLUDED
+#include <pb.h>
+
+#if PB_PROTO_HEADER_VERSION != 40
+#error Regenerate this file with the current version of nanopb generator.
+#endif
+
+/* Struct definitions */
+/* Fixed bucket histogram. Bucket 0 holds values below 2^shift, every following bucket is twice
+ as wide as the one before and the last one holds everything above. */
+typedef struct _CanHistogram {
+    pb_size_t buckets_count;
+    uint32_t buckets[10];
+    uint32_t shift;
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+} CanHistogram;
+
+typedef struct _CanIdStats {
+    uint32_t id;
+    uint32_t tx_frames;
+    uint32_t tx_events;
+    uint32_t rx_frames;
+    CanHistogram tx_latency_us;
+    CanHistogram rx_age_us;
+} CanIdStats;
+
+typedef struct _CanStatsResp {
+    uint32_t milliseconds_tick;
+    uint32_t tx_error_count;
+    uint32_t rx_error_count;
+    uint32_t errors_logged;
+    pb_size_t last_errors_count;
+    uint32_t last_errors[8];
+    pb_size_t data_last_errors_count;
+    uint32_t data_last_errors[8];
+    uint32_t tx_events_unmatched;
+    pb_size_t ids_count;
+    CanIdStats ids[12];
+} CanStatsResp;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Initializer values for message structs */
+#define CanHistogram_init_default                {0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, 0, 0, 0, 0}
+#define CanIdStats_init_default                  {0, 0, 0, 0, CanHistogram_init_default, CanHistogram_init_default}
+#define CanStatsResp_init_default                {0, 0, 0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0}, 0, {0, 0, 0, 0, 0, 0, 0, 0}, 0, 0, {CanIdStats_init_default, CanIdStats_init_default, CanIdStats_init_default, CanIdStats_init_default, CanIdStats_init_default, CanIdStats_init_default, CanIdStats_init_default, CanIdStats_init_default, CanIdStats_init_default, CanIdStats_init_default, CanIdStats_init_default, CanIdStats_init_default}}
+#define CanHistogram_init_zero                   {0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, 0, 0, 0, 0}
+#define CanIdStats_init_zero                     {0, 0, 0, 0, CanHistogram_init_zero, CanHistogram_init_zero}
+#define CanStatsResp_init_zero                   {0, 0, 0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0}, 0, {0, 0, 0, 0, 0, 0, 0, 0}, 0, 0, {CanIdStats_init_zero, CanIdStats_init_zero, CanIdStats_init_zero, CanIdStats_init_zero, CanIdStats_init_zero, CanIdStats_init_zero, CanIdStats_init_zero, CanIdStats_init_zero, CanIdStats_init_zero, CanIdStats_init_zero, CanIdStats_init_zero, CanIdStats_init_zero}}
+
+/* Field tags (for use in manual encoding/decoding) */
+#define CanHistogram_buckets_tag                 1
+#define CanHistogram_shift_tag                   2
+#define CanHistogram_count_tag                   3
+#define CanHistogram_min_tag                     4
+#define CanHistogram_max_tag                     5
+#define CanHistogram_sum_tag                     6
+#define CanIdStats_id_tag                        1
+#define CanIdStats_tx_frames_tag                 2
+#define CanIdStats_tx_events_tag                 3
+#define CanIdStats_rx_frames_tag                 4
+#define CanIdStats_tx_latency_us_tag             5
+#define CanIdStats_rx_age_us_tag                 6
+#define CanStatsResp_milliseconds_tick_tag       1
+#define CanStatsResp_tx_error_count_tag          2
+#define CanStatsResp_rx_error_count_tag          3
+#define CanStatsResp_errors_logged_tag           4
+#define CanStatsResp_last_errors_tag             5
+#define CanStatsResp_data_last_errors_tag        6
+#define CanStatsResp_tx_events_unmatched_tag     7
+#define CanStatsResp_ids_tag                     8
+
+/* Struct field encoding specification for nanopb */
+#define CanHistogram_FIELDLIST(X, a) \
+X(a, STATIC,   REPEATED, UINT32,   buckets,           1) \
+X(a, STATIC,   REQUIRED, UINT32,   shift,             2) \
+X(a, STATIC,   REQUIRED, UINT32,   count,             3) \
+X(a, STATIC,   REQUIRED, UINT32,   min,               4) \
+X(a, STATIC,   REQUIRED, UINT32,   max,               5) \
+X(a, STATIC,   REQUIRED, UINT64,   sum,               6)
+#define CanHistogram_CALLBACK NULL
+#define CanHistogram_DEFAULT NULL
+
+#define CanIdStats_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   id,                1) \
+X(a, STATIC,   REQUIRED, UINT32,   tx_frames,         2) \
+X(a, STATIC,   REQUIRED, UINT32,   tx_events,         3) \
+X(a, STATIC,   REQUIRED, UINT32,   rx_frames,         4) \
+X(a, STATIC,   REQUIRED, MESSAGE,  tx_latency_us,     5) \
+X(a, STATIC,   REQUIRED, MESSAGE,  rx_age_us,         6)
+#define CanIdStats_CALLBACK NULL
+#define CanIdStats_DEFAULT NULL
+#define CanIdStats_tx_latency_us_MSGTYPE CanHistogram
+#define CanIdStats_rx_age_us_MSGTYPE CanHistogram
+
+#define CanStatsResp_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   milliseconds_tick,   1) \
+X(a, STATIC,   REQUIRED, UINT32,   tx_error_count,    2) \
+X(a, STATIC,   REQUIRED, UINT32,   rx_error_count,    3) \
+X(a, STATIC,   REQUIRED, UINT32,   errors_logged,     4) \
+X(a, STATIC,   REPEATED, UINT32,   last_errors,       5) \
+X(a, STATIC,   REPEATED, UINT32,   data_last_errors,   6) \
+X(a, STATIC,   REQUIRED, UINT32,   tx_events_unmatched,   7) \
+X(a, STATIC,   REPEATED, MESSAGE,  ids,               8)
+#define CanStatsResp_CALLBACK NULL
+#define CanStatsResp_DEFAULT NULL
+#define CanStatsResp_ids_MSGTYPE CanIdStats
+
+extern const pb_msgdesc_t CanHistogram_msg;
+extern const pb_msgdesc_t CanIdStats_msg;
+extern const pb_msgdesc_t CanStatsResp_msg;
+
+/* Defines for backwards compatibility with code written before nanopb-0.4.0 */
+#define CanHistogram_fields &CanHistogram_msg
+#define CanIdStats_fields &CanIdStats_msg
+#define CanStatsResp_fields &CanStatsResp_msg
+
+/* Maximum encoded size of messages (where known) */
+#define CANSTATS_PB_H_MAX_SIZE                   CanStatsResp_size
+#define CanHistogram_size                        95
+#define CanIdStats_size                          218
+#define CanStatsResp_size                        2778
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,63 @@
+/* Automatically generated nanopb header */
+/* Generated by nanopb-0.4.9-dev */
+
+#ifndef PB_CPULOAD_PB_H_INCLUDED
+#define PB_CPULOAD_PB_H_INCLUDED
+#include <pb.h>
+
+#if PB_PROTO_HEADER_VERSION != 40
+#error Regenerate this file with the current version of nanopb generator.
+#endif
+
+/* Struct definitions */
+/* The share of the time not spent in the idle loop, in tenths of a percent. Each board sends it
+ once a second; the 1 s and 10 s loads average the 100 ms windows since start up until there
+ are that many. */
+typedef struct _CpuLoad {
+    uint32_t milliseconds_tick;
+    uint32_t load_100ms;
+    uint32_t load_1s;
+    uint32_t load_10s;
+    uint32_t peak_100ms; /* the busiest window since start up or the last reset */
+} CpuLoad;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Initializer values for message structs */
+#define CpuLoad_init_default                     {0, 0, 0, 0, 0}
+#define CpuLoad_init_zero                        {0, 0, 0, 0, 0}
+
+/* Field tags (for use in manual encoding/decoding) */
+#define CpuLoad_milliseconds_tick_tag            1
+#define CpuLoad_load_100ms_tag                   2
+#define CpuLoad_load_1s_tag                      3
+#define CpuLoad_load_10s_tag                     4
+#define CpuLoad_peak_100ms_tag                   5
+
+/* Struct field encoding specification for nanopb */
+#define CpuLoad_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   milliseconds_tick,   1) \
+X(a, STATIC,   REQUIRED, UINT32,   load_100ms,        2) \
+X(a, STATIC,   REQUIRED, UINT32,   load_1s,           3) \
+X(a, STATIC,   REQUIRED, UINT32,   load_10s,          4) \
+X(a, STATIC,   REQUIRED, UINT32,   peak_100ms,        5)
+#define CpuLoad_CALLBACK NULL
+#define CpuLoad_DEFAULT NULL
+
+extern const pb_msgdesc_t CpuLoad_msg;
+
+/* Defines for backwards compatibility with code written before nanopb-0.4.0 */
+#define CpuLoad_fields &CpuLoad_msg
+
+/* Maximum encoded size of messages (where known) */
+#define CPULOAD_PB_H_MAX_SIZE                    CpuLoad_size
+#define CpuLoad_size                             30
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
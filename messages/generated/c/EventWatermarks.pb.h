@@ -0,0 +1,126 @@
+/* Automatically generated nanopb header */
+/* Generated by nanopb-0.4.9-dev */
+
+#ifndef PB_EVENTWATERMARKS_PB_H_INCLUDED
+#define PB_EVENTWATERMARKS_PB_H_INCLUDED
+#include <pb.h>
+
+#if PB_PROTO_HEADER_VERSION != 40
+#error Regenerate this file with the current version of nanopb generator.
+#endif
+
+/* Struct definitions */
+/* One of QF's event pools: how close it came to running out, and how fast it is drawn on */
+typedef struct _EventPoolWatermark {
+    uint32_t block_size; /* bytes, the largest event the pool holds */
+    uint32_t blocks;
+    uint32_t free;
+    uint32_t min_free; /* the low-water mark since start up */
+    uint32_t allocs; /* since start up */
+    uint32_t allocs_per_s; /* over the last second */
+    uint32_t peak_allocs_per_s;
+} EventPoolWatermark;
+
+/* The event queue of one active object */
+typedef struct _EventQueueWatermark {
+    char name[12];
+    uint32_t prio;
+    uint32_t length; /* events the queue holds */
+    uint32_t free;
+    uint32_t min_free; /* the low-water mark since start up */
+} EventQueueWatermark;
+
+/* EVENT_WATERMARKS_REQ carries no message. The board answers with an EVENT_WATERMARKS_RESP of
+ every event pool, smallest events first, and the queue of every AO. A low-water mark under
+ warn_percent of the pool or queue is also logged as a warning. */
+typedef struct _EventWatermarksResp {
+    uint32_t milliseconds_tick;
+    uint32_t warn_percent;
+    pb_size_t pools_count;
+    EventPoolWatermark pools[15];
+    pb_size_t queues_count;
+    EventQueueWatermark queues[12];
+} EventWatermarksResp;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Initializer values for message structs */
+#define EventPoolWatermark_init_default          {0, 0, 0, 0, 0, 0, 0}
+#define EventQueueWatermark_init_default         {"", 0, 0, 0, 0}
+#define EventWatermarksResp_init_default         {0, 0, 0, {EventPoolWatermark_init_default, EventPoolWatermark_init_default, EventPoolWatermark_init_default, EventPoolWatermark_init_default, EventPoolWatermark_init_default, EventPoolWatermark_init_default, EventPoolWatermark_init_default, EventPoolWatermark_init_default, EventPoolWatermark_init_default, EventPoolWatermark_init_default, EventPoolWatermark_init_default, EventPoolWatermark_init_default, EventPoolWatermark_init_default, EventPoolWatermark_init_default, EventPoolWatermark_init_default}, 0, {EventQueueWatermark_init_default, EventQueueWatermark_init_default, EventQueueWatermark_init_default, EventQueueWatermark_init_default, EventQueueWatermark_init_default, EventQueueWatermark_init_default, EventQueueWatermark_init_default, EventQueueWatermark_init_default, EventQueueWatermark_init_default, EventQueueWatermark_init_default, EventQueueWatermark_init_default, EventQueueWatermark_init_default}}
+#define EventPoolWatermark_init_zero             {0, 0, 0, 0, 0, 0, 0}
+#define EventQueueWatermark_init_zero            {"", 0, 0, 0, 0}
+#define EventWatermarksResp_init_zero            {0, 0, 0, {EventPoolWatermark_init_zero, EventPoolWatermark_init_zero, EventPoolWatermark_init_zero, EventPoolWatermark_init_zero, EventPoolWatermark_init_zero, EventPoolWatermark_init_zero, EventPoolWatermark_init_zero, EventPoolWatermark_init_zero, EventPoolWatermark_init_zero, EventPoolWatermark_init_zero, EventPoolWatermark_init_zero, EventPoolWatermark_init_zero, EventPoolWatermark_init_zero, EventPoolWatermark_init_zero, EventPoolWatermark_init_zero}, 0, {EventQueueWatermark_init_zero, EventQueueWatermark_init_zero, EventQueueWatermark_init_zero, EventQueueWatermark_init_zero, EventQueueWatermark_init_zero, EventQueueWatermark_init_zero, EventQueueWatermark_init_zero, EventQueueWatermark_init_zero, EventQueueWatermark_init_zero, EventQueueWatermark_init_zero, EventQueueWatermark_init_zero, EventQueueWatermark_init_zero}}
+
+/* Field tags (for use in manual encoding/decoding) */
+#define EventPoolWatermark_block_size_tag        1
+#define EventPoolWatermark_blocks_tag            2
+#define EventPoolWatermark_free_tag              3
+#define EventPoolWatermark_min_free_tag          4
+#define EventPoolWatermark_allocs_tag            5
+#define EventPoolWatermark_allocs_per_s_tag      6
+#define EventPoolWatermark_peak_allocs_per_s_tag 7
+#define EventQueueWatermark_name_tag             1
+#define EventQueueWatermark_prio_tag             2
+#define EventQueueWatermark_length_tag           3
+#define EventQueueWatermark_free_tag             4
+#define EventQueueWatermark_min_free_tag         5
+#define EventWatermarksResp_milliseconds_tick_tag 1
+#define EventWatermarksResp_warn_percent_tag     2
+#define EventWatermarksResp_pools_tag            3
+#define EventWatermarksResp_queues_tag           4
+
+/* Struct field encoding specification for nanopb */
+#define EventPoolWatermark_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   block_size,        1) \
+X(a, STATIC,   REQUIRED, UINT32,   blocks,            2) \
+X(a, STATIC,   REQUIRED, UINT32,   free,              3) \
+X(a, STATIC,   REQUIRED, UINT32,   min_free,          4) \
+X(a, STATIC,   REQUIRED, UINT32,   allocs,            5) \
+X(a, STATIC,   REQUIRED, UINT32,   allocs_per_s,      6) \
+X(a, STATIC,   REQUIRED, UINT32,   peak_allocs_per_s,   7)
+#define EventPoolWatermark_CALLBACK NULL
+#define EventPoolWatermark_DEFAULT NULL
+
+#define EventQueueWatermark_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, STRING,   name,              1) \
+X(a, STATIC,   REQUIRED, UINT32,   prio,              2) \
+X(a, STATIC,   REQUIRED, UINT32,   length,            3) \
+X(a, STATIC,   REQUIRED, UINT32,   free,              4) \
+X(a, STATIC,   REQUIRED, UINT32,   min_free,          5)
+#define EventQueueWatermark_CALLBACK NULL
+#define EventQueueWatermark_DEFAULT NULL
+
+#define EventWatermarksResp_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   milliseconds_tick,   1) \
+X(a, STATIC,   REQUIRED, UINT32,   warn_percent,      2) \
+X(a, STATIC,   REPEATED, MESSAGE,  pools,             3) \
+X(a, STATIC,   REPEATED, MESSAGE,  queues,            4)
+#define EventWatermarksResp_CALLBACK NULL
+#define EventWatermarksResp_DEFAULT NULL
+#define EventWatermarksResp_pools_MSGTYPE EventPoolWatermark
+#define EventWatermarksResp_queues_MSGTYPE EventQueueWatermark
+
+extern const pb_msgdesc_t EventPoolWatermark_msg;
+extern const pb_msgdesc_t EventQueueWatermark_msg;
+extern const pb_msgdesc_t EventWatermarksResp_msg;
+
+/* Defines for backwards compatibility with code written before nanopb-0.4.0 */
+#define EventPoolWatermark_fields &EventPoolWatermark_msg
+#define EventQueueWatermark_fields &EventQueueWatermark_msg
+#define EventWatermarksResp_fields &EventWatermarksResp_msg
+
+/* Maximum encoded size of messages (where known) */
+#define EVENTWATERMARKS_PB_H_MAX_SIZE            EventWatermarksResp_size
+#define EventPoolWatermark_size                  42
+#define EventQueueWatermark_size                 37
+#define EventWatermarksResp_size                 1140
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -27,7 +27,23 @@ typedef enum _MessageType {
     MessageType_CONFIG_DB_INFO_RESP = 17,
     MessageType_CONFIG_DB_ENTRY_DATA_RESP = 18,
     /* Motor telemetry */
-    MessageType_MOTOR_DATA = 19
+    MessageType_MOTOR_DATA = 19,
+    /* CAN bus statistics */
+    MessageType_CAN_STATS_REQ = 20,
+    MessageType_CAN_STATS_RESP = 21,
+    /* Sensor trace recording, see SensorTrace.proto */
+    MessageType_SENSOR_TRACE_START_REQ = 22,
+    MessageType_SENSOR_TRACE_STOP_REQ = 23,
+    MessageType_SENSOR_TRACE_DATA = 24,
+    /* Active object run to completion profiling, see AoProfile.proto */
+    MessageType_AO_PROFILE_REQ = 25,
+    MessageType_AO_PROFILE_RESP = 26,
+    MessageType_SIGNAL_PROFILE_RESP = 27,
+    /* CPU load telemetry, see CpuLoad.proto */
+    MessageType_CPU_LOAD = 28,
+    /* Event pool and AO queue low-water marks, see EventWatermarks.proto */
+    MessageType_EVENT_WATERMARKS_REQ = 29,
+    MessageType_EVENT_WATERMARKS_RESP = 30
 } MessageType;
 
 #ifdef __cplusplus
@@ -36,8 +52,8 @@ extern "C" {
 
 /* Helper constants for enums */
 #define _MessageType_MIN MessageType_LOG_PRINT
-#define _MessageType_MAX MessageType_MOTOR_DATA
-#define _MessageType_ARRAYSIZE ((MessageType)(MessageType_MOTOR_DATA+1))
+#define _MessageType_MAX MessageType_EVENT_WATERMARKS_RESP
+#define _MessageType_ARRAYSIZE ((MessageType)(MessageType_EVENT_WATERMARKS_RESP+1))
 
 
 #ifdef __cplusplus
@@ -22,6 +22,9 @@ typedef struct _MotorData {
     bool buzzer;
     bool temp_good;
     bool pres_good;
+    uint64_t timestamp_us;
+    uint32_t temperature_age_us;
+    uint32_t pressure_age_us;
 } MotorData;
 
 
@@ -30,8 +33,8 @@ extern "C" {
 #endif
 
 /* Initializer values for message structs */
-#define MotorData_init_default                   {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
-#define MotorData_init_zero                      {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
+#define MotorData_init_default                   {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
+#define MotorData_init_zero                      {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
 
 /* Field tags (for use in manual encoding/decoding) */
 #define MotorData_milliseconds_tick_tag          1
@@ -45,6 +48,9 @@ extern "C" {
 #define MotorData_buzzer_tag                     9
 #define MotorData_temp_good_tag                  10
 #define MotorData_pres_good_tag                  11
+#define MotorData_timestamp_us_tag               12
+#define MotorData_temperature_age_us_tag         13
+#define MotorData_pressure_age_us_tag            14
 
 /* Struct field encoding specification for nanopb */
 #define MotorData_FIELDLIST(X, a) \
@@ -58,7 +64,10 @@ X(a, STATIC,   REQUIRED, BOOL,     start,             7) \
 X(a, STATIC,   REQUIRED, BOOL,     neutral,           8) \
 X(a, STATIC,   REQUIRED, BOOL,     buzzer,            9) \
 X(a, STATIC,   REQUIRED, BOOL,     temp_good,        10) \
-X(a, STATIC,   REQUIRED, BOOL,     pres_good,        11)
+X(a, STATIC,   REQUIRED, BOOL,     pres_good,        11) \
+X(a, STATIC,   REQUIRED, UINT64,   timestamp_us,     12) \
+X(a, STATIC,   REQUIRED, UINT32,   temperature_age_us,  13) \
+X(a, STATIC,   REQUIRED, UINT32,   pressure_age_us,  14)
 #define MotorData_CALLBACK NULL
 #define MotorData_DEFAULT NULL
 
@@ -69,7 +78,7 @@ extern const pb_msgdesc_t MotorData_msg;
 
 /* Maximum encoded size of messages (where known) */
 #define MOTORDATA_PB_H_MAX_SIZE                  MotorData_size
-#define MotorData_size                           42
+#define MotorData_size                           65
 
 #ifdef __cplusplus
 } /* extern "C" */
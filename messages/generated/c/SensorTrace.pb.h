@@ -0,0 +1,62 @@
+/* Automatically generated nanopb header */
+/* Generated by nanopb-0.4.9-dev */
+
+#ifndef PB_SENSORTRACE_PB_H_INCLUDED
+#define PB_SENSORTRACE_PB_H_INCLUDED
+#include <pb.h>
+
+#if PB_PROTO_HEADER_VERSION != 40
+#error Regenerate this file with the current version of nanopb generator.
+#endif
+
+/* Struct definitions */
+typedef PB_BYTES_ARRAY_T(192) SensorTraceData_data_t;
+/* A piece of a sensor trace, the motor streams them after SENSOR_TRACE_START_REQ until
+ SENSOR_TRACE_STOP_REQ, neither of which carries a message. The data of consecutive sequence
+ numbers joins up into the trace, see shared/services/sensor_trace.h for its format; a gap in
+ the sequence means a packet was lost on the way. */
+typedef struct _SensorTraceData {
+    uint32_t sequence;
+    SensorTraceData_data_t data;
+    uint32_t lost_records; /* dropped on the board so far, its buffer was full */
+    bool last; /* the rest of the trace after the stop request */
+} SensorTraceData;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Initializer values for message structs */
+#define SensorTraceData_init_default             {0, {0, {0}}, 0, 0}
+#define SensorTraceData_init_zero                {0, {0, {0}}, 0, 0}
+
+/* Field tags (for use in manual encoding/decoding) */
+#define SensorTraceData_sequence_tag             1
+#define SensorTraceData_data_tag                 2
+#define SensorTraceData_lost_records_tag         3
+#define SensorTraceData_last_tag                 4
+
+/* Struct field encoding specification for nanopb */
+#define SensorTraceData_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   sequence,          1) \
+X(a, STATIC,   REQUIRED, BYTES,    data,              2) \
+X(a, STATIC,   REQUIRED, UINT32,   lost_records,      3) \
+X(a, STATIC,   REQUIRED, BOOL,     last,              4)
+#define SensorTraceData_CALLBACK NULL
+#define SensorTraceData_DEFAULT NULL
+
+extern const pb_msgdesc_t SensorTraceData_msg;
+
+/* Defines for backwards compatibility with code written before nanopb-0.4.0 */
+#define SensorTraceData_fields &SensorTraceData_msg
+
+/* Maximum encoded size of messages (where known) */
+#define SENSORTRACE_PB_H_MAX_SIZE                SensorTraceData_size
+#define SensorTraceData_size                     209
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
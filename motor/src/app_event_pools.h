@@ -0,0 +1,46 @@
+#ifndef APP_EVENT_POOLS_H_
+#define APP_EVENT_POOLS_H_
+
+#include "config.h"
+#include "event_catalogue.h"
+#include "fram.h"
+#include "pc_com.h"
+#include "posted_signals.h"
+#include "pubsub_signals.h"
+#include "shared_i2c_events.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************************************************\
+* Public macros
+\**************************************************************************************************/
+
+// every event allocated from QF's pools, see event_catalogue.h
+#define APP_POOL_EVENTS(X)    \
+    PUBSUB_POOL_EVENTS(X)     \
+    POSTED_POOL_EVENTS(X)     \
+    PC_COM_POOL_EVENTS(X)     \
+    CONFIG_POOL_EVENTS(X)     \
+    FRAM_POOL_EVENTS(X)       \
+    SHARED_I2C_POOL_EVENTS(X)
+
+// blocks App_Start() gives each pool
+#define APP_SMALL_POOL_BLOCKS  EVENT_CATALOGUE_TIER_COUNT(APP_POOL_EVENTS, SMALL)
+#define APP_MEDIUM_POOL_BLOCKS EVENT_CATALOGUE_TIER_COUNT(APP_POOL_EVENTS, MEDIUM)
+#define APP_LARGE_POOL_BLOCKS  EVENT_CATALOGUE_TIER_COUNT(APP_POOL_EVENTS, LARGE)
+
+/**************************************************************************************************\
+* Public type definitions
+\**************************************************************************************************/
+
+// as big as the largest event of each pool
+typedef EVENT_CATALOGUE_TIER(APP_POOL_EVENTS, SMALL) Small_Pool_Event_T;
+typedef EVENT_CATALOGUE_TIER(APP_POOL_EVENTS, MEDIUM) Medium_Pool_Event_T;
+typedef EVENT_CATALOGUE_TIER(APP_POOL_EVENTS, LARGE) Large_Pool_Event_T;
+
+#ifdef __cplusplus
+}
+#endif
+#endif // APP_EVENT_POOLS_H_
@@ -14,6 +14,9 @@
 #define BSP_TICKS_PER_SEC         1000U
 #define MILLISECONDS_TO_TICKS(ms) ((ms) * ((BSP_TICKS_PER_SEC) / 1000))
 
+#define BSP_ADC_VBAT_SAMPLE_RATE_HZ 1000U // TIM6 trigger rate, each sample is 16x oversampled
+#define BSP_ADC_VBAT_BLOCK_LEN      50U   // samples per VBAT block (half the DMA buffer)
+
 /**************************************************************************************************\
 * Public type definitions
 \**************************************************************************************************/
@@ -35,6 +38,15 @@ void BSP_terminate(int16_t result);
  **************************************************************************************************/
 uint32_t BSP_Get_Milliseconds_Tick(void);
 
+/**
+ ***************************************************************************************************
+ * @brief   DWT cycle counter and the 64-bit microsecond clock built on it (bsp_timestamp.c)
+ **************************************************************************************************/
+void BSP_Cycle_Counter_Init(void);
+uint32_t BSP_Get_Cycle_Count(void);
+uint64_t BSP_Get_Cycle_Count_64(void);
+uint64_t BSP_Get_Microseconds(void);
+
 /**
  ***************************************************************************************************
  * @brief   Functions for blinky LED
@@ -66,6 +78,43 @@ void BSP_CAN_Bus_Init(void);
  **************************************************************************************************/
 int32_t BSP_CAN_Write_Msg(const CAN_Message_T *msg);
 
+/**
+ ***************************************************************************************************
+ * @brief   Fault confinement state and error counters of the CAN controller
+ **************************************************************************************************/
+void BSP_CAN_Get_Bus_Status(CAN_Bus_Status_T *status);
+
+/**
+ ***************************************************************************************************
+ * @brief   Next frame the FDCAN finished sending, false if there is none
+ **************************************************************************************************/
+bool BSP_CAN_Read_Tx_Event(CAN_Tx_Event_T *event);
+
+/**
+ ***************************************************************************************************
+ * @brief   FDCAN timestamp of a frame from the last 466 ms on the BSP_Get_Microseconds() clock
+ **************************************************************************************************/
+uint64_t BSP_CAN_Timestamp_To_Us(uint16_t timestamp);
+
+/**
+ ***************************************************************************************************
+ * @brief   Start the bus-off recovery sequence, the controller rejoins the bus after 128
+ *          occurrences of 11 recessive bits
+ **************************************************************************************************/
+void BSP_CAN_Bus_Recover(void);
+
+/**
+ ***************************************************************************************************
+ * @brief   Nominal and data phase bit rates frames are currently sent at
+ **************************************************************************************************/
+void BSP_CAN_Get_Bit_Rates(CAN_Bit_Rates_T *rates);
+
+/**
+ ***************************************************************************************************
+ * @brief   Fall back to sending whole frames at the nominal rate, until the next reset
+ **************************************************************************************************/
+void BSP_CAN_Disable_Bit_Rate_Switch(void);
+
 /**
  ***************************************************************************************************
  * @brief   I2C Functions
@@ -98,7 +147,13 @@ bool BSP_Get_Start();
 uint8_t BSP_Get_Temp_Good();
 uint8_t BSP_Get_Pres_Good();
 bool BSP_Get_Buzzer();
-float BSP_ADC_Read_VBAT(void);
+
+/**
+ ***************************************************************************************************
+ * @brief   VBAT ADC Functions
+ **************************************************************************************************/
+const uint16_t *BSP_ADC_Get_VBAT_Block(bool second_half);
+float BSP_ADC_VBAT_Counts_To_Volts(float counts);
 
 /**
  ***************************************************************************************************
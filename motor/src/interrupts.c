@@ -1,12 +1,21 @@
 #include "box_to_box.h"
 #include "bsp.h"
+#include "can_rx_ring.h"
 #include "flowsensor.h"
 #include "posted_signals.h"
 #include "pubsub_signals.h"
 #include "stm32g4xx_hal.h"
+#include "vbat_sensor.h"
 
 Q_DEFINE_THIS_MODULE("interrupts.c")
 
+static void drain_can_fifo(FDCAN_HandleTypeDef *hfdcan, uint32_t rx_fifo);
+
+// static events posted to Box_To_Box, nothing is allocated in the CAN interrupts
+static QEvt const s_can_frames_available_evt = QEVT_INITIALIZER(POSTED_CAN_FRAMES_AVAILABLE_SIG);
+static QEvt const s_can_tx_complete_evt      = QEVT_INITIALIZER(POSTED_CAN_TX_COMPLETE_SIG);
+static QEvt const s_can_bus_status_evt       = QEVT_INITIALIZER(POSTED_CAN_BUS_STATUS_SIG);
+
 extern bool input_capture_found;
 
 /**
@@ -73,28 +82,117 @@ void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef *htim)
 
 /**
  ***************************************************************************************************
- * @brief   CAN Message Received callback
+ * @brief   VBAT ADC2 DMA half transfer callback (first block of the circular buffer is ready)
+ **************************************************************************************************/
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    if (hadc->Instance != ADC2)
+    {
+        return;
+    }
+
+    VBAT_Sensor_Block_Callback(BSP_ADC_Get_VBAT_Block(false), BSP_ADC_VBAT_BLOCK_LEN);
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   VBAT ADC2 DMA transfer complete callback (second block of the circular buffer is ready)
+ **************************************************************************************************/
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    if (hadc->Instance != ADC2)
+    {
+        return;
+    }
+
+    VBAT_Sensor_Block_Callback(BSP_ADC_Get_VBAT_Block(true), BSP_ADC_VBAT_BLOCK_LEN);
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   CAN Message Received callbacks, FIFO0 holds the high priority messages
  *
- *          This posts a QP message directly to the BOX_TO_BOX AO
+ *          Every frame waiting in the FIFO is copied into the RX ring, and at most one
+ *          frames-available event is posted to the BOX_TO_BOX AO. Nothing is allocated here, so
+ *          a bus flooded with frames costs dropped frames (counted in the ring stats), not an
+ *          assert.
  **************************************************************************************************/
 void HAL_FDCAN_RxFifo0Callback(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo0ITs)
 {
-    HAL_StatusTypeDef retval;
-    FDCAN_RxHeaderTypeDef RxHeader;
+    if ((RxFifo0ITs & FDCAN_IT_RX_FIFO0_MESSAGE_LOST) != RESET)
+    {
+        CAN_Rx_Ring_Fifo_Lost();
+    }
 
     if ((RxFifo0ITs & FDCAN_IT_RX_FIFO0_NEW_MESSAGE) != RESET)
     {
-        CAN_Message_Received_Event_T *evt = Q_NEW(
-            CAN_Message_Received_Event_T, POSTED_CAN_MESSAGE_RECEIVED_SIG);
+        drain_can_fifo(hfdcan, FDCAN_RX_FIFO0);
+    }
+}
 
-        /* Retrieve Rx messages from RX FIFO0 */
-        retval = HAL_FDCAN_GetRxMessage(hfdcan, FDCAN_RX_FIFO0, &RxHeader, evt->msg.data);
+void HAL_FDCAN_RxFifo1Callback(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo1ITs)
+{
+    if ((RxFifo1ITs & FDCAN_IT_RX_FIFO1_MESSAGE_LOST) != RESET)
+    {
+        CAN_Rx_Ring_Fifo_Lost();
+    }
 
-        Q_ASSERT(retval == HAL_OK);
+    if ((RxFifo1ITs & FDCAN_IT_RX_FIFO1_NEW_MESSAGE) != RESET)
+    {
+        drain_can_fifo(hfdcan, FDCAN_RX_FIFO1);
+    }
+}
 
-        evt->msg.id  = RxHeader.Identifier;
-        evt->msg.dlc = RxHeader.DataLength;
+static void drain_can_fifo(FDCAN_HandleTypeDef *hfdcan, uint32_t rx_fifo)
+{
+    FDCAN_RxHeaderTypeDef RxHeader;
+    uint32_t fill_level = HAL_FDCAN_GetRxFifoFillLevel(hfdcan, rx_fifo);
+
+    for (uint32_t i = 0U; i < fill_level; i++)
+    {
+        CAN_Message_T *frame = CAN_Rx_Ring_Reserve();
+
+        if (HAL_FDCAN_GetRxMessage(hfdcan, rx_fifo, &RxHeader, frame->data) != HAL_OK)
+        {
+            break;
+        }
+
+        frame->id           = RxHeader.Identifier;
+        frame->dlc          = RxHeader.DataLength;
+        frame->timestamp_us = BSP_CAN_Timestamp_To_Us((uint16_t) RxHeader.RxTimestamp);
+        CAN_Rx_Ring_Commit();
+    }
 
-        QACTIVE_POST(AO_BOX_TO_BOX, &evt->super, 0U);
+    if (CAN_Rx_Ring_Notify_Needed())
+    {
+        if (!QACTIVE_POST_X(AO_BOX_TO_BOX, &s_can_frames_available_evt, 1U, 0U))
+        {
+            // queue full, the next frame tries again
+            CAN_Rx_Ring_Notify_Failed();
+        }
     }
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   CAN TX complete and error status callbacks
+ *
+ *          Box_To_Box refills the TX FIFO from its queue on TX complete, and reads PSR/ECR on a
+ *          bus-off or error-passive change. It also polls both periodically, so a post dropped
+ *          here for lack of queue margin only delays it.
+ **************************************************************************************************/
+void HAL_FDCAN_TxBufferCompleteCallback(FDCAN_HandleTypeDef *hfdcan, uint32_t BufferIndexes)
+{
+    (void) hfdcan;
+    (void) BufferIndexes;
+
+    (void) QACTIVE_POST_X(AO_BOX_TO_BOX, &s_can_tx_complete_evt, 2U, 0U);
+}
+
+void HAL_FDCAN_ErrorStatusCallback(FDCAN_HandleTypeDef *hfdcan, uint32_t ErrorStatusITs)
+{
+    (void) hfdcan;
+    (void) ErrorStatusITs;
+
+    (void) QACTIVE_POST_X(AO_BOX_TO_BOX, &s_can_bus_status_evt, 2U, 0U);
 }
\ No newline at end of file
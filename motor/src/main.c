@@ -22,84 +22,16 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 
-#include "LMT01.h"
-#include "blinky.h"
-#include "box_to_box.h"
+#include "app_start.h"
 #include "bsp.h"
-#include "pc_com.h"
-#include "config.h"
-#include "director.h"
-#include "fram.h"
-#include "log_com.h"
-#include "posted_signals.h"
-#include "pressure_sensor.h"
 #include "qpc.h"
 #include "reset.h"
-#include "shared_i2c.h"
-#include "shared_i2c_events.h"
-#include "usb.h"
-#include <stdbool.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
 
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
 /* USER CODE BEGIN PTD */
 
-// QP Priorities for Active Objects must be unique
-// Lower number is lower priority
-// 0 is reserved, lowest available is 1
-typedef enum
-{
-    AO_RESERVED = 0U,
-    AO_PRIO_BLINKY,
-    AO_PRIO_PC_COM,
-    AO_PRIO_CONFIG,
-    AO_PRIO_FRAM,
-    AO_PRIO_LOG_COM,
-    AO_PRIO_DIRECTOR,
-    AO_PRIO_LMT01,
-    AO_PRIO_PRESSURE,
-    AO_PRIO_SHARED_I2C2,
-    AO_PRIO_BOX_TO_BOX,
-    AO_PRIO_USB,
-} AO_Priority_T;
-
-extern const QActive *AO_SharedI2C2;
-
-typedef struct
-{
-    union
-    {
-        QEvt base_event;
-        FloatEvent_T float_event;
-    } small_messages;
-} SmallMessageUnion_T;
-typedef struct
-{
-    union
-    {
-        QEvt someMultipleQEvt[4];
-        PCCOMPrintEvent_T pc_com_print_event;
-        PCCOMCliDataEvent_T pc_com_cli_data_event;
-        DebugForceFaultEvent_T fault_event;
-        FramReadReqEvent_T fram_read_req_event;
-        ConfigEntryChangedEvent_T config_entry_changed_event;
-    } medium_messages;
-} MediumMessageUnion_T;
-typedef struct
-{
-    union
-    {
-        QEvt base_event;
-        FaultGeneratedEvent_T fault_event;
-        FramReadRespEvent_T fram_read_resp_event;
-        FramWriteReqEvent_T fram_write_req_event;
-    } large_messages;
-} LongMessageUnion_T;
-
 /* USER CODE END PTD */
 
 /* Private define ------------------------------------------------------------*/
@@ -114,11 +46,13 @@ typedef struct
 
 /* Private variables ---------------------------------------------------------*/
 ADC_HandleTypeDef hadc2;
+DMA_HandleTypeDef hdma_adc2;
 
 FDCAN_HandleTypeDef hfdcan2;
 
 I2C_HandleTypeDef hi2c2;
 
+TIM_HandleTypeDef htim6;
 TIM_HandleTypeDef htim8;
 TIM_HandleTypeDef htim15;
 
@@ -131,12 +65,14 @@ PCD_HandleTypeDef hpcd_USB_FS;
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
+static void MX_DMA_Init(void);
 static void MX_USB_PCD_Init(void);
 static void MX_I2C2_Init(void);
 static void MX_TIM8_Init(void);
 static void MX_ADC2_Init(void);
 static void MX_TIM15_Init(void);
 static void MX_FDCAN2_Init(void);
+static void MX_TIM6_Init(void);
 /* USER CODE BEGIN PFP */
 
 /* USER CODE END PFP */
@@ -180,162 +116,21 @@ int main(void)
 
     /* Initialize all configured peripherals */
     MX_GPIO_Init();
+    MX_DMA_Init();
     MX_USB_PCD_Init();
     MX_I2C2_Init();
     MX_TIM8_Init();
     MX_ADC2_Init();
     MX_TIM15_Init();
     MX_FDCAN2_Init();
+    MX_TIM6_Init();
     /* USER CODE BEGIN 2 */
 
     uint16_t priority = QF_AWARE_ISR_CMSIS_PRI;
     (void) priority; // be sure to set your QP aware interrupt priority in Cube MX to at least this
 
     BSP_Init();
-
-    size_t smallsize  = sizeof(SmallMessageUnion_T);
-    size_t mediumsize = sizeof(MediumMessageUnion_T);
-    size_t largesize  = sizeof(LongMessageUnion_T);
-    (void) smallsize;
-    (void) mediumsize;
-    (void) largesize;
-
-    // initialize event pools
-    static QF_MPOOL_EL(SmallMessageUnion_T) smlPoolSto[10];
-    QF_poolInit(smlPoolSto, sizeof(smlPoolSto), sizeof(smlPoolSto[0]));
-
-    static QF_MPOOL_EL(MediumMessageUnion_T) mediumPoolSto[20];
-    QF_poolInit(mediumPoolSto, sizeof(mediumPoolSto), sizeof(mediumPoolSto[0]));
-
-    static QF_MPOOL_EL(LongMessageUnion_T) longPoolSto[20];
-    QF_poolInit(longPoolSto, sizeof(longPoolSto), sizeof(longPoolSto[0]));
-
-    // initialize publish-subscribe
-    static QSubscrList subscrSto[PUBSUB_MAX_SIG];
-    QActive_psInit(subscrSto, Q_DIM(subscrSto));
-
-    // instantiate and start AOs/threads...
-
-    static QEvt const *blinkyQueueSto[10];
-    Blinky_ctor();
-    QACTIVE_START(
-        AO_Blinky,
-        AO_PRIO_BLINKY,        // QP prio. of the AO
-        blinkyQueueSto,        // event queue storage
-        Q_DIM(blinkyQueueSto), // queue length [events]
-        (void *) 0,
-        0U,          // no stack storage
-        (void *) 0); // no initialization param
-
-    static QEvt const *shared_i2c1_QueueSto[10];
-    // AO_SharedI2C constructor is called in BSP_Init
-    QACTIVE_START(
-        AO_SharedI2C2,
-        AO_PRIO_SHARED_I2C2,         // QP prio. of the AO
-        shared_i2c1_QueueSto,        // event queue storage
-        Q_DIM(shared_i2c1_QueueSto), // queue length [events]
-        (void *) 0,                  // stack storage (not used in QK)
-        0U,                          // stack size [bytes] (not used in QK)
-        (void *) 0);                 // no initialization param
-
-    // static QEvt const *PressureQueueSto[10];
-    // Pressure_Sensor_ctor(BSP_Get_I2C_Write_Pressure(), BSP_Get_I2C_Read_Pressure());
-    // QACTIVE_START(
-    //     AO_Pressure,
-    //     AO_PRIO_PRESSURE,        // QP prio. of the AO
-    //     PressureQueueSto,        // event queue storage
-    //     Q_DIM(PressureQueueSto), // queue length [events]
-    //     (void *) 0,
-    //     0U,          // no stack storage
-    //     (void *) 0); // no initialization param
-
-    static QEvt const *LMT01QueueSto[10];
-    LMT01_ctor();
-    QACTIVE_START(
-        AO_LMT01,
-        AO_PRIO_LMT01,        // QP prio. of the AO
-        LMT01QueueSto,        // event queue storage
-        Q_DIM(LMT01QueueSto), // queue length [events]
-        (void *) 0,
-        0U,          // no stack storage
-        (void *) 0); // no initialization param
-
-    static QEvt const *box_to_box_QueueSto[20];
-    Box_To_Box_ctor();
-    QACTIVE_START(
-        AO_BOX_TO_BOX,
-        AO_PRIO_BOX_TO_BOX,         // QP prio. of the AO
-        box_to_box_QueueSto,        // event queue storage
-        Q_DIM(box_to_box_QueueSto), // queue length [events]
-        (void *) 0,                 // stack storage (not used in QK)
-        0U,                         // stack size [bytes] (not used in QK)
-        (void *) 0);                // no initialization param
-
-    static QEvt const *config_QueueSto[10];
-    Config_ctor();
-    QACTIVE_START(
-        AO_Config,
-        AO_PRIO_CONFIG,         // QP prio. of the AO
-        config_QueueSto,        // event queue storage
-        Q_DIM(config_QueueSto), // queue length [events]
-        (void *) 0,
-        0U,
-        (void *) 0);
-
-    static QEvt const *fram_QueueSto[10];
-    Fram_ctor(BSP_Get_I2C_Write_FRAM(), BSP_Get_I2C_Memory_Read_FRAM());
-    QACTIVE_START(
-        AO_Fram,
-        AO_PRIO_FRAM,         // QP prio. of the AO
-        fram_QueueSto,        // event queue storage
-        Q_DIM(fram_QueueSto), // queue length [events]
-        (void *) 0,
-        0U,
-        (void *) 0);
-
-    static QEvt const *DirectorQueueSto[10];
-    Director_ctor();
-    QACTIVE_START(
-        AO_Director,
-        AO_PRIO_DIRECTOR,        // QP prio. of the AO
-        DirectorQueueSto,        // event queue storage
-        Q_DIM(DirectorQueueSto), // queue length [events]
-        (void *) 0,
-        0U,          // no stack storage
-        (void *) 0); // no initialization param
-
-    static QEvt const *pc_com_QueueSto[10];
-    PC_COM_ctor(BSP_Get_Serial_IO_Interface_USB0());
-    QACTIVE_START(
-        AO_PC_COM,
-        AO_PRIO_PC_COM,         // QP prio. of the AO
-        pc_com_QueueSto,        // event queue storage
-        Q_DIM(pc_com_QueueSto), // queue length [events]
-        (void *) 0,             // stack storage (not used in QK)
-        0U,                     // stack size [bytes] (not used in QK)
-        (void *) 0);            // no initialization param
-
-    static QEvt const *log_com_QueueSto[20];
-    LogCom_ctor(BSP_Get_Serial_IO_Interface_USB1());
-    QACTIVE_START(
-        AO_LogCom,
-        AO_PRIO_LOG_COM,         // QP prio. of the AO
-        log_com_QueueSto,        // event queue storage
-        Q_DIM(log_com_QueueSto), // queue length [events]
-        (void *) 0,              // stack storage (not used in QK)
-        0U,                      // stack size [bytes] (not used in QK)
-        (void *) 0);             // no initialization param
-
-    static QEvt const *usb_QueueSto[10];
-    USB_ctor();
-    QACTIVE_START(
-        AO_USB,
-        AO_PRIO_USB,         // QP prio. of the AO
-        usb_QueueSto,        // event queue storage
-        Q_DIM(usb_QueueSto), // queue length [events]
-        (void *) 0,          // stack storage (not used in QK)
-        0U,                  // stack size [bytes] (not used in QK)
-        (void *) 0);         // no initialization param
+    App_Start(); // event pools, publish-subscribe and the AOs
 
     return QF_run(); // run the QF application
                      /* USER CODE END 2 */
@@ -416,22 +211,26 @@ static void MX_ADC2_Init(void)
 
     /** Common config
      */
-    hadc2.Instance                   = ADC2;
-    hadc2.Init.ClockPrescaler        = ADC_CLOCK_SYNC_PCLK_DIV4;
-    hadc2.Init.Resolution            = ADC_RESOLUTION_12B;
-    hadc2.Init.DataAlign             = ADC_DATAALIGN_RIGHT;
-    hadc2.Init.GainCompensation      = 0;
-    hadc2.Init.ScanConvMode          = ADC_SCAN_DISABLE;
-    hadc2.Init.EOCSelection          = ADC_EOC_SINGLE_CONV;
-    hadc2.Init.LowPowerAutoWait      = DISABLE;
-    hadc2.Init.ContinuousConvMode    = DISABLE;
-    hadc2.Init.NbrOfConversion       = 1;
-    hadc2.Init.DiscontinuousConvMode = DISABLE;
-    hadc2.Init.ExternalTrigConv      = ADC_SOFTWARE_START;
-    hadc2.Init.ExternalTrigConvEdge  = ADC_EXTERNALTRIGCONVEDGE_NONE;
-    hadc2.Init.DMAContinuousRequests = DISABLE;
-    hadc2.Init.Overrun               = ADC_OVR_DATA_PRESERVED;
-    hadc2.Init.OversamplingMode      = DISABLE;
+    hadc2.Instance                                = ADC2;
+    hadc2.Init.ClockPrescaler                     = ADC_CLOCK_SYNC_PCLK_DIV4;
+    hadc2.Init.Resolution                         = ADC_RESOLUTION_12B;
+    hadc2.Init.DataAlign                          = ADC_DATAALIGN_RIGHT;
+    hadc2.Init.GainCompensation                   = 0;
+    hadc2.Init.ScanConvMode                       = ADC_SCAN_DISABLE;
+    hadc2.Init.EOCSelection                       = ADC_EOC_SINGLE_CONV;
+    hadc2.Init.LowPowerAutoWait                   = DISABLE;
+    hadc2.Init.ContinuousConvMode                 = DISABLE;
+    hadc2.Init.NbrOfConversion                    = 1;
+    hadc2.Init.DiscontinuousConvMode              = DISABLE;
+    hadc2.Init.ExternalTrigConv                   = ADC_EXTERNALTRIG_T6_TRGO;
+    hadc2.Init.ExternalTrigConvEdge               = ADC_EXTERNALTRIGCONVEDGE_RISING;
+    hadc2.Init.DMAContinuousRequests              = ENABLE;
+    hadc2.Init.Overrun                            = ADC_OVR_DATA_OVERWRITTEN;
+    hadc2.Init.OversamplingMode                   = ENABLE;
+    hadc2.Init.Oversampling.Ratio                 = ADC_OVERSAMPLING_RATIO_16;
+    hadc2.Init.Oversampling.RightBitShift         = ADC_RIGHTBITSHIFT_4;
+    hadc2.Init.Oversampling.TriggeredMode         = ADC_TRIGGEREDMODE_SINGLE_TRIGGER;
+    hadc2.Init.Oversampling.OversamplingStopReset = ADC_REGOVERSAMPLING_CONTINUED_MODE;
     if (HAL_ADC_Init(&hadc2) != HAL_OK)
     {
         Error_Handler();
@@ -441,7 +240,7 @@ static void MX_ADC2_Init(void)
      */
     sConfig.Channel      = ADC_CHANNEL_15;
     sConfig.Rank         = ADC_REGULAR_RANK_1;
-    sConfig.SamplingTime = ADC_SAMPLETIME_2CYCLES_5;
+    sConfig.SamplingTime = ADC_SAMPLETIME_47CYCLES_5;
     sConfig.SingleDiff   = ADC_SINGLE_ENDED;
     sConfig.OffsetNumber = ADC_OFFSET_NONE;
     sConfig.Offset       = 0;
@@ -483,9 +282,9 @@ static void MX_FDCAN2_Init(void)
     hfdcan2.Init.DataSyncJumpWidth    = 1;
     hfdcan2.Init.DataTimeSeg1         = 13;
     hfdcan2.Init.DataTimeSeg2         = 2;
-    hfdcan2.Init.StdFiltersNbr        = 1;
+    hfdcan2.Init.StdFiltersNbr        = 8;
     hfdcan2.Init.ExtFiltersNbr        = 0;
-    hfdcan2.Init.TxFifoQueueMode      = FDCAN_TX_FIFO_OPERATION;
+    hfdcan2.Init.TxFifoQueueMode      = FDCAN_TX_QUEUE_OPERATION;
     if (HAL_FDCAN_Init(&hfdcan2) != HAL_OK)
     {
         Error_Handler();
@@ -541,6 +340,44 @@ static void MX_I2C2_Init(void)
     /* USER CODE END I2C2_Init 2 */
 }
 
+/**
+ * @brief TIM6 Initialization Function
+ * @param None
+ * @retval None
+ */
+static void MX_TIM6_Init(void)
+{
+    /* USER CODE BEGIN TIM6_Init 0 */
+
+    /* USER CODE END TIM6_Init 0 */
+
+    TIM_MasterConfigTypeDef sMasterConfig = {0};
+
+    /* USER CODE BEGIN TIM6_Init 1 */
+
+    // TIM6 is the ADC2 (VBAT) conversion trigger: 144Mhz/(143+1) = 1Mhz, /(999+1) = 1kHz TRGO
+
+    /* USER CODE END TIM6_Init 1 */
+    htim6.Instance               = TIM6;
+    htim6.Init.Prescaler         = 143;
+    htim6.Init.CounterMode       = TIM_COUNTERMODE_UP;
+    htim6.Init.Period            = 999;
+    htim6.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+    if (HAL_TIM_Base_Init(&htim6) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    sMasterConfig.MasterOutputTrigger = TIM_TRGO_UPDATE;
+    sMasterConfig.MasterSlaveMode     = TIM_MASTERSLAVEMODE_DISABLE;
+    if (HAL_TIMEx_MasterConfigSynchronization(&htim6, &sMasterConfig) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    /* USER CODE BEGIN TIM6_Init 2 */
+
+    /* USER CODE END TIM6_Init 2 */
+}
+
 /**
  * @brief TIM8 Initialization Function
  * @param None
@@ -686,6 +523,21 @@ static void MX_USB_PCD_Init(void)
     /* USER CODE END USB_Init 2 */
 }
 
+/**
+ * Enable DMA controller clock
+ */
+static void MX_DMA_Init(void)
+{
+    /* DMA controller clock enable */
+    __HAL_RCC_DMAMUX1_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    /* DMA interrupt init */
+    /* DMA1_Channel1_IRQn interrupt configuration */
+    HAL_NVIC_SetPriority(DMA1_Channel1_IRQn, 4, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+}
+
 /**
  * @brief GPIO Initialization Function
  * @param None
@@ -1,8 +1,10 @@
 #include "LMT01.h"
 #include "bsp.h"
 #include "fault_manager.h"
+#include "filters.h"
 #include "private_signal_ranges.h"
 #include "pubsub_signals.h"
+#include "sensor_trace.h"
 #include "stm32g4xx_hal.h"
 #include <stdbool.h>
 
@@ -14,12 +16,11 @@ Q_DEFINE_THIS_MODULE("LMT01")
 * Private macros
 \**************************************************************************************************/
 
-#define LAMBDA 0.95
 #define LMT01_POLL_TICKS              (BSP_TICKS_PER_SEC / 100U)
 #define LMT01_NO_PULSE_TIMEOUT_MS     1000U
 #define LMT01_NO_PULSE_TIMEOUT_COUNTS \
     (MILLISECONDS_TO_TICKS(LMT01_NO_PULSE_TIMEOUT_MS) / LMT01_POLL_TICKS)
-#define LMT01_INVALID_TEMPERATURE_C (-999.0f)
+#define LMT01_TEMPERATURE_EMA_ALPHA 0.05f // weight of each new reading
 
 /**************************************************************************************************\
 * Private type definitions
@@ -35,7 +36,7 @@ typedef struct
     QActive super; // inherit QActive
     QTimeEvt timer_evt;
     uint16_t lmt01_counter;
-    float temperature;
+    Filter_EMA_F32_T temperature_filter;
     uint16_t no_pulse_counts;
     bool no_pulse_fault_reported;
 } LMT01;
@@ -72,7 +73,7 @@ void LMT01_ctor()
     QTimeEvt_ctorX(&me->timer_evt, &me->super, WAIT_TIMEOUT_SIG, 0U);
 
     me->lmt01_counter = 0U;
-    me->temperature = LMT01_INVALID_TEMPERATURE_C;
+    Filter_EMA_F32_Init(&me->temperature_filter, LMT01_TEMPERATURE_EMA_ALPHA, true);
     me->no_pulse_counts = 0U;
     me->no_pulse_fault_reported = false;
 
@@ -138,19 +139,21 @@ static QState running(LMT01 *const me, QEvt const *const e)
             {
                 __HAL_TIM_SET_COUNTER(&htim8, 0); // reset the timer
 
+                Sensor_Trace_Record(SENSOR_TRACE_LMT01_COUNT, me->lmt01_counter);
+
                 // deglitching
                 if (me->lmt01_counter > 10)
                 {
                     float new_temperature = (me->lmt01_counter * 0.0625f) -
-                        50; // temperature in degrees C
+                        50.0f; // temperature in degrees C
 
-                    if (me->temperature == LMT01_INVALID_TEMPERATURE_C)
-                        me->temperature = new_temperature;
-                    else
-                        me->temperature = LAMBDA * me->temperature + (1 - LAMBDA) * new_temperature;
+                    float filtered = Filter_EMA_F32_Update(
+                        &me->temperature_filter, new_temperature);
 
-                    FloatEvent_T *event = Q_NEW(FloatEvent_T, PUBSUB_TEMPERATURE_SIG);
-                    event->num          = me->temperature;
+                    FloatEvent_T *event = EVENT_CATALOGUE_NEW(
+                        PUBSUB_POOL_EVENTS, FloatEvent_T, PUBSUB_TEMPERATURE_SIG);
+                    event->num          = filtered;
+                    event->timestamp_us = BSP_Get_Microseconds();
                     QACTIVE_PUBLISH(&event->super, &me->super);
                 }
             }
@@ -1,11 +1,16 @@
 #include "cli_commands.h"
 #include "blinky.h"
+#include "box_to_box.h"
 #include "bsp.h"
 #include "bsp_manual.h"
+#include "can_tx_queue.h"
 #include "cli_manual_commands.h"
+#include "cli_shared_commands.h"
 #include "config.h"
+#include "filters.h"
 #include "interfaces/gpio.h"
 #include "interfaces/i2c_bus.h"
+#include "kernel_bench.h"
 #include "posted_signals.h"
 #include "reset.h"
 #include "qpc.h"
@@ -34,10 +39,34 @@ static void on_cli_config_read(EmbeddedCli *cli, char *args, void *context);
 static void on_cli_config_set(EmbeddedCli *cli, char *args, void *context);
 static void on_cli_config_save(EmbeddedCli *cli, char *args, void *context);
 static void on_bootloader(EmbeddedCli *cli, char *args, void *context);
+static void on_cli_can_tx_stats(EmbeddedCli *cli, char *args, void *context);
+static void setup_filter_kernels(void);
+static size_t bench_ema_f32_call(uint32_t i);
+static size_t bench_ema_q15_call(uint32_t i);
+static size_t bench_biquad_call(uint32_t i);
+static size_t bench_median_call(uint32_t i);
+static size_t bench_rate_limit_call(uint32_t i);
 static bool is_numeric(const char *s);
 static bool is_positive_numeric(const char *s);
 static void lowercase(const char *src, char *dst, unsigned max_len);
 
+// Filter state for the bench command's filter kernels, which feed them a ramp
+static Filter_EMA_F32_T bench_ema;
+static Filter_EMA_Q15_T bench_ema_q15;
+static Filter_Biquad_F32_T bench_biquad;
+static Filter_Median_F32_T bench_median;
+static Filter_Rate_Limit_F32_T bench_rate_limit;
+static volatile float bench_sink;
+static volatile int16_t bench_sink_q15;
+
+static const Kernel_Bench_T filter_kernels[] = {
+    {"filter-ema-f32", setup_filter_kernels, bench_ema_f32_call},
+    {"filter-ema-q15", setup_filter_kernels, bench_ema_q15_call},
+    {"filter-biquad", setup_filter_kernels, bench_biquad_call},
+    {"filter-median-5", setup_filter_kernels, bench_median_call},
+    {"filter-rate-limit", setup_filter_kernels, bench_rate_limit_call},
+};
+
 static CliCommandBinding cli_cmd_list[] = {
 
     (CliCommandBinding) {
@@ -114,6 +143,14 @@ static CliCommandBinding cli_cmd_list[] = {
         NULL,
         on_bootloader,
     },
+
+    (CliCommandBinding) {
+        "can-tx-stats",
+        "Print the motor data CAN frames the deadbands saved, the TX queue and the bus state",
+        false,
+        NULL,
+        on_cli_can_tx_stats,
+    },
 };
 
 void CLI_AddCommands(EmbeddedCli *cli)
@@ -122,6 +159,7 @@ void CLI_AddCommands(EmbeddedCli *cli)
     {
         embeddedCliAddBinding(cli, cli_cmd_list[i]);
     }
+    CLI_Shared_AddCommands(cli, filter_kernels, DIMENSION_OF(filter_kernels));
 }
 
 static void on_bootloader(EmbeddedCli *cli, char *args, void *context)
@@ -133,6 +171,125 @@ static void on_bootloader(EmbeddedCli *cli, char *args, void *context)
     Reset_RequestBootloader();
 }
 
+static void setup_filter_kernels(void)
+{
+    Filter_Biquad_Coeffs_T coeffs;
+
+    Filter_EMA_F32_Init(&bench_ema, 0.1f, false);
+    Filter_EMA_Q15_Init(&bench_ema_q15, FILTER_FLOAT_TO_Q15(0.1f), false);
+    Filter_Biquad_Lowpass_Coeffs(&coeffs, 5.0f, 100.0f, 0.7071f);
+    Filter_Biquad_F32_Init(&bench_biquad, &coeffs);
+    Filter_Median_F32_Init(&bench_median, 5U);
+    Filter_Rate_Limit_F32_Init(&bench_rate_limit, 1.0f, 1.0f);
+}
+
+static size_t bench_ema_f32_call(uint32_t i)
+{
+    bench_sink = Filter_EMA_F32_Update(&bench_ema, (float) i);
+    return 0U;
+}
+
+static size_t bench_ema_q15_call(uint32_t i)
+{
+    bench_sink_q15 = Filter_EMA_Q15_Update(&bench_ema_q15, (int16_t) i);
+    return 0U;
+}
+
+static size_t bench_biquad_call(uint32_t i)
+{
+    bench_sink = Filter_Biquad_F32_Update(&bench_biquad, (float) i);
+    return 0U;
+}
+
+static size_t bench_median_call(uint32_t i)
+{
+    bench_sink = Filter_Median_F32_Update(&bench_median, (float) i);
+    return 0U;
+}
+
+static size_t bench_rate_limit_call(uint32_t i)
+{
+    bench_sink = Filter_Rate_Limit_F32_Update(&bench_rate_limit, (float) i);
+    return 0U;
+}
+
+static void on_cli_can_tx_stats(EmbeddedCli *cli, char *args, void *context)
+{
+    (void) args;
+    (void) context;
+
+    char print_buffer[CLI_PRINT_BUFFER_SIZE] = {0};
+    Box_To_Box_Stats_T stats;
+    CAN_Tx_Queue_Stats_T queue_stats;
+
+    Box_To_Box_Get_Stats(&stats);
+    CAN_Tx_Queue_Get_Stats(&queue_stats);
+
+    // share of motor data events that did not need a frame
+    uint32_t saved_percent = 0U;
+    if (stats.motor_data_events > 0U)
+    {
+        saved_percent = (uint32_t) (((uint64_t) stats.motor_data_suppressed * 100U) /
+                                    stats.motor_data_events);
+    }
+
+    snprintf(
+        print_buffer,
+        sizeof(print_buffer),
+        "motor data events %lu, frames %lu (heartbeat %lu), suppressed %lu (%lu%% bus load saved)",
+        (unsigned long) stats.motor_data_events,
+        (unsigned long) stats.motor_data_frames,
+        (unsigned long) stats.heartbeat_frames,
+        (unsigned long) stats.motor_data_suppressed,
+        (unsigned long) saved_percent);
+    embeddedCliPrint(cli, print_buffer);
+
+    snprintf(
+        print_buffer,
+        sizeof(print_buffer),
+        "tx queue %lu queued, %lu sent, %lu replaced, %lu deferred, high water %lu",
+        (unsigned long) queue_stats.queued,
+        (unsigned long) queue_stats.sent,
+        (unsigned long) queue_stats.replaced,
+        (unsigned long) queue_stats.deferred,
+        (unsigned long) queue_stats.high_water);
+    embeddedCliPrint(cli, print_buffer);
+
+    static const char *const bus_state_names[] = {
+        [CAN_BUS_STATE_ACTIVE]  = "active",
+        [CAN_BUS_STATE_WARNING] = "warning",
+        [CAN_BUS_STATE_PASSIVE] = "passive",
+        [CAN_BUS_STATE_OFF]     = "off",
+    };
+    snprintf(
+        print_buffer,
+        sizeof(print_buffer),
+        "bus %s (TEC %u, REC %u), error passive %lu, bus off %lu, recoveries %lu",
+        bus_state_names[stats.bus.state],
+        (unsigned) stats.bus.tx_errors,
+        (unsigned) stats.bus.rx_errors,
+        (unsigned long) stats.error_passive_events,
+        (unsigned long) stats.bus_off_events,
+        (unsigned long) stats.bus_off_recoveries);
+    embeddedCliPrint(cli, print_buffer);
+
+    CAN_Bit_Rates_T rates;
+    BSP_CAN_Get_Bit_Rates(&rates);
+    snprintf(
+        print_buffer,
+        sizeof(print_buffer),
+        "bit rate %lu/%lu kbit/s (BRS %s, %lu fallbacks), load %u.%u%% (%u.%u%% without BRS)",
+        (unsigned long) (rates.nominal_bps / 1000U),
+        (unsigned long) (rates.data_bps / 1000U),
+        rates.brs ? "on" : "off",
+        (unsigned long) stats.brs_fallbacks,
+        (unsigned) (stats.bus_load / 10U),
+        (unsigned) (stats.bus_load % 10U),
+        (unsigned) (stats.bus_load_nominal / 10U),
+        (unsigned) (stats.bus_load_nominal % 10U));
+    embeddedCliPrint(cli, print_buffer);
+}
+
 static void on_fault(EmbeddedCli *cli, char *args, void *context)
 {
     char print_buffer[CLI_PRINT_BUFFER_SIZE] = {0};
@@ -1,8 +1,10 @@
 #include "config.h"
+#include "director.h"
 #include "fram.h"
 #include "log_com.h"
 #include "posted_signals.h"
 #include "pubsub_signals.h"
+#include <assert.h>
 #include <string.h>
 
 Q_DEFINE_THIS_MODULE("config")
@@ -56,6 +58,74 @@ QActive *const AO_Config = &Config_inst.super;
 static const uint32_t VERSION        = 0U;
 static ConfigDBEntry_T s_config_db[] = {
     {CFG_ID_ENGINE_MINUTES, CFG_VAL_TYPE_U32, {.u32_val = 0U}, {.u32_val = 0U}, "engine_minutes"},
+
+    // Director sampling rates, new entries are only ever appended so older NVM files still load
+    {CFG_ID_DIRECTOR_FLAGS_HZ,
+     CFG_VAL_TYPE_U32,
+     {.u32_val = DIRECTOR_FLAGS_HZ},
+     {.u32_val = DIRECTOR_FLAGS_HZ},
+     "director_flags_hz"},
+    {CFG_ID_DIRECTOR_RPM_HZ,
+     CFG_VAL_TYPE_U32,
+     {.u32_val = DIRECTOR_RPM_HZ},
+     {.u32_val = DIRECTOR_RPM_HZ},
+     "director_rpm_hz"},
+    {CFG_ID_DIRECTOR_TEMPERATURE_HZ,
+     CFG_VAL_TYPE_U32,
+     {.u32_val = DIRECTOR_TEMPERATURE_HZ},
+     {.u32_val = DIRECTOR_TEMPERATURE_HZ},
+     "director_temperature_hz"},
+    {CFG_ID_DIRECTOR_PRESSURE_HZ,
+     CFG_VAL_TYPE_U32,
+     {.u32_val = DIRECTOR_PRESSURE_HZ},
+     {.u32_val = DIRECTOR_PRESSURE_HZ},
+     "director_pressure_hz"},
+    {CFG_ID_DIRECTOR_VBAT_HZ,
+     CFG_VAL_TYPE_U32,
+     {.u32_val = DIRECTOR_VBAT_HZ},
+     {.u32_val = DIRECTOR_VBAT_HZ},
+     "director_vbat_hz"},
+    {CFG_ID_DIRECTOR_ENGINE_MINUTES_HZ,
+     CFG_VAL_TYPE_U32,
+     {.u32_val = DIRECTOR_ENGINE_MINUTES_HZ},
+     {.u32_val = DIRECTOR_ENGINE_MINUTES_HZ},
+     "director_engine_minutes_hz"},
+
+    // Box to Box motor data frames only go out when a field moves more than its deadband,
+    // or when the heartbeat interval expires
+    {CFG_ID_CAN_TEMPERATURE_DEADBAND,
+     CFG_VAL_TYPE_F32,
+     {.f32_val = 0.5f},
+     {.f32_val = 0.5f},
+     "can_temperature_deadband"},
+    {CFG_ID_CAN_PRESSURE_DEADBAND,
+     CFG_VAL_TYPE_F32,
+     {.f32_val = 0.1f},
+     {.f32_val = 0.1f},
+     "can_pressure_deadband"},
+    {CFG_ID_CAN_TACHOMETER_DEADBAND,
+     CFG_VAL_TYPE_F32,
+     {.f32_val = 20.0f},
+     {.f32_val = 20.0f},
+     "can_tachometer_deadband"},
+    {CFG_ID_CAN_VBAT_DEADBAND,
+     CFG_VAL_TYPE_F32,
+     {.f32_val = 0.05f},
+     {.f32_val = 0.05f},
+     "can_vbat_deadband"},
+    {CFG_ID_CAN_HEARTBEAT_MS,
+     CFG_VAL_TYPE_U32,
+     {.u32_val = 250U},
+     {.u32_val = 250U},
+     "can_heartbeat_ms"},
+
+    // 1: 48 byte float frame, 2: 12 byte scaled integer frame. v2 has no room for the motor's
+    // clock, the sample ages or the updated bits, so v1 stays the default until it does
+    {CFG_ID_CAN_MOTOR_DATA_VERSION,
+     CFG_VAL_TYPE_U32,
+     {.u32_val = 1U},
+     {.u32_val = 1U},
+     "can_motor_data_version"},
 };
 
 static_assert(
@@ -274,7 +344,8 @@ static QState Config_loading(Config *const me, QEvt const *const e)
     switch (e->sig)
     {
         case Q_ENTRY_SIG: {
-            FramReadReqEvent_T *read_req_evt = Q_NEW(FramReadReqEvent_T, POSTED_FRAM_READ_REQ_SIG);
+            FramReadReqEvent_T *read_req_evt = EVENT_CATALOGUE_NEW(
+                FRAM_POOL_EVENTS, FramReadReqEvent_T, POSTED_FRAM_READ_REQ_SIG);
             read_req_evt->requester          = &me->super;
             QACTIVE_POST(AO_Fram, &read_req_evt->super, &me->super);
             status = Q_HANDLED();
@@ -288,12 +359,22 @@ static QState Config_loading(Config *const me, QEvt const *const e)
             {
                 memcpy(&nvm_file, read_resp_evt->file.data, sizeof(nvm_file));
 
-                if ((nvm_file.version == VERSION) && (nvm_file.num_elements == CFG_ID_NUM_IDS))
+                // entries are only ever appended, so a file saved before the newer entries existed
+                // is still valid: load what it has and leave the rest at their defaults
+                if (
+                    (nvm_file.version == VERSION) && (nvm_file.num_elements > 0U) &&
+                    (nvm_file.num_elements <= CFG_ID_NUM_IDS))
                 {
-                    for (unsigned i = 0; i < CFG_ID_NUM_IDS; i++)
+                    for (unsigned i = 0; i < nvm_file.num_elements; i++)
                     {
                         s_config_db[i].val = nvm_file.values[i].val;
                     }
+                    // past the saved entries the buffer holds whatever followed the old file,
+                    // so the saved value of an entry it didn't have reads as its default
+                    for (unsigned i = nvm_file.num_elements; i < CFG_ID_NUM_IDS; i++)
+                    {
+                        nvm_file.values[i].val = s_config_db[i].default_val;
+                    }
                     nvm_file_is_valid = true;
                     LogCom_Printf("config loaded from FRAM");
                 }
@@ -354,7 +435,8 @@ static QState Config_busy_saving(Config *const me, QEvt const *const e)
     switch (e->sig)
     {
         case Q_ENTRY_SIG: {
-            FramWriteReqEvent_T *write_evt = Q_NEW(FramWriteReqEvent_T, POSTED_FRAM_WRITE_REQ_SIG);
+            FramWriteReqEvent_T *write_evt = EVENT_CATALOGUE_NEW(
+                FRAM_POOL_EVENTS, FramWriteReqEvent_T, POSTED_FRAM_WRITE_REQ_SIG);
             write_evt->requester           = &me->super;
 
             for (unsigned i = 0; i < CFG_ID_NUM_IDS; i++)
@@ -390,8 +472,8 @@ static QState Config_busy_saving(Config *const me, QEvt const *const e)
 
 static void Config_PublishEntryChanged(ConfigID_T id)
 {
-    ConfigEntryChangedEvent_T *event = Q_NEW(
-        ConfigEntryChangedEvent_T, PUBSUB_CONFIG_ENTRY_CHANGED_SIG);
+    ConfigEntryChangedEvent_T *event = EVENT_CATALOGUE_NEW(
+        CONFIG_POOL_EVENTS, ConfigEntryChangedEvent_T, PUBSUB_CONFIG_ENTRY_CHANGED_SIG);
     event->id = id;
     QACTIVE_PUBLISH(&event->super, AO_Config);
 }
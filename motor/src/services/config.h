@@ -1,6 +1,7 @@
 #ifndef CONFIG_H_
 #define CONFIG_H_
 
+#include "event_catalogue.h"
 #include "qpc.h"
 #include <stdbool.h>
 #include <stdint.h>
@@ -16,6 +17,18 @@ typedef enum
 typedef enum
 {
     CFG_ID_ENGINE_MINUTES,
+    CFG_ID_DIRECTOR_FLAGS_HZ,
+    CFG_ID_DIRECTOR_RPM_HZ,
+    CFG_ID_DIRECTOR_TEMPERATURE_HZ,
+    CFG_ID_DIRECTOR_PRESSURE_HZ,
+    CFG_ID_DIRECTOR_VBAT_HZ,
+    CFG_ID_DIRECTOR_ENGINE_MINUTES_HZ,
+    CFG_ID_CAN_TEMPERATURE_DEADBAND,
+    CFG_ID_CAN_PRESSURE_DEADBAND,
+    CFG_ID_CAN_TACHOMETER_DEADBAND,
+    CFG_ID_CAN_VBAT_DEADBAND,
+    CFG_ID_CAN_HEARTBEAT_MS,
+    CFG_ID_CAN_MOTOR_DATA_VERSION,
     CFG_ID_NUM_IDS,
     CFG_ID_INVALID = CFG_ID_NUM_IDS
 } ConfigID_T;
@@ -26,6 +39,9 @@ typedef struct
     ConfigID_T id;
 } ConfigEntryChangedEvent_T;
 
+// pool events, see event_catalogue.h; Config_SetDefaultAll() publishes every entry at once
+#define CONFIG_POOL_EVENTS(X) X(ConfigEntryChangedEvent_T, CFG_ID_NUM_IDS + 1U)
+
 extern QActive *const AO_Config;
 
 void Config_ctor(void);
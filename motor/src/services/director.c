@@ -1,10 +1,13 @@
 #include "director.h"
 #include "bsp.h"
 #include "config.h"
+#include "filters.h"
 #include "flowsensor.h"
 #include "private_signal_ranges.h"
 #include "pubsub_signals.h"
+#include "sensor_trace.h"
 #include "stm32g4xx_hal.h"
+#include <assert.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -16,11 +19,18 @@ Q_DEFINE_THIS_MODULE("Director")
 * Private macros
 \**************************************************************************************************/
 
-#define TACH_LAMBDA 0.9
-#define VBAT_LAMBDA 0.99
+#define TACH_EMA_TAU_S               0.09f // alpha 0.1 at the default 100 Hz RPM rate
+#define VBAT_EMA_ALPHA               0.05f // per 50 ms VBAT block, ~1 s time constant
+#define TACH_HZ_TO_RPM               (60.0f / 6.666f) // Hz to RPM + fudge factor for BF20
 #define ENGINE_RUNNING_RPM_THRESHOLD 1.0f
 #define ENGINE_MINUTE_PERIOD_MS      60000U
 
+#define SCHEDULER_TICK_PERIOD (BSP_TICKS_PER_SEC / DIRECTOR_SCHEDULER_HZ)
+
+static_assert(
+    (BSP_TICKS_PER_SEC % DIRECTOR_SCHEDULER_HZ) == 0U,
+    "Director scheduler tick must be a whole number of QF ticks");
+
 /**************************************************************************************************\
 * Private type definitions
 \**************************************************************************************************/
@@ -31,16 +41,53 @@ enum PressureSignals
     ENGINE_MINUTE_TIMEOUT_SIG,
 };
 
+// Rate groups, fields that are sampled and published together
+typedef enum
+{
+    RATE_GROUP_FLAGS,
+    RATE_GROUP_TACHOMETER,
+    RATE_GROUP_TEMPERATURE,
+    RATE_GROUP_PRESSURE,
+    RATE_GROUP_VBAT,
+    RATE_GROUP_ENGINE_MINUTES,
+    RATE_GROUP_NUM
+} RateGroupID_T;
+
+typedef struct
+{
+    ConfigID_T rate_config_id; // U32 rate override in Hz
+    uint32_t default_hz;       // compile-time rate, used until config is ready
+    uint8_t updated_bit;       // MOTOR_DATA_UPDATED_*
+} RateGroupInfo_T;
+
+typedef struct
+{
+    uint16_t period_ticks; // scheduler ticks between samples
+    uint16_t countdown;    // scheduler ticks until the next sample
+} RateGroup_T;
+
 typedef struct
 {
     QActive super; // inherit QActive
     QTimeEvt timer_evt;
     QTimeEvt engine_minute_evt;
 
+    RateGroup_T rate_groups[RATE_GROUP_NUM];
+
+    bool neutral;
+    bool start;
+    bool temp_good;
+    bool pres_good;
+    bool buzzer;
+    uint32_t engine_minutes;
     float pressure;
     float temperature;
-    float vbat_volts;
-    float tachometer;
+    uint64_t pressure_timestamp_us;    // 0 until the first pressure sample
+    uint64_t temperature_timestamp_us; // 0 until the first temperature sample
+    Filter_EMA_F32_T vbat_filter;
+    float vbat_min_volts;
+    float vbat_max_volts;
+    Filter_EMA_F32_T tach_filter;
     bool config_ready;
 } Director;
 
@@ -50,6 +97,22 @@ typedef struct
 static Director director_inst;
 QActive *const AO_Director = &director_inst.super;
 
+static const RateGroupInfo_T s_rate_group_info[RATE_GROUP_NUM] = {
+    [RATE_GROUP_FLAGS] =
+        {CFG_ID_DIRECTOR_FLAGS_HZ, DIRECTOR_FLAGS_HZ, MOTOR_DATA_UPDATED_FLAGS},
+    [RATE_GROUP_TACHOMETER] =
+        {CFG_ID_DIRECTOR_RPM_HZ, DIRECTOR_RPM_HZ, MOTOR_DATA_UPDATED_TACHOMETER},
+    [RATE_GROUP_TEMPERATURE] =
+        {CFG_ID_DIRECTOR_TEMPERATURE_HZ, DIRECTOR_TEMPERATURE_HZ, MOTOR_DATA_UPDATED_TEMPERATURE},
+    [RATE_GROUP_PRESSURE] =
+        {CFG_ID_DIRECTOR_PRESSURE_HZ, DIRECTOR_PRESSURE_HZ, MOTOR_DATA_UPDATED_PRESSURE},
+    [RATE_GROUP_VBAT] = {CFG_ID_DIRECTOR_VBAT_HZ, DIRECTOR_VBAT_HZ, MOTOR_DATA_UPDATED_VBAT},
+    [RATE_GROUP_ENGINE_MINUTES] =
+        {CFG_ID_DIRECTOR_ENGINE_MINUTES_HZ,
+         DIRECTOR_ENGINE_MINUTES_HZ,
+         MOTOR_DATA_UPDATED_ENGINE_MINUTES},
+};
+
 /**************************************************************************************************\
 * Private prototypes
 \**************************************************************************************************/
@@ -59,6 +122,12 @@ static QState initial(Director *const me, void const *const par);
 static QState top(Director *const me, QEvt const *const e);
 static QState running(Director *const me, QEvt const *const e);
 
+static void set_rate_group_hz(Director *const me, RateGroupID_T group, uint32_t rate_hz);
+static void read_rate_group_config(Director *const me);
+static uint8_t rate_groups_due(Director *const me);
+static void publish_motor_data(Director *const me, uint8_t updated);
+static uint32_t sample_age_us(uint64_t now_us, uint64_t timestamp_us);
+
 /**************************************************************************************************\
 * Public functions
 \**************************************************************************************************/
@@ -77,11 +146,31 @@ void Director_ctor()
     QTimeEvt_ctorX(&me->timer_evt, &me->super, WAIT_TIMEOUT_SIG, 0U);
     QTimeEvt_ctorX(&me->engine_minute_evt, &me->super, ENGINE_MINUTE_TIMEOUT_SIG, 0U);
 
-    me->pressure     = 0.0f;
-    me->temperature  = 0.0f;
-    me->vbat_volts   = 0.0f;
-    me->tachometer   = 0.0f;
-    me->config_ready = false;
+    me->neutral                  = false;
+    me->start                    = false;
+    me->temp_good                = false;
+    me->pres_good                = false;
+    me->buzzer                   = false;
+    me->engine_minutes           = 0U;
+    me->pressure                 = 0.0f;
+    me->temperature              = 0.0f;
+    me->pressure_timestamp_us    = 0U;
+    me->temperature_timestamp_us = 0U;
+    me->vbat_min_volts           = 0.0f;
+    me->vbat_max_volts           = 0.0f;
+    me->config_ready             = false;
+
+    // VBAT starts from the first block rather than ramping up from 0 V, the tach ramps up from 0
+    Filter_EMA_F32_Init(&me->vbat_filter, VBAT_EMA_ALPHA, true);
+    Filter_EMA_F32_Init(&me->tach_filter, FILTER_EMA_ALPHA(TACH_EMA_TAU_S, DIRECTOR_RPM_HZ), false);
+
+    for (unsigned i = 0; i < RATE_GROUP_NUM; i++)
+    {
+        set_rate_group_hz(me, (RateGroupID_T) i, s_rate_group_info[i].default_hz);
+
+        // every group is due on the first tick, so the first publication is complete
+        me->rate_groups[i].countdown = 1U;
+    }
 }
 
 /**************************************************************************************************\
@@ -98,12 +187,14 @@ static QState initial(Director *const me, void const *const par)
 
     QActive_subscribe((QActive *) me, PUBSUB_PRESSURE_SIG);
     QActive_subscribe((QActive *) me, PUBSUB_TEMPERATURE_SIG);
+    QActive_subscribe((QActive *) me, PUBSUB_VBAT_SIG);
     QActive_subscribe((QActive *) me, PUBSUB_CONFIG_READY_SIG);
+    QActive_subscribe((QActive *) me, PUBSUB_CONFIG_ENTRY_CHANGED_SIG);
 
     // BSP_Tach_Capture_Timer_Enable();
 
-    // Start update loop of 100hz
-    QTimeEvt_armX(&me->timer_evt, BSP_TICKS_PER_SEC / 100, BSP_TICKS_PER_SEC / 100);
+    // Start the rate group scheduler
+    QTimeEvt_armX(&me->timer_evt, SCHEDULER_TICK_PERIOD, SCHEDULER_TICK_PERIOD);
     QTimeEvt_armX(
         &me->engine_minute_evt,
         MILLISECONDS_TO_TICKS(ENGINE_MINUTE_PERIOD_MS),
@@ -121,7 +212,8 @@ static QState top(Director *const me, QEvt const *const e)
     {
         case Q_ENTRY_SIG: {
             // startup Box to Box (CAN)
-            QEvt *evt = Q_NEW(QEvt, PUBSUB_BOX_TO_BOX_STARTUP_SIG);
+            QEvt *evt = EVENT_CATALOGUE_NEW(
+                PUBSUB_POOL_EVENTS, QEvt, PUBSUB_BOX_TO_BOX_STARTUP_SIG);
             QACTIVE_PUBLISH(evt, &me->super);
 
             status = Q_HANDLED();
@@ -130,18 +222,41 @@ static QState top(Director *const me, QEvt const *const e)
         case PUBSUB_PRESSURE_SIG: {
             const FloatEvent_T *event = Q_EVT_CAST(FloatEvent_T);
             me->pressure              = event->num;
+            me->pressure_timestamp_us = event->timestamp_us;
             status                    = Q_HANDLED();
             break;
         }
         case PUBSUB_TEMPERATURE_SIG: {
-            const FloatEvent_T *event = Q_EVT_CAST(FloatEvent_T);
-            me->temperature           = event->num;
-            status                    = Q_HANDLED();
+            const FloatEvent_T *event    = Q_EVT_CAST(FloatEvent_T);
+            me->temperature              = event->num;
+            me->temperature_timestamp_us = event->timestamp_us;
+            status                       = Q_HANDLED();
+            break;
+        }
+        case PUBSUB_VBAT_SIG: {
+            const VbatEvent_T *event = Q_EVT_CAST(VbatEvent_T);
+            Filter_EMA_F32_Update(&me->vbat_filter, event->volts);
+            me->vbat_min_volts = event->min_volts;
+            me->vbat_max_volts = event->max_volts;
+            status             = Q_HANDLED();
             break;
         }
         case PUBSUB_CONFIG_READY_SIG: {
             me->config_ready = true;
-            status           = Q_HANDLED();
+            read_rate_group_config(me);
+            status = Q_HANDLED();
+            break;
+        }
+        case PUBSUB_CONFIG_ENTRY_CHANGED_SIG: {
+            const ConfigEntryChangedEvent_T *event = Q_EVT_CAST(ConfigEntryChangedEvent_T);
+            for (unsigned i = 0; i < RATE_GROUP_NUM; i++)
+            {
+                if (me->config_ready && (event->id == s_rate_group_info[i].rate_config_id))
+                {
+                    set_rate_group_hz(me, (RateGroupID_T) i, Config_Read_U32(event->id));
+                }
+            }
+            status = Q_HANDLED();
             break;
         }
         // case PUBSUB_TACH_SIG: {
@@ -160,8 +275,8 @@ static QState top(Director *const me, QEvt const *const e)
     return status;
 }
 
-// state that periodically bundles up information and publishes it on QP
-// and over the USART2 to the gauge cluster PCB
+// state that samples each rate group when it is due and publishes the due fields on QP,
+// Box to Box forwards them to the gauge cluster PCB
 static QState running(Director *const me, QEvt const *const e)
 {
     QState status;
@@ -173,35 +288,47 @@ static QState running(Director *const me, QEvt const *const e)
             break;
         }
         case WAIT_TIMEOUT_SIG: {
-            bool neutral   = BSP_Get_Neutral();
-            bool start     = BSP_Get_Start();
-            bool temp_good = BSP_Get_Temp_Good();
-            bool pres_good = BSP_Get_Pres_Good();
-            bool buzzer    = BSP_Get_Buzzer();
-            me->vbat_volts = VBAT_LAMBDA * me->vbat_volts + (1 - VBAT_LAMBDA) * BSP_ADC_Read_VBAT();
-
-            float this_tach = Flow_Sensor_Read_Hz();
-            this_tach       = this_tach * 60 / 6.666; // Hz to RPM + fudge factor for BF20
-            me->tachometer  = TACH_LAMBDA * me->tachometer + (1 - TACH_LAMBDA) * this_tach;
-
-            MotorDataEvent_T *event = Q_NEW(MotorDataEvent_T, PUBSUB_MOTOR_DATA_SIG);
-            event->neutral          = neutral;
-            event->start            = start;
-            event->temp_good        = temp_good;
-            event->pres_good        = pres_good;
-            event->buzzer           = buzzer;
-            event->vbat             = me->vbat_volts;
-            event->temperature      = me->temperature;
-            event->pressure         = me->pressure;
-            event->tachometer       = me->tachometer;
-            event->engine_minutes   = Config_Read_U32(CFG_ID_ENGINE_MINUTES);
-            QACTIVE_PUBLISH(&event->super, &me->super);
+            uint8_t due = rate_groups_due(me);
+
+            if ((due & MOTOR_DATA_UPDATED_FLAGS) != 0U)
+            {
+                me->neutral   = BSP_Get_Neutral();
+                me->start     = BSP_Get_Start();
+                me->temp_good = BSP_Get_Temp_Good();
+                me->pres_good = BSP_Get_Pres_Good();
+                me->buzzer    = BSP_Get_Buzzer();
+
+                Sensor_Trace_Record(
+                    SENSOR_TRACE_GPIO,
+                    (me->neutral ? SENSOR_TRACE_GPIO_NEUTRAL : 0U) |
+                        (me->start ? SENSOR_TRACE_GPIO_START : 0U) |
+                        (me->temp_good ? SENSOR_TRACE_GPIO_TEMP_GOOD : 0U) |
+                        (me->pres_good ? SENSOR_TRACE_GPIO_PRES_GOOD : 0U) |
+                        (me->buzzer ? SENSOR_TRACE_GPIO_BUZZER : 0U));
+            }
+            if ((due & MOTOR_DATA_UPDATED_TACHOMETER) != 0U)
+            {
+                Filter_EMA_F32_Update(&me->tach_filter, Flow_Sensor_Read_Hz() * TACH_HZ_TO_RPM);
+            }
+            if ((due & MOTOR_DATA_UPDATED_ENGINE_MINUTES) != 0U)
+            {
+                me->engine_minutes = Config_Read_U32(CFG_ID_ENGINE_MINUTES);
+            }
+
+            // temperature, pressure and VBAT arrive from their own AOs, their groups only set
+            // how often they are republished
+            if (due != 0U)
+            {
+                publish_motor_data(me, due);
+            }
 
             status = Q_HANDLED();
             break;
         }
         case ENGINE_MINUTE_TIMEOUT_SIG: {
-            if (me->config_ready && (me->tachometer > ENGINE_RUNNING_RPM_THRESHOLD))
+            if (
+                me->config_ready &&
+                (Filter_EMA_F32_Get(&me->tach_filter) > ENGINE_RUNNING_RPM_THRESHOLD))
             {
                 uint32_t engine_minutes = Config_Read_U32(CFG_ID_ENGINE_MINUTES);
                 if (engine_minutes < UINT32_MAX)
@@ -222,3 +349,114 @@ static QState running(Director *const me, QEvt const *const e)
 
     return status;
 }
+
+/**
+ ***************************************************************************************************
+ * @brief   Set a rate group's sampling rate, rounded to a whole number of scheduler ticks.
+ *          0 or rates above DIRECTOR_SCHEDULER_HZ fall back to the compile-time default.
+ **************************************************************************************************/
+static void set_rate_group_hz(Director *const me, RateGroupID_T group, uint32_t rate_hz)
+{
+    if ((rate_hz == 0U) || (rate_hz > DIRECTOR_SCHEDULER_HZ))
+    {
+        rate_hz = s_rate_group_info[group].default_hz;
+    }
+
+    RateGroup_T *rate_group  = &me->rate_groups[group];
+    rate_group->period_ticks = (uint16_t) ((DIRECTOR_SCHEDULER_HZ + (rate_hz / 2U)) / rate_hz);
+    if (rate_group->countdown > rate_group->period_ticks)
+    {
+        rate_group->countdown = rate_group->period_ticks;
+    }
+
+    if (group == RATE_GROUP_TACHOMETER)
+    {
+        // keep the tach time constant independent of its sampling rate
+        float sample_rate_hz = (float) DIRECTOR_SCHEDULER_HZ / (float) rate_group->period_ticks;
+        Filter_EMA_F32_Set_Alpha(
+            &me->tach_filter, FILTER_EMA_ALPHA(TACH_EMA_TAU_S, sample_rate_hz));
+    }
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Apply the config overrides of every rate group
+ **************************************************************************************************/
+static void read_rate_group_config(Director *const me)
+{
+    for (unsigned i = 0; i < RATE_GROUP_NUM; i++)
+    {
+        uint32_t rate_hz = Config_Read_U32(s_rate_group_info[i].rate_config_id);
+        set_rate_group_hz(me, (RateGroupID_T) i, rate_hz);
+    }
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Advance the rate groups by one scheduler tick
+ *
+ * @return  MOTOR_DATA_UPDATED_* bits of the groups due on this tick
+ **************************************************************************************************/
+static uint8_t rate_groups_due(Director *const me)
+{
+    uint8_t due = 0U;
+
+    for (unsigned i = 0; i < RATE_GROUP_NUM; i++)
+    {
+        RateGroup_T *rate_group = &me->rate_groups[i];
+
+        rate_group->countdown--;
+        if (rate_group->countdown == 0U)
+        {
+            rate_group->countdown = rate_group->period_ticks;
+            due |= s_rate_group_info[i].updated_bit;
+        }
+    }
+
+    return due;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Publish the latest value of every field, flagging the ones sampled on this tick
+ **************************************************************************************************/
+static void publish_motor_data(Director *const me, uint8_t updated)
+{
+    uint64_t now_us = BSP_Get_Microseconds();
+
+    MotorDataEvent_T *event = EVENT_CATALOGUE_NEW(
+        PUBSUB_POOL_EVENTS, MotorDataEvent_T, PUBSUB_MOTOR_DATA_SIG);
+    event->neutral            = me->neutral;
+    event->start              = me->start;
+    event->temp_good          = me->temp_good;
+    event->pres_good          = me->pres_good;
+    event->buzzer             = me->buzzer;
+    event->vbat               = Filter_EMA_F32_Get(&me->vbat_filter);
+    event->vbat_min           = me->vbat_min_volts;
+    event->vbat_max           = me->vbat_max_volts;
+    event->temperature        = me->temperature;
+    event->pressure           = me->pressure;
+    event->tachometer         = Filter_EMA_F32_Get(&me->tach_filter);
+    event->engine_minutes     = me->engine_minutes;
+    event->timestamp_us       = now_us;
+    event->temperature_age_us = sample_age_us(now_us, me->temperature_timestamp_us);
+    event->pressure_age_us    = sample_age_us(now_us, me->pressure_timestamp_us);
+    event->updated            = updated;
+    QACTIVE_PUBLISH(&event->super, &me->super);
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Age of a sample at now_us, SAMPLE_AGE_UNKNOWN_US if there has been no sample yet
+ **************************************************************************************************/
+static uint32_t sample_age_us(uint64_t now_us, uint64_t timestamp_us)
+{
+    if ((timestamp_us == 0U) || (timestamp_us > now_us))
+    {
+        return SAMPLE_AGE_UNKNOWN_US;
+    }
+
+    uint64_t age_us = now_us - timestamp_us;
+
+    return (age_us < SAMPLE_AGE_UNKNOWN_US) ? (uint32_t) age_us : SAMPLE_AGE_UNKNOWN_US;
+}
@@ -9,6 +9,34 @@ extern "C" {
 
 #include <stddef.h>
 
+/**************************************************************************************************\
+* Public macros
+\**************************************************************************************************/
+
+// Rate group scheduler tick, every sampling rate is a whole number of these ticks
+#define DIRECTOR_SCHEDULER_HZ 200U
+
+// Compile-time default sampling rates, used as the config defaults (CFG_ID_DIRECTOR_*_HZ) so they
+// can be overridden per build with -D or per board through config
+#ifndef DIRECTOR_FLAGS_HZ
+#define DIRECTOR_FLAGS_HZ 50U // neutral, start, temp/pres good and buzzer GPIO
+#endif
+#ifndef DIRECTOR_RPM_HZ
+#define DIRECTOR_RPM_HZ 100U
+#endif
+#ifndef DIRECTOR_TEMPERATURE_HZ
+#define DIRECTOR_TEMPERATURE_HZ 10U
+#endif
+#ifndef DIRECTOR_PRESSURE_HZ
+#define DIRECTOR_PRESSURE_HZ 20U
+#endif
+#ifndef DIRECTOR_VBAT_HZ
+#define DIRECTOR_VBAT_HZ 10U
+#endif
+#ifndef DIRECTOR_ENGINE_MINUTES_HZ
+#define DIRECTOR_ENGINE_MINUTES_HZ 1U
+#endif
+
 /**************************************************************************************************\
 * Public memory declarations
 \**************************************************************************************************/
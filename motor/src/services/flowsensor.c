@@ -1,5 +1,6 @@
 #include "flowsensor.h"
 #include "bsp.h"
+#include "sensor_trace.h"
 #include <math.h>
 #include <stdbool.h>
 
@@ -51,6 +52,8 @@ void Flow_Sensor_IC_Callback(TIM_HandleTypeDef *htim, uint32_t TIM_CHANNEL)
     uint16_t this_pulse = (uint16_t) HAL_TIM_ReadCapturedValue(htim, TIM_CHANNEL);
     if (this_pulse > 0)
     {
+        Sensor_Trace_Record(SENSOR_TRACE_TACH_PERIOD, this_pulse);
+
         pulse_time = this_pulse;
         edgeFound  = true;
         if (edges == NO_EDGES)
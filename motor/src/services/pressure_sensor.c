@@ -7,6 +7,7 @@
 #include "bsp.h"
 #include "private_signal_ranges.h"
 #include "pubsub_signals.h"
+#include "sensor_trace.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -394,6 +395,8 @@ static QState readData(PRESSURE *const me, QEvt const *const e)
 
                 uint32_t press_counts = me->i2c_data[3] + (me->i2c_data[2] << 8) +
                     (me->i2c_data[1] << 16);
+                Sensor_Trace_Record(SENSOR_TRACE_PRESSURE_COUNTS, press_counts);
+
                 // calculation of pressure value according to equation 2 of datasheet
                 int32_t pressure = ((press_counts - OUTPUTMIN) * (PMAX - PMIN)) * 100 /
                         (OUTPUTMAX - OUTPUTMIN) +
@@ -403,8 +406,10 @@ static QState readData(PRESSURE *const me, QEvt const *const e)
                 // (me->i2c_data[4] << 16); int8_t temperature = (temp_counts * 200 / 16777215) -
                 // 50; (void)temperature;
 
-                FloatEvent_T *event = Q_NEW(FloatEvent_T, PUBSUB_PRESSURE_SIG);
+                FloatEvent_T *event = EVENT_CATALOGUE_NEW(
+                    PUBSUB_POOL_EVENTS, FloatEvent_T, PUBSUB_PRESSURE_SIG);
                 event->num          = pressure;
+                event->timestamp_us = BSP_Get_Microseconds();
                 QACTIVE_PUBLISH(&event->super, &me->super);
             }
 
@@ -0,0 +1,82 @@
+#include "vbat_sensor.h"
+#include "bsp.h"
+#include "pubsub_signals.h"
+#include "qpc.h"
+#include "sensor_trace.h"
+
+Q_DEFINE_THIS_MODULE("vbat_sensor.c")
+
+/**************************************************************************************************\
+* Private macros
+\**************************************************************************************************/
+
+/**************************************************************************************************\
+* Private type definitions
+\**************************************************************************************************/
+
+/**************************************************************************************************\
+* Private memory declarations
+\**************************************************************************************************/
+
+#ifdef Q_SPY
+static QSpyId const l_vbat_dma_isr = {0U}; // QS sender ID for publishing from the DMA ISR
+#endif
+
+/**************************************************************************************************\
+* Private prototypes
+\**************************************************************************************************/
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+/**
+ ***************************************************************************************************
+ *
+ * @brief   Handle one completed block of oversampled VBAT ADC samples (DMA half / full transfer)
+ *
+ *          The block is reduced to mean, min and max in raw counts, so that only three values
+ *          need to be scaled to volts, and the result is published as PUBSUB_VBAT_SIG.
+ *          Called from the DMA ISR.
+ *
+ **************************************************************************************************/
+void VBAT_Sensor_Block_Callback(const uint16_t *block, uint16_t len)
+{
+    Q_ASSERT((block != NULL) && (len > 0U));
+
+    uint32_t sum = 0U;
+    uint16_t min = UINT16_MAX;
+    uint16_t max = 0U;
+
+    for (uint16_t i = 0U; i < len; i++)
+    {
+        uint16_t sample = block[i];
+
+        sum += sample;
+        if (sample < min)
+        {
+            min = sample;
+        }
+        if (sample > max)
+        {
+            max = sample;
+        }
+    }
+
+    Sensor_Trace_Record(
+        SENSOR_TRACE_VBAT_MEAN, ((sum * SENSOR_TRACE_VBAT_SCALE) + (len / 2U)) / len);
+
+    // the last sample of the block was just converted, stamp the block with its middle
+    uint64_t half_block_us = ((uint64_t) len * 1000000U) / (2U * BSP_ADC_VBAT_SAMPLE_RATE_HZ);
+
+    VbatEvent_T *event  = EVENT_CATALOGUE_NEW(PUBSUB_POOL_EVENTS, VbatEvent_T, PUBSUB_VBAT_SIG);
+    event->volts        = BSP_ADC_VBAT_Counts_To_Volts((float) sum / (float) len);
+    event->min_volts    = BSP_ADC_VBAT_Counts_To_Volts((float) min);
+    event->max_volts    = BSP_ADC_VBAT_Counts_To_Volts((float) max);
+    event->timestamp_us = BSP_Get_Microseconds() - half_block_us;
+    QACTIVE_PUBLISH(&event->super, &l_vbat_dma_isr);
+}
+
+/**************************************************************************************************\
+* Private functions
+\**************************************************************************************************/
@@ -0,0 +1,22 @@
+#ifndef VBAT_SENSOR_H_
+#define VBAT_SENSOR_H_
+
+#include "stdint.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************************************************\
+* Public type definitions
+\**************************************************************************************************/
+
+/**************************************************************************************************\
+* Public prototypes
+\**************************************************************************************************/
+void VBAT_Sensor_Block_Callback(const uint16_t *block, uint16_t len);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // VBAT_SENSOR_H_
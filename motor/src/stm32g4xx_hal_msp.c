@@ -23,6 +23,8 @@
 /* USER CODE BEGIN Includes */
 
 /* USER CODE END Includes */
+extern DMA_HandleTypeDef hdma_adc2;
+
 
 /* Private typedef -----------------------------------------------------------*/
 /* USER CODE BEGIN TD */
@@ -129,6 +131,24 @@ void HAL_ADC_MspInit(ADC_HandleTypeDef *hadc)
         GPIO_InitStruct.Pull = GPIO_NOPULL;
         HAL_GPIO_Init(VBAT_SENSE_GPIO_Port, &GPIO_InitStruct);
 
+        /* ADC2 DMA Init */
+        /* ADC2 Init */
+        hdma_adc2.Instance                 = DMA1_Channel1;
+        hdma_adc2.Init.Request             = DMA_REQUEST_ADC2;
+        hdma_adc2.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+        hdma_adc2.Init.PeriphInc           = DMA_PINC_DISABLE;
+        hdma_adc2.Init.MemInc              = DMA_MINC_ENABLE;
+        hdma_adc2.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+        hdma_adc2.Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+        hdma_adc2.Init.Mode                = DMA_CIRCULAR;
+        hdma_adc2.Init.Priority            = DMA_PRIORITY_LOW;
+        if (HAL_DMA_Init(&hdma_adc2) != HAL_OK)
+        {
+            Error_Handler();
+        }
+
+        __HAL_LINKDMA(hadc, DMA_Handle, hdma_adc2);
+
         /* USER CODE BEGIN ADC2_MspInit 1 */
 
         /* USER CODE END ADC2_MspInit 1 */
@@ -156,6 +176,8 @@ void HAL_ADC_MspDeInit(ADC_HandleTypeDef *hadc)
         */
         HAL_GPIO_DeInit(VBAT_SENSE_GPIO_Port, VBAT_SENSE_Pin);
 
+        /* ADC2 DMA DeInit */
+        HAL_DMA_DeInit(hadc->DMA_Handle);
         /* USER CODE BEGIN ADC2_MspDeInit 1 */
 
         /* USER CODE END ADC2_MspDeInit 1 */
@@ -333,7 +355,18 @@ void HAL_I2C_MspDeInit(I2C_HandleTypeDef *hi2c)
 void HAL_TIM_Base_MspInit(TIM_HandleTypeDef *htim_base)
 {
     GPIO_InitTypeDef GPIO_InitStruct = {0};
-    if (htim_base->Instance == TIM8)
+    if (htim_base->Instance == TIM6)
+    {
+        /* USER CODE BEGIN TIM6_MspInit 0 */
+
+        /* USER CODE END TIM6_MspInit 0 */
+        /* Peripheral clock enable */
+        __HAL_RCC_TIM6_CLK_ENABLE();
+        /* USER CODE BEGIN TIM6_MspInit 1 */
+
+        /* USER CODE END TIM6_MspInit 1 */
+    }
+    else if (htim_base->Instance == TIM8)
     {
         /* USER CODE BEGIN TIM8_MspInit 0 */
 
@@ -392,7 +425,18 @@ void HAL_TIM_Base_MspInit(TIM_HandleTypeDef *htim_base)
  */
 void HAL_TIM_Base_MspDeInit(TIM_HandleTypeDef *htim_base)
 {
-    if (htim_base->Instance == TIM8)
+    if (htim_base->Instance == TIM6)
+    {
+        /* USER CODE BEGIN TIM6_MspDeInit 0 */
+
+        /* USER CODE END TIM6_MspDeInit 0 */
+        /* Peripheral clock disable */
+        __HAL_RCC_TIM6_CLK_DISABLE();
+        /* USER CODE BEGIN TIM6_MspDeInit 1 */
+
+        /* USER CODE END TIM6_MspDeInit 1 */
+    }
+    else if (htim_base->Instance == TIM8)
     {
         /* USER CODE BEGIN TIM8_MspDeInit 0 */
 
@@ -1,3 +1,5 @@
+import glob
+import os
 import queue
 import logging
 from dataclasses import dataclass
@@ -45,6 +47,12 @@ def get_com_port_options():
         ComPortOption(device=port.device, label=format_com_port_label(port))
         for port in ports
     ]
+    # host simulation (sim/), its CLI / pc_com PTY in the directory it was started with
+    sim_dir = os.environ.get("BOAT_SIM_STATE_DIR", ".")
+    for link in sorted(glob.glob(os.path.join(sim_dir, "*-usb0"))):
+        port_options.append(
+            ComPortOption(device=link, label=f"Host simulation: {link}")
+        )
     port_options.append(
         ComPortOption(
             device="socket://127.0.0.1:7777",
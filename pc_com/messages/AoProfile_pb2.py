@@ -0,0 +1,206 @@
+# -*- coding: utf-8 -*-
+# Generated by the protocol buffer compiler.  DO NOT EDIT!
+# source: AoProfile.proto
+
+from google.protobuf import descriptor as _descriptor
+from google.protobuf import message as _message
+from google.protobuf import reflection as _reflection
+from google.protobuf import symbol_database as _symbol_database
+# @@protoc_insertion_point(imports)
+
+_sym_db = _symbol_database.Default()
+
+
+
+
+DESCRIPTOR = _descriptor.FileDescriptor(
+  name='AoProfile.proto',
+  package='',
+  syntax='proto2',
+  serialized_options=None,
+  create_key=_descriptor._internal_create_key,
+  serialized_pb=b'\n\x0f\x41oProfile.proto\"d\n\x0cRtcHistogram\x12\x0f\n\x07\x62uckets\x18\x01 \x03(\r\x12\r\n\x05shift\x18\x02 \x02(\r\x12\r\n\x05\x63ount\x18\x03 \x02(\r\x12\x0b\n\x03min\x18\x04 \x02(\r\x12\x0b\n\x03max\x18\x05 \x02(\r\x12\x0b\n\x03sum\x18\x06 \x02(\x04\"E\n\nRtcProfile\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\n\n\x02id\x18\x02 \x02(\r\x12\x1d\n\x06\x63ycles\x18\x03 \x02(\x0b\x32\r.RtcHistogram\"J\n\x0eRtcProfileResp\x12\x19\n\x11milliseconds_tick\x18\x01 \x02(\r\x12\x1d\n\x08profiles\x18\x02 \x03(\x0b\x32\x0b.RtcProfile'
+)
+
+
+
+
+_RTCHISTOGRAM = _descriptor.Descriptor(
+  name='RtcHistogram',
+  full_name='RtcHistogram',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  create_key=_descriptor._internal_create_key,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='buckets', full_name='RtcHistogram.buckets', index=0,
+      number=1, type=13, cpp_type=3, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='shift', full_name='RtcHistogram.shift', index=1,
+      number=2, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='count', full_name='RtcHistogram.count', index=2,
+      number=3, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='min', full_name='RtcHistogram.min', index=3,
+      number=4, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='max', full_name='RtcHistogram.max', index=4,
+      number=5, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='sum', full_name='RtcHistogram.sum', index=5,
+      number=6, type=4, cpp_type=4, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto2',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=19,
+  serialized_end=119,
+)
+
+_RTCPROFILE = _descriptor.Descriptor(
+  name='RtcProfile',
+  full_name='RtcProfile',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  create_key=_descriptor._internal_create_key,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='name', full_name='RtcProfile.name', index=0,
+      number=1, type=9, cpp_type=9, label=2,
+      has_default_value=False, default_value=b"".decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='id', full_name='RtcProfile.id', index=1,
+      number=2, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='cycles', full_name='RtcProfile.cycles', index=2,
+      number=3, type=11, cpp_type=10, label=2,
+      has_default_value=False, default_value=None,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto2',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=121,
+  serialized_end=190,
+)
+
+_RTCPROFILERESP = _descriptor.Descriptor(
+  name='RtcProfileResp',
+  full_name='RtcProfileResp',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  create_key=_descriptor._internal_create_key,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='milliseconds_tick', full_name='RtcProfileResp.milliseconds_tick', index=0,
+      number=1, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='profiles', full_name='RtcProfileResp.profiles', index=1,
+      number=2, type=11, cpp_type=10, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto2',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=192,
+  serialized_end=266,
+)
+
+_RTCPROFILE.fields_by_name['cycles'].message_type = _RTCHISTOGRAM
+_RTCPROFILERESP.fields_by_name['profiles'].message_type = _RTCPROFILE
+DESCRIPTOR.message_types_by_name['RtcHistogram'] = _RTCHISTOGRAM
+DESCRIPTOR.message_types_by_name['RtcProfile'] = _RTCPROFILE
+DESCRIPTOR.message_types_by_name['RtcProfileResp'] = _RTCPROFILERESP
+_sym_db.RegisterFileDescriptor(DESCRIPTOR)
+
+RtcHistogram = _reflection.GeneratedProtocolMessageType('RtcHistogram', (_message.Message,), {
+  'DESCRIPTOR' : _RTCHISTOGRAM,
+  '__module__' : 'AoProfile_pb2'
+  # @@protoc_insertion_point(class_scope:RtcHistogram)
+  })
+_sym_db.RegisterMessage(RtcHistogram)
+
+RtcProfile = _reflection.GeneratedProtocolMessageType('RtcProfile', (_message.Message,), {
+  'DESCRIPTOR' : _RTCPROFILE,
+  '__module__' : 'AoProfile_pb2'
+  # @@protoc_insertion_point(class_scope:RtcProfile)
+  })
+_sym_db.RegisterMessage(RtcProfile)
+
+RtcProfileResp = _reflection.GeneratedProtocolMessageType('RtcProfileResp', (_message.Message,), {
+  'DESCRIPTOR' : _RTCPROFILERESP,
+  '__module__' : 'AoProfile_pb2'
+  # @@protoc_insertion_point(class_scope:RtcProfileResp)
+  })
+_sym_db.RegisterMessage(RtcProfileResp)
+
+
+# @@protoc_insertion_point(module_scope)
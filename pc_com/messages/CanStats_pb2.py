@@ -0,0 +1,272 @@
+# -*- coding: utf-8 -*-
+# Generated by the protocol buffer compiler.  DO NOT EDIT!
+# source: CanStats.proto
+
+from google.protobuf import descriptor as _descriptor
+from google.protobuf import message as _message
+from google.protobuf import reflection as _reflection
+from google.protobuf import symbol_database as _symbol_database
+# @@protoc_insertion_point(imports)
+
+_sym_db = _symbol_database.Default()
+
+
+
+
+DESCRIPTOR = _descriptor.FileDescriptor(
+  name='CanStats.proto',
+  package='',
+  syntax='proto2',
+  serialized_options=None,
+  create_key=_descriptor._internal_create_key,
+  serialized_pb=b'\n\x0e\x43\x61nStats.proto\"d\n\x0c\x43\x61nHistogram\x12\x0f\n\x07\x62uckets\x18\x01 \x03(\r\x12\r\n\x05shift\x18\x02 \x02(\r\x12\r\n\x05\x63ount\x18\x03 \x02(\r\x12\x0b\n\x03min\x18\x04 \x02(\r\x12\x0b\n\x03max\x18\x05 \x02(\r\x12\x0b\n\x03sum\x18\x06 \x02(\x04\"\x99\x01\n\nCanIdStats\x12\n\n\x02id\x18\x01 \x02(\r\x12\x11\n\ttx_frames\x18\x02 \x02(\r\x12\x11\n\ttx_events\x18\x03 \x02(\r\x12\x11\n\trx_frames\x18\x04 \x02(\r\x12$\n\rtx_latency_us\x18\x05 \x02(\x0b\x32\r.CanHistogram\x12 \n\trx_age_us\x18\x06 \x02(\x0b\x32\r.CanHistogram\"\xd6\x01\n\x0c\x43\x61nStatsResp\x12\x19\n\x11milliseconds_tick\x18\x01 \x02(\r\x12\x16\n\x0etx_error_count\x18\x02 \x02(\r\x12\x16\n\x0erx_error_count\x18\x03 \x02(\r\x12\x15\n\rerrors_logged\x18\x04 \x02(\r\x12\x13\n\x0blast_errors\x18\x05 \x03(\r\x12\x18\n\x10\x64\x61ta_last_errors\x18\x06 \x03(\r\x12\x1b\n\x13tx_events_unmatched\x18\x07 \x02(\r\x12\x18\n\x03ids\x18\x08 \x03(\x0b\x32\x0b.CanIdStats'
+)
+
+
+
+
+_CANHISTOGRAM = _descriptor.Descriptor(
+  name='CanHistogram',
+  full_name='CanHistogram',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  create_key=_descriptor._internal_create_key,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='buckets', full_name='CanHistogram.buckets', index=0,
+      number=1, type=13, cpp_type=3, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='shift', full_name='CanHistogram.shift', index=1,
+      number=2, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='count', full_name='CanHistogram.count', index=2,
+      number=3, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='min', full_name='CanHistogram.min', index=3,
+      number=4, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='max', full_name='CanHistogram.max', index=4,
+      number=5, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='sum', full_name='CanHistogram.sum', index=5,
+      number=6, type=4, cpp_type=4, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto2',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=18,
+  serialized_end=118,
+)
+
+
+_CANIDSTATS = _descriptor.Descriptor(
+  name='CanIdStats',
+  full_name='CanIdStats',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  create_key=_descriptor._internal_create_key,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='id', full_name='CanIdStats.id', index=0,
+      number=1, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='tx_frames', full_name='CanIdStats.tx_frames', index=1,
+      number=2, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='tx_events', full_name='CanIdStats.tx_events', index=2,
+      number=3, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='rx_frames', full_name='CanIdStats.rx_frames', index=3,
+      number=4, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='tx_latency_us', full_name='CanIdStats.tx_latency_us', index=4,
+      number=5, type=11, cpp_type=10, label=2,
+      has_default_value=False, default_value=None,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='rx_age_us', full_name='CanIdStats.rx_age_us', index=5,
+      number=6, type=11, cpp_type=10, label=2,
+      has_default_value=False, default_value=None,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto2',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=121,
+  serialized_end=274,
+)
+
+
+_CANSTATSRESP = _descriptor.Descriptor(
+  name='CanStatsResp',
+  full_name='CanStatsResp',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  create_key=_descriptor._internal_create_key,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='milliseconds_tick', full_name='CanStatsResp.milliseconds_tick', index=0,
+      number=1, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='tx_error_count', full_name='CanStatsResp.tx_error_count', index=1,
+      number=2, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='rx_error_count', full_name='CanStatsResp.rx_error_count', index=2,
+      number=3, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='errors_logged', full_name='CanStatsResp.errors_logged', index=3,
+      number=4, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='last_errors', full_name='CanStatsResp.last_errors', index=4,
+      number=5, type=13, cpp_type=3, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='data_last_errors', full_name='CanStatsResp.data_last_errors', index=5,
+      number=6, type=13, cpp_type=3, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='tx_events_unmatched', full_name='CanStatsResp.tx_events_unmatched', index=6,
+      number=7, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='ids', full_name='CanStatsResp.ids', index=7,
+      number=8, type=11, cpp_type=10, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto2',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=277,
+  serialized_end=491,
+)
+
+_CANIDSTATS.fields_by_name['tx_latency_us'].message_type = _CANHISTOGRAM
+_CANIDSTATS.fields_by_name['rx_age_us'].message_type = _CANHISTOGRAM
+_CANSTATSRESP.fields_by_name['ids'].message_type = _CANIDSTATS
+DESCRIPTOR.message_types_by_name['CanHistogram'] = _CANHISTOGRAM
+DESCRIPTOR.message_types_by_name['CanIdStats'] = _CANIDSTATS
+DESCRIPTOR.message_types_by_name['CanStatsResp'] = _CANSTATSRESP
+_sym_db.RegisterFileDescriptor(DESCRIPTOR)
+
+CanHistogram = _reflection.GeneratedProtocolMessageType('CanHistogram', (_message.Message,), {
+  'DESCRIPTOR' : _CANHISTOGRAM,
+  '__module__' : 'CanStats_pb2'
+  # @@protoc_insertion_point(class_scope:CanHistogram)
+  })
+_sym_db.RegisterMessage(CanHistogram)
+
+CanIdStats = _reflection.GeneratedProtocolMessageType('CanIdStats', (_message.Message,), {
+  'DESCRIPTOR' : _CANIDSTATS,
+  '__module__' : 'CanStats_pb2'
+  # @@protoc_insertion_point(class_scope:CanIdStats)
+  })
+_sym_db.RegisterMessage(CanIdStats)
+
+CanStatsResp = _reflection.GeneratedProtocolMessageType('CanStatsResp', (_message.Message,), {
+  'DESCRIPTOR' : _CANSTATSRESP,
+  '__module__' : 'CanStats_pb2'
+  # @@protoc_insertion_point(class_scope:CanStatsResp)
+  })
+_sym_db.RegisterMessage(CanStatsResp)
+
+
+# @@protoc_insertion_point(module_scope)
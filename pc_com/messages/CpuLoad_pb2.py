@@ -0,0 +1,98 @@
+# -*- coding: utf-8 -*-
+# Generated by the protocol buffer compiler.  DO NOT EDIT!
+# source: CpuLoad.proto
+
+from google.protobuf import descriptor as _descriptor
+from google.protobuf import message as _message
+from google.protobuf import reflection as _reflection
+from google.protobuf import symbol_database as _symbol_database
+# @@protoc_insertion_point(imports)
+
+_sym_db = _symbol_database.Default()
+
+
+
+
+DESCRIPTOR = _descriptor.FileDescriptor(
+  name='CpuLoad.proto',
+  package='',
+  syntax='proto2',
+  serialized_options=None,
+  create_key=_descriptor._internal_create_key,
+  serialized_pb=b'\n\rCpuLoad.proto\"o\n\x07\x43puLoad\x12\x19\n\x11milliseconds_tick\x18\x01 \x02(\r\x12\x12\n\nload_100ms\x18\x02 \x02(\r\x12\x0f\n\x07load_1s\x18\x03 \x02(\r\x12\x10\n\x08load_10s\x18\x04 \x02(\r\x12\x12\n\npeak_100ms\x18\x05 \x02(\r'
+)
+
+
+
+
+_CPULOAD = _descriptor.Descriptor(
+  name='CpuLoad',
+  full_name='CpuLoad',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  create_key=_descriptor._internal_create_key,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='milliseconds_tick', full_name='CpuLoad.milliseconds_tick', index=0,
+      number=1, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='load_100ms', full_name='CpuLoad.load_100ms', index=1,
+      number=2, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='load_1s', full_name='CpuLoad.load_1s', index=2,
+      number=3, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='load_10s', full_name='CpuLoad.load_10s', index=3,
+      number=4, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='peak_100ms', full_name='CpuLoad.peak_100ms', index=4,
+      number=5, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto2',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=17,
+  serialized_end=128,
+)
+
+DESCRIPTOR.message_types_by_name['CpuLoad'] = _CPULOAD
+_sym_db.RegisterFileDescriptor(DESCRIPTOR)
+
+CpuLoad = _reflection.GeneratedProtocolMessageType('CpuLoad', (_message.Message,), {
+  'DESCRIPTOR' : _CPULOAD,
+  '__module__' : 'CpuLoad_pb2'
+  # @@protoc_insertion_point(class_scope:CpuLoad)
+  })
+_sym_db.RegisterMessage(CpuLoad)
+
+
+# @@protoc_insertion_point(module_scope)
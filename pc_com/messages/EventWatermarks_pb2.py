@@ -0,0 +1,243 @@
+# -*- coding: utf-8 -*-
+# Generated by the protocol buffer compiler.  DO NOT EDIT!
+# source: EventWatermarks.proto
+
+from google.protobuf import descriptor as _descriptor
+from google.protobuf import message as _message
+from google.protobuf import reflection as _reflection
+from google.protobuf import symbol_database as _symbol_database
+# @@protoc_insertion_point(imports)
+
+_sym_db = _symbol_database.Default()
+
+
+
+
+DESCRIPTOR = _descriptor.FileDescriptor(
+  name='EventWatermarks.proto',
+  package='',
+  syntax='proto2',
+  serialized_options=None,
+  create_key=_descriptor._internal_create_key,
+  serialized_pb=b'\n\x15\x45ventWatermarks.proto\"\x99\x01\n\x12\x45ventPoolWatermark\x12\x12\n\nblock_size\x18\x01 \x02(\r\x12\x0e\n\x06\x62locks\x18\x02 \x02(\r\x12\x0c\n\x04\x66ree\x18\x03 \x02(\r\x12\x10\n\x08min_free\x18\x04 \x02(\r\x12\x0e\n\x06\x61llocs\x18\x05 \x02(\r\x12\x14\n\x0c\x61llocs_per_s\x18\x06 \x02(\r\x12\x19\n\x11peak_allocs_per_s\x18\x07 \x02(\r\"a\n\x13\x45ventQueueWatermark\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\x0c\n\x04prio\x18\x02 \x02(\r\x12\x0e\n\x06length\x18\x03 \x02(\r\x12\x0c\n\x04\x66ree\x18\x04 \x02(\r\x12\x10\n\x08min_free\x18\x05 \x02(\r\"\x90\x01\n\x13\x45ventWatermarksResp\x12\x19\n\x11milliseconds_tick\x18\x01 \x02(\r\x12\x14\n\x0cwarn_percent\x18\x02 \x02(\r\x12\"\n\x05pools\x18\x03 \x03(\x0b\x32\x13.EventPoolWatermark\x12$\n\x06queues\x18\x04 \x03(\x0b\x32\x14.EventQueueWatermark'
+)
+
+
+
+
+_EVENTPOOLWATERMARK = _descriptor.Descriptor(
+  name='EventPoolWatermark',
+  full_name='EventPoolWatermark',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  create_key=_descriptor._internal_create_key,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='block_size', full_name='EventPoolWatermark.block_size', index=0,
+      number=1, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='blocks', full_name='EventPoolWatermark.blocks', index=1,
+      number=2, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='free', full_name='EventPoolWatermark.free', index=2,
+      number=3, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='min_free', full_name='EventPoolWatermark.min_free', index=3,
+      number=4, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='allocs', full_name='EventPoolWatermark.allocs', index=4,
+      number=5, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='allocs_per_s', full_name='EventPoolWatermark.allocs_per_s', index=5,
+      number=6, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='peak_allocs_per_s', full_name='EventPoolWatermark.peak_allocs_per_s', index=6,
+      number=7, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto2',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=26,
+  serialized_end=179,
+)
+
+
+_EVENTQUEUEWATERMARK = _descriptor.Descriptor(
+  name='EventQueueWatermark',
+  full_name='EventQueueWatermark',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  create_key=_descriptor._internal_create_key,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='name', full_name='EventQueueWatermark.name', index=0,
+      number=1, type=9, cpp_type=9, label=2,
+      has_default_value=False, default_value=b"".decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='prio', full_name='EventQueueWatermark.prio', index=1,
+      number=2, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='length', full_name='EventQueueWatermark.length', index=2,
+      number=3, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='free', full_name='EventQueueWatermark.free', index=3,
+      number=4, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='min_free', full_name='EventQueueWatermark.min_free', index=4,
+      number=5, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto2',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=181,
+  serialized_end=278,
+)
+
+
+_EVENTWATERMARKSRESP = _descriptor.Descriptor(
+  name='EventWatermarksResp',
+  full_name='EventWatermarksResp',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  create_key=_descriptor._internal_create_key,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='milliseconds_tick', full_name='EventWatermarksResp.milliseconds_tick', index=0,
+      number=1, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='warn_percent', full_name='EventWatermarksResp.warn_percent', index=1,
+      number=2, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='pools', full_name='EventWatermarksResp.pools', index=2,
+      number=3, type=11, cpp_type=10, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='queues', full_name='EventWatermarksResp.queues', index=3,
+      number=4, type=11, cpp_type=10, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto2',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=281,
+  serialized_end=425,
+)
+
+_EVENTWATERMARKSRESP.fields_by_name['pools'].message_type = _EVENTPOOLWATERMARK
+_EVENTWATERMARKSRESP.fields_by_name['queues'].message_type = _EVENTQUEUEWATERMARK
+DESCRIPTOR.message_types_by_name['EventPoolWatermark'] = _EVENTPOOLWATERMARK
+DESCRIPTOR.message_types_by_name['EventQueueWatermark'] = _EVENTQUEUEWATERMARK
+DESCRIPTOR.message_types_by_name['EventWatermarksResp'] = _EVENTWATERMARKSRESP
+_sym_db.RegisterFileDescriptor(DESCRIPTOR)
+
+EventPoolWatermark = _reflection.GeneratedProtocolMessageType('EventPoolWatermark', (_message.Message,), {
+  'DESCRIPTOR' : _EVENTPOOLWATERMARK,
+  '__module__' : 'EventWatermarks_pb2'
+  # @@protoc_insertion_point(class_scope:EventPoolWatermark)
+  })
+_sym_db.RegisterMessage(EventPoolWatermark)
+
+EventQueueWatermark = _reflection.GeneratedProtocolMessageType('EventQueueWatermark', (_message.Message,), {
+  'DESCRIPTOR' : _EVENTQUEUEWATERMARK,
+  '__module__' : 'EventWatermarks_pb2'
+  # @@protoc_insertion_point(class_scope:EventQueueWatermark)
+  })
+_sym_db.RegisterMessage(EventQueueWatermark)
+
+EventWatermarksResp = _reflection.GeneratedProtocolMessageType('EventWatermarksResp', (_message.Message,), {
+  'DESCRIPTOR' : _EVENTWATERMARKSRESP,
+  '__module__' : 'EventWatermarks_pb2'
+  # @@protoc_insertion_point(class_scope:EventWatermarksResp)
+  })
+_sym_db.RegisterMessage(EventWatermarksResp)
+
+
+# @@protoc_insertion_point(module_scope)
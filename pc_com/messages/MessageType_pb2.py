@@ -20,7 +20,7 @@ DESCRIPTOR = _descriptor.FileDescriptor(
   syntax='proto2',
   serialized_options=None,
   create_key=_descriptor._internal_create_key,
-  serialized_pb=b'\n\x11MessageType.proto*\xbe\x02\n\x0bMessageType\x12\r\n\tLOG_PRINT\x10\x01\x12\x0c\n\x08\x43LI_DATA\x10\x02\x12\x1d\n\x19\x43ONFIG_DB_SAVE_TO_NVM_REQ\x10\x0b\x12#\n\x1f\x43ONFIG_DB_REQ_DATABASE_INFO_REQ\x10\x0c\x12$\n CONFIG_DB_SET_ALL_TO_DEFAULT_REQ\x10\r\x12\x1b\n\x17\x43ONFIG_DB_GET_ENTRY_REQ\x10\x0e\x12\x1b\n\x17\x43ONFIG_DB_SET_ENTRY_REQ\x10\x0f\x12&\n\"CONFIG_DB_SET_ENTRY_TO_DEFAULT_REQ\x10\x10\x12\x17\n\x13\x43ONFIG_DB_INFO_RESP\x10\x11\x12\x1d\n\x19\x43ONFIG_DB_ENTRY_DATA_RESP\x10\x12\x12\x0e\n\nMOTOR_DATA\x10\x13'
+  serialized_pb=b'\n\x11MessageType.proto*\xb8\x04\n\x0bMessageType\x12\r\n\tLOG_PRINT\x10\x01\x12\x0c\n\x08\x43LI_DATA\x10\x02\x12\x1d\n\x19\x43ONFIG_DB_SAVE_TO_NVM_REQ\x10\x0b\x12#\n\x1f\x43ONFIG_DB_REQ_DATABASE_INFO_REQ\x10\x0c\x12$\n CONFIG_DB_SET_ALL_TO_DEFAULT_REQ\x10\r\x12\x1b\n\x17\x43ONFIG_DB_GET_ENTRY_REQ\x10\x0e\x12\x1b\n\x17\x43ONFIG_DB_SET_ENTRY_REQ\x10\x0f\x12&\n\"CONFIG_DB_SET_ENTRY_TO_DEFAULT_REQ\x10\x10\x12\x17\n\x13\x43ONFIG_DB_INFO_RESP\x10\x11\x12\x1d\n\x19\x43ONFIG_DB_ENTRY_DATA_RESP\x10\x12\x12\x0e\n\nMOTOR_DATA\x10\x13\x12\x11\n\rCAN_STATS_REQ\x10\x14\x12\x12\n\x0e\x43\x41N_STATS_RESP\x10\x15\x12\x1a\n\x16SENSOR_TRACE_START_REQ\x10\x16\x12\x19\n\x15SENSOR_TRACE_STOP_REQ\x10\x17\x12\x15\n\x11SENSOR_TRACE_DATA\x10\x18\x12\x12\n\x0e\x41O_PROFILE_REQ\x10\x19\x12\x13\n\x0f\x41O_PROFILE_RESP\x10\x1a\x12\x17\n\x13SIGNAL_PROFILE_RESP\x10\x1b\x12\x0c\n\x08\x43PU_LOAD\x10\x1c\x12\x18\n\x14\x45VENT_WATERMARKS_REQ\x10\x1d\x12\x19\n\x15\x45VENT_WATERMARKS_RESP\x10\x1e'
 )
 
 _MESSAGETYPE = _descriptor.EnumDescriptor(
@@ -85,11 +85,66 @@ _MESSAGETYPE = _descriptor.EnumDescriptor(
       serialized_options=None,
       type=None,
       create_key=_descriptor._internal_create_key),
+    _descriptor.EnumValueDescriptor(
+      name='CAN_STATS_REQ', index=11, number=20,
+      serialized_options=None,
+      type=None,
+      create_key=_descriptor._internal_create_key),
+    _descriptor.EnumValueDescriptor(
+      name='CAN_STATS_RESP', index=12, number=21,
+      serialized_options=None,
+      type=None,
+      create_key=_descriptor._internal_create_key),
+    _descriptor.EnumValueDescriptor(
+      name='SENSOR_TRACE_START_REQ', index=13, number=22,
+      serialized_options=None,
+      type=None,
+      create_key=_descriptor._internal_create_key),
+    _descriptor.EnumValueDescriptor(
+      name='SENSOR_TRACE_STOP_REQ', index=14, number=23,
+      serialized_options=None,
+      type=None,
+      create_key=_descriptor._internal_create_key),
+    _descriptor.EnumValueDescriptor(
+      name='SENSOR_TRACE_DATA', index=15, number=24,
+      serialized_options=None,
+      type=None,
+      create_key=_descriptor._internal_create_key),
+    _descriptor.EnumValueDescriptor(
+      name='AO_PROFILE_REQ', index=16, number=25,
+      serialized_options=None,
+      type=None,
+      create_key=_descriptor._internal_create_key),
+    _descriptor.EnumValueDescriptor(
+      name='AO_PROFILE_RESP', index=17, number=26,
+      serialized_options=None,
+      type=None,
+      create_key=_descriptor._internal_create_key),
+    _descriptor.EnumValueDescriptor(
+      name='SIGNAL_PROFILE_RESP', index=18, number=27,
+      serialized_options=None,
+      type=None,
+      create_key=_descriptor._internal_create_key),
+    _descriptor.EnumValueDescriptor(
+      name='CPU_LOAD', index=19, number=28,
+      serialized_options=None,
+      type=None,
+      create_key=_descriptor._internal_create_key),
+    _descriptor.EnumValueDescriptor(
+      name='EVENT_WATERMARKS_REQ', index=20, number=29,
+      serialized_options=None,
+      type=None,
+      create_key=_descriptor._internal_create_key),
+    _descriptor.EnumValueDescriptor(
+      name='EVENT_WATERMARKS_RESP', index=21, number=30,
+      serialized_options=None,
+      type=None,
+      create_key=_descriptor._internal_create_key),
   ],
   containing_type=None,
   serialized_options=None,
   serialized_start=22,
-  serialized_end=340,
+  serialized_end=590,
 )
 _sym_db.RegisterEnumDescriptor(_MESSAGETYPE)
 
@@ -105,6 +160,17 @@ CONFIG_DB_SET_ENTRY_TO_DEFAULT_REQ = 16
 CONFIG_DB_INFO_RESP = 17
 CONFIG_DB_ENTRY_DATA_RESP = 18
 MOTOR_DATA = 19
+CAN_STATS_REQ = 20
+CAN_STATS_RESP = 21
+SENSOR_TRACE_START_REQ = 22
+SENSOR_TRACE_STOP_REQ = 23
+SENSOR_TRACE_DATA = 24
+AO_PROFILE_REQ = 25
+AO_PROFILE_RESP = 26
+SIGNAL_PROFILE_RESP = 27
+CPU_LOAD = 28
+EVENT_WATERMARKS_REQ = 29
+EVENT_WATERMARKS_RESP = 30
 
 
 DESCRIPTOR.enum_types_by_name['MessageType'] = _MESSAGETYPE
@@ -19,7 +19,7 @@ DESCRIPTOR = _descriptor.FileDescriptor(
   syntax='proto2',
   serialized_options=None,
   create_key=_descriptor._internal_create_key,
-  serialized_pb=b'\n\x0fMotorData.proto\"\xdd\x01\n\tMotorData\x12\x19\n\x11milliseconds_tick\x18\x01 \x02(\r\x12\x13\n\x0btemperature\x18\x02 \x02(\x02\x12\x10\n\x08pressure\x18\x03 \x02(\x02\x12\x12\n\ntachometer\x18\x04 \x02(\x02\x12\x0c\n\x04vbat\x18\x05 \x02(\x02\x12\x16\n\x0e\x65ngine_minutes\x18\x06 \x02(\r\x12\r\n\x05start\x18\x07 \x02(\x08\x12\x0f\n\x07neutral\x18\x08 \x02(\x08\x12\x0e\n\x06\x62uzzer\x18\t \x02(\x08\x12\x11\n\ttemp_good\x18\n \x02(\x08\x12\x11\n\tpres_good\x18\x0b \x02(\x08'
+  serialized_pb=b'\n\x0fMotorData.proto\"\xa8\x02\n\tMotorData\x12\x19\n\x11milliseconds_tick\x18\x01 \x02(\r\x12\x13\n\x0btemperature\x18\x02 \x02(\x02\x12\x10\n\x08pressure\x18\x03 \x02(\x02\x12\x12\n\ntachometer\x18\x04 \x02(\x02\x12\x0c\n\x04vbat\x18\x05 \x02(\x02\x12\x16\n\x0e\x65ngine_minutes\x18\x06 \x02(\r\x12\r\n\x05start\x18\x07 \x02(\x08\x12\x0f\n\x07neutral\x18\x08 \x02(\x08\x12\x0e\n\x06\x62uzzer\x18\t \x02(\x08\x12\x11\n\ttemp_good\x18\n \x02(\x08\x12\x11\n\tpres_good\x18\x0b \x02(\x08\x12\x14\n\x0ctimestamp_us\x18\x0c \x02(\x04\x12\x1a\n\x12temperature_age_us\x18\r \x02(\r\x12\x17\n\x0fpressure_age_us\x18\x0e \x02(\r'
 )
 
 
@@ -110,6 +110,27 @@ _MOTORDATA = _descriptor.Descriptor(
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='timestamp_us', full_name='MotorData.timestamp_us', index=11,
+      number=12, type=4, cpp_type=4, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='temperature_age_us', full_name='MotorData.temperature_age_us', index=12,
+      number=13, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
+    _descriptor.FieldDescriptor(
+      name='pressure_age_us', full_name='MotorData.pressure_age_us', index=13,
+      number=14, type=13, cpp_type=3, label=2,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
   ],
   extensions=[
   ],
@@ -123,7 +144,7 @@ _MOTORDATA = _descriptor.Descriptor(
   oneofs=[
   ],
   serialized_start=20,
-  serialized_end=241,
+  serialized_end=316,
 )
 
 DESCRIPTOR.message_types_by_name['MotorData'] = _MOTORDATA
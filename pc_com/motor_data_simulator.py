@@ -26,6 +26,9 @@ def make_motor_data(start_time):
     msg.buzzer = int(elapsed) % 30 >= 27
     msg.temp_good = temperature < 105
     msg.pres_good = pressure > 24
+    msg.timestamp_us = int(elapsed * 1000000)
+    msg.temperature_age_us = 50000
+    msg.pressure_age_us = 20000
     return msg
 
 
@@ -1,18 +1,32 @@
 import struct
 from .crc import calculate_crc
+from .messages.AoProfile_pb2 import RtcProfileResp
+from .messages.CanStats_pb2 import CanStatsResp
 from .messages.CLIData_pb2 import CLIData
 from .messages.LogPrint_pb2 import LogPrint
+from .messages.CpuLoad_pb2 import CpuLoad
+from .messages.EventWatermarks_pb2 import EventWatermarksResp
 from .messages.ConfigDB_pb2 import ConfigDBSetEntryReq, ConfigDBGetEntryReq, ConfigDBSetEntryToDefaultReq, ConfigEntryDataResp, ConfigDBInfoResp
 from .messages.MessageType_pb2 import MessageType
 from .messages.MotorData_pb2 import MotorData
+from .messages.SensorTrace_pb2 import SensorTraceData
 
 message_from_id = {MessageType.LOG_PRINT: LogPrint,
                    MessageType.CLI_DATA: CLIData,
                    MessageType.CONFIG_DB_INFO_RESP: ConfigDBInfoResp,
                    MessageType.CONFIG_DB_ENTRY_DATA_RESP: ConfigEntryDataResp,
                    MessageType.MOTOR_DATA: MotorData,
+                   MessageType.CAN_STATS_RESP: CanStatsResp,
+                   MessageType.SENSOR_TRACE_DATA: SensorTraceData,
+                   MessageType.AO_PROFILE_RESP: RtcProfileResp,
+                   MessageType.SIGNAL_PROFILE_RESP: RtcProfileResp,
+                   MessageType.CPU_LOAD: CpuLoad,
+                   MessageType.EVENT_WATERMARKS_RESP: EventWatermarksResp,
                    }
 
+# set in a packet's type: a request the gauge passes on to the motor, or the motor's response
+MOTOR_BOARD_BIT = 0x80
+
 
 def get_message_from_packet(packet):
     """
@@ -30,7 +44,7 @@ def get_message_from_packet(packet):
     # check if crc provided by packet matches the calculated crc
     if packet_crc == crc_calc:
         # packet id follows CRC, the 3rd byte
-        packet_id = struct.unpack('<B', packet[2:3])[0]
+        packet_id = struct.unpack('<B', packet[2:3])[0] & ~MOTOR_BOARD_BIT
 
         try:
             message = message_from_id[packet_id]()
@@ -43,6 +57,20 @@ def get_message_from_packet(packet):
     return message
 
 
+def is_packet_from_motor(packet):
+    return len(packet) > 2 and (packet[2] & MOTOR_BOARD_BIT) != 0
+
+
+def address_packet_to_motor(packet):
+    """
+    Marks a built packet for the gauge to pass on to the motor, with a new CRC
+    """
+    packet_id_and_data = bytes([packet[2] | MOTOR_BOARD_BIT]) + packet[3:]
+    packet_crc = struct.pack('<H', calculate_crc(packet_id_and_data))
+
+    return packet_crc + packet_id_and_data
+
+
 def build_packet_cli_data(data: bytes):
     packet_id = struct.pack('<B', MessageType.CLI_DATA)
 
@@ -76,6 +104,46 @@ def build_packet_config_db_info_req():
 
     return packet
 
+def build_packet_can_stats_req():
+    packet_id = struct.pack('<B', MessageType.CAN_STATS_REQ)
+
+    packet_crc = struct.pack('<H', calculate_crc(packet_id))
+    packet = packet_crc + packet_id
+
+    return packet
+
+def build_packet_ao_profile_req():
+    packet_id = struct.pack('<B', MessageType.AO_PROFILE_REQ)
+
+    packet_crc = struct.pack('<H', calculate_crc(packet_id))
+    packet = packet_crc + packet_id
+
+    return packet
+
+def build_packet_event_watermarks_req():
+    packet_id = struct.pack('<B', MessageType.EVENT_WATERMARKS_REQ)
+
+    packet_crc = struct.pack('<H', calculate_crc(packet_id))
+    packet = packet_crc + packet_id
+
+    return packet
+
+def build_packet_sensor_trace_start_req():
+    packet_id = struct.pack('<B', MessageType.SENSOR_TRACE_START_REQ)
+
+    packet_crc = struct.pack('<H', calculate_crc(packet_id))
+    packet = packet_crc + packet_id
+
+    return packet
+
+def build_packet_sensor_trace_stop_req():
+    packet_id = struct.pack('<B', MessageType.SENSOR_TRACE_STOP_REQ)
+
+    packet_crc = struct.pack('<H', calculate_crc(packet_id))
+    packet = packet_crc + packet_id
+
+    return packet
+
 def build_packet_config_db_save_no_nvm_req():
     packet_id = struct.pack('<B', MessageType.CONFIG_DB_SAVE_TO_NVM_REQ)
 
@@ -0,0 +1,94 @@
+import argparse
+import sys
+import time
+
+import serial
+
+from .hdlc import HDLC, HDLCStatus
+from .messages.MessageType_pb2 import MessageType
+from .messages.SensorTrace_pb2 import SensorTraceData
+from .packets import (
+    MOTOR_BOARD_BIT,
+    address_packet_to_motor,
+    build_packet_sensor_trace_start_req,
+    build_packet_sensor_trace_stop_req,
+    get_message_from_packet,
+)
+
+
+def send(port, hdlc, packet, via_gauge):
+    if via_gauge:
+        packet = address_packet_to_motor(packet)
+    port.write(hdlc.frame_packet(packet))
+
+
+def record(port, out, seconds, via_gauge):
+    """
+    Records the motor's sensors for seconds, or until Ctrl+C, and writes the trace to out as it
+    arrives. Returns the number of records the motor dropped because its buffer was full.
+    """
+    hdlc = HDLC()
+    sequence = 0
+    lost = 0
+    stop_at = time.monotonic() + seconds if seconds else None
+    stopping = False
+
+    send(port, hdlc, build_packet_sensor_trace_start_req(), via_gauge)
+    while True:
+        if not stopping and stop_at is not None and time.monotonic() >= stop_at:
+            send(port, hdlc, build_packet_sensor_trace_stop_req(), via_gauge)
+            stopping = True
+
+        try:
+            data = port.read(4096)
+        except KeyboardInterrupt:
+            send(port, hdlc, build_packet_sensor_trace_stop_req(), via_gauge)
+            stopping = True
+            continue
+
+        for byte in data:
+            if hdlc.add_byte(byte) != HDLCStatus.MSG_OK:
+                continue
+
+            packet = hdlc.last_message
+            if len(packet) < 3 or (packet[2] & ~MOTOR_BOARD_BIT) != MessageType.SENSOR_TRACE_DATA:
+                continue
+
+            message = get_message_from_packet(packet)
+            if not isinstance(message, SensorTraceData):
+                continue
+            if message.sequence != sequence:
+                # the varints can't be resynchronised after a gap, what follows is unusable
+                print(f"packet {sequence} missing, got {message.sequence}", file=sys.stderr)
+                return None
+
+            out.write(message.data)
+            sequence += 1
+            lost = message.lost_records
+            if message.last:
+                return lost
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Record the motor's sensor inputs into a trace for the host simulation's --replay.")
+    parser.add_argument("port", help="serial port of the motor, or of the gauge with --motor-via-gauge")
+    parser.add_argument("output", help="trace file to write")
+    parser.add_argument("--seconds", type=float, default=0,
+                        help="stop recording after this long (default: on Ctrl+C)")
+    parser.add_argument("--motor-via-gauge", action="store_true",
+                        help="the port is the gauge's, which passes the requests on to the motor")
+    args = parser.parse_args()
+
+    with serial.Serial(args.port, timeout=0.1) as port, open(args.output, "wb") as out:
+        lost = record(port, out, args.seconds, args.motor_via_gauge)
+
+    if lost is None:
+        sys.exit(1)
+    if lost:
+        print(f"{lost} records were dropped by the motor, its trace buffer was full", file=sys.stderr)
+    print(f"trace written to {args.output}")
+
+
+if __name__ == "__main__":
+    main()
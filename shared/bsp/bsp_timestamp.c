@@ -0,0 +1,73 @@
+#include "bsp.h"
+#include "stm32g4xx.h"
+
+/**************************************************************************************************\
+* Private memory declarations
+\**************************************************************************************************/
+
+static uint32_t s_cycles_per_us = 1U;
+static uint32_t s_cycles_high;      // number of times CYCCNT has wrapped
+static uint32_t s_last_cycle_count; // CYCCNT at the previous extension, to detect the wrap
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+/**
+ ***************************************************************************************************
+ * @brief   Enable the DWT cycle counter, used for timestamps and on-target timing measurements.
+ *          Call once from BSP_Init, after the system clock has been configured.
+ **************************************************************************************************/
+void BSP_Cycle_Counter_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    s_cycles_per_us    = SystemCoreClock / 1000000U;
+    s_cycles_high      = 0U;
+    s_last_cycle_count = 0U;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Free running CPU cycle counter (DWT CYCCNT), wraps every 2^32 cycles (~30 s)
+ **************************************************************************************************/
+uint32_t BSP_Get_Cycle_Count(void)
+{
+    return DWT->CYCCNT;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   CPU cycle counter extended to 64 bits, never wraps.
+ *          The wrap of CYCCNT is only detected if this is called at least once per wrap period,
+ *          so it is also called from SysTick_Handler.
+ **************************************************************************************************/
+uint64_t BSP_Get_Cycle_Count_64(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t now = DWT->CYCCNT;
+    if (now < s_last_cycle_count)
+    {
+        s_cycles_high++;
+    }
+    s_last_cycle_count = now;
+
+    uint64_t cycles = ((uint64_t) s_cycles_high << 32) | now;
+
+    __set_PRIMASK(primask);
+
+    return cycles;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Microseconds since BSP_Cycle_Counter_Init(), for stamping sensor samples
+ **************************************************************************************************/
+uint64_t BSP_Get_Microseconds(void)
+{
+    return BSP_Get_Cycle_Count_64() / s_cycles_per_us;
+}
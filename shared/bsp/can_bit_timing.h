@@ -0,0 +1,48 @@
+#ifndef CAN_BIT_TIMING_H_
+#define CAN_BIT_TIMING_H_
+
+#include <assert.h>
+
+/**************************************************************************************************\
+* Public macros
+*
+* FDCAN data phase timing, shared by both boards so they always agree on it. The nominal
+* (arbitration) timing stays in MX_FDCAN2_Init() where CubeMX generates it.
+*
+* CAN_DATA_BITRATE_BPS is the bit rate switched to after the BRS bit, 0 keeps whole frames at the
+* nominal rate. It must divide the FDCAN kernel clock into 8 to 49 time quanta.
+\**************************************************************************************************/
+
+#define CAN_KERNEL_CLOCK_HZ 144000000U // PLLQ, see RCC.FDCANFreq_Value in the .ioc
+
+#ifndef CAN_DATA_BITRATE_BPS
+#define CAN_DATA_BITRATE_BPS 4500000U
+#endif
+
+#define CAN_DATA_PRESCALER 1U
+
+#if CAN_DATA_BITRATE_BPS != 0
+
+// time quanta per data bit, sampled at 75 %
+#define CAN_DATA_TQ_PER_BIT  (CAN_KERNEL_CLOCK_HZ / (CAN_DATA_PRESCALER * CAN_DATA_BITRATE_BPS))
+#define CAN_DATA_TIME_SEG1   (((CAN_DATA_TQ_PER_BIT * 3U) / 4U) - 1U)
+#define CAN_DATA_TIME_SEG2   (CAN_DATA_TQ_PER_BIT - 1U - CAN_DATA_TIME_SEG1)
+#define CAN_DATA_SYNC_JUMP_W CAN_DATA_TIME_SEG2
+
+// Transmitter delay compensation: the FDCAN checks its own bits at the sample point plus the
+// measured transceiver loop delay, without it a fast data phase sees its own bits too late
+#define CAN_DATA_TDC_OFFSET (CAN_DATA_PRESCALER * (CAN_DATA_TIME_SEG1 + 1U))
+#define CAN_DATA_TDC_FILTER 0U
+
+static_assert(
+    (CAN_KERNEL_CLOCK_HZ % (CAN_DATA_PRESCALER * CAN_DATA_BITRATE_BPS)) == 0U,
+    "CAN_DATA_BITRATE_BPS is not a whole number of time quanta");
+static_assert(
+    (CAN_DATA_TIME_SEG1 >= 1U) && (CAN_DATA_TIME_SEG1 <= 32U), "data time segment 1 out of range");
+static_assert(
+    (CAN_DATA_TIME_SEG2 >= 1U) && (CAN_DATA_TIME_SEG2 <= 16U), "data time segment 2 out of range");
+static_assert(CAN_DATA_TDC_OFFSET <= 127U, "TDC offset out of range");
+
+#endif
+
+#endif // CAN_BIT_TIMING_H_
@@ -1,6 +1,7 @@
 #ifndef CAN_INTERFACE_H_
 #define CAN_INTERFACE_H_
 
+#include "stdbool.h"
 #include "stdint.h"
 
 /**************************************************************************************************\
@@ -8,6 +9,12 @@
 \**************************************************************************************************/
 #define CAN_MAX_DATA_LENGTH 64
 
+// the write of a TX event couldn't be matched up
+#define CAN_TX_QUEUED_UNKNOWN UINT32_MAX
+
+// a frame's start couldn't be placed on the microsecond clock
+#define CAN_TIMESTAMP_UNKNOWN UINT64_MAX
+
 static const uint8_t CAN_DLC_to_Bytes[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64};
 
 /**************************************************************************************************\
@@ -17,7 +24,57 @@ typedef struct
 {
     uint32_t id; // This parameter must be a number between 0 and 0x7FF
     uint32_t dlc;
+    uint64_t timestamp_us; // received frames: start of frame, BSP_Get_Microseconds() clock
     uint8_t data[CAN_MAX_DATA_LENGTH];
 } __attribute__((packed, aligned(1))) CAN_Message_T;
 
+// fault confinement state of the controller, from the error counters
+typedef enum
+{
+    CAN_BUS_STATE_ACTIVE,  // both error counters below 96
+    CAN_BUS_STATE_WARNING, // an error counter at 96 or more
+    CAN_BUS_STATE_PASSIVE, // an error counter at 128 or more, e.g. nobody ACKs our frames
+    CAN_BUS_STATE_OFF,     // TX error counter past 255, the controller left the bus
+} CAN_Bus_State_T;
+
+// last error code of the FDCAN, PSR.LEC for the arbitration phase and PSR.DLEC for the data phase
+typedef enum
+{
+    CAN_ERROR_NONE,
+    CAN_ERROR_STUFF,     // more than 5 equal bits in a row
+    CAN_ERROR_FORM,      // a fixed format part of a frame had the wrong value
+    CAN_ERROR_ACK,       // nobody acknowledged our frame
+    CAN_ERROR_BIT1,      // sent recessive, read back dominant
+    CAN_ERROR_BIT0,      // sent dominant, read back recessive
+    CAN_ERROR_CRC,       // received CRC didn't match
+    CAN_ERROR_NO_CHANGE, // no frame on the bus since the last read
+    CAN_ERROR_CODE_COUNT,
+} CAN_Error_Code_T;
+
+typedef struct
+{
+    CAN_Bus_State_T state;
+    uint8_t tx_errors;                // transmit error counter (TEC)
+    uint8_t rx_errors;                // receive error counter (REC)
+    uint8_t errors_logged;            // protocol errors since last read (ECR.CEL)
+    CAN_Error_Code_T last_error;      // last error since last read, arbitration phase
+    CAN_Error_Code_T data_last_error; // last error since last read, data phase of FD frames
+} CAN_Bus_Status_T;
+
+typedef struct
+{
+    uint32_t nominal_bps; // arbitration phase
+    uint32_t data_bps;    // data phase, the nominal rate when bit rate switching is off
+    bool brs;             // frames are sent with bit rate switching
+} CAN_Bit_Rates_T;
+
+// a frame the FDCAN finished sending, from the TX event FIFO
+typedef struct
+{
+    uint32_t id;
+    uint32_t dlc;
+    uint32_t queued_us; // BSP_CAN_Write_Msg() to the start of the frame, CAN_TX_QUEUED_UNKNOWN
+    uint64_t sent_us;   // start of frame, BSP_Get_Microseconds() clock, CAN_TIMESTAMP_UNKNOWN
+} CAN_Tx_Event_T;
+
 #endif // CAN_INTERFACE_H_
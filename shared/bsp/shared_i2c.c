@@ -233,7 +233,8 @@ I2C_Return_T SharedI2C_Write(
     I2C_Error_Callback error_cb,
     void *cb_data)
 {
-    SharedI2CWriteEvent_T *p_i2c_write_evt = Q_NEW(SharedI2CWriteEvent_T, SHARED_I2C_WRITE_REQUEST);
+    SharedI2CWriteEvent_T *p_i2c_write_evt = EVENT_CATALOGUE_NEW(
+        SHARED_I2C_POOL_EVENTS, SharedI2CWriteEvent_T, SHARED_I2C_WRITE_REQUEST);
 
     p_i2c_write_evt->address     = address;
     p_i2c_write_evt->tx_buffer   = tx_buffer;
@@ -256,7 +257,8 @@ I2C_Return_T SharedI2C_Read(
     I2C_Error_Callback error_cb,
     void *cb_data)
 {
-    SharedI2CReadEvent_T *p_i2c_read_evt = Q_NEW(SharedI2CReadEvent_T, SHARED_I2C_READ_REQUEST);
+    SharedI2CReadEvent_T *p_i2c_read_evt = EVENT_CATALOGUE_NEW(
+        SHARED_I2C_POOL_EVENTS, SharedI2CReadEvent_T, SHARED_I2C_READ_REQUEST);
 
     p_i2c_read_evt->address     = address;
     p_i2c_read_evt->rx_buffer   = rx_buffer;
@@ -280,8 +282,8 @@ I2C_Return_T SharedI2C_MemoryRead(
     I2C_Error_Callback error_cb,
     void *cb_data)
 {
-    SharedI2CMemoryReadEvent_T *p_i2c_memread_evt = Q_NEW(
-        SharedI2CMemoryReadEvent_T, SHARED_I2C_MEMORY_READ_REQUEST);
+    SharedI2CMemoryReadEvent_T *p_i2c_memread_evt = EVENT_CATALOGUE_NEW(
+        SHARED_I2C_POOL_EVENTS, SharedI2CMemoryReadEvent_T, SHARED_I2C_MEMORY_READ_REQUEST);
 
     p_i2c_memread_evt->address          = address;
     p_i2c_memread_evt->mem_address      = mem_address;
@@ -1,6 +1,7 @@
 #ifndef SHARED_I2C_EVENTS_H_
 #define SHARED_I2C_EVENTS_H_
 
+#include "event_catalogue.h"
 #include "interfaces/i2c_bus.h"
 #include "qpc.h"
 
@@ -42,4 +43,10 @@ typedef struct
     void *cb_data;
 } SharedI2CMemoryReadEvent_T;
 
+// pool events, see event_catalogue.h; one request per I2C user in flight
+#define SHARED_I2C_POOL_EVENTS(X)     \
+    X(SharedI2CWriteEvent_T, 2U)      \
+    X(SharedI2CReadEvent_T, 2U)       \
+    X(SharedI2CMemoryReadEvent_T, 2U)
+
 #endif // SHARED_I2C_EVENTS_H_
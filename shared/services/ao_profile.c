@@ -0,0 +1,220 @@
+#include "ao_profile.h"
+#include "bsp.h"
+#include "private_signal_ranges.h"
+#include "pubsub_signals.h"
+#include "qpc.h"
+#include <string.h>
+
+/**************************************************************************************************\
+* Private type definitions
+\**************************************************************************************************/
+typedef struct
+{
+    const char *name;
+    QSignal first;
+    QSignal end; // one past the last
+} Signal_Range_T;
+
+typedef struct
+{
+    const char *name;
+    QActive *ao;
+    const struct QAsmVtable *original; // the AO's own state machine
+    struct QAsmVtable profiled;        // the same, dispatching through profiled_dispatch()
+    Histogram_T rtc_cycles;
+} AO_Slot_T;
+
+/**************************************************************************************************\
+* Private prototypes
+\**************************************************************************************************/
+static void profiled_dispatch(QAsm *const me, QEvt const *const e, uint_fast8_t const qsId);
+static size_t signal_range_of(QSignal sig);
+static void init_histograms(void);
+
+/**************************************************************************************************\
+* Private memory declarations
+\**************************************************************************************************/
+
+// the last range, matching no signal, is "other"
+static const Signal_Range_T signal_ranges[AO_PROFILE_SIGNAL_RANGES] = {
+    {"pubsub", PUBSUB_FIRST_SIG, PUBSUB_MAX_SIG},
+    {"posted", POSTED_FIRST_SIG, DISPATCHED_MAX_SIG},
+    {"blinky", PRIVATE_SIGNAL_BLINKY_START, PRIVATE_SIGNAL_BLINKY_MAX + 1},
+    {"app_cli", PRIVATE_SIGNAL_APP_CLI_START, PRIVATE_SIGNAL_APP_CLI_MAX + 1},
+    {"pc_com", PRIVATE_SIGNAL_PC_COM_START, PRIVATE_SIGNAL_PC_COM_MAX + 1},
+    {"log_com", PRIVATE_SIGNAL_LOG_COM_START, PRIVATE_SIGNAL_LOG_COM_MAX + 1},
+    {"fram", PRIVATE_SIGNAL_FRAM_START, PRIVATE_SIGNAL_FRAM_MAX + 1},
+    {"app_gui", PRIVATE_SIGNAL_APP_GUI_START, PRIVATE_SIGNAL_APP_GUI_MAX + 1},
+    {"usb", PRIVATE_SIGNAL_USB_START, PRIVATE_SIGNAL_USB_MAX + 1},
+    {"ssd1306", PRIVATE_SIGNAL_SSD1306_START, PRIVATE_SIGNAL_SSD1306_MAX + 1},
+    {"shared_i2c", PRIVATE_SIGNAL_SHARED_I2C_START, PRIVATE_SIGNAL_SHARED_I2C_MAX + 1},
+    {"pressure", PRIVATE_SIGNAL_PRESSURE_START, PRIVATE_SIGNAL_PRESSURE_MAX + 1},
+    {"lmt01", PRIVATE_SIGNAL_LMT01_START, PRIVATE_SIGNAL_LMT01_MAX + 1},
+    {"director", PRIVATE_SIGNAL_DIRECTOR_START, PRIVATE_SIGNAL_DIRECTOR_MAX + 1},
+    {"box_to_box", PRIVATE_SIGNAL_BOX_TO_BOX_START, PRIVATE_SIGNAL_BOX_TO_BOX_MAX + 1},
+    {"other", 0U, 0U},
+};
+
+// written by the dispatching AOs, read by the CLI and PC_COM, all under a critical section
+static AO_Slot_T s_slots[AO_PROFILE_MAX_AOS];
+static size_t s_slot_count;
+static uint8_t s_slot_of_prio[QF_MAX_ACTIVE + 1U]; // index + 1, 0 when not profiled
+static Histogram_T s_range_cycles[AO_PROFILE_SIGNAL_RANGES];
+
+// cycles taken by the AOs that preempted each dispatch in progress, innermost last
+static uint32_t s_preempted_cycles[QF_MAX_ACTIVE + 1U];
+static uint8_t s_depth;
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+/**
+ ***************************************************************************************************
+ * @brief   Time every run to completion of the AOs started so far. names[prio] names the AO of
+ *          that priority. Call once, after the AOs are started and before QF_run().
+ *
+ *          Each AO's state machine is reached through a copy of its vtable whose dispatch takes
+ *          the DWT cycle count around the original one. A dispatch preempted by a higher priority
+ *          AO doesn't count the cycles that AO took, so each histogram holds the AO's own work;
+ *          interrupts are still counted in.
+ **************************************************************************************************/
+void AO_Profile_Start(const char *const *names, size_t names_count)
+{
+    memset(s_slots, 0, sizeof(s_slots));
+    memset(s_slot_of_prio, 0, sizeof(s_slot_of_prio));
+    s_slot_count = 0U;
+    s_depth      = 0U;
+    init_histograms();
+
+    for (uint_fast8_t prio = 1U; prio <= QF_MAX_ACTIVE; prio++)
+    {
+        QActive *ao = QActive_registry_[prio];
+        if ((ao == NULL) || (s_slot_count >= AO_PROFILE_MAX_AOS))
+        {
+            continue;
+        }
+
+        const char *name = (prio < names_count) ? names[prio] : NULL;
+
+        AO_Slot_T *slot         = &s_slots[s_slot_count++];
+        slot->name              = (name != NULL) ? name : "?";
+        slot->ao                = ao;
+        slot->original          = ao->super.vptr;
+        slot->profiled          = *ao->super.vptr;
+        slot->profiled.dispatch = profiled_dispatch;
+        s_slot_of_prio[prio]    = (uint8_t) s_slot_count;
+
+        ao->super.vptr = &slot->profiled;
+    }
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Clear every histogram
+ **************************************************************************************************/
+void AO_Profile_Reset(void)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    init_histograms();
+    QF_CRIT_EXIT();
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   The profile of the index'th AO by priority, false past the last one
+ **************************************************************************************************/
+bool AO_Profile_Get_AO(size_t index, AO_Profile_Stats_T *stats)
+{
+    if (index >= s_slot_count)
+    {
+        return false;
+    }
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    stats->name       = s_slots[index].name;
+    stats->id         = s_slots[index].ao->prio;
+    stats->rtc_cycles = s_slots[index].rtc_cycles;
+    QF_CRIT_EXIT();
+    return true;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   The profile of the events of the index'th signal range, false past the last one
+ **************************************************************************************************/
+bool AO_Profile_Get_Signal_Range(size_t index, AO_Profile_Stats_T *stats)
+{
+    if (index >= AO_PROFILE_SIGNAL_RANGES)
+    {
+        return false;
+    }
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    stats->name       = signal_ranges[index].name;
+    stats->id         = signal_ranges[index].first;
+    stats->rtc_cycles = s_range_cycles[index];
+    QF_CRIT_EXIT();
+    return true;
+}
+
+/**************************************************************************************************\
+* Private functions
+\**************************************************************************************************/
+static void profiled_dispatch(QAsm *const me, QEvt const *const e, uint_fast8_t const qsId)
+{
+    AO_Slot_T *slot = &s_slots[s_slot_of_prio[((QActive *) me)->prio] - 1U];
+    size_t range    = signal_range_of(e->sig);
+    uint32_t start;
+    uint8_t depth;
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    depth                     = ++s_depth;
+    s_preempted_cycles[depth] = 0U;
+    start                     = BSP_Get_Cycle_Count();
+    QF_CRIT_EXIT();
+
+    slot->original->dispatch(me, e, qsId);
+
+    QF_CRIT_ENTRY();
+    uint32_t elapsed = BSP_Get_Cycle_Count() - start;
+    uint32_t cycles  = elapsed - s_preempted_cycles[depth];
+
+    s_depth--;
+    if (s_depth > 0U)
+    {
+        s_preempted_cycles[s_depth] += elapsed;
+    }
+
+    Histogram_Add(&slot->rtc_cycles, cycles);
+    Histogram_Add(&s_range_cycles[range], cycles);
+    QF_CRIT_EXIT();
+}
+
+static size_t signal_range_of(QSignal sig)
+{
+    for (size_t i = 0U; i < (AO_PROFILE_SIGNAL_RANGES - 1U); i++)
+    {
+        if ((sig >= signal_ranges[i].first) && (sig < signal_ranges[i].end))
+        {
+            return i;
+        }
+    }
+    return AO_PROFILE_SIGNAL_RANGES - 1U;
+}
+
+static void init_histograms(void)
+{
+    for (size_t i = 0U; i < AO_PROFILE_MAX_AOS; i++)
+    {
+        Histogram_Init(&s_slots[i].rtc_cycles, AO_PROFILE_RTC_SHIFT);
+    }
+    for (size_t i = 0U; i < AO_PROFILE_SIGNAL_RANGES; i++)
+    {
+        Histogram_Init(&s_range_cycles[i], AO_PROFILE_RTC_SHIFT);
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef AO_PROFILE_H_
+#define AO_PROFILE_H_
+
+#include "histogram.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************************************************\
+* Public macros
+\**************************************************************************************************/
+
+// histogram bucket 0 ends at 2^shift DWT cycles: 256 cycles (under 2 us) to 64 k cycles (455 us)
+#define AO_PROFILE_RTC_SHIFT 8U
+
+// active objects profiled, the rest run as before
+#define AO_PROFILE_MAX_AOS 12U
+
+// the ranges of private_signal_ranges.h, the public pub-sub and posted signals, and "other"
+#define AO_PROFILE_SIGNAL_RANGES 16U
+
+/**************************************************************************************************\
+* Public type definitions
+\**************************************************************************************************/
+typedef struct
+{
+    const char *name;
+    uint32_t id;            // the AO's priority, or the first signal of the range
+    Histogram_T rtc_cycles; // cycles per run to completion, less the AOs that preempted it
+} AO_Profile_Stats_T;
+
+/**************************************************************************************************\
+* Public prototypes
+\**************************************************************************************************/
+void AO_Profile_Start(const char *const *names, size_t names_count);
+void AO_Profile_Reset(void);
+
+bool AO_Profile_Get_AO(size_t index, AO_Profile_Stats_T *stats);
+bool AO_Profile_Get_Signal_Range(size_t index, AO_Profile_Stats_T *stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // AO_PROFILE_H_
@@ -1,44 +1,123 @@
 #include "box_to_box.h"
 #include "bsp.h"
+#include "can_bus_load.h"
 #include "can_messages.h"
+#include "can_rx_ring.h"
+#include "can_stats.h"
+#include "can_transport.h"
+#include "can_tx_queue.h"
 #include "fault_manager.h"
 // #include "pc_com.h"
 // #include "pressuresensor.h"
 #include "private_signal_ranges.h"
+#include "time_sync.h"
+#include <math.h>
 #include <stdio.h>
 #include <string.h>
 
+#ifdef BOARD_MOTOR
+#include "config.h"
+#endif
+
 // Q_DEFINE_THIS_MODULE("box_to_box")
 
 /**************************************************************************************************\
 * Private macros
 \**************************************************************************************************/
+#define BUS_CHECK_PERIOD_MS 100U
+#define BUS_RECOVERY_MIN_MS 50U
+#define BUS_RECOVERY_MAX_MS 5000U
+#define BUS_LOAD_WINDOW_MS  1000U
+#define TIME_SYNC_PERIOD_MS 1000U
+#define TUNNEL_TICK_MS      (CAN_TRANSPORT_RETRY_MS / 2U)
+
+// This board's end of the tunnel: segments go out as TUNNEL_<other board> and come in as
+// TUNNEL_<this board>, the acknowledgements the other way round. The structs of both directions
+// have the same fields.
+#ifdef BOARD_GAUGE
+#define TUNNEL_SEGMENT_OUT_ID       CAN_MSG_TUNNEL_MOTOR_ID
+#define TUNNEL_SEGMENT_IN_ID        CAN_MSG_TUNNEL_GAUGE_ID
+#define TUNNEL_ACK_IN_ID            CAN_MSG_TUNNEL_MOTOR_ACK_ID
+#define Tunnel_Segment_Out_T        CAN_Msg_Tunnel_Motor_T
+#define Tunnel_Segment_In_T         CAN_Msg_Tunnel_Gauge_T
+#define Tunnel_Ack_Out_T            CAN_Msg_Tunnel_Gauge_Ack_T
+#define Tunnel_Ack_In_T             CAN_Msg_Tunnel_Motor_Ack_T
+#define CAN_Pack_Tunnel_Segment     CAN_Pack_Tunnel_Motor
+#define CAN_Unpack_Tunnel_Segment   CAN_Unpack_Tunnel_Gauge
+#define CAN_Pack_Tunnel_Ack         CAN_Pack_Tunnel_Gauge_Ack
+#define CAN_Unpack_Tunnel_Ack       CAN_Unpack_Tunnel_Motor_Ack
+#endif
+#ifdef BOARD_MOTOR
+#define TUNNEL_SEGMENT_OUT_ID       CAN_MSG_TUNNEL_GAUGE_ID
+#define TUNNEL_SEGMENT_IN_ID        CAN_MSG_TUNNEL_MOTOR_ID
+#define TUNNEL_ACK_IN_ID            CAN_MSG_TUNNEL_GAUGE_ACK_ID
+#define Tunnel_Segment_Out_T        CAN_Msg_Tunnel_Gauge_T
+#define Tunnel_Segment_In_T         CAN_Msg_Tunnel_Motor_T
+#define Tunnel_Ack_Out_T            CAN_Msg_Tunnel_Motor_Ack_T
+#define Tunnel_Ack_In_T             CAN_Msg_Tunnel_Gauge_Ack_T
+#define CAN_Pack_Tunnel_Segment     CAN_Pack_Tunnel_Gauge
+#define CAN_Unpack_Tunnel_Segment   CAN_Unpack_Tunnel_Motor
+#define CAN_Pack_Tunnel_Ack         CAN_Pack_Tunnel_Motor_Ack
+#define CAN_Unpack_Tunnel_Ack       CAN_Unpack_Tunnel_Gauge_Ack
+#endif
 
 /**************************************************************************************************\
 * Private type definitions
 \**************************************************************************************************/
-typedef union
-{
-    CAN_Msg_Test1_T test1;
-    CAN_Msg_Motor_Data_T motor_data_msg;
-    CAN_Msg_TDS_T water_tds_msg;
-    CAN_Msg_Water_Good_T water_good_msg;
-} CAN_Msgs_T;
-
 enum BOX_TO_BOX_Signals
 {
     TEST_SIG = PRIVATE_SIGNAL_BOX_TO_BOX_START,
-    BUS_TIMOUT_SIG
+    BUS_CHECK_SIG,
+    BUS_RECOVERY_SIG,
+    BUS_LOAD_SIG,
+    TIME_SYNC_SIG,
+    TUNNEL_SIG,      // posted by the tunnel's other user
+    TUNNEL_TICK_SIG, // retries
 };
 
+// gauge side of a time sync exchange, complete once the next response brings the motor's t3
+typedef struct
+{
+    uint8_t sequence;
+    uint64_t request_tx_us;  // t1, CAN_TIMESTAMP_UNKNOWN until the TX event
+    uint64_t request_rx_us;  // t2, from the response
+    uint64_t response_rx_us; // t4, CAN_TIMESTAMP_UNKNOWN until the response
+} Time_Sync_Exchange_T;
+
 typedef struct
 {
     QActive super; // inherit QActive
 
     QTimeEvt testEvt;
-    QTimeEvt timeout_evt;
+    QTimeEvt bus_check_evt; // periodic PSR/ECR poll
+    QTimeEvt recovery_evt;  // bus-off backoff
+    QTimeEvt bus_load_evt;  // end of a bus load window
+    QTimeEvt time_sync_evt; // gauge: next time sync request
+    QTimeEvt tunnel_evt;    // tunnel retries
+
+    bool tx_enabled;            // frames may go to the TX FIFO, only in active
+    CAN_Bus_State_T bus_state;  // at the last PSR/ECR reading
+    uint32_t recovery_delay_ms; // backoff before the next bus-off recovery
+    CAN_Bit_Rates_T bit_rates;  // as the frames are currently sent
+    bool brs_confirmed;         // a frame got through with bit rate switching
+    CAN_Bus_Load_T bus_load;    // frames sent and received in the current window
+
+    CAN_Msg_Motor_Data_T last_motor_data; // last motor data written to the bus
+    bool motor_data_sent;                 // false until the first frame, which always goes out
+    uint32_t last_motor_data_tick;        // BSP_Get_Milliseconds_Tick() of the last frame
+    uint8_t pending_updated;              // MOTOR_DATA_UPDATED_* bits since the last frame
+    uint8_t motor_data_sequence;          // v2 frames, sent on the motor and expected on the gauge
+    bool motor_data_v2_received;          // gauge: false until the first v2 frame
+
+    uint8_t sync_sequence;                   // of the last time sync request sent or answered
+    Time_Sync_Exchange_T sync_exchanges[2U]; // gauge: the last two, indexed by sequence
+    uint64_t sync_response_tx_us;            // motor: t3 of the last response, not yet reported
+    uint8_t sync_response_tx_sequence;       // motor: of that response
 } Box_To_Box;
 
+// returns false if the frame was malformed and dropped
+typedef bool (*CAN_Rx_Handler_T)(Box_To_Box *const me, const CAN_Message_T *frame);
+
 /**************************************************************************************************\
 * Private memory declarations
 \**************************************************************************************************/
@@ -47,15 +126,77 @@ QActive *const AO_BOX_TO_BOX = &box_to_box_inst.super;
 
 uint32_t fault_bits = 0;
 
+static Box_To_Box_Stats_T s_stats;
+
+// gauge: the motor's clock, written by Box_To_Box only
+static Time_Sync_T s_time_sync;
+
+// pc_com packets to and from the other board, see Box_To_Box_Get_Tunnel_IO()
+static CAN_Transport_T s_tunnel;
+static bool s_tunnel_notify_pending; // a TUNNEL_SIG is posted but not yet handled
+static Serial_IO_Data_Ready_Callback s_tunnel_rx_cb;
+static void *s_tunnel_rx_cb_data;
+
 /**************************************************************************************************\
 * Private prototypes
 \**************************************************************************************************/
 static QState initial(Box_To_Box *const me, void const *const par);
 static QState uinitialized(Box_To_Box *const me, QEvt const *const e);
+static QState running(Box_To_Box *const me, QEvt const *const e);
 static QState active(Box_To_Box *const me, QEvt const *const e);
-static QState bus_error(Box_To_Box *const me, QEvt const *const e);
+static QState bus_off(Box_To_Box *const me, QEvt const *const e);
 
-void handle_can_message_received(Box_To_Box *const me, QEvt const *const e);
+static void send_frame(Box_To_Box *const me, const CAN_Message_T *frame);
+static void tx_pump(Box_To_Box *const me);
+static void read_tx_events(Box_To_Box *const me);
+static CAN_Bus_State_T update_bus_status(Box_To_Box *const me);
+static void handle_can_frame(Box_To_Box *const me, const CAN_Message_T *frame);
+static void time_sync_tx_event(Box_To_Box *const me, const CAN_Tx_Event_T *event);
+static void tunnel_pump(Box_To_Box *const me);
+static bool rx_tunnel_segment(Box_To_Box *const me, const CAN_Message_T *frame);
+static bool rx_tunnel_ack(Box_To_Box *const me, const CAN_Message_T *frame);
+static void tunnel_notify(void);
+static uint16_t tunnel_tx(const uint8_t *data_ptr, const uint16_t data_len);
+static uint16_t tunnel_rx(uint8_t *data_ptr, const uint16_t max_data_len);
+static void tunnel_register_cb(Serial_IO_Data_Ready_Callback cb, void *cb_data);
+
+#ifdef BOARD_GAUGE
+static bool rx_motor_data(Box_To_Box *const me, const CAN_Message_T *frame);
+static bool rx_motor_data_v2(Box_To_Box *const me, const CAN_Message_T *frame);
+static void send_time_sync_req(Box_To_Box *const me);
+static bool rx_time_sync_resp(Box_To_Box *const me, const CAN_Message_T *frame);
+#endif
+
+#ifdef BOARD_MOTOR
+static bool rx_time_sync_req(Box_To_Box *const me, const CAN_Message_T *frame);
+static bool motor_data_changed(Box_To_Box *const me, const MotorDataEvent_T *evt);
+static bool age_known_changed(uint32_t last_age_us, uint32_t age_us);
+static void scale_motor_data_v2(
+    const CAN_Msg_Motor_Data_T *motor_data, uint8_t sequence, CAN_Msg_Motor_Data_V2_T *v2);
+static uint16_t scale_to_u16(float value, float scale);
+static int16_t scale_to_i16(float value, float scale);
+#endif
+
+// handlers of the messages this board accepts, indexed by ID, see CAN_MESSAGES() rx_boards
+static const CAN_Rx_Handler_T s_rx_handlers[CAN_MSG_ID_SPAN] = {
+    [CAN_MSG_TEST1_ID]     = NULL, // bring-up frame, nothing to do with it
+    [TUNNEL_SEGMENT_IN_ID] = rx_tunnel_segment,
+    [TUNNEL_ACK_IN_ID]     = rx_tunnel_ack,
+#ifdef BOARD_GAUGE
+    [CAN_MSG_MOTOR_DATA_ID]     = rx_motor_data,
+    [CAN_MSG_MOTOR_DATA_V2_ID]  = rx_motor_data_v2,
+    [CAN_MSG_TIME_SYNC_RESP_ID] = rx_time_sync_resp,
+#endif
+#ifdef BOARD_MOTOR
+    [CAN_MSG_TIME_SYNC_REQ_ID] = rx_time_sync_req,
+#endif
+};
+
+static const Serial_IO_T s_tunnel_io = {
+    .tx_func          = tunnel_tx,
+    .rx_func          = tunnel_rx,
+    .register_cb_func = tunnel_register_cb,
+};
 
 /**************************************************************************************************\
 * Public functions
@@ -72,6 +213,108 @@ void Box_To_Box_ctor(void)
     QActive_ctor(&me->super, Q_STATE_CAST(&initial));
 
     QTimeEvt_ctorX(&me->testEvt, &me->super, TEST_SIG, 0U);
+    QTimeEvt_ctorX(&me->bus_check_evt, &me->super, BUS_CHECK_SIG, 0U);
+    QTimeEvt_ctorX(&me->recovery_evt, &me->super, BUS_RECOVERY_SIG, 0U);
+    QTimeEvt_ctorX(&me->bus_load_evt, &me->super, BUS_LOAD_SIG, 0U);
+    QTimeEvt_ctorX(&me->time_sync_evt, &me->super, TIME_SYNC_SIG, 0U);
+    QTimeEvt_ctorX(&me->tunnel_evt, &me->super, TUNNEL_TICK_SIG, 0U);
+
+    me->tx_enabled        = false;
+    me->bus_state         = CAN_BUS_STATE_ACTIVE;
+    me->recovery_delay_ms = BUS_RECOVERY_MIN_MS;
+    me->brs_confirmed     = false;
+    memset(&me->bit_rates, 0, sizeof(me->bit_rates));
+    memset(&me->bus_load, 0, sizeof(me->bus_load));
+
+    memset(&me->last_motor_data, 0, sizeof(me->last_motor_data));
+    me->motor_data_sent        = false;
+    me->last_motor_data_tick   = 0U;
+    me->pending_updated        = 0U;
+    me->motor_data_sequence    = 0U;
+    me->motor_data_v2_received = false;
+
+    me->sync_sequence = 0U;
+    for (uint32_t i = 0U; i < Q_DIM(me->sync_exchanges); i++)
+    {
+        me->sync_exchanges[i].sequence       = 0U;
+        me->sync_exchanges[i].request_tx_us  = CAN_TIMESTAMP_UNKNOWN;
+        me->sync_exchanges[i].request_rx_us  = CAN_TIMESTAMP_UNKNOWN;
+        me->sync_exchanges[i].response_rx_us = CAN_TIMESTAMP_UNKNOWN;
+    }
+    me->sync_response_tx_us       = CAN_TIMESTAMP_UNKNOWN;
+    me->sync_response_tx_sequence = 0U;
+
+    memset(&s_stats, 0, sizeof(s_stats));
+    Time_Sync_Init(&s_time_sync);
+    CAN_Transport_Init(&s_tunnel);
+    s_tunnel_notify_pending = false;
+    CAN_Stats_Init();
+    CAN_Rx_Ring_Init();
+    CAN_Tx_Queue_Init();
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Copy of the motor data publication counters
+ **************************************************************************************************/
+void Box_To_Box_Get_Stats(Box_To_Box_Stats_T *stats)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    *stats = s_stats;
+    QF_CRIT_EXIT();
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Copy of the gauge's estimate of the motor's clock
+ **************************************************************************************************/
+void Box_To_Box_Get_Time_Sync(Time_Sync_T *sync)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    *sync = s_time_sync;
+    QF_CRIT_EXIT();
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Convert a time on the other board's BSP_Get_Microseconds() clock to ours, e.g. the
+ *          motor's sample timestamps. False until the clocks are synchronised (gauge only, after
+ *          the first two time sync exchanges).
+ **************************************************************************************************/
+bool Box_To_Box_Remote_To_Local_Time(uint64_t remote_us, uint64_t *local_us)
+{
+    Time_Sync_T sync;
+    Box_To_Box_Get_Time_Sync(&sync);
+
+    if (!sync.synced)
+    {
+        return false;
+    }
+
+    *local_us = Time_Sync_Remote_To_Local(&sync, remote_us);
+    return true;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   pc_com packets to and from the other board over the CAN transport, a whole packet per
+ *          transmit and receive, no HDLC framing. Transmit returns 0 if the packet doesn't fit in
+ *          the TX buffer, receive 0 if no packet is waiting. The data ready callback is called
+ *          from Box_To_Box when one arrives, the next one is held back until it is read.
+ **************************************************************************************************/
+const Serial_IO_T *Box_To_Box_Get_Tunnel_IO(void)
+{
+    return &s_tunnel_io;
+}
+
+void Box_To_Box_Get_Tunnel_Stats(CAN_Transport_Stats_T *stats)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    *stats = s_tunnel.stats;
+    QF_CRIT_EXIT();
 }
 
 /**************************************************************************************************\
@@ -110,6 +353,8 @@ static QState uinitialized(Box_To_Box *const me, QEvt const *const e)
         }
 
         case PUBSUB_BOX_TO_BOX_STARTUP_SIG: {
+            BSP_CAN_Bus_Init();
+            BSP_CAN_Get_Bit_Rates(&me->bit_rates);
             status = Q_TRAN(&active);
             break;
         }
@@ -123,18 +368,38 @@ static QState uinitialized(Box_To_Box *const me, QEvt const *const e)
     return status;
 }
 
-static QState active(Box_To_Box *const me, QEvt const *const e)
+static QState running(Box_To_Box *const me, QEvt const *const e)
 {
     QState status;
-    uint32_t retval;
-    CAN_Msgs_T can_msg;
+    CAN_Message_T frame;
 
     switch (e->sig)
     {
         case Q_ENTRY_SIG: {
-            BSP_CAN_Bus_Init();
+            QTimeEvt_armX(
+                &me->bus_check_evt,
+                MILLISECONDS_TO_TICKS(BUS_CHECK_PERIOD_MS),
+                MILLISECONDS_TO_TICKS(BUS_CHECK_PERIOD_MS));
+            QTimeEvt_armX(
+                &me->bus_load_evt,
+                MILLISECONDS_TO_TICKS(BUS_LOAD_WINDOW_MS),
+                MILLISECONDS_TO_TICKS(BUS_LOAD_WINDOW_MS));
 
-#ifdef BOARD_MOTOR
+#ifdef BOARD_GAUGE
+            // the gauge follows the motor's clock, the motor only answers
+            QTimeEvt_armX(
+                &me->time_sync_evt,
+                MILLISECONDS_TO_TICKS(TIME_SYNC_PERIOD_MS),
+                MILLISECONDS_TO_TICKS(TIME_SYNC_PERIOD_MS));
+#endif
+
+            QTimeEvt_armX(
+                &me->tunnel_evt,
+                MILLISECONDS_TO_TICKS(TUNNEL_TICK_MS),
+                MILLISECONDS_TO_TICKS(TUNNEL_TICK_MS));
+
+#if defined(BOARD_MOTOR) && defined(DEBUG)
+            // bring-up test frame, not sent by release builds
             QTimeEvt_armX(&me->testEvt, MILLISECONDS_TO_TICKS(50), MILLISECONDS_TO_TICKS(50));
 #endif
             status = Q_HANDLED();
@@ -142,24 +407,15 @@ static QState active(Box_To_Box *const me, QEvt const *const e)
         }
 
         case TEST_SIG: {
-            can_msg.test1.id         = CAN_MSG_TEST1_ID;
-            can_msg.test1.dlc        = CAN_MSG_TEST1_DLC;
-            can_msg.test1.tick       = BSP_Get_Milliseconds_Tick();
-            can_msg.test1.variable_1 = 1;
-            can_msg.test1.variable_2 = 2;
-
-            retval = BSP_CAN_Write_Msg((CAN_Message_T *) &can_msg.test1);
-
-            // TX mailbox full, this means box1 didn't ACK last 3 messages
-            if (retval)
-            {
-                status = Q_TRAN(&bus_error);
-            }
-            else
-            {
-                status = Q_HANDLED();
-            }
+            CAN_Msg_Test1_T test1 = {
+                .tick       = BSP_Get_Milliseconds_Tick(),
+                .variable_1 = 1,
+                .variable_2 = 2,
+            };
+            CAN_Pack_Test1(&test1, &frame);
+            send_frame(me, &frame);
 
+            status = Q_HANDLED();
             break;
         }
 
@@ -178,33 +434,67 @@ static QState active(Box_To_Box *const me, QEvt const *const e)
 #ifdef BOARD_MOTOR
             const MotorDataEvent_T *evt = Q_EVT_CAST(MotorDataEvent_T);
 
-            can_msg.motor_data_msg.id             = CAN_MSG_MOTOR_DATA_ID;
-            can_msg.motor_data_msg.dlc            = CAN_MSG_MOTOR_DATA_DLC;
-            can_msg.motor_data_msg.tick           = BSP_Get_Milliseconds_Tick();
-            can_msg.motor_data_msg.temperature    = evt->temperature;
-            can_msg.motor_data_msg.pressure       = evt->pressure;
-            can_msg.motor_data_msg.tachometer     = evt->tachometer;
-            can_msg.motor_data_msg.vbat           = evt->vbat;
-            can_msg.motor_data_msg.engine_minutes = evt->engine_minutes;
-            can_msg.motor_data_msg.start          = evt->start;
-            can_msg.motor_data_msg.neutral        = evt->neutral;
-            can_msg.motor_data_msg.buzzer         = evt->buzzer;
-            can_msg.motor_data_msg.temp_good      = evt->temp_good;
-            can_msg.motor_data_msg.pres_good      = evt->pres_good;
-            memset(can_msg.motor_data_msg.reserved, 0, sizeof(can_msg.motor_data_msg.reserved));
-
-            retval = BSP_CAN_Write_Msg((CAN_Message_T *) &can_msg.motor_data_msg);
-
-            // TX mailbox full, this means box1 didn't ACK last 3 messages
-            if (retval)
+            s_stats.motor_data_events++;
+            me->pending_updated |= evt->updated;
+
+            uint32_t now_ms       = BSP_Get_Milliseconds_Tick();
+            uint32_t heartbeat_ms = Config_Read_U32(CFG_ID_CAN_HEARTBEAT_MS);
+            bool heartbeat_due    = (now_ms - me->last_motor_data_tick) >= heartbeat_ms;
+            bool changed          = motor_data_changed(me, evt);
+            if (!changed && !heartbeat_due)
             {
-                status = Q_TRAN(&bus_error);
+                s_stats.motor_data_suppressed++;
+                status = Q_HANDLED();
+                break;
+            }
+
+            CAN_Msg_Motor_Data_T motor_data = {
+                .tick               = now_ms,
+                .temperature        = evt->temperature,
+                .pressure           = evt->pressure,
+                .tachometer         = evt->tachometer,
+                .vbat               = evt->vbat,
+                .engine_minutes     = evt->engine_minutes,
+                .start              = evt->start,
+                .neutral            = evt->neutral,
+                .buzzer             = evt->buzzer,
+                .temp_good          = evt->temp_good,
+                .pres_good          = evt->pres_good,
+                .updated            = me->pending_updated,
+                .reserved           = 0U,
+                .timestamp_us       = evt->timestamp_us,
+                .temperature_age_us = evt->temperature_age_us,
+                .pressure_age_us    = evt->pressure_age_us,
+            };
+
+            if (Config_Read_U32(CFG_ID_CAN_MOTOR_DATA_VERSION) == 1U)
+            {
+                CAN_Pack_Motor_Data(&motor_data, &frame);
             }
             else
             {
-                status = Q_HANDLED();
+                CAN_Msg_Motor_Data_V2_T v2;
+                scale_motor_data_v2(&motor_data, me->motor_data_sequence, &v2);
+                CAN_Pack_Motor_Data_V2(&v2, &frame);
+                me->motor_data_sequence++;
+            }
+
+            // while the bus is down this only replaces the frame still waiting in the queue, the
+            // gauge gets the latest data once it is back
+            send_frame(me, &frame);
+
+            me->last_motor_data      = motor_data;
+            me->motor_data_sent      = true;
+            me->last_motor_data_tick = now_ms;
+            me->pending_updated      = 0U;
+
+            s_stats.motor_data_frames++;
+            if (!changed)
+            {
+                s_stats.heartbeat_frames++;
             }
 
+            status = Q_HANDLED();
             break;
 #else
             status = Q_SUPER(&QHsm_top);
@@ -212,8 +502,55 @@ static QState active(Box_To_Box *const me, QEvt const *const e)
 #endif
         }
 
-        case POSTED_CAN_MESSAGE_RECEIVED_SIG: {
-            handle_can_message_received(me, e);
+        case POSTED_CAN_FRAMES_AVAILABLE_SIG: {
+            CAN_Rx_Ring_Notify_Ack();
+            while (CAN_Rx_Ring_Pop(&frame))
+            {
+                handle_can_frame(me, &frame);
+            }
+            status = Q_HANDLED();
+            break;
+        }
+
+        case POSTED_CAN_TX_COMPLETE_SIG: {
+            read_tx_events(me);
+            status = Q_HANDLED();
+            break;
+        }
+
+        case BUS_LOAD_SIG: {
+            s_stats.bus_load = CAN_Bus_Load_Permille(me->bus_load.busy_ns, BUS_LOAD_WINDOW_MS);
+            s_stats.bus_load_nominal = CAN_Bus_Load_Permille(
+                me->bus_load.busy_nominal_ns, BUS_LOAD_WINDOW_MS);
+            memset(&me->bus_load, 0, sizeof(me->bus_load));
+
+            status = Q_HANDLED();
+            break;
+        }
+
+        case TIME_SYNC_SIG: {
+#ifdef BOARD_GAUGE
+            send_time_sync_req(me);
+            status = Q_HANDLED();
+#else
+            status = Q_SUPER(&QHsm_top);
+#endif
+            break;
+        }
+
+        case TUNNEL_SIG: {
+            QF_CRIT_STAT
+            QF_CRIT_ENTRY();
+            s_tunnel_notify_pending = false;
+            QF_CRIT_EXIT();
+
+            tunnel_pump(me);
+            status = Q_HANDLED();
+            break;
+        }
+
+        case TUNNEL_TICK_SIG: {
+            tunnel_pump(me);
             status = Q_HANDLED();
             break;
         }
@@ -227,21 +564,63 @@ static QState active(Box_To_Box *const me, QEvt const *const e)
     return status;
 }
 
-static QState bus_error(Box_To_Box *const me, QEvt const *const e)
+/**
+ ***************************************************************************************************
+ * @brief   On the bus, frames go from the TX queue to the FDCAN TX FIFO as space frees up.
+ *          Error passive (typically no gauge ACKing at the dock) stays here: the FDCAN keeps
+ *          retransmitting and the queue keeps the latest value of each message meanwhile.
+ **************************************************************************************************/
+static QState active(Box_To_Box *const me, QEvt const *const e)
 {
     QState status;
 
     switch (e->sig)
     {
         case Q_ENTRY_SIG: {
-            Fault_Manager_Generate_Fault(&me->super, FAULT_ID_CAN_FAILURE, "TX mailbox full");
+            me->tx_enabled = true;
+            tx_pump(me);
 
             status = Q_HANDLED();
             break;
         }
 
+        case Q_EXIT_SIG: {
+            me->tx_enabled = false;
+
+            status = Q_HANDLED();
+            break;
+        }
+
+        case POSTED_CAN_TX_COMPLETE_SIG: {
+            // a frame got through, so the bus works again, and at the data rate
+            me->recovery_delay_ms = BUS_RECOVERY_MIN_MS;
+            me->brs_confirmed     = me->bit_rates.brs;
+            read_tx_events(me);
+            tx_pump(me);
+            tunnel_pump(me);
+
+            status = Q_HANDLED();
+            break;
+        }
+
+        case BUS_CHECK_SIG:
+        case POSTED_CAN_BUS_STATUS_SIG: {
+            if (update_bus_status(me) == CAN_BUS_STATE_OFF)
+            {
+                status = Q_TRAN(&bus_off);
+            }
+            else
+            {
+                // also covers a TX complete event that couldn't be posted
+                read_tx_events(me);
+                tx_pump(me);
+                status = Q_HANDLED();
+            }
+            break;
+        }
+
         default: {
-            status = Q_SUPER(&QHsm_top);
+            status = Q_SUPER(&running);
             break;
         }
     }
@@ -249,44 +628,622 @@ static QState bus_error(Box_To_Box *const me, QEvt const *const e)
     return status;
 }
 
-void handle_can_message_received(Box_To_Box *const me, QEvt const *const e)
+/**
+ ***************************************************************************************************
+ * @brief   The FDCAN left the bus. After a backoff, doubled each time the bus goes off again
+ *          without a frame getting through, the recovery sequence is started and Box_To_Box goes
+ *          back to active once the controller has rejoined.
+ **************************************************************************************************/
+static QState bus_off(Box_To_Box *const me, QEvt const *const e)
 {
-    Q_UNUSED_PAR(me);
+    QState status;
 
-    CAN_Msgs_T *can_msg;
+    switch (e->sig)
+    {
+        case Q_ENTRY_SIG: {
+            s_stats.bus_off_events++;
+            Fault_Manager_Generate_Fault(&me->super, FAULT_ID_CAN_FAILURE, "CAN bus off");
 
-    const CAN_Message_Received_Event_T *msg_received_evt = Q_EVT_CAST(CAN_Message_Received_Event_T);
+            QTimeEvt_armX(&me->recovery_evt, MILLISECONDS_TO_TICKS(me->recovery_delay_ms), 0U);
+            me->recovery_delay_ms *= 2U;
+            if (me->recovery_delay_ms > BUS_RECOVERY_MAX_MS)
+            {
+                me->recovery_delay_ms = BUS_RECOVERY_MAX_MS;
+            }
 
-    can_msg = (CAN_Msgs_T *) &msg_received_evt->msg;
+            status = Q_HANDLED();
+            break;
+        }
 
-#ifdef BOARD_GAUGE
-    switch (msg_received_evt->msg.id)
-    {
-        case CAN_MSG_TEST1_ID: {
+        case Q_EXIT_SIG: {
+            QTimeEvt_disarm(&me->recovery_evt);
+
+            status = Q_HANDLED();
             break;
         }
-        case CAN_MSG_MOTOR_DATA_ID: {
-            CAN_Msg_Motor_Data_T motor_data = can_msg->motor_data_msg;
-
-            MotorDataEvent_T *event = Q_NEW(MotorDataEvent_T, PUBSUB_MOTOR_DATA_SIG);
-            event->neutral          = motor_data.neutral;
-            event->start            = motor_data.start;
-            event->temp_good        = motor_data.temp_good;
-            event->pres_good        = motor_data.pres_good;
-            event->buzzer           = motor_data.buzzer;
-            event->vbat             = motor_data.vbat;
-            event->temperature      = (float) motor_data.temperature;
-            event->pressure         = (float) motor_data.pressure;
-            event->tachometer       = (float) motor_data.tachometer;
-            event->engine_minutes   = motor_data.engine_minutes;
-            QACTIVE_PUBLISH(&event->super, &me->super);
+
+        case BUS_RECOVERY_SIG: {
+            s_stats.bus_off_recoveries++;
+            BSP_CAN_Bus_Recover();
+
+            status = Q_HANDLED();
             break;
         }
+
+        case BUS_CHECK_SIG:
+        case POSTED_CAN_BUS_STATUS_SIG: {
+            if (update_bus_status(me) != CAN_BUS_STATE_OFF)
+            {
+                status = Q_TRAN(&active);
+            }
+            else
+            {
+                status = Q_HANDLED();
+            }
+            break;
+        }
+
         default: {
+            status = Q_SUPER(&running);
             break;
         }
     }
-#else
-    Q_UNUSED_PAR(can_msg);
+
+    return status;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Queue a frame, replacing an unsent one with the same ID, and send what fits
+ **************************************************************************************************/
+static void send_frame(Box_To_Box *const me, const CAN_Message_T *frame)
+{
+    CAN_Tx_Queue_Put(frame);
+    tx_pump(me);
+}
+
+static void tx_pump(Box_To_Box *const me)
+{
+    if (!me->tx_enabled)
+    {
+        return;
+    }
+
+    const CAN_Message_T *frame;
+    while ((frame = CAN_Tx_Queue_Front()) != NULL)
+    {
+        // TX FIFO full, TX complete brings us back
+        if (BSP_CAN_Write_Msg(frame) != 0)
+        {
+            CAN_Tx_Queue_Deferred();
+            break;
+        }
+
+        CAN_Bus_Load_Add(&me->bus_load, frame->dlc, &me->bit_rates);
+        CAN_Stats_Tx(frame->id);
+        CAN_Tx_Queue_Pop();
+    }
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Per ID latency of the frames sent since the last call. The G4 TX event FIFO holds
+ *          only 3 events, the FDCAN drops newer ones while it is full.
+ **************************************************************************************************/
+static void read_tx_events(Box_To_Box *const me)
+{
+    CAN_Tx_Event_T event;
+
+    while (BSP_CAN_Read_Tx_Event(&event))
+    {
+        CAN_Stats_Tx_Event(&event, &me->bit_rates);
+        time_sync_tx_event(me, &event);
+    }
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Start of frame of our own time sync frames: t1 of the gauge's request, t3 of the
+ *          motor's response
+ **************************************************************************************************/
+static void time_sync_tx_event(Box_To_Box *const me, const CAN_Tx_Event_T *event)
+{
+#ifdef BOARD_GAUGE
+    if (event->id == CAN_MSG_TIME_SYNC_REQ_ID)
+    {
+        // a single request in flight, a newer one replaces an unsent one in the TX queue
+        me->sync_exchanges[me->sync_sequence % 2U].request_tx_us = event->sent_us;
+    }
+#endif
+#ifdef BOARD_MOTOR
+    if (event->id == CAN_MSG_TIME_SYNC_RESP_ID)
+    {
+        me->sync_response_tx_us       = event->sent_us;
+        me->sync_response_tx_sequence = me->sync_sequence;
+    }
+#endif
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Send the acknowledgement due, and segments while the window allows. Only one segment
+ *          waits in the TX queue at a time, as a newer frame with the same ID would replace it.
+ **************************************************************************************************/
+static void tunnel_pump(Box_To_Box *const me)
+{
+    CAN_Message_T frame;
+    CAN_Transport_Ack_T ack;
+    CAN_Transport_Segment_T segment;
+    uint32_t now_ms = BSP_Get_Milliseconds_Tick();
+
+    // acknowledgements are cumulative, a newer one replacing an unsent one loses nothing
+    if (CAN_Transport_Next_Ack(&s_tunnel, &ack))
+    {
+        Tunnel_Ack_Out_T msg = {
+            .next_sequence = ack.next_sequence,
+            .window        = ack.window,
+        };
+        CAN_Pack_Tunnel_Ack(&msg, &frame);
+        send_frame(me, &frame);
+    }
+
+    while (!CAN_Tx_Queue_Is_Pending(TUNNEL_SEGMENT_OUT_ID) &&
+           CAN_Transport_Next_Segment(&s_tunnel, now_ms, &segment))
+    {
+        Tunnel_Segment_Out_T msg = {
+            .sequence = segment.sequence,
+            .flags    = segment.flags,
+            .length   = segment.length,
+        };
+        memcpy(msg.data, segment.data, sizeof(msg.data));
+        CAN_Pack_Tunnel_Segment(&msg, &frame);
+        send_frame(me, &frame);
+    }
+}
+
+static CAN_Bus_State_T update_bus_status(Box_To_Box *const me)
+{
+    CAN_Bus_Status_T bus;
+    BSP_CAN_Get_Bus_Status(&bus);
+
+    if ((bus.state == CAN_BUS_STATE_PASSIVE) && (me->bus_state != CAN_BUS_STATE_PASSIVE))
+    {
+        s_stats.error_passive_events++;
+    }
+    me->bus_state = bus.state;
+    s_stats.bus   = bus;
+    CAN_Stats_Bus_Status(&bus);
+
+    // Errors in the data phase before any frame with bit rate switching got through: the other
+    // box or a transceiver can't keep up with the data rate, send whole frames at the nominal rate
+    bool data_phase_error = (bus.data_last_error != CAN_ERROR_NONE) &&
+                            (bus.data_last_error != CAN_ERROR_NO_CHANGE);
+    if (data_phase_error && me->bit_rates.brs && !me->brs_confirmed)
+    {
+        BSP_CAN_Disable_Bit_Rate_Switch();
+        BSP_CAN_Get_Bit_Rates(&me->bit_rates);
+        s_stats.brs_fallbacks++;
+    }
+
+    return bus.state;
+}
+
+static void handle_can_frame(Box_To_Box *const me, const CAN_Message_T *frame)
+{
+    // costed at our own rates, the other box switches its bit rate the same way
+    CAN_Bus_Load_Add(&me->bus_load, frame->dlc, &me->bit_rates);
+    CAN_Stats_Rx(frame->id);
+
+    // frames the acceptance filters let through that we have no use for, each one cost an
+    // interrupt, a ring slot and a dispatch; the frames the filters reject cost nothing
+    if ((frame->id < CAN_MSG_ID_SPAN) && (s_rx_handlers[frame->id] != NULL) &&
+        s_rx_handlers[frame->id](me, frame))
+    {
+        s_stats.rx_handled++;
+    }
+    else
+    {
+        s_stats.rx_unhandled++;
+    }
+}
+
+static bool rx_tunnel_segment(Box_To_Box *const me, const CAN_Message_T *frame)
+{
+    Tunnel_Segment_In_T msg;
+    if (!CAN_Unpack_Tunnel_Segment(frame, &msg))
+    {
+        return false;
+    }
+
+    CAN_Transport_Segment_T segment = {
+        .sequence = msg.sequence,
+        .flags    = msg.flags,
+        .length   = msg.length,
+    };
+    memcpy(segment.data, msg.data, sizeof(segment.data));
+
+    if (CAN_Transport_Rx_Segment(&s_tunnel, &segment) && (s_tunnel_rx_cb != NULL))
+    {
+        s_tunnel_rx_cb(s_tunnel_rx_cb_data);
+    }
+
+    tunnel_pump(me);
+    return true;
+}
+
+static bool rx_tunnel_ack(Box_To_Box *const me, const CAN_Message_T *frame)
+{
+    Tunnel_Ack_In_T msg;
+    if (!CAN_Unpack_Tunnel_Ack(frame, &msg))
+    {
+        return false;
+    }
+
+    CAN_Transport_Ack_T ack = {
+        .next_sequence = msg.next_sequence,
+        .window        = msg.window,
+    };
+    CAN_Transport_Rx_Ack(&s_tunnel, &ack, BSP_Get_Milliseconds_Tick());
+
+    tunnel_pump(me);
+    return true;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Have Box_To_Box look at the tunnel, from the context of its other user. At most one
+ *          event is outstanding.
+ **************************************************************************************************/
+static void tunnel_notify(void)
+{
+    static QEvt const event = QEVT_INITIALIZER(TUNNEL_SIG);
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    bool post               = !s_tunnel_notify_pending;
+    s_tunnel_notify_pending = true;
+    QF_CRIT_EXIT();
+
+    if (post)
+    {
+        QACTIVE_POST(AO_BOX_TO_BOX, &event, AO_BOX_TO_BOX);
+    }
+}
+
+static uint16_t tunnel_tx(const uint8_t *data_ptr, const uint16_t data_len)
+{
+    if (!CAN_Transport_Send(&s_tunnel, data_ptr, data_len))
+    {
+        return 0U;
+    }
+
+    tunnel_notify();
+    return data_len;
+}
+
+static uint16_t tunnel_rx(uint8_t *data_ptr, const uint16_t max_data_len)
+{
+    uint16_t length = CAN_Transport_Receive(&s_tunnel, data_ptr, max_data_len);
+
+    // the window opens again with the next acknowledgement
+    if (length > 0U)
+    {
+        tunnel_notify();
+    }
+
+    return length;
+}
+
+static void tunnel_register_cb(Serial_IO_Data_Ready_Callback cb, void *cb_data)
+{
+    s_tunnel_rx_cb_data = cb_data;
+    s_tunnel_rx_cb      = cb;
+}
+
+#ifdef BOARD_GAUGE
+static bool rx_motor_data(Box_To_Box *const me, const CAN_Message_T *frame)
+{
+    CAN_Msg_Motor_Data_T motor_data;
+    if (!CAN_Unpack_Motor_Data(frame, &motor_data))
+    {
+        return false;
+    }
+
+    // MotorDataEvent_T is on our clock whichever frame brought it; until the clocks are
+    // synchronised the data is stamped with the start of its frame, as v2 data always is, and its
+    // age guessed from the motor's tick
+    uint64_t timestamp_us;
+    if (Box_To_Box_Remote_To_Local_Time(motor_data.timestamp_us, &timestamp_us))
+    {
+        CAN_Stats_Rx_Age(frame->id, timestamp_us, BSP_Get_Microseconds());
+    }
+    else
+    {
+        CAN_Stats_Rx_Tick(frame->id, motor_data.tick, BSP_Get_Milliseconds_Tick());
+        timestamp_us = frame->timestamp_us;
+    }
+
+    MotorDataEvent_T *event = EVENT_CATALOGUE_NEW(
+        PUBSUB_POOL_EVENTS, MotorDataEvent_T, PUBSUB_MOTOR_DATA_SIG);
+    event->neutral            = motor_data.neutral;
+    event->start              = motor_data.start;
+    event->temp_good          = motor_data.temp_good;
+    event->pres_good          = motor_data.pres_good;
+    event->buzzer             = motor_data.buzzer;
+    event->vbat               = motor_data.vbat;
+    event->vbat_min           = motor_data.vbat; // ripple is not carried over CAN
+    event->vbat_max           = motor_data.vbat;
+    event->temperature        = motor_data.temperature;
+    event->pressure           = motor_data.pressure;
+    event->tachometer         = motor_data.tachometer;
+    event->engine_minutes     = motor_data.engine_minutes;
+    event->timestamp_us       = timestamp_us;
+    event->temperature_age_us = motor_data.temperature_age_us;
+    event->pressure_age_us    = motor_data.pressure_age_us;
+    event->updated            = motor_data.updated;
+    QACTIVE_PUBLISH(&event->super, &me->super);
+
+    s_stats.motor_data_received++;
+    return true;
+}
+
+static bool rx_motor_data_v2(Box_To_Box *const me, const CAN_Message_T *frame)
+{
+    CAN_Msg_Motor_Data_V2_T v2;
+    if (!CAN_Unpack_Motor_Data_V2(frame, &v2))
+    {
+        return false;
+    }
+
+    uint32_t status  = v2.status;
+    uint8_t sequence = (uint8_t) (status & CAN_MOTOR_DATA_V2_SEQUENCE_MASK);
+    if (me->motor_data_v2_received)
+    {
+        s_stats.motor_data_lost += (uint8_t) (sequence - me->motor_data_sequence) &
+                                   CAN_MOTOR_DATA_V2_SEQUENCE_MASK;
+    }
+    me->motor_data_sequence    = (uint8_t) (sequence + 1U);
+    me->motor_data_v2_received = true;
+
+    float vbat           = (float) v2.vbat / CAN_MOTOR_DATA_V2_VBAT_SCALE;
+    float temperature    = (float) v2.temperature / CAN_MOTOR_DATA_V2_TEMPERATURE_SCALE;
+    float pressure       = (float) v2.pressure / CAN_MOTOR_DATA_V2_PRESSURE_SCALE;
+    float tachometer     = (float) v2.tachometer / CAN_MOTOR_DATA_V2_TACHOMETER_SCALE;
+    bool has_temperature = (status & CAN_MOTOR_DATA_V2_NO_TEMPERATURE_BIT) == 0U;
+    bool has_pressure    = (status & CAN_MOTOR_DATA_V2_NO_PRESSURE_BIT) == 0U;
+
+    // v2 carries neither the motor's clock nor the sample ages, only whether there is a
+    // sample, so the data is stamped with our clock at the start of the frame
+    MotorDataEvent_T *event = EVENT_CATALOGUE_NEW(
+        PUBSUB_POOL_EVENTS, MotorDataEvent_T, PUBSUB_MOTOR_DATA_SIG);
+    event->neutral            = (status & CAN_MOTOR_DATA_V2_NEUTRAL_BIT) != 0U;
+    event->start              = (status & CAN_MOTOR_DATA_V2_START_BIT) != 0U;
+    event->temp_good          = (status & CAN_MOTOR_DATA_V2_TEMP_GOOD_BIT) != 0U;
+    event->pres_good          = (status & CAN_MOTOR_DATA_V2_PRES_GOOD_BIT) != 0U;
+    event->buzzer             = (status & CAN_MOTOR_DATA_V2_BUZZER_BIT) != 0U;
+    event->vbat               = vbat;
+    event->vbat_min           = vbat; // ripple is not carried over CAN
+    event->vbat_max           = vbat;
+    event->temperature        = temperature;
+    event->pressure           = pressure;
+    event->tachometer         = tachometer;
+    event->engine_minutes     = status >> CAN_MOTOR_DATA_V2_ENGINE_MINUTES_SHIFT;
+    event->timestamp_us       = frame->timestamp_us;
+    event->temperature_age_us = has_temperature ? 0U : SAMPLE_AGE_UNKNOWN_US;
+    event->pressure_age_us    = has_pressure ? 0U : SAMPLE_AGE_UNKNOWN_US;
+    event->updated            = MOTOR_DATA_UPDATED_ALL;
+    QACTIVE_PUBLISH(&event->super, &me->super);
+
+    s_stats.motor_data_received++;
+    return true;
+}
+
+static void send_time_sync_req(Box_To_Box *const me)
+{
+    CAN_Message_T frame;
+    CAN_Msg_Time_Sync_Req_T req = {
+        .sequence = ++me->sync_sequence,
+    };
+
+    Time_Sync_Exchange_T *exchange = &me->sync_exchanges[req.sequence % 2U];
+    exchange->sequence             = req.sequence;
+    exchange->request_tx_us        = CAN_TIMESTAMP_UNKNOWN;
+    exchange->request_rx_us        = CAN_TIMESTAMP_UNKNOWN;
+    exchange->response_rx_us       = CAN_TIMESTAMP_UNKNOWN;
+
+    CAN_Pack_Time_Sync_Req(&req, &frame);
+    send_frame(me, &frame);
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   The response completes the previous exchange with its t3, and gives t2 and t4 of this
+ *          one. An exchange missing a stamp (its TX event was dropped, a frame was lost) is
+ *          skipped, the next one is a second later.
+ **************************************************************************************************/
+static bool rx_time_sync_resp(Box_To_Box *const me, const CAN_Message_T *frame)
+{
+    CAN_Msg_Time_Sync_Resp_T resp;
+    if (!CAN_Unpack_Time_Sync_Resp(frame, &resp))
+    {
+        return false;
+    }
+
+    Time_Sync_Exchange_T *exchange = &me->sync_exchanges[resp.sequence % 2U];
+    if (exchange->sequence == resp.sequence)
+    {
+        exchange->request_rx_us  = resp.request_rx_us;
+        exchange->response_rx_us = frame->timestamp_us;
+    }
+
+    Time_Sync_Exchange_T *last = &me->sync_exchanges[resp.last_sequence % 2U];
+    if (
+        ((resp.flags & CAN_TIME_SYNC_LAST_VALID_BIT) != 0U) && (last != exchange) &&
+        (last->sequence == resp.last_sequence) &&
+        (last->request_tx_us != CAN_TIMESTAMP_UNKNOWN) &&
+        (last->response_rx_us != CAN_TIMESTAMP_UNKNOWN))
+    {
+        // only this AO writes the estimate, others read it under a critical section
+        Time_Sync_T sync = s_time_sync;
+        (void) Time_Sync_Add_Exchange(
+            &sync,
+            last->request_tx_us,
+            last->request_rx_us,
+            resp.last_response_tx_us,
+            last->response_rx_us);
+
+        QF_CRIT_STAT
+        QF_CRIT_ENTRY();
+        s_time_sync = sync;
+        QF_CRIT_EXIT();
+
+        last->response_rx_us = CAN_TIMESTAMP_UNKNOWN;
+    }
+
+    return true;
+}
 #endif
+
+#ifdef BOARD_MOTOR
+/**
+ ***************************************************************************************************
+ * @brief   Answer a time sync request with when it arrived (t2), and when the previous answer
+ *          went out (t3), which only the TX event tells
+ **************************************************************************************************/
+static bool rx_time_sync_req(Box_To_Box *const me, const CAN_Message_T *frame)
+{
+    CAN_Msg_Time_Sync_Req_T req;
+    if (!CAN_Unpack_Time_Sync_Req(frame, &req))
+    {
+        return false;
+    }
+
+    bool last_valid = me->sync_response_tx_us != CAN_TIMESTAMP_UNKNOWN;
+
+    CAN_Message_T response;
+    CAN_Msg_Time_Sync_Resp_T resp = {
+        .sequence            = req.sequence,
+        .last_sequence       = me->sync_response_tx_sequence,
+        .flags               = last_valid ? CAN_TIME_SYNC_LAST_VALID_BIT : 0U,
+        .request_rx_us       = frame->timestamp_us,
+        .last_response_tx_us = me->sync_response_tx_us,
+    };
+    CAN_Pack_Time_Sync_Resp(&resp, &response);
+
+    // each t3 is reported once
+    me->sync_response_tx_us = CAN_TIMESTAMP_UNKNOWN;
+    me->sync_sequence       = req.sequence;
+    send_frame(me, &response);
+
+    return true;
 }
+
+/**
+ ***************************************************************************************************
+ * @brief   True if any field moved past its config deadband since the last frame. Flags, engine
+ *          minutes and a sensor appearing or going missing always count as a change.
+ **************************************************************************************************/
+static bool motor_data_changed(Box_To_Box *const me, const MotorDataEvent_T *evt)
+{
+    const CAN_Msg_Motor_Data_T *last = &me->last_motor_data;
+
+    if (!me->motor_data_sent)
+    {
+        return true;
+    }
+
+    if (
+        (evt->start != last->start) || (evt->neutral != last->neutral) ||
+        (evt->buzzer != last->buzzer) || (evt->temp_good != last->temp_good) ||
+        (evt->pres_good != last->pres_good) || (evt->engine_minutes != last->engine_minutes))
+    {
+        return true;
+    }
+
+    if (
+        age_known_changed(last->temperature_age_us, evt->temperature_age_us) ||
+        age_known_changed(last->pressure_age_us, evt->pressure_age_us))
+    {
+        return true;
+    }
+
+    float temperature_deadband = Config_Read_F32(CFG_ID_CAN_TEMPERATURE_DEADBAND);
+    float pressure_deadband    = Config_Read_F32(CFG_ID_CAN_PRESSURE_DEADBAND);
+    float tachometer_deadband  = Config_Read_F32(CFG_ID_CAN_TACHOMETER_DEADBAND);
+    float vbat_deadband        = Config_Read_F32(CFG_ID_CAN_VBAT_DEADBAND);
+
+    return (fabsf(evt->temperature - last->temperature) > temperature_deadband) ||
+           (fabsf(evt->pressure - last->pressure) > pressure_deadband) ||
+           (fabsf(evt->tachometer - last->tachometer) > tachometer_deadband) ||
+           (fabsf(evt->vbat - last->vbat) > vbat_deadband);
+}
+
+static bool age_known_changed(uint32_t last_age_us, uint32_t age_us)
+{
+    return (last_age_us == SAMPLE_AGE_UNKNOWN_US) != (age_us == SAMPLE_AGE_UNKNOWN_US);
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Scale v1 motor data down to the compact v2 message, saturating out of range values
+ **************************************************************************************************/
+static void scale_motor_data_v2(
+    const CAN_Msg_Motor_Data_T *motor_data, uint8_t sequence, CAN_Msg_Motor_Data_V2_T *v2)
+{
+    uint32_t engine_minutes = motor_data->engine_minutes;
+    if (engine_minutes > CAN_MOTOR_DATA_V2_ENGINE_MINUTES_MAX)
+    {
+        engine_minutes = CAN_MOTOR_DATA_V2_ENGINE_MINUTES_MAX;
+    }
+
+    uint32_t status = (uint32_t) sequence & CAN_MOTOR_DATA_V2_SEQUENCE_MASK;
+    status |= motor_data->start ? CAN_MOTOR_DATA_V2_START_BIT : 0U;
+    status |= motor_data->neutral ? CAN_MOTOR_DATA_V2_NEUTRAL_BIT : 0U;
+    status |= motor_data->buzzer ? CAN_MOTOR_DATA_V2_BUZZER_BIT : 0U;
+    status |= motor_data->temp_good ? CAN_MOTOR_DATA_V2_TEMP_GOOD_BIT : 0U;
+    status |= motor_data->pres_good ? CAN_MOTOR_DATA_V2_PRES_GOOD_BIT : 0U;
+    if (motor_data->temperature_age_us == SAMPLE_AGE_UNKNOWN_US)
+    {
+        status |= CAN_MOTOR_DATA_V2_NO_TEMPERATURE_BIT;
+    }
+    if (motor_data->pressure_age_us == SAMPLE_AGE_UNKNOWN_US)
+    {
+        status |= CAN_MOTOR_DATA_V2_NO_PRESSURE_BIT;
+    }
+    status |= engine_minutes << CAN_MOTOR_DATA_V2_ENGINE_MINUTES_SHIFT;
+
+    v2->temperature = scale_to_i16(motor_data->temperature, CAN_MOTOR_DATA_V2_TEMPERATURE_SCALE);
+    v2->pressure    = scale_to_u16(motor_data->pressure, CAN_MOTOR_DATA_V2_PRESSURE_SCALE);
+    v2->tachometer  = scale_to_u16(motor_data->tachometer, CAN_MOTOR_DATA_V2_TACHOMETER_SCALE);
+    v2->vbat        = scale_to_u16(motor_data->vbat, CAN_MOTOR_DATA_V2_VBAT_SCALE);
+    v2->status      = status;
+}
+
+static uint16_t scale_to_u16(float value, float scale)
+{
+    float scaled = roundf(value * scale);
+
+    if (!(scaled > 0.0f)) // also catches NaN
+    {
+        return 0U;
+    }
+
+    return (scaled < (float) UINT16_MAX) ? (uint16_t) scaled : UINT16_MAX;
+}
+
+static int16_t scale_to_i16(float value, float scale)
+{
+    float scaled = roundf(value * scale);
+
+    if (scaled != scaled) // NaN
+    {
+        return 0;
+    }
+    if (scaled <= (float) INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+
+    return (scaled < (float) INT16_MAX) ? (int16_t) scaled : INT16_MAX;
+}
+#endif
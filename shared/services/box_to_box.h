@@ -1,9 +1,12 @@
 #ifndef BOX_TO_BOX_H_
 #define BOX_TO_BOX_H_
 
+#include "can_transport.h"
 #include "interfaces/can_interface.h"
+#include "interfaces/serial_interface.h"
 #include "qpc.h"
 #include "stddef.h"
+#include "time_sync.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -21,16 +24,36 @@ extern QActive *const AO_BOX_TO_BOX; // opaque pointer
 /**************************************************************************************************\
 * Public type definitions
 \**************************************************************************************************/
+// CAN counters. For motor data, events - frames is the bus load saved by the deadbands, on the
+// receiving side rx_unhandled is what the acceptance filters should have kept off the CPU
 typedef struct
 {
-    QEvt super;
-    CAN_Message_T msg;
-} CAN_Message_Received_Event_T;
+    uint32_t motor_data_events;     // PUBSUB_MOTOR_DATA_SIG received
+    uint32_t motor_data_frames;     // motor data frames queued for the bus
+    uint32_t motor_data_suppressed; // events inside every deadband, before the heartbeat was due
+    uint32_t heartbeat_frames;      // frames sent only because the heartbeat interval expired
+    uint32_t motor_data_received;   // gauge: motor data frames received, either version
+    uint32_t motor_data_lost;       // gauge: v2 frames missing from the sequence numbers
+    uint32_t rx_handled;            // received frames with a handler that accepted them
+    uint32_t rx_unhandled;          // received frames without a handler, or malformed
+    uint32_t error_passive_events;  // times the controller went error passive
+    uint32_t bus_off_events;        // times the controller went bus-off
+    uint32_t bus_off_recoveries;    // bus-off recovery sequences started
+    uint32_t brs_fallbacks;         // bit rate switching given up for data phase errors
+    CAN_Bus_Status_T bus;           // last PSR/ECR reading
+    uint16_t bus_load;              // permille of the last second taken by our frames
+    uint16_t bus_load_nominal;      // permille the same frames would take without BRS
+} Box_To_Box_Stats_T;
 
 /**************************************************************************************************\
 * Public prototypes
 \**************************************************************************************************/
 void Box_To_Box_ctor(void);
+void Box_To_Box_Get_Stats(Box_To_Box_Stats_T *stats);
+void Box_To_Box_Get_Time_Sync(Time_Sync_T *sync);
+bool Box_To_Box_Remote_To_Local_Time(uint64_t remote_us, uint64_t *local_us);
+const Serial_IO_T *Box_To_Box_Get_Tunnel_IO(void);
+void Box_To_Box_Get_Tunnel_Stats(CAN_Transport_Stats_T *stats);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,56 @@
+#include "can_bus_load.h"
+
+/**************************************************************************************************\
+* Private macros
+\**************************************************************************************************/
+
+// CAN FD base format frame, ISO 11898-1:2015. Dynamic stuff bits are not counted, they add up to
+// one bit in five depending on the payload.
+#define FD_ARBITRATION_BITS 17U // SOF, ID, RRS, IDE, FDF, res, BRS at the nominal rate
+#define FD_CONTROL_BITS     5U  // ESI, DLC at the data rate
+#define FD_CRC17_BITS       27U // stuff count, CRC and fixed stuff bits, up to 16 bytes
+#define FD_CRC21_BITS       32U // same with the 21 bit CRC, more than 16 bytes
+#define FD_TRAILER_BITS     13U // CRC delimiter, ACK, ACK delimiter, EOF, IFS at the nominal rate
+
+#define NS_PER_SECOND 1000000000ULL
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+/**
+ ***************************************************************************************************
+ * @brief   Time an FD frame with the given DLC code holds the bus
+ **************************************************************************************************/
+uint32_t CAN_Frame_Time_Ns(uint32_t dlc, const CAN_Bit_Rates_T *rates)
+{
+    uint32_t bytes        = CAN_DLC_to_Bytes[dlc & 0x0FU];
+    uint32_t crc_bits     = (bytes <= 16U) ? FD_CRC17_BITS : FD_CRC21_BITS;
+    uint32_t nominal_bits = FD_ARBITRATION_BITS + FD_TRAILER_BITS;
+    uint32_t data_bits    = FD_CONTROL_BITS + (bytes * 8U) + crc_bits;
+    uint32_t data_bps     = rates->brs ? rates->data_bps : rates->nominal_bps;
+
+    uint64_t ns = ((nominal_bits * NS_PER_SECOND) / rates->nominal_bps) +
+                  ((data_bits * NS_PER_SECOND) / data_bps);
+
+    return (uint32_t) ns;
+}
+
+void CAN_Bus_Load_Add(CAN_Bus_Load_T *load, uint32_t dlc, const CAN_Bit_Rates_T *rates)
+{
+    CAN_Bit_Rates_T nominal = {
+        .nominal_bps = rates->nominal_bps,
+        .data_bps    = rates->nominal_bps,
+        .brs         = false,
+    };
+
+    load->busy_ns += CAN_Frame_Time_Ns(dlc, rates);
+    load->busy_nominal_ns += CAN_Frame_Time_Ns(dlc, &nominal);
+}
+
+uint16_t CAN_Bus_Load_Permille(uint64_t busy_ns, uint32_t window_ms)
+{
+    uint64_t permille = (busy_ns / 1000U) / window_ms; // ns / (ms * 1000) = 1/1000ths
+
+    return (permille > 1000U) ? 1000U : (uint16_t) permille;
+}
@@ -0,0 +1,34 @@
+#ifndef CAN_BUS_LOAD_H_
+#define CAN_BUS_LOAD_H_
+
+#include "interfaces/can_interface.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************************************************\
+* Public type definitions
+\**************************************************************************************************/
+
+// Bus time of the frames seen over a window, at the rates in use and as if every frame had been
+// sent at the nominal rate, the difference being what bit rate switching saves
+typedef struct
+{
+    uint64_t busy_ns;
+    uint64_t busy_nominal_ns;
+} CAN_Bus_Load_T;
+
+/**************************************************************************************************\
+* Public prototypes
+\**************************************************************************************************/
+uint32_t CAN_Frame_Time_Ns(uint32_t dlc, const CAN_Bit_Rates_T *rates);
+void CAN_Bus_Load_Add(CAN_Bus_Load_T *load, uint32_t dlc, const CAN_Bit_Rates_T *rates);
+uint16_t CAN_Bus_Load_Permille(uint64_t busy_ns, uint32_t window_ms);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // CAN_BUS_LOAD_H_
@@ -0,0 +1,184 @@
+#include "can_messages.h"
+#include <string.h>
+
+/**************************************************************************************************\
+* Private macros
+\**************************************************************************************************/
+
+#define CAN_MSG_INFO(NAME, Name, ID, DLC, RX, PRIO) \
+    {.id = (ID), .dlc = (DLC), .rx_boards = (RX), .rx_prio = (PRIO)},
+
+#define CAN_PUT_FIELD(TYPE, name) p = put_##TYPE(p, msg->name);
+#define CAN_GET_FIELD(TYPE, name) p = get_##TYPE(p, &msg->name);
+
+#define CAN_MSG_PACK_UNPACK(NAME, Name, ID, DLC, RX, PRIO)                              \
+    void CAN_Pack_##Name(const CAN_Msg_##Name##_T *msg, CAN_Message_T *frame)           \
+    {                                                                                   \
+        uint8_t *p = frame->data;                                                       \
+        frame->id  = CAN_MSG_##NAME##_ID;                                               \
+        frame->dlc = CAN_MSG_##NAME##_DLC;                                              \
+        CAN_MSG_##NAME##_FIELDS(CAN_PUT_FIELD)                                          \
+        (void) p;                                                                       \
+    }                                                                                   \
+                                                                                        \
+    bool CAN_Unpack_##Name(const CAN_Message_T *frame, CAN_Msg_##Name##_T *msg)         \
+    {                                                                                   \
+        if ((frame->id != CAN_MSG_##NAME##_ID) || (frame->dlc != CAN_MSG_##NAME##_DLC)) \
+        {                                                                               \
+            return false;                                                               \
+        }                                                                               \
+        const uint8_t *p = frame->data;                                                 \
+        CAN_MSG_##NAME##_FIELDS(CAN_GET_FIELD)                                          \
+        (void) p;                                                                       \
+        return true;                                                                    \
+    }
+
+/**************************************************************************************************\
+* Private prototypes
+\**************************************************************************************************/
+static uint8_t *put_U8(uint8_t *p, uint8_t value);
+static uint8_t *put_U16(uint8_t *p, uint16_t value);
+static uint8_t *put_I16(uint8_t *p, int16_t value);
+static uint8_t *put_U32(uint8_t *p, uint32_t value);
+static uint8_t *put_U64(uint8_t *p, uint64_t value);
+static uint8_t *put_F32(uint8_t *p, float value);
+static uint8_t *put_BOOL(uint8_t *p, bool value);
+static uint8_t *put_SEGMENT(uint8_t *p, const uint8_t *value);
+
+static const uint8_t *get_U8(const uint8_t *p, uint8_t *value);
+static const uint8_t *get_U16(const uint8_t *p, uint16_t *value);
+static const uint8_t *get_I16(const uint8_t *p, int16_t *value);
+static const uint8_t *get_U32(const uint8_t *p, uint32_t *value);
+static const uint8_t *get_U64(const uint8_t *p, uint64_t *value);
+static const uint8_t *get_F32(const uint8_t *p, float *value);
+static const uint8_t *get_BOOL(const uint8_t *p, bool *value);
+static const uint8_t *get_SEGMENT(const uint8_t *p, CAN_Segment_T *value);
+
+/**************************************************************************************************\
+* Public memory declarations
+\**************************************************************************************************/
+const CAN_Msg_Info_T CAN_Msg_Info[CAN_MSG_COUNT] = {CAN_MESSAGES(CAN_MSG_INFO)};
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+/**
+ ***************************************************************************************************
+ * @brief   CAN_Pack_<Name>() and CAN_Unpack_<Name>() for every registered message.
+ *          Fields are written little endian in declaration order, unpack rejects a frame whose
+ *          ID or DLC isn't the registered one.
+ **************************************************************************************************/
+CAN_MESSAGES(CAN_MSG_PACK_UNPACK)
+
+/**************************************************************************************************\
+* Private functions
+\**************************************************************************************************/
+
+static uint8_t *put_U8(uint8_t *p, uint8_t value)
+{
+    p[0] = value;
+    return p + 1;
+}
+
+static uint8_t *put_U16(uint8_t *p, uint16_t value)
+{
+    p[0] = (uint8_t) value;
+    p[1] = (uint8_t) (value >> 8);
+    return p + 2;
+}
+
+static uint8_t *put_I16(uint8_t *p, int16_t value)
+{
+    return put_U16(p, (uint16_t) value);
+}
+
+static uint8_t *put_U32(uint8_t *p, uint32_t value)
+{
+    p[0] = (uint8_t) value;
+    p[1] = (uint8_t) (value >> 8);
+    p[2] = (uint8_t) (value >> 16);
+    p[3] = (uint8_t) (value >> 24);
+    return p + 4;
+}
+
+static uint8_t *put_U64(uint8_t *p, uint64_t value)
+{
+    p = put_U32(p, (uint32_t) value);
+    return put_U32(p, (uint32_t) (value >> 32));
+}
+
+static uint8_t *put_F32(uint8_t *p, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return put_U32(p, bits);
+}
+
+static uint8_t *put_BOOL(uint8_t *p, bool value)
+{
+    return put_U8(p, value ? 1U : 0U);
+}
+
+static uint8_t *put_SEGMENT(uint8_t *p, const uint8_t *value)
+{
+    memcpy(p, value, sizeof(CAN_Segment_T));
+    return p + sizeof(CAN_Segment_T);
+}
+
+static const uint8_t *get_U8(const uint8_t *p, uint8_t *value)
+{
+    *value = p[0];
+    return p + 1;
+}
+
+static const uint8_t *get_U16(const uint8_t *p, uint16_t *value)
+{
+    *value = (uint16_t) (p[0] | ((uint16_t) p[1] << 8));
+    return p + 2;
+}
+
+static const uint8_t *get_I16(const uint8_t *p, int16_t *value)
+{
+    uint16_t raw;
+    p      = get_U16(p, &raw);
+    *value = (int16_t) raw;
+    return p;
+}
+
+static const uint8_t *get_U32(const uint8_t *p, uint32_t *value)
+{
+    *value = (uint32_t) p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16) |
+             ((uint32_t) p[3] << 24);
+    return p + 4;
+}
+
+static const uint8_t *get_U64(const uint8_t *p, uint64_t *value)
+{
+    uint32_t low;
+    uint32_t high;
+    p      = get_U32(p, &low);
+    p      = get_U32(p, &high);
+    *value = ((uint64_t) high << 32) | low;
+    return p;
+}
+
+static const uint8_t *get_F32(const uint8_t *p, float *value)
+{
+    uint32_t bits;
+    p = get_U32(p, &bits);
+    memcpy(value, &bits, sizeof(bits));
+    return p;
+}
+
+static const uint8_t *get_BOOL(const uint8_t *p, bool *value)
+{
+    *value = p[0] != 0U;
+    return p + 1;
+}
+
+static const uint8_t *get_SEGMENT(const uint8_t *p, CAN_Segment_T *value)
+{
+    memcpy(*value, p, sizeof(CAN_Segment_T));
+    return p + sizeof(CAN_Segment_T);
+}
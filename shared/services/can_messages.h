@@ -1,70 +1,301 @@
+#ifndef CAN_MESSAGES_H_
+#define CAN_MESSAGES_H_
+
+#include "can_transport.h"
+#include "interfaces/can_interface.h"
 #include "stm32g4xx.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************************************************\
+* Message registry
+*
+* Every box to box message is declared once here, everything else is generated from the tables:
+* the payload structs, CAN_MSG_<NAME>_ID / _DLC / _SIZE, the DLC checks, the little endian
+* CAN_Pack_<Name>() / CAN_Unpack_<Name>() functions, CAN_Msg_Info[] and from it the FDCAN
+* acceptance filters of each board.
+*
+* X(NAME, Name, id, dlc, rx_boards, rx_prio)
+*     NAME      upper case name, for CAN_MSG_<NAME>_* and CAN_MSG_<NAME>_FIELDS
+*     Name      mixed case name, for CAN_Msg_<Name>_T and CAN_Pack_<Name>()
+*     id        standard ID, 0 to 0x7FF, also the priority on the bus (lower wins), written as
+*               a plain literal such as 12U
+*     dlc       FDCAN_DLC_BYTES_*, must match the payload size exactly
+*     rx_boards CAN_RX_* boards that accept the message in their filters
+*     rx_prio   CAN_RX_PRIO_HIGH messages are filtered to RX FIFO0, CAN_RX_PRIO_LOW to FIFO1, so
+*               a burst of low priority frames can't overflow the FIFO the motor data arrives in
+*
+* Payload fields are listed in wire order as F(type, name), type being one of the CAN_CTYPE_*
+* below, SEGMENT being a byte array. The structs are native (not packed), the wire layout only
+* exists in the pack/unpack.
+\**************************************************************************************************/
+
+#define CAN_RX_NONE  0U
+#define CAN_RX_MOTOR (1U << 0)
+#define CAN_RX_GAUGE (1U << 1)
+
+#define CAN_RX_PRIO_HIGH 0U // RX FIFO0
+#define CAN_RX_PRIO_LOW  1U // RX FIFO1
+
+#define CAN_MESSAGES(X)                                                                         \
+    X(TEST1, Test1, 1U, FDCAN_DLC_BYTES_8, CAN_RX_NONE, CAN_RX_PRIO_LOW)                        \
+    X(MOTOR_DATA, Motor_Data, 2U, FDCAN_DLC_BYTES_48, CAN_RX_GAUGE, CAN_RX_PRIO_HIGH)           \
+    X(TDS, TDS, 3U, FDCAN_DLC_BYTES_16, CAN_RX_NONE, CAN_RX_PRIO_LOW)                           \
+    X(WATER_GOOD, Water_Good, 4U, FDCAN_DLC_BYTES_5, CAN_RX_NONE, CAN_RX_PRIO_LOW)              \
+    X(MOTOR_DATA_V2, Motor_Data_V2, 5U, FDCAN_DLC_BYTES_12, CAN_RX_GAUGE, CAN_RX_PRIO_HIGH)     \
+    X(TIME_SYNC_REQ, Time_Sync_Req, 6U, FDCAN_DLC_BYTES_1, CAN_RX_MOTOR, CAN_RX_PRIO_LOW)       \
+    X(TIME_SYNC_RESP, Time_Sync_Resp, 7U, FDCAN_DLC_BYTES_20, CAN_RX_GAUGE, CAN_RX_PRIO_LOW)    \
+    X(TUNNEL_MOTOR, Tunnel_Motor, 8U, FDCAN_DLC_BYTES_64, CAN_RX_MOTOR, CAN_RX_PRIO_LOW)        \
+    X(TUNNEL_MOTOR_ACK, Tunnel_Motor_Ack, 9U, FDCAN_DLC_BYTES_2, CAN_RX_GAUGE, CAN_RX_PRIO_LOW) \
+    X(TUNNEL_GAUGE, Tunnel_Gauge, 10U, FDCAN_DLC_BYTES_64, CAN_RX_GAUGE, CAN_RX_PRIO_LOW)       \
+    X(TUNNEL_GAUGE_ACK, Tunnel_Gauge_Ack, 11U, FDCAN_DLC_BYTES_2, CAN_RX_MOTOR, CAN_RX_PRIO_LOW)
 
 /**************************************************************************************************\
 * Test Message 1
 \**************************************************************************************************/
-#define CAN_MSG_TEST1_ID  1U
-#define CAN_MSG_TEST1_DLC FDCAN_DLC_BYTES_8
+#define CAN_MSG_TEST1_FIELDS(F) \
+    F(U32, tick)                \
+    F(U16, variable_1)          \
+    F(U16, variable_2)
 
-typedef struct
-{
-    uint32_t id;
-    uint32_t dlc;
-    uint32_t tick;
-    uint16_t variable_1;
-    uint16_t variable_2;
-} __attribute__((packed, aligned(1))) CAN_Msg_Test1_T;
+/**************************************************************************************************\
+* Motor Data (v1)
+\**************************************************************************************************/
+#define CAN_MSG_MOTOR_DATA_FIELDS(F)                                                      \
+    F(U32, tick)                                                                          \
+    F(F32, temperature) /* degrees C */                                                   \
+    F(F32, pressure)    /* PSI */                                                         \
+    F(F32, tachometer)  /* RPM */                                                         \
+    F(F32, vbat)        /* volts */                                                       \
+    F(U32, engine_minutes)                                                                \
+    F(BOOL, start)                                                                        \
+    F(BOOL, neutral)                                                                      \
+    F(BOOL, buzzer)                                                                       \
+    F(BOOL, temp_good)                                                                    \
+    F(BOOL, pres_good)                                                                    \
+    F(U8, updated)  /* MOTOR_DATA_UPDATED_* bits */                                       \
+    F(U16, reserved)                                                                      \
+    F(U64, timestamp_us)       /* motor's microsecond clock when the data was gathered */ \
+    F(U32, temperature_age_us) /* SAMPLE_AGE_UNKNOWN_US if there is no sample yet */      \
+    F(U32, pressure_age_us)    /* SAMPLE_AGE_UNKNOWN_US if there is no sample yet */
 
 /**************************************************************************************************\
-* Motor Data
+* Motor Data, compact v2
+*
+* Scaled integers and a status word instead of floats and bools, 12 bytes so it fits a
+* classic-CAN-sized DLC. Samples are stamped with the receiver's clock, the sample ages are
+* reduced to whether there is a sample at all, and a 4 bit sequence number shows lost frames.
+* Without the motor's tick, the sample ages and the updated bits it is opt in
+* (can_motor_data_version), the motor sends v1 by default.
 \**************************************************************************************************/
-#define CAN_MSG_MOTOR_DATA_ID  2U
-#define CAN_MSG_MOTOR_DATA_DLC FDCAN_DLC_BYTES_32
+#define CAN_MOTOR_DATA_V2_TEMPERATURE_SCALE 100.0f  // centi-degrees C
+#define CAN_MOTOR_DATA_V2_PRESSURE_SCALE    100.0f  // centi-PSI
+#define CAN_MOTOR_DATA_V2_TACHOMETER_SCALE  1.0f    // RPM
+#define CAN_MOTOR_DATA_V2_VBAT_SCALE        1000.0f // millivolts
 
-typedef struct
-{
-    uint32_t id;  // unique message ID
-    uint32_t dlc; // Data Length Code
-    uint32_t tick;
-    float temperature; // degrees C
-    float pressure;    // PSI
-    float tachometer;  // RPM
-    float vbat;        // volts
-    uint32_t engine_minutes;
-    bool start;
-    bool neutral;
-    bool buzzer;
-    bool temp_good;
-    bool pres_good;
-    uint8_t reserved[3];
-} __attribute__((packed, aligned(1))) CAN_Msg_Motor_Data_T;
+// status word layout
+#define CAN_MOTOR_DATA_V2_SEQUENCE_MASK        0x0000000FU
+#define CAN_MOTOR_DATA_V2_START_BIT            (1U << 4)
+#define CAN_MOTOR_DATA_V2_NEUTRAL_BIT          (1U << 5)
+#define CAN_MOTOR_DATA_V2_BUZZER_BIT           (1U << 6)
+#define CAN_MOTOR_DATA_V2_TEMP_GOOD_BIT        (1U << 7)
+#define CAN_MOTOR_DATA_V2_PRES_GOOD_BIT        (1U << 8)
+#define CAN_MOTOR_DATA_V2_NO_TEMPERATURE_BIT   (1U << 9)   // no temperature sample yet
+#define CAN_MOTOR_DATA_V2_NO_PRESSURE_BIT      (1U << 10)  // no pressure sample yet
+#define CAN_MOTOR_DATA_V2_ENGINE_MINUTES_SHIFT 11U
+#define CAN_MOTOR_DATA_V2_ENGINE_MINUTES_MAX   0x001FFFFFU // 21 bits, ~35000 hours
+
+#define CAN_MSG_MOTOR_DATA_V2_FIELDS(F)                           \
+    F(I16, temperature) /* CAN_MOTOR_DATA_V2_TEMPERATURE_SCALE */ \
+    F(U16, pressure)    /* CAN_MOTOR_DATA_V2_PRESSURE_SCALE */    \
+    F(U16, tachometer)  /* CAN_MOTOR_DATA_V2_TACHOMETER_SCALE */  \
+    F(U16, vbat)        /* CAN_MOTOR_DATA_V2_VBAT_SCALE */        \
+    F(U32, status)      /* sequence, flags and engine minutes */
 
 /**************************************************************************************************\
 * Water salinity + temperature message
 \**************************************************************************************************/
-#define CAN_MSG_TDS_ID  3U
-#define CAN_MSG_TDS_DLC FDCAN_DLC_BYTES_16
+#define CAN_MSG_TDS_FIELDS(F)   \
+    F(U32, tick)                \
+    F(F32, water_temperature_C) \
+    F(F32, water_salinity_PPM)  \
+    F(U32, fault_status)
 
-typedef struct
+/**************************************************************************************************\
+* Water Good Message (controls box 2 blue LED)
+\**************************************************************************************************/
+#define CAN_MSG_WATER_GOOD_FIELDS(F) \
+    F(U32, tick)                     \
+    F(BOOL, water_good)
+
+/**************************************************************************************************\
+* Time sync, gauge to motor and back
+*
+* The FDCAN stamps the start of every frame, sent or received, so both ends of an exchange are
+* timed by hardware: the gauge sends a request at t1 (its TX event), the motor receives it at t2,
+* answers at t3 (the motor's TX event) and the gauge receives that at t4. t3 is only known once the
+* answer is gone, so each response carries the t3 of the previous one (two step, as in PTP).
+\**************************************************************************************************/
+#define CAN_TIME_SYNC_LAST_VALID_BIT (1U << 0) // last_response_tx_us is known
+
+#define CAN_MSG_TIME_SYNC_REQ_FIELDS(F) \
+    F(U8, sequence)
+
+#define CAN_MSG_TIME_SYNC_RESP_FIELDS(F)                                     \
+    F(U8, sequence)             /* of the request answered */                \
+    F(U8, last_sequence)        /* of the response last_response_tx_us is */ \
+    F(U16, flags)               /* CAN_TIME_SYNC_* */                        \
+    F(U64, request_rx_us)       /* t2, motor's microsecond clock */          \
+    F(U64, last_response_tx_us) /* t3 of last_sequence */
+
+/**************************************************************************************************\
+* Tunnel, pc_com packets between the boards
+*
+* The segments and acknowledgements of can_transport.h, a pair of messages per direction so the
+* filters of each board only take what is meant for it: TUNNEL_<BOARD> carries segments to that
+* board, TUNNEL_<BOARD>_ACK its acknowledgements back. The IDs are the highest in use, so the
+* tunnel only gets the bus when nothing else wants it.
+\**************************************************************************************************/
+#define CAN_MSG_TUNNEL_SEGMENT_FIELDS(F)     \
+    F(U8, sequence)                          \
+    F(U8, flags)   /* CAN_TRANSPORT_*_BIT */ \
+    F(U16, length) /* bytes of data used */  \
+    F(SEGMENT, data)
+
+#define CAN_MSG_TUNNEL_ACK_FIELDS(F)                        \
+    F(U8, next_sequence) /* every segment before arrived */ \
+    F(U8, window)        /* segments taken from there on */
+
+#define CAN_MSG_TUNNEL_MOTOR_FIELDS     CAN_MSG_TUNNEL_SEGMENT_FIELDS
+#define CAN_MSG_TUNNEL_MOTOR_ACK_FIELDS CAN_MSG_TUNNEL_ACK_FIELDS
+#define CAN_MSG_TUNNEL_GAUGE_FIELDS     CAN_MSG_TUNNEL_SEGMENT_FIELDS
+#define CAN_MSG_TUNNEL_GAUGE_ACK_FIELDS CAN_MSG_TUNNEL_ACK_FIELDS
+
+/**************************************************************************************************\
+* Field types
+\**************************************************************************************************/
+typedef uint8_t CAN_Segment_T[CAN_TRANSPORT_SEGMENT_BYTES];
+
+#define CAN_CTYPE_U8      uint8_t
+#define CAN_CTYPE_U16     uint16_t
+#define CAN_CTYPE_I16     int16_t
+#define CAN_CTYPE_U32     uint32_t
+#define CAN_CTYPE_U64     uint64_t
+#define CAN_CTYPE_F32     float
+#define CAN_CTYPE_BOOL    bool
+#define CAN_CTYPE_SEGMENT CAN_Segment_T
+
+#define CAN_WIRE_SIZE_U8      1U
+#define CAN_WIRE_SIZE_U16     2U
+#define CAN_WIRE_SIZE_I16     2U
+#define CAN_WIRE_SIZE_U32     4U
+#define CAN_WIRE_SIZE_U64     8U
+#define CAN_WIRE_SIZE_F32     4U
+#define CAN_WIRE_SIZE_BOOL    1U
+#define CAN_WIRE_SIZE_SEGMENT CAN_TRANSPORT_SEGMENT_BYTES
+
+// payload bytes of a DLC code, usable in constant expressions (CAN_DLC_to_Bytes[] is not)
+#define CAN_DLC_BYTES(dlc)                        \
+    ((dlc) <= 8U    ? (dlc)                       \
+     : (dlc) <= 12U ? (12U + (((dlc) - 9U) * 4U)) \
+                    : (32U + (((dlc) - 13U) * 16U)))
+
+/**************************************************************************************************\
+* Generated declarations
+\**************************************************************************************************/
+#define CAN_MSG_FIELD_DECLARE(TYPE, name) CAN_CTYPE_##TYPE name;
+#define CAN_MSG_FIELD_SIZE(TYPE, name)    +CAN_WIRE_SIZE_##TYPE
+
+#define CAN_MSG_CONSTANTS(NAME, Name, ID, DLC, RX, PRIO) \
+    CAN_MSG_##NAME##_ID   = (ID),                        \
+    CAN_MSG_##NAME##_DLC  = (DLC),                       \
+    CAN_MSG_##NAME##_SIZE = (0U CAN_MSG_##NAME##_FIELDS(CAN_MSG_FIELD_SIZE)),
+
+#define CAN_MSG_INDEX(NAME, Name, ID, DLC, RX, PRIO) CAN_MSG_INDEX_##NAME,
+
+#define CAN_MSG_STRUCT(NAME, Name, ID, DLC, RX, PRIO)  \
+    typedef struct                                     \
+    {                                                  \
+        CAN_MSG_##NAME##_FIELDS(CAN_MSG_FIELD_DECLARE) \
+    } CAN_Msg_##Name##_T;
+
+#define CAN_MSG_CHECKS(NAME, Name, ID, DLC, RX, PRIO)                             \
+    static_assert((ID) <= 0x7FFU, #NAME ": not a standard ID");                   \
+    static_assert((DLC) <= 15U, #NAME ": not a DLC code, use FDCAN_DLC_BYTES_*"); \
+    static_assert(                                                                \
+        CAN_MSG_##NAME##_SIZE == CAN_DLC_BYTES(DLC), #NAME ": payload size does not match DLC");
+
+#define CAN_MSG_PROTOTYPES(NAME, Name, ID, DLC, RX, PRIO)                      \
+    void CAN_Pack_##Name(const CAN_Msg_##Name##_T *msg, CAN_Message_T *frame); \
+    bool CAN_Unpack_##Name(const CAN_Message_T *frame, CAN_Msg_##Name##_T *msg);
+
+// one enumerator named after each ID, so a duplicated ID is a duplicate enumerator
+#define CAN_MSG_ID_UNIQUE(NAME, Name, ID, DLC, RX, PRIO) CAN_MSG_ID_##ID##_TAKEN,
+
+#define CAN_MSG_ID_SPAN_MEMBER(NAME, Name, ID, DLC, RX, PRIO) uint8_t NAME[(ID) + 1U];
+
+/**************************************************************************************************\
+* Public macros
+\**************************************************************************************************/
+enum
 {
-    uint32_t id;  // unique message ID
-    uint32_t dlc; // Data Length Code
-    uint32_t tick;
-    float32_t water_temperature_C;
-    float32_t water_salinity_PPM;
-    uint32_t fault_status;
-} __attribute__((packed, aligned(1))) CAN_Msg_TDS_T;
+    CAN_MESSAGES(CAN_MSG_CONSTANTS)
+};
+
+enum
+{
+    CAN_MESSAGES(CAN_MSG_INDEX) CAN_MSG_COUNT
+};
+
+enum
+{
+    CAN_MESSAGES(CAN_MSG_ID_UNIQUE)
+};
+
+CAN_MESSAGES(CAN_MSG_CHECKS)
+
+// highest registered ID + 1, the size of a table indexed by ID
+typedef union
+{
+    CAN_MESSAGES(CAN_MSG_ID_SPAN_MEMBER)
+} CAN_Msg_ID_Span_T;
+#define CAN_MSG_ID_SPAN (sizeof(CAN_Msg_ID_Span_T))
+
+#if defined(BOARD_MOTOR)
+#define CAN_RX_THIS_BOARD CAN_RX_MOTOR
+#elif defined(BOARD_GAUGE)
+#define CAN_RX_THIS_BOARD CAN_RX_GAUGE
+#endif
 
 /**************************************************************************************************\
-* Water Good Message (controls box 2 blue LED)
+* Public type definitions
 \**************************************************************************************************/
-#define CAN_MSG_WATER_GOOD_ID  4U
-#define CAN_MSG_WATER_GOOD_DLC FDCAN_DLC_BYTES_5
+CAN_MESSAGES(CAN_MSG_STRUCT)
 
 typedef struct
 {
-    uint32_t id;
-    uint32_t dlc;
-    uint32_t tick;
-    bool water_good;
-} __attribute__((packed, aligned(1))) CAN_Msg_Water_Good_T;
+    uint16_t id;
+    uint8_t dlc;
+    uint8_t rx_boards; // CAN_RX_* bits
+    uint8_t rx_prio;   // CAN_RX_PRIO_*
+} CAN_Msg_Info_T;
+
+/**************************************************************************************************\
+* Public memory declarations
+\**************************************************************************************************/
+extern const CAN_Msg_Info_T CAN_Msg_Info[CAN_MSG_COUNT];
+
+/**************************************************************************************************\
+* Public prototypes
+\**************************************************************************************************/
+CAN_MESSAGES(CAN_MSG_PROTOTYPES)
+
+#ifdef __cplusplus
+}
+#endif
+#endif // CAN_MESSAGES_H_
@@ -0,0 +1,180 @@
+#include "can_rx_ring.h"
+#include "qpc.h"
+#include <assert.h>
+#include <string.h>
+
+/**************************************************************************************************\
+* Private macros
+\**************************************************************************************************/
+
+static_assert(
+    (CAN_RX_RING_LENGTH & (CAN_RX_RING_LENGTH - 1U)) == 0U,
+    "CAN_RX_RING_LENGTH must be a power of two");
+
+#define RING_MASK (CAN_RX_RING_LENGTH - 1U)
+
+/**************************************************************************************************\
+* Private memory declarations
+\**************************************************************************************************/
+static CAN_Message_T s_ring[CAN_RX_RING_LENGTH];
+static CAN_Message_T s_scratch; // FIFO elements are read into this when the ring is full
+
+// The ring has a single producer (the FDCAN RX interrupt) and a single consumer (Box_To_Box).
+// Each side only writes its own index, after the frame itself is written or read, and the
+// indices and s_notify_pending are only touched under a critical section; the frames are not.
+static uint32_t s_head; // written by the producer only, free running
+static uint32_t s_tail; // written by the consumer only, free running
+static bool s_reserved;
+static bool s_notify_pending; // a frames-available event is posted but not yet handled
+
+static CAN_Rx_Ring_Stats_T s_stats;
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+/**
+ ***************************************************************************************************
+ * @brief   Empty the ring and clear the counters, before the FDCAN is started
+ **************************************************************************************************/
+void CAN_Rx_Ring_Init(void)
+{
+    s_head           = 0U;
+    s_tail           = 0U;
+    s_reserved       = false;
+    s_notify_pending = false;
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Slot for the next received frame, read the FDCAN element straight into it and then
+ *          call CAN_Rx_Ring_Commit(). Never NULL: when the ring is full a scratch slot is
+ *          returned so the FIFO element can still be released, and the frame is counted as an
+ *          overflow instead of being committed.
+ **************************************************************************************************/
+CAN_Message_T *CAN_Rx_Ring_Reserve(void)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    uint32_t head = s_head;
+    uint32_t used = head - s_tail;
+    QF_CRIT_EXIT();
+
+    if (used >= CAN_RX_RING_LENGTH)
+    {
+        s_reserved = false;
+        return &s_scratch;
+    }
+
+    s_reserved = true;
+    return &s_ring[head & RING_MASK];
+}
+
+void CAN_Rx_Ring_Commit(void)
+{
+    if (!s_reserved)
+    {
+        s_stats.overflows++;
+        return;
+    }
+
+    s_reserved = false;
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    s_head++;
+    uint32_t used = s_head - s_tail;
+    s_stats.frames++;
+    if (used > s_stats.high_water)
+    {
+        s_stats.high_water = used;
+    }
+    QF_CRIT_EXIT();
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   The FDCAN reported a full RX FIFO dropping a frame (RF0L / RF1L)
+ **************************************************************************************************/
+void CAN_Rx_Ring_Fifo_Lost(void)
+{
+    s_stats.fifo_lost++;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   True if the interrupt must post a frames-available event. At most one is outstanding,
+ *          so a burst of frames can never fill the Box_To_Box queue.
+ *          Call CAN_Rx_Ring_Notify_Failed() if the post doesn't go through.
+ **************************************************************************************************/
+bool CAN_Rx_Ring_Notify_Needed(void)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    bool needed = !s_notify_pending && (s_tail != s_head);
+    if (needed)
+    {
+        s_notify_pending = true;
+        s_stats.notifies++;
+    }
+    QF_CRIT_EXIT();
+
+    return needed;
+}
+
+void CAN_Rx_Ring_Notify_Failed(void)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    s_notify_pending = false;
+    s_stats.notifies--;
+    QF_CRIT_EXIT();
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   The frames-available event arrived, call before draining the ring with
+ *          CAN_Rx_Ring_Pop(). Frames committed after this raise a new event.
+ **************************************************************************************************/
+void CAN_Rx_Ring_Notify_Ack(void)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    s_notify_pending = false;
+    QF_CRIT_EXIT();
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Take the oldest frame out of the ring, false if it is empty
+ **************************************************************************************************/
+bool CAN_Rx_Ring_Pop(CAN_Message_T *frame)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    uint32_t tail = s_tail;
+    bool empty    = tail == s_head;
+    QF_CRIT_EXIT();
+
+    if (empty)
+    {
+        return false;
+    }
+
+    *frame = s_ring[tail & RING_MASK];
+
+    QF_CRIT_ENTRY();
+    s_tail = tail + 1U;
+    QF_CRIT_EXIT();
+
+    return true;
+}
+
+void CAN_Rx_Ring_Get_Stats(CAN_Rx_Ring_Stats_T *stats)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    *stats = s_stats;
+    QF_CRIT_EXIT();
+}
@@ -0,0 +1,54 @@
+#ifndef CAN_RX_RING_H_
+#define CAN_RX_RING_H_
+
+#include "interfaces/can_interface.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************************************************\
+* Public macros
+\**************************************************************************************************/
+
+// received frames waiting for Box_To_Box, must be a power of two
+#ifndef CAN_RX_RING_LENGTH
+#define CAN_RX_RING_LENGTH 16U
+#endif
+
+/**************************************************************************************************\
+* Public type definitions
+\**************************************************************************************************/
+typedef struct
+{
+    uint32_t frames;     // frames put in the ring
+    uint32_t overflows;  // frames read out of the FDCAN but dropped because the ring was full
+    uint32_t fifo_lost;  // RF0L / RF1L events, frames the FDCAN dropped because its FIFO was full
+    uint32_t high_water; // most frames ever waiting in the ring
+    uint32_t notifies;   // frames-available events posted
+} CAN_Rx_Ring_Stats_T;
+
+/**************************************************************************************************\
+* Public prototypes
+\**************************************************************************************************/
+void CAN_Rx_Ring_Init(void);
+
+// producer side, from the FDCAN RX interrupt
+CAN_Message_T *CAN_Rx_Ring_Reserve(void);
+void CAN_Rx_Ring_Commit(void);
+void CAN_Rx_Ring_Fifo_Lost(void);
+bool CAN_Rx_Ring_Notify_Needed(void);
+void CAN_Rx_Ring_Notify_Failed(void);
+
+// consumer side, from Box_To_Box
+void CAN_Rx_Ring_Notify_Ack(void);
+bool CAN_Rx_Ring_Pop(CAN_Message_T *frame);
+
+void CAN_Rx_Ring_Get_Stats(CAN_Rx_Ring_Stats_T *stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // CAN_RX_RING_H_
@@ -0,0 +1,177 @@
+#include "can_stats.h"
+#include "can_bus_load.h"
+#include "qpc.h"
+#include <stdbool.h>
+#include <string.h>
+
+/**************************************************************************************************\
+* Private type definitions
+\**************************************************************************************************/
+typedef struct
+{
+    int32_t min_offset_ms; // our tick - sender's tick of the quickest frame so far
+    bool offset_known;
+} CAN_Rx_Clock_T;
+
+/**************************************************************************************************\
+* Private memory declarations
+\**************************************************************************************************/
+
+// written by Box_To_Box only, read by the CLI and PC_COM under a critical section
+static CAN_Id_Stats_T s_ids[CAN_MSG_ID_SPAN];
+static CAN_Rx_Clock_T s_rx_clocks[CAN_MSG_ID_SPAN];
+static CAN_Error_Stats_T s_errors;
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+/**
+ ***************************************************************************************************
+ * @brief   Clear every counter and histogram
+ **************************************************************************************************/
+void CAN_Stats_Init(void)
+{
+    memset(s_ids, 0, sizeof(s_ids));
+    memset(s_rx_clocks, 0, sizeof(s_rx_clocks));
+    memset(&s_errors, 0, sizeof(s_errors));
+
+    for (uint32_t id = 0U; id < CAN_MSG_ID_SPAN; id++)
+    {
+        Histogram_Init(&s_ids[id].tx_latency_us, CAN_STATS_TX_LATENCY_SHIFT);
+        Histogram_Init(&s_ids[id].rx_age_us, CAN_STATS_RX_AGE_SHIFT);
+    }
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   A frame went to the FDCAN. IDs outside the message registry aren't counted here, the
+ *          filters keep them out and Box_To_Box counts them as unhandled.
+ **************************************************************************************************/
+void CAN_Stats_Tx(uint32_t id)
+{
+    if (id < CAN_MSG_ID_SPAN)
+    {
+        s_ids[id].tx_frames++;
+    }
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   The FDCAN sent a frame. The latency adds the frame's own duration at the current bit
+ *          rates to the time it waited, as the ACK slot is at its end.
+ **************************************************************************************************/
+void CAN_Stats_Tx_Event(const CAN_Tx_Event_T *event, const CAN_Bit_Rates_T *rates)
+{
+    if (event->id >= CAN_MSG_ID_SPAN)
+    {
+        return;
+    }
+
+    CAN_Id_Stats_T *stats = &s_ids[event->id];
+    stats->tx_events++;
+
+    if (event->queued_us == CAN_TX_QUEUED_UNKNOWN)
+    {
+        s_errors.tx_events_unmatched++;
+        return;
+    }
+
+    uint32_t frame_us = CAN_Frame_Time_Ns(event->dlc, rates) / 1000U;
+    Histogram_Add(&stats->tx_latency_us, event->queued_us + frame_us);
+}
+
+void CAN_Stats_Rx(uint32_t id)
+{
+    if (id < CAN_MSG_ID_SPAN)
+    {
+        s_ids[id].rx_frames++;
+    }
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Age of a received frame from when the sender stamped it, already converted to our
+ *          clock by the time sync
+ **************************************************************************************************/
+void CAN_Stats_Rx_Age(uint32_t id, uint64_t sent_us, uint64_t now_us)
+{
+    if (id >= CAN_MSG_ID_SPAN)
+    {
+        return;
+    }
+
+    // the estimate is off by a few us, which can put a quick frame's sending after now
+    uint64_t age_us = (now_us > sent_us) ? (now_us - sent_us) : 0U;
+    Histogram_Add(&s_ids[id].rx_age_us, (age_us < UINT32_MAX) ? (uint32_t) age_us : UINT32_MAX);
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Age of a received frame from the millisecond tick the sender put in it, for when the
+ *          clocks aren't synchronised (yet). The difference between the two boards' ticks is
+ *          taken relative to the smallest one seen: the age is how much longer this frame took
+ *          than the quickest one, with 1 ms resolution.
+ **************************************************************************************************/
+void CAN_Stats_Rx_Tick(uint32_t id, uint32_t sent_tick_ms, uint32_t now_tick_ms)
+{
+    if (id >= CAN_MSG_ID_SPAN)
+    {
+        return;
+    }
+
+    CAN_Rx_Clock_T *clock = &s_rx_clocks[id];
+    int32_t offset_ms     = (int32_t) (now_tick_ms - sent_tick_ms);
+
+    if (
+        !clock->offset_known || (offset_ms < clock->min_offset_ms) ||
+        ((uint32_t) (offset_ms - clock->min_offset_ms) > CAN_STATS_RX_AGE_RESYNC_MS))
+    {
+        clock->min_offset_ms = offset_ms;
+        clock->offset_known  = true;
+    }
+
+    uint32_t age_ms = (uint32_t) (offset_ms - clock->min_offset_ms);
+    Histogram_Add(&s_ids[id].rx_age_us, age_ms * 1000U);
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Accumulate a PSR/ECR reading, the error log and last error codes clear on every read
+ **************************************************************************************************/
+void CAN_Stats_Bus_Status(const CAN_Bus_Status_T *bus)
+{
+    s_errors.bus = *bus;
+    s_errors.errors_logged += bus->errors_logged;
+
+    if (bus->last_error < CAN_ERROR_CODE_COUNT)
+    {
+        s_errors.last_errors[bus->last_error]++;
+    }
+    if (bus->data_last_error < CAN_ERROR_CODE_COUNT)
+    {
+        s_errors.data_last_errors[bus->data_last_error]++;
+    }
+}
+
+void CAN_Stats_Get_Id(uint32_t id, CAN_Id_Stats_T *stats)
+{
+    if (id >= CAN_MSG_ID_SPAN)
+    {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    *stats = s_ids[id];
+    QF_CRIT_EXIT();
+}
+
+void CAN_Stats_Get_Errors(CAN_Error_Stats_T *stats)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    *stats = s_errors;
+    QF_CRIT_EXIT();
+}
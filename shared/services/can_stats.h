@@ -0,0 +1,63 @@
+#ifndef CAN_STATS_H_
+#define CAN_STATS_H_
+
+#include "can_messages.h"
+#include "histogram.h"
+#include "interfaces/can_interface.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************************************************\
+* Public macros
+\**************************************************************************************************/
+
+// histogram bucket 0 ends at 2^shift us: TX latency from 32 us to 8 ms, RX age from 128 us to 32 ms
+#define CAN_STATS_TX_LATENCY_SHIFT 5U
+#define CAN_STATS_RX_AGE_SHIFT     7U
+
+// an age this far above the best seen is the sender restarting its clock, not a slow frame
+#define CAN_STATS_RX_AGE_RESYNC_MS 10000U
+
+/**************************************************************************************************\
+* Public type definitions
+\**************************************************************************************************/
+typedef struct
+{
+    uint32_t tx_frames;        // frames handed to the FDCAN
+    uint32_t tx_events;        // frames the TX event FIFO reported sent
+    uint32_t rx_frames;        // frames received
+    Histogram_T tx_latency_us; // write to the end of the acknowledged frame
+    Histogram_T rx_age_us;     // sender's stamp to reception, see CAN_Stats_Rx_Age/_Tick()
+} CAN_Id_Stats_T;
+
+typedef struct
+{
+    CAN_Bus_Status_T bus;                            // last PSR/ECR reading
+    uint32_t errors_logged;                          // ECR.CEL summed up
+    uint32_t last_errors[CAN_ERROR_CODE_COUNT];      // PSR.LEC readings by code
+    uint32_t data_last_errors[CAN_ERROR_CODE_COUNT]; // PSR.DLEC readings by code
+    uint32_t tx_events_unmatched;                    // TX events without a latency
+} CAN_Error_Stats_T;
+
+/**************************************************************************************************\
+* Public prototypes
+\**************************************************************************************************/
+void CAN_Stats_Init(void);
+
+void CAN_Stats_Tx(uint32_t id);
+void CAN_Stats_Tx_Event(const CAN_Tx_Event_T *event, const CAN_Bit_Rates_T *rates);
+void CAN_Stats_Rx(uint32_t id);
+void CAN_Stats_Rx_Age(uint32_t id, uint64_t sent_us, uint64_t now_us);
+void CAN_Stats_Rx_Tick(uint32_t id, uint32_t sent_tick_ms, uint32_t now_tick_ms);
+void CAN_Stats_Bus_Status(const CAN_Bus_Status_T *bus);
+
+void CAN_Stats_Get_Id(uint32_t id, CAN_Id_Stats_T *stats);
+void CAN_Stats_Get_Errors(CAN_Error_Stats_T *stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // CAN_STATS_H_
@@ -0,0 +1,437 @@
+#include "can_transport.h"
+#include "qpc.h"
+#include <assert.h>
+#include <string.h>
+
+/**************************************************************************************************\
+* Private macros
+\**************************************************************************************************/
+
+static_assert(
+    (CAN_TRANSPORT_TX_BUFFER & (CAN_TRANSPORT_TX_BUFFER - 1U)) == 0U,
+    "CAN_TRANSPORT_TX_BUFFER must be a power of two");
+static_assert(
+    CAN_TRANSPORT_TX_BUFFER >= (CAN_TRANSPORT_MAX_MESSAGE + 2U),
+    "CAN_TRANSPORT_TX_BUFFER must hold the longest message");
+
+// sequence numbers are compared modulo 256, a message must stay well within half of that
+static_assert(
+    ((CAN_TRANSPORT_MAX_MESSAGE + CAN_TRANSPORT_SEGMENT_BYTES - 1U) / CAN_TRANSPORT_SEGMENT_BYTES) <
+        128U,
+    "CAN_TRANSPORT_MAX_MESSAGE takes too many segments");
+
+#define TX_BUFFER_MASK (CAN_TRANSPORT_TX_BUFFER - 1U)
+#define LENGTH_BYTES   2U
+
+/**************************************************************************************************\
+* Private prototypes
+\**************************************************************************************************/
+static bool start_message(CAN_Transport_T *transport);
+static void finish_message(CAN_Transport_T *transport);
+static void tx_buffer_write(
+    CAN_Transport_T *transport, uint32_t at, const uint8_t *data, uint32_t length);
+static void tx_buffer_read(
+    const CAN_Transport_T *transport, uint32_t at, uint8_t *data, uint32_t length);
+static void count_by_caller(uint32_t *counter);
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+void CAN_Transport_Init(CAN_Transport_T *transport)
+{
+    memset(transport, 0, sizeof(*transport));
+
+    // until told otherwise the peer is taken to be ready, and to have lost track of us
+    transport->tx_sync        = true;
+    transport->tx_peer_window = CAN_TRANSPORT_WINDOW;
+    transport->rx_advertised  = CAN_TRANSPORT_WINDOW;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Queue a message, false if there isn't room for it in the TX buffer
+ **************************************************************************************************/
+bool CAN_Transport_Send(CAN_Transport_T *transport, const uint8_t *data, uint16_t length)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    uint32_t head = transport->tx_head;
+    uint32_t used = head - transport->tx_tail;
+    QF_CRIT_EXIT();
+
+    if (
+        (length == 0U) || (length > CAN_TRANSPORT_MAX_MESSAGE) ||
+        ((CAN_TRANSPORT_TX_BUFFER - used) < (LENGTH_BYTES + length)))
+    {
+        count_by_caller(&transport->stats.messages_refused);
+        return false;
+    }
+
+    uint8_t header[LENGTH_BYTES] = {(uint8_t) length, (uint8_t) (length >> 8)};
+    tx_buffer_write(transport, head, header, LENGTH_BYTES);
+    tx_buffer_write(transport, head + LENGTH_BYTES, data, length);
+
+    // the owner only sees the message once it is all in the buffer
+    QF_CRIT_ENTRY();
+    transport->tx_head = head + LENGTH_BYTES + length;
+    QF_CRIT_EXIT();
+
+    return true;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Copy out the message received, 0 if there is none. Reading it frees the receive buffer,
+ *          the owner then opens the window again with its next acknowledgement. A message longer
+ *          than max_length is dropped.
+ **************************************************************************************************/
+uint16_t CAN_Transport_Receive(CAN_Transport_T *transport, uint8_t *data, uint16_t max_length)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    bool held = transport->rx_held;
+    QF_CRIT_EXIT();
+
+    if (!held)
+    {
+        return 0U;
+    }
+
+    uint16_t length = transport->rx_length;
+    if (length > max_length)
+    {
+        count_by_caller(&transport->stats.messages_unread);
+        length = 0U;
+    }
+    else
+    {
+        memcpy(data, transport->rx_buffer, length);
+    }
+
+    QF_CRIT_ENTRY();
+    transport->rx_held = false;
+    QF_CRIT_EXIT();
+
+    return length;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Next segment to put on the bus, false if there is none for now: nothing queued, the
+ *          window is full, or everything is sent and waiting to be acknowledged. Call again after
+ *          each acknowledgement and periodically, for the retries.
+ **************************************************************************************************/
+bool CAN_Transport_Next_Segment(
+    CAN_Transport_T *transport, uint32_t now_ms, CAN_Transport_Segment_T *segment)
+{
+    if (!transport->tx_active && !start_message(transport))
+    {
+        return false;
+    }
+
+    // waiting on the peer, for acknowledgements or for it to open its window
+    bool force   = false;
+    bool waiting = (transport->tx_sent != transport->tx_acked) || (transport->tx_peer_window == 0U);
+    if (waiting && ((now_ms - transport->tx_progress_ms) >= CAN_TRANSPORT_RETRY_MS))
+    {
+        transport->tx_retries++;
+        if (transport->tx_retries > CAN_TRANSPORT_MAX_RETRIES)
+        {
+            // the peer is gone or stuck, when it is back it may have restarted
+            transport->stats.messages_dropped++;
+            transport->tx_sync = true;
+            finish_message(transport);
+            if (!start_message(transport))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            // go back to the oldest segment, sent even into a closed window to get an answer
+            transport->stats.retransmits++;
+            transport->tx_sent = transport->tx_acked;
+            force              = true;
+        }
+    }
+
+    if (transport->tx_sent >= transport->tx_segments)
+    {
+        return false;
+    }
+
+    uint8_t window = (transport->tx_peer_window < CAN_TRANSPORT_WINDOW)
+                         ? transport->tx_peer_window
+                         : (uint8_t) CAN_TRANSPORT_WINDOW;
+    if (!force && ((uint8_t) (transport->tx_sent - transport->tx_acked) >= window))
+    {
+        return false;
+    }
+
+    if (transport->tx_sent == transport->tx_acked)
+    {
+        transport->tx_progress_ms = now_ms;
+    }
+
+    uint32_t offset = (uint32_t) transport->tx_sent * CAN_TRANSPORT_SEGMENT_BYTES;
+    uint32_t length = transport->tx_length - offset;
+    if (length > CAN_TRANSPORT_SEGMENT_BYTES)
+    {
+        length = CAN_TRANSPORT_SEGMENT_BYTES;
+    }
+
+    segment->sequence = (uint8_t) (transport->tx_first_seq + transport->tx_sent);
+    segment->flags    = 0U;
+    segment->length   = (uint16_t) length;
+    if (transport->tx_sent == 0U)
+    {
+        segment->flags |= CAN_TRANSPORT_FIRST_BIT;
+        segment->flags |= transport->tx_sync ? CAN_TRANSPORT_SYNC_BIT : 0U;
+    }
+    if (transport->tx_sent == (transport->tx_segments - 1U))
+    {
+        segment->flags |= CAN_TRANSPORT_LAST_BIT;
+    }
+
+    tx_buffer_read(transport, transport->tx_tail + LENGTH_BYTES + offset, segment->data, length);
+    memset(&segment->data[length], 0, CAN_TRANSPORT_SEGMENT_BYTES - length);
+
+    transport->tx_sent++;
+    transport->stats.segments_sent++;
+    return true;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Acknowledgement to send, false if none is due. One goes out every half window, at the
+ *          end of a message, for every segment that wasn't taken, and when the window opens again.
+ **************************************************************************************************/
+bool CAN_Transport_Next_Ack(CAN_Transport_T *transport, CAN_Transport_Ack_T *ack)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    uint8_t window = transport->rx_held ? 0U : (uint8_t) CAN_TRANSPORT_WINDOW;
+    QF_CRIT_EXIT();
+
+    if (!transport->rx_ack_due && (window == transport->rx_advertised))
+    {
+        return false;
+    }
+
+    ack->next_sequence = transport->rx_next_seq;
+    ack->window        = window;
+
+    transport->rx_advertised = window;
+    transport->rx_ack_due    = false;
+    transport->rx_since_ack  = 0U;
+    transport->stats.acks_sent++;
+    return true;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   A segment from the peer, true if it completed a message for CAN_Transport_Receive().
+ *          Only the next segment in sequence is taken. A first segment restarts the message, and
+ *          also the sequence numbers if the peer asks for it or we haven't heard from it yet.
+ **************************************************************************************************/
+bool CAN_Transport_Rx_Segment(CAN_Transport_T *transport, const CAN_Transport_Segment_T *segment)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    bool held = transport->rx_held;
+    QF_CRIT_EXIT();
+
+    bool first = (segment->flags & CAN_TRANSPORT_FIRST_BIT) != 0U;
+    bool last  = (segment->flags & CAN_TRANSPORT_LAST_BIT) != 0U;
+
+    transport->stats.segments_received++;
+
+    if (
+        first && !held &&
+        (((segment->flags & CAN_TRANSPORT_SYNC_BIT) != 0U) || !transport->rx_synced))
+    {
+        transport->rx_next_seq = segment->sequence;
+        transport->rx_synced   = true;
+    }
+
+    if (
+        held || !transport->rx_synced || (segment->sequence != transport->rx_next_seq) ||
+        (segment->length > CAN_TRANSPORT_SEGMENT_BYTES))
+    {
+        // tell the peer where we are, it goes back there after its timeout
+        transport->stats.segments_ignored++;
+        transport->rx_ack_due = true;
+        return false;
+    }
+
+    transport->rx_next_seq++;
+    transport->rx_since_ack++;
+    if ((transport->rx_since_ack >= (CAN_TRANSPORT_WINDOW / 2U)) || last)
+    {
+        transport->rx_ack_due = true;
+    }
+
+    if (first)
+    {
+        if (transport->rx_in_message)
+        {
+            transport->stats.messages_lost++;
+        }
+        transport->rx_in_message = true;
+        transport->rx_length     = 0U;
+    }
+
+    // the rest of a message whose start we missed
+    if (!transport->rx_in_message)
+    {
+        return false;
+    }
+
+    if ((transport->rx_length + segment->length) > CAN_TRANSPORT_MAX_MESSAGE)
+    {
+        transport->stats.messages_lost++;
+        transport->rx_in_message = false;
+        return false;
+    }
+
+    memcpy(&transport->rx_buffer[transport->rx_length], segment->data, segment->length);
+    transport->rx_length += segment->length;
+
+    if (!last)
+    {
+        return false;
+    }
+
+    transport->rx_in_message = false;
+    transport->stats.messages_received++;
+
+    QF_CRIT_ENTRY();
+    transport->rx_held = true;
+    QF_CRIT_EXIT();
+
+    return true;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   An acknowledgement from the peer. One that doesn't fall within the message being sent
+ *          is stale, or from a peer that lost track of us, and the timeout sorts that out.
+ **************************************************************************************************/
+void CAN_Transport_Rx_Ack(
+    CAN_Transport_T *transport, const CAN_Transport_Ack_T *ack, uint32_t now_ms)
+{
+    if (!transport->tx_active)
+    {
+        transport->tx_peer_window = ack->window;
+        return;
+    }
+
+    uint8_t acked = (uint8_t) (ack->next_sequence - transport->tx_first_seq);
+    if ((acked > transport->tx_segments) || (acked < transport->tx_acked))
+    {
+        return;
+    }
+
+    transport->tx_sync        = false;
+    transport->tx_peer_window = ack->window;
+
+    if (acked > transport->tx_acked)
+    {
+        transport->tx_acked       = acked;
+        transport->tx_retries     = 0U;
+        transport->tx_progress_ms = now_ms;
+        if (transport->tx_sent < acked)
+        {
+            transport->tx_sent = acked;
+        }
+    }
+
+    if (transport->tx_acked == transport->tx_segments)
+    {
+        transport->stats.messages_sent++;
+        finish_message(transport);
+    }
+}
+
+/**************************************************************************************************\
+* Private functions
+\**************************************************************************************************/
+
+static bool start_message(CAN_Transport_T *transport)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    bool empty = transport->tx_head == transport->tx_tail;
+    QF_CRIT_EXIT();
+
+    if (empty)
+    {
+        return false;
+    }
+
+    uint8_t header[LENGTH_BYTES];
+    tx_buffer_read(transport, transport->tx_tail, header, LENGTH_BYTES);
+
+    transport->tx_length   = (uint16_t) (header[0] | ((uint16_t) header[1] << 8));
+    transport->tx_segments = (uint8_t) ((transport->tx_length + CAN_TRANSPORT_SEGMENT_BYTES - 1U) /
+                                        CAN_TRANSPORT_SEGMENT_BYTES);
+    transport->tx_first_seq = transport->tx_next_seq;
+    transport->tx_acked     = 0U;
+    transport->tx_sent      = 0U;
+    transport->tx_retries   = 0U;
+    transport->tx_active    = true;
+
+    return true;
+}
+
+static void finish_message(CAN_Transport_T *transport)
+{
+    transport->tx_next_seq = (uint8_t) (transport->tx_first_seq + transport->tx_segments);
+    transport->tx_active   = false;
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    transport->tx_tail += LENGTH_BYTES + transport->tx_length;
+    QF_CRIT_EXIT();
+}
+
+static void tx_buffer_write(
+    CAN_Transport_T *transport, uint32_t at, const uint8_t *data, uint32_t length)
+{
+    uint32_t start = at & TX_BUFFER_MASK;
+    uint32_t first = CAN_TRANSPORT_TX_BUFFER - start;
+
+    if (first > length)
+    {
+        first = length;
+    }
+
+    memcpy(&transport->tx_buffer[start], data, first);
+    memcpy(transport->tx_buffer, &data[first], length - first);
+}
+
+static void tx_buffer_read(
+    const CAN_Transport_T *transport, uint32_t at, uint8_t *data, uint32_t length)
+{
+    uint32_t start = at & TX_BUFFER_MASK;
+    uint32_t first = CAN_TRANSPORT_TX_BUFFER - start;
+
+    if (first > length)
+    {
+        first = length;
+    }
+
+    memcpy(data, &transport->tx_buffer[start], first);
+    memcpy(&data[first], transport->tx_buffer, length - first);
+}
+
+// CAN_Transport_Send() and CAN_Transport_Receive() run in the caller's AO, while the owner and
+// Box_To_Box_Get_Tunnel_Stats() work on the rest of the stats
+static void count_by_caller(uint32_t *counter)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    (*counter)++;
+    QF_CRIT_EXIT();
+}
@@ -0,0 +1,120 @@
+#ifndef CAN_TRANSPORT_H_
+#define CAN_TRANSPORT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************************************************\
+* Public macros
+\**************************************************************************************************/
+
+// A message is cut into segments of up to CAN_TRANSPORT_SEGMENT_BYTES, one per 64 byte frame, each
+// with a sequence number. The receiver acknowledges the next sequence it expects and how many
+// segments it takes from there (its window), which is 0 while it holds a complete message nobody
+// has read yet. Segments that aren't acknowledged in time are sent again from the oldest (go back
+// N), a message that gets nowhere in CAN_TRANSPORT_MAX_RETRIES tries is dropped.
+#define CAN_TRANSPORT_SEGMENT_BYTES 60U
+#define CAN_TRANSPORT_WINDOW        4U    // segments sent ahead of the acknowledgement
+#define CAN_TRANSPORT_MAX_MESSAGE   3072U // bytes, the receive buffer
+#define CAN_TRANSPORT_TX_BUFFER     4096U // bytes of queued messages, 2 + length each
+#define CAN_TRANSPORT_RETRY_MS      50U
+#define CAN_TRANSPORT_MAX_RETRIES   5U
+
+// CAN_Transport_Segment_T.flags
+#define CAN_TRANSPORT_FIRST_BIT (1U << 0) // first segment of a message
+#define CAN_TRANSPORT_LAST_BIT  (1U << 1) // last segment of a message
+#define CAN_TRANSPORT_SYNC_BIT  (1U << 2) // sender (re)started, take its sequence numbers
+
+/**************************************************************************************************\
+* Public type definitions
+\**************************************************************************************************/
+typedef struct
+{
+    uint8_t sequence;
+    uint8_t flags;   // CAN_TRANSPORT_*_BIT
+    uint16_t length; // bytes of data used
+    uint8_t data[CAN_TRANSPORT_SEGMENT_BYTES];
+} CAN_Transport_Segment_T;
+
+typedef struct
+{
+    uint8_t next_sequence; // every segment before this one arrived
+    uint8_t window;        // segments taken from next_sequence on
+} CAN_Transport_Ack_T;
+
+typedef struct
+{
+    uint32_t messages_sent;     // completely acknowledged
+    uint32_t messages_dropped;  // given up after CAN_TRANSPORT_MAX_RETRIES
+    uint32_t messages_refused;  // CAN_Transport_Send() without room in the TX buffer
+    uint32_t segments_sent;     // including the ones sent again
+    uint32_t retransmits;       // timeouts that went back to the oldest segment
+    uint32_t messages_received; // complete messages
+    uint32_t messages_lost;     // too long for the receive buffer or cut short
+    uint32_t messages_unread;   // too long for the buffer CAN_Transport_Receive() was given
+    uint32_t segments_received;
+    uint32_t segments_ignored;  // duplicates, out of order or while a message was held
+    uint32_t acks_sent;
+} CAN_Transport_Stats_T;
+
+// One end of a link, both directions. The owner (Box_To_Box) does the segments and
+// acknowledgements, CAN_Transport_Send() and CAN_Transport_Receive() may be called by one other AO.
+// What both sides touch, tx_head, tx_tail, rx_held and that AO's two counters (messages_refused
+// and messages_unread), is read and written under a critical section.
+typedef struct
+{
+    // queued messages, written by CAN_Transport_Send() only
+    uint8_t tx_buffer[CAN_TRANSPORT_TX_BUFFER];
+    uint32_t tx_head; // free running, written by the sender only
+    uint32_t tx_tail; // free running, start of the message being sent, written by the owner only
+
+    // message being sent
+    bool tx_active;
+    bool tx_sync;            // SYNC_BIT on first segments until the peer acknowledges one
+    uint16_t tx_length;      // bytes
+    uint8_t tx_segments;     // in the message
+    uint8_t tx_first_seq;    // sequence of its first segment
+    uint8_t tx_acked;        // segments acknowledged
+    uint8_t tx_sent;         // segments sent since the last go back
+    uint8_t tx_peer_window;  // segments the peer takes from tx_acked on
+    uint8_t tx_retries;      // timeouts without progress
+    uint8_t tx_next_seq;     // sequence of the first segment of the next message
+    uint32_t tx_progress_ms; // last segment sent into an empty window or acknowledged
+
+    // message being received
+    uint8_t rx_buffer[CAN_TRANSPORT_MAX_MESSAGE];
+    uint16_t rx_length;
+    bool rx_synced;        // rx_next_seq follows the peer
+    bool rx_in_message;    // between a first and a last segment
+    bool rx_held;          // complete and not read yet, cleared by the reader
+    bool rx_ack_due;       // an acknowledgement should go out
+    uint8_t rx_next_seq;   // next sequence expected
+    uint8_t rx_since_ack;  // segments taken since the last acknowledgement
+    uint8_t rx_advertised; // window in the last acknowledgement
+
+    CAN_Transport_Stats_T stats;
+} CAN_Transport_T;
+
+/**************************************************************************************************\
+* Public prototypes
+\**************************************************************************************************/
+void CAN_Transport_Init(CAN_Transport_T *transport);
+
+bool CAN_Transport_Send(CAN_Transport_T *transport, const uint8_t *data, uint16_t length);
+uint16_t CAN_Transport_Receive(CAN_Transport_T *transport, uint8_t *data, uint16_t max_length);
+
+bool CAN_Transport_Next_Segment(
+    CAN_Transport_T *transport, uint32_t now_ms, CAN_Transport_Segment_T *segment);
+bool CAN_Transport_Next_Ack(CAN_Transport_T *transport, CAN_Transport_Ack_T *ack);
+bool CAN_Transport_Rx_Segment(CAN_Transport_T *transport, const CAN_Transport_Segment_T *segment);
+void CAN_Transport_Rx_Ack(
+    CAN_Transport_T *transport, const CAN_Transport_Ack_T *ack, uint32_t now_ms);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // CAN_TRANSPORT_H_
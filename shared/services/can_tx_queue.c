@@ -0,0 +1,112 @@
+#include "can_tx_queue.h"
+#include "can_messages.h"
+#include "qpc.h"
+#include "qsafe.h"
+#include <assert.h>
+#include <string.h>
+
+Q_DEFINE_THIS_MODULE("can_tx_queue.c")
+
+/**************************************************************************************************\
+* Private macros
+\**************************************************************************************************/
+
+// one pending bit per ID
+static_assert(CAN_MSG_ID_SPAN <= 32U, "CAN IDs no longer fit the pending mask");
+
+/**************************************************************************************************\
+* Private memory declarations
+\**************************************************************************************************/
+
+// One slot per registered ID, so a message that changes faster than the bus can take it only
+// ever has its latest value waiting, and the queue can never fill. Only Box_To_Box uses it.
+static CAN_Message_T s_slots[CAN_MSG_ID_SPAN];
+static uint32_t s_pending; // bit n set when s_slots[n] is waiting to be sent
+
+static CAN_Tx_Queue_Stats_T s_stats;
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+void CAN_Tx_Queue_Init(void)
+{
+    s_pending = 0U;
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Queue a frame for the bus, replacing the pending frame with the same ID if there is one
+ **************************************************************************************************/
+void CAN_Tx_Queue_Put(const CAN_Message_T *frame)
+{
+    Q_ASSERT(frame->id < CAN_MSG_ID_SPAN);
+
+    uint32_t bit = 1UL << frame->id;
+    if ((s_pending & bit) != 0U)
+    {
+        s_stats.replaced++;
+    }
+
+    s_slots[frame->id] = *frame;
+    s_pending |= bit;
+    s_stats.queued++;
+
+    uint32_t count = CAN_Tx_Queue_Count();
+    if (count > s_stats.high_water)
+    {
+        s_stats.high_water = count;
+    }
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Next frame to send, the pending one with the lowest ID as on the bus, NULL if none.
+ *          It stays queued until CAN_Tx_Queue_Pop(), call CAN_Tx_Queue_Deferred() instead if
+ *          the TX FIFO refused it.
+ **************************************************************************************************/
+const CAN_Message_T *CAN_Tx_Queue_Front(void)
+{
+    if (s_pending == 0U)
+    {
+        return NULL;
+    }
+
+    return &s_slots[__builtin_ctz(s_pending)];
+}
+
+void CAN_Tx_Queue_Pop(void)
+{
+    Q_ASSERT(s_pending != 0U);
+
+    s_pending &= s_pending - 1U; // clear the lowest set bit
+    s_stats.sent++;
+}
+
+void CAN_Tx_Queue_Deferred(void)
+{
+    s_stats.deferred++;
+}
+
+uint32_t CAN_Tx_Queue_Count(void)
+{
+    return (uint32_t) __builtin_popcount(s_pending);
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   True if a frame with this ID is waiting, a frame put now would replace it
+ **************************************************************************************************/
+bool CAN_Tx_Queue_Is_Pending(uint32_t id)
+{
+    return (id < CAN_MSG_ID_SPAN) && ((s_pending & (1UL << id)) != 0U);
+}
+
+void CAN_Tx_Queue_Get_Stats(CAN_Tx_Queue_Stats_T *stats)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    *stats = s_stats;
+    QF_CRIT_EXIT();
+}
@@ -0,0 +1,39 @@
+#ifndef CAN_TX_QUEUE_H_
+#define CAN_TX_QUEUE_H_
+
+#include "interfaces/can_interface.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************************************************\
+* Public type definitions
+\**************************************************************************************************/
+typedef struct
+{
+    uint32_t queued;     // frames put in the queue
+    uint32_t replaced;   // pending frames overwritten by a newer frame with the same ID
+    uint32_t sent;       // frames handed to the FDCAN TX FIFO
+    uint32_t deferred;   // writes refused because the TX FIFO was full, retried later
+    uint32_t high_water; // most frames ever pending at once
+} CAN_Tx_Queue_Stats_T;
+
+/**************************************************************************************************\
+* Public prototypes
+\**************************************************************************************************/
+void CAN_Tx_Queue_Init(void);
+void CAN_Tx_Queue_Put(const CAN_Message_T *frame);
+const CAN_Message_T *CAN_Tx_Queue_Front(void);
+void CAN_Tx_Queue_Pop(void);
+void CAN_Tx_Queue_Deferred(void);
+uint32_t CAN_Tx_Queue_Count(void);
+bool CAN_Tx_Queue_Is_Pending(uint32_t id);
+void CAN_Tx_Queue_Get_Stats(CAN_Tx_Queue_Stats_T *stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // CAN_TX_QUEUE_H_
@@ -0,0 +1,449 @@
+#include "cli_shared_commands.h"
+#include "ao_profile.h"
+#include "can_stats.h"
+#include "cpu_load.h"
+#include "event_watermarks.h"
+#include "histogram.h"
+#include <stdio.h>
+#include <string.h>
+
+/**************************************************************************************************\
+* Private macros
+\**************************************************************************************************/
+
+#define DIMENSION_OF(a)       ((sizeof(a)) / (sizeof(a[0])))
+#define CLI_PRINT_BUFFER_SIZE 128
+
+/**************************************************************************************************\
+* Private prototypes
+\**************************************************************************************************/
+
+static void on_cli_bench(EmbeddedCli *cli, char *args, void *context);
+static void on_cli_can_stats(EmbeddedCli *cli, char *args, void *context);
+static void on_cli_ao_profile(EmbeddedCli *cli, char *args, void *context);
+static void on_cli_cpu_load(EmbeddedCli *cli, char *args, void *context);
+static void on_cli_event_watermarks(EmbeddedCli *cli, char *args, void *context);
+static void print_bench_header(EmbeddedCli *cli, char *print_buffer, size_t size);
+static void print_bench(
+    EmbeddedCli *cli,
+    char *print_buffer,
+    size_t size,
+    const Kernel_Bench_T *kernels,
+    size_t count,
+    const char *prefix);
+static void print_histogram(
+    EmbeddedCli *cli,
+    char *print_buffer,
+    size_t size,
+    const char *name,
+    const char *unit,
+    const Histogram_T *histogram);
+
+/**************************************************************************************************\
+* Private memory declarations
+\**************************************************************************************************/
+
+// the filters on the motor, the gauge calibration lookups on the gauge
+static const Kernel_Bench_T *s_board_kernels;
+static size_t s_board_kernel_count;
+
+static const CliCommandBinding cli_cmd_list[] = {
+    (CliCommandBinding) {
+        "bench",
+        "Measure CPU cycles per call of the CRC, HDLC, nanopb and board specific kernels. Usage: "
+        "bench [name prefix]",
+        true,
+        NULL,
+        on_cli_bench,
+    },
+    (CliCommandBinding) {
+        "ao-profile",
+        "Print CPU cycles per run to completion of each AO and signal range. Usage: ao-profile "
+        "[reset]",
+        true,
+        NULL,
+        on_cli_ao_profile,
+    },
+    (CliCommandBinding) {
+        "cpu-load",
+        "Print the CPU load over the last 100 ms, 1 s and 10 s, and the peak. Usage: cpu-load "
+        "[reset]",
+        true,
+        NULL,
+        on_cli_cpu_load,
+    },
+    (CliCommandBinding) {
+        "event-watermarks",
+        "Print how close each event pool and AO queue came to running out, and each pool's "
+        "allocations per second and RAM",
+        false,
+        NULL,
+        on_cli_event_watermarks,
+    },
+    (CliCommandBinding) {
+        "can-stats",
+        "Print CAN frames, latency and age histograms per ID, and the FDCAN error counters",
+        false,
+        NULL,
+        on_cli_can_stats,
+    },
+};
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+/**
+ ***************************************************************************************************
+ * @brief   Add the commands both boards have to the CLI. The board's kernels are kept for bench,
+ *          and have to outlive the CLI.
+ **************************************************************************************************/
+void CLI_Shared_AddCommands(
+    EmbeddedCli *cli, const Kernel_Bench_T *board_kernels, size_t board_kernel_count)
+{
+    s_board_kernels      = board_kernels;
+    s_board_kernel_count = board_kernel_count;
+
+    for (unsigned i = 0; i < DIMENSION_OF(cli_cmd_list); i++)
+    {
+        embeddedCliAddBinding(cli, cli_cmd_list[i]);
+    }
+}
+
+/**************************************************************************************************\
+* Private functions
+\**************************************************************************************************/
+
+static void on_cli_bench(EmbeddedCli *cli, char *args, void *context)
+{
+    (void) context;
+
+    char print_buffer[CLI_PRINT_BUFFER_SIZE] = {0};
+
+    // only the kernels whose name starts with the argument, when there is one
+    const char *prefix = (embeddedCliGetTokenCount(args) > 0) ? embeddedCliGetToken(args, 1) : "";
+
+    print_bench_header(cli, print_buffer, sizeof(print_buffer));
+    print_bench(
+        cli,
+        print_buffer,
+        sizeof(print_buffer),
+        Kernel_Bench_Common,
+        Kernel_Bench_Common_Count,
+        prefix);
+    print_bench(
+        cli,
+        print_buffer,
+        sizeof(print_buffer),
+        s_board_kernels,
+        s_board_kernel_count,
+        prefix);
+}
+
+static void on_cli_can_stats(EmbeddedCli *cli, char *args, void *context)
+{
+    (void) args;
+    (void) context;
+
+    char print_buffer[CLI_PRINT_BUFFER_SIZE] = {0};
+    CAN_Error_Stats_T errors;
+    CAN_Id_Stats_T id_stats;
+
+    CAN_Stats_Get_Errors(&errors);
+
+    snprintf(
+        print_buffer,
+        sizeof(print_buffer),
+        "TEC %u, REC %u, %lu errors logged, %lu TX events unmatched",
+        (unsigned) errors.bus.tx_errors,
+        (unsigned) errors.bus.rx_errors,
+        (unsigned long) errors.errors_logged,
+        (unsigned long) errors.tx_events_unmatched);
+    embeddedCliPrint(cli, print_buffer);
+
+    for (uint32_t phase = 0U; phase < 2U; phase++)
+    {
+        const uint32_t *codes = (phase == 0U) ? errors.last_errors : errors.data_last_errors;
+        snprintf(
+            print_buffer,
+            sizeof(print_buffer),
+            "%s errors: stuff %lu, form %lu, ack %lu, bit1 %lu, bit0 %lu, crc %lu",
+            (phase == 0U) ? "arbitration" : "data",
+            (unsigned long) codes[CAN_ERROR_STUFF],
+            (unsigned long) codes[CAN_ERROR_FORM],
+            (unsigned long) codes[CAN_ERROR_ACK],
+            (unsigned long) codes[CAN_ERROR_BIT1],
+            (unsigned long) codes[CAN_ERROR_BIT0],
+            (unsigned long) codes[CAN_ERROR_CRC]);
+        embeddedCliPrint(cli, print_buffer);
+    }
+
+    for (uint32_t id = 0U; id < CAN_MSG_ID_SPAN; id++)
+    {
+        CAN_Stats_Get_Id(id, &id_stats);
+        if ((id_stats.tx_frames == 0U) && (id_stats.rx_frames == 0U))
+        {
+            continue;
+        }
+
+        snprintf(
+            print_buffer,
+            sizeof(print_buffer),
+            "id %lu: tx %lu (%lu sent), rx %lu",
+            (unsigned long) id,
+            (unsigned long) id_stats.tx_frames,
+            (unsigned long) id_stats.tx_events,
+            (unsigned long) id_stats.rx_frames);
+        embeddedCliPrint(cli, print_buffer);
+
+        print_histogram(
+            cli, print_buffer, sizeof(print_buffer), "tx latency", "us", &id_stats.tx_latency_us);
+        print_histogram(
+            cli, print_buffer, sizeof(print_buffer), "rx age", "us", &id_stats.rx_age_us);
+    }
+}
+
+// shares the caller's print buffer, the CLI runs on the one 1 kB stack
+static void print_bench_header(EmbeddedCli *cli, char *print_buffer, size_t size)
+{
+#ifdef __OPTIMIZE__
+    const char *build = "optimized";
+#else
+    const char *build = "unoptimized";
+#endif
+
+    snprintf(
+        print_buffer,
+        size,
+        "Fastest of %u runs of %u calls, %s build",
+        KERNEL_BENCH_RUNS,
+        KERNEL_BENCH_CALLS,
+        build);
+    embeddedCliPrint(cli, print_buffer);
+    embeddedCliPrint(cli, "kernel             cycles/call  bytes/call  cycles/byte");
+}
+
+static void print_bench(
+    EmbeddedCli *cli,
+    char *print_buffer,
+    size_t size,
+    const Kernel_Bench_T *kernels,
+    size_t count,
+    const char *prefix)
+{
+    for (size_t i = 0U; i < count; i++)
+    {
+        if (strncmp(kernels[i].name, prefix, strlen(prefix)) != 0)
+        {
+            continue;
+        }
+
+        Kernel_Bench_Result_T result = Kernel_Bench_Measure(&kernels[i]);
+
+        if (result.bytes_per_call > 0U)
+        {
+            snprintf(
+                print_buffer,
+                size,
+                "%-18s %11lu  %10lu  %11.2f",
+                kernels[i].name,
+                (unsigned long) result.cycles_per_call,
+                (unsigned long) result.bytes_per_call,
+                (double) result.cycles_per_call / (double) result.bytes_per_call);
+        }
+        else
+        {
+            snprintf(
+                print_buffer,
+                size,
+                "%-18s %11lu",
+                kernels[i].name,
+                (unsigned long) result.cycles_per_call);
+        }
+        embeddedCliPrint(cli, print_buffer);
+    }
+}
+
+// per AO, less the AOs that preempted it, then per signal range, the ones that ran since reset
+static void on_cli_ao_profile(EmbeddedCli *cli, char *args, void *context)
+{
+    (void) context;
+
+    char print_buffer[CLI_PRINT_BUFFER_SIZE] = {0};
+    AO_Profile_Stats_T stats;
+
+    if ((embeddedCliGetTokenCount(args) > 0) &&
+        (strcmp(embeddedCliGetToken(args, 1), "reset") == 0))
+    {
+        AO_Profile_Reset();
+        embeddedCliPrint(cli, "AO profile reset");
+        return;
+    }
+
+    for (size_t i = 0U; AO_Profile_Get_AO(i, &stats); i++)
+    {
+        if (stats.rtc_cycles.count == 0U)
+        {
+            continue;
+        }
+
+        snprintf(
+            print_buffer,
+            sizeof(print_buffer),
+            "AO %s (prio %lu):",
+            stats.name,
+            (unsigned long) stats.id);
+        embeddedCliPrint(cli, print_buffer);
+        print_histogram(
+            cli, print_buffer, sizeof(print_buffer), "rtc", "cycles", &stats.rtc_cycles);
+    }
+
+    for (size_t i = 0U; AO_Profile_Get_Signal_Range(i, &stats); i++)
+    {
+        if (stats.rtc_cycles.count == 0U)
+        {
+            continue;
+        }
+
+        snprintf(
+            print_buffer,
+            sizeof(print_buffer),
+            "signals %s (from %lu):",
+            stats.name,
+            (unsigned long) stats.id);
+        embeddedCliPrint(cli, print_buffer);
+        print_histogram(
+            cli, print_buffer, sizeof(print_buffer), "rtc", "cycles", &stats.rtc_cycles);
+    }
+}
+
+// in percent with one decimal, each load is in tenths of a percent
+static void on_cli_cpu_load(EmbeddedCli *cli, char *args, void *context)
+{
+    (void) context;
+
+    char print_buffer[CLI_PRINT_BUFFER_SIZE] = {0};
+    CPU_Load_T load;
+
+    if ((embeddedCliGetTokenCount(args) > 0) &&
+        (strcmp(embeddedCliGetToken(args, 1), "reset") == 0))
+    {
+        CPU_Load_Reset_Peak();
+        embeddedCliPrint(cli, "CPU load peak reset");
+        return;
+    }
+
+    CPU_Load_Get(&load);
+    snprintf(
+        print_buffer,
+        sizeof(print_buffer),
+        "CPU load: 100 ms %u.%u%%, 1 s %u.%u%%, 10 s %u.%u%%, peak %u.%u%% (%lu windows)",
+        load.load_100ms / 10U,
+        load.load_100ms % 10U,
+        load.load_1s / 10U,
+        load.load_1s % 10U,
+        load.load_10s / 10U,
+        load.load_10s % 10U,
+        load.peak_100ms / 10U,
+        load.peak_100ms % 10U,
+        (unsigned long) load.windows);
+    embeddedCliPrint(cli, print_buffer);
+}
+
+// the low-water marks since start up, "low" under EVENT_WATERMARKS_WARN_PERCENT free, and the
+// RAM each pool takes
+static void on_cli_event_watermarks(EmbeddedCli *cli, char *args, void *context)
+{
+    (void) args;
+    (void) context;
+
+    char print_buffer[CLI_PRINT_BUFFER_SIZE] = {0};
+    Event_Pool_Stats_T pool;
+    Event_Queue_Stats_T queue;
+    uint32_t pool_ram = 0U;
+
+    for (size_t i = 0U; Event_Watermarks_Get_Pool(i, &pool); i++)
+    {
+        snprintf(
+            print_buffer,
+            sizeof(print_buffer),
+            "pool %u: %lu x %lu B = %lu B, %lu free, min %lu, %lu allocs, %lu/s (peak %lu/s)%s",
+            (unsigned) (i + 1U),
+            (unsigned long) pool.blocks,
+            (unsigned long) pool.block_size,
+            (unsigned long) (pool.blocks * pool.block_size),
+            (unsigned long) pool.free,
+            (unsigned long) pool.min_free,
+            (unsigned long) pool.allocs,
+            (unsigned long) pool.allocs_per_s,
+            (unsigned long) pool.peak_allocs_per_s,
+            pool.low ? " LOW" : "");
+        embeddedCliPrint(cli, print_buffer);
+        pool_ram += pool.blocks * pool.block_size;
+    }
+    snprintf(print_buffer, sizeof(print_buffer), "event pools: %lu B", (unsigned long) pool_ram);
+    embeddedCliPrint(cli, print_buffer);
+
+    for (size_t i = 0U; Event_Watermarks_Get_Queue(i, &queue); i++)
+    {
+        snprintf(
+            print_buffer,
+            sizeof(print_buffer),
+            "queue %s (prio %lu): %lu events, %lu free, min %lu%s",
+            queue.name,
+            (unsigned long) queue.prio,
+            (unsigned long) queue.length,
+            (unsigned long) queue.free,
+            (unsigned long) queue.min_free,
+            queue.low ? " LOW" : "");
+        embeddedCliPrint(cli, print_buffer);
+    }
+}
+
+static void print_histogram(
+    EmbeddedCli *cli,
+    char *print_buffer,
+    size_t size,
+    const char *name,
+    const char *unit,
+    const Histogram_T *histogram)
+{
+    if (histogram->count == 0U)
+    {
+        return;
+    }
+
+    snprintf(
+        print_buffer,
+        size,
+        "  %s %s: n %lu, min %lu, mean %lu, p50 <= %lu, p99 <= %lu, max %lu",
+        name,
+        unit,
+        (unsigned long) histogram->count,
+        (unsigned long) histogram->min,
+        (unsigned long) Histogram_Mean(histogram),
+        (unsigned long) Histogram_Percentile(histogram, 50U),
+        (unsigned long) Histogram_Percentile(histogram, 99U),
+        (unsigned long) histogram->max);
+    embeddedCliPrint(cli, print_buffer);
+
+    // bucket counts, the first ending at 2^shift units and each one twice as wide as the last
+    int len = snprintf(
+        print_buffer,
+        size,
+        "  buckets from <%lu:",
+        (unsigned long) Histogram_Bucket_Limit(histogram, 0U));
+    for (uint32_t bucket = 0U; bucket < HISTOGRAM_BUCKETS; bucket++)
+    {
+        if ((len < 0) || ((size_t) len >= size))
+        {
+            break;
+        }
+        len += snprintf(
+            &print_buffer[len],
+            size - (size_t) len,
+            " %lu",
+            (unsigned long) histogram->buckets[bucket]);
+    }
+    embeddedCliPrint(cli, print_buffer);
+}
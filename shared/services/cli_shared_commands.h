@@ -0,0 +1,24 @@
+#ifndef CLI_SHARED_COMMANDS_H_
+#define CLI_SHARED_COMMANDS_H_
+
+#include "embedded_cli.h"
+#include "kernel_bench.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************************************************\
+* Public prototypes
+\**************************************************************************************************/
+
+// bench, can-stats, ao-profile, cpu-load and event-watermarks, the same on both boards; bench
+// times the board's own kernels after the common ones
+void CLI_Shared_AddCommands(
+    EmbeddedCli *cli, const Kernel_Bench_T *board_kernels, size_t board_kernel_count);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // CLI_SHARED_COMMANDS_H_
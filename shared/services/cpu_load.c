@@ -0,0 +1,138 @@
+#include "cpu_load.h"
+#include "bsp.h"
+#include "qpc.h"
+
+/**************************************************************************************************\
+* Private memory declarations
+\**************************************************************************************************/
+
+// written by the idle loop with interrupts disabled, and by the SysTick interrupt
+static uint32_t s_idle_cycles; // in the window so far
+static uint32_t s_last_idle_end;
+
+// written by the SysTick interrupt only
+static uint32_t s_window_start;
+static uint32_t s_window_ticks;
+static uint32_t s_windows;
+static uint16_t s_history[CPU_LOAD_10S_WINDOWS]; // per window, s_windows % N is the next
+static uint32_t s_sum_1s;                        // of the newest CPU_LOAD_1S_WINDOWS
+static uint32_t s_sum_10s;                       // of all of them
+static uint16_t s_peak;
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+/**
+ ***************************************************************************************************
+ * @brief   Start the first window now, with nothing measured. Call once the cycle counter runs.
+ **************************************************************************************************/
+void CPU_Load_Start(void)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    s_window_start  = BSP_Get_Cycle_Count();
+    s_last_idle_end = s_window_start;
+    s_idle_cycles   = 0U;
+    s_window_ticks  = 0U;
+    s_windows       = 0U;
+    s_sum_1s        = 0U;
+    s_sum_10s       = 0U;
+    s_peak          = 0U;
+    for (uint32_t i = 0U; i < CPU_LOAD_10S_WINDOWS; i++)
+    {
+        s_history[i] = 0U;
+    }
+    QF_CRIT_EXIT();
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Count one pass of the idle loop as idle time: what it slept from start to end, if it
+ *          sleeps, and the gap since the last pass when nothing ran in between. Call with
+ *          interrupts disabled, before the interrupt that ended a sleep is taken.
+ **************************************************************************************************/
+void CPU_Load_Idle(uint32_t start_cycles, uint32_t end_cycles)
+{
+    uint32_t gap = start_cycles - s_last_idle_end;
+
+    if (gap <= CPU_LOAD_IDLE_GAP_MAX_CYCLES)
+    {
+        s_idle_cycles += gap;
+    }
+    s_idle_cycles += end_cycles - start_cycles;
+    s_last_idle_end = end_cycles;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Close a window every CPU_LOAD_WINDOW_TICKS calls. Call from the SysTick interrupt.
+ **************************************************************************************************/
+void CPU_Load_Tick(void)
+{
+    if (++s_window_ticks < CPU_LOAD_WINDOW_TICKS)
+    {
+        return;
+    }
+
+    // per mille, without a 64-bit division in the interrupt
+    uint32_t now       = BSP_Get_Cycle_Count();
+    uint32_t per_mille = (now - s_window_start) / 1000U;
+    uint32_t idle      = (per_mille > 0U) ? (s_idle_cycles / per_mille) : 1000U;
+    uint16_t load      = (idle < 1000U) ? (uint16_t) (1000U - idle) : 0U;
+
+    s_window_ticks = 0U;
+    s_window_start = now;
+    s_idle_cycles  = 0U;
+
+    // the oldest window drops out of each sum once it is full, zeros until then
+    uint32_t next = s_windows % CPU_LOAD_10S_WINDOWS;
+    uint32_t old  = (s_windows + CPU_LOAD_10S_WINDOWS - CPU_LOAD_1S_WINDOWS) % CPU_LOAD_10S_WINDOWS;
+    s_sum_1s += load - s_history[old];
+    s_sum_10s += load - s_history[next];
+    s_history[next] = load;
+    s_windows++;
+    if (load > s_peak)
+    {
+        s_peak = load;
+    }
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   The load of the last window, averaged over the last 1 s and 10 s, and the peak
+ **************************************************************************************************/
+void CPU_Load_Get(CPU_Load_T *load)
+{
+    uint32_t sum_1s;
+    uint32_t sum_10s;
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    load->windows    = s_windows;
+    load->peak_100ms = s_peak;
+    load->load_100ms = (s_windows > 0U) ? s_history[(s_windows - 1U) % CPU_LOAD_10S_WINDOWS] : 0U;
+    sum_1s           = s_sum_1s;
+    sum_10s          = s_sum_10s;
+    QF_CRIT_EXIT();
+
+    // fewer windows than that since start up
+    uint32_t windows   = load->windows;
+    uint32_t count_1s  = (windows < CPU_LOAD_1S_WINDOWS) ? windows : CPU_LOAD_1S_WINDOWS;
+    uint32_t count_10s = (windows < CPU_LOAD_10S_WINDOWS) ? windows : CPU_LOAD_10S_WINDOWS;
+
+    load->load_1s  = (count_1s > 0U) ? (uint16_t) (sum_1s / count_1s) : 0U;
+    load->load_10s = (count_10s > 0U) ? (uint16_t) (sum_10s / count_10s) : 0U;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Start looking for the busiest window again
+ **************************************************************************************************/
+void CPU_Load_Reset_Peak(void)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    s_peak = 0U;
+    QF_CRIT_EXIT();
+}
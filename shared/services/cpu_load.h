@@ -0,0 +1,59 @@
+#ifndef CPU_LOAD_H_
+#define CPU_LOAD_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************************************************\
+* Public macros
+\**************************************************************************************************/
+
+// Sleep with WFI in the idle loop rather than spin. Off by default, see QK_onIdle() in bsp.c
+#ifndef CPU_LOAD_WFI
+#define CPU_LOAD_WFI 0
+#endif
+
+// A gap between two idle loop passes longer than this was an interrupt or an AO running, shorter
+// is the idle loop itself; about 2 us at 144 MHz. A pass that sleeps is only left for the interrupt
+// that woke it, so none of the gap after a sleep is idle.
+#if CPU_LOAD_WFI
+#define CPU_LOAD_IDLE_GAP_MAX_CYCLES 0U
+#else
+#define CPU_LOAD_IDLE_GAP_MAX_CYCLES 256U
+#endif
+
+// CPU_Load_Tick() calls per window, and the windows averaged for the 1 s and 10 s loads
+#define CPU_LOAD_WINDOW_TICKS 100U
+#define CPU_LOAD_1S_WINDOWS   10U
+#define CPU_LOAD_10S_WINDOWS  100U
+
+/**************************************************************************************************\
+* Public type definitions
+\**************************************************************************************************/
+
+// in tenths of a percent, the time not spent in the idle loop
+typedef struct
+{
+    uint16_t load_100ms; // the last 100 ms window
+    uint16_t load_1s;    // the last 10 windows, or as many as there have been
+    uint16_t load_10s;   // the last 100 windows, or as many as there have been
+    uint16_t peak_100ms; // the busiest window since start up or CPU_Load_Reset_Peak()
+    uint32_t windows;    // windows closed since start up
+} CPU_Load_T;
+
+/**************************************************************************************************\
+* Public prototypes
+\**************************************************************************************************/
+void CPU_Load_Start(void);
+void CPU_Load_Idle(uint32_t start_cycles, uint32_t end_cycles);
+void CPU_Load_Tick(void);
+void CPU_Load_Get(CPU_Load_T *load);
+void CPU_Load_Reset_Peak(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // CPU_LOAD_H_
@@ -0,0 +1,63 @@
+#ifndef EVENT_CATALOGUE_H_
+#define EVENT_CATALOGUE_H_
+
+#include <stdint.h>
+
+/**************************************************************************************************\
+* Public macros
+\**************************************************************************************************/
+
+// Every event allocated from QF's pools is listed next to its typedef, with the most of it that
+// can be allocated at once:
+//
+//     #define FRAM_POOL_EVENTS(X) X(FramReadReqEvent_T, 2U) X(FramReadRespEvent_T, 2U) ...
+//
+// Each board joins the lists of the headers it builds with into one catalogue, and sizes its
+// three event pools from it. An event of up to EVENT_CATALOGUE_SMALL_MAX_SIZE bytes goes to the
+// small pool, up to EVENT_CATALOGUE_MEDIUM_MAX_SIZE to the medium one and anything larger to the
+// large one, the same pool QF takes it from. A pool's blocks are as big as its largest event, and
+// as many as the counts of its events add up to. An event listed twice does not compile.
+#define EVENT_CATALOGUE_SMALL_MAX_SIZE  16U
+#define EVENT_CATALOGUE_MEDIUM_MAX_SIZE 96U
+
+// EVENT_CATALOGUE_TIER(CATALOGUE, SMALL) is a type as big as the largest event of the small pool,
+// for QF_MPOOL_EL(), and EVENT_CATALOGUE_TIER_COUNT(CATALOGUE, SMALL) the blocks it needs.
+// Likewise MEDIUM and LARGE.
+#define EVENT_CATALOGUE_TIER(CATALOGUE, TIER)     \
+    union                                         \
+    {                                             \
+        CATALOGUE(EVENT_CATALOGUE_##TIER##_SIZE_) \
+    }
+#define EVENT_CATALOGUE_TIER_COUNT(CATALOGUE, TIER) (0U CATALOGUE(EVENT_CATALOGUE_##TIER##_COUNT_))
+
+// Q_NEW() for the pools, which only compiles when T is listed in CATALOGUE, the list of the header
+// that declares T. Every pool allocation goes through it, so no event is left out of the pools'
+// sizes; one that isn't listed fails with "no member named 'T_is_catalogued'".
+#define EVENT_CATALOGUE_NEW(CATALOGUE, T, SIG)                                                \
+    ((void) sizeof(((struct { CATALOGUE(EVENT_CATALOGUE_LISTED_) } *) 0)->T##_is_catalogued), \
+     Q_NEW(T, SIG))
+
+// per tier, a union member as big as the event when it is in the tier, else a byte, and the
+// event's count when it is in the tier, else nothing. And a member named after each event, for
+// EVENT_CATALOGUE_NEW().
+#define EVENT_CATALOGUE_IN_(T, MIN, MAX) ((sizeof(T) > (MIN)) && (sizeof(T) <= (MAX)))
+#define EVENT_CATALOGUE_SIZE_(T, MIN, MAX) \
+    uint8_t T##_size[EVENT_CATALOGUE_IN_(T, MIN, MAX) ? sizeof(T) : 1U];
+#define EVENT_CATALOGUE_COUNT_(T, N, MIN, MAX) +(EVENT_CATALOGUE_IN_(T, MIN, MAX) ? (N) : 0U)
+#define EVENT_CATALOGUE_LISTED_(T, N)          uint8_t T##_is_catalogued;
+
+#define EVENT_CATALOGUE_SMALL_SIZE_(T, N) \
+    EVENT_CATALOGUE_SIZE_(T, 0U, EVENT_CATALOGUE_SMALL_MAX_SIZE)
+#define EVENT_CATALOGUE_MEDIUM_SIZE_(T, N) \
+    EVENT_CATALOGUE_SIZE_(T, EVENT_CATALOGUE_SMALL_MAX_SIZE, EVENT_CATALOGUE_MEDIUM_MAX_SIZE)
+#define EVENT_CATALOGUE_LARGE_SIZE_(T, N) \
+    EVENT_CATALOGUE_SIZE_(T, EVENT_CATALOGUE_MEDIUM_MAX_SIZE, SIZE_MAX)
+
+#define EVENT_CATALOGUE_SMALL_COUNT_(T, N) \
+    EVENT_CATALOGUE_COUNT_(T, N, 0U, EVENT_CATALOGUE_SMALL_MAX_SIZE)
+#define EVENT_CATALOGUE_MEDIUM_COUNT_(T, N) \
+    EVENT_CATALOGUE_COUNT_(T, N, EVENT_CATALOGUE_SMALL_MAX_SIZE, EVENT_CATALOGUE_MEDIUM_MAX_SIZE)
+#define EVENT_CATALOGUE_LARGE_COUNT_(T, N) \
+    EVENT_CATALOGUE_COUNT_(T, N, EVENT_CATALOGUE_MEDIUM_MAX_SIZE, SIZE_MAX)
+
+#endif // EVENT_CATALOGUE_H_
@@ -0,0 +1,332 @@
+#include "event_watermarks.h"
+#include "qpc.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/**************************************************************************************************\
+* Private macros
+\**************************************************************************************************/
+
+#define WARNING_MAX_LENGTH 80U
+
+/**************************************************************************************************\
+* Private type definitions
+\**************************************************************************************************/
+// an event pool as the board gave it to QF_poolInit()
+typedef struct
+{
+    uintptr_t start; // of its storage
+    uintptr_t end;
+    uint32_t block_size;
+    uint32_t blocks;
+} Pool_Slot_T;
+
+typedef struct
+{
+    const char *name;
+    QActive const *ao;
+    uint32_t warned_min_free; // the low-water mark last warned about
+} Queue_Slot_T;
+
+/**************************************************************************************************\
+* Private prototypes
+\**************************************************************************************************/
+
+// QP's own, around which whatever links this file wraps them with -Wl,--wrap=QF_poolInit,
+// --wrap=QF_newX_ and --wrap=QMPool_put
+void __real_QF_poolInit(
+    void *const poolSto, uint_fast32_t const poolSize, uint_fast16_t const evtSize);
+QEvt *__real_QF_newX_(uint_fast16_t const evtSize, uint_fast16_t const margin, enum_t const sig);
+void __real_QMPool_put(QMPool *const me, void *const block, uint_fast8_t const qsId);
+
+void __wrap_QF_poolInit(
+    void *const poolSto, uint_fast32_t const poolSize, uint_fast16_t const evtSize);
+QEvt *__wrap_QF_newX_(uint_fast16_t const evtSize, uint_fast16_t const margin, enum_t const sig);
+void __wrap_QMPool_put(QMPool *const me, void *const block, uint_fast8_t const qsId);
+
+static size_t pool_of_size(uint_fast16_t evt_size);
+static size_t pool_of_block(const void *block);
+static bool is_low(uint32_t min_free, uint32_t size);
+
+/**************************************************************************************************\
+* Private memory declarations
+\**************************************************************************************************/
+
+// written by __wrap_QF_poolInit() before QF runs
+static Pool_Slot_T s_pools[QF_MAX_EPOOL];
+static size_t s_pool_count;
+
+// counted by whoever allocates or recycles an event, an AO or an interrupt, under a critical
+// section
+static uint32_t s_allocs[QF_MAX_EPOOL];
+static uint32_t s_in_use[QF_MAX_EPOOL];
+
+// written by Event_Watermarks_Update() under a critical section
+static uint32_t s_allocs_per_s[QF_MAX_EPOOL];
+static uint32_t s_peak_allocs_per_s[QF_MAX_EPOOL];
+
+// Event_Watermarks_Update() only
+static uint32_t s_last_allocs[QF_MAX_EPOOL];
+static uint32_t s_pool_warned_min_free[QF_MAX_EPOOL]; // the low-water mark last warned about
+static uint32_t s_last_update_ms;
+static bool s_updated;
+
+static Queue_Slot_T s_queues[EVENT_WATERMARKS_MAX_QUEUES];
+static size_t s_queue_count;
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+/**
+ ***************************************************************************************************
+ * @brief   Watch the event pools given to QF so far and the queues of the AOs started so far.
+ *          names[prio] names the AO of that priority. Call once, after the AOs are started and
+ *          before QF_run().
+ **************************************************************************************************/
+void Event_Watermarks_Start(const char *const *names, size_t names_count)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    memset(s_allocs, 0, sizeof(s_allocs));
+    memset(s_allocs_per_s, 0, sizeof(s_allocs_per_s));
+    memset(s_peak_allocs_per_s, 0, sizeof(s_peak_allocs_per_s));
+    QF_CRIT_EXIT();
+
+    memset(s_last_allocs, 0, sizeof(s_last_allocs));
+    memset(s_pool_warned_min_free, 0xFF, sizeof(s_pool_warned_min_free));
+    s_updated     = false;
+    s_queue_count = 0U;
+
+    for (uint_fast8_t prio = 1U; prio <= QF_MAX_ACTIVE; prio++)
+    {
+        QActive const *ao = QActive_registry_[prio];
+        if ((ao == NULL) || (s_queue_count >= EVENT_WATERMARKS_MAX_QUEUES))
+        {
+            continue;
+        }
+
+        const char *name = (prio < names_count) ? names[prio] : NULL;
+
+        Queue_Slot_T *slot    = &s_queues[s_queue_count++];
+        slot->name            = (name != NULL) ? name : "?";
+        slot->ao              = ao;
+        slot->warned_min_free = UINT32_MAX;
+    }
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Work out each pool's allocations per second since the last call, and warn once about
+ *          each new low-water mark of a pool or queue that leaves it under
+ *          EVENT_WATERMARKS_WARN_PERCENT free. Call about once a second from one AO.
+ **************************************************************************************************/
+void Event_Watermarks_Update(uint32_t now_ms, Event_Watermarks_Warn_T warn, void *context)
+{
+    char warning[WARNING_MAX_LENGTH];
+    uint32_t elapsed_ms = now_ms - s_last_update_ms;
+    Event_Pool_Stats_T pool;
+    Event_Queue_Stats_T queue;
+
+    for (size_t i = 0U; Event_Watermarks_Get_Pool(i, &pool); i++)
+    {
+        if (s_updated && (elapsed_ms > 0U))
+        {
+            uint32_t rate = (uint32_t) (((uint64_t) (pool.allocs - s_last_allocs[i]) * 1000U) /
+                                        elapsed_ms);
+
+            QF_CRIT_STAT
+            QF_CRIT_ENTRY();
+            s_allocs_per_s[i] = rate;
+            if (rate > s_peak_allocs_per_s[i])
+            {
+                s_peak_allocs_per_s[i] = rate;
+            }
+            QF_CRIT_EXIT();
+        }
+        s_last_allocs[i] = pool.allocs;
+
+        if (pool.low && (pool.min_free < s_pool_warned_min_free[i]))
+        {
+            s_pool_warned_min_free[i] = pool.min_free;
+            snprintf(
+                warning,
+                sizeof(warning),
+                "warning: event pool %u (%lu x %lu B) down to %lu free",
+                (unsigned) (i + 1U),
+                (unsigned long) pool.blocks,
+                (unsigned long) pool.block_size,
+                (unsigned long) pool.min_free);
+            warn(context, warning);
+        }
+    }
+
+    for (size_t i = 0U; Event_Watermarks_Get_Queue(i, &queue); i++)
+    {
+        if (queue.low && (queue.min_free < s_queues[i].warned_min_free))
+        {
+            s_queues[i].warned_min_free = queue.min_free;
+            snprintf(
+                warning,
+                sizeof(warning),
+                "warning: %s queue (prio %lu, %lu events) down to %lu free",
+                queue.name,
+                (unsigned long) queue.prio,
+                (unsigned long) queue.length,
+                (unsigned long) queue.min_free);
+            warn(context, warning);
+        }
+    }
+
+    s_last_update_ms = now_ms;
+    s_updated        = true;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   The index'th event pool, smallest events first, false past the last one
+ **************************************************************************************************/
+bool Event_Watermarks_Get_Pool(size_t index, Event_Pool_Stats_T *stats)
+{
+    if (index >= s_pool_count)
+    {
+        return false;
+    }
+
+    stats->block_size = s_pools[index].block_size;
+    stats->blocks     = s_pools[index].blocks;
+    stats->min_free   = QF_getPoolMin((uint_fast8_t) (index + 1U));
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    stats->free              = stats->blocks - s_in_use[index];
+    stats->allocs            = s_allocs[index];
+    stats->allocs_per_s      = s_allocs_per_s[index];
+    stats->peak_allocs_per_s = s_peak_allocs_per_s[index];
+    QF_CRIT_EXIT();
+
+    stats->low = is_low(stats->min_free, stats->blocks);
+    return true;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   The queue of the index'th AO by priority, false past the last one
+ **************************************************************************************************/
+bool Event_Watermarks_Get_Queue(size_t index, Event_Queue_Stats_T *stats)
+{
+    if (index >= s_queue_count)
+    {
+        return false;
+    }
+
+    QActive const *ao = s_queues[index].ao;
+    stats->name       = s_queues[index].name;
+    stats->prio       = ao->prio;
+    stats->length     = (uint32_t) ao->eQueue.end + 1U; // the ring and the front event
+    stats->free       = QEQueue_getNFree(&ao->eQueue);
+    stats->min_free   = QF_getQueueMin(ao->prio);
+
+    stats->low = is_low(stats->min_free, stats->length);
+    return true;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Each event pool on its way into QF, whose size QF keeps to itself
+ **************************************************************************************************/
+void __wrap_QF_poolInit(
+    void *const poolSto, uint_fast32_t const poolSize, uint_fast16_t const evtSize)
+{
+    // QF takes the pools smallest first, one no bigger than the last can only follow a new
+    // QF_init(), as the host tests do before each test
+    if ((s_pool_count > 0U) && (evtSize <= s_pools[s_pool_count - 1U].block_size))
+    {
+        s_pool_count = 0U;
+    }
+
+    if (s_pool_count < QF_MAX_EPOOL)
+    {
+        Pool_Slot_T *slot = &s_pools[s_pool_count];
+        slot->start       = (uintptr_t) poolSto;
+        slot->end         = (uintptr_t) poolSto + poolSize;
+        slot->block_size  = evtSize;
+        slot->blocks      = poolSize / evtSize;
+
+        s_in_use[s_pool_count] = 0U;
+        s_pool_count++;
+    }
+    __real_QF_poolInit(poolSto, poolSize, evtSize);
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Every event allocated, counted against the pool QF takes it from: the first one whose
+ *          blocks it fits in
+ **************************************************************************************************/
+QEvt *__wrap_QF_newX_(uint_fast16_t const evtSize, uint_fast16_t const margin, enum_t const sig)
+{
+    QEvt *e = __real_QF_newX_(evtSize, margin, sig);
+
+    size_t pool = pool_of_size(evtSize);
+    if ((e != NULL) && (pool < s_pool_count))
+    {
+        QF_CRIT_STAT
+        QF_CRIT_ENTRY();
+        s_allocs[pool]++;
+        s_in_use[pool]++;
+        QF_CRIT_EXIT();
+    }
+    return e;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Every event recycled, given back to the pool whose storage it lies in. QF_gc() calls
+ *          this outside of its critical section.
+ **************************************************************************************************/
+void __wrap_QMPool_put(QMPool *const me, void *const block, uint_fast8_t const qsId)
+{
+    size_t pool = pool_of_block(block);
+    if (pool < s_pool_count)
+    {
+        QF_CRIT_STAT
+        QF_CRIT_ENTRY();
+        s_in_use[pool]--;
+        QF_CRIT_EXIT();
+    }
+    __real_QMPool_put(me, block, qsId);
+}
+
+/**************************************************************************************************\
+* Private functions
+\**************************************************************************************************/
+
+// The boards size their pools' blocks with QF_MPOOL_EL(), so these are the sizes QF compares
+// evtSize against, and both lookups find the same pool for an event
+static size_t pool_of_size(uint_fast16_t evt_size)
+{
+    size_t pool = 0U;
+    while ((pool < s_pool_count) && (evt_size > s_pools[pool].block_size))
+    {
+        pool++;
+    }
+    return pool;
+}
+
+static size_t pool_of_block(const void *block)
+{
+    size_t pool = 0U;
+    while ((pool < s_pool_count) &&
+           (((uintptr_t) block < s_pools[pool].start) || ((uintptr_t) block >= s_pools[pool].end)))
+    {
+        pool++;
+    }
+    return pool;
+}
+
+static bool is_low(uint32_t min_free, uint32_t size)
+{
+    return (min_free * 100U) < (size * EVENT_WATERMARKS_WARN_PERCENT);
+}
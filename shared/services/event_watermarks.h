@@ -0,0 +1,62 @@
+#ifndef EVENT_WATERMARKS_H_
+#define EVENT_WATERMARKS_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************************************************\
+* Public macros
+\**************************************************************************************************/
+
+// a pool or queue whose low-water mark leaves less than this share of it free is warned about
+#define EVENT_WATERMARKS_WARN_PERCENT 25U
+
+// AO queues watched, the rest run as before
+#define EVENT_WATERMARKS_MAX_QUEUES 12U
+
+/**************************************************************************************************\
+* Public type definitions
+\**************************************************************************************************/
+typedef struct
+{
+    uint32_t block_size;        // bytes, the largest event the pool holds
+    uint32_t blocks;            // in the pool
+    uint32_t free;              // now
+    uint32_t min_free;          // the low-water mark since start up
+    uint32_t allocs;            // since start up
+    uint32_t allocs_per_s;      // between the last two Event_Watermarks_Update() calls
+    uint32_t peak_allocs_per_s; // the most since start up
+    bool low;                   // min_free is under EVENT_WATERMARKS_WARN_PERCENT of blocks
+} Event_Pool_Stats_T;
+
+typedef struct
+{
+    const char *name;
+    uint32_t prio;
+    uint32_t length;   // events the queue holds
+    uint32_t free;     // now
+    uint32_t min_free; // the low-water mark since start up
+    bool low;          // min_free is under EVENT_WATERMARKS_WARN_PERCENT of length
+} Event_Queue_Stats_T;
+
+// prints one warning line, without a line ending
+typedef void (*Event_Watermarks_Warn_T)(void *context, const char *warning);
+
+/**************************************************************************************************\
+* Public prototypes
+\**************************************************************************************************/
+void Event_Watermarks_Start(const char *const *names, size_t names_count);
+void Event_Watermarks_Update(uint32_t now_ms, Event_Watermarks_Warn_T warn, void *context);
+
+bool Event_Watermarks_Get_Pool(size_t index, Event_Pool_Stats_T *stats);
+bool Event_Watermarks_Get_Queue(size_t index, Event_Queue_Stats_T *stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EVENT_WATERMARKS_H_
@@ -48,7 +48,8 @@ void Fault_Manager_Generate_Fault(QActive *sender, Fault_ID_T fault_id, const ch
         num_active_faults++;
     }
 
-    FaultGeneratedEvent_T *event = Q_NEW(FaultGeneratedEvent_T, PUBSUB_FAULT_GENERATED_SIG);
+    FaultGeneratedEvent_T *event = EVENT_CATALOGUE_NEW(
+        PUBSUB_POOL_EVENTS, FaultGeneratedEvent_T, PUBSUB_FAULT_GENERATED_SIG);
     event->id                    = fault_id;
     event->type                  = s_fault_info_list[fault_id].fault_type;
     event->code                  = s_fault_info_list[fault_id].code;
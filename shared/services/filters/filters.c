@@ -0,0 +1,292 @@
+#include "filters.h"
+#include "qpc.h"
+#include "qsafe.h"
+#include <math.h>
+#include <string.h>
+
+Q_DEFINE_THIS_MODULE("filters.c")
+
+/**************************************************************************************************\
+* Private macros
+\**************************************************************************************************/
+
+#define FILTER_PI 3.14159265f
+
+/**************************************************************************************************\
+* Private prototypes
+\**************************************************************************************************/
+
+static float median_of_window(const Filter_Median_F32_T *filter);
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+/**
+ ***************************************************************************************************
+ *
+ * @brief   Exponential moving average (float)
+ *
+ * @param  alpha          Weight of the new sample, 0 < alpha <= 1. Equivalent to (1 - lambda)
+ *                        of the "lambda * y + (1 - lambda) * x" form.
+ * @param  seed_on_first  Start from the first sample instead of ramping up from 0.
+ *
+ **************************************************************************************************/
+void Filter_EMA_F32_Init(Filter_EMA_F32_T *filter, float alpha, bool seed_on_first)
+{
+    filter->alpha         = alpha;
+    filter->seed_on_first = seed_on_first;
+    Filter_EMA_F32_Reset(filter);
+}
+
+void Filter_EMA_F32_Reset(Filter_EMA_F32_T *filter)
+{
+    filter->state  = 0.0f;
+    filter->seeded = false;
+}
+
+// Change the smoothing factor (e.g. after a sample rate change) without disturbing the output
+void Filter_EMA_F32_Set_Alpha(Filter_EMA_F32_T *filter, float alpha)
+{
+    filter->alpha = alpha;
+}
+
+float Filter_EMA_F32_Update(Filter_EMA_F32_T *filter, float sample)
+{
+    if (filter->seed_on_first && !filter->seeded)
+    {
+        filter->state = sample;
+    }
+    else
+    {
+        filter->state += filter->alpha * (sample - filter->state);
+    }
+    filter->seeded = true;
+
+    return filter->state;
+}
+
+float Filter_EMA_F32_Get(const Filter_EMA_F32_T *filter)
+{
+    return filter->state;
+}
+
+/**
+ ***************************************************************************************************
+ *
+ * @brief   Exponential moving average (Q15), for raw integer samples without touching the FPU
+ *
+ **************************************************************************************************/
+void Filter_EMA_Q15_Init(Filter_EMA_Q15_T *filter, int16_t alpha_q15, bool seed_on_first)
+{
+    filter->alpha_q15     = alpha_q15;
+    filter->seed_on_first = seed_on_first;
+    Filter_EMA_Q15_Reset(filter);
+}
+
+void Filter_EMA_Q15_Reset(Filter_EMA_Q15_T *filter)
+{
+    filter->state_q31 = 0;
+    filter->seeded    = false;
+}
+
+int16_t Filter_EMA_Q15_Update(Filter_EMA_Q15_T *filter, int16_t sample)
+{
+    int32_t sample_q31 = (int32_t) ((uint32_t) (int32_t) sample << 16);
+
+    if (filter->seed_on_first && !filter->seeded)
+    {
+        filter->state_q31 = sample_q31;
+    }
+    else
+    {
+        int64_t delta = (int64_t) sample_q31 - (int64_t) filter->state_q31;
+        filter->state_q31 += (int32_t) ((delta * filter->alpha_q15) >> 15);
+    }
+    filter->seeded = true;
+
+    return (int16_t) (filter->state_q31 >> 16);
+}
+
+/**
+ ***************************************************************************************************
+ *
+ * @brief   Biquad, direct form II transposed (2 state variables, 5 multiplies per sample)
+ *
+ **************************************************************************************************/
+void Filter_Biquad_F32_Init(Filter_Biquad_F32_T *filter, const Filter_Biquad_Coeffs_T *coeffs)
+{
+    filter->coeffs = *coeffs;
+    Filter_Biquad_F32_Reset(filter);
+}
+
+void Filter_Biquad_F32_Reset(Filter_Biquad_F32_T *filter)
+{
+    filter->z1 = 0.0f;
+    filter->z2 = 0.0f;
+}
+
+float Filter_Biquad_F32_Update(Filter_Biquad_F32_T *filter, float sample)
+{
+    const Filter_Biquad_Coeffs_T *c = &filter->coeffs;
+
+    float out  = c->b0 * sample + filter->z1;
+    filter->z1 = c->b1 * sample - c->a1 * out + filter->z2;
+    filter->z2 = c->b2 * sample - c->a2 * out;
+
+    return out;
+}
+
+/**
+ ***************************************************************************************************
+ *
+ * @brief   Compute 2nd order low pass coefficients (RBJ audio EQ cookbook)
+ *
+ *          Uses trig functions, so call it at init or when a config value changes, not per sample.
+ *          q = 0.7071 gives a Butterworth response.
+ *
+ **************************************************************************************************/
+void Filter_Biquad_Lowpass_Coeffs(
+    Filter_Biquad_Coeffs_T *coeffs, float cutoff_hz, float sample_rate_hz, float q)
+{
+    float w0    = 2.0f * FILTER_PI * cutoff_hz / sample_rate_hz;
+    float cosw0 = cosf(w0);
+    float alpha = sinf(w0) / (2.0f * q);
+    float a0    = 1.0f + alpha;
+
+    coeffs->b0 = ((1.0f - cosw0) / 2.0f) / a0;
+    coeffs->b1 = (1.0f - cosw0) / a0;
+    coeffs->b2 = coeffs->b0;
+    coeffs->a1 = (-2.0f * cosw0) / a0;
+    coeffs->a2 = (1.0f - alpha) / a0;
+}
+
+/**
+ ***************************************************************************************************
+ *
+ * @brief   Median of the last n samples
+ *
+ *          n is clamped to [1, FILTER_MEDIAN_MAX_N] and must then be odd, so the median is always
+ *          a sample. Until the window has filled, the median of the samples seen so far is
+ *          returned (the mean of the middle two while their count is even).
+ *
+ **************************************************************************************************/
+void Filter_Median_F32_Init(Filter_Median_F32_T *filter, uint8_t n)
+{
+    if (n == 0U)
+    {
+        n = 1U;
+    }
+    else if (n > FILTER_MEDIAN_MAX_N)
+    {
+        n = FILTER_MEDIAN_MAX_N;
+    }
+
+    Q_ASSERT((n & 1U) != 0U);
+
+    filter->n = n;
+    Filter_Median_F32_Reset(filter);
+}
+
+void Filter_Median_F32_Reset(Filter_Median_F32_T *filter)
+{
+    memset(filter->window, 0, sizeof(filter->window));
+    filter->index = 0U;
+    filter->count = 0U;
+}
+
+float Filter_Median_F32_Update(Filter_Median_F32_T *filter, float sample)
+{
+    filter->window[filter->index] = sample;
+
+    filter->index++;
+    if (filter->index >= filter->n)
+    {
+        filter->index = 0U;
+    }
+
+    if (filter->count < filter->n)
+    {
+        filter->count++;
+    }
+
+    return median_of_window(filter);
+}
+
+/**
+ ***************************************************************************************************
+ *
+ * @brief   Slew rate limiter
+ *
+ *          The first sample passes through unchanged, after that the output moves towards the
+ *          input by at most max_rise / max_fall per sample.
+ *
+ **************************************************************************************************/
+void Filter_Rate_Limit_F32_Init(Filter_Rate_Limit_F32_T *filter, float max_rise, float max_fall)
+{
+    filter->max_rise = max_rise;
+    filter->max_fall = max_fall;
+    Filter_Rate_Limit_F32_Reset(filter);
+}
+
+void Filter_Rate_Limit_F32_Reset(Filter_Rate_Limit_F32_T *filter)
+{
+    filter->state  = 0.0f;
+    filter->seeded = false;
+}
+
+float Filter_Rate_Limit_F32_Update(Filter_Rate_Limit_F32_T *filter, float sample)
+{
+    if (!filter->seeded)
+    {
+        filter->state  = sample;
+        filter->seeded = true;
+        return filter->state;
+    }
+
+    float delta = sample - filter->state;
+
+    if (delta > filter->max_rise)
+    {
+        delta = filter->max_rise;
+    }
+    else if (delta < -filter->max_fall)
+    {
+        delta = -filter->max_fall;
+    }
+
+    filter->state += delta;
+
+    return filter->state;
+}
+
+/**************************************************************************************************\
+* Private functions
+\**************************************************************************************************/
+
+static float median_of_window(const Filter_Median_F32_T *filter)
+{
+    float sorted[FILTER_MEDIAN_MAX_N];
+    uint8_t count = filter->count;
+
+    // insertion sort, the window is at most FILTER_MEDIAN_MAX_N long
+    for (uint8_t i = 0U; i < count; i++)
+    {
+        float value = filter->window[i];
+        uint8_t j   = i;
+
+        while ((j > 0U) && (sorted[j - 1U] > value))
+        {
+            sorted[j] = sorted[j - 1U];
+            j--;
+        }
+        sorted[j] = value;
+    }
+
+    if ((count % 2U) == 1U)
+    {
+        return sorted[count / 2U];
+    }
+
+    return 0.5f * (sorted[(count / 2U) - 1U] + sorted[count / 2U]);
+}
@@ -0,0 +1,127 @@
+#ifndef FILTERS_H_
+#define FILTERS_H_
+
+#include "stdint.h"
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************************************************\
+* Public macros
+\**************************************************************************************************/
+
+// Largest window supported by the median filter
+#define FILTER_MEDIAN_MAX_N 9U
+
+// EMA smoothing factor (weight of the new sample) for a first order lag with time constant tau,
+// sampled at sample_rate_hz. Pure arithmetic, so it folds to a constant for literal arguments.
+#define FILTER_EMA_ALPHA(tau_s, sample_rate_hz) \
+    ((1.0f / (float) (sample_rate_hz)) / ((float) (tau_s) + (1.0f / (float) (sample_rate_hz))))
+
+// Convert a float in [-1, 1) to Q15, at compile time for literal arguments
+#define FILTER_FLOAT_TO_Q15(x) ((int16_t) ((x) * 32767.0f))
+
+/**************************************************************************************************\
+* Public type definitions
+\**************************************************************************************************/
+
+/**
+ ***************************************************************************************************
+ * @brief   Exponential moving average, y += alpha * (x - y)
+ **************************************************************************************************/
+typedef struct
+{
+    float alpha;        // weight of the new sample, (1 - lambda)
+    float state;        // last output
+    bool seed_on_first; // if true, the first sample initializes the output instead of 0
+    bool seeded;
+} Filter_EMA_F32_T;
+
+typedef struct
+{
+    int16_t alpha_q15; // weight of the new sample, Q15
+    int32_t state_q31; // last output, Q15 with 16 extra fraction bits so small steps don't stall
+    bool seed_on_first;
+    bool seeded;
+} Filter_EMA_Q15_T;
+
+/**
+ ***************************************************************************************************
+ * @brief   Biquad (direct form II transposed), coefficients normalized so a0 == 1
+ *
+ *          y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+ **************************************************************************************************/
+typedef struct
+{
+    float b0;
+    float b1;
+    float b2;
+    float a1;
+    float a2;
+} Filter_Biquad_Coeffs_T;
+
+typedef struct
+{
+    Filter_Biquad_Coeffs_T coeffs;
+    float z1;
+    float z2;
+} Filter_Biquad_F32_T;
+
+/**
+ ***************************************************************************************************
+ * @brief   Median of the last N samples, rejects single-sample spikes
+ **************************************************************************************************/
+typedef struct
+{
+    float window[FILTER_MEDIAN_MAX_N];
+    uint8_t n;     // window length, odd, <= FILTER_MEDIAN_MAX_N
+    uint8_t index; // next slot to overwrite
+    uint8_t count; // number of valid samples, saturates at n
+} Filter_Median_F32_T;
+
+/**
+ ***************************************************************************************************
+ * @brief   Slew rate limiter, limits the change per sample
+ **************************************************************************************************/
+typedef struct
+{
+    float max_rise; // largest allowed increase per sample (positive)
+    float max_fall; // largest allowed decrease per sample (positive)
+    float state;
+    bool seeded;
+} Filter_Rate_Limit_F32_T;
+
+/**************************************************************************************************\
+* Public prototypes
+\**************************************************************************************************/
+
+void Filter_EMA_F32_Init(Filter_EMA_F32_T *filter, float alpha, bool seed_on_first);
+void Filter_EMA_F32_Reset(Filter_EMA_F32_T *filter);
+void Filter_EMA_F32_Set_Alpha(Filter_EMA_F32_T *filter, float alpha);
+float Filter_EMA_F32_Update(Filter_EMA_F32_T *filter, float sample);
+float Filter_EMA_F32_Get(const Filter_EMA_F32_T *filter);
+
+void Filter_EMA_Q15_Init(Filter_EMA_Q15_T *filter, int16_t alpha_q15, bool seed_on_first);
+void Filter_EMA_Q15_Reset(Filter_EMA_Q15_T *filter);
+int16_t Filter_EMA_Q15_Update(Filter_EMA_Q15_T *filter, int16_t sample);
+
+void Filter_Biquad_F32_Init(Filter_Biquad_F32_T *filter, const Filter_Biquad_Coeffs_T *coeffs);
+void Filter_Biquad_F32_Reset(Filter_Biquad_F32_T *filter);
+float Filter_Biquad_F32_Update(Filter_Biquad_F32_T *filter, float sample);
+void Filter_Biquad_Lowpass_Coeffs(
+    Filter_Biquad_Coeffs_T *coeffs, float cutoff_hz, float sample_rate_hz, float q);
+
+void Filter_Median_F32_Init(Filter_Median_F32_T *filter, uint8_t n);
+void Filter_Median_F32_Reset(Filter_Median_F32_T *filter);
+float Filter_Median_F32_Update(Filter_Median_F32_T *filter, float sample);
+
+void Filter_Rate_Limit_F32_Init(Filter_Rate_Limit_F32_T *filter, float max_rise, float max_fall);
+void Filter_Rate_Limit_F32_Reset(Filter_Rate_Limit_F32_T *filter);
+float Filter_Rate_Limit_F32_Update(Filter_Rate_Limit_F32_T *filter, float sample);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // FILTERS_H_
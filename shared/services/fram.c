@@ -211,7 +211,8 @@ static QState Fram_standby(Fram *const me, QEvt const *const e)
 
             if (me->latest_valid_page < 0)
             {
-                FramReadRespEvent_T *resp_evt = Q_NEW(FramReadRespEvent_T, POSTED_FRAM_READ_RESP_SIG);
+                FramReadRespEvent_T *resp_evt = EVENT_CATALOGUE_NEW(
+                    FRAM_POOL_EVENTS, FramReadRespEvent_T, POSTED_FRAM_READ_RESP_SIG);
                 memset(&resp_evt->file, 0, sizeof(resp_evt->file));
                 resp_evt->read_status = FRAM_FILE_READ_FAIL;
                 QACTIVE_POST(me->requester, &resp_evt->super, &me->super);
@@ -337,7 +338,8 @@ static QState Fram_busy_reading(Fram *const me, QEvt const *const e)
         }
 
         case FRAM_I2C_COMPLETE_SIG: {
-            FramReadRespEvent_T *resp_evt = Q_NEW(FramReadRespEvent_T, POSTED_FRAM_READ_RESP_SIG);
+            FramReadRespEvent_T *resp_evt = EVENT_CATALOGUE_NEW(
+                FRAM_POOL_EVENTS, FramReadRespEvent_T, POSTED_FRAM_READ_RESP_SIG);
             resp_evt->read_status         = FRAM_FILE_READ_OK;
             memcpy(&resp_evt->file, &me->transfer_buffer.file, sizeof(resp_evt->file));
 
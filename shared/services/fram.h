@@ -1,6 +1,7 @@
 #ifndef FRAM_H_
 #define FRAM_H_
 
+#include "event_catalogue.h"
 #include "interfaces/i2c_interface.h"
 #include "qpc.h"
 
@@ -46,6 +47,12 @@ typedef struct
     FRAM_File_T file;
 } FramWriteReqEvent_T;
 
+// pool events, see event_catalogue.h; Config has one request with the Fram AO at a time
+#define FRAM_POOL_EVENTS(X)    \
+    X(FramReadReqEvent_T, 2U)  \
+    X(FramReadRespEvent_T, 2U) \
+    X(FramWriteReqEvent_T, 2U)
+
 extern QActive *const AO_Fram;
 
 void Fram_ctor(I2C_Write i2c_write_fn, I2C_MemoryRead i2c_memory_read_fn);
@@ -0,0 +1,95 @@
+#include "histogram.h"
+#include <string.h>
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+/**
+ ***************************************************************************************************
+ * @brief   Empty the histogram, bucket 0 ending at 2^shift
+ **************************************************************************************************/
+void Histogram_Init(Histogram_T *histogram, uint8_t shift)
+{
+    memset(histogram, 0, sizeof(*histogram));
+    histogram->min   = UINT32_MAX;
+    histogram->shift = shift;
+}
+
+void Histogram_Add(Histogram_T *histogram, uint32_t value)
+{
+    uint32_t scaled = value >> histogram->shift;
+    uint32_t bucket = (scaled == 0U) ? 0U : (32U - (uint32_t) __builtin_clz(scaled));
+
+    if (bucket >= HISTOGRAM_BUCKETS)
+    {
+        bucket = HISTOGRAM_BUCKETS - 1U;
+    }
+
+    histogram->buckets[bucket]++;
+    histogram->count++;
+    histogram->sum += value;
+    if (value < histogram->min)
+    {
+        histogram->min = value;
+    }
+    if (value > histogram->max)
+    {
+        histogram->max = value;
+    }
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Values in the bucket are below this, UINT32_MAX for the last bucket
+ **************************************************************************************************/
+uint32_t Histogram_Bucket_Limit(const Histogram_T *histogram, uint32_t bucket)
+{
+    uint32_t log2_limit = histogram->shift + bucket;
+
+    if ((bucket >= (HISTOGRAM_BUCKETS - 1U)) || (log2_limit >= 32U))
+    {
+        return UINT32_MAX;
+    }
+
+    return 1UL << log2_limit;
+}
+
+uint32_t Histogram_Mean(const Histogram_T *histogram)
+{
+    if (histogram->count == 0U)
+    {
+        return 0U;
+    }
+
+    return (uint32_t) (histogram->sum / histogram->count);
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Upper limit of the bucket the given percentile falls in, capped at the largest value
+ *          seen. 0 if the histogram is empty.
+ **************************************************************************************************/
+uint32_t Histogram_Percentile(const Histogram_T *histogram, uint32_t percent)
+{
+    // rank of the sample at the percentile, 1 based, rounded up
+    uint64_t rank = (((uint64_t) histogram->count * percent) + 99U) / 100U;
+    uint64_t seen = 0U;
+
+    if (rank == 0U)
+    {
+        rank = 1U;
+    }
+
+    for (uint32_t bucket = 0U; bucket < HISTOGRAM_BUCKETS; bucket++)
+    {
+        seen += histogram->buckets[bucket];
+        if (seen >= rank)
+        {
+            uint32_t limit = Histogram_Bucket_Limit(histogram, bucket);
+            return (limit < histogram->max) ? limit : histogram->max;
+        }
+    }
+
+    return 0U;
+}
@@ -0,0 +1,43 @@
+#ifndef HISTOGRAM_H_
+#define HISTOGRAM_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************************************************\
+* Public macros
+\**************************************************************************************************/
+
+// Buckets double in width: bucket 0 holds values below 2^shift, bucket n values from
+// 2^(shift + n - 1) up to 2^(shift + n), and the last bucket everything above
+#define HISTOGRAM_BUCKETS 10U
+
+/**************************************************************************************************\
+* Public type definitions
+\**************************************************************************************************/
+typedef struct
+{
+    uint32_t buckets[HISTOGRAM_BUCKETS];
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint8_t shift; // log2 of the upper limit of bucket 0
+} Histogram_T;
+
+/**************************************************************************************************\
+* Public prototypes
+\**************************************************************************************************/
+void Histogram_Init(Histogram_T *histogram, uint8_t shift);
+void Histogram_Add(Histogram_T *histogram, uint32_t value);
+uint32_t Histogram_Bucket_Limit(const Histogram_T *histogram, uint32_t bucket);
+uint32_t Histogram_Mean(const Histogram_T *histogram);
+uint32_t Histogram_Percentile(const Histogram_T *histogram, uint32_t percent);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // HISTOGRAM_H_
@@ -0,0 +1,190 @@
+#include "kernel_bench.h"
+#include "bsp.h"
+#include "c/MotorData.pb.h"
+#include "crc16.h"
+#include "hdlc.h"
+#include "pb_encode.h"
+#include <string.h>
+
+/**************************************************************************************************\
+* Private prototypes
+\**************************************************************************************************/
+static uint32_t fastest_run(Kernel_Bench_Call_T call, size_t *bytes);
+static size_t empty_call(uint32_t i);
+static void fill_payload(void);
+static void frame_payload(void);
+static uint16_t discard_tx(const uint8_t *data_ptr, const uint16_t data_len);
+static uint16_t capture_tx(const uint8_t *data_ptr, const uint16_t data_len);
+static size_t crc16_call(uint32_t i);
+static size_t hdlc_tx_call(uint32_t i);
+static size_t hdlc_rx_call(uint32_t i);
+static size_t pb_motor_data_call(uint32_t i);
+
+/**************************************************************************************************\
+* Private memory declarations
+\**************************************************************************************************/
+
+// every byte escaped, plus the two flags
+#define FRAMED_PAYLOAD_MAX (2U * KERNEL_BENCH_PAYLOAD_SIZE + 2U)
+
+static uint8_t payload[KERNEL_BENCH_PAYLOAD_SIZE];
+static uint8_t framed_payload[FRAMED_PAYLOAD_MAX];
+static size_t framed_payload_length;
+static uint8_t unpack_buffer[KERNEL_BENCH_PAYLOAD_SIZE];
+static uint8_t encode_buffer[MotorData_size];
+
+/**************************************************************************************************\
+* Public memory declarations
+\**************************************************************************************************/
+const Kernel_Bench_T Kernel_Bench_Common[] = {
+    {"crc16", fill_payload, crc16_call},
+    {"hdlc-tx", fill_payload, hdlc_tx_call},
+    {"hdlc-rx", frame_payload, hdlc_rx_call},
+    {"pb-motor-data", NULL, pb_motor_data_call},
+};
+
+const size_t Kernel_Bench_Common_Count = sizeof(Kernel_Bench_Common) / sizeof(Kernel_Bench_T);
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+/**
+ ***************************************************************************************************
+ * @brief   DWT cycles one call of the kernel takes, from the fastest of KERNEL_BENCH_RUNS runs of
+ *          KERNEL_BENCH_CALLS calls, less the cost of calling an empty kernel the same way
+ **************************************************************************************************/
+Kernel_Bench_Result_T Kernel_Bench_Measure(const Kernel_Bench_T *kernel)
+{
+    Kernel_Bench_Result_T result = {0U, 0U};
+    size_t bytes                 = 0U;
+
+    if (kernel->setup != NULL)
+    {
+        kernel->setup();
+    }
+
+    uint32_t overhead = fastest_run(empty_call, &bytes);
+    uint32_t cycles   = fastest_run(kernel->call, &bytes);
+
+    result.cycles_per_call = ((cycles > overhead) ? (cycles - overhead) : 0U) / KERNEL_BENCH_CALLS;
+    result.bytes_per_call  = (uint32_t) (bytes / KERNEL_BENCH_CALLS);
+    return result;
+}
+
+/**************************************************************************************************\
+* Private functions
+\**************************************************************************************************/
+static uint32_t fastest_run(Kernel_Bench_Call_T call, size_t *bytes)
+{
+    uint32_t fastest = UINT32_MAX;
+
+    for (uint32_t run = 0U; run < KERNEL_BENCH_RUNS; run++)
+    {
+        size_t run_bytes = 0U;
+        uint32_t start   = BSP_Get_Cycle_Count();
+
+        for (uint32_t i = 0U; i < KERNEL_BENCH_CALLS; i++)
+        {
+            run_bytes += call(run * KERNEL_BENCH_CALLS + i);
+        }
+
+        uint32_t elapsed = BSP_Get_Cycle_Count() - start;
+        if (elapsed < fastest)
+        {
+            fastest = elapsed;
+        }
+        *bytes = run_bytes;
+    }
+
+    return fastest;
+}
+
+static size_t empty_call(uint32_t i)
+{
+    (void) i;
+    return 0U;
+}
+
+// a mix of plain bytes and the FLAG / DLE bytes HDLC escapes, about one in 32
+static void fill_payload(void)
+{
+    for (uint32_t i = 0U; i < KERNEL_BENCH_PAYLOAD_SIZE; i++)
+    {
+        payload[i] = (uint8_t) (i * 37U + 11U);
+    }
+}
+
+static void frame_payload(void)
+{
+    fill_payload();
+    framed_payload_length = 0U;
+    hdlc_transmit_packet(capture_tx, payload, sizeof(payload));
+}
+
+static uint16_t discard_tx(const uint8_t *data_ptr, const uint16_t data_len)
+{
+    (void) data_ptr;
+    return data_len;
+}
+
+static uint16_t capture_tx(const uint8_t *data_ptr, const uint16_t data_len)
+{
+    if (framed_payload_length + data_len > sizeof(framed_payload))
+    {
+        return 0U;
+    }
+
+    memcpy(&framed_payload[framed_payload_length], data_ptr, data_len);
+    framed_payload_length += data_len;
+    return data_len;
+}
+
+static size_t crc16_call(uint32_t i)
+{
+    payload[0] = (uint8_t) i;
+    (void) crc_calculate(payload, sizeof(payload));
+    return sizeof(payload);
+}
+
+static size_t hdlc_tx_call(uint32_t i)
+{
+    payload[0] = (uint8_t) i;
+    (void) hdlc_transmit_packet(discard_tx, payload, sizeof(payload));
+    return sizeof(payload);
+}
+
+static size_t hdlc_rx_call(uint32_t i)
+{
+    HDLC_Unpacker_T unpacker;
+    (void) i;
+
+    hdlc_unpacker_init(&unpacker, unpack_buffer, sizeof(unpack_buffer));
+    for (size_t n = 0U; n < framed_payload_length; n++)
+    {
+        (void) hdlc_unpacker_add_byte(&unpacker, framed_payload[n]);
+    }
+    return framed_payload_length;
+}
+
+// a cruising engine, as pc_com sends it
+static size_t pb_motor_data_call(uint32_t i)
+{
+    MotorData message   = MotorData_init_zero;
+    pb_ostream_t stream = pb_ostream_from_buffer(encode_buffer, sizeof(encode_buffer));
+
+    message.milliseconds_tick  = i * 20U;
+    message.temperature        = 78.5f;
+    message.pressure           = 42.0f;
+    message.tachometer         = 4500.0f + (float) (i & 0xFU);
+    message.vbat               = 13.8f;
+    message.engine_minutes     = 12345U;
+    message.temp_good          = true;
+    message.pres_good          = true;
+    message.timestamp_us       = 1000000ULL + (uint64_t) i * 20000U;
+    message.temperature_age_us = 8000U;
+    message.pressure_age_us    = 12000U;
+
+    (void) pb_encode(&stream, MotorData_fields, &message);
+    return stream.bytes_written;
+}
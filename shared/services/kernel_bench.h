@@ -0,0 +1,57 @@
+#ifndef KERNEL_BENCH_H_
+#define KERNEL_BENCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************************************************\
+* Public macros
+\**************************************************************************************************/
+
+// Calls per run, and runs per kernel; the fastest run is kept, so an interrupt landing in one of
+// them doesn't count
+#define KERNEL_BENCH_CALLS 100U
+#define KERNEL_BENCH_RUNS  8U
+
+// Payload of the CRC and HDLC kernels, about a config or motor data packet
+#define KERNEL_BENCH_PAYLOAD_SIZE 64U
+
+/**************************************************************************************************\
+* Public type definitions
+\**************************************************************************************************/
+
+// One call of the kernel, i counting up to vary its input. Returns the bytes it went through, 0
+// for a kernel working on samples rather than bytes
+typedef size_t (*Kernel_Bench_Call_T)(uint32_t i);
+
+typedef struct
+{
+    const char *name;
+    void (*setup)(void); // optional, run once before timing
+    Kernel_Bench_Call_T call;
+} Kernel_Bench_T;
+
+typedef struct
+{
+    uint32_t cycles_per_call; // DWT cycles, loop overhead taken out
+    uint32_t bytes_per_call;
+} Kernel_Bench_Result_T;
+
+/**************************************************************************************************\
+* Public prototypes
+\**************************************************************************************************/
+
+// CRC-16, HDLC framing / unframing and the nanopb MotorData encode, on both boards
+extern const Kernel_Bench_T Kernel_Bench_Common[];
+extern const size_t Kernel_Bench_Common_Count;
+
+Kernel_Bench_Result_T Kernel_Bench_Measure(const Kernel_Bench_T *kernel);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // KERNEL_BENCH_H_
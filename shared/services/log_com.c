@@ -1,5 +1,6 @@
 #include "log_com.h"
 #include "bsp.h"
+#include "event_watermarks.h"
 #include "posted_signals.h"
 #include "private_signal_ranges.h"
 #include "pubsub_signals.h"
@@ -36,6 +37,7 @@ static QState LogCom_active(LogCom *const me, QEvt const *const e);
 static void LogCom_WriteEvent(LogCom *const me, const PrintEvent_T *const print_event);
 static void LogCom_WriteTimestampedText(LogCom *const me, uint32_t milliseconds, const char *msg);
 static void LogCom_WriteLine(LogCom *const me, const char *msg);
+static void LogCom_LogWarning(void *context, const char *warning);
 static void LogCom_LogMotorData(LogCom *const me, const MotorDataEvent_T *const motor_data_event);
 
 static LogCom LogCom_inst;
@@ -54,7 +56,8 @@ int LogCom_Printf(const char *sFormat, ...)
 {
     int r;
     va_list ParamList;
-    PrintEvent_T *printEvent = Q_NEW(PrintEvent_T, POSTED_LOG_COM_PRINT_SIG);
+    PrintEvent_T *printEvent = EVENT_CATALOGUE_NEW(
+        POSTED_POOL_EVENTS, PrintEvent_T, POSTED_LOG_COM_PRINT_SIG);
 
     printEvent->milliseconds = BSP_Get_Milliseconds_Tick();
 
@@ -122,6 +125,8 @@ static QState LogCom_active(LogCom *const me, QEvt const *const e)
                 LogCom_WriteLine(me, "warning: no PUBSUB_MOTOR_DATA_SIG received in 1000 ms");
             }
 
+            Event_Watermarks_Update(BSP_Get_Milliseconds_Tick(), LogCom_LogWarning, me);
+
             me->received_motor_data_since_timeout = false;
             status                                = Q_HANDLED();
             break;
@@ -172,16 +177,23 @@ static void LogCom_WriteLine(LogCom *const me, const char *msg)
     LogCom_WriteEvent(me, &print_event);
 }
 
+static void LogCom_LogWarning(void *context, const char *warning)
+{
+    LogCom_WriteLine((LogCom *) context, warning);
+}
+
 static void LogCom_LogMotorData(LogCom *const me, const MotorDataEvent_T *const motor_data_event)
 {
     char motor_msg[120];
     int msg_length = snprintf(
         motor_msg,
         sizeof(motor_msg),
-        "RPM:%5.0f VBat:%5.2fV Temp:%4.1fC EngMin:%lu\r\n"
+        "RPM:%5.0f VBat:%5.2fV (%5.2f..%5.2f) Temp:%4.1fC EngMin:%lu\r\n"
         "Press:%4.1f Neutral:%u Start:%u TG:%u PG:%u Bz:%u",
         motor_data_event->tachometer,
         motor_data_event->vbat,
+        motor_data_event->vbat_min,
+        motor_data_event->vbat_max,
         motor_data_event->temperature,
         (unsigned long) motor_data_event->engine_minutes,
         motor_data_event->pressure,
@@ -1,13 +1,23 @@
 #include "pc_com.h"
+#include "ao_profile.h"
 #include "bsp.h"
+#include "c/AoProfile.pb.h"
 #include "c/CLIData.pb.h"
+#include "c/CanStats.pb.h"
+#include "c/CpuLoad.pb.h"
+#include "c/EventWatermarks.pb.h"
 #include "c/ConfigDB.pb.h"
 #include "c/LogPrint.pb.h"
 #include "c/MessageType.pb.h"
 #include "c/MotorData.pb.h"
+#include "c/SensorTrace.pb.h"
+#include "can_stats.h"
+#include "can_transport.h"
 #include "cli_commands.h"
 #include "config.h"
+#include "cpu_load.h"
 #include "crc16.h"
+#include "event_watermarks.h"
 #include "hdlc.h"
 #include "pb_decode.h"
 #include "pb_encode.h"
@@ -15,7 +25,9 @@
 #include "pubsub_signals.h"
 #include "reset.h"
 #include "safe_strncpy.h"
+#include "sensor_trace.h"
 #include "stdio.h"
+#include <assert.h>
 #include <string.h>
 
 #define EMBEDDED_CLI_IMPL
@@ -30,15 +42,55 @@ Q_DEFINE_THIS_MODULE("pc_com")
 #define CLI_BUFFER_SIZE 1024
 #endif
 
+// a sensor trace goes out a packet of up to 192 bytes at a time, this many every tick, which is
+// well above what the sensors record while leaving room on the tunnel for the rest
+#define SENSOR_TRACE_TICK_MS          50U
+#define SENSOR_TRACE_PACKETS_PER_TICK 4U
+
+// the CPU load goes out to the PC this often, with its 1 s average
+#define CPU_LOAD_TELEMETRY_MS 1000U
+
+static_assert(
+    Q_DIM(((CanStatsResp *) 0)->ids) >= CAN_MSG_ID_SPAN, "CanStats.options: ids max_count too small");
+static_assert(
+    Q_DIM(((CanStatsResp *) 0)->last_errors) == CAN_ERROR_CODE_COUNT,
+    "CanStats.options: last_errors max_count must be CAN_ERROR_CODE_COUNT");
+static_assert(
+    Q_DIM(((CanHistogram *) 0)->buckets) == HISTOGRAM_BUCKETS,
+    "CanStats.options: buckets max_count must be HISTOGRAM_BUCKETS");
+static_assert(
+    Q_DIM(((RtcProfileResp *) 0)->profiles) >= AO_PROFILE_SIGNAL_RANGES &&
+        Q_DIM(((RtcProfileResp *) 0)->profiles) >= AO_PROFILE_MAX_AOS,
+    "AoProfile.options: profiles max_count too small");
+static_assert(
+    Q_DIM(((RtcHistogram *) 0)->buckets) == HISTOGRAM_BUCKETS,
+    "AoProfile.options: buckets max_count must be HISTOGRAM_BUCKETS");
+static_assert(
+    Q_DIM(((EventWatermarksResp *) 0)->pools) >= QF_MAX_EPOOL,
+    "EventWatermarks.options: pools max_count too small");
+static_assert(
+    Q_DIM(((EventWatermarksResp *) 0)->queues) >= EVENT_WATERMARKS_MAX_QUEUES,
+    "EventWatermarks.options: queues max_count too small");
+
 /**************************************************************************************************\
 * Private type definitions
 \**************************************************************************************************/
 enum PC_COM_Signals
 {
     SERIAL_DATA_AVAILABLE_SIG = PRIVATE_SIGNAL_PC_COM_START,
+    TUNNEL_DATA_AVAILABLE_SIG,
     CLI_PROCESS_TICK_SIG,
+    SENSOR_TRACE_TICK_SIG,
+    CPU_LOAD_TICK_SIG,
 };
 
+// where a packet came from, and so where its response goes
+typedef enum
+{
+    PC_COM_PORT_SERIAL, // HDLC framed
+    PC_COM_PORT_TUNNEL, // to and from the other board, a whole packet at a time
+} PC_COM_Port_T;
+
 typedef uint16_t Packet_CRC_T;
 typedef uint8_t Packet_Type_T;
 
@@ -51,6 +103,11 @@ typedef union
     uint8_t ConfigDBInfoResp_max[ConfigDBInfoResp_size];
     uint8_t ConfigEntryDataResp_max[ConfigEntryDataResp_size];
     uint8_t MotorData_max[MotorData_size];
+    uint8_t CanStatsResp_max[CanStatsResp_size];
+    uint8_t SensorTraceData_max[SensorTraceData_size];
+    uint8_t RtcProfileResp_max[RtcProfileResp_size];
+    uint8_t CpuLoad_max[CpuLoad_size];
+    uint8_t EventWatermarksResp_max[EventWatermarksResp_size];
 } TX_Message_Buffer_T;
 
 typedef union
@@ -83,10 +140,17 @@ typedef struct
     RX_Message_Buffer_T message;
 } __attribute__((packed, aligned(1))) PC_COM_RX_Packet_T;
 
+static_assert(
+    (sizeof(PC_COM_TX_Packet_T) <= CAN_TRANSPORT_MAX_MESSAGE) &&
+        (sizeof(PC_COM_RX_Packet_T) <= CAN_TRANSPORT_MAX_MESSAGE),
+    "pc_com packets must fit through the tunnel");
+
 typedef struct
 {
     QActive super; // inherit QActive
     const Serial_IO_T *serial_io_interface;
+    const Serial_IO_T *tunnel_io_interface; // NULL without a tunnel
+    PC_COM_Port_T reply_port;               // of the last packet received
 
     PC_COM_TX_Packet_T tx_packet;
     PC_COM_RX_Packet_T rx_packet;
@@ -99,6 +163,11 @@ typedef struct
 
     QTimeEvt testEvt;
     QTimeEvt cli_process_tick_evt;
+
+    QTimeEvt sensor_trace_tick_evt;
+    QTimeEvt cpu_load_tick_evt;
+    PC_COM_Port_T sensor_trace_port; // of the start request
+    uint32_t sensor_trace_sequence;
 } PC_COM;
 
 /**************************************************************************************************\
@@ -117,13 +186,32 @@ static QState initial(PC_COM *const me, void const *const par);
 static QState active(PC_COM *const me, QEvt const *const e);
 
 static void calculate_crc_and_send_packet(PC_COM *const me, size_t message_len);
+static void calculate_crc_and_send_packet_to(
+    PC_COM *const me, PC_COM_Port_T port, size_t message_len);
 static void Serial_Data_Ready(void *cb_data);
-static void parse_and_handle_pc_packet(PC_COM *const me);
+static void Tunnel_Data_Ready(void *cb_data);
+static void handle_serial_packet(PC_COM *const me, size_t packet_length);
+static void handle_tunnel_packet(PC_COM *const me, size_t packet_length);
+static void parse_and_handle_pc_packet(PC_COM *const me, size_t packet_length);
 static void handle_cli_char_received(PC_COM *const me);
 static void handle_config_db_info_req(PC_COM *const me);
 static void handle_config_get_entry_req(PC_COM *const me);
 static void handle_config_set_entry_req(PC_COM *const me);
 static void handle_config_db_save_to_nvm_req(PC_COM *const me);
+static void handle_can_stats_req(PC_COM *const me);
+static void copy_histogram(CanHistogram *message, const Histogram_T *histogram);
+static void handle_ao_profile_req(PC_COM *const me);
+static void send_rtc_profile(
+    PC_COM *const me,
+    Packet_Type_T type,
+    bool (*get_profile)(size_t index, AO_Profile_Stats_T *stats));
+static void copy_rtc_histogram(RtcHistogram *message, const Histogram_T *histogram);
+static void send_cpu_load(PC_COM *const me);
+static void handle_event_watermarks_req(PC_COM *const me);
+#ifndef BOARD_GAUGE
+static void handle_sensor_trace_start_req(PC_COM *const me);
+static void send_sensor_trace_data(PC_COM *const me);
+#endif
 
 static void send_db_entry_data_resp_msg(PC_COM *const me, uint32_t id);
 
@@ -135,13 +223,17 @@ static void cli_write_char(EmbeddedCli *embeddedCli, char c);
 
 /**
  ***************************************************************************************************
- * @brief   Constructor
+ * @brief   Constructor. The tunnel carries packets to and from the other board, NULL if there
+ *          isn't one.
  **************************************************************************************************/
-void PC_COM_ctor(const Serial_IO_T *const serial_io_interface)
+void PC_COM_ctor(
+    const Serial_IO_T *const serial_io_interface, const Serial_IO_T *const tunnel_io_interface)
 {
     PC_COM *const me = &pc_com_inst;
 
     pc_com_inst.serial_io_interface = serial_io_interface;
+    pc_com_inst.tunnel_io_interface = tunnel_io_interface;
+    pc_com_inst.reply_port          = PC_COM_PORT_SERIAL;
 
     // CLI config
     EmbeddedCliConfig *config = embeddedCliDefaultConfig();
@@ -167,13 +259,16 @@ void PC_COM_ctor(const Serial_IO_T *const serial_io_interface)
         sizeof(PC_COM_RX_Packet_T));
 
     // init cli data buffer
-    cli_data_event           = Q_NEW(PCCOMCliDataEvent_T, POSTED_PC_COM_CLI_DATA_SIG);
+    cli_data_event = EVENT_CATALOGUE_NEW(
+        PC_COM_POOL_EVENTS, PCCOMCliDataEvent_T, POSTED_PC_COM_CLI_DATA_SIG);
     cli_data_event->msg_size = 0;
     memset(cli_data_event->msg, 0, CLI_DATA_MAX_LENGTH);
 
     QActive_ctor(&me->super, Q_STATE_CAST(&initial));
 
     QTimeEvt_ctorX(&me->cli_process_tick_evt, &me->super, CLI_PROCESS_TICK_SIG, 0U);
+    QTimeEvt_ctorX(&me->sensor_trace_tick_evt, &me->super, SENSOR_TRACE_TICK_SIG, 0U);
+    QTimeEvt_ctorX(&me->cpu_load_tick_evt, &me->super, CPU_LOAD_TICK_SIG, 0U);
 }
 
 /**
@@ -184,7 +279,8 @@ void PC_COM_ctor(const Serial_IO_T *const serial_io_interface)
  **************************************************************************************************/
 void PC_COM_print(const char *msg)
 {
-    PCCOMPrintEvent_T *event = Q_NEW(PCCOMPrintEvent_T, POSTED_PC_COM_PRINT_SIG);
+    PCCOMPrintEvent_T *event = EVENT_CATALOGUE_NEW(
+        PC_COM_POOL_EVENTS, PCCOMPrintEvent_T, POSTED_PC_COM_PRINT_SIG);
 
     event->milliseconds = BSP_Get_Milliseconds_Tick();
     safe_strncpy(event->msg, msg, sizeof(event->msg));
@@ -213,11 +309,20 @@ static QState initial(PC_COM *const me, void const *const par)
     QTimeEvt_armX(
         &me->cli_process_tick_evt, MILLISECONDS_TO_TICKS(25U), MILLISECONDS_TO_TICKS(25U));
 
+    QTimeEvt_armX(
+        &me->cpu_load_tick_evt,
+        MILLISECONDS_TO_TICKS(CPU_LOAD_TELEMETRY_MS),
+        MILLISECONDS_TO_TICKS(CPU_LOAD_TELEMETRY_MS));
+
     // test
     // QTimeEvt_armX(&me->testEvt, MILLISECONDS_TO_TICKS(1000), MILLISECONDS_TO_TICKS(1000));
 
     // Register callback with the SerialIO interface to be called when new data is available
     me->serial_io_interface->register_cb_func(Serial_Data_Ready, me);
+    if (me->tunnel_io_interface != NULL)
+    {
+        me->tunnel_io_interface->register_cb_func(Tunnel_Data_Ready, me);
+    }
     return Q_TRAN(&active);
 }
 
@@ -242,7 +347,7 @@ static QState active(PC_COM *const me, QEvt const *const e)
 
                 if (unpack_state == FRAME_UNPACK_COMPLETE)
                 {
-                    parse_and_handle_pc_packet(me);
+                    handle_serial_packet(me, me->hdlc_unpacker.packet_length);
                 }
             }
 
@@ -250,6 +355,26 @@ static QState active(PC_COM *const me, QEvt const *const e)
             break;
         }
 
+        case TUNNEL_DATA_AVAILABLE_SIG: {
+#ifdef BOARD_GAUGE
+            // responses from the motor, passed on as they are
+            uint8_t *packet = (uint8_t *) &me->tx_packet;
+            uint16_t length = sizeof(PC_COM_TX_Packet_T);
+#else
+            uint8_t *packet = (uint8_t *) &me->rx_packet;
+            uint16_t length = sizeof(PC_COM_RX_Packet_T);
+#endif
+            uint16_t packet_length;
+
+            while ((packet_length = me->tunnel_io_interface->rx_func(packet, length)) > 0U)
+            {
+                handle_tunnel_packet(me, packet_length);
+            }
+
+            status = Q_HANDLED();
+            break;
+        }
+
         case CLI_PROCESS_TICK_SIG: {
             // check to see if there is CLI data in buffer to be sent
             if (cli_data_event->msg_size > 0)
@@ -257,7 +382,8 @@ static QState active(PC_COM *const me, QEvt const *const e)
                 QACTIVE_POST(AO_PC_COM, (QEvt *) (cli_data_event), AO_PC_COM);
 
                 // init a new cli data event
-                cli_data_event           = Q_NEW(PCCOMCliDataEvent_T, POSTED_PC_COM_CLI_DATA_SIG);
+                cli_data_event = EVENT_CATALOGUE_NEW(
+                    PC_COM_POOL_EVENTS, PCCOMCliDataEvent_T, POSTED_PC_COM_CLI_DATA_SIG);
                 cli_data_event->msg_size = 0;
                 memset(cli_data_event->msg, 0, CLI_DATA_MAX_LENGTH);
             }
@@ -267,6 +393,20 @@ static QState active(PC_COM *const me, QEvt const *const e)
             break;
         }
 
+        case CPU_LOAD_TICK_SIG: {
+            send_cpu_load(me);
+            status = Q_HANDLED();
+            break;
+        }
+
+#ifndef BOARD_GAUGE
+        case SENSOR_TRACE_TICK_SIG: {
+            send_sensor_trace_data(me);
+            status = Q_HANDLED();
+            break;
+        }
+#endif
+
         case POSTED_PC_COM_CLI_DATA_SIG: {
             // set message type
             me->tx_packet.type = MessageType_CLI_DATA;
@@ -310,7 +450,7 @@ static QState active(PC_COM *const me, QEvt const *const e)
             Q_ASSERT(ok);
 
             // calculate CRC and transmit
-            calculate_crc_and_send_packet(me, stream.bytes_written);
+            calculate_crc_and_send_packet_to(me, PC_COM_PORT_SERIAL, stream.bytes_written);
             status = Q_HANDLED();
             break;
         }
@@ -331,22 +471,25 @@ static QState active(PC_COM *const me, QEvt const *const e)
             pb_ostream_t stream = pb_ostream_from_buffer(
                 ((uint8_t *) &me->tx_packet.message), sizeof(TX_Message_Buffer_T));
 
-            message.milliseconds_tick = BSP_Get_Milliseconds_Tick();
-            message.temperature       = evt->temperature;
-            message.pressure          = evt->pressure;
-            message.tachometer        = evt->tachometer;
-            message.vbat              = evt->vbat;
-            message.engine_minutes    = evt->engine_minutes;
-            message.start             = evt->start;
-            message.neutral           = evt->neutral;
-            message.buzzer            = evt->buzzer;
-            message.temp_good         = evt->temp_good;
-            message.pres_good         = evt->pres_good;
+            message.milliseconds_tick  = BSP_Get_Milliseconds_Tick();
+            message.temperature        = evt->temperature;
+            message.pressure           = evt->pressure;
+            message.tachometer         = evt->tachometer;
+            message.vbat               = evt->vbat;
+            message.engine_minutes     = evt->engine_minutes;
+            message.start              = evt->start;
+            message.neutral            = evt->neutral;
+            message.buzzer             = evt->buzzer;
+            message.temp_good          = evt->temp_good;
+            message.pres_good          = evt->pres_good;
+            message.timestamp_us       = evt->timestamp_us;
+            message.temperature_age_us = evt->temperature_age_us;
+            message.pressure_age_us    = evt->pressure_age_us;
 
             bool ok = pb_encode(&stream, MotorData_fields, &message);
             Q_ASSERT(ok);
 
-            calculate_crc_and_send_packet(me, stream.bytes_written);
+            calculate_crc_and_send_packet_to(me, PC_COM_PORT_SERIAL, stream.bytes_written);
             status = Q_HANDLED();
             break;
         }
@@ -360,8 +503,20 @@ static QState active(PC_COM *const me, QEvt const *const e)
     return status;
 }
 
+/**
+ ***************************************************************************************************
+ * @brief   Send the TX packet where the last packet received came from
+ **************************************************************************************************/
 static void calculate_crc_and_send_packet(PC_COM *const me, size_t message_len)
 {
+    calculate_crc_and_send_packet_to(me, me->reply_port, message_len);
+}
+
+static void calculate_crc_and_send_packet_to(
+    PC_COM *const me, PC_COM_Port_T port, size_t message_len)
+{
+    size_t packet_len = sizeof(Packet_CRC_T) + sizeof(Packet_Type_T) + message_len;
+
     // calculate CRC, including packet type and data (ignore the CRC itself)
     uint16_t crc_calc = crc_calculate(
         &((uint8_t *) &me->tx_packet)[sizeof(Packet_CRC_T)], sizeof(Packet_Type_T) + message_len);
@@ -369,11 +524,16 @@ static void calculate_crc_and_send_packet(PC_COM *const me, size_t message_len)
     // add CRC to the packet
     me->tx_packet.crc = crc_calc;
 
-    // transmit packet
-    hdlc_transmit_packet(
-        me->serial_io_interface->tx_func,
-        ((uint8_t *) &me->tx_packet),
-        sizeof(Packet_CRC_T) + sizeof(Packet_Type_T) + message_len);
+    // transmit packet, dropped if the tunnel has no room for it, like a full serial port
+    if ((port == PC_COM_PORT_TUNNEL) && (me->tunnel_io_interface != NULL))
+    {
+        me->tunnel_io_interface->tx_func((uint8_t *) &me->tx_packet, (uint16_t) packet_len);
+    }
+    else
+    {
+        hdlc_transmit_packet(
+            me->serial_io_interface->tx_func, ((uint8_t *) &me->tx_packet), packet_len);
+    }
 }
 
 /**
@@ -390,6 +550,18 @@ static void Serial_Data_Ready(void *cb_data)
     QACTIVE_POST(me, &event, me);
 }
 
+/**
+ ***************************************************************************************************
+ * @brief   Tunnel packet ready callback, called by Box_To_Box
+ **************************************************************************************************/
+static void Tunnel_Data_Ready(void *cb_data)
+{
+    static QEvt const event = QEVT_INITIALIZER(TUNNEL_DATA_AVAILABLE_SIG);
+
+    QActive *me = (QActive *) cb_data;
+    QACTIVE_POST(me, &event, me);
+}
+
 /**
  ***************************************************************************************************
  *
@@ -408,31 +580,87 @@ static void cli_write_char(EmbeddedCli *embeddedCli, char c)
         QACTIVE_POST(AO_PC_COM, (QEvt *) (cli_data_event), AO_PC_COM);
 
         // init a new cli data event
-        cli_data_event           = Q_NEW(PCCOMCliDataEvent_T, POSTED_PC_COM_CLI_DATA_SIG);
+        cli_data_event = EVENT_CATALOGUE_NEW(
+            PC_COM_POOL_EVENTS, PCCOMCliDataEvent_T, POSTED_PC_COM_CLI_DATA_SIG);
         cli_data_event->msg_size = 0;
         memset(cli_data_event->msg, 0, CLI_DATA_MAX_LENGTH);
     }
 }
 
+/**
+ ***************************************************************************************************
+ * @brief   A packet from the PC. On the gauge, one with PC_COM_TYPE_MOTOR_BIT set in its type goes
+ *          on to the motor without the bit.
+ **************************************************************************************************/
+static void handle_serial_packet(PC_COM *const me, size_t packet_length)
+{
+#ifdef BOARD_GAUGE
+    if (
+        (packet_length >= (sizeof(Packet_CRC_T) + sizeof(Packet_Type_T))) &&
+        ((me->rx_packet.type & PC_COM_TYPE_MOTOR_BIT) != 0U) && (me->tunnel_io_interface != NULL))
+    {
+        uint8_t *packet = (uint8_t *) &me->rx_packet;
+        uint16_t crc_calc =
+            crc_calculate(&packet[sizeof(Packet_CRC_T)], packet_length - sizeof(Packet_CRC_T));
+
+        // only a packet that arrived intact is passed on with a new CRC
+        if (me->rx_packet.crc == crc_calc)
+        {
+            me->rx_packet.type &= (Packet_Type_T) ~PC_COM_TYPE_MOTOR_BIT;
+            me->rx_packet.crc =
+                crc_calculate(&packet[sizeof(Packet_CRC_T)], packet_length - sizeof(Packet_CRC_T));
+            me->tunnel_io_interface->tx_func(packet, (uint16_t) packet_length);
+        }
+        return;
+    }
+#endif
+
+    me->reply_port = PC_COM_PORT_SERIAL;
+    parse_and_handle_pc_packet(me, packet_length);
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   A packet from the other board. The gauge passes the motor's on to the PC with
+ *          PC_COM_TYPE_MOTOR_BIT set in their type, the motor handles the requests the gauge
+ *          passed on and responds through the tunnel.
+ **************************************************************************************************/
+static void handle_tunnel_packet(PC_COM *const me, size_t packet_length)
+{
+    if (packet_length < (sizeof(Packet_CRC_T) + sizeof(Packet_Type_T)))
+    {
+        return;
+    }
+
+#ifdef BOARD_GAUGE
+    me->tx_packet.type |= PC_COM_TYPE_MOTOR_BIT;
+    calculate_crc_and_send_packet_to(
+        me, PC_COM_PORT_SERIAL, packet_length - sizeof(Packet_CRC_T) - sizeof(Packet_Type_T));
+#else
+    me->reply_port = PC_COM_PORT_TUNNEL;
+    parse_and_handle_pc_packet(me, packet_length);
+#endif
+}
+
 /**
  ***************************************************************************************************
  *
  * @brief   Parse packet recieved from PC and handle it
  *
  **************************************************************************************************/
-static void parse_and_handle_pc_packet(PC_COM *const me)
+static void parse_and_handle_pc_packet(PC_COM *const me, size_t packet_length)
 {
     uint16_t crc_calc;
 
     // calculate the CRC of the received packet, excluding the CRC itself (the initial bytes)
     crc_calc = crc_calculate(
-        &((uint8_t *) &me->rx_packet)[sizeof(Packet_CRC_T)],
-        me->hdlc_unpacker.packet_length - sizeof(Packet_CRC_T));
+        &((uint8_t *) &me->rx_packet)[sizeof(Packet_CRC_T)], packet_length - sizeof(Packet_CRC_T));
 
     // does crc in the packet match the calculated crc?
     if (me->rx_packet.crc == crc_calc)
     {
-        switch (me->rx_packet.type)
+        // the PC addressing this board's own messages to the motor changes nothing
+        switch (me->rx_packet.type & (Packet_Type_T) ~PC_COM_TYPE_MOTOR_BIT)
         {
             // CLI character(s) received
             case MessageType_CLI_DATA:
@@ -459,6 +687,32 @@ static void parse_and_handle_pc_packet(PC_COM *const me)
                 handle_config_db_save_to_nvm_req(me);
                 break;
 
+            // CAN statistics request
+            case MessageType_CAN_STATS_REQ:
+                handle_can_stats_req(me);
+                break;
+
+            // run to completion profile request
+            case MessageType_AO_PROFILE_REQ:
+                handle_ao_profile_req(me);
+                break;
+
+            // event pool and queue low-water marks request
+            case MessageType_EVENT_WATERMARKS_REQ:
+                handle_event_watermarks_req(me);
+                break;
+
+#ifndef BOARD_GAUGE
+            // sensor trace, only the motor has the sensors
+            case MessageType_SENSOR_TRACE_START_REQ:
+                handle_sensor_trace_start_req(me);
+                break;
+
+            case MessageType_SENSOR_TRACE_STOP_REQ:
+                Sensor_Trace_Stop();
+                break;
+#endif
+
             // command not found, let it go
             default:
                 break;
@@ -508,6 +762,264 @@ static void handle_config_db_save_to_nvm_req(PC_COM *const me)
     QACTIVE_POST(AO_Config, &event, &me);
 }
 
+/**
+ ***************************************************************************************************
+ * @brief   Send the CAN counters and histograms of every message ID with traffic
+ **************************************************************************************************/
+static void handle_can_stats_req(PC_COM *const me)
+{
+    // over 1 kB decoded, too big for the stack
+    static CanStatsResp message;
+    CAN_Error_Stats_T errors;
+    CAN_Id_Stats_T id_stats;
+
+    me->tx_packet.type = MessageType_CAN_STATS_RESP;
+    memset(&message, 0, sizeof(message));
+
+    CAN_Stats_Get_Errors(&errors);
+    message.milliseconds_tick      = BSP_Get_Milliseconds_Tick();
+    message.tx_error_count         = errors.bus.tx_errors;
+    message.rx_error_count         = errors.bus.rx_errors;
+    message.errors_logged          = errors.errors_logged;
+    message.tx_events_unmatched    = errors.tx_events_unmatched;
+    message.last_errors_count      = CAN_ERROR_CODE_COUNT;
+    message.data_last_errors_count = CAN_ERROR_CODE_COUNT;
+    memcpy(message.last_errors, errors.last_errors, sizeof(message.last_errors));
+    memcpy(message.data_last_errors, errors.data_last_errors, sizeof(message.data_last_errors));
+
+    for (uint32_t id = 0U; id < CAN_MSG_ID_SPAN; id++)
+    {
+        CAN_Stats_Get_Id(id, &id_stats);
+        if ((id_stats.tx_frames == 0U) && (id_stats.rx_frames == 0U))
+        {
+            continue;
+        }
+
+        CanIdStats *entry = &message.ids[message.ids_count++];
+        entry->id         = id;
+        entry->tx_frames  = id_stats.tx_frames;
+        entry->tx_events  = id_stats.tx_events;
+        entry->rx_frames  = id_stats.rx_frames;
+        copy_histogram(&entry->tx_latency_us, &id_stats.tx_latency_us);
+        copy_histogram(&entry->rx_age_us, &id_stats.rx_age_us);
+    }
+
+    pb_ostream_t stream = pb_ostream_from_buffer(
+        ((uint8_t *) &me->tx_packet.message), sizeof(TX_Message_Buffer_T));
+
+    bool ok = pb_encode(&stream, CanStatsResp_fields, &message);
+    Q_ASSERT(ok);
+
+    calculate_crc_and_send_packet(me, stream.bytes_written);
+}
+
+static void copy_histogram(CanHistogram *message, const Histogram_T *histogram)
+{
+    message->buckets_count = HISTOGRAM_BUCKETS;
+    memcpy(message->buckets, histogram->buckets, sizeof(message->buckets));
+    message->shift = histogram->shift;
+    message->count = histogram->count;
+    message->min   = (histogram->count > 0U) ? histogram->min : 0U;
+    message->max   = histogram->max;
+    message->sum   = histogram->sum;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Send the run to completion profile of each AO, then of each signal range, the ones that
+ *          ran since the last reset
+ **************************************************************************************************/
+static void handle_ao_profile_req(PC_COM *const me)
+{
+    send_rtc_profile(me, MessageType_AO_PROFILE_RESP, AO_Profile_Get_AO);
+    send_rtc_profile(me, MessageType_SIGNAL_PROFILE_RESP, AO_Profile_Get_Signal_Range);
+}
+
+static void send_rtc_profile(
+    PC_COM *const me,
+    Packet_Type_T type,
+    bool (*get_profile)(size_t index, AO_Profile_Stats_T *stats))
+{
+    // near 2 kB decoded, too big for the stack
+    static RtcProfileResp message;
+    AO_Profile_Stats_T stats;
+
+    me->tx_packet.type = type;
+    memset(&message, 0, sizeof(message));
+    message.milliseconds_tick = BSP_Get_Milliseconds_Tick();
+
+    for (size_t i = 0U; get_profile(i, &stats); i++)
+    {
+        if (stats.rtc_cycles.count == 0U)
+        {
+            continue;
+        }
+
+        RtcProfile *entry = &message.profiles[message.profiles_count++];
+        safe_strncpy(entry->name, stats.name, sizeof(entry->name));
+        entry->id = stats.id;
+        copy_rtc_histogram(&entry->cycles, &stats.rtc_cycles);
+    }
+
+    pb_ostream_t stream = pb_ostream_from_buffer(
+        ((uint8_t *) &me->tx_packet.message), sizeof(TX_Message_Buffer_T));
+
+    bool ok = pb_encode(&stream, RtcProfileResp_fields, &message);
+    Q_ASSERT(ok);
+
+    calculate_crc_and_send_packet(me, stream.bytes_written);
+}
+
+static void copy_rtc_histogram(RtcHistogram *message, const Histogram_T *histogram)
+{
+    message->buckets_count = HISTOGRAM_BUCKETS;
+    memcpy(message->buckets, histogram->buckets, sizeof(message->buckets));
+    message->shift = histogram->shift;
+    message->count = histogram->count;
+    message->min   = histogram->min;
+    message->max   = histogram->max;
+    message->sum   = histogram->sum;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Send the CPU load to the PC, as the motor data
+ **************************************************************************************************/
+static void send_cpu_load(PC_COM *const me)
+{
+    CpuLoad message = CpuLoad_init_zero;
+    CPU_Load_T load;
+
+    CPU_Load_Get(&load);
+    message.milliseconds_tick = BSP_Get_Milliseconds_Tick();
+    message.load_100ms        = load.load_100ms;
+    message.load_1s           = load.load_1s;
+    message.load_10s          = load.load_10s;
+    message.peak_100ms        = load.peak_100ms;
+
+    me->tx_packet.type  = MessageType_CPU_LOAD;
+    pb_ostream_t stream = pb_ostream_from_buffer(
+        ((uint8_t *) &me->tx_packet.message), sizeof(TX_Message_Buffer_T));
+
+    bool ok = pb_encode(&stream, CpuLoad_fields, &message);
+    Q_ASSERT(ok);
+
+    calculate_crc_and_send_packet_to(me, PC_COM_PORT_SERIAL, stream.bytes_written);
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Send how close each event pool and AO queue came to running out, and how fast each
+ *          pool is drawn on
+ **************************************************************************************************/
+static void handle_event_watermarks_req(PC_COM *const me)
+{
+    static EventWatermarksResp message;
+    Event_Pool_Stats_T pool;
+    Event_Queue_Stats_T queue;
+
+    memset(&message, 0, sizeof(message));
+    message.milliseconds_tick = BSP_Get_Milliseconds_Tick();
+    message.warn_percent      = EVENT_WATERMARKS_WARN_PERCENT;
+
+    for (size_t i = 0U; Event_Watermarks_Get_Pool(i, &pool); i++)
+    {
+        EventPoolWatermark *entry = &message.pools[message.pools_count++];
+        entry->block_size         = pool.block_size;
+        entry->blocks             = pool.blocks;
+        entry->free               = pool.free;
+        entry->min_free           = pool.min_free;
+        entry->allocs             = pool.allocs;
+        entry->allocs_per_s       = pool.allocs_per_s;
+        entry->peak_allocs_per_s  = pool.peak_allocs_per_s;
+    }
+
+    for (size_t i = 0U; Event_Watermarks_Get_Queue(i, &queue); i++)
+    {
+        EventQueueWatermark *entry = &message.queues[message.queues_count++];
+        safe_strncpy(entry->name, queue.name, sizeof(entry->name));
+        entry->prio     = queue.prio;
+        entry->length   = queue.length;
+        entry->free     = queue.free;
+        entry->min_free = queue.min_free;
+    }
+
+    me->tx_packet.type  = MessageType_EVENT_WATERMARKS_RESP;
+    pb_ostream_t stream = pb_ostream_from_buffer(
+        ((uint8_t *) &me->tx_packet.message), sizeof(TX_Message_Buffer_T));
+
+    bool ok = pb_encode(&stream, EventWatermarksResp_fields, &message);
+    Q_ASSERT(ok);
+
+    calculate_crc_and_send_packet(me, stream.bytes_written);
+}
+
+#ifndef BOARD_GAUGE
+/**
+ ***************************************************************************************************
+ * @brief   Start a new sensor trace, streamed to where the request came from until the stop
+ *          request
+ **************************************************************************************************/
+static void handle_sensor_trace_start_req(PC_COM *const me)
+{
+    me->sensor_trace_port     = me->reply_port;
+    me->sensor_trace_sequence = 0U;
+    Sensor_Trace_Start();
+
+    QTimeEvt_disarm(&me->sensor_trace_tick_evt);
+    QTimeEvt_armX(
+        &me->sensor_trace_tick_evt,
+        MILLISECONDS_TO_TICKS(SENSOR_TRACE_TICK_MS),
+        MILLISECONDS_TO_TICKS(SENSOR_TRACE_TICK_MS));
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Send what the trace recorded since the last tick. Once it is stopped and all sent, a
+ *          packet flagged last ends the stream.
+ **************************************************************************************************/
+static void send_sensor_trace_data(PC_COM *const me)
+{
+    SensorTraceData message = SensorTraceData_init_zero;
+    Sensor_Trace_Stats_T stats;
+
+    for (uint32_t i = 0U; i < SENSOR_TRACE_PACKETS_PER_TICK; i++)
+    {
+        message.data.size = (pb_size_t) Sensor_Trace_Read(
+            message.data.bytes, sizeof(message.data.bytes));
+        message.last = !Sensor_Trace_Is_Recording() &&
+            (message.data.size < sizeof(message.data.bytes));
+        if ((message.data.size == 0U) && !message.last)
+        {
+            break;
+        }
+
+        Sensor_Trace_Get_Stats(&stats);
+        message.sequence     = me->sensor_trace_sequence++;
+        message.lost_records = stats.lost;
+
+        me->tx_packet.type  = MessageType_SENSOR_TRACE_DATA;
+        pb_ostream_t stream = pb_ostream_from_buffer(
+            ((uint8_t *) &me->tx_packet.message), sizeof(TX_Message_Buffer_T));
+
+        bool ok = pb_encode(&stream, SensorTraceData_fields, &message);
+        Q_ASSERT(ok);
+
+        calculate_crc_and_send_packet_to(me, me->sensor_trace_port, stream.bytes_written);
+
+        if (message.last)
+        {
+            QTimeEvt_disarm(&me->sensor_trace_tick_evt);
+            break;
+        }
+        if (message.data.size < sizeof(message.data.bytes))
+        {
+            break;
+        }
+    }
+}
+#endif
+
 static void handle_config_get_entry_req(PC_COM *const me)
 {
     pb_istream_t istream = pb_istream_from_buffer(
@@ -1,6 +1,7 @@
 #ifndef PC_COM_AO_H_
 #define PC_COM_AO_H_
 
+#include "event_catalogue.h"
 #include "interfaces/serial_interface.h"
 #include "qpc.h"
 #include "stddef.h"
@@ -16,6 +17,10 @@ extern "C" {
 #define PC_COM_EVENT_MAX_MSG_LENGTH 64
 #define CLI_DATA_MAX_LENGTH         64
 
+// set in a packet's type, which is a MessageType below 128: a request the gauge passes on to the
+// motor, or the motor's response the gauge passes back
+#define PC_COM_TYPE_MOTOR_BIT 0x80U
+
 /**************************************************************************************************\
 * Public memory declarations
 \**************************************************************************************************/
@@ -86,10 +91,16 @@ typedef struct
     uint16_t data_len;
 } Plot_DPV_Event_T;
 
+// pool events, see event_catalogue.h; PC_COM keeps one CLI data event while it fills it
+#define PC_COM_POOL_EVENTS(X)  \
+    X(PCCOMPrintEvent_T, 4U)   \
+    X(PCCOMCliDataEvent_T, 4U)
+
 /**************************************************************************************************\
 * Public prototypes
 \**************************************************************************************************/
-void PC_COM_ctor(const Serial_IO_T *const serial_io_interface);
+void PC_COM_ctor(
+    const Serial_IO_T *const serial_io_interface, const Serial_IO_T *const tunnel_io_interface);
 void PC_COM_print(const char *msg);
 
 #ifdef __cplusplus
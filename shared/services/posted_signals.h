@@ -1,6 +1,7 @@
 #ifndef POSTED_SIGNALS_H_
 #define POSTED_SIGNALS_H_
 
+#include "event_catalogue.h"
 #include "pubsub_signals.h"
 #include "qp.h"
 
@@ -18,7 +19,9 @@ enum PostedSignals
     POSTED_FRAM_READ_RESP_SIG,
     POSTED_FRAM_WRITE_REQ_SIG,
     POSTED_FRAM_WRITE_COMPLETE_SIG,
-    POSTED_CAN_MESSAGE_RECEIVED_SIG,
+    POSTED_CAN_FRAMES_AVAILABLE_SIG,
+    POSTED_CAN_TX_COMPLETE_SIG,
+    POSTED_CAN_BUS_STATUS_SIG,
     POSTED_BLINKY_TOGGLE_USER_LED,
     POSTED_MAX_SIG
 };
@@ -46,4 +49,7 @@ typedef struct
     uint32_t desiredFault;
 } DebugForceFaultEvent_T;
 
+// pool events, see event_catalogue.h; LogCom_Printf() can be called a few times in a row
+#define POSTED_POOL_EVENTS(X) X(PrintEvent_T, 8U)
+
 #endif // POSTED_SIGNALS_H_
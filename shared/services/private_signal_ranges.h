@@ -27,9 +27,9 @@ enum PrivateSignalRanges
     PRIVATE_SIGNAL_SHARED_I2C_START,
     PRIVATE_SIGNAL_SHARED_I2C_MAX = PRIVATE_SIGNAL_SHARED_I2C_START + 10,
     PRIVATE_SIGNAL_PRESSURE_START,
-    PRIVATE_SIGNAL_PRESSURE_MAX = PRIVATE_SIGNAL_SHARED_I2C_START + 10,
+    PRIVATE_SIGNAL_PRESSURE_MAX = PRIVATE_SIGNAL_PRESSURE_START + 10,
     PRIVATE_SIGNAL_LMT01_START,
-    PRIVATE_SIGNAL_LMT01_MAX = PRIVATE_SIGNAL_SHARED_I2C_START + 10,
+    PRIVATE_SIGNAL_LMT01_MAX = PRIVATE_SIGNAL_LMT01_START + 10,
     PRIVATE_SIGNAL_DIRECTOR_START,
     PRIVATE_SIGNAL_DIRECTOR_MAX = PRIVATE_SIGNAL_DIRECTOR_START + 10,
     PRIVATE_SIGNAL_BOX_TO_BOX_START,
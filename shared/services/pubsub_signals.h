@@ -1,6 +1,7 @@
 #ifndef PUBSUB_SIGNALS_H_
 #define PUBSUB_SIGNALS_H_
 
+#include "event_catalogue.h"
 #include "fault_manager.h"
 #include "qpc.h"
 #include <stddef.h>
@@ -16,13 +17,27 @@ enum PubSubSignals
     PUBSUB_CONFIG_READY_SIG,
     PUBSUB_CONFIG_ENTRY_CHANGED_SIG,
     PUBSUB_BOX_TO_BOX_STARTUP_SIG,
+    PUBSUB_VBAT_SIG,
     PUBSUB_MAX_SIG
 };
 
+// Sample age reported in MotorDataEvent_T when that sensor has not produced a sample yet
+#define SAMPLE_AGE_UNKNOWN_US UINT32_MAX
+
+// MotorDataEvent_T.updated bits, the fields (rate groups) sampled for that publication
+#define MOTOR_DATA_UPDATED_FLAGS          (1U << 0) // start, neutral, buzzer, temp/pres good
+#define MOTOR_DATA_UPDATED_TACHOMETER     (1U << 1)
+#define MOTOR_DATA_UPDATED_TEMPERATURE    (1U << 2)
+#define MOTOR_DATA_UPDATED_PRESSURE       (1U << 3)
+#define MOTOR_DATA_UPDATED_VBAT           (1U << 4) // vbat, vbat_min, vbat_max
+#define MOTOR_DATA_UPDATED_ENGINE_MINUTES (1U << 5)
+#define MOTOR_DATA_UPDATED_ALL            0x3FU
+
 typedef struct
 {
     QEvt super;
     float num;
+    uint64_t timestamp_us; // BSP_Get_Microseconds() when the sample was acquired
 } FloatEvent_T;
 
 typedef struct
@@ -31,6 +46,15 @@ typedef struct
     int16_t num;
 } Int16Event_T;
 
+typedef struct
+{
+    QEvt super;
+    float volts;           // mean over one VBAT ADC block
+    float min_volts;       // lowest sample in the block (e.g. cranking dip)
+    float max_volts;       // highest sample in the block
+    uint64_t timestamp_us; // middle of the block
+} VbatEvent_T;
+
 typedef struct
 {
     QEvt super;
@@ -38,12 +62,18 @@ typedef struct
     float pressure;
     float tachometer;
     float vbat;
+    float vbat_min;
+    float vbat_max;
     uint32_t engine_minutes;
     bool start;
     bool neutral;
     bool buzzer;
     bool temp_good;
     bool pres_good;
+    uint64_t timestamp_us;       // when the data was gathered, publishing board's clock
+    uint32_t temperature_age_us; // temperature sample age at timestamp_us
+    uint32_t pressure_age_us;    // pressure sample age at timestamp_us
+    uint8_t updated;             // MOTOR_DATA_UPDATED_* bits, the others hold their last value
 } MotorDataEvent_T;
 
 typedef struct
@@ -56,4 +86,13 @@ typedef struct
     char msg[FAULT_GEN_EVENT_MAX_MSG_LENGTH];
 } FaultGeneratedEvent_T;
 
+// For event_catalogue.h, the events above allocated from QF's pools and the most in use at once.
+// A bare QEvt carries a signal such as PUBSUB_BOX_TO_BOX_STARTUP_SIG.
+#define PUBSUB_POOL_EVENTS(X)    \
+    X(QEvt, 2U)                  \
+    X(FloatEvent_T, 4U)          \
+    X(VbatEvent_T, 2U)           \
+    X(MotorDataEvent_T, 4U)      \
+    X(FaultGeneratedEvent_T, 4U)
+
 #endif // PUBSUB_SIGNALS_H_
@@ -0,0 +1,305 @@
+#include "sensor_trace.h"
+#include "bsp.h"
+#include "qpc.h"
+#include <assert.h>
+#include <string.h>
+
+/**************************************************************************************************\
+* Private macros
+\**************************************************************************************************/
+
+static_assert(
+    (SENSOR_TRACE_BUFFER_LENGTH & (SENSOR_TRACE_BUFFER_LENGTH - 1U)) == 0U,
+    "SENSOR_TRACE_BUFFER_LENGTH must be a power of two");
+
+#define BUFFER_MASK (SENSOR_TRACE_BUFFER_LENGTH - 1U)
+
+#define VARINT_MAX_LEN_64 10U
+#define VARINT_MAX_LEN_32 5U
+
+/**************************************************************************************************\
+* Private prototypes
+\**************************************************************************************************/
+
+static size_t put_varint(uint8_t *buffer, uint64_t value);
+static bool get_varint(Sensor_Trace_Reader_T *reader, uint8_t max_len, uint64_t *value);
+static void buffer_put(const uint8_t *data, size_t length);
+
+/**************************************************************************************************\
+* Private memory declarations
+\**************************************************************************************************/
+
+// The buffer has several producers, the sensor interrupts and AOs, so both ends are moved inside
+// a critical section. The indexes are free running.
+static uint8_t s_buffer[SENSOR_TRACE_BUFFER_LENGTH];
+static uint32_t s_head;
+static uint32_t s_tail;
+
+static volatile bool s_recording;
+static uint64_t s_last_us;      // of the last record in the buffer
+static uint32_t s_pending_lost; // dropped since, written as a SENSOR_TRACE_LOST record
+static uint32_t s_last_gpio;
+static bool s_gpio_recorded;
+
+static Sensor_Trace_Stats_T s_stats;
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+size_t Sensor_Trace_Encode_Header(uint8_t *buffer)
+{
+    memcpy(buffer, SENSOR_TRACE_MAGIC, SENSOR_TRACE_MAGIC_LEN);
+    buffer[SENSOR_TRACE_MAGIC_LEN] = SENSOR_TRACE_VERSION;
+    return SENSOR_TRACE_HEADER_LEN;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Encode one record into buffer, which must have room for SENSOR_TRACE_RECORD_MAX_LEN
+ *          bytes, and return its length
+ **************************************************************************************************/
+size_t Sensor_Trace_Encode_Record(
+    uint8_t *buffer, Sensor_Trace_Type_T type, uint64_t delta_us, uint32_t value)
+{
+    size_t length = 0U;
+
+    buffer[length++] = (uint8_t) type;
+    length += put_varint(&buffer[length], delta_us);
+    length += put_varint(&buffer[length], value);
+
+    return length;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Start reading a whole trace, false if it doesn't begin with a header of this version
+ **************************************************************************************************/
+bool Sensor_Trace_Reader_Init(Sensor_Trace_Reader_T *reader, const uint8_t *data, size_t length)
+{
+    reader->data         = data;
+    reader->length       = length;
+    reader->position     = SENSOR_TRACE_HEADER_LEN;
+    reader->timestamp_us = 0U;
+    reader->corrupt      = false;
+
+    return (length >= SENSOR_TRACE_HEADER_LEN) &&
+        (memcmp(data, SENSOR_TRACE_MAGIC, SENSOR_TRACE_MAGIC_LEN) == 0) &&
+        (data[SENSOR_TRACE_MAGIC_LEN] == SENSOR_TRACE_VERSION);
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   The next record, false at the end of the trace. A record that is cut short or of an
+ *          unknown type also ends it, with reader->corrupt set.
+ **************************************************************************************************/
+bool Sensor_Trace_Reader_Next(Sensor_Trace_Reader_T *reader, Sensor_Trace_Record_T *record)
+{
+    uint64_t delta_us;
+    uint64_t value;
+
+    if (reader->corrupt || (reader->position >= reader->length))
+    {
+        return false;
+    }
+
+    uint8_t type = reader->data[reader->position++];
+    if (
+        (type == 0U) || (type >= (uint8_t) SENSOR_TRACE_TYPE_COUNT) ||
+        !get_varint(reader, VARINT_MAX_LEN_64, &delta_us) ||
+        !get_varint(reader, VARINT_MAX_LEN_32, &value) || (value > UINT32_MAX))
+    {
+        reader->corrupt = true;
+        return false;
+    }
+
+    reader->timestamp_us += delta_us;
+    record->type         = (Sensor_Trace_Type_T) type;
+    record->timestamp_us = reader->timestamp_us;
+    record->value        = (uint32_t) value;
+
+    return true;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Throw away what is left of the last trace and start a new one, from its header
+ **************************************************************************************************/
+void Sensor_Trace_Start(void)
+{
+    uint8_t header[SENSOR_TRACE_HEADER_LEN];
+    size_t length   = Sensor_Trace_Encode_Header(header);
+    uint64_t now_us = BSP_Get_Microseconds();
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    s_head          = 0U;
+    s_tail          = 0U;
+    s_last_us       = now_us;
+    s_pending_lost  = 0U;
+    s_gpio_recorded = false;
+    memset(&s_stats, 0, sizeof(s_stats));
+    buffer_put(header, length);
+    s_recording = true;
+    QF_CRIT_EXIT();
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Stop recording, what is in the buffer can still be read
+ **************************************************************************************************/
+void Sensor_Trace_Stop(void)
+{
+    s_recording = false;
+}
+
+bool Sensor_Trace_Is_Recording(void)
+{
+    return s_recording;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Record a sensor input, stamped now. Does nothing unless a trace is being recorded, and
+ *          a GPIO record only goes in when the flags changed. When the buffer is full the record
+ *          is dropped and counted, and the count goes in before the next one that fits.
+ **************************************************************************************************/
+void Sensor_Trace_Record(Sensor_Trace_Type_T type, uint32_t value)
+{
+    uint8_t record[2U * SENSOR_TRACE_RECORD_MAX_LEN];
+
+    if (!s_recording)
+    {
+        return;
+    }
+
+    uint64_t now_us = BSP_Get_Microseconds();
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    if (s_recording && !((type == SENSOR_TRACE_GPIO) && s_gpio_recorded && (value == s_last_gpio)))
+    {
+        // an interrupt may have recorded between reading the time and getting here
+        uint64_t delta_us = (now_us > s_last_us) ? (now_us - s_last_us) : 0U;
+        size_t length     = 0U;
+
+        if (s_pending_lost > 0U)
+        {
+            length = Sensor_Trace_Encode_Record(
+                record, SENSOR_TRACE_LOST, delta_us, s_pending_lost);
+            delta_us = 0U;
+        }
+        length += Sensor_Trace_Encode_Record(&record[length], type, delta_us, value);
+
+        if (length <= (SENSOR_TRACE_BUFFER_LENGTH - (s_head - s_tail)))
+        {
+            buffer_put(record, length);
+            s_last_us      = (now_us > s_last_us) ? now_us : s_last_us;
+            s_pending_lost = 0U;
+            s_stats.records++;
+            if (type == SENSOR_TRACE_GPIO)
+            {
+                s_last_gpio     = value;
+                s_gpio_recorded = true;
+            }
+        }
+        else
+        {
+            s_pending_lost++;
+            s_stats.lost++;
+        }
+    }
+    QF_CRIT_EXIT();
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Take up to size bytes of the trace out of the buffer, records may be split between
+ *          reads
+ **************************************************************************************************/
+size_t Sensor_Trace_Read(uint8_t *buffer, size_t size)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    size_t length = s_head - s_tail;
+    if (length > size)
+    {
+        length = size;
+    }
+
+    size_t first = SENSOR_TRACE_BUFFER_LENGTH - (s_tail & BUFFER_MASK);
+    if (first > length)
+    {
+        first = length;
+    }
+    memcpy(buffer, &s_buffer[s_tail & BUFFER_MASK], first);
+    memcpy(&buffer[first], s_buffer, length - first);
+    s_tail += (uint32_t) length;
+    QF_CRIT_EXIT();
+
+    return length;
+}
+
+void Sensor_Trace_Get_Stats(Sensor_Trace_Stats_T *stats)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    *stats = s_stats;
+    QF_CRIT_EXIT();
+}
+
+/**************************************************************************************************\
+* Private functions
+\**************************************************************************************************/
+
+static size_t put_varint(uint8_t *buffer, uint64_t value)
+{
+    size_t length = 0U;
+
+    while (value >= 0x80U)
+    {
+        buffer[length++] = (uint8_t) (value | 0x80U);
+        value >>= 7U;
+    }
+    buffer[length++] = (uint8_t) value;
+
+    return length;
+}
+
+static bool get_varint(Sensor_Trace_Reader_T *reader, uint8_t max_len, uint64_t *value)
+{
+    *value = 0U;
+
+    for (uint8_t i = 0U; i < max_len; i++)
+    {
+        if (reader->position >= reader->length)
+        {
+            return false;
+        }
+
+        uint8_t byte = reader->data[reader->position++];
+        *value |= (uint64_t) (byte & 0x7FU) << (7U * i);
+        if ((byte & 0x80U) == 0U)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// with the critical section held, the caller checked for room
+static void buffer_put(const uint8_t *data, size_t length)
+{
+    for (size_t i = 0U; i < length; i++)
+    {
+        s_buffer[(s_head + i) & BUFFER_MASK] = data[i];
+    }
+    s_head += (uint32_t) length;
+
+    uint32_t used = s_head - s_tail;
+    if (used > s_stats.high_water)
+    {
+        s_stats.high_water = used;
+    }
+}
@@ -0,0 +1,101 @@
+#ifndef SENSOR_TRACE_H_
+#define SENSOR_TRACE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************************************************\
+* Public macros
+\**************************************************************************************************/
+
+// A sensor trace is the raw inputs of the motor's sensors as they arrived, recorded on the board,
+// streamed to the PC over pc_com and replayed into the host simulation ("Sensor Traces" in the
+// README). It starts with a header, the magic and the version, followed by records: a type
+// byte, then the microseconds since the previous record and the value, both LEB128 varints.
+#define SENSOR_TRACE_MAGIC          "BMST"
+#define SENSOR_TRACE_MAGIC_LEN      4U
+#define SENSOR_TRACE_VERSION        1U
+#define SENSOR_TRACE_HEADER_LEN     (SENSOR_TRACE_MAGIC_LEN + 1U)
+#define SENSOR_TRACE_RECORD_MAX_LEN (1U + 10U + 5U) // type, 64 bit delta, 32 bit value
+
+// GPIO record value, the inputs the Director samples
+#define SENSOR_TRACE_GPIO_NEUTRAL   (1U << 0)
+#define SENSOR_TRACE_GPIO_START     (1U << 1)
+#define SENSOR_TRACE_GPIO_TEMP_GOOD (1U << 2)
+#define SENSOR_TRACE_GPIO_PRES_GOOD (1U << 3)
+#define SENSOR_TRACE_GPIO_BUZZER    (1U << 4)
+
+// VBAT record value, the mean of a block in 1 / SENSOR_TRACE_VBAT_SCALE ADC counts
+#define SENSOR_TRACE_VBAT_SCALE 16U
+
+// bytes of trace waiting for PC_COM on the board, must be a power of two
+#ifndef SENSOR_TRACE_BUFFER_LENGTH
+#define SENSOR_TRACE_BUFFER_LENGTH 4096U
+#endif
+
+/**************************************************************************************************\
+* Public type definitions
+\**************************************************************************************************/
+typedef enum
+{
+    SENSOR_TRACE_TACH_PERIOD = 1, // tach input capture, the period in 0.5 us TIM15 ticks
+    SENSOR_TRACE_LMT01_COUNT,     // the pulses of one LMT01 conversion
+    SENSOR_TRACE_PRESSURE_COUNTS, // the MPRLS bridge output, 24 bits
+    SENSOR_TRACE_VBAT_MEAN,       // one VBAT ADC block, see SENSOR_TRACE_VBAT_SCALE
+    SENSOR_TRACE_GPIO,            // SENSOR_TRACE_GPIO_* flags, recorded when they change
+    SENSOR_TRACE_LOST,            // records dropped before this one, the buffer was full
+    SENSOR_TRACE_TYPE_COUNT,
+} Sensor_Trace_Type_T;
+
+typedef struct
+{
+    Sensor_Trace_Type_T type;
+    uint64_t timestamp_us; // since the start of the trace
+    uint32_t value;
+} Sensor_Trace_Record_T;
+
+// walks through a whole trace in memory
+typedef struct
+{
+    const uint8_t *data;
+    size_t length;
+    size_t position;
+    uint64_t timestamp_us;
+    bool corrupt; // stopped on a record that is cut short or of an unknown type
+} Sensor_Trace_Reader_T;
+
+typedef struct
+{
+    uint32_t records;    // recorded since the trace started
+    uint32_t lost;       // dropped because the buffer was full
+    uint32_t high_water; // most bytes ever waiting in the buffer
+} Sensor_Trace_Stats_T;
+
+/**************************************************************************************************\
+* Public prototypes
+\**************************************************************************************************/
+
+// the format
+size_t Sensor_Trace_Encode_Header(uint8_t *buffer);
+size_t Sensor_Trace_Encode_Record(
+    uint8_t *buffer, Sensor_Trace_Type_T type, uint64_t delta_us, uint32_t value);
+bool Sensor_Trace_Reader_Init(Sensor_Trace_Reader_T *reader, const uint8_t *data, size_t length);
+bool Sensor_Trace_Reader_Next(Sensor_Trace_Reader_T *reader, Sensor_Trace_Record_T *record);
+
+// the recorder on the board, Sensor_Trace_Record() from any context, interrupts included
+void Sensor_Trace_Start(void);
+void Sensor_Trace_Stop(void);
+bool Sensor_Trace_Is_Recording(void);
+void Sensor_Trace_Record(Sensor_Trace_Type_T type, uint32_t value);
+size_t Sensor_Trace_Read(uint8_t *buffer, size_t size);
+void Sensor_Trace_Get_Stats(Sensor_Trace_Stats_T *stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // SENSOR_TRACE_H_
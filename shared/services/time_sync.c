@@ -0,0 +1,102 @@
+#include "time_sync.h"
+#include <string.h>
+
+/**************************************************************************************************\
+* Private macros
+\**************************************************************************************************/
+#define PPB 1000000000LL // parts per billion
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+void Time_Sync_Init(Time_Sync_T *sync)
+{
+    memset(sync, 0, sizeof(*sync));
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Add an exchange: the request sent at t1 and received at t2, the response sent at t3 and
+ *          received at t4. t1 and t4 are on the local clock, t2 and t3 on the remote one.
+ *          The link is taken as symmetric, the offset is the mean of what each direction sees.
+ *          Returns false if the exchange was rejected.
+ **************************************************************************************************/
+bool Time_Sync_Add_Exchange(
+    Time_Sync_T *sync,
+    uint64_t request_tx_us,
+    uint64_t request_rx_us,
+    uint64_t response_tx_us,
+    uint64_t response_rx_us)
+{
+    int64_t round_trip_us = (int64_t) (response_rx_us - request_tx_us) -
+                            (int64_t) (response_tx_us - request_rx_us);
+    if ((round_trip_us < -TIME_SYNC_MAX_ROUND_TRIP_US) ||
+        (round_trip_us > TIME_SYNC_MAX_ROUND_TRIP_US))
+    {
+        sync->rejected++;
+        return false;
+    }
+
+    int64_t measured_us = ((int64_t) (request_rx_us - request_tx_us) +
+                           (int64_t) (response_tx_us - response_rx_us)) /
+                          2;
+
+    int64_t error_us = measured_us;
+    if (sync->synced)
+    {
+        error_us = measured_us - Time_Sync_Offset_At(sync, response_rx_us);
+    }
+
+    if (!sync->synced || (error_us < -TIME_SYNC_STEP_US) || (error_us > TIME_SYNC_STEP_US))
+    {
+        if (sync->synced)
+        {
+            sync->steps++;
+        }
+        sync->offset_us = measured_us;
+        sync->drift_ppb = 0;
+    }
+    else
+    {
+        // the drift comes from the raw measurements, the filtered offset lags behind them
+        int64_t elapsed_us = (int64_t) (response_rx_us - sync->ref_local_us);
+        if (elapsed_us > 0)
+        {
+            int64_t drift_ppb = ((measured_us - sync->last_measured_us) * PPB) / elapsed_us;
+            sync->drift_ppb += (int32_t) ((drift_ppb - sync->drift_ppb) /
+                                          (1 << TIME_SYNC_DRIFT_GAIN_SHIFT));
+        }
+
+        sync->offset_us = Time_Sync_Offset_At(sync, response_rx_us) +
+                          (error_us / (1 << TIME_SYNC_OFFSET_GAIN_SHIFT));
+    }
+
+    sync->synced           = true;
+    sync->ref_local_us     = response_rx_us;
+    sync->last_measured_us = measured_us;
+    sync->round_trip_us    = (int32_t) round_trip_us;
+    sync->exchanges++;
+
+    return true;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Remote clock - local clock at the given local time, with the drift since the last
+ *          exchange
+ **************************************************************************************************/
+int64_t Time_Sync_Offset_At(const Time_Sync_T *sync, uint64_t local_us)
+{
+    int64_t elapsed_us = (int64_t) (local_us - sync->ref_local_us);
+
+    return sync->offset_us + ((sync->drift_ppb * elapsed_us) / PPB);
+}
+
+uint64_t Time_Sync_Remote_To_Local(const Time_Sync_T *sync, uint64_t remote_us)
+{
+    // the offset is a function of local time, the first guess is close enough for the drift
+    uint64_t local_us = remote_us - (uint64_t) sync->offset_us;
+
+    return remote_us - (uint64_t) Time_Sync_Offset_At(sync, local_us);
+}
@@ -0,0 +1,60 @@
+#ifndef TIME_SYNC_H_
+#define TIME_SYNC_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************************************************\
+* Public macros
+\**************************************************************************************************/
+
+// Both ends of an exchange are stamped by the FDCAN at the start of frame, so the round trip is
+// only the stamps' error, a few counter ticks. More than this and a stamp is wrong.
+#define TIME_SYNC_MAX_ROUND_TRIP_US 100
+
+// an offset this far from the prediction is the other board restarting its clock, not drift
+#define TIME_SYNC_STEP_US 1000
+
+// share of a new measurement taken into the estimates, as a right shift
+#define TIME_SYNC_OFFSET_GAIN_SHIFT 1U
+#define TIME_SYNC_DRIFT_GAIN_SHIFT  2U
+
+/**************************************************************************************************\
+* Public type definitions
+\**************************************************************************************************/
+
+// Remote clock = local clock + offset_us + drift_ppb * (local clock - ref_local_us) / 10^9
+typedef struct
+{
+    bool synced;              // at least one exchange accepted
+    int64_t offset_us;        // remote - local at ref_local_us
+    uint64_t ref_local_us;    // local time of the last accepted exchange
+    int32_t drift_ppb;        // how much faster the remote clock runs, parts per billion
+    int32_t round_trip_us;    // of the last accepted exchange, without the remote's turnaround
+    int64_t last_measured_us; // offset measured by the last accepted exchange, for the drift
+    uint32_t exchanges;       // accepted
+    uint32_t rejected;        // round trip out of range
+    uint32_t steps;           // restarts of the estimate
+} Time_Sync_T;
+
+/**************************************************************************************************\
+* Public prototypes
+\**************************************************************************************************/
+void Time_Sync_Init(Time_Sync_T *sync);
+bool Time_Sync_Add_Exchange(
+    Time_Sync_T *sync,
+    uint64_t request_tx_us,
+    uint64_t request_rx_us,
+    uint64_t response_tx_us,
+    uint64_t response_rx_us);
+int64_t Time_Sync_Offset_At(const Time_Sync_T *sync, uint64_t local_us);
+uint64_t Time_Sync_Remote_To_Local(const Time_Sync_T *sync, uint64_t remote_us);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // TIME_SYNC_H_
@@ -0,0 +1,740 @@
+#include "sim.h"
+#include "bsp.h"
+#include "cpu_load.h"
+#include "qpc.h"
+#include "reset.h"
+#include "stm32g4xx_hal.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+Q_DEFINE_THIS_MODULE("sim.c")
+
+/**************************************************************************************************\
+* Private macros
+\**************************************************************************************************/
+
+#define SIM_MAX_INTERRUPTS       8U
+#define SIM_BACKUP_RAM_WORDS     32U              // TAMP BKP0R..BKP31R
+#define SIM_CATCH_UP_LIMIT_NS    100000000ULL     // 100 ms of missed timer periods
+#define SIM_STATUS_PERIOD_NS     1000000000ULL    // every second of real time
+#define SIM_VIRTUAL_STATUS_NS    3600000000000ULL // every simulated hour in virtual time
+#define SIM_SOFT_RESET_ENV       "BOAT_SIM_SOFT_RESET" // set across the exec of a software reset
+
+// RCC CSR reset flags, as in reset.c
+#define SIM_RCC_CSR_BORRSTF (1UL << 25U)
+#define SIM_RCC_CSR_PINRSTF (1UL << 26U)
+#define SIM_RCC_CSR_PORRSTF (1UL << 27U)
+#define SIM_RCC_CSR_SFTRSTF (1UL << 28U)
+
+/**************************************************************************************************\
+* Private type definitions
+\**************************************************************************************************/
+
+typedef struct
+{
+    const char *name;
+    void *(*thread)(void *);
+    void *arg;
+} Sim_Interrupt_T;
+
+typedef struct
+{
+    Sim_Timer_T timer; // first, the handler finds the rest from it
+    uint64_t period_ns;
+    Sim_Isr_T handler;
+} Sim_Periodic_T;
+
+/**************************************************************************************************\
+* Private prototypes
+\**************************************************************************************************/
+
+static void start_thread(const Sim_Interrupt_T *interrupt);
+static void *timer_thread(void *arg);
+static void run_timer(Sim_Timer_T *timer);
+static void unlink_timer(Sim_Timer_T *timer);
+static void periodic_handler(Sim_Timer_T *timer);
+static void sys_tick_handler(void);
+static void status_handler(Sim_Timer_T *timer);
+static void end_handler(Sim_Timer_T *timer);
+static void *power_thread(void *arg);
+static bool parse_duration(const char *text, uint64_t *duration_ns);
+static void usage(const char *program);
+
+/**************************************************************************************************\
+* Private memory declarations
+\**************************************************************************************************/
+
+static const char *const s_board_names[] = {"motor", "gauge"};
+
+static Sim_Board_T s_board;
+static const char *s_state_dir = ".";
+static uint16_t s_can_port_base = SIM_CAN_UDP_PORT_DEFAULT;
+static bool s_quiet;
+static bool s_virtual;
+static uint64_t s_duration_ns; // 0: until powered off
+static uint64_t s_random = 1U; // --seed, xorshift64* state
+static const char *s_replay_path;
+static char **s_argv;          // for the exec of a software reset
+
+static struct timespec s_power_on;
+static uint64_t s_virtual_ns;       // Sim_Now_Ns() in virtual time, moved on by the idle loop
+static volatile uint32_t s_ms_tick; // HAL_GetTick(), counted by the SysTick handler
+
+static Sim_Interrupt_T s_interrupts[SIM_MAX_INTERRUPTS];
+static Sim_Periodic_T s_periodics[SIM_MAX_INTERRUPTS];
+static uint32_t s_interrupt_count;
+static uint32_t s_periodic_count;
+static bool s_interrupts_enabled; // QF_onStartup() ran
+
+// the armed timers, soonest first; taken inside the critical section, never around it
+static pthread_mutex_t s_timer_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_timer_wake;
+static Sim_Timer_T *s_timers;
+static uint64_t s_timer_interrupts;
+
+static Sim_Timer_T s_status_timer;
+static Sim_Timer_T s_end_timer;
+
+static uint32_t *s_backup_ram; // mapped from <board>-backup-ram.bin
+static uint32_t s_rcc_csr;
+static bool s_led;
+
+// what reset.c's jump into the ROM bootloader writes, never reached in the simulation
+SCB_Type Sim_SCB;
+SYSCFG_TypeDef Sim_SYSCFG;
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+void Sim_Init(int argc, char *argv[], Sim_Board_T board)
+{
+    static const struct option options[] = {
+        {"state-dir", required_argument, NULL, 'd'},
+        {"can-port", required_argument, NULL, 'p'},
+        {"quiet", no_argument, NULL, 'q'},
+        {"virtual-time", no_argument, NULL, 'v'},
+        {"duration", required_argument, NULL, 't'},
+        {"seed", required_argument, NULL, 's'},
+        {"replay", required_argument, NULL, 'r'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+
+    clock_gettime(CLOCK_MONOTONIC, &s_power_on);
+    s_board = board;
+    s_argv  = argv;
+
+    int option;
+    while ((option = getopt_long(argc, argv, "d:p:qvt:s:r:h", options, NULL)) != -1)
+    {
+        switch (option)
+        {
+            case 'd':
+                s_state_dir = optarg;
+                break;
+            case 'p':
+                s_can_port_base = (uint16_t) strtoul(optarg, NULL, 0);
+                break;
+            case 'q':
+                s_quiet = true;
+                break;
+            case 'v':
+                s_virtual = true;
+                break;
+            case 't':
+                if (!parse_duration(optarg, &s_duration_ns))
+                {
+                    usage(argv[0]);
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 's':
+                // xorshift64* stays at 0 from 0, any other seed is fine
+                s_random = strtoull(optarg, NULL, 0);
+                s_random = (s_random != 0U) ? s_random : 1U;
+                break;
+            case 'r':
+                s_replay_path = optarg;
+                break;
+            default:
+                usage(argv[0]);
+                exit(option == 'h' ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+    }
+
+    if ((s_replay_path != NULL) && (board != SIM_BOARD_MOTOR))
+    {
+        fprintf(stderr, "%s: only the motor has sensors to replay\n", Sim_Board_Name());
+        exit(EXIT_FAILURE);
+    }
+
+    // a software reset comes back through exec, anything else is a power on
+    if (getenv(SIM_SOFT_RESET_ENV) != NULL)
+    {
+        s_rcc_csr = SIM_RCC_CSR_SFTRSTF | SIM_RCC_CSR_PINRSTF;
+        unsetenv(SIM_SOFT_RESET_ENV);
+    }
+    else
+    {
+        s_rcc_csr = SIM_RCC_CSR_BORRSTF | SIM_RCC_CSR_PINRSTF | SIM_RCC_CSR_PORRSTF;
+    }
+
+    // the backup RAM survives resets in a file, mapped so a crash doesn't lose a write
+    char path[256];
+    Sim_State_Path(path, sizeof(path), "backup-ram.bin");
+    int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if ((fd < 0) || (ftruncate(fd, SIM_BACKUP_RAM_WORDS * sizeof(uint32_t)) != 0))
+    {
+        fprintf(stderr, "%s: %s: %s\n", Sim_Board_Name(), path, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    s_backup_ram = mmap(
+        NULL, SIM_BACKUP_RAM_WORDS * sizeof(uint32_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    Q_ASSERT(s_backup_ram != MAP_FAILED);
+    close(fd);
+
+    // SIGINT and SIGTERM only go to the power thread, no peripheral thread is interrupted
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, NULL);
+
+    static const Sim_Interrupt_T power = {"power", power_thread, NULL};
+    start_thread(&power);
+
+    // the timer thread sleeps until a time of Sim_Host_Ns()
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&s_timer_wake, &attr);
+    pthread_condattr_destroy(&attr);
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    Sim_Add_Periodic_Interrupt("SysTick", 1000000U / BSP_TICKS_PER_SEC, sys_tick_handler);
+}
+
+const char *Sim_Board_Name(void)
+{
+    return s_board_names[s_board];
+}
+
+void Sim_State_Path(char *path, size_t size, const char *name)
+{
+    snprintf(path, size, "%s/%s-%s", s_state_dir, Sim_Board_Name(), name);
+}
+
+uint16_t Sim_CAN_Port(void)
+{
+    return (uint16_t) (s_can_port_base + (uint16_t) s_board);
+}
+
+uint16_t Sim_CAN_Peer_Port(void)
+{
+    return (uint16_t) (s_can_port_base + (uint16_t) (s_board ^ 1U));
+}
+
+bool Sim_Virtual_Time(void)
+{
+    return s_virtual;
+}
+
+uint64_t Sim_Now_Ns(void)
+{
+    return s_virtual ? s_virtual_ns : Sim_Host_Ns();
+}
+
+uint64_t Sim_Host_Ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t) (now.tv_sec - s_power_on.tv_sec) * 1000000000ULL) +
+           (uint64_t) now.tv_nsec - (uint64_t) s_power_on.tv_nsec;
+}
+
+const char *Sim_Replay_Path(void)
+{
+    return s_replay_path;
+}
+
+uint32_t Sim_Random(void)
+{
+    s_random ^= s_random >> 12;
+    s_random ^= s_random << 25;
+    s_random ^= s_random >> 27;
+    return (uint32_t) ((s_random * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+void Sim_Power_Off(void)
+{
+    fprintf(stderr, "%s: power off\n", Sim_Board_Name());
+    Sim_Report();
+    exit(EXIT_SUCCESS);
+}
+
+uint64_t Sim_Timer_Interrupts(void)
+{
+    return s_timer_interrupts;
+}
+
+void Sim_Add_Interrupt(const char *name, void *(*thread)(void *), void *arg)
+{
+    Q_ASSERT(s_interrupt_count < SIM_MAX_INTERRUPTS);
+
+    Sim_Interrupt_T *interrupt = &s_interrupts[s_interrupt_count++];
+    interrupt->name            = name;
+    interrupt->thread          = thread;
+    interrupt->arg             = arg;
+
+    if (s_interrupts_enabled && !s_virtual)
+    {
+        start_thread(interrupt);
+    }
+}
+
+void Sim_Add_Periodic_Interrupt(const char *name, uint32_t period_us, Sim_Isr_T handler)
+{
+    Q_ASSERT(s_periodic_count < SIM_MAX_INTERRUPTS);
+
+    Sim_Periodic_T *periodic = &s_periodics[s_periodic_count++];
+    periodic->period_ns      = (uint64_t) period_us * 1000U;
+    periodic->handler        = handler;
+
+    Sim_Timer_Init(&periodic->timer, name, periodic_handler);
+    Sim_Timer_Arm(&periodic->timer, Sim_Now_Ns() + periodic->period_ns);
+}
+
+void Sim_Timer_Init(Sim_Timer_T *timer, const char *name, Sim_Timer_Handler_T handler)
+{
+    timer->name    = name;
+    timer->handler = handler;
+    timer->armed   = false;
+    timer->next    = NULL;
+}
+
+void Sim_Timer_Arm(Sim_Timer_T *timer, uint64_t due_ns)
+{
+    pthread_mutex_lock(&s_timer_mutex);
+    unlink_timer(timer);
+
+    timer->due_ns = due_ns;
+    timer->armed  = true;
+
+    // after every timer due at the same time or sooner, those run in the order they were armed
+    Sim_Timer_T **link = &s_timers;
+    while ((*link != NULL) && ((*link)->due_ns <= due_ns))
+    {
+        link = &(*link)->next;
+    }
+    timer->next = *link;
+    *link       = timer;
+
+    if (s_timers == timer)
+    {
+        pthread_cond_signal(&s_timer_wake);
+    }
+    pthread_mutex_unlock(&s_timer_mutex);
+}
+
+void Sim_Timer_Disarm(Sim_Timer_T *timer)
+{
+    pthread_mutex_lock(&s_timer_mutex);
+    unlink_timer(timer);
+    pthread_mutex_unlock(&s_timer_mutex);
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   The DWT cycle counter, at SIM_CORE_CLOCK_HZ from power on
+ **************************************************************************************************/
+void BSP_Cycle_Counter_Init(void)
+{
+}
+
+uint32_t BSP_Get_Cycle_Count(void)
+{
+    return (uint32_t) BSP_Get_Cycle_Count_64();
+}
+
+uint64_t BSP_Get_Cycle_Count_64(void)
+{
+    return (Sim_Now_Ns() * (SIM_CORE_CLOCK_HZ / 1000000U)) / 1000U;
+}
+
+uint64_t BSP_Get_Microseconds(void)
+{
+    return Sim_Now_Ns() / 1000U;
+}
+
+uint32_t BSP_Get_Milliseconds_Tick(void)
+{
+    return s_ms_tick;
+}
+
+void BSP_LED_On(void)
+{
+    s_led = true;
+}
+
+void BSP_LED_Off(void)
+{
+    s_led = false;
+}
+
+void BSP_LED_Toggle(void)
+{
+    s_led = !s_led;
+}
+
+void BSP_LED2_Toggle(void)
+{
+}
+
+void BSP_terminate(int16_t result)
+{
+    Q_UNUSED_PAR(result);
+}
+
+bool BSP_Backup_RAM_Read(int index, uint32_t *output)
+{
+    if ((index < 0) || (index >= (int) SIM_BACKUP_RAM_WORDS) || (output == NULL))
+    {
+        return false;
+    }
+
+    *output = s_backup_ram[index];
+    return true;
+}
+
+void BSP_Backup_RAM_Write(int index, uint32_t value)
+{
+    Q_ASSERT((index >= 0) && (index < (int) SIM_BACKUP_RAM_WORDS));
+    s_backup_ram[index] = value;
+}
+
+uint32_t BSP_RCC_CSR_Read(void)
+{
+    return s_rcc_csr;
+}
+
+void BSP_RCC_CSR_ClearResetFlags(void)
+{
+    s_rcc_csr = 0U;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Run the program again, with the backup RAM and FRAM image as they are. Every file and
+ *          socket is opened close-on-exec, the PTYs come back under the same links.
+ **************************************************************************************************/
+__attribute__((noreturn)) void BSP_SystemReset(void)
+{
+    fprintf(stderr, "%s: reset\n", Sim_Board_Name());
+    fflush(NULL);
+
+    setenv(SIM_SOFT_RESET_ENV, "1", 1);
+    execv("/proc/self/exe", s_argv);
+
+    fprintf(stderr, "%s: reset failed: %s\n", Sim_Board_Name(), strerror(errno));
+    _exit(EXIT_FAILURE);
+}
+
+Q_NORETURN Q_onError(char const *const module, int_t const loc)
+{
+    fprintf(stderr, "%s: Q_onError %s:%d\n", Sim_Board_Name(), module, (int) loc);
+
+    const uint32_t NOT_USED = 0;
+    Reset_DoResetWithReasonWithStr(RESET_REASON_Q_ASSERT, module, loc, NOT_USED);
+}
+
+void assert_failed(char const *const module, int_t const id); // prototype
+void assert_failed(char const *const module, int_t const id)
+{
+    Q_onError(module, id);
+}
+
+//============================================================================
+// QF callbacks...
+void QF_onStartup(void)
+{
+    // interrupts are enabled from here on, as when QF_run() starts on the board
+    s_interrupts_enabled = true;
+
+    if (!s_quiet)
+    {
+        Sim_Timer_Init(&s_status_timer, "status", status_handler);
+        Sim_Timer_Arm(&s_status_timer, s_virtual ? SIM_VIRTUAL_STATUS_NS : SIM_STATUS_PERIOD_NS);
+    }
+    if (s_duration_ns != 0U)
+    {
+        Sim_Timer_Init(&s_end_timer, "end", end_handler);
+        Sim_Timer_Arm(&s_end_timer, s_duration_ns);
+    }
+
+    // in virtual time the idle loop runs the timers, and nothing comes from outside
+    if (!s_virtual)
+    {
+        for (uint32_t i = 0U; i < s_interrupt_count; i++)
+        {
+            start_thread(&s_interrupts[i]);
+        }
+
+        static const Sim_Interrupt_T timers = {"timers", timer_thread, NULL};
+        start_thread(&timers);
+    }
+}
+//............................................................................
+void QF_onCleanup(void)
+{
+}
+//............................................................................
+void QV_onIdle(void)
+{ // called with interrupts DISABLED, returns with them enabled
+    uint32_t start = BSP_Get_Cycle_Count();
+
+    if (s_virtual)
+    {
+        // no time passes while the AOs run, what happens next is the next timer interrupt
+        pthread_mutex_lock(&s_timer_mutex);
+        Sim_Timer_T *timer = s_timers;
+        Q_ASSERT(timer != NULL); // SysTick is always armed
+        unlink_timer(timer);
+        s_virtual_ns = timer->due_ns;
+        pthread_mutex_unlock(&s_timer_mutex);
+
+        CPU_Load_Idle(start, BSP_Get_Cycle_Count());
+        run_timer(timer);
+        QF_INT_ENABLE();
+    }
+    else
+    {
+        // the interrupt that woke it has run by now, and is counted in as idle
+        QV_CPU_SLEEP();
+        QF_INT_DISABLE();
+        CPU_Load_Idle(start, BSP_Get_Cycle_Count());
+        QF_INT_ENABLE();
+    }
+}
+
+/**************************************************************************************************\
+* Private functions
+\**************************************************************************************************/
+
+static void start_thread(const Sim_Interrupt_T *interrupt)
+{
+    pthread_t thread;
+
+    int error = pthread_create(&thread, NULL, interrupt->thread, interrupt->arg);
+    Q_ASSERT(error == 0);
+
+    (void) pthread_setname_np(thread, interrupt->name);
+    (void) pthread_detach(thread);
+}
+
+// in real time, every timer interrupt as it comes due, one at a time
+static void *timer_thread(void *arg)
+{
+    (void) arg;
+
+    pthread_mutex_lock(&s_timer_mutex);
+    for (;;)
+    {
+        Sim_Timer_T *timer = s_timers;
+        if (timer == NULL)
+        {
+            pthread_cond_wait(&s_timer_wake, &s_timer_mutex);
+        }
+        else if (Sim_Host_Ns() < timer->due_ns)
+        {
+            uint64_t ns           = (uint64_t) s_power_on.tv_nsec + timer->due_ns;
+            struct timespec until = {
+                .tv_sec  = s_power_on.tv_sec + (time_t) (ns / 1000000000ULL),
+                .tv_nsec = (long) (ns % 1000000000ULL),
+            };
+            (void) pthread_cond_timedwait(&s_timer_wake, &s_timer_mutex, &until);
+        }
+        else
+        {
+            unlink_timer(timer);
+            pthread_mutex_unlock(&s_timer_mutex);
+
+            run_timer(timer);
+
+            pthread_mutex_lock(&s_timer_mutex);
+        }
+    }
+
+    return NULL;
+}
+
+static void run_timer(Sim_Timer_T *timer)
+{
+    QV_ISR_ENTRY();
+    s_timer_interrupts++;
+    timer->handler(timer);
+    QV_ISR_EXIT();
+}
+
+// with s_timer_mutex
+static void unlink_timer(Sim_Timer_T *timer)
+{
+    if (timer->armed)
+    {
+        Sim_Timer_T **link = &s_timers;
+        while (*link != timer)
+        {
+            link = &(*link)->next;
+        }
+        *link        = timer->next;
+        timer->armed = false;
+    }
+}
+
+static void periodic_handler(Sim_Timer_T *timer)
+{
+    Sim_Periodic_T *periodic = (Sim_Periodic_T *) timer;
+    uint64_t next_ns         = timer->due_ns + periodic->period_ns;
+
+    if (Sim_Now_Ns() > (next_ns + SIM_CATCH_UP_LIMIT_NS))
+    {
+        // the host stopped us (a debugger, suspended), don't replay all of it at once
+        next_ns = Sim_Now_Ns() + periodic->period_ns;
+    }
+    Sim_Timer_Arm(timer, next_ns);
+
+    periodic->handler();
+}
+
+static void sys_tick_handler(void)
+{
+    s_ms_tick++;
+    CPU_Load_Tick();   // close a CPU load window every 100 ms
+    QTIMEEVT_TICK(0U); // process time events for primary clock rate
+}
+
+static void status_handler(Sim_Timer_T *timer)
+{
+    char board_status[160];
+    Sim_CAN_Stats_T can;
+
+    Sim_Timer_Arm(
+        timer, timer->due_ns + (s_virtual ? SIM_VIRTUAL_STATUS_NS : SIM_STATUS_PERIOD_NS));
+
+    Sim_CAN_Get_Stats(&can);
+    Sim_Board_Status(board_status, sizeof(board_status));
+
+    if (s_virtual)
+    {
+        printf(
+            "%s %7.1f h in %6.1f s | CAN tx %lu | %s\n",
+            Sim_Board_Name(),
+            (double) Sim_Now_Ns() / 3.6e12,
+            (double) Sim_Host_Ns() / 1e9,
+            (unsigned long) can.tx_frames,
+            board_status);
+    }
+    else
+    {
+        printf(
+            "%s %7.1f s | CAN tx %lu rx %lu no-ack %lu | %s%s\n",
+            Sim_Board_Name(),
+            (double) Sim_Now_Ns() / 1e9,
+            (unsigned long) can.tx_frames,
+            (unsigned long) can.rx_frames,
+            (unsigned long) can.tx_no_ack,
+            board_status,
+            s_led ? " | led" : "");
+    }
+}
+
+// --duration is up
+static void end_handler(Sim_Timer_T *timer)
+{
+    Q_UNUSED_PAR(timer);
+    Sim_Power_Off();
+}
+
+// removing power
+static void *power_thread(void *arg)
+{
+    sigset_t signals;
+    int signal;
+
+    (void) arg;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    (void) sigwait(&signals, &signal);
+
+    // the event loop and the interrupts stop where they are
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    Sim_Power_Off();
+    return NULL;
+}
+
+
+// a number with an optional unit: s (the default), m, h or d
+static bool parse_duration(const char *text, uint64_t *duration_ns)
+{
+    char *unit;
+    double value = strtod(text, &unit);
+    double scale = 1e9;
+
+    if ((unit == text) || !(value > 0.0) || ((unit[0] != '\0') && (unit[1] != '\0')))
+    {
+        return false;
+    }
+
+    switch (unit[0])
+    {
+        case '\0':
+        case 's':
+            break;
+        case 'm':
+            scale *= 60.0;
+            break;
+        case 'h':
+            scale *= 3600.0;
+            break;
+        case 'd':
+            scale *= 86400.0;
+            break;
+        default:
+            return false;
+    }
+
+    *duration_ns = (uint64_t) (value * scale);
+    return true;
+}
+
+static void usage(const char *program)
+{
+    fprintf(
+        stderr,
+        "usage: %s [--state-dir DIR] [--can-port PORT] [--quiet] [--virtual-time] "
+        "[--duration TIME] [--seed N] [--replay FILE]\n"
+        "  --state-dir DIR  FRAM image, backup RAM and USB PTY links (default: .)\n"
+        "  --can-port PORT  UDP port of the motor's CAN controller, the gauge's is PORT + 1 "
+        "(default: %u)\n"
+        "  --quiet          no status line every second (every simulated hour in virtual time)\n"
+        "  --virtual-time   as fast as the host runs it and deterministic, the board on its own:\n"
+        "                   no PTYs, and a CAN bus that acknowledges every frame\n"
+        "  --duration TIME  power off after TIME, in s (default), m, h or d\n"
+        "  --seed N         for the sensor models' random numbers (default: 1)\n"
+        "  --replay FILE    the motor's sensors play back a recorded sensor trace instead of the\n"
+        "                   engine scenario, then power off\n",
+        program,
+        SIM_CAN_UDP_PORT_DEFAULT);
+}
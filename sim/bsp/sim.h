@@ -0,0 +1,202 @@
+#ifndef SIM_H_
+#define SIM_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**************************************************************************************************\
+* Public macros
+\**************************************************************************************************/
+
+#define SIM_CORE_CLOCK_HZ       144000000U // the STM32G474 SYSCLK, for the simulated DWT counter
+#define SIM_CAN_UDP_PORT_DEFAULT 47400U    // the motor listens here, the gauge one above
+
+/**************************************************************************************************\
+* Public type definitions
+\**************************************************************************************************/
+
+// the boards, in the order of their CAN UDP ports
+typedef enum
+{
+    SIM_BOARD_MOTOR,
+    SIM_BOARD_GAUGE,
+} Sim_Board_T;
+
+// an interrupt handler, run with the critical section held (QV_ISR_ENTRY/EXIT)
+typedef void (*Sim_Isr_T)(void);
+
+typedef struct Sim_Timer Sim_Timer_T;
+typedef void (*Sim_Timer_Handler_T)(Sim_Timer_T *timer);
+
+// a one-shot timer interrupt of a simulated peripheral, fields private to sim.c
+struct Sim_Timer
+{
+    const char *name;
+    Sim_Timer_Handler_T handler;
+    uint64_t due_ns;
+    bool armed;
+    Sim_Timer_T *next;
+};
+
+typedef struct
+{
+    uint32_t tx_frames;    // sent to the other board and acknowledged
+    uint32_t tx_no_ack;    // attempts nobody acknowledged, the other board isn't running
+    uint32_t tx_full;      // writes refused with all 3 TX buffers in use
+    uint32_t rx_frames;    // put in the RX ring
+    uint32_t rx_filtered;  // rejected by the acceptance filters
+} Sim_CAN_Stats_T;
+
+typedef struct
+{
+    uint32_t transfers;     // completed, ACKed or not
+    uint32_t nacks;         // nothing at the address
+    uint32_t fram_writes;   // bytes written into the FRAM
+} Sim_I2C_Stats_T;
+
+/**************************************************************************************************\
+* Public prototypes
+\**************************************************************************************************/
+
+/**
+ ***************************************************************************************************
+ * @brief   Power on: parse the command line, open the backup RAM and start the clocks. Called
+ *          first thing in main(), before Reset_Init().
+ **************************************************************************************************/
+void Sim_Init(int argc, char *argv[], Sim_Board_T board);
+
+/**
+ ***************************************************************************************************
+ * @brief   "motor" or "gauge"
+ **************************************************************************************************/
+const char *Sim_Board_Name(void);
+
+/**
+ ***************************************************************************************************
+ * @brief   Path of a file this board keeps between runs, <state dir>/<board>-<name>
+ **************************************************************************************************/
+void Sim_State_Path(char *path, size_t size, const char *name);
+
+/**
+ ***************************************************************************************************
+ * @brief   UDP ports of this board's CAN controller and of the other board's
+ **************************************************************************************************/
+uint16_t Sim_CAN_Port(void);
+uint16_t Sim_CAN_Peer_Port(void);
+
+/**
+ ***************************************************************************************************
+ * @brief   True with --virtual-time: simulated time only moves on when every AO is idle, straight
+ *          to the next timer interrupt, and nothing outside the process is connected
+ **************************************************************************************************/
+bool Sim_Virtual_Time(void);
+
+/**
+ ***************************************************************************************************
+ * @brief   Nanoseconds since power on (Sim_Init), the time base of every simulated clock
+ **************************************************************************************************/
+uint64_t Sim_Now_Ns(void);
+
+/**
+ ***************************************************************************************************
+ * @brief   Nanoseconds of the host's monotonic clock since power on, for how fast virtual time
+ *          runs
+ **************************************************************************************************/
+uint64_t Sim_Host_Ns(void);
+
+/**
+ ***************************************************************************************************
+ * @brief   The next number of the sequence started by --seed, for the sensor models. The same
+ *          seed and options give the same run in virtual time.
+ **************************************************************************************************/
+uint32_t Sim_Random(void);
+
+/**
+ ***************************************************************************************************
+ * @brief   The sensor trace given with --replay, NULL without
+ **************************************************************************************************/
+const char *Sim_Replay_Path(void);
+
+/**
+ ***************************************************************************************************
+ * @brief   A peripheral that raises interrupts from a thread of its own, for input from outside
+ *          the process. The thread is started when QF_run() enables interrupts (QF_onStartup), or
+ *          right away after that. It does its blocking I/O outside the critical section, and
+ *          brackets what the handler on the board would do with QV_ISR_ENTRY() and QV_ISR_EXIT().
+ *          Not started in virtual time.
+ **************************************************************************************************/
+void Sim_Add_Interrupt(const char *name, void *(*thread)(void *), void *arg);
+
+/**
+ ***************************************************************************************************
+ * @brief   A timer interrupt, the handler runs every period_us from QF_onStartup on. In real time,
+ *          periods missed while the host was busy are caught up, up to 100 ms of them.
+ **************************************************************************************************/
+void Sim_Add_Periodic_Interrupt(const char *name, uint32_t period_us, Sim_Isr_T handler);
+
+/**
+ ***************************************************************************************************
+ * @brief   A one-shot timer interrupt: the time a transfer or a frame takes on its bus. Arming an
+ *          armed timer moves it. The handler runs in interrupt context, not before QF_onStartup.
+ *          Any thread, in or out of the critical section.
+ **************************************************************************************************/
+void Sim_Timer_Init(Sim_Timer_T *timer, const char *name, Sim_Timer_Handler_T handler);
+void Sim_Timer_Arm(Sim_Timer_T *timer, uint64_t due_ns);
+void Sim_Timer_Disarm(Sim_Timer_T *timer);
+
+/**
+ ***************************************************************************************************
+ * @brief   Timer interrupts run since power on, periodic and one-shot
+ **************************************************************************************************/
+uint64_t Sim_Timer_Interrupts(void);
+
+/**
+ ***************************************************************************************************
+ * @brief   Remove power, in the critical section: the report, then exit() so the PTY links are
+ *          cleaned up
+ **************************************************************************************************/
+void Sim_Power_Off(void);
+
+/**
+ ***************************************************************************************************
+ * @brief   At power off, in the critical section: simulated and host time, event throughput, the
+ *          event pool and queue watermarks, the peripherals' counters and the FRAM contents
+ *          (sim_report.c)
+ **************************************************************************************************/
+void Sim_Report(void);
+
+/**
+ ***************************************************************************************************
+ * @brief   CAN controller counters for the status line (sim_can.c)
+ **************************************************************************************************/
+void Sim_CAN_Get_Stats(Sim_CAN_Stats_T *stats);
+
+/**
+ ***************************************************************************************************
+ * @brief   I2C bus 2 counters, and the FRAM image for the report at power off (sim_i2c.c)
+ **************************************************************************************************/
+void Sim_I2C_Get_Stats(Sim_I2C_Stats_T *stats);
+const uint8_t *Sim_FRAM_Image(size_t *size);
+
+/**
+ ***************************************************************************************************
+ * @brief   Bytes written to each USB CDC interface, usb0 and usb1 (sim_usb.c)
+ **************************************************************************************************/
+void Sim_USB_Get_Tx_Bytes(uint64_t tx_bytes[2]);
+
+/**
+ ***************************************************************************************************
+ * @brief   Claim I2C bus 2 with its FRAM and construct the SharedI2C AO on it, from BSP_Init()
+ *          (sim_i2c.c)
+ **************************************************************************************************/
+void Sim_I2C_Init(void);
+
+/**
+ ***************************************************************************************************
+ * @brief   The board's part of the once a second status line: sensor models, gauge outputs
+ *          (sim/motor, sim/gauge)
+ **************************************************************************************************/
+void Sim_Board_Status(char *line, size_t size);
+
+#endif // SIM_H_
@@ -0,0 +1,477 @@
+#include "box_to_box.h"
+#include "bsp.h"
+#include "can_bit_timing.h"
+#include "can_bus_load.h"
+#include "can_messages.h"
+#include "can_rx_ring.h"
+#include "posted_signals.h"
+#include "qpc.h"
+#include "sim.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+Q_DEFINE_THIS_MODULE("sim_can.c")
+
+/**************************************************************************************************\
+* Private macros
+\**************************************************************************************************/
+
+#define CAN_TX_BUFFERS       3U // FDCAN TX FIFO/queue elements on the G4
+#define CAN_TX_EVENTS        3U // and TX event FIFO elements
+#define CAN_NOMINAL_BPS      (CAN_KERNEL_CLOCK_HZ / (4U * (1U + 13U + 2U))) // MX_FDCAN2_Init
+#define CAN_TIMESTAMP_PRESCALER 16U
+#define CAN_NO_ACK_RETRY_NS  1000000ULL // the FDCAN retries at once, this keeps the host idle
+#define CAN_ERROR_PASSIVE    128U
+#define CAN_ERROR_WARNING    96U
+
+/**************************************************************************************************\
+* Private type definitions
+\**************************************************************************************************/
+
+// a frame on the wire, one UDP datagram, only the DLC's bytes of data are sent
+typedef struct
+{
+    uint32_t id;
+    uint8_t dlc;
+    uint8_t brs;
+    uint8_t data[CAN_MAX_DATA_LENGTH];
+} __attribute__((packed)) Wire_Frame_T;
+
+typedef struct
+{
+    bool used;
+    uint32_t order; // FIFO order among equal IDs
+    uint64_t write_ns;
+    CAN_Message_T msg;
+} Tx_Buffer_T;
+
+// what the transmitter is doing
+typedef enum
+{
+    TX_IDLE,
+    TX_SENDING, // a frame on the bus until the TX timer
+    TX_BACKOFF, // not acknowledged, waiting for the retry
+} Tx_State_T;
+
+/**************************************************************************************************\
+* Private prototypes
+\**************************************************************************************************/
+
+static void start_next_tx(void);
+static void can_tx_handler(Sim_Timer_T *timer);
+static void *can_rx_thread(void *arg);
+static bool filter_accepts(uint32_t id);
+static void set_tx_errors(uint32_t tx_errors);
+
+/**************************************************************************************************\
+* Private memory declarations
+\**************************************************************************************************/
+
+// static events posted to Box_To_Box, as from the CAN interrupts
+static QEvt const s_can_frames_available_evt = QEVT_INITIALIZER(POSTED_CAN_FRAMES_AVAILABLE_SIG);
+static QEvt const s_can_tx_complete_evt      = QEVT_INITIALIZER(POSTED_CAN_TX_COMPLETE_SIG);
+static QEvt const s_can_bus_status_evt       = QEVT_INITIALIZER(POSTED_CAN_BUS_STATUS_SIG);
+
+static int s_socket = -1;
+static bool s_can_brs;
+
+// the controller's state, guarded by s_mutex; taken inside the critical section, never around it
+static pthread_mutex_t s_mutex = PTHREAD_MUTEX_INITIALIZER;
+static Tx_Buffer_T s_tx_buffers[CAN_TX_BUFFERS];
+static uint32_t s_tx_order;
+static Sim_Timer_T s_tx_timer;
+static Tx_State_T s_tx_state;
+static Tx_Buffer_T *s_tx_next;  // the buffer on the bus
+static Tx_Buffer_T s_tx_frame;  // and its frame as it went out
+static uint64_t s_tx_start_ns;
+static CAN_Tx_Event_T s_tx_events[CAN_TX_EVENTS];
+static uint32_t s_tx_event_count;
+static uint32_t s_tx_errors; // TEC
+static CAN_Error_Code_T s_last_error = CAN_ERROR_NO_CHANGE;
+static Sim_CAN_Stats_T s_stats;
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+/**
+ ***************************************************************************************************
+ * @brief   The FDCAN as a UDP socket on the loopback interface, connected to the other board's.
+ *          The bus is full duplex between the two and has no arbitration: each board's own
+ *          frames go out lowest ID first, one frame time apart, whatever the other board sends.
+ *          In virtual time there is no socket, and every frame is acknowledged.
+ **************************************************************************************************/
+void BSP_CAN_Bus_Init(void)
+{
+    struct sockaddr_in addr = {.sin_family = AF_INET};
+    int error;
+
+    if (s_tx_timer.handler != NULL)
+    {
+        return;
+    }
+
+#if CAN_DATA_BITRATE_BPS != 0
+    s_can_brs = true;
+#endif
+
+    Sim_Timer_Init(&s_tx_timer, "FDCAN2 TX", can_tx_handler);
+    if (Sim_Virtual_Time())
+    {
+        return;
+    }
+
+    s_socket = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    Q_ASSERT(s_socket >= 0);
+
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port        = htons(Sim_CAN_Port());
+    if (bind(s_socket, (struct sockaddr *) &addr, sizeof(addr)) != 0)
+    {
+        fprintf(stderr, "%s: CAN UDP port %u: %s\n", Sim_Board_Name(), Sim_CAN_Port(), strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+
+    addr.sin_port = htons(Sim_CAN_Peer_Port());
+    error         = connect(s_socket, (struct sockaddr *) &addr, sizeof(addr));
+    Q_ASSERT(error == 0);
+
+    Sim_Add_Interrupt("FDCAN2 RX", can_rx_thread, NULL);
+}
+
+/**
+ ***************************************************************************************************
+ *
+ * @brief   Write CAN Message with Standard ID (range of 0 to 0x7FF)
+ *
+ * @retval  0 if message is sucsssfully queued into TX mailbox
+ * @retval  1 if TX mailbox is full and message cannot be send (likely BUS error or
+ *disconnected)
+ *
+ **************************************************************************************************/
+int32_t BSP_CAN_Write_Msg(const CAN_Message_T *msg)
+{
+    int32_t retval = 1;
+
+    pthread_mutex_lock(&s_mutex);
+    for (uint32_t i = 0U; i < CAN_TX_BUFFERS; i++)
+    {
+        if (!s_tx_buffers[i].used)
+        {
+            s_tx_buffers[i].used     = true;
+            s_tx_buffers[i].order    = s_tx_order++;
+            s_tx_buffers[i].write_ns = Sim_Now_Ns();
+            s_tx_buffers[i].msg      = *msg;
+            start_next_tx();
+            retval = 0;
+            break;
+        }
+    }
+    if (retval != 0)
+    {
+        s_stats.tx_full++;
+    }
+    pthread_mutex_unlock(&s_mutex);
+
+    return retval;
+}
+
+void BSP_CAN_Get_Bus_Status(CAN_Bus_Status_T *status)
+{
+    pthread_mutex_lock(&s_mutex);
+    if (s_tx_errors >= CAN_ERROR_PASSIVE)
+    {
+        status->state = CAN_BUS_STATE_PASSIVE;
+    }
+    else if (s_tx_errors >= CAN_ERROR_WARNING)
+    {
+        status->state = CAN_BUS_STATE_WARNING;
+    }
+    else
+    {
+        status->state = CAN_BUS_STATE_ACTIVE;
+    }
+
+    // as reading PSR and ECR, the last error code resets to "no change"
+    status->tx_errors       = (uint8_t) s_tx_errors;
+    status->rx_errors       = 0U;
+    status->errors_logged   = (s_last_error == CAN_ERROR_ACK) ? 1U : 0U;
+    status->last_error      = s_last_error;
+    status->data_last_error = CAN_ERROR_NO_CHANGE;
+    s_last_error            = CAN_ERROR_NO_CHANGE;
+    pthread_mutex_unlock(&s_mutex);
+}
+
+bool BSP_CAN_Read_Tx_Event(CAN_Tx_Event_T *event)
+{
+    bool found = false;
+
+    pthread_mutex_lock(&s_mutex);
+    if (s_tx_event_count > 0U)
+    {
+        *event = s_tx_events[0];
+        s_tx_event_count--;
+        memmove(&s_tx_events[0], &s_tx_events[1], s_tx_event_count * sizeof(*event));
+        found = true;
+    }
+    pthread_mutex_unlock(&s_mutex);
+
+    return found;
+}
+
+uint64_t BSP_CAN_Timestamp_To_Us(uint16_t timestamp)
+{
+    uint64_t tick_ns  = (CAN_TIMESTAMP_PRESCALER * 1000000000ULL) / CAN_NOMINAL_BPS;
+    uint64_t now_ns   = Sim_Now_Ns();
+    uint16_t now_tick = (uint16_t) (now_ns / tick_ns);
+    uint16_t ticks    = (uint16_t) (now_tick - timestamp);
+
+    return (now_ns / 1000U) - ((ticks * tick_ns) / 1000U);
+}
+
+void BSP_CAN_Get_Bit_Rates(CAN_Bit_Rates_T *rates)
+{
+    rates->nominal_bps = CAN_NOMINAL_BPS;
+    rates->data_bps    = s_can_brs ? CAN_DATA_BITRATE_BPS : rates->nominal_bps;
+    rates->brs         = s_can_brs;
+}
+
+void BSP_CAN_Disable_Bit_Rate_Switch(void)
+{
+    pthread_mutex_lock(&s_mutex);
+    s_can_brs = false;
+
+    // frames already in the TX buffers would keep retrying with BRS, the queue has newer values
+    for (uint32_t i = 0U; i < CAN_TX_BUFFERS; i++)
+    {
+        s_tx_buffers[i].used = false;
+    }
+    pthread_mutex_unlock(&s_mutex);
+}
+
+void BSP_CAN_Bus_Recover(void)
+{
+    // ACK errors stop counting at error passive, the simulated controller never goes bus-off
+    pthread_mutex_lock(&s_mutex);
+    s_tx_errors = 0U;
+    pthread_mutex_unlock(&s_mutex);
+}
+
+void Sim_CAN_Get_Stats(Sim_CAN_Stats_T *stats)
+{
+    pthread_mutex_lock(&s_mutex);
+    *stats = s_stats;
+    pthread_mutex_unlock(&s_mutex);
+}
+
+/**************************************************************************************************\
+* Private functions
+\**************************************************************************************************/
+
+/**
+ ***************************************************************************************************
+ * @brief   With the transmitter idle, the lowest ID waiting goes on the bus for its frame time.
+ *          With s_mutex.
+ **************************************************************************************************/
+static void start_next_tx(void)
+{
+    CAN_Bit_Rates_T rates;
+
+    if (s_tx_state != TX_IDLE)
+    {
+        return;
+    }
+
+    s_tx_next = NULL;
+    for (uint32_t i = 0U; i < CAN_TX_BUFFERS; i++)
+    {
+        Tx_Buffer_T *buffer = &s_tx_buffers[i];
+        if (buffer->used &&
+            ((s_tx_next == NULL) || (buffer->msg.id < s_tx_next->msg.id) ||
+             ((buffer->msg.id == s_tx_next->msg.id) && (buffer->order < s_tx_next->order))))
+        {
+            s_tx_next = buffer;
+        }
+    }
+    if (s_tx_next == NULL)
+    {
+        return;
+    }
+
+    rates.nominal_bps = CAN_NOMINAL_BPS;
+    rates.data_bps    = s_can_brs ? CAN_DATA_BITRATE_BPS : CAN_NOMINAL_BPS;
+    rates.brs         = s_can_brs;
+
+    s_tx_state    = TX_SENDING;
+    s_tx_frame    = *s_tx_next;
+    s_tx_start_ns = Sim_Now_Ns();
+    Sim_Timer_Arm(&s_tx_timer, s_tx_start_ns + CAN_Frame_Time_Ns(s_tx_frame.msg.dlc, &rates));
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   The end of the frame on the bus, the TX complete interrupt. A frame the other board
+ *          didn't receive (its socket is closed) wasn't acknowledged and stays in its buffer to be
+ *          retried.
+ **************************************************************************************************/
+static void can_tx_handler(Sim_Timer_T *timer)
+{
+    Q_UNUSED_PAR(timer);
+    Wire_Frame_T wire;
+    bool acked = true;
+
+    pthread_mutex_lock(&s_mutex);
+    if (s_tx_state == TX_BACKOFF)
+    {
+        s_tx_state = TX_IDLE;
+        start_next_tx();
+        pthread_mutex_unlock(&s_mutex);
+        return;
+    }
+
+    if (s_socket >= 0)
+    {
+        uint8_t bytes = CAN_DLC_to_Bytes[s_tx_frame.msg.dlc & 0x0FU];
+        wire.id       = s_tx_frame.msg.id;
+        wire.dlc      = (uint8_t) s_tx_frame.msg.dlc;
+        wire.brs      = s_can_brs ? 1U : 0U;
+        memcpy(wire.data, s_tx_frame.msg.data, bytes);
+        size_t len = offsetof(Wire_Frame_T, data) + bytes;
+        acked      = send(s_socket, &wire, len, MSG_DONTWAIT) == (ssize_t) len;
+    }
+
+    bool passive = s_tx_errors >= CAN_ERROR_PASSIVE;
+    if (!acked)
+    {
+        s_stats.tx_no_ack++;
+        s_last_error = CAN_ERROR_ACK;
+        if (!passive)
+        {
+            set_tx_errors(s_tx_errors + 8U);
+        }
+    }
+    else if ((s_tx_next->used) && (s_tx_next->order == s_tx_frame.order))
+    {
+        // not aborted while on the bus
+        s_tx_next->used = false;
+        s_last_error    = CAN_ERROR_NONE;
+        s_stats.tx_frames++;
+        set_tx_errors((s_tx_errors > 0U) ? (s_tx_errors - 1U) : 0U);
+
+        if (s_tx_event_count < CAN_TX_EVENTS)
+        {
+            CAN_Tx_Event_T *event = &s_tx_events[s_tx_event_count++];
+            event->id             = s_tx_frame.msg.id;
+            event->dlc            = s_tx_frame.msg.dlc;
+            event->queued_us      = (uint32_t) ((s_tx_start_ns - s_tx_frame.write_ns) / 1000U);
+            event->sent_us        = s_tx_start_ns / 1000U;
+        }
+    }
+    bool status_changed = passive != (s_tx_errors >= CAN_ERROR_PASSIVE);
+
+    if (acked)
+    {
+        s_tx_state = TX_IDLE;
+        start_next_tx();
+    }
+    else
+    {
+        s_tx_state = TX_BACKOFF;
+        Sim_Timer_Arm(&s_tx_timer, Sim_Now_Ns() + CAN_NO_ACK_RETRY_NS);
+    }
+    pthread_mutex_unlock(&s_mutex);
+
+    if (acked)
+    {
+        (void) QACTIVE_POST_X(AO_BOX_TO_BOX, &s_can_tx_complete_evt, 2U, NULL);
+    }
+    if (status_changed)
+    {
+        (void) QACTIVE_POST_X(AO_BOX_TO_BOX, &s_can_bus_status_evt, 2U, NULL);
+    }
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   The FDCAN receiving: frames from the other board through the acceptance filters into
+ *          the RX ring, at most one frames-available event posted to the BOX_TO_BOX AO
+ **************************************************************************************************/
+static void *can_rx_thread(void *arg)
+{
+    Wire_Frame_T wire;
+    CAN_Bit_Rates_T rates;
+
+    (void) arg;
+    for (;;)
+    {
+        ssize_t n = recv(s_socket, &wire, sizeof(wire), 0);
+        if ((n < (ssize_t) offsetof(Wire_Frame_T, data)) || (wire.dlc > 15U))
+        {
+            continue; // ECONNREFUSED from our own sends to a closed port, or not a frame
+        }
+
+        rates.nominal_bps = CAN_NOMINAL_BPS;
+        rates.data_bps    = (wire.brs != 0U) ? CAN_DATA_BITRATE_BPS : CAN_NOMINAL_BPS;
+        rates.brs         = wire.brs != 0U;
+        uint64_t end_ns   = Sim_Now_Ns();
+        uint64_t frame_ns = CAN_Frame_Time_Ns(wire.dlc, &rates);
+
+        QV_ISR_ENTRY();
+        if (!filter_accepts(wire.id))
+        {
+            pthread_mutex_lock(&s_mutex);
+            s_stats.rx_filtered++;
+            pthread_mutex_unlock(&s_mutex);
+        }
+        else
+        {
+            CAN_Message_T *frame = CAN_Rx_Ring_Reserve();
+            frame->id            = wire.id;
+            frame->dlc           = wire.dlc;
+            frame->timestamp_us  = ((end_ns > frame_ns) ? (end_ns - frame_ns) : 0U) / 1000U;
+            memcpy(frame->data, wire.data, CAN_DLC_to_Bytes[wire.dlc]);
+            CAN_Rx_Ring_Commit();
+
+            if (CAN_Rx_Ring_Notify_Needed())
+            {
+                if (!QACTIVE_POST_X(AO_BOX_TO_BOX, &s_can_frames_available_evt, 1U, NULL))
+                {
+                    CAN_Rx_Ring_Notify_Failed();
+                }
+            }
+
+            pthread_mutex_lock(&s_mutex);
+            s_stats.rx_frames++;
+            pthread_mutex_unlock(&s_mutex);
+        }
+        QV_ISR_EXIT();
+    }
+
+    return NULL;
+}
+
+// the FDCAN filters, from the message registry
+static bool filter_accepts(uint32_t id)
+{
+    for (uint32_t i = 0U; i < CAN_MSG_COUNT; i++)
+    {
+        if (CAN_Msg_Info[i].id == id)
+        {
+            return (CAN_Msg_Info[i].rx_boards & CAN_RX_THIS_BOARD) != 0U;
+        }
+    }
+    return false;
+}
+
+static void set_tx_errors(uint32_t tx_errors)
+{
+    s_tx_errors = (tx_errors > CAN_ERROR_PASSIVE) ? CAN_ERROR_PASSIVE : tx_errors;
+}
@@ -0,0 +1,417 @@
+#include "bsp.h"
+#include "i2c_bus.h"
+#include "qpc.h"
+#include "shared_i2c.h"
+#include "sim.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+Q_DEFINE_THIS_MODULE("sim_i2c.c")
+
+/**************************************************************************************************\
+* Private macros
+\**************************************************************************************************/
+
+#define SHARED_I2C_BUS_2_DEFERRED_QUEUE_LEN 3
+#define I2C_BIT_RATE_HZ                     100000U // about what the I2C2 timing 0x50916E9F gives
+#define I2C_BITS_PER_BYTE                   9U      // 8 data bits and the ACK
+
+// FM24CL04B, 4 kbit: the top bit of the word address is the A8 bit of the device address
+#define FRAM_DEVICE_ADDR 0x50U
+#define FRAM_DEVICE_MASK 0x7EU
+#define FRAM_SIZE        512U
+
+/**************************************************************************************************\
+* Private type definitions
+\**************************************************************************************************/
+
+typedef enum
+{
+    TRANSFER_WRITE,
+    TRANSFER_READ,
+    TRANSFER_MEMORY_READ,
+} Transfer_Kind_T;
+
+// the transfer in progress on the bus, one at a time as with the HAL's IT transfers
+typedef struct
+{
+    bool active;
+    Transfer_Kind_T kind;
+    uint8_t address;
+    uint16_t mem_address;
+    uint8_t *buffer;
+    uint16_t len;
+    I2C_Complete_Callback complete_cb;
+    I2C_Error_Callback error_cb;
+    void *cb_data;
+} Transfer_T;
+
+/**************************************************************************************************\
+* Private prototypes
+\**************************************************************************************************/
+
+static I2C_Return_T start_transfer(const Transfer_T *transfer);
+static void i2c_handler(Sim_Timer_T *timer);
+static bool fram_transfer(Transfer_T *transfer);
+
+static I2C_Return_T BSP_I2C_Write_Pressure(
+    uint8_t address,
+    uint8_t *tx_buffer,
+    const uint16_t data_len,
+    I2C_Complete_Callback complete_cb,
+    I2C_Error_Callback error_cb,
+    void *cb_data);
+
+static I2C_Return_T BSP_I2C_Read_Pressure(
+    uint8_t address,
+    uint8_t *tx_buffer,
+    const uint16_t data_len,
+    I2C_Complete_Callback complete_cb,
+    I2C_Error_Callback error_cb,
+    void *cb_data);
+
+static I2C_Return_T BSP_I2C_Write_FRAM(
+    uint8_t address,
+    uint8_t *tx_buffer,
+    const uint16_t data_len,
+    I2C_Complete_Callback complete_cb,
+    I2C_Error_Callback error_cb,
+    void *cb_data);
+
+static I2C_Return_T BSP_I2C_Memory_Read_FRAM(
+    uint8_t address,
+    uint16_t mem_address,
+    uint8_t mem_address_size,
+    uint8_t *rx_buffer,
+    const uint16_t data_len,
+    I2C_Complete_Callback complete_cb,
+    I2C_Error_Callback error_cb,
+    void *cb_data);
+
+/**************************************************************************************************\
+* Private memory declarations
+\**************************************************************************************************/
+
+static I2C_Bus_T s_i2c_bus2;
+
+static SharedI2C_T SharedI2C_Bus2;
+const QActive *AO_SharedI2C2 = &(SharedI2C_Bus2.super); // externally available
+QEvt const *i2c_bus_2_deferred_queue_storage[SHARED_I2C_BUS_2_DEFERRED_QUEUE_LEN];
+
+static Sim_Timer_T s_i2c_timer; // the end of the transfer on the bus
+static Transfer_T s_transfer;
+static Sim_I2C_Stats_T s_stats;
+
+static uint8_t *s_fram;         // mapped from <board>-fram.bin, every write goes to the file
+static uint16_t s_fram_address; // the FRAM's address latch, the next byte read or written
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+void Sim_I2C_Init(void)
+{
+    char path[256];
+
+    // a new image is all zeros, which fram.c finds no valid file in, like a blank part
+    Sim_State_Path(path, sizeof(path), "fram.bin");
+    int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if ((fd < 0) || (ftruncate(fd, FRAM_SIZE) != 0))
+    {
+        fprintf(stderr, "%s: %s: %s\n", Sim_Board_Name(), path, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    s_fram = mmap(NULL, FRAM_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    Q_ASSERT(s_fram != MAP_FAILED);
+    close(fd);
+
+    I2C_Bus_Init(&s_i2c_bus2, I2C_BUS_ID_2);
+    Sim_Timer_Init(&s_i2c_timer, "I2C2", i2c_handler);
+
+    SharedI2C_ctor(
+        &SharedI2C_Bus2,
+        I2C_BUS_ID_2,
+        i2c_bus_2_deferred_queue_storage,
+        SHARED_I2C_BUS_2_DEFERRED_QUEUE_LEN);
+}
+
+void I2C_Bus_Init(I2C_Bus_T *p_I2C_bus, I2C_Bus_ID_T id)
+{
+    Q_ASSERT(id == I2C_BUS_ID_2); // the only bus either board uses
+    p_I2C_bus->id = id;
+
+    p_I2C_bus->active_complete_cb = NULL;
+    p_I2C_bus->active_error_cb    = NULL;
+    p_I2C_bus->active_cb_data     = NULL;
+}
+
+I2C_Return_T I2C_Bus_Write(
+    I2C_Bus_ID_T bus_id,
+    uint8_t address,
+    uint8_t *tx_buffer,
+    const uint16_t data_len,
+    I2C_Complete_Callback complete_cb,
+    I2C_Error_Callback error_cb,
+    void *cb_data)
+{
+    Q_ASSERT(bus_id == I2C_BUS_ID_2);
+
+    Transfer_T transfer = {
+        .kind        = TRANSFER_WRITE,
+        .address     = address,
+        .buffer      = tx_buffer,
+        .len         = data_len,
+        .complete_cb = complete_cb,
+        .error_cb    = error_cb,
+        .cb_data     = cb_data,
+    };
+    return start_transfer(&transfer);
+}
+
+I2C_Return_T I2C_Bus_Read(
+    I2C_Bus_ID_T bus_id,
+    uint8_t address,
+    uint8_t *rx_buffer,
+    const uint16_t data_len,
+    I2C_Complete_Callback complete_cb,
+    I2C_Error_Callback error_cb,
+    void *cb_data)
+{
+    Q_ASSERT(bus_id == I2C_BUS_ID_2);
+
+    Transfer_T transfer = {
+        .kind        = TRANSFER_READ,
+        .address     = address,
+        .buffer      = rx_buffer,
+        .len         = data_len,
+        .complete_cb = complete_cb,
+        .error_cb    = error_cb,
+        .cb_data     = cb_data,
+    };
+    return start_transfer(&transfer);
+}
+
+I2C_Return_T I2C_Bus_MemoryRead(
+    I2C_Bus_ID_T bus_id,
+    uint8_t address,
+    uint16_t mem_address,
+    uint8_t mem_address_size,
+    uint8_t *rx_buffer,
+    const uint16_t data_len,
+    I2C_Complete_Callback complete_cb,
+    I2C_Error_Callback error_cb,
+    void *cb_data)
+{
+    Q_ASSERT(bus_id == I2C_BUS_ID_2);
+    Q_ASSERT((mem_address_size == 1U) || (mem_address_size == 2U));
+
+    Transfer_T transfer = {
+        .kind        = TRANSFER_MEMORY_READ,
+        .address     = address,
+        .mem_address = mem_address,
+        .buffer      = rx_buffer,
+        .len         = data_len,
+        .complete_cb = complete_cb,
+        .error_cb    = error_cb,
+        .cb_data     = cb_data,
+    };
+    return start_transfer(&transfer);
+}
+
+void Sim_I2C_Get_Stats(Sim_I2C_Stats_T *stats)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    *stats = s_stats;
+    QF_CRIT_EXIT();
+}
+
+const uint8_t *Sim_FRAM_Image(size_t *size)
+{
+    *size = FRAM_SIZE;
+    return s_fram;
+}
+
+I2C_Write BSP_Get_I2C_Write_Pressure()
+{
+    return BSP_I2C_Write_Pressure;
+}
+
+I2C_Read BSP_Get_I2C_Read_Pressure()
+{
+    return BSP_I2C_Read_Pressure;
+}
+
+I2C_Write BSP_Get_I2C_Write_FRAM()
+{
+    return BSP_I2C_Write_FRAM;
+}
+
+I2C_MemoryRead BSP_Get_I2C_Memory_Read_FRAM()
+{
+    return BSP_I2C_Memory_Read_FRAM;
+}
+
+/**************************************************************************************************\
+* Private functions
+\**************************************************************************************************/
+
+static I2C_Return_T start_transfer(const Transfer_T *transfer)
+{
+    I2C_Return_T retval = I2C_RTN_BUSY;
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    if (!s_transfer.active)
+    {
+        s_transfer        = *transfer;
+        s_transfer.active = true;
+
+        // address byte, the word address of a memory read, then the data
+        uint32_t bytes = 1U + transfer->len + ((transfer->kind == TRANSFER_MEMORY_READ) ? 2U : 0U);
+        Sim_Timer_Arm(
+            &s_i2c_timer,
+            Sim_Now_Ns() +
+                (((uint64_t) bytes * I2C_BITS_PER_BYTE * 1000000000ULL) / I2C_BIT_RATE_HZ));
+        retval = I2C_RTN_SUCCESS;
+    }
+    QF_CRIT_EXIT();
+
+    return retval;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   The I2C2 event and error interrupts, at the end of the transfer: the device answers
+ *          and the callback runs in interrupt context
+ **************************************************************************************************/
+static void i2c_handler(Sim_Timer_T *timer)
+{
+    Q_UNUSED_PAR(timer);
+
+    Transfer_T transfer = s_transfer;
+    bool acked          = fram_transfer(&transfer);
+
+    s_stats.transfers++;
+    s_stats.nacks += acked ? 0U : 1U;
+
+    // the bus is free again before the callback, which may start the next transfer
+    s_transfer.active = false;
+
+    if (acked && (transfer.complete_cb != NULL))
+    {
+        transfer.complete_cb(transfer.cb_data);
+    }
+    else if (!acked && (transfer.error_cb != NULL))
+    {
+        transfer.error_cb(transfer.cb_data);
+    }
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   The FRAM's side of a transfer, false for a NACK (nothing at the address)
+ **************************************************************************************************/
+static bool fram_transfer(Transfer_T *transfer)
+{
+    if ((transfer->address & FRAM_DEVICE_MASK) != FRAM_DEVICE_ADDR)
+    {
+        return false;
+    }
+
+    uint16_t a8 = (uint16_t) ((transfer->address & 0x01U) << 8);
+    uint16_t i  = 0U;
+
+    switch (transfer->kind)
+    {
+        case TRANSFER_WRITE:
+            if (transfer->len > 0U)
+            {
+                s_fram_address = a8 | transfer->buffer[0];
+                i              = 1U;
+            }
+            for (; i < transfer->len; i++)
+            {
+                s_fram[s_fram_address] = transfer->buffer[i];
+                s_fram_address         = (s_fram_address + 1U) % FRAM_SIZE;
+                s_stats.fram_writes++;
+            }
+            break;
+
+        case TRANSFER_MEMORY_READ:
+            s_fram_address = a8 | (transfer->mem_address & 0xFFU);
+            // fall through
+        case TRANSFER_READ:
+            for (; i < transfer->len; i++)
+            {
+                transfer->buffer[i] = s_fram[s_fram_address];
+                s_fram_address      = (s_fram_address + 1U) % FRAM_SIZE;
+            }
+            break;
+    }
+
+    return true;
+}
+
+static I2C_Return_T BSP_I2C_Write_Pressure(
+    uint8_t address,
+    uint8_t *tx_buffer,
+    const uint16_t data_len,
+    I2C_Complete_Callback complete_cb,
+    I2C_Error_Callback error_cb,
+    void *cb_data)
+{
+    return SharedI2C_Write(
+        &SharedI2C_Bus2, address, tx_buffer, data_len, complete_cb, error_cb, cb_data);
+}
+
+static I2C_Return_T BSP_I2C_Read_Pressure(
+    uint8_t address,
+    uint8_t *rx_buffer,
+    const uint16_t data_len,
+    I2C_Complete_Callback complete_cb,
+    I2C_Error_Callback error_cb,
+    void *cb_data)
+{
+    return SharedI2C_Read(
+        &SharedI2C_Bus2, address, rx_buffer, data_len, complete_cb, error_cb, cb_data);
+}
+
+static I2C_Return_T BSP_I2C_Write_FRAM(
+    uint8_t address,
+    uint8_t *tx_buffer,
+    const uint16_t data_len,
+    I2C_Complete_Callback complete_cb,
+    I2C_Error_Callback error_cb,
+    void *cb_data)
+{
+    return SharedI2C_Write(
+        &SharedI2C_Bus2, address, tx_buffer, data_len, complete_cb, error_cb, cb_data);
+}
+
+static I2C_Return_T BSP_I2C_Memory_Read_FRAM(
+    uint8_t address,
+    uint16_t mem_address,
+    uint8_t mem_address_size,
+    uint8_t *rx_buffer,
+    const uint16_t data_len,
+    I2C_Complete_Callback complete_cb,
+    I2C_Error_Callback error_cb,
+    void *cb_data)
+{
+    return SharedI2C_MemoryRead(
+        &SharedI2C_Bus2,
+        address,
+        mem_address,
+        mem_address_size,
+        rx_buffer,
+        data_len,
+        complete_cb,
+        error_cb,
+        cb_data);
+}
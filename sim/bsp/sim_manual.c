@@ -0,0 +1,33 @@
+#include "bsp_manual.h"
+#include "qsafe.h"
+
+Q_DEFINE_THIS_MODULE("sim_manual")
+
+// GPIOA..GPIOG, what the CLI last drove on each pin reads back, everything else reads low
+#define SIM_GPIO_PORTS 7U
+#define SIM_GPIO_PINS  16U
+
+static uint16_t s_gpio_levels[SIM_GPIO_PORTS];
+
+void BSP_Manual_Config_and_Set_Digital_Output(char port_char, uint8_t pin, bool is_high)
+{
+    uint32_t port = (uint32_t) (port_char - 'A');
+    Q_ASSERT((port < SIM_GPIO_PORTS) && (pin < SIM_GPIO_PINS));
+
+    if (is_high)
+    {
+        s_gpio_levels[port] |= (uint16_t) (1U << pin);
+    }
+    else
+    {
+        s_gpio_levels[port] &= (uint16_t) ~(1U << pin);
+    }
+}
+
+bool BSP_Manual_Config_and_Read_Digital_Input(char port_char, uint8_t pin)
+{
+    uint32_t port = (uint32_t) (port_char - 'A');
+    Q_ASSERT((port < SIM_GPIO_PORTS) && (pin < SIM_GPIO_PINS));
+
+    return (s_gpio_levels[port] & (1U << pin)) != 0U;
+}
@@ -0,0 +1,141 @@
+#include "event_watermarks.h"
+#include "qpc.h"
+#include "sim.h"
+#include <stdio.h>
+
+/**************************************************************************************************\
+* Private macros
+\**************************************************************************************************/
+
+#define FRAM_DUMP_BYTES_PER_LINE 16U
+
+/**************************************************************************************************\
+* Private prototypes
+\**************************************************************************************************/
+
+// QP's own, around which the sim executables are linked with -Wl,--wrap (sim/CMakeLists.txt)
+bool __real_QActive_post_(
+    QActive *const me, QEvt const *const e, uint_fast16_t const margin, void const *const sender);
+void __real_QActive_postLIFO_(QActive *const me, QEvt const *const e);
+
+bool __wrap_QActive_post_(
+    QActive *const me, QEvt const *const e, uint_fast16_t const margin, void const *const sender);
+void __wrap_QActive_postLIFO_(QActive *const me, QEvt const *const e);
+
+/**************************************************************************************************\
+* Private memory declarations
+\**************************************************************************************************/
+
+static uint64_t s_posts[QF_MAX_ACTIVE + 1U]; // events posted to each AO, by priority
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+void Sim_Report(void)
+{
+    const char *board  = Sim_Board_Name();
+    double sim_s       = (double) Sim_Now_Ns() / 1e9;
+    double host_s      = (double) Sim_Host_Ns() / 1e9;
+    uint64_t posts     = 0U;
+    Sim_CAN_Stats_T can;
+    Sim_I2C_Stats_T i2c;
+    Event_Pool_Stats_T pool;
+    uint64_t usb_tx[2];
+
+    for (uint_fast8_t prio = 1U; prio <= QF_MAX_ACTIVE; prio++)
+    {
+        posts += s_posts[prio];
+    }
+
+    printf(
+        "%s: %.1f s (%.1f h) simulated in %.1f s of host time (%.0f x real time)\n",
+        board,
+        sim_s,
+        sim_s / 3600.0,
+        host_s,
+        (host_s > 0.0) ? (sim_s / host_s) : 0.0);
+    printf(
+        "%s: %llu events posted, %.0f per simulated s, %.0f per host s; %llu timer interrupts\n",
+        board,
+        (unsigned long long) posts,
+        (sim_s > 0.0) ? ((double) posts / sim_s) : 0.0,
+        (host_s > 0.0) ? ((double) posts / host_s) : 0.0,
+        (unsigned long long) Sim_Timer_Interrupts());
+
+    // a pool or a queue whose minimum free reached 0 ran out at least once
+    for (size_t i = 0U; Event_Watermarks_Get_Pool(i, &pool); i++)
+    {
+        printf(
+            "%s: event pool %u: %lu x %lu B, min free %lu\n",
+            board,
+            (unsigned) (i + 1U),
+            (unsigned long) pool.blocks,
+            (unsigned long) pool.block_size,
+            (unsigned long) pool.min_free);
+    }
+    for (uint_fast8_t prio = 1U; prio <= QF_MAX_ACTIVE; prio++)
+    {
+        QActive const *ao = QActive_registry_[prio];
+        if (ao != NULL)
+        {
+            printf(
+                "%s: AO prio %2u: queue %3u, min free %3u, %llu events posted\n",
+                board,
+                (unsigned) prio,
+                (unsigned) ao->eQueue.end + 1U,
+                (unsigned) QEQueue_getNMin(&ao->eQueue),
+                (unsigned long long) s_posts[prio]);
+        }
+    }
+
+    Sim_CAN_Get_Stats(&can);
+    Sim_I2C_Get_Stats(&i2c);
+    Sim_USB_Get_Tx_Bytes(usb_tx);
+    printf(
+        "%s: CAN tx %lu no-ack %lu full %lu rx %lu filtered %lu | I2C %lu transfers, %lu NACKs, "
+        "%lu B written to the FRAM | USB tx usb0 %llu B usb1 %llu B\n",
+        board,
+        (unsigned long) can.tx_frames,
+        (unsigned long) can.tx_no_ack,
+        (unsigned long) can.tx_full,
+        (unsigned long) can.rx_frames,
+        (unsigned long) can.rx_filtered,
+        (unsigned long) i2c.transfers,
+        (unsigned long) i2c.nacks,
+        (unsigned long) i2c.fram_writes,
+        (unsigned long long) usb_tx[0],
+        (unsigned long long) usb_tx[1]);
+
+    size_t size;
+    const uint8_t *fram = Sim_FRAM_Image(&size);
+    printf("%s: FRAM\n", board);
+    for (size_t offset = 0U; offset < size; offset += FRAM_DUMP_BYTES_PER_LINE)
+    {
+        printf("%04zx ", offset);
+        for (size_t i = offset; (i < (offset + FRAM_DUMP_BYTES_PER_LINE)) && (i < size); i++)
+        {
+            printf(" %02x", fram[i]);
+        }
+        printf("\n");
+    }
+    fflush(stdout);
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Every post to an AO queue, direct, published or from a time event, counted on its way
+ *          into QP
+ **************************************************************************************************/
+bool __wrap_QActive_post_(
+    QActive *const me, QEvt const *const e, uint_fast16_t const margin, void const *const sender)
+{
+    __atomic_add_fetch(&s_posts[me->prio], 1U, __ATOMIC_RELAXED);
+    return __real_QActive_post_(me, e, margin, sender);
+}
+
+void __wrap_QActive_postLIFO_(QActive *const me, QEvt const *const e)
+{
+    __atomic_add_fetch(&s_posts[me->prio], 1U, __ATOMIC_RELAXED);
+    __real_QActive_postLIFO_(me, e);
+}
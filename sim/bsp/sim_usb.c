@@ -0,0 +1,310 @@
+#include "bsp.h"
+#include "qpc.h"
+#include "sim.h"
+#include "tusb.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+Q_DEFINE_THIS_MODULE("sim_usb.c")
+
+/**************************************************************************************************\
+* Private macros
+\**************************************************************************************************/
+
+#define USB_INTERFACE_CLI   0
+#define USB_INTERFACE_LOG   1
+#define USB_INTERFACE_COUNT 2
+#define CDC_RX_FIFO_SIZE    1024U // CFG_TUD_CDC_RX_BUFSIZE on the board is 64, the PTY buffers more
+
+/**************************************************************************************************\
+* Private type definitions
+\**************************************************************************************************/
+
+// a CDC interface: the master side of a pseudo-terminal, the host program opens the slave
+typedef struct
+{
+    int master; // -1 in virtual time, with nothing connected
+    uint64_t tx_bytes; // written by the board, for the report at power off
+    int slave; // kept open so the master never reads EIO between host connections
+    char link[256];
+    uint8_t rx_fifo[CDC_RX_FIFO_SIZE];
+    uint32_t rx_head;
+    uint32_t rx_count;
+    Serial_IO_Data_Ready_Callback data_ready_cb;
+    void *data_ready_cb_data;
+} CDC_Interface_T;
+
+/**************************************************************************************************\
+* Private prototypes
+\**************************************************************************************************/
+
+static void open_interface(CDC_Interface_T *cdc, const char *name, const char *role);
+static void remove_links(void);
+static uint16_t USB0_TransmitData(const uint8_t *data_ptr, const uint16_t data_len);
+static uint16_t USB0_ReceiveData(uint8_t *data_ptr, const uint16_t max_data_len);
+static void USB0_RegisterDataReadyCB(Serial_IO_Data_Ready_Callback cb, void *cb_data);
+static uint16_t USB1_TransmitData(const uint8_t *data_ptr, const uint16_t data_len);
+static uint16_t USB1_ReceiveData(uint8_t *data_ptr, const uint16_t max_data_len);
+static void USB1_RegisterDataReadyCB(Serial_IO_Data_Ready_Callback cb, void *cb_data);
+
+/**************************************************************************************************\
+* Private memory declarations
+\**************************************************************************************************/
+
+static CDC_Interface_T s_cdc[USB_INTERFACE_COUNT];
+
+static const Serial_IO_T s_bsp_serial_io_usb0 = {
+    .tx_func          = USB0_TransmitData,
+    .rx_func          = USB0_ReceiveData,
+    .register_cb_func = USB0_RegisterDataReadyCB,
+};
+
+static const Serial_IO_T s_bsp_serial_io_usb1 = {
+    .tx_func          = USB1_TransmitData,
+    .rx_func          = USB1_ReceiveData,
+    .register_cb_func = USB1_RegisterDataReadyCB,
+};
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+bool tud_init(uint8_t rhport)
+{
+    Q_UNUSED_PAR(rhport);
+
+    // in virtual time a host that reads everything at once, and never sends
+    if (Sim_Virtual_Time())
+    {
+        s_cdc[USB_INTERFACE_CLI].master = -1;
+        s_cdc[USB_INTERFACE_LOG].master = -1;
+        return true;
+    }
+
+    open_interface(&s_cdc[USB_INTERFACE_CLI], "usb0", "CLI, pc_com");
+    open_interface(&s_cdc[USB_INTERFACE_LOG], "usb1", "log");
+    atexit(remove_links);
+
+    return true;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Move what the host sent into the RX FIFOs, in the USB AO like the device stack
+ **************************************************************************************************/
+void tud_task(void)
+{
+    for (uint8_t itf = 0U; itf < USB_INTERFACE_COUNT; itf++)
+    {
+        CDC_Interface_T *cdc = &s_cdc[itf];
+        bool received        = false;
+
+        while ((cdc->master >= 0) && (cdc->rx_count < CDC_RX_FIFO_SIZE))
+        {
+            uint32_t tail  = (cdc->rx_head + cdc->rx_count) % CDC_RX_FIFO_SIZE;
+            uint32_t space = (tail >= cdc->rx_head) ? (CDC_RX_FIFO_SIZE - tail)
+                                                    : (cdc->rx_head - tail);
+
+            ssize_t n = read(cdc->master, &cdc->rx_fifo[tail], space);
+            if (n <= 0)
+            {
+                break;
+            }
+            cdc->rx_count += (uint32_t) n;
+            received = true;
+        }
+
+        if (received)
+        {
+            tud_cdc_rx_cb(itf);
+        }
+    }
+}
+
+uint32_t tud_cdc_n_available(uint8_t itf)
+{
+    Q_ASSERT(itf < USB_INTERFACE_COUNT);
+    return s_cdc[itf].rx_count;
+}
+
+uint32_t tud_cdc_n_read(uint8_t itf, void *buffer, uint32_t bufsize)
+{
+    Q_ASSERT(itf < USB_INTERFACE_COUNT);
+
+    CDC_Interface_T *cdc = &s_cdc[itf];
+    uint8_t *out         = buffer;
+    uint32_t count       = 0U;
+
+    while ((count < bufsize) && (cdc->rx_count > 0U))
+    {
+        out[count++] = cdc->rx_fifo[cdc->rx_head];
+        cdc->rx_head = (cdc->rx_head + 1U) % CDC_RX_FIFO_SIZE;
+        cdc->rx_count--;
+    }
+
+    return count;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Write to the host. With nobody reading, the PTY fills up and the rest is dropped, as
+ *          the TX FIFO does on the board with the port closed.
+ **************************************************************************************************/
+uint32_t tud_cdc_n_write(uint8_t itf, void const *buffer, uint32_t bufsize)
+{
+    Q_ASSERT(itf < USB_INTERFACE_COUNT);
+
+    CDC_Interface_T *cdc = &s_cdc[itf];
+    ssize_t n = (cdc->master >= 0) ? write(cdc->master, buffer, bufsize) : (ssize_t) bufsize;
+    if (n <= 0)
+    {
+        return 0U;
+    }
+
+    cdc->tx_bytes += (uint64_t) n;
+    return (uint32_t) n;
+}
+
+uint32_t tud_cdc_n_write_flush(uint8_t itf)
+{
+    Q_UNUSED_PAR(itf);
+    return 0U;
+}
+
+// Invoked when CDC interface received data from host
+void tud_cdc_rx_cb(uint8_t itf)
+{
+    CDC_Interface_T *cdc = &s_cdc[itf];
+
+    if (cdc->data_ready_cb != NULL)
+    {
+        cdc->data_ready_cb(cdc->data_ready_cb_data);
+    }
+}
+
+void Sim_USB_Get_Tx_Bytes(uint64_t tx_bytes[2])
+{
+    for (uint8_t itf = 0U; itf < USB_INTERFACE_COUNT; itf++)
+    {
+        tx_bytes[itf] = s_cdc[itf].tx_bytes;
+    }
+}
+
+/**
+ ***************************************************************************************************
+ *
+ * @brief   USB0 Interface Getter
+ *
+ **************************************************************************************************/
+const Serial_IO_T *BSP_Get_Serial_IO_Interface_USB0()
+{
+    return &s_bsp_serial_io_usb0;
+}
+
+/**
+ ***************************************************************************************************
+ *
+ * @brief   USB1 Interface Getter
+ *
+ **************************************************************************************************/
+const Serial_IO_T *BSP_Get_Serial_IO_Interface_USB1()
+{
+    return &s_bsp_serial_io_usb1;
+}
+
+/**************************************************************************************************\
+* Private functions
+\**************************************************************************************************/
+
+static void open_interface(CDC_Interface_T *cdc, const char *name, const char *role)
+{
+    struct termios raw;
+    int error;
+
+    cdc->master = posix_openpt(O_RDWR | O_NOCTTY);
+    Q_ASSERT(cdc->master >= 0);
+    error = grantpt(cdc->master) | unlockpt(cdc->master);
+    Q_ASSERT(error == 0);
+    (void) fcntl(cdc->master, F_SETFD, FD_CLOEXEC);
+    (void) fcntl(cdc->master, F_SETFL, O_NONBLOCK);
+
+    const char *slave_path = ptsname(cdc->master);
+    Q_ASSERT(slave_path != NULL);
+
+    // a CDC ACM port passes bytes through, whatever settings the host program leaves
+    cdc->slave = open(slave_path, O_RDWR | O_NOCTTY | O_CLOEXEC);
+    Q_ASSERT(cdc->slave >= 0);
+    error = tcgetattr(cdc->slave, &raw);
+    Q_ASSERT(error == 0);
+    cfmakeraw(&raw);
+    error = tcsetattr(cdc->slave, TCSANOW, &raw);
+    Q_ASSERT(error == 0);
+
+    Sim_State_Path(cdc->link, sizeof(cdc->link), name);
+    (void) unlink(cdc->link);
+    if (symlink(slave_path, cdc->link) != 0)
+    {
+        fprintf(stderr, "%s: %s: %s\n", Sim_Board_Name(), cdc->link, strerror(errno));
+        cdc->link[0] = '\0';
+    }
+
+    printf("%s: USB %s (%s) on %s -> %s\n", Sim_Board_Name(), name, role, cdc->link, slave_path);
+}
+
+static void remove_links(void)
+{
+    for (uint32_t itf = 0U; itf < USB_INTERFACE_COUNT; itf++)
+    {
+        if (s_cdc[itf].link[0] != '\0')
+        {
+            (void) unlink(s_cdc[itf].link);
+        }
+    }
+}
+
+/**
+ ***************************************************************************************************
+ *  @brief   Functions for USB
+ **************************************************************************************************/
+static uint16_t USB0_TransmitData(const uint8_t *data_ptr, const uint16_t data_len)
+{
+    uint16_t n_written = tud_cdc_n_write(USB_INTERFACE_CLI, data_ptr, data_len);
+    tud_cdc_n_write_flush(USB_INTERFACE_CLI);
+
+    return n_written;
+}
+
+static uint16_t USB0_ReceiveData(uint8_t *data_ptr, const uint16_t max_data_len)
+{
+    return (uint16_t) tud_cdc_n_read(USB_INTERFACE_CLI, data_ptr, max_data_len);
+}
+
+static void USB0_RegisterDataReadyCB(Serial_IO_Data_Ready_Callback cb, void *cb_data)
+{
+    s_cdc[USB_INTERFACE_CLI].data_ready_cb      = cb;
+    s_cdc[USB_INTERFACE_CLI].data_ready_cb_data = cb_data;
+}
+
+static uint16_t USB1_TransmitData(const uint8_t *data_ptr, const uint16_t data_len)
+{
+    uint16_t n_written = tud_cdc_n_write(USB_INTERFACE_LOG, data_ptr, data_len);
+    tud_cdc_n_write_flush(USB_INTERFACE_LOG);
+
+    return n_written;
+}
+
+static uint16_t USB1_ReceiveData(uint8_t *data_ptr, const uint16_t max_data_len)
+{
+    return (uint16_t) tud_cdc_n_read(USB_INTERFACE_LOG, data_ptr, max_data_len);
+}
+
+static void USB1_RegisterDataReadyCB(Serial_IO_Data_Ready_Callback cb, void *cb_data)
+{
+    s_cdc[USB_INTERFACE_LOG].data_ready_cb      = cb;
+    s_cdc[USB_INTERFACE_LOG].data_ready_cb_data = cb_data;
+}
@@ -0,0 +1,19 @@
+#include "app_start.h"
+#include "bsp.h"
+#include "qpc.h"
+#include "reset.h"
+#include "sim.h"
+
+// the gauge board's main() without CubeMX: the application starts the same way as on the board
+int main(int argc, char *argv[])
+{
+    Sim_Init(argc, argv, SIM_BOARD_GAUGE);
+
+    Reset_Init();
+    QF_init(); // initialize the framework and the underlying RT kernel
+
+    BSP_Init();
+    App_Start(); // event pools, publish-subscribe and the AOs
+
+    return QF_run(); // run the QF application
+}
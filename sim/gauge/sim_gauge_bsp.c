@@ -0,0 +1,78 @@
+#include "bsp.h" // Board Support Package
+#include "cpu_load.h"
+#include "qpc.h"
+#include "sim.h"
+#include "tusb.h"
+#include <stdio.h>
+
+/**************************************************************************************************\
+* Private memory declarations
+\**************************************************************************************************/
+
+// what the DACs, TIM8 and the backlight switch last drove the gauges with
+static float s_pressure_v;
+static float s_temperature_v;
+static float s_opamp_ref_v;
+static uint32_t s_rpm;
+static bool s_backlight;
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+void BSP_Init(void)
+{
+    // initialize TinyUSB device stack on configured roothub port
+    tud_init(BOARD_TUD_RHPORT);
+
+    BSP_Cycle_Counter_Init();
+    CPU_Load_Start();
+
+    Sim_I2C_Init();
+}
+
+void BSP_Gauge_SetPressure_V(float volts)
+{
+    s_pressure_v = volts;
+}
+
+void BSP_Gauge_SetTemperature_V(float volts)
+{
+    s_temperature_v = volts;
+}
+
+void BSP_Gauge_SetOpAmpRef_V(float volts)
+{
+    s_opamp_ref_v = volts;
+}
+
+void BSP_RpmGauge_SetPFM_RPM(uint32_t RPM)
+{
+    s_rpm = RPM;
+}
+
+/**
+ * @brief Read digital input from backlight switch, always on in the simulation
+ */
+bool BSP_Get_Backlight(void)
+{
+    return true;
+}
+
+void BSP_Set_Backlight(bool x)
+{
+    s_backlight = x;
+}
+
+void Sim_Board_Status(char *line, size_t size)
+{
+    snprintf(
+        line,
+        size,
+        "gauges %lu rpm pressure %.2f V temperature %.2f V ref %.2f V%s",
+        (unsigned long) s_rpm,
+        (double) s_pressure_v,
+        (double) s_temperature_v,
+        (double) s_opamp_ref_v,
+        s_backlight ? " backlight" : "");
+}
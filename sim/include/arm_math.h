@@ -0,0 +1,6 @@
+#ifndef SIM_ARM_MATH_H_
+#define SIM_ARM_MATH_H_
+
+// Host simulation stand-in for CMSIS-DSP, flowsensor.h includes it but the simulation uses none of it
+
+#endif // SIM_ARM_MATH_H_
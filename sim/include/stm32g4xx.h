@@ -0,0 +1,27 @@
+#ifndef SIM_STM32G4XX_H_
+#define SIM_STM32G4XX_H_
+
+// Host simulation stand-in for the device header: the FDCAN data length codes the CAN message
+// registry is written in, the values of the STM32G4 HAL.
+
+#include "stm32g4xx_hal.h"
+#include <stdint.h>
+
+#define FDCAN_DLC_BYTES_0  0U
+#define FDCAN_DLC_BYTES_1  1U
+#define FDCAN_DLC_BYTES_2  2U
+#define FDCAN_DLC_BYTES_3  3U
+#define FDCAN_DLC_BYTES_4  4U
+#define FDCAN_DLC_BYTES_5  5U
+#define FDCAN_DLC_BYTES_6  6U
+#define FDCAN_DLC_BYTES_7  7U
+#define FDCAN_DLC_BYTES_8  8U
+#define FDCAN_DLC_BYTES_12 9U
+#define FDCAN_DLC_BYTES_16 10U
+#define FDCAN_DLC_BYTES_20 11U
+#define FDCAN_DLC_BYTES_24 12U
+#define FDCAN_DLC_BYTES_32 13U
+#define FDCAN_DLC_BYTES_48 14U
+#define FDCAN_DLC_BYTES_64 15U
+
+#endif // SIM_STM32G4XX_H_
@@ -0,0 +1,61 @@
+#ifndef SIM_STM32G4XX_HAL_H_
+#define SIM_STM32G4XX_HAL_H_
+
+// Host simulation stand-in for the HAL and CMSIS names the application modules use directly: the
+// TIM8 pulse counter LMT01.c reads (counted by the motor's sensor model), and what reset.c's jump
+// into the ROM bootloader touches, which the simulation never takes.
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum
+{
+    HAL_OK      = 0x00U,
+    HAL_ERROR   = 0x01U,
+    HAL_BUSY    = 0x02U,
+    HAL_TIMEOUT = 0x03U,
+} HAL_StatusTypeDef;
+
+typedef struct
+{
+    volatile uint32_t counter; // CNT, counted up by the simulated input
+} TIM_HandleTypeDef;
+
+typedef struct
+{
+    volatile uint32_t VTOR;
+} SCB_Type;
+
+typedef struct
+{
+    volatile uint32_t MEMRMP;
+} SYSCFG_TypeDef;
+
+extern SCB_Type Sim_SCB;
+extern SYSCFG_TypeDef Sim_SYSCFG;
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define __HAL_TIM_GET_COUNTER(htim)        ((uint16_t) ((htim)->counter))
+#define __HAL_TIM_SET_COUNTER(htim, value) ((htim)->counter = (value))
+
+#define SCB        (&Sim_SCB)
+#define SYSCFG     (&Sim_SYSCFG)
+#define FLASH_BASE 0x08000000UL
+
+#define __HAL_RCC_USB_CLK_DISABLE()    ((void) 0)
+#define __HAL_RCC_USB_FORCE_RESET()    ((void) 0)
+#define __HAL_RCC_USB_RELEASE_RESET()  ((void) 0)
+#define __HAL_RCC_SYSCFG_CLK_ENABLE()  ((void) 0)
+#define HAL_PWR_EnableBkUpAccess()     ((void) 0)
+#define __disable_irq()                ((void) 0)
+#define __set_MSP(top_of_main_stack)   ((void) (top_of_main_stack))
+
+#endif // SIM_STM32G4XX_HAL_H_
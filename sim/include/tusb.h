@@ -0,0 +1,31 @@
+#ifndef SIM_TUSB_H_
+#define SIM_TUSB_H_
+
+// Host simulation stand-in for TinyUSB: the device stack calls the BSP and usb.c make, with each
+// CDC interface a pseudo-terminal (sim_usb.c). tud_task() runs in the USB AO as on the board.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BOARD_TUD_RHPORT 0
+
+bool tud_init(uint8_t rhport);
+void tud_task(void);
+
+uint32_t tud_cdc_n_available(uint8_t itf);
+uint32_t tud_cdc_n_read(uint8_t itf, void *buffer, uint32_t bufsize);
+uint32_t tud_cdc_n_write(uint8_t itf, void const *buffer, uint32_t bufsize);
+uint32_t tud_cdc_n_write_flush(uint8_t itf);
+
+// invoked from tud_task() when a CDC interface received data, implemented by the BSP
+void tud_cdc_rx_cb(uint8_t itf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SIM_TUSB_H_
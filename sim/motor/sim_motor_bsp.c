@@ -0,0 +1,475 @@
+#include "bsp.h" // Board Support Package
+#include "cpu_load.h"
+#include "flowsensor.h"
+#include "qpc.h"
+#include "sensor_trace.h"
+#include "sim.h"
+#include "stm32g4xx_hal.h"
+#include "tusb.h"
+#include "vbat_sensor.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**************************************************************************************************\
+* Private macros
+\**************************************************************************************************/
+
+// the VBAT chain of the board's bsp.c, run backwards to make ADC counts from volts
+#define AVREF                      2.9f
+#define VBAT_ADC_FULL_SCALE_COUNTS 4096.0f
+#define VBAT_DIVIDER_RATIO         4.6f
+#define VBAT_CAL_SCALE             1.5633f
+#define VBAT_CAL_OFFSET            0.81196f
+#define VBAT_VOLTS_PER_COUNT \
+    (AVREF / VBAT_ADC_FULL_SCALE_COUNTS * VBAT_DIVIDER_RATIO * VBAT_CAL_SCALE)
+
+#define TACH_HZ_TO_RPM (60.0f / 6.666f) // as director.c turns the tach frequency into RPM
+
+// TIM15 captures the tach period at 2 MHz, and flowsensor.c reads 0 Hz once a whole 16 bit
+// period of the timer passes without an edge
+#define TIM15_HZ        2000000.0f
+#define TIM15_PERIOD_NS ((65536ULL * 1000000000ULL) / 2000000ULL)
+
+#define REPLAY_TAIL_NS 1000000000ULL // after the last record, for the AOs to catch up
+
+// LMT01: 0.0625 C per pulse from -50 C, a pulse train of up to 54 ms every ~104 ms
+#define LMT01_PULSE_TRAIN_MS 50U
+#define LMT01_PERIOD_MS      104U
+
+#define ENGINE_RPM_TAU_S         0.5f
+#define ENGINE_TEMPERATURE_TAU_S 60.0f
+#define AMBIENT_TEMPERATURE_C    20.0f
+#define RUNNING_TEMPERATURE_C    75.0f
+#define OVERHEATING_C            95.0f
+
+/**************************************************************************************************\
+* Private type definitions
+\**************************************************************************************************/
+
+// one step of the engine scenario, which repeats; each time round, the durations and the RPM
+// are scaled by a random factor from --seed
+typedef struct
+{
+    const char *name;
+    uint32_t duration_ms;
+    float rpm;
+    bool neutral;
+    bool start;
+    float vbat;
+} Engine_Phase_T;
+
+/**************************************************************************************************\
+* Private prototypes
+\**************************************************************************************************/
+
+static void sensor_handler(void);
+static void start_phase(uint32_t phase);
+static float random_between(float low, float high);
+static void start_replay(const char *path);
+static void replay_handler(Sim_Timer_T *timer);
+static void replay_record(const Sensor_Trace_Record_T *record);
+
+/**************************************************************************************************\
+* Private memory declarations
+\**************************************************************************************************/
+
+static const Engine_Phase_T s_scenario[] = {
+    {"off", 5000U, 0.0f, true, false, 12.6f},
+    {"cranking", 2000U, 250.0f, true, true, 10.5f},
+    {"idle", 20000U, 900.0f, true, false, 14.2f},
+    {"cruise", 60000U, 4500.0f, false, false, 14.4f},
+    {"idle", 20000U, 900.0f, true, false, 14.2f},
+    {"off", 10000U, 0.0f, true, false, 12.6f},
+};
+
+TIM_HandleTypeDef htim8; // LMT01 pulse counter
+
+// circular DMA target for ADC2, each half is one VBAT block
+static uint16_t s_vbat_adc_dma_buffer[2U * BSP_ADC_VBAT_BLOCK_LEN];
+static uint32_t s_vbat_adc_index;
+
+static uint32_t s_phase;
+static uint32_t s_phase_ms;
+static uint32_t s_phase_duration_ms;
+static float s_phase_rpm;
+static uint32_t s_ms;
+static float s_rpm;
+static float s_temperature = AMBIENT_TEMPERATURE_C;
+static float s_lmt01_pulses; // still to come in this pulse train
+static float s_tach_cycles;  // of the tach signal since its last edge
+
+// --replay: the sensors follow a recorded sensor trace instead of the scenario
+static bool s_replaying;
+static Sim_Timer_T s_replay_timer;
+static Sensor_Trace_Reader_T s_replay_reader;
+static Sensor_Trace_Record_T s_replay_next;
+static bool s_replay_done;
+static uint32_t s_replay_records;
+static uint32_t s_replay_lost;             // on the board while recording
+static uint32_t s_replay_pressure_skipped; // the Pressure AO isn't part of the simulation
+static float s_replay_tach_hz;
+static uint64_t s_replay_tach_edge_ns;
+static float s_replay_vbat_counts;
+static uint32_t s_replay_gpio;
+
+/**************************************************************************************************\
+* Public functions
+\**************************************************************************************************/
+
+void BSP_Init(void)
+{
+    // initialize TinyUSB device stack on configured roothub port
+    tud_init(BOARD_TUD_RHPORT);
+
+    BSP_Cycle_Counter_Init();
+    CPU_Load_Start();
+
+    if (Sim_Replay_Path() != NULL)
+    {
+        start_replay(Sim_Replay_Path());
+    }
+    else
+    {
+        start_phase(0U);
+    }
+
+    // TIM6 triggers the VBAT ADC at 1 kHz, the same interrupt drives the rest of the engine
+    Sim_Add_Periodic_Interrupt(
+        "TIM6 ADC2", 1000000U / BSP_ADC_VBAT_SAMPLE_RATE_HZ, sensor_handler);
+
+    Sim_I2C_Init();
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim)
+{
+    Q_UNUSED_PAR(htim);
+    return HAL_OK;
+}
+
+float Flow_Sensor_Read_Hz()
+{
+    if (s_replaying)
+    {
+        return ((Sim_Now_Ns() - s_replay_tach_edge_ns) > TIM15_PERIOD_NS) ? 0.0f : s_replay_tach_hz;
+    }
+    return s_rpm / TACH_HZ_TO_RPM;
+}
+
+void Flow_Sensor_IC_Callback(TIM_HandleTypeDef *htim, uint32_t tim_channel)
+{
+    Q_UNUSED_PAR(htim);
+    Q_UNUSED_PAR(tim_channel);
+}
+
+void Flow_Sensor_Period_Elapsed_Callback(TIM_HandleTypeDef *htim)
+{
+    Q_UNUSED_PAR(htim);
+}
+
+int32_t BSP_Get_Flow_Sensor_IRQN(void)
+{
+    return 0;
+}
+
+void BSP_Put_Pressure_Sensor_Into_Reset(bool reset)
+{
+    Q_UNUSED_PAR(reset);
+}
+
+bool BSP_Get_Neutral()
+{
+    if (s_replaying)
+    {
+        return (s_replay_gpio & SENSOR_TRACE_GPIO_NEUTRAL) != 0U;
+    }
+    return s_scenario[s_phase].neutral;
+}
+
+bool BSP_Get_Start()
+{
+    if (s_replaying)
+    {
+        return (s_replay_gpio & SENSOR_TRACE_GPIO_START) != 0U;
+    }
+    return s_scenario[s_phase].start;
+}
+
+uint8_t BSP_Get_Temp_Good()
+{
+    if (s_replaying)
+    {
+        return (s_replay_gpio & SENSOR_TRACE_GPIO_TEMP_GOOD) != 0U;
+    }
+    return s_temperature < OVERHEATING_C;
+}
+
+uint8_t BSP_Get_Pres_Good()
+{
+    if (s_replaying)
+    {
+        return (s_replay_gpio & SENSOR_TRACE_GPIO_PRES_GOOD) != 0U;
+    }
+    return s_rpm > 0.5f * s_scenario[2].rpm; // the oil pressure switch closes near idle
+}
+
+bool BSP_Get_Buzzer()
+{
+    if (s_replaying)
+    {
+        return (s_replay_gpio & SENSOR_TRACE_GPIO_BUZZER) != 0U;
+    }
+    return false;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Get one half of the VBAT ADC DMA buffer
+ *
+ *          Only valid from the ADC half / full transfer complete callbacks, while the DMA is
+ *          filling the other half.
+ **************************************************************************************************/
+const uint16_t *BSP_ADC_Get_VBAT_Block(bool second_half)
+{
+    return second_half ? &s_vbat_adc_dma_buffer[BSP_ADC_VBAT_BLOCK_LEN] : &s_vbat_adc_dma_buffer[0];
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Convert (oversampled, 12 bit) VBAT ADC counts to volts
+ **************************************************************************************************/
+float BSP_ADC_VBAT_Counts_To_Volts(float counts)
+{
+    return VBAT_VOLTS_PER_COUNT * counts + VBAT_CAL_OFFSET;
+}
+
+void Sim_Board_Status(char *line, size_t size)
+{
+    if (s_replaying)
+    {
+        snprintf(
+            line,
+            size,
+            "replay %.1f s %lu records %.0f rpm %.2f V",
+            (double) s_replay_reader.timestamp_us / 1e6,
+            (unsigned long) s_replay_records,
+            (double) (Flow_Sensor_Read_Hz() * TACH_HZ_TO_RPM),
+            (double) BSP_ADC_VBAT_Counts_To_Volts(s_replay_vbat_counts));
+        return;
+    }
+
+    snprintf(
+        line,
+        size,
+        "engine %s %.0f rpm %.1f C %.2f V",
+        s_scenario[s_phase].name,
+        (double) s_rpm,
+        (double) s_temperature,
+        (double) s_scenario[s_phase].vbat);
+}
+
+/**************************************************************************************************\
+* Private functions
+\**************************************************************************************************/
+
+/**
+ ***************************************************************************************************
+ * @brief   1 ms of the engine: the scenario, the sensors following it, a VBAT conversion into the
+ *          DMA buffer with its half / full transfer callbacks, and LMT01 pulses into TIM8. When
+ *          replaying, only the VBAT conversion, of the recorded level.
+ **************************************************************************************************/
+static void sensor_handler(void)
+{
+    const float dt_s = 0.001f;
+
+    if (s_replaying)
+    {
+        s_vbat_adc_dma_buffer[s_vbat_adc_index++] = (uint16_t) (s_replay_vbat_counts + 0.5f);
+        if (s_vbat_adc_index == BSP_ADC_VBAT_BLOCK_LEN)
+        {
+            VBAT_Sensor_Block_Callback(BSP_ADC_Get_VBAT_Block(false), BSP_ADC_VBAT_BLOCK_LEN);
+        }
+        else if (s_vbat_adc_index == (2U * BSP_ADC_VBAT_BLOCK_LEN))
+        {
+            s_vbat_adc_index = 0U;
+            VBAT_Sensor_Block_Callback(BSP_ADC_Get_VBAT_Block(true), BSP_ADC_VBAT_BLOCK_LEN);
+        }
+        return;
+    }
+
+    if (++s_phase_ms >= s_phase_duration_ms)
+    {
+        start_phase((s_phase + 1U) % (sizeof(s_scenario) / sizeof(s_scenario[0])));
+    }
+    const Engine_Phase_T *phase = &s_scenario[s_phase];
+    s_ms++;
+
+    // first order lags towards the phase's values
+    s_rpm += (s_phase_rpm - s_rpm) * (dt_s / ENGINE_RPM_TAU_S);
+    float temperature_target = (s_phase_rpm > 0.0f) ? RUNNING_TEMPERATURE_C : AMBIENT_TEMPERATURE_C;
+    s_temperature += (temperature_target - s_temperature) * (dt_s / ENGINE_TEMPERATURE_TAU_S);
+
+    // the tach edges TIM15 would capture, which only a sensor trace recorded from the scenario
+    // sees, flowsensor.c isn't part of the simulation
+    float tach_hz = s_rpm / TACH_HZ_TO_RPM;
+    s_tach_cycles += tach_hz * dt_s;
+    while (s_tach_cycles >= 1.0f)
+    {
+        s_tach_cycles -= 1.0f;
+        Sensor_Trace_Record(SENSOR_TRACE_TACH_PERIOD, (uint32_t) (TIM15_HZ / tach_hz));
+    }
+
+    // ADC2, the DMA wraps around the buffer
+    float counts = (phase->vbat - VBAT_CAL_OFFSET) / VBAT_VOLTS_PER_COUNT;
+    s_vbat_adc_dma_buffer[s_vbat_adc_index++] = (uint16_t) (counts + 0.5f);
+    if (s_vbat_adc_index == BSP_ADC_VBAT_BLOCK_LEN)
+    {
+        VBAT_Sensor_Block_Callback(BSP_ADC_Get_VBAT_Block(false), BSP_ADC_VBAT_BLOCK_LEN);
+    }
+    else if (s_vbat_adc_index == (2U * BSP_ADC_VBAT_BLOCK_LEN))
+    {
+        s_vbat_adc_index = 0U;
+        VBAT_Sensor_Block_Callback(BSP_ADC_Get_VBAT_Block(true), BSP_ADC_VBAT_BLOCK_LEN);
+    }
+
+    // LMT01, the pulses of one conversion spread over the train, then quiet until the next
+    uint32_t lmt01_ms = s_ms % LMT01_PERIOD_MS;
+    if (lmt01_ms == 0U)
+    {
+        s_lmt01_pulses = (s_temperature + 50.0f) / 0.0625f;
+    }
+    if (lmt01_ms < LMT01_PULSE_TRAIN_MS)
+    {
+        float pulses = s_lmt01_pulses / (float) (LMT01_PULSE_TRAIN_MS - lmt01_ms);
+        htim8.counter += (uint32_t) pulses;
+        s_lmt01_pulses -= (float) (uint32_t) pulses;
+    }
+}
+
+static void start_phase(uint32_t phase)
+{
+    s_phase             = phase;
+    s_phase_ms          = 0U;
+    s_phase_duration_ms = (uint32_t) ((float) s_scenario[phase].duration_ms *
+                                      random_between(0.5f, 1.5f));
+    s_phase_rpm         = s_scenario[phase].rpm * random_between(0.8f, 1.2f);
+}
+
+static float random_between(float low, float high)
+{
+    return low + ((high - low) * ((float) Sim_Random() / 4294967296.0f));
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Read a whole sensor trace and play it back from power on, in place of the scenario
+ **************************************************************************************************/
+static void start_replay(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "%s: %s: %s\n", Sim_Board_Name(), path, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+
+    fseek(file, 0L, SEEK_END);
+    long length = ftell(file);
+    rewind(file);
+    uint8_t *data = malloc((length > 0L) ? (size_t) length : 1U);
+    if (data == NULL)
+    {
+        fprintf(stderr, "%s: %s: too big to replay\n", Sim_Board_Name(), path);
+        exit(EXIT_FAILURE);
+    }
+    size_t read = fread(data, 1U, (size_t) length, file);
+    fclose(file);
+
+    if (!Sensor_Trace_Reader_Init(&s_replay_reader, data, read))
+    {
+        fprintf(stderr, "%s: %s: not a sensor trace\n", Sim_Board_Name(), path);
+        exit(EXIT_FAILURE);
+    }
+
+    s_replaying = true;
+    Sim_Timer_Init(&s_replay_timer, "replay", replay_handler);
+    if (Sensor_Trace_Reader_Next(&s_replay_reader, &s_replay_next))
+    {
+        Sim_Timer_Arm(&s_replay_timer, s_replay_next.timestamp_us * 1000U);
+    }
+    else
+    {
+        s_replay_done = true;
+        Sim_Timer_Arm(&s_replay_timer, REPLAY_TAIL_NS);
+    }
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   The records that are due, then a wait for the next one. A second after the last, the
+ *          board is powered off.
+ **************************************************************************************************/
+static void replay_handler(Sim_Timer_T *timer)
+{
+    if (s_replay_done)
+    {
+        fprintf(
+            stderr,
+            "%s: replay of %s%s: %lu records over %.1f s, %lu lost while recording, "
+            "%lu pressure readings not replayed\n",
+            Sim_Board_Name(),
+            Sim_Replay_Path(),
+            s_replay_reader.corrupt ? " (cut short)" : "",
+            (unsigned long) s_replay_records,
+            (double) s_replay_reader.timestamp_us / 1e6,
+            (unsigned long) s_replay_lost,
+            (unsigned long) s_replay_pressure_skipped);
+        Sim_Power_Off();
+    }
+
+    uint64_t due_us = s_replay_next.timestamp_us;
+    do
+    {
+        replay_record(&s_replay_next);
+        if (!Sensor_Trace_Reader_Next(&s_replay_reader, &s_replay_next))
+        {
+            s_replay_done = true;
+            Sim_Timer_Arm(timer, (due_us * 1000U) + REPLAY_TAIL_NS);
+            return;
+        }
+    } while (s_replay_next.timestamp_us == due_us);
+
+    Sim_Timer_Arm(timer, s_replay_next.timestamp_us * 1000U);
+}
+
+// a recorded input, into the peripheral it came from
+static void replay_record(const Sensor_Trace_Record_T *record)
+{
+    s_replay_records++;
+
+    switch (record->type)
+    {
+        case SENSOR_TRACE_TACH_PERIOD:
+            s_replay_tach_hz = (record->value > 0U) ? (TIM15_HZ / (float) record->value) : 0.0f;
+            s_replay_tach_edge_ns = Sim_Now_Ns();
+            break;
+        case SENSOR_TRACE_LMT01_COUNT:
+            htim8.counter = record->value; // the pulse train is over when LMT01.c reads it
+            break;
+        case SENSOR_TRACE_PRESSURE_COUNTS:
+            s_replay_pressure_skipped++;
+            break;
+        case SENSOR_TRACE_VBAT_MEAN:
+            s_replay_vbat_counts = (float) record->value / (float) SENSOR_TRACE_VBAT_SCALE;
+            break;
+        case SENSOR_TRACE_GPIO:
+            s_replay_gpio = record->value;
+            break;
+        case SENSOR_TRACE_LOST:
+            s_replay_lost += record->value;
+            break;
+        default:
+            break;
+    }
+}
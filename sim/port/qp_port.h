@@ -0,0 +1,59 @@
+#ifndef QP_PORT_H_
+#define QP_PORT_H_
+
+// QP/C port for the host simulation: the cooperative QV kernel (qpc/src/qv/qv.c, unchanged) with
+// its event loop on the main thread, and the simulated interrupts on POSIX threads of their own.
+//
+// "Disabling interrupts" locks one recursive mutex. An interrupt thread holds it for the whole
+// handler (QV_ISR_ENTRY/EXIT), so handlers never run inside a critical section, and they can post
+// and publish, which enters the critical section again. The idle event loop sleeps on a condition
+// variable with the mutex released, and every interrupt exit wakes it.
+
+#include <stdbool.h> // Boolean type.      WG14/N843 C99 Standard
+#include <stdint.h>  // Exact-width types. WG14/N843 C99 Standard
+
+#ifdef QP_CONFIG
+#include "qp_config.h" // the firmware's configuration, ports/arm-cm/qk/config
+#endif
+
+// no-return function specifier (C11 Standard)
+#define Q_NORETURN _Noreturn void
+
+// QV event-queue used for AOs
+#define QACTIVE_EQUEUE_TYPE QEQueue
+
+// QF interrupt disable/enable and critical section
+#define QF_INT_DISABLE() (QF_enterCriticalSection_())
+#define QF_INT_ENABLE()  (QF_leaveCriticalSection_())
+
+#define QF_CRIT_STAT
+#define QF_CRIT_ENTRY() (QF_enterCriticalSection_())
+#define QF_CRIT_EXIT()  (QF_leaveCriticalSection_())
+
+#define QF_LOG2(n_) ((uint_fast8_t) (32 - __builtin_clz((unsigned) (n_))))
+
+// entry and exit of a simulated interrupt handler, on the thread of its peripheral (sim.h)
+#define QV_ISR_ENTRY() (QF_enterCriticalSection_())
+#define QV_ISR_EXIT()  (QF_isrExit_())
+
+// from QV_onIdle(), called in a critical section: sleep until the next interrupt exit and return
+// with the critical section left, as QV_CPU_SLEEP() does on ARM Cortex-M
+#define QV_CPU_SLEEP() (QF_cpuSleep_())
+
+// initialization of the QV kernel
+#define QV_INIT() (QF_portInit_())
+
+// include files -------------------------------------------------------------
+#include "qequeue.h" // QV kernel uses the native QP event queue
+#include "qmpool.h"  // QV kernel uses the native QP memory pool
+#include "qp.h"      // QP framework
+#include "qv.h"      // QV kernel
+
+// prototypes
+void QF_enterCriticalSection_(void);
+void QF_leaveCriticalSection_(void);
+void QF_isrExit_(void);
+void QF_cpuSleep_(void);
+void QF_portInit_(void);
+
+#endif // QP_PORT_H_
@@ -0,0 +1,42 @@
+#include "qp_port.h"
+#include <pthread.h>
+
+// every "interrupt disable" in QP and the simulated peripherals, see qp_port.h
+static pthread_mutex_t s_critical_section;
+
+// signalled at every simulated interrupt exit, the idle event loop waits on it
+static pthread_cond_t s_interrupt = PTHREAD_COND_INITIALIZER;
+
+void QF_portInit_(void)
+{
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&s_critical_section, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+void QF_enterCriticalSection_(void)
+{
+    pthread_mutex_lock(&s_critical_section);
+}
+
+void QF_leaveCriticalSection_(void)
+{
+    pthread_mutex_unlock(&s_critical_section);
+}
+
+void QF_isrExit_(void)
+{
+    pthread_mutex_unlock(&s_critical_section);
+    pthread_cond_signal(&s_interrupt);
+}
+
+void QF_cpuSleep_(void)
+{
+    // QV checked the ready set with the mutex held, so no post can slip in before the wait. A
+    // spurious wakeup just goes round the event loop once more.
+    pthread_cond_wait(&s_interrupt, &s_critical_section);
+    pthread_mutex_unlock(&s_critical_section);
+}
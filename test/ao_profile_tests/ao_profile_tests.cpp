@@ -0,0 +1,194 @@
+extern "C" {
+#include "ao_profile.h"
+#include "bsp_timestamp_fake.h"
+#include "private_signal_ranges.h"
+#include "pubsub_signals.h"
+}
+
+#include "cms_cpputest_qf_ctrl.hpp"
+
+#include "CppUTest/TestHarness.h"
+
+#include <cstring>
+
+using namespace cms::test;
+
+// Two AOs whose steps take a set number of microseconds, the fake cycle counter's unit. The low
+// priority one can also run a step of the high priority one in the middle of its own, as QK does
+// when it posts to it.
+static constexpr uint8_t HIGH_PRIORITY = qf_ctrl::RECORDER_PRIORITY + 1U;
+
+enum
+{
+    WORK_SIG    = PRIVATE_SIGNAL_LMT01_START, // counted in the "lmt01" range
+    PREEMPT_SIG = PRIVATE_SIGNAL_RANGE_MAX,   // in no range, counted in "other"
+};
+
+typedef struct
+{
+    QActive super;
+    uint32_t work_us;
+} Test_AO_T;
+
+static Test_AO_T s_low;
+static Test_AO_T s_high;
+static QEvt const *s_low_queue[4];
+static QEvt const *s_high_queue[4];
+
+static const char *const s_names[] = {nullptr, "low", nullptr, "high"};
+
+static QState test_ao_active(Test_AO_T *const me, QEvt const *const e)
+{
+    static QEvt const work = QEVT_INITIALIZER(WORK_SIG);
+
+    switch (e->sig)
+    {
+        case WORK_SIG:
+            BSP_TimestampFake_Advance_Microseconds(me->work_us);
+            return Q_HANDLED();
+
+        case PREEMPT_SIG:
+            BSP_TimestampFake_Advance_Microseconds(100U);
+            QASM_DISPATCH(&s_high.super, &work, HIGH_PRIORITY);
+            BSP_TimestampFake_Advance_Microseconds(100U);
+            return Q_HANDLED();
+
+        default:
+            return Q_SUPER(&QHsm_top);
+    }
+}
+
+static QState test_ao_initial(Test_AO_T *const me, void const *const par)
+{
+    (void) me;
+    (void) par;
+    return Q_TRAN(&test_ao_active);
+}
+
+static void start_test_ao(Test_AO_T *me, uint8_t prio, QEvt const **queue, uint32_t work_us)
+{
+    QActive_ctor(&me->super, Q_STATE_CAST(&test_ao_initial));
+    me->work_us = work_us;
+    QACTIVE_START(&me->super, prio, queue, 4U, nullptr, 0U, nullptr);
+}
+
+static void post(Test_AO_T *me, enum_t sig)
+{
+    QEvt event = QEVT_INITIALIZER(sig);
+    qf_ctrl::PostAndProcess(&event, &me->super);
+}
+
+static AO_Profile_Stats_T get_range(const char *name)
+{
+    AO_Profile_Stats_T stats;
+    for (size_t i = 0U; AO_Profile_Get_Signal_Range(i, &stats); i++)
+    {
+        if (strcmp(stats.name, name) == 0)
+        {
+            return stats;
+        }
+    }
+    FAIL("no such signal range");
+    return stats;
+}
+
+TEST_GROUP(AoProfileTests) {
+    void setup() final
+    {
+        BSP_TimestampFake_Reset();
+        qf_ctrl::Setup(PUBSUB_MAX_SIG, 1000);
+
+        start_test_ao(&s_low, qf_ctrl::UNIT_UNDER_TEST_PRIORITY, s_low_queue, 50U);
+        start_test_ao(&s_high, HIGH_PRIORITY, s_high_queue, 30U);
+        qf_ctrl::ProcessEvents();
+
+        AO_Profile_Start(s_names, Q_DIM(s_names));
+    }
+
+    void teardown() final
+    {
+        qf_ctrl::Teardown();
+    }
+};
+
+TEST(AoProfileTests, every_started_ao_is_profiled_by_priority)
+{
+    AO_Profile_Stats_T stats;
+
+    CHECK_TRUE(AO_Profile_Get_AO(0U, &stats));
+    STRCMP_EQUAL("low", stats.name);
+    CHECK_EQUAL(qf_ctrl::UNIT_UNDER_TEST_PRIORITY, stats.id);
+    CHECK_EQUAL(0U, stats.rtc_cycles.count);
+
+    CHECK_TRUE(AO_Profile_Get_AO(1U, &stats));
+    STRCMP_EQUAL("high", stats.name);
+    CHECK_EQUAL(HIGH_PRIORITY, stats.id);
+
+    CHECK_FALSE(AO_Profile_Get_AO(2U, &stats));
+}
+
+TEST(AoProfileTests, each_rtc_step_is_timed)
+{
+    AO_Profile_Stats_T stats;
+
+    post(&s_low, WORK_SIG);
+    post(&s_low, WORK_SIG);
+    post(&s_low, WORK_SIG);
+
+    AO_Profile_Get_AO(0U, &stats);
+    CHECK_EQUAL(3U, stats.rtc_cycles.count);
+    CHECK_EQUAL(50U, stats.rtc_cycles.min);
+    CHECK_EQUAL(50U, stats.rtc_cycles.max);
+    CHECK_EQUAL(150U, stats.rtc_cycles.sum);
+
+    AO_Profile_Get_AO(1U, &stats);
+    CHECK_EQUAL(0U, stats.rtc_cycles.count);
+}
+
+TEST(AoProfileTests, preempting_ao_is_not_counted_in)
+{
+    AO_Profile_Stats_T stats;
+
+    post(&s_low, PREEMPT_SIG);
+
+    AO_Profile_Get_AO(0U, &stats);
+    CHECK_EQUAL(1U, stats.rtc_cycles.count);
+    CHECK_EQUAL(200U, stats.rtc_cycles.max);
+
+    AO_Profile_Get_AO(1U, &stats);
+    CHECK_EQUAL(1U, stats.rtc_cycles.count);
+    CHECK_EQUAL(30U, stats.rtc_cycles.max);
+}
+
+TEST(AoProfileTests, steps_are_grouped_by_signal_range)
+{
+    post(&s_low, WORK_SIG);
+    post(&s_low, PREEMPT_SIG);
+
+    AO_Profile_Stats_T lmt01 = get_range("lmt01");
+    CHECK_EQUAL(PRIVATE_SIGNAL_LMT01_START, lmt01.id);
+    CHECK_EQUAL(2U, lmt01.rtc_cycles.count); // the low AO's and the preempting one's
+    CHECK_EQUAL(30U, lmt01.rtc_cycles.min);
+    CHECK_EQUAL(50U, lmt01.rtc_cycles.max);
+
+    AO_Profile_Stats_T other = get_range("other");
+    CHECK_EQUAL(1U, other.rtc_cycles.count);
+    CHECK_EQUAL(200U, other.rtc_cycles.max);
+
+    CHECK_EQUAL(0U, get_range("pubsub").rtc_cycles.count);
+}
+
+TEST(AoProfileTests, reset_clears_every_histogram)
+{
+    AO_Profile_Stats_T stats;
+
+    post(&s_low, PREEMPT_SIG);
+    AO_Profile_Reset();
+
+    AO_Profile_Get_AO(0U, &stats);
+    CHECK_EQUAL(0U, stats.rtc_cycles.count);
+    AO_Profile_Get_AO(1U, &stats);
+    CHECK_EQUAL(0U, stats.rtc_cycles.count);
+    CHECK_EQUAL(0U, get_range("other").rtc_cycles.count);
+    CHECK_EQUAL(AO_PROFILE_RTC_SHIFT, get_range("other").rtc_cycles.shift);
+}
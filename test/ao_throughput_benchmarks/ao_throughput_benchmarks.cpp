@@ -0,0 +1,540 @@
+extern "C" {
+#include "app_event_pools.h"
+#include "c/ConfigDB.pb.h"
+#include "c/MessageType.pb.h"
+#include "cli_commands.h"
+#include "config.h"
+#include "fault_manager.h"
+#include "fram.h"
+#include "log_com.h"
+#include "pc_com.h"
+#include "pc_com/crc16.h"
+#include "pc_com/hdlc.h"
+#include "pb_encode.h"
+#include "pubsub_signals.h"
+}
+
+#include "cms_cpputest_qf_ctrl.hpp"
+
+#include "CppUTest/TestHarness.h"
+#include "benchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+// The real PC_COM, Config and Fram AOs fed scripted request streams through the serial port, from
+// SERIAL_DATA_AVAILABLE_SIG through unpacking, decoding, the handlers and Config/Fram to the
+// encoded responses, reported by the harness in benchmark.h. Besides the speed they report how
+// far each AO queue and event pool filled, against the sizes the motor gives them.
+//
+// qf_ctrl runs the AOs cooperatively, as QV and the host simulation do, so a queue fills with
+// everything posted to it during one RTC step. Under QK an AO of higher priority than its sender
+// (Config and Fram, to PC_COM) runs on each post instead, so their peaks are upper bounds there;
+// what PC_COM posts to itself, like the entry changed events, piles up the same on both.
+
+using namespace cms::test;
+
+static constexpr size_t QUEUE_LEN   = 64U; // so nothing runs out while the peaks are measured
+static constexpr size_t POOL_BLOCKS = 64U;
+
+static constexpr size_t USB_PACKET_LEN = 64U; // a full speed CDC packet, one serial interrupt
+static constexpr unsigned MAX_BURST    = 32U; // requests in a single serial read
+
+/**************************************************************************************************\
+* Fakes
+\**************************************************************************************************/
+
+static uint32_t s_faults;
+
+extern "C" uint32_t BSP_Get_Milliseconds_Tick(void)
+{
+    return 4321U;
+}
+
+extern "C" void CLI_AddCommands(EmbeddedCli *)
+{
+}
+
+extern "C" int LogCom_Printf(const char *, ...)
+{
+    return 0;
+}
+
+extern "C" void Fault_Manager_Generate_Fault(QActive *, Fault_ID_T, const char *)
+{
+    s_faults++;
+}
+
+// The FRAM, one 256 byte page at each of its two device addresses. A transfer completes when
+// complete_i2c() says its interrupt fired.
+static uint8_t s_fram[2][sizeof(FRAM_File_T)];
+static I2C_Complete_Callback s_i2c_complete_cb;
+static void *s_i2c_cb_data;
+static uint32_t s_fram_writes;
+
+static I2C_Return_T fram_write(
+    uint8_t address,
+    uint8_t *tx_buffer,
+    const uint16_t data_len,
+    I2C_Complete_Callback complete_cb,
+    I2C_Error_Callback,
+    void *cb_data)
+{
+    // the memory address, then the file
+    CHECK_EQUAL(1U + sizeof(FRAM_File_T), data_len);
+    CHECK_TRUE(s_i2c_complete_cb == nullptr);
+
+    memcpy(s_fram[address & 0x01U], &tx_buffer[1], sizeof(FRAM_File_T));
+    s_fram_writes++;
+    s_i2c_complete_cb = complete_cb;
+    s_i2c_cb_data     = cb_data;
+    return I2C_RTN_SUCCESS;
+}
+
+static I2C_Return_T fram_memory_read(
+    uint8_t address,
+    uint16_t,
+    uint8_t,
+    uint8_t *rx_buffer,
+    const uint16_t rx_n_bytes,
+    I2C_Complete_Callback complete_cb,
+    I2C_Error_Callback,
+    void *cb_data)
+{
+    CHECK_TRUE(rx_n_bytes <= sizeof(FRAM_File_T));
+    CHECK_TRUE(s_i2c_complete_cb == nullptr);
+
+    memcpy(rx_buffer, s_fram[address & 0x01U], rx_n_bytes);
+    s_i2c_complete_cb = complete_cb;
+    s_i2c_cb_data     = cb_data;
+    return I2C_RTN_SUCCESS;
+}
+
+// the interrupt of the transfer in flight, if there is one, then the AOs it posted to
+static void complete_i2c(void)
+{
+    if (s_i2c_complete_cb != nullptr)
+    {
+        I2C_Complete_Callback complete_cb = s_i2c_complete_cb;
+        s_i2c_complete_cb                 = nullptr;
+        complete_cb(s_i2c_cb_data);
+        qf_ctrl::ProcessEvents();
+    }
+}
+
+static void complete_all_i2c(void)
+{
+    while (s_i2c_complete_cb != nullptr)
+    {
+        complete_i2c();
+    }
+}
+
+// The PC's side of the serial port: a scripted stream of framed requests handed over a chunk at
+// a time, and the response frames counted
+static uint8_t s_stream[4096];
+static size_t s_stream_len;
+static size_t s_stream_pos;
+static size_t s_stream_available;
+static uint64_t s_tx_bytes;
+static uint64_t s_tx_flags; // two to a frame
+static Serial_IO_Data_Ready_Callback s_data_ready_cb;
+static void *s_data_ready_cb_data;
+
+static uint16_t serial_tx(const uint8_t *data_ptr, const uint16_t data_len)
+{
+    for (uint16_t i = 0U; i < data_len; i++)
+    {
+        s_tx_flags += (data_ptr[i] == 0x7EU) ? 1U : 0U;
+    }
+    s_tx_bytes += data_len;
+    return data_len;
+}
+
+static uint16_t serial_rx(uint8_t *data_ptr, const uint16_t max_data_len)
+{
+    uint16_t length = 0U;
+    while ((length < max_data_len) && (s_stream_pos < s_stream_available))
+    {
+        data_ptr[length++] = s_stream[s_stream_pos++];
+    }
+    return length;
+}
+
+static void serial_register_cb(Serial_IO_Data_Ready_Callback cb, void *cb_data)
+{
+    s_data_ready_cb      = cb;
+    s_data_ready_cb_data = cb_data;
+}
+
+static const Serial_IO_T s_serial = {
+    .tx_func          = serial_tx,
+    .rx_func          = serial_rx,
+    .register_cb_func = serial_register_cb,
+};
+
+/**************************************************************************************************\
+* Request streams
+\**************************************************************************************************/
+
+static uint16_t stream_append(const uint8_t *data_ptr, const uint16_t data_len)
+{
+    CHECK_TRUE((s_stream_len + data_len) <= sizeof(s_stream));
+    memcpy(&s_stream[s_stream_len], data_ptr, data_len);
+    s_stream_len += data_len;
+    return data_len;
+}
+
+static void stream_clear(void)
+{
+    s_stream_len = 0U;
+}
+
+// a whole request packet, CRC, type and message, framed onto the end of the stream
+static void add_request(MessageType type, const pb_msgdesc_t *fields, const void *message)
+{
+    uint8_t packet[64];
+    size_t message_len = 0U;
+
+    if (fields != nullptr)
+    {
+        pb_ostream_t stream = pb_ostream_from_buffer(&packet[3], sizeof(packet) - 3U);
+        CHECK_TRUE(pb_encode(&stream, fields, message));
+        message_len = stream.bytes_written;
+    }
+
+    packet[2]    = (uint8_t) type;
+    uint16_t crc = crc_calculate(&packet[2], (uint16_t) (message_len + 1U));
+    packet[0]    = (uint8_t) crc;
+    packet[1]    = (uint8_t) (crc >> 8U);
+    CHECK_EQUAL(0, hdlc_transmit_packet(stream_append, packet, message_len + 3U));
+}
+
+static void add_get_entry(ConfigID_T id)
+{
+    ConfigDBGetEntryReq request = ConfigDBGetEntryReq_init_zero;
+    request.entry_id            = id;
+    add_request(MessageType_CONFIG_DB_GET_ENTRY_REQ, ConfigDBGetEntryReq_fields, &request);
+}
+
+static void add_set_entry_f32(ConfigID_T id, float value)
+{
+    ConfigDBSetEntryReq request       = ConfigDBSetEntryReq_init_zero;
+    request.entry_id                  = id;
+    request.value.which_value         = ConfigValue_value_float32_tag;
+    request.value.value.value_float32 = value;
+    add_request(MessageType_CONFIG_DB_SET_ENTRY_REQ, ConfigDBSetEntryReq_fields, &request);
+}
+
+static void add_set_entry_u32(ConfigID_T id, uint32_t value)
+{
+    ConfigDBSetEntryReq request      = ConfigDBSetEntryReq_init_zero;
+    request.entry_id                 = id;
+    request.value.which_value        = ConfigValue_value_uint32_tag;
+    request.value.value.value_uint32 = value;
+    add_request(MessageType_CONFIG_DB_SET_ENTRY_REQ, ConfigDBSetEntryReq_fields, &request);
+}
+
+static void add_save(void)
+{
+    add_request(MessageType_CONFIG_DB_SAVE_TO_NVM_REQ, nullptr, nullptr);
+}
+
+static void add_db_info(void)
+{
+    add_request(MessageType_CONFIG_DB_REQ_DATABASE_INFO_REQ, nullptr, nullptr);
+}
+
+// The stream arrives chunk_len bytes at a time, each chunk a serial interrupt followed by the AOs
+// it woke. A FRAM transfer in flight completes between chunks, so a save spans the next one.
+static void deliver_stream(size_t chunk_len)
+{
+    s_stream_pos       = 0U;
+    s_stream_available = 0U;
+
+    while (s_stream_available < s_stream_len)
+    {
+        s_stream_available = std::min(s_stream_available + chunk_len, s_stream_len);
+        s_data_ready_cb(s_data_ready_cb_data);
+        qf_ctrl::ProcessEvents();
+        complete_i2c();
+    }
+    complete_all_i2c();
+}
+
+/**************************************************************************************************\
+* Queue and pool peaks
+\**************************************************************************************************/
+
+// events waiting at once, the one being taken out counted, so up to its length + 1
+static unsigned queue_peak(QActive const *ao)
+{
+    return (unsigned) (ao->eQueue.end + 1U - QEQueue_getNMin(&ao->eQueue));
+}
+
+// pools numbered from 1 in the order of the fixture's MemPoolConfigs, with the blocks QF made of
+// them, fewer than POOL_BLOCKS when it rounded the block size up
+static uint_fast16_t s_pool_blocks[3];
+
+static unsigned pool_peak(uint_fast8_t pool)
+{
+    return (unsigned) (s_pool_blocks[pool - 1U] - QF_getPoolMin(pool));
+}
+
+// the queues and pools watched
+typedef enum
+{
+    PEAK_PC_COM_QUEUE,
+    PEAK_CONFIG_QUEUE,
+    PEAK_FRAM_QUEUE,
+    PEAK_SMALL_POOL,
+    PEAK_MEDIUM_POOL,
+    PEAK_LARGE_POOL,
+    PEAK_COUNT,
+} Peak_T;
+
+static const char *const PEAK_NAMES[PEAK_COUNT] = {
+    "pc_com_queue", "config_queue", "fram_queue", "small_pool", "medium_pool", "large_pool"};
+
+// what motor/src/app_start.c gives them, the peaks are held against these. A queue of 10 holds 11
+// events, the one being taken out counted. The pools are the motor's event catalogue as built for
+// this host, the same as the host simulation's.
+static const unsigned FIRMWARE_CAPACITY[PEAK_COUNT] = {
+    11U, 11U, 11U, APP_SMALL_POOL_BLOCKS, APP_MEDIUM_POOL_BLOCKS, APP_LARGE_POOL_BLOCKS};
+
+typedef struct
+{
+    unsigned peak[PEAK_COUNT];
+} Peaks_T;
+
+static Peaks_T peaks(void)
+{
+    return {{
+        queue_peak(AO_PC_COM),
+        queue_peak(AO_Config),
+        queue_peak(AO_Fram),
+        pool_peak(1U),
+        pool_peak(2U),
+        pool_peak(3U),
+    }};
+}
+
+static int peaks_json(char *json, size_t size, const Peaks_T &measured)
+{
+    int length = 0;
+    for (unsigned i = 0U; i < PEAK_COUNT; i++)
+    {
+        length += snprintf(
+            &json[length],
+            size - (size_t) length,
+            "%s\"%s_peak\": %u",
+            (i > 0U) ? ", " : "",
+            PEAK_NAMES[i],
+            measured.peak[i]);
+    }
+    return length;
+}
+
+/**************************************************************************************************\
+* Benchmarks
+\**************************************************************************************************/
+
+TEST_GROUP(AoThroughputBenchmarks) {
+    QEvt const *pc_com_queue[QUEUE_LEN];
+    QEvt const *config_queue[QUEUE_LEN];
+    QEvt const *fram_queue[QUEUE_LEN];
+
+    void setup() final
+    {
+        start();
+    }
+
+    void teardown() final
+    {
+        CHECK_EQUAL(0U, s_faults);
+        qf_ctrl::Teardown();
+    }
+
+    // PC_COM, Config and Fram from power up, in the motor's priority order, with an empty FRAM
+    void start()
+    {
+        qf_ctrl::MemPoolConfigs configs = {
+            {sizeof(Small_Pool_Event_T), POOL_BLOCKS},
+            {sizeof(Medium_Pool_Event_T), POOL_BLOCKS},
+            {sizeof(Large_Pool_Event_T), POOL_BLOCKS},
+        };
+
+        s_faults           = 0U;
+        s_fram_writes      = 0U;
+        s_i2c_complete_cb  = nullptr;
+        s_tx_bytes         = 0U;
+        s_tx_flags         = 0U;
+        s_data_ready_cb    = nullptr;
+        memset(s_fram, 0, sizeof(s_fram));
+        stream_clear();
+
+        qf_ctrl::Setup(PUBSUB_MAX_SIG, 1000, configs, qf_ctrl::MemPoolTeardownOption::IGNORE);
+        for (uint_fast8_t pool = 1U; pool <= Q_DIM(s_pool_blocks); pool++)
+        {
+            s_pool_blocks[pool - 1U] = QF_getPoolMin(pool);
+        }
+
+        uint8_t priority =
+            std::max(qf_ctrl::UNIT_UNDER_TEST_PRIORITY, qf_ctrl::RECORDER_PRIORITY) + 1U;
+
+        PC_COM_ctor(&s_serial, nullptr);
+        QACTIVE_START(
+            AO_PC_COM, priority++, pc_com_queue, Q_DIM(pc_com_queue), nullptr, 0, nullptr);
+        Config_ctor();
+        QACTIVE_START(
+            AO_Config, priority++, config_queue, Q_DIM(config_queue), nullptr, 0, nullptr);
+        Fram_ctor(fram_write, fram_memory_read);
+        QACTIVE_START(AO_Fram, priority++, fram_queue, Q_DIM(fram_queue), nullptr, 0, nullptr);
+
+        qf_ctrl::ProcessEvents();
+        complete_all_i2c();
+        CHECK_TRUE(s_data_ready_cb != nullptr);
+    }
+
+    void restart()
+    {
+        teardown();
+        start();
+    }
+
+    // Bursts of 1 to MAX_BURST requests in a single serial read, from a fresh start each, with
+    // the peaks of the power of two bursts and, for each queue and pool, the smallest burst that
+    // needs more than the motor gives it (null if none in the sweep does)
+    void burst_sweep(const char *name, void (*add)(unsigned i))
+    {
+        unsigned exhausted[PEAK_COUNT] = {0U};
+        char json[512];
+        int length;
+
+        for (unsigned burst = 1U; burst <= MAX_BURST; burst++)
+        {
+            restart();
+            for (unsigned i = 0U; i < burst; i++)
+            {
+                add(i);
+            }
+            deliver_stream(s_stream_len);
+
+            Peaks_T burst_peaks = peaks();
+            for (unsigned i = 0U; i < PEAK_COUNT; i++)
+            {
+                if ((exhausted[i] == 0U) && (burst_peaks.peak[i] > FIRMWARE_CAPACITY[i]))
+                {
+                    exhausted[i] = burst;
+                }
+            }
+
+            if ((burst & (burst - 1U)) == 0U)
+            {
+                length = snprintf(
+                    json, sizeof(json), "{\"benchmark\": \"%s\", \"burst\": %u, ", name, burst);
+                length += peaks_json(&json[length], sizeof(json) - (size_t) length, burst_peaks);
+                snprintf(&json[length], sizeof(json) - (size_t) length, "}");
+                Benchmark_Print_Json(json);
+            }
+        }
+
+        length = snprintf(json, sizeof(json), "{\"benchmark\": \"%s_exhaustion\"", name);
+        for (unsigned i = 0U; i < PEAK_COUNT; i++)
+        {
+            char burst[16];
+            snprintf(burst, sizeof(burst), "%u", exhausted[i]);
+            length += snprintf(
+                &json[length],
+                sizeof(json) - (size_t) length,
+                ", \"%s\": %s",
+                PEAK_NAMES[i],
+                (exhausted[i] != 0U) ? burst : "null");
+        }
+        snprintf(&json[length], sizeof(json) - (size_t) length, "}");
+        Benchmark_Print_Json(json);
+    }
+};
+
+// entry reads, writes and database info requests, as the PC's config tool sends them
+TEST(AoThroughputBenchmarks, pc_com_stream_throughput)
+{
+    static constexpr unsigned ROUNDS = 16U;
+
+    for (unsigned i = 0U; i < ROUNDS; i++)
+    {
+        add_get_entry(CFG_ID_DIRECTOR_RPM_HZ);
+        add_set_entry_u32(CFG_ID_CAN_HEARTBEAT_MS, 100U + i);
+        add_db_info();
+    }
+    unsigned frames = 3U * ROUNDS;
+
+    // a set is answered once by its handler and again by the entry changed event it publishes
+    deliver_stream(USB_PACKET_LEN);
+    CHECK_EQUAL(4U * ROUNDS, s_tx_flags / 2U);
+    CHECK_EQUAL(100U + ROUNDS - 1U, Config_Read_U32(CFG_ID_CAN_HEARTBEAT_MS));
+    uint64_t response_bytes = s_tx_bytes;
+
+    Benchmark_Result_T result = Benchmark_Time([&](uint64_t) { deliver_stream(USB_PACKET_LEN); });
+
+    char extra[384];
+    int length = snprintf(
+        extra,
+        sizeof(extra),
+        "\"frames_per_op\": %u, \"frames_per_s\": %.0f, \"response_bytes_per_op\": %llu, ",
+        frames,
+        (double) frames * (double) result.ops / result.elapsed_s,
+        (unsigned long long) response_bytes);
+    peaks_json(&extra[length], sizeof(extra) - (size_t) length, peaks());
+    Benchmark_Report("pc_com_stream_throughput", result, s_stream_len, extra);
+}
+
+// Every entry written then saved, one request after the other. A save that arrives while the last
+// one is still being written to the FRAM is dropped by Config, which is counted.
+TEST(AoThroughputBenchmarks, config_set_and_save_flood)
+{
+    static constexpr unsigned ROUNDS = 32U;
+
+    for (unsigned i = 0U; i < ROUNDS; i++)
+    {
+        add_set_entry_f32(CFG_ID_CAN_PRESSURE_DEADBAND, 0.25F * (float) (i + 1U));
+        add_save();
+    }
+    unsigned frames = 2U * ROUNDS;
+
+    deliver_stream(USB_PACKET_LEN);
+    uint32_t fram_writes = s_fram_writes;
+    CHECK_TRUE((fram_writes > 0U) && (fram_writes <= ROUNDS));
+    DOUBLES_EQUAL(0.25 * ROUNDS, Config_Read_F32(CFG_ID_CAN_PRESSURE_DEADBAND), 0.0);
+
+    Benchmark_Result_T result = Benchmark_Time([&](uint64_t) { deliver_stream(USB_PACKET_LEN); });
+
+    char extra[384];
+    int length = snprintf(
+        extra,
+        sizeof(extra),
+        "\"frames_per_op\": %u, \"frames_per_s\": %.0f, \"fram_writes_per_op\": %lu, "
+        "\"saves_dropped_per_op\": %lu, ",
+        frames,
+        (double) frames * (double) result.ops / result.elapsed_s,
+        (unsigned long) fram_writes,
+        (unsigned long) (ROUNDS - fram_writes));
+    peaks_json(&extra[length], sizeof(extra) - (size_t) length, peaks());
+    Benchmark_Report("config_set_and_save_flood", result, s_stream_len, extra);
+}
+
+// each write publishes an entry changed event that PC_COM only takes once the read is done
+TEST(AoThroughputBenchmarks, set_entry_bursts)
+{
+    burst_sweep("set_entry_burst", [](unsigned i) {
+        add_set_entry_u32(CFG_ID_CAN_HEARTBEAT_MS, 100U + i);
+    });
+    CHECK_EQUAL(100U + MAX_BURST - 1U, Config_Read_U32(CFG_ID_CAN_HEARTBEAT_MS));
+}
+
+TEST(AoThroughputBenchmarks, save_bursts)
+{
+    burst_sweep("save_burst", [](unsigned) { add_save(); });
+    CHECK_EQUAL(1U, s_fram_writes);
+}
@@ -1,7 +1,11 @@
 extern "C" {
 #include "box_to_box.h"
+#include "bsp.h"
 #include "bsp_box_to_box_mock.h"
+#include "bsp_timestamp_fake.h"
 #include "can_messages.h"
+#include "can_rx_ring.h"
+#include "can_stats.h"
 #include "posted_signals.h"
 #include "pubsub_signals.h"
 }
@@ -15,6 +19,9 @@ using namespace cms::test;
 
 static QEvt const *s_queue_storage[10];
 
+// start of frame to the FDCAN RX interrupt
+static constexpr uint64_t RX_LATENCY_US = 40U;
+
 TEST_GROUP(BoxToBoxGaugeTests) {
     PublishedEventRecorder *recorder;
 
@@ -25,6 +32,7 @@ TEST_GROUP(BoxToBoxGaugeTests) {
         };
 
         BSP_BoxToBoxMock_Reset();
+        BSP_TimestampFake_Reset();
         qf_ctrl::Setup(PUBSUB_MAX_SIG, 1000, configs);
         recorder = PublishedEventRecorder::CreatePublishedEventRecorder(
             qf_ctrl::RECORDER_PRIORITY, PUBSUB_MOTOR_DATA_SIG, PUBSUB_MOTOR_DATA_SIG + 1);
@@ -48,13 +56,72 @@ TEST_GROUP(BoxToBoxGaugeTests) {
         qf_ctrl::Teardown();
     }
 
+    // what the FDCAN RX interrupt does for each frame it drains
+    void queueCanFrame(CAN_Message_T const *msg)
+    {
+        *CAN_Rx_Ring_Reserve() = *msg;
+        CAN_Rx_Ring_Commit();
+    }
+
+    void notifyCanFrames()
+    {
+        static QEvt const event = QEVT_INITIALIZER(POSTED_CAN_FRAMES_AVAILABLE_SIG);
+        if (CAN_Rx_Ring_Notify_Needed())
+        {
+            qf_ctrl::PostAndProcess(&event, AO_BOX_TO_BOX);
+        }
+    }
+
     void postCanMessage(CAN_Message_T const *msg)
     {
-        CAN_Message_Received_Event_T event = {
-            .super = QEVT_INITIALIZER(POSTED_CAN_MESSAGE_RECEIVED_SIG),
-            .msg   = *msg,
+        queueCanFrame(msg);
+        notifyCanFrames();
+    }
+
+    void postMotorData(CAN_Msg_Motor_Data_T const *motor_data)
+    {
+        CAN_Message_T msg = {};
+        CAN_Pack_Motor_Data(motor_data, &msg);
+        msg.timestamp_us = BSP_Get_Microseconds() - RX_LATENCY_US;
+        postCanMessage(&msg);
+    }
+
+    void postMotorDataV2(CAN_Msg_Motor_Data_V2_T const *motor_data)
+    {
+        CAN_Message_T msg = {};
+        CAN_Pack_Motor_Data_V2(motor_data, &msg);
+        msg.timestamp_us = BSP_Get_Microseconds() - RX_LATENCY_US;
+        postCanMessage(&msg);
+    }
+
+    void postSignal(enum_t sig)
+    {
+        QEvt event = QEVT_INITIALIZER(sig);
+        qf_ctrl::PostAndProcess(&event, AO_BOX_TO_BOX);
+    }
+
+    // The gauge sends a request at t1 = now + 100 us (the mock's TX event) and the motor, its clock
+    // motor_ahead_us ahead of ours, answers 200 us later. Both ends stamp the start of frame.
+    void timeSyncExchange(int64_t motor_ahead_us, uint64_t last_response_tx_us, bool last_valid)
+    {
+        qf_ctrl::MoveTimeForward(std::chrono::milliseconds(1000));
+        CAN_Msg_Time_Sync_Req_T req = {};
+        CHECK_TRUE(CAN_Unpack_Time_Sync_Req(BSP_BoxToBoxMock_GetLastCanMsg(), &req));
+
+        uint64_t request_tx_us = BSP_Get_Microseconds() + 100U;
+        postSignal(POSTED_CAN_TX_COMPLETE_SIG);
+
+        CAN_Msg_Time_Sync_Resp_T resp = {
+            .sequence            = req.sequence,
+            .last_sequence       = (uint8_t) (req.sequence - 1U),
+            .flags               = (uint16_t) (last_valid ? CAN_TIME_SYNC_LAST_VALID_BIT : 0U),
+            .request_rx_us       = request_tx_us + motor_ahead_us,
+            .last_response_tx_us = last_response_tx_us,
         };
-        qf_ctrl::PostAndProcess(&event.super, AO_BOX_TO_BOX);
+        CAN_Message_T msg = {};
+        CAN_Pack_Time_Sync_Resp(&resp, &msg);
+        msg.timestamp_us = request_tx_us + 200U;
+        postCanMessage(&msg);
     }
 };
 
@@ -66,23 +133,25 @@ TEST(BoxToBoxGaugeTests, startup_initializes_can_bus)
 TEST(BoxToBoxGaugeTests, can_motor_data_message_is_republished_as_motor_data_event)
 {
     CAN_Msg_Motor_Data_T can_msg = {
-        .id             = CAN_MSG_MOTOR_DATA_ID,
-        .dlc            = CAN_MSG_MOTOR_DATA_DLC,
-        .tick           = 99U,
-        .temperature    = 76.5F,
-        .pressure       = 8.25F,
-        .tachometer     = 1800.0F,
-        .vbat           = 12.6F,
-        .engine_minutes = 789U,
-        .start          = false,
-        .neutral        = true,
-        .buzzer         = false,
-        .temp_good      = true,
-        .pres_good      = true,
-        .reserved       = {0},
+        .tick               = 99U,
+        .temperature        = 76.5F,
+        .pressure           = 8.25F,
+        .tachometer         = 1800.0F,
+        .vbat               = 12.6F,
+        .engine_minutes     = 789U,
+        .start              = false,
+        .neutral            = true,
+        .buzzer             = false,
+        .temp_good          = true,
+        .pres_good          = true,
+        .updated            = MOTOR_DATA_UPDATED_TACHOMETER | MOTOR_DATA_UPDATED_FLAGS,
+        .reserved           = 0U,
+        .timestamp_us       = 0x123456789ULL,
+        .temperature_age_us = 60000U,
+        .pressure_age_us    = 15000U,
     };
 
-    postCanMessage(reinterpret_cast<CAN_Message_T const *>(&can_msg));
+    postMotorData(&can_msg);
 
     auto event = recorder->getRecordedEvent();
     CHECK_TRUE(event != nullptr);
@@ -99,6 +168,116 @@ TEST(BoxToBoxGaugeTests, can_motor_data_message_is_republished_as_motor_data_eve
     CHECK_EQUAL(can_msg.buzzer, motor_event->buzzer);
     CHECK_EQUAL(can_msg.temp_good, motor_event->temp_good);
     CHECK_EQUAL(can_msg.pres_good, motor_event->pres_good);
+    CHECK_EQUAL(BSP_Get_Microseconds() - RX_LATENCY_US, motor_event->timestamp_us);
+    CHECK_EQUAL(can_msg.temperature_age_us, motor_event->temperature_age_us);
+    CHECK_EQUAL(can_msg.pressure_age_us, motor_event->pressure_age_us);
+    CHECK_EQUAL(can_msg.updated, motor_event->updated);
+}
+
+TEST(BoxToBoxGaugeTests, motor_data_timestamp_is_converted_to_our_clock_once_synced)
+{
+    timeSyncExchange(4000000, 0U, false);
+    uint64_t first_response_tx_us = BSP_Get_Microseconds() + 100U + 4000000U + 200U;
+    BSP_TimestampFake_Advance_Microseconds(1000000U);
+    timeSyncExchange(4000000, first_response_tx_us, true);
+
+    uint64_t gathered_us         = BSP_Get_Microseconds() - 300U;
+    CAN_Msg_Motor_Data_T can_msg = {};
+    can_msg.timestamp_us         = gathered_us + 4000000U;
+    postMotorData(&can_msg);
+
+    auto event = recorder->getRecordedEvent();
+    CHECK_TRUE(event != nullptr);
+    MotorDataEvent_T const *motor_event = reinterpret_cast<MotorDataEvent_T const *>(event.get());
+    CHECK_EQUAL(gathered_us, motor_event->timestamp_us);
+
+    // and the end to end age is measured on the synchronised clock, to the microsecond
+    CAN_Id_Stats_T stats;
+    CAN_Stats_Get_Id(CAN_MSG_MOTOR_DATA_ID, &stats);
+    CHECK_EQUAL(1U, stats.rx_age_us.count);
+    CHECK_EQUAL(300U, stats.rx_age_us.max);
+}
+
+TEST(BoxToBoxGaugeTests, can_motor_data_v2_message_is_unscaled_into_motor_data_event)
+{
+    uint32_t status = 3U | CAN_MOTOR_DATA_V2_NEUTRAL_BIT | CAN_MOTOR_DATA_V2_TEMP_GOOD_BIT |
+                      CAN_MOTOR_DATA_V2_NO_TEMPERATURE_BIT |
+                      (789U << CAN_MOTOR_DATA_V2_ENGINE_MINUTES_SHIFT);
+
+    CAN_Msg_Motor_Data_V2_T can_msg = {
+        .temperature = -1235,
+        .pressure    = 825U,
+        .tachometer  = 1800U,
+        .vbat        = 12600U,
+        .status      = status,
+    };
+
+    postMotorDataV2(&can_msg);
+
+    auto event = recorder->getRecordedEvent();
+    CHECK_TRUE(event != nullptr);
+    CHECK_EQUAL(PUBSUB_MOTOR_DATA_SIG, event->sig);
+
+    MotorDataEvent_T const *motor_event = reinterpret_cast<MotorDataEvent_T const *>(event.get());
+    DOUBLES_EQUAL(-12.35, motor_event->temperature, 0.001);
+    DOUBLES_EQUAL(8.25, motor_event->pressure, 0.001);
+    DOUBLES_EQUAL(1800.0, motor_event->tachometer, 0.001);
+    DOUBLES_EQUAL(12.6, motor_event->vbat, 0.001);
+    CHECK_EQUAL(789U, motor_event->engine_minutes);
+    CHECK_FALSE(motor_event->start);
+    CHECK_TRUE(motor_event->neutral);
+    CHECK_FALSE(motor_event->buzzer);
+    CHECK_TRUE(motor_event->temp_good);
+    CHECK_FALSE(motor_event->pres_good);
+    CHECK_EQUAL(BSP_Get_Microseconds() - RX_LATENCY_US, motor_event->timestamp_us);
+    CHECK_EQUAL(SAMPLE_AGE_UNKNOWN_US, motor_event->temperature_age_us);
+    CHECK_EQUAL(0U, motor_event->pressure_age_us);
+    CHECK_EQUAL(MOTOR_DATA_UPDATED_ALL, motor_event->updated);
+}
+
+TEST(BoxToBoxGaugeTests, gaps_in_the_v2_sequence_count_lost_frames)
+{
+    CAN_Msg_Motor_Data_V2_T can_msg = {
+        .status = 14U,
+    };
+
+    postMotorDataV2(&can_msg);
+    can_msg.status = 15U;
+    postMotorDataV2(&can_msg);
+    can_msg.status = 2U; // 0 and 1 lost, across the wrap
+    postMotorDataV2(&can_msg);
+
+    Box_To_Box_Stats_T stats;
+    Box_To_Box_Get_Stats(&stats);
+    CHECK_EQUAL(3U, stats.motor_data_received);
+    CHECK_EQUAL(2U, stats.motor_data_lost);
+    CHECK_EQUAL(3U, stats.rx_handled);
+    CHECK_EQUAL(0U, stats.rx_unhandled);
+}
+
+TEST(BoxToBoxGaugeTests, a_burst_of_frames_is_handled_from_one_event)
+{
+    CAN_Msg_Motor_Data_V2_T can_msg = {};
+    CAN_Message_T msg               = {};
+
+    for (uint32_t seq = 0U; seq < 3U; seq++)
+    {
+        can_msg.status = seq;
+        CAN_Pack_Motor_Data_V2(&can_msg, &msg);
+        queueCanFrame(&msg);
+    }
+    notifyCanFrames();
+
+    Box_To_Box_Stats_T stats;
+    Box_To_Box_Get_Stats(&stats);
+    CHECK_EQUAL(3U, stats.motor_data_received);
+    CHECK_EQUAL(0U, stats.motor_data_lost);
+
+    CAN_Rx_Ring_Stats_T ring_stats;
+    CAN_Rx_Ring_Get_Stats(&ring_stats);
+    CHECK_EQUAL(3U, ring_stats.frames);
+    CHECK_EQUAL(1U, ring_stats.notifies);
+    CHECK_EQUAL(3U, ring_stats.high_water);
 }
 
 TEST(BoxToBoxGaugeTests, unknown_can_id_is_ignored)
@@ -110,4 +289,82 @@ TEST(BoxToBoxGaugeTests, unknown_can_id_is_ignored)
     postCanMessage(&msg);
 
     CHECK_FALSE(recorder->isAnyEventRecorded());
+
+    Box_To_Box_Stats_T stats;
+    Box_To_Box_Get_Stats(&stats);
+    CHECK_EQUAL(0U, stats.rx_handled);
+    CHECK_EQUAL(1U, stats.rx_unhandled);
+}
+
+TEST(BoxToBoxGaugeTests, frame_with_the_wrong_dlc_for_its_id_is_ignored)
+{
+    CAN_Message_T msg = {};
+    msg.id            = CAN_MSG_MOTOR_DATA_V2_ID;
+    msg.dlc           = CAN_MSG_MOTOR_DATA_DLC;
+
+    postCanMessage(&msg);
+
+    CHECK_FALSE(recorder->isAnyEventRecorded());
+}
+
+TEST(BoxToBoxGaugeTests, motor_clock_is_synced_once_a_response_brings_the_previous_t3)
+{
+    uint64_t local_us = 0U;
+    CHECK_FALSE(Box_To_Box_Remote_To_Local_Time(5000000U, &local_us));
+
+    // first exchange, its response was sent 200 us after the request arrived
+    timeSyncExchange(4000000, 0U, false);
+    uint64_t first_response_tx_us = BSP_Get_Microseconds() + 100U + 4000000U + 200U;
+    CHECK_FALSE(Box_To_Box_Remote_To_Local_Time(5000000U, &local_us));
+
+    BSP_TimestampFake_Advance_Microseconds(1000000U);
+    timeSyncExchange(4000000, first_response_tx_us, true);
+
+    Time_Sync_T sync;
+    Box_To_Box_Get_Time_Sync(&sync);
+    CHECK_TRUE(sync.synced);
+    CHECK_EQUAL(4000000, sync.offset_us);
+    CHECK_EQUAL(0, sync.round_trip_us);
+
+    CHECK_TRUE(Box_To_Box_Remote_To_Local_Time(5000000U, &local_us));
+    CHECK_EQUAL(1000000U, local_us);
+}
+
+TEST(BoxToBoxGaugeTests, tunnel_packets_go_to_the_motor_and_its_responses_come_back)
+{
+    const Serial_IO_T *tunnel = Box_To_Box_Get_Tunnel_IO();
+    const uint8_t packet[]    = {0x12, 0x34, 0x05};
+
+    CHECK_EQUAL(sizeof(packet), tunnel->tx_func(packet, sizeof(packet)));
+    qf_ctrl::ProcessEvents();
+
+    CAN_Msg_Tunnel_Motor_T segment = {};
+    CHECK_TRUE(CAN_Unpack_Tunnel_Motor(BSP_BoxToBoxMock_GetLastCanMsg(), &segment));
+    CHECK_EQUAL(sizeof(packet), segment.length);
+    CHECK_TRUE((segment.flags & CAN_TRANSPORT_LAST_BIT) != 0U);
+    MEMCMP_EQUAL(packet, segment.data, sizeof(packet));
+
+    CAN_Msg_Tunnel_Gauge_T response = {
+        .sequence = 7U,
+        .flags    = CAN_TRANSPORT_FIRST_BIT | CAN_TRANSPORT_LAST_BIT | CAN_TRANSPORT_SYNC_BIT,
+        .length   = 2U,
+        .data     = {0xab, 0xcd},
+    };
+    CAN_Message_T msg = {};
+    CAN_Pack_Tunnel_Gauge(&response, &msg);
+    postCanMessage(&msg);
+
+    CAN_Msg_Tunnel_Gauge_Ack_T ack = {};
+    CHECK_TRUE(CAN_Unpack_Tunnel_Gauge_Ack(BSP_BoxToBoxMock_GetLastCanMsg(), &ack));
+    CHECK_EQUAL(8U, ack.next_sequence);
+    CHECK_EQUAL(0U, ack.window);
+
+    uint8_t received[8];
+    CHECK_EQUAL(2U, tunnel->rx_func(received, sizeof(received)));
+    MEMCMP_EQUAL(response.data, received, 2U);
+
+    // reading it opens the window again
+    qf_ctrl::ProcessEvents();
+    CHECK_TRUE(CAN_Unpack_Tunnel_Gauge_Ack(BSP_BoxToBoxMock_GetLastCanMsg(), &ack));
+    CHECK_EQUAL(CAN_TRANSPORT_WINDOW, ack.window);
 }
@@ -0,0 +1,423 @@
+extern "C" {
+#include "box_to_box.h"
+#include "bsp.h"
+#include "bsp_can_virtual.h"
+#include "bsp_timestamp_fake.h"
+#include "can_bus_load.h"
+#include "can_messages.h"
+#include "config.h"
+#include "director.h"
+#include "motor_side_symbols.h"
+#include "pubsub_signals.h"
+#include "virtual_can_bus.h"
+}
+
+#include "cmsTestPublishedEventRecorder.hpp"
+#include "cms_cpputest_qf_ctrl.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+#include "CppUTest/TestHarness.h"
+
+// Both boards in one executable, the gauge built as usual and the motor with its symbols prefixed,
+// their Box_To_Box AOs talking over the virtual CAN bus. Latency is from the motor Director's
+// publication of a new pressure to the gauge Director setting the pressure gauge DAC.
+
+using namespace cms::test;
+
+static const CAN_Bit_Rates_T s_rates = {
+    .nominal_bps = 1000000U,
+    .data_bps    = 4000000U,
+    .brs         = true,
+};
+
+static QEvt const *s_motor_director_queue[16];
+static QEvt const *s_motor_box_to_box_queue[16];
+static QEvt const *s_gauge_director_queue[16];
+static QEvt const *s_gauge_box_to_box_queue[16];
+
+static uint32_t s_gauge_faults;
+static uint32_t s_motor_faults;
+
+static float s_pressure_volts;
+static std::deque<uint64_t> s_published_us; // new pressures on their way to the gauge
+static std::vector<uint64_t> s_latencies_us;
+
+extern "C" uint32_t BSP_Get_Milliseconds_Tick(void)
+{
+    return (uint32_t) (BSP_Get_Microseconds() / 1000U);
+}
+
+// motor
+extern "C" bool BSP_Get_Neutral(void) { return true; }
+extern "C" bool BSP_Get_Start(void) { return false; }
+extern "C" bool BSP_Get_Temp_Good(void) { return true; }
+extern "C" bool BSP_Get_Pres_Good(void) { return true; }
+extern "C" bool BSP_Get_Buzzer(void) { return false; }
+extern "C" float Flow_Sensor_Read_Hz(void) { return 0.0F; }
+extern "C" void Config_Write_U32(ConfigID_T, uint32_t) {}
+extern "C" void Config_Save(void) {}
+extern "C" void Motor_Fault_Manager_Generate_Fault(QActive *, Fault_ID_T, const char *)
+{
+    s_motor_faults++;
+}
+
+// both, every motor data field sent as soon as it changes
+extern "C" uint32_t Config_Read_U32(ConfigID_T id)
+{
+    switch (id)
+    {
+        case CFG_ID_CAN_HEARTBEAT_MS:
+            return 1000U;
+        case CFG_ID_CAN_MOTOR_DATA_VERSION:
+            return 2U;
+        case CFG_ID_ENGINE_MINUTES:
+            return 42U;
+        default:
+            return 0U;
+    }
+}
+
+extern "C" float Config_Read_F32(ConfigID_T) { return 0.0F; }
+
+// gauge
+extern "C" void BSP_Gauge_SetPressure_V(float volts)
+{
+    if ((volts != s_pressure_volts) && !s_published_us.empty())
+    {
+        s_latencies_us.push_back(BSP_Get_Microseconds() - s_published_us.front());
+        s_published_us.pop_front();
+    }
+    s_pressure_volts = volts;
+}
+extern "C" void BSP_Gauge_SetTemperature_V(float) {}
+extern "C" void BSP_Gauge_SetOpAmpRef_V(float) {}
+extern "C" void BSP_RpmGauge_SetPFM_RPM(uint32_t) {}
+extern "C" void BSP_Set_Backlight(bool) {}
+extern "C" bool BSP_Get_Backlight(void) { return false; }
+extern "C" void Fault_Manager_Generate_Fault(QActive *, Fault_ID_T, const char *)
+{
+    s_gauge_faults++;
+}
+
+// every instant on the bus: the clocks catch up, then the AOs handle what the CAN interrupts posted
+static void busHook(void)
+{
+    BSP_TimestampFake_Set_Microseconds(Virtual_CAN_Bus_Now_Ns() / 1000U);
+    qf_ctrl::ProcessEvents();
+}
+
+static uint64_t s_tunnel_rx_bytes;
+
+static void tunnelDataReady(void *cb_data)
+{
+    const Serial_IO_T *io = static_cast<const Serial_IO_T *>(cb_data);
+    uint8_t message[CAN_TRANSPORT_MAX_MESSAGE];
+    uint16_t length;
+
+    while ((length = io->rx_func(message, sizeof(message))) > 0U)
+    {
+        s_tunnel_rx_bytes += length;
+    }
+}
+
+TEST_GROUP(BoxToBoxIntegrationTests) {
+    PublishedEventRecorder *recorder;
+    uint64_t now_ns;
+    uint32_t motor_node;
+    float last_published_pressure;
+
+    void setup() final
+    {
+        qf_ctrl::MemPoolConfigs configs = {
+            {sizeof(QEvt), 8},
+            {sizeof(MotorDataEvent_T), 16},
+        };
+
+        s_gauge_faults          = 0U;
+        s_motor_faults          = 0U;
+        s_pressure_volts        = 0.0F;
+        s_tunnel_rx_bytes       = 0U;
+        last_published_pressure = 0.0F;
+        s_published_us.clear();
+        s_latencies_us.clear();
+
+        BSP_TimestampFake_Reset();
+        now_ns = BSP_Get_Microseconds() * 1000U;
+        Virtual_CAN_Bus_Reset(&s_rates, now_ns);
+        Virtual_CAN_Bus_Set_Hook(busHook);
+        motor_node = Motor_BSP_CAN_Virtual_Attach();
+        BSP_CAN_Virtual_Attach();
+
+        qf_ctrl::Setup(MOTOR_SIDE_MAX_PUB_SIG, BSP_TICKS_PER_SEC, configs);
+        recorder = PublishedEventRecorder::CreatePublishedEventRecorder(
+            qf_ctrl::RECORDER_PRIORITY, MOTOR_SIDE_MOTOR_DATA_SIG, MOTOR_SIDE_MAX_PUB_SIG);
+
+        uint8_t priority =
+            std::max(qf_ctrl::UNIT_UNDER_TEST_PRIORITY, qf_ctrl::RECORDER_PRIORITY) + 1U;
+
+        Motor_Box_To_Box_ctor();
+        QACTIVE_START(
+            Motor_AO_BOX_TO_BOX,
+            priority++,
+            s_motor_box_to_box_queue,
+            Q_DIM(s_motor_box_to_box_queue),
+            nullptr,
+            0,
+            nullptr);
+        Box_To_Box_ctor();
+        QACTIVE_START(
+            AO_BOX_TO_BOX,
+            priority++,
+            s_gauge_box_to_box_queue,
+            Q_DIM(s_gauge_box_to_box_queue),
+            nullptr,
+            0,
+            nullptr);
+        Motor_Director_ctor();
+        QACTIVE_START(
+            Motor_AO_Director,
+            priority++,
+            s_motor_director_queue,
+            Q_DIM(s_motor_director_queue),
+            nullptr,
+            0,
+            nullptr);
+        Director_ctor();
+        QACTIVE_START(
+            AO_DIRECTOR,
+            priority++,
+            s_gauge_director_queue,
+            Q_DIM(s_gauge_director_queue),
+            nullptr,
+            0,
+            nullptr);
+        qf_ctrl::ProcessEvents();
+    }
+
+    void teardown() final
+    {
+        delete recorder;
+        qf_ctrl::Teardown();
+    }
+
+    // the bus up to the next tick, then the tick
+    void step(uint32_t ms)
+    {
+        for (uint32_t i = 0U; i < ms; i++)
+        {
+            now_ns += 1000000U;
+            Virtual_CAN_Bus_Run_Until(now_ns);
+            BSP_TimestampFake_Set_Microseconds(now_ns / 1000U);
+            qf_ctrl::MoveTimeForward(std::chrono::milliseconds(1));
+            drainMotorData();
+        }
+    }
+
+    // when the motor Director published each new pressure
+    void drainMotorData()
+    {
+        while (recorder->isAnyEventRecorded())
+        {
+            auto event = recorder->getRecordedEvent();
+            auto motor = reinterpret_cast<MotorDataEvent_T const *>(event.get());
+            if (motor->pressure != last_published_pressure)
+            {
+                last_published_pressure = motor->pressure;
+                s_published_us.push_back(motor->timestamp_us);
+            }
+        }
+    }
+
+    void publishPressure(float psi)
+    {
+        FloatEvent_T event = {
+            .super        = QEVT_INITIALIZER(PUBSUB_PRESSURE_SIG),
+            .num          = psi,
+            .timestamp_us = BSP_Get_Microseconds(),
+        };
+        qf_ctrl::PublishAndProcess(&event.super);
+    }
+
+    Box_To_Box_Stats_T gaugeStats()
+    {
+        Box_To_Box_Stats_T stats;
+        Box_To_Box_Get_Stats(&stats);
+        return stats;
+    }
+
+    Box_To_Box_Stats_T motorStats()
+    {
+        Box_To_Box_Stats_T stats;
+        Motor_Box_To_Box_Get_Stats(&stats);
+        return stats;
+    }
+};
+
+TEST(BoxToBoxIntegrationTests, both_boards_start_their_can_bus)
+{
+    BSP_CAN_Virtual_Stats_T stats;
+    Motor_BSP_CAN_Virtual_Get_Stats(&stats);
+    CHECK_TRUE(stats.bus_inits > 0U);
+    BSP_CAN_Virtual_Get_Stats(&stats);
+    CHECK_TRUE(stats.bus_inits > 0U);
+}
+
+TEST(BoxToBoxIntegrationTests, new_pressure_reaches_the_gauge_one_frame_after_it_is_published)
+{
+    step(100U);
+    publishPressure(20.0F);
+    step(20U);
+
+    CHECK_EQUAL(1U, s_latencies_us.size());
+    CHECK_EQUAL(CAN_Frame_Time_Ns(CAN_MSG_MOTOR_DATA_V2_DLC, &s_rates) / 1000U, s_latencies_us[0]);
+    CHECK_TRUE(s_published_us.empty());
+}
+
+TEST(BoxToBoxIntegrationTests, rx_delay_adds_to_the_latency)
+{
+    Virtual_CAN_Bus_Set_Rx_Delay_Ns(250000U);
+    step(100U);
+    publishPressure(20.0F);
+    step(20U);
+
+    CHECK_EQUAL(1U, s_latencies_us.size());
+    CHECK_EQUAL(
+        (CAN_Frame_Time_Ns(CAN_MSG_MOTOR_DATA_V2_DLC, &s_rates) / 1000U) + 250U,
+        s_latencies_us[0]);
+}
+
+TEST(BoxToBoxIntegrationTests, gauge_counts_the_motor_data_frames_it_missed)
+{
+    step(100U);
+    Virtual_CAN_Bus_Drop_Id(CAN_MSG_MOTOR_DATA_V2_ID, 2U);
+    publishPressure(20.0F);
+    step(20U);
+    publishPressure(30.0F);
+    step(20U);
+    publishPressure(40.0F);
+    step(20U);
+
+    CHECK_EQUAL(2U, gaugeStats().motor_data_lost);
+    CHECK_EQUAL(1U, s_latencies_us.size());
+}
+
+TEST(BoxToBoxIntegrationTests, motor_recovers_from_bus_off_and_sends_what_changed_meanwhile)
+{
+    step(100U);
+    Motor_BSP_CAN_Virtual_Bus_Off();
+    qf_ctrl::ProcessEvents();
+    CHECK_EQUAL(1U, s_motor_faults);
+
+    publishPressure(20.0F);
+    step(20U);
+    CHECK_TRUE(s_latencies_us.empty());
+
+    // 50 ms backoff, 128 x 11 recessive bits, then the next bus check
+    step(200U);
+    CHECK_EQUAL(1U, motorStats().bus_off_events);
+    CHECK_EQUAL(1U, motorStats().bus_off_recoveries);
+    CHECK_FALSE(Virtual_CAN_Bus_Is_Bus_Off(motor_node));
+    CHECK_EQUAL(1U, s_latencies_us.size());
+    CHECK_EQUAL(0U, s_gauge_faults);
+}
+
+TEST(BoxToBoxIntegrationTests, gauge_syncs_to_the_motor_clock)
+{
+    step(3000U);
+
+    uint64_t local_us;
+    uint64_t remote_us = BSP_Get_Microseconds();
+    CHECK_TRUE(Box_To_Box_Remote_To_Local_Time(remote_us, &local_us));
+    CHECK_TRUE(std::max(local_us, remote_us) - std::min(local_us, remote_us) <= 2U);
+}
+
+TEST(BoxToBoxIntegrationTests, tunnel_carries_a_message_from_the_gauge_to_the_motor)
+{
+    const Serial_IO_T *motor_io = Motor_Box_To_Box_Get_Tunnel_IO();
+    const Serial_IO_T *gauge_io = Box_To_Box_Get_Tunnel_IO();
+    motor_io->register_cb_func(tunnelDataReady, (void *) motor_io);
+
+    uint8_t message[200];
+    memset(message, 0xA5, sizeof(message));
+    CHECK_EQUAL(sizeof(message), gauge_io->tx_func(message, sizeof(message)));
+    qf_ctrl::ProcessEvents();
+    step(10U);
+
+    CHECK_EQUAL(sizeof(message), s_tunnel_rx_bytes);
+}
+
+// 10 s of the pressure changing every 10 ms, as often as the motor Director publishes with its
+// default rates, while pc_com packets stream through the tunnel both ways
+TEST(BoxToBoxIntegrationTests, benchmark_frames_per_second_and_publish_to_dac_latency)
+{
+    static constexpr uint32_t SIMULATED_MS = 10000U;
+    static uint8_t packet[240];
+
+    const Serial_IO_T *motor_io = Motor_Box_To_Box_Get_Tunnel_IO();
+    const Serial_IO_T *gauge_io = Box_To_Box_Get_Tunnel_IO();
+    motor_io->register_cb_func(tunnelDataReady, (void *) motor_io);
+    gauge_io->register_cb_func(tunnelDataReady, (void *) gauge_io);
+
+    step(100U);
+    Virtual_CAN_Bus_Stats_T start;
+    Virtual_CAN_Bus_Get_Stats(&start);
+    s_tunnel_rx_bytes = 0U;
+
+    auto wall_start = std::chrono::steady_clock::now();
+    for (uint32_t ms = 0U; ms < SIMULATED_MS; ms += 10U)
+    {
+        publishPressure(10.0F + (float) ((ms / 10U) % 100U));
+        (void) motor_io->tx_func(packet, sizeof(packet));
+        (void) gauge_io->tx_func(packet, sizeof(packet));
+        qf_ctrl::ProcessEvents();
+        step(10U);
+    }
+    auto wall_end = std::chrono::steady_clock::now();
+
+    Virtual_CAN_Bus_Stats_T end;
+    Virtual_CAN_Bus_Get_Stats(&end);
+
+    double wall_s      = std::chrono::duration<double>(wall_end - wall_start).count();
+    double simulated_s = SIMULATED_MS / 1000.0;
+    uint32_t frames    = end.frames - start.frames;
+    uint64_t sum_us    = 0U;
+    for (uint64_t latency_us : s_latencies_us)
+    {
+        sum_us += latency_us;
+    }
+    uint64_t min_us = *std::min_element(s_latencies_us.begin(), s_latencies_us.end());
+    uint64_t max_us = *std::max_element(s_latencies_us.begin(), s_latencies_us.end());
+
+    UT_PRINT(StringFromFormat(
+                 "virtual CAN: %u frames in %.1f s simulated, %.0f frames/s simulated, "
+                 "%.0f frames/s wall clock, %.1f simulated s per s",
+                 frames,
+                 simulated_s,
+                 frames / simulated_s,
+                 frames / wall_s,
+                 simulated_s / wall_s)
+                 .asCharString());
+    UT_PRINT(StringFromFormat(
+                 "virtual CAN: bus busy %.1f %%, tunnel %.0f B/s, publish to DAC latency "
+                 "min %u us mean %.1f us max %u us over %u samples",
+                 100.0 * (double) (end.busy_ns - start.busy_ns) / (simulated_s * 1e9),
+                 s_tunnel_rx_bytes / simulated_s,
+                 (unsigned) min_us,
+                 (double) sum_us / (double) s_latencies_us.size(),
+                 (unsigned) max_us,
+                 (unsigned) s_latencies_us.size())
+                 .asCharString());
+
+    // every new pressure gets through, behind at most a tunnel segment that already had the bus
+    CHECK_EQUAL(0U, gaugeStats().motor_data_lost);
+    CHECK_TRUE(s_latencies_us.size() >= ((SIMULATED_MS / 10U) - 1U));
+    CHECK_TRUE(
+        max_us <= ((CAN_Frame_Time_Ns(CAN_MSG_TUNNEL_MOTOR_DLC, &s_rates) +
+                    CAN_Frame_Time_Ns(CAN_MSG_MOTOR_DATA_V2_DLC, &s_rates)) /
+                   1000U));
+}
@@ -1,7 +1,15 @@
 extern "C" {
 #include "box_to_box.h"
+#include "bsp.h"
 #include "bsp_box_to_box_mock.h"
+#include "bsp_timestamp_fake.h"
+#include "can_bus_load.h"
 #include "can_messages.h"
+#include "can_rx_ring.h"
+#include "can_stats.h"
+#include "can_tx_queue.h"
+#include "config.h"
+#include "posted_signals.h"
 #include "pubsub_signals.h"
 }
 
@@ -12,11 +20,61 @@ extern "C" {
 using namespace cms::test;
 
 static QEvt const *s_queue_storage[10];
+static uint32_t s_motor_data_version;
+
+extern "C" uint32_t Config_Read_U32(ConfigID_T id)
+{
+    switch (id)
+    {
+        case CFG_ID_CAN_HEARTBEAT_MS:
+            return 250U;
+        case CFG_ID_CAN_MOTOR_DATA_VERSION:
+            return s_motor_data_version;
+        default:
+            return 0U;
+    }
+}
+
+extern "C" float Config_Read_F32(ConfigID_T id)
+{
+    switch (id)
+    {
+        case CFG_ID_CAN_TEMPERATURE_DEADBAND:
+            return 0.5F;
+        case CFG_ID_CAN_PRESSURE_DEADBAND:
+            return 0.1F;
+        case CFG_ID_CAN_TACHOMETER_DEADBAND:
+            return 20.0F;
+        case CFG_ID_CAN_VBAT_DEADBAND:
+            return 0.05F;
+        default:
+            return 0.0F;
+    }
+}
+
+static MotorDataEvent_T makeMotorDataEvent(void)
+{
+    MotorDataEvent_T event = {
+        .super              = QEVT_INITIALIZER(PUBSUB_MOTOR_DATA_SIG),
+        .temperature        = 70.0F,
+        .pressure           = 10.0F,
+        .tachometer         = 2000.0F,
+        .vbat               = 13.0F,
+        .engine_minutes     = 100U,
+        .timestamp_us       = 1000000U,
+        .temperature_age_us = 20000U,
+        .pressure_age_us    = 10000U,
+        .updated            = MOTOR_DATA_UPDATED_TACHOMETER,
+    };
+    return event;
+}
 
 TEST_GROUP(BoxToBoxMotorTests) {
     void setup() final
     {
         BSP_BoxToBoxMock_Reset();
+        BSP_TimestampFake_Reset();
+        s_motor_data_version = 2U;
         qf_ctrl::Setup(PUBSUB_MAX_SIG, 1000);
         Box_To_Box_ctor();
         QACTIVE_START(
@@ -35,6 +93,35 @@ TEST_GROUP(BoxToBoxMotorTests) {
     {
         qf_ctrl::Teardown();
     }
+
+    void postSignal(enum_t sig)
+    {
+        QEvt event = QEVT_INITIALIZER(sig);
+        qf_ctrl::PostAndProcess(&event, AO_BOX_TO_BOX);
+    }
+
+    // a frame from the gauge, through the RX ring like the FDCAN RX interrupt does
+    void postTimeSyncReq(uint8_t sequence, uint64_t rx_us)
+    {
+        CAN_Msg_Time_Sync_Req_T req = {.sequence = sequence};
+        CAN_Message_T msg           = {};
+        CAN_Pack_Time_Sync_Req(&req, &msg);
+        msg.timestamp_us = rx_us;
+
+        *CAN_Rx_Ring_Reserve() = msg;
+        CAN_Rx_Ring_Commit();
+        if (CAN_Rx_Ring_Notify_Needed())
+        {
+            postSignal(POSTED_CAN_FRAMES_AVAILABLE_SIG);
+        }
+    }
+
+    CAN_Msg_Time_Sync_Resp_T lastTimeSyncResp()
+    {
+        CAN_Msg_Time_Sync_Resp_T resp = {};
+        CHECK_TRUE(CAN_Unpack_Time_Sync_Resp(BSP_BoxToBoxMock_GetLastCanMsg(), &resp));
+        return resp;
+    }
 };
 
 TEST(BoxToBoxMotorTests, startup_initializes_can_bus)
@@ -44,28 +131,33 @@ TEST(BoxToBoxMotorTests, startup_initializes_can_bus)
 
 TEST(BoxToBoxMotorTests, motor_data_event_is_encoded_as_can_motor_data_message)
 {
+    s_motor_data_version = 1U;
+
     MotorDataEvent_T event = {
-        .super          = QEVT_INITIALIZER(PUBSUB_MOTOR_DATA_SIG),
-        .temperature    = 81.5F,
-        .pressure       = 12.25F,
-        .tachometer     = 2350.0F,
-        .vbat           = 13.2F,
-        .engine_minutes = 456U,
-        .start          = true,
-        .neutral        = false,
-        .buzzer         = true,
-        .temp_good      = true,
-        .pres_good      = false,
+        .super              = QEVT_INITIALIZER(PUBSUB_MOTOR_DATA_SIG),
+        .temperature        = 81.5F,
+        .pressure           = 12.25F,
+        .tachometer         = 2350.0F,
+        .vbat               = 13.2F,
+        .engine_minutes     = 456U,
+        .start              = true,
+        .neutral            = false,
+        .buzzer             = true,
+        .temp_good          = true,
+        .pres_good          = false,
+        .timestamp_us       = 0x123456789ULL,
+        .temperature_age_us = 40000U,
+        .pressure_age_us    = SAMPLE_AGE_UNKNOWN_US,
+        .updated            = MOTOR_DATA_UPDATED_ALL,
     };
 
     qf_ctrl::PublishAndProcess(&event.super);
 
     CHECK_EQUAL(1U, BSP_BoxToBoxMock_GetCanWriteCount());
 
-    CAN_Msg_Motor_Data_T const *msg =
-        reinterpret_cast<CAN_Msg_Motor_Data_T const *>(BSP_BoxToBoxMock_GetLastCanMsg());
-    CHECK_EQUAL(CAN_MSG_MOTOR_DATA_ID, msg->id);
-    CHECK_EQUAL(CAN_MSG_MOTOR_DATA_DLC, msg->dlc);
+    CAN_Msg_Motor_Data_T unpacked;
+    CHECK_TRUE(CAN_Unpack_Motor_Data(BSP_BoxToBoxMock_GetLastCanMsg(), &unpacked));
+    CAN_Msg_Motor_Data_T const *msg = &unpacked;
     CHECK_EQUAL(1234U, msg->tick);
     DOUBLES_EQUAL(event.temperature, msg->temperature, 0.001);
     DOUBLES_EQUAL(event.pressure, msg->pressure, 0.001);
@@ -77,17 +169,338 @@ TEST(BoxToBoxMotorTests, motor_data_event_is_encoded_as_can_motor_data_message)
     CHECK_EQUAL(event.buzzer, msg->buzzer);
     CHECK_EQUAL(event.temp_good, msg->temp_good);
     CHECK_EQUAL(event.pres_good, msg->pres_good);
+    CHECK_EQUAL(event.timestamp_us, msg->timestamp_us);
+    CHECK_EQUAL(event.temperature_age_us, msg->temperature_age_us);
+    CHECK_EQUAL(event.pressure_age_us, msg->pressure_age_us);
+    CHECK_EQUAL(event.updated, msg->updated);
 }
 
-TEST(BoxToBoxMotorTests, can_write_failure_generates_can_fault)
+TEST(BoxToBoxMotorTests, motor_data_event_is_encoded_as_compact_v2_frame_by_default)
 {
-    BSP_BoxToBoxMock_SetCanWriteRetval(-1);
+    MotorDataEvent_T event = {
+        .super              = QEVT_INITIALIZER(PUBSUB_MOTOR_DATA_SIG),
+        .temperature        = -12.345F,
+        .pressure           = 12.25F,
+        .tachometer         = 2350.4F,
+        .vbat               = 13.2F,
+        .engine_minutes     = 456U,
+        .start              = true,
+        .neutral            = false,
+        .buzzer             = true,
+        .temp_good          = true,
+        .pres_good          = false,
+        .timestamp_us       = 0x123456789ULL,
+        .temperature_age_us = 40000U,
+        .pressure_age_us    = SAMPLE_AGE_UNKNOWN_US,
+    };
+
+    qf_ctrl::PublishAndProcess(&event.super);
+
+    CHECK_EQUAL(1U, BSP_BoxToBoxMock_GetCanWriteCount());
+
+    CAN_Message_T const *frame = BSP_BoxToBoxMock_GetLastCanMsg();
+    CHECK_EQUAL(CAN_MSG_MOTOR_DATA_V2_ID, frame->id);
+    CHECK_EQUAL(CAN_MSG_MOTOR_DATA_V2_DLC, frame->dlc);
+    CHECK_EQUAL(12U, CAN_DLC_to_Bytes[frame->dlc]);
 
-    MotorDataEvent_T event = {};
-    event.super            = QEVT_INITIALIZER(PUBSUB_MOTOR_DATA_SIG);
+    CAN_Msg_Motor_Data_V2_T unpacked;
+    CHECK_TRUE(CAN_Unpack_Motor_Data_V2(frame, &unpacked));
+    CAN_Msg_Motor_Data_V2_T const *msg = &unpacked;
+    CHECK_EQUAL(-1235, msg->temperature);
+    CHECK_EQUAL(1225U, msg->pressure);
+    CHECK_EQUAL(2350U, msg->tachometer);
+    CHECK_EQUAL(13200U, msg->vbat);
 
+    uint32_t status = msg->status;
+    CHECK_EQUAL(0U, status & CAN_MOTOR_DATA_V2_SEQUENCE_MASK);
+    CHECK_TRUE((status & CAN_MOTOR_DATA_V2_START_BIT) != 0U);
+    CHECK_TRUE((status & CAN_MOTOR_DATA_V2_NEUTRAL_BIT) == 0U);
+    CHECK_TRUE((status & CAN_MOTOR_DATA_V2_BUZZER_BIT) != 0U);
+    CHECK_TRUE((status & CAN_MOTOR_DATA_V2_TEMP_GOOD_BIT) != 0U);
+    CHECK_TRUE((status & CAN_MOTOR_DATA_V2_PRES_GOOD_BIT) == 0U);
+    CHECK_TRUE((status & CAN_MOTOR_DATA_V2_NO_TEMPERATURE_BIT) == 0U);
+    CHECK_TRUE((status & CAN_MOTOR_DATA_V2_NO_PRESSURE_BIT) != 0U);
+    CHECK_EQUAL(456U, status >> CAN_MOTOR_DATA_V2_ENGINE_MINUTES_SHIFT);
+
+    // every frame takes the next sequence number
+    event.neutral = true;
     qf_ctrl::PublishAndProcess(&event.super);
+    CHECK_TRUE(CAN_Unpack_Motor_Data_V2(BSP_BoxToBoxMock_GetLastCanMsg(), &unpacked));
+    CHECK_EQUAL(1U, unpacked.status & CAN_MOTOR_DATA_V2_SEQUENCE_MASK);
+}
 
+TEST(BoxToBoxMotorTests, v2_frame_saturates_out_of_range_values)
+{
+    MotorDataEvent_T event = makeMotorDataEvent();
+    event.temperature      = 1000.0F;
+    event.pressure         = -5.0F;
+    event.tachometer       = 100000.0F;
+    event.engine_minutes   = UINT32_MAX;
+
+    qf_ctrl::PublishAndProcess(&event.super);
+
+    CAN_Msg_Motor_Data_V2_T msg;
+    CHECK_TRUE(CAN_Unpack_Motor_Data_V2(BSP_BoxToBoxMock_GetLastCanMsg(), &msg));
+    CHECK_EQUAL(INT16_MAX, msg.temperature);
+    CHECK_EQUAL(0U, msg.pressure);
+    CHECK_EQUAL(UINT16_MAX, msg.tachometer);
+    uint32_t engine_minutes = msg.status >> CAN_MOTOR_DATA_V2_ENGINE_MINUTES_SHIFT;
+    CHECK_EQUAL(CAN_MOTOR_DATA_V2_ENGINE_MINUTES_MAX, engine_minutes);
+}
+
+TEST(BoxToBoxMotorTests, full_tx_fifo_keeps_the_frame_queued_until_tx_complete)
+{
+    BSP_BoxToBoxMock_SetCanWriteRetval(1);
+
+    MotorDataEvent_T event = makeMotorDataEvent();
+    qf_ctrl::PublishAndProcess(&event.super);
+    CHECK_EQUAL(1U, BSP_BoxToBoxMock_GetCanWriteCount());
+    CHECK_EQUAL(1U, CAN_Tx_Queue_Count());
+
+    BSP_BoxToBoxMock_SetCanWriteRetval(0);
+    postSignal(POSTED_CAN_TX_COMPLETE_SIG);
+
+    CHECK_EQUAL(2U, BSP_BoxToBoxMock_GetCanWriteCount());
+    CHECK_EQUAL(CAN_MSG_MOTOR_DATA_V2_ID, BSP_BoxToBoxMock_GetLastCanMsg()->id);
+    CHECK_EQUAL(0U, CAN_Tx_Queue_Count());
+    CHECK_EQUAL(0U, BSP_BoxToBoxMock_GetFaultCount());
+}
+
+TEST(BoxToBoxMotorTests, only_the_latest_motor_data_waits_for_the_bus)
+{
+    BSP_BoxToBoxMock_SetCanWriteRetval(1);
+
+    MotorDataEvent_T event = makeMotorDataEvent();
+    qf_ctrl::PublishAndProcess(&event.super);
+    event.tachometer = 3000.0F;
+    qf_ctrl::PublishAndProcess(&event.super);
+    CHECK_EQUAL(1U, CAN_Tx_Queue_Count());
+
+    BSP_BoxToBoxMock_SetCanWriteRetval(0);
+    postSignal(POSTED_CAN_TX_COMPLETE_SIG);
+
+    CAN_Msg_Motor_Data_V2_T msg;
+    CHECK_TRUE(CAN_Unpack_Motor_Data_V2(BSP_BoxToBoxMock_GetLastCanMsg(), &msg));
+    CHECK_EQUAL(3000U, msg.tachometer);
+
+    CAN_Tx_Queue_Stats_T queue_stats;
+    CAN_Tx_Queue_Get_Stats(&queue_stats);
+    CHECK_EQUAL(1U, queue_stats.replaced);
+    CHECK_EQUAL(1U, queue_stats.sent);
+}
+
+TEST(BoxToBoxMotorTests, bus_off_generates_can_fault_and_recovers_with_backoff)
+{
+    BSP_BoxToBoxMock_SetCanBusState(CAN_BUS_STATE_OFF);
+    postSignal(POSTED_CAN_BUS_STATUS_SIG);
     CHECK_EQUAL(1U, BSP_BoxToBoxMock_GetFaultCount());
     CHECK_EQUAL(FAULT_ID_CAN_FAILURE, BSP_BoxToBoxMock_GetLastFaultId());
+
+    // nothing goes to the FDCAN while it is off the bus
+    MotorDataEvent_T event = makeMotorDataEvent();
+    qf_ctrl::PublishAndProcess(&event.super);
+    CHECK_EQUAL(0U, BSP_BoxToBoxMock_GetCanWriteCount());
+
+    qf_ctrl::MoveTimeForward(std::chrono::milliseconds(50));
+    CHECK_EQUAL(1U, BSP_BoxToBoxMock_GetCanBusRecoverCount());
+
+    // back on the bus at the next status check, with the frame that was waiting
+    BSP_BoxToBoxMock_SetCanBusState(CAN_BUS_STATE_ACTIVE);
+    qf_ctrl::MoveTimeForward(std::chrono::milliseconds(100));
+    CHECK_EQUAL(1U, BSP_BoxToBoxMock_GetCanWriteCount());
+
+    // off again before a frame got through, so the next attempt waits twice as long
+    BSP_BoxToBoxMock_SetCanBusState(CAN_BUS_STATE_OFF);
+    postSignal(POSTED_CAN_BUS_STATUS_SIG);
+    qf_ctrl::MoveTimeForward(std::chrono::milliseconds(50));
+    CHECK_EQUAL(1U, BSP_BoxToBoxMock_GetCanBusRecoverCount());
+    qf_ctrl::MoveTimeForward(std::chrono::milliseconds(50));
+    CHECK_EQUAL(2U, BSP_BoxToBoxMock_GetCanBusRecoverCount());
+
+    Box_To_Box_Stats_T stats;
+    Box_To_Box_Get_Stats(&stats);
+    CHECK_EQUAL(2U, stats.bus_off_events);
+    CHECK_EQUAL(2U, stats.bus_off_recoveries);
+}
+
+TEST(BoxToBoxMotorTests, error_passive_is_counted_but_keeps_sending)
+{
+    BSP_BoxToBoxMock_SetCanBusState(CAN_BUS_STATE_PASSIVE);
+    postSignal(POSTED_CAN_BUS_STATUS_SIG);
+    qf_ctrl::MoveTimeForward(std::chrono::milliseconds(100));
+
+    MotorDataEvent_T event = makeMotorDataEvent();
+    qf_ctrl::PublishAndProcess(&event.super);
+    CHECK_EQUAL(1U, BSP_BoxToBoxMock_GetCanWriteCount());
+
+    Box_To_Box_Stats_T stats;
+    Box_To_Box_Get_Stats(&stats);
+    CHECK_EQUAL(1U, stats.error_passive_events);
+    CHECK_EQUAL(CAN_BUS_STATE_PASSIVE, stats.bus.state);
+    CHECK_EQUAL(0U, BSP_BoxToBoxMock_GetFaultCount());
+}
+
+TEST(BoxToBoxMotorTests, data_phase_errors_before_any_brs_frame_fall_back_to_the_nominal_rate)
+{
+    BSP_BoxToBoxMock_SetCanDataPhaseError();
+    postSignal(POSTED_CAN_BUS_STATUS_SIG);
+
+    Box_To_Box_Stats_T stats;
+    Box_To_Box_Get_Stats(&stats);
+    CHECK_EQUAL(1U, stats.brs_fallbacks);
+
+    CAN_Bit_Rates_T rates;
+    BSP_CAN_Get_Bit_Rates(&rates);
+    CHECK_FALSE(rates.brs);
+}
+
+TEST(BoxToBoxMotorTests, data_phase_errors_after_a_brs_frame_got_through_keep_brs)
+{
+    MotorDataEvent_T event = makeMotorDataEvent();
+    qf_ctrl::PublishAndProcess(&event.super);
+    postSignal(POSTED_CAN_TX_COMPLETE_SIG);
+
+    BSP_BoxToBoxMock_SetCanDataPhaseError();
+    postSignal(POSTED_CAN_BUS_STATUS_SIG);
+
+    Box_To_Box_Stats_T stats;
+    Box_To_Box_Get_Stats(&stats);
+    CHECK_EQUAL(0U, stats.brs_fallbacks);
+}
+
+TEST(BoxToBoxMotorTests, bus_load_is_measured_over_a_second_with_and_without_brs)
+{
+    MotorDataEvent_T event = makeMotorDataEvent();
+    qf_ctrl::PublishAndProcess(&event.super);
+    qf_ctrl::MoveTimeForward(std::chrono::milliseconds(1000));
+
+    // a 12 byte frame is 30 bits at 1 Mbit/s plus 128 at 4 Mbit/s, or 158 bits at 1 Mbit/s
+    CAN_Bit_Rates_T rates;
+    BSP_CAN_Get_Bit_Rates(&rates);
+    CHECK_EQUAL(62000U, CAN_Frame_Time_Ns(CAN_MSG_MOTOR_DATA_V2_DLC, &rates));
+
+    Box_To_Box_Stats_T stats;
+    Box_To_Box_Get_Stats(&stats);
+    CHECK_EQUAL(0U, stats.bus_load); // 62 us of a second
+    CHECK_EQUAL(0U, stats.bus_load_nominal);
+
+    // 100 frames in the next second, each past the tachometer deadband
+    for (uint32_t i = 1U; i <= 100U; i++)
+    {
+        event.tachometer += 100.0F;
+        qf_ctrl::PublishAndProcess(&event.super);
+    }
+    qf_ctrl::MoveTimeForward(std::chrono::milliseconds(1000));
+
+    Box_To_Box_Get_Stats(&stats);
+    CHECK_EQUAL(6U, stats.bus_load);          // 6.2 ms
+    CHECK_EQUAL(15U, stats.bus_load_nominal); // 15.8 ms
+}
+
+TEST(BoxToBoxMotorTests, tx_latency_is_recorded_from_the_tx_event_fifo)
+{
+    BSP_BoxToBoxMock_SetCanTxQueuedUs(250U);
+
+    MotorDataEvent_T event = makeMotorDataEvent();
+    qf_ctrl::PublishAndProcess(&event.super);
+    postSignal(POSTED_CAN_TX_COMPLETE_SIG);
+
+    CAN_Id_Stats_T stats;
+    CAN_Stats_Get_Id(CAN_MSG_MOTOR_DATA_V2_ID, &stats);
+    CHECK_EQUAL(1U, stats.tx_frames);
+    CHECK_EQUAL(1U, stats.tx_events);
+    CHECK_EQUAL(1U, stats.tx_latency_us.count);
+    CHECK_EQUAL(250U + 62U, stats.tx_latency_us.min); // waited, then 62 us on the wire
+}
+
+TEST(BoxToBoxMotorTests, motor_data_inside_the_deadbands_is_suppressed_until_the_heartbeat)
+{
+    s_motor_data_version = 1U;
+
+    MotorDataEvent_T event = makeMotorDataEvent();
+    qf_ctrl::PublishAndProcess(&event.super);
+    CHECK_EQUAL(1U, BSP_BoxToBoxMock_GetCanWriteCount());
+
+    // small moves and fresh timestamps alone don't need a frame
+    event.temperature += 0.4F;
+    event.tachometer += 15.0F;
+    event.timestamp_us += 10000U;
+    event.updated = MOTOR_DATA_UPDATED_TEMPERATURE;
+    BSP_BoxToBoxMock_SetMillisecondsTick(1234U + 100U);
+    qf_ctrl::PublishAndProcess(&event.super);
+    CHECK_EQUAL(1U, BSP_BoxToBoxMock_GetCanWriteCount());
+
+    event.updated = MOTOR_DATA_UPDATED_TACHOMETER;
+    BSP_BoxToBoxMock_SetMillisecondsTick(1234U + 250U);
+    qf_ctrl::PublishAndProcess(&event.super);
+    CHECK_EQUAL(2U, BSP_BoxToBoxMock_GetCanWriteCount());
+
+    // the heartbeat frame carries every field updated since the last frame
+    CAN_Msg_Motor_Data_T msg;
+    CHECK_TRUE(CAN_Unpack_Motor_Data(BSP_BoxToBoxMock_GetLastCanMsg(), &msg));
+    CHECK_EQUAL(MOTOR_DATA_UPDATED_TACHOMETER | MOTOR_DATA_UPDATED_TEMPERATURE, msg.updated);
+
+    Box_To_Box_Stats_T stats;
+    Box_To_Box_Get_Stats(&stats);
+    CHECK_EQUAL(3U, stats.motor_data_events);
+    CHECK_EQUAL(2U, stats.motor_data_frames);
+    CHECK_EQUAL(1U, stats.motor_data_suppressed);
+    CHECK_EQUAL(1U, stats.heartbeat_frames);
+}
+
+TEST(BoxToBoxMotorTests, field_past_its_deadband_is_sent_immediately)
+{
+    MotorDataEvent_T event = makeMotorDataEvent();
+    qf_ctrl::PublishAndProcess(&event.super);
+
+    event.tachometer += 25.0F;
+    qf_ctrl::PublishAndProcess(&event.super);
+    CHECK_EQUAL(2U, BSP_BoxToBoxMock_GetCanWriteCount());
+
+    // the deadband is measured from the last frame, not the last event
+    event.tachometer += 15.0F;
+    qf_ctrl::PublishAndProcess(&event.super);
+    event.tachometer += 15.0F;
+    qf_ctrl::PublishAndProcess(&event.super);
+    CHECK_EQUAL(3U, BSP_BoxToBoxMock_GetCanWriteCount());
+
+    Box_To_Box_Stats_T stats;
+    Box_To_Box_Get_Stats(&stats);
+    CHECK_EQUAL(0U, stats.heartbeat_frames);
+}
+
+TEST(BoxToBoxMotorTests, flag_change_or_lost_sensor_is_sent_immediately)
+{
+    MotorDataEvent_T event = makeMotorDataEvent();
+    qf_ctrl::PublishAndProcess(&event.super);
+
+    event.neutral = true;
+    qf_ctrl::PublishAndProcess(&event.super);
+    CHECK_EQUAL(2U, BSP_BoxToBoxMock_GetCanWriteCount());
+
+    event.pressure_age_us = SAMPLE_AGE_UNKNOWN_US;
+    qf_ctrl::PublishAndProcess(&event.super);
+    CHECK_EQUAL(3U, BSP_BoxToBoxMock_GetCanWriteCount());
+}
+
+TEST(BoxToBoxMotorTests, time_sync_request_is_answered_with_its_rx_and_the_last_tx_time)
+{
+    postTimeSyncReq(7U, 1500000U);
+
+    CAN_Msg_Time_Sync_Resp_T resp = lastTimeSyncResp();
+    CHECK_EQUAL(7U, resp.sequence);
+    CHECK_EQUAL(1500000U, resp.request_rx_us);
+    CHECK_EQUAL(0U, resp.flags & CAN_TIME_SYNC_LAST_VALID_BIT);
+
+    // the response started 100 us after the write, at 1000100 on the fake clock
+    postSignal(POSTED_CAN_TX_COMPLETE_SIG);
+
+    postTimeSyncReq(8U, 2500000U);
+
+    resp = lastTimeSyncResp();
+    CHECK_EQUAL(8U, resp.sequence);
+    CHECK_EQUAL(2500000U, resp.request_rx_us);
+    CHECK_EQUAL(7U, resp.last_sequence);
+    CHECK_EQUAL(CAN_TIME_SYNC_LAST_VALID_BIT, resp.flags & CAN_TIME_SYNC_LAST_VALID_BIT);
+    CHECK_EQUAL(1000100U, resp.last_response_tx_us);
 }
@@ -0,0 +1,63 @@
+extern "C" {
+#include "can_bus_load.h"
+}
+
+#include <cstdint>
+
+#include "CppUTest/TestHarness.h"
+
+static const CAN_Bit_Rates_T s_nominal_only = {
+    .nominal_bps = 1000000U,
+    .data_bps    = 1000000U,
+    .brs         = false,
+};
+
+static const CAN_Bit_Rates_T s_brs = {
+    .nominal_bps = 1000000U,
+    .data_bps    = 4000000U,
+    .brs         = true,
+};
+
+TEST_GROUP(CanBusLoadTests) {
+};
+
+TEST(CanBusLoadTests, frame_time_counts_every_bit_at_the_nominal_rate_without_brs)
+{
+    // 8 bytes: 30 nominal bits + 5 + 64 + 27 data bits = 126 bits at 1 us
+    CHECK_EQUAL(126000U, CAN_Frame_Time_Ns(8U, &s_nominal_only));
+
+    // 48 bytes (DLC 14) switch to the 21 bit CRC: 30 + 5 + 384 + 32 = 451 bits
+    CHECK_EQUAL(451000U, CAN_Frame_Time_Ns(14U, &s_nominal_only));
+}
+
+TEST(CanBusLoadTests, brs_only_speeds_up_the_data_phase)
+{
+    // 30 nominal bits at 1 us, 96 data bits at 250 ns
+    CHECK_EQUAL(30000U + 24000U, CAN_Frame_Time_Ns(8U, &s_brs));
+}
+
+TEST(CanBusLoadTests, brs_is_ignored_when_not_in_use)
+{
+    CAN_Bit_Rates_T rates = s_brs;
+    rates.brs             = false;
+
+    CHECK_EQUAL(CAN_Frame_Time_Ns(8U, &s_nominal_only), CAN_Frame_Time_Ns(8U, &rates));
+}
+
+TEST(CanBusLoadTests, load_keeps_the_nominal_equivalent_alongside)
+{
+    CAN_Bus_Load_T load = {};
+
+    CAN_Bus_Load_Add(&load, 8U, &s_brs);
+    CAN_Bus_Load_Add(&load, 8U, &s_brs);
+
+    CHECK_EQUAL(2U * 54000U, load.busy_ns);
+    CHECK_EQUAL(2U * 126000U, load.busy_nominal_ns);
+}
+
+TEST(CanBusLoadTests, permille_of_the_window)
+{
+    CHECK_EQUAL(0U, CAN_Bus_Load_Permille(0U, 1000U));
+    CHECK_EQUAL(126U, CAN_Bus_Load_Permille(126000000U, 1000U));
+    CHECK_EQUAL(1000U, CAN_Bus_Load_Permille(2000000000U, 1000U));
+}
@@ -0,0 +1,153 @@
+extern "C" {
+#include "can_messages.h"
+}
+
+#include <cstdint>
+
+#include "CppUTest/TestHarness.h"
+
+// can_messages.h already refuses to compile when a payload doesn't add up to its DLC, these pin
+// the sizes the other box depends on
+static_assert(CAN_MSG_TEST1_SIZE == 8U, "test1 payload changed");
+static_assert(CAN_MSG_MOTOR_DATA_SIZE == 48U, "motor data v1 payload changed");
+static_assert(CAN_MSG_MOTOR_DATA_V2_SIZE == 12U, "motor data v2 payload changed");
+static_assert(CAN_MSG_TDS_SIZE == 16U, "TDS payload changed");
+static_assert(CAN_MSG_WATER_GOOD_SIZE == 5U, "water good payload changed");
+static_assert(CAN_MSG_TUNNEL_MOTOR_SIZE == 64U, "tunnel segment payload changed");
+static_assert(CAN_MSG_TUNNEL_MOTOR_ACK_SIZE == 2U, "tunnel ack payload changed");
+static_assert(CAN_DLC_BYTES(FDCAN_DLC_BYTES_48) == 48U, "DLC 14 is 48 bytes");
+
+TEST_GROUP(CanMessagesTests) {
+};
+
+TEST(CanMessagesTests, dlc_bytes_macro_matches_lookup_table)
+{
+    for (uint32_t dlc = 0U; dlc < 16U; dlc++)
+    {
+        CHECK_EQUAL(CAN_DLC_to_Bytes[dlc], CAN_DLC_BYTES(dlc));
+    }
+}
+
+TEST(CanMessagesTests, v2_fields_are_packed_little_endian_in_declaration_order)
+{
+    CAN_Msg_Motor_Data_V2_T msg = {
+        .temperature = -2,
+        .pressure    = 0x1234U,
+        .tachometer  = 0x5678U,
+        .vbat        = 0x9ABCU,
+        .status      = 0x11223344U,
+    };
+
+    CAN_Message_T frame = {};
+    CAN_Pack_Motor_Data_V2(&msg, &frame);
+
+    const uint8_t expected[] = {
+        0xFE, 0xFF, 0x34, 0x12, 0x78, 0x56, 0xBC, 0x9A, 0x44, 0x33, 0x22, 0x11};
+    CHECK_EQUAL(CAN_MSG_MOTOR_DATA_V2_ID, frame.id);
+    CHECK_EQUAL(CAN_MSG_MOTOR_DATA_V2_DLC, frame.dlc);
+    MEMCMP_EQUAL(expected, frame.data, sizeof(expected));
+}
+
+TEST(CanMessagesTests, motor_data_round_trips)
+{
+    CAN_Msg_Motor_Data_T msg = {
+        .tick               = 99U,
+        .temperature        = 76.5F,
+        .pressure           = -8.25F,
+        .tachometer         = 1800.0F,
+        .vbat               = 12.6F,
+        .engine_minutes     = 789U,
+        .start              = true,
+        .neutral            = false,
+        .buzzer             = true,
+        .temp_good          = false,
+        .pres_good          = true,
+        .updated            = 0x21U,
+        .reserved           = 0U,
+        .timestamp_us       = 0x0123456789ABCDEFULL,
+        .temperature_age_us = 60000U,
+        .pressure_age_us    = UINT32_MAX,
+    };
+
+    CAN_Message_T frame = {};
+    CAN_Pack_Motor_Data(&msg, &frame);
+
+    CAN_Msg_Motor_Data_T out = {};
+    CHECK_TRUE(CAN_Unpack_Motor_Data(&frame, &out));
+    CHECK_EQUAL(msg.tick, out.tick);
+    DOUBLES_EQUAL(msg.temperature, out.temperature, 0.0);
+    DOUBLES_EQUAL(msg.pressure, out.pressure, 0.0);
+    DOUBLES_EQUAL(msg.tachometer, out.tachometer, 0.0);
+    DOUBLES_EQUAL(msg.vbat, out.vbat, 0.0);
+    CHECK_EQUAL(msg.engine_minutes, out.engine_minutes);
+    CHECK_EQUAL(msg.start, out.start);
+    CHECK_EQUAL(msg.neutral, out.neutral);
+    CHECK_EQUAL(msg.buzzer, out.buzzer);
+    CHECK_EQUAL(msg.temp_good, out.temp_good);
+    CHECK_EQUAL(msg.pres_good, out.pres_good);
+    CHECK_EQUAL(msg.updated, out.updated);
+    CHECK_EQUAL(msg.timestamp_us, out.timestamp_us);
+    CHECK_EQUAL(msg.temperature_age_us, out.temperature_age_us);
+    CHECK_EQUAL(msg.pressure_age_us, out.pressure_age_us);
+}
+
+TEST(CanMessagesTests, unpack_rejects_wrong_id_or_dlc)
+{
+    CAN_Msg_Water_Good_T msg = {.tick = 1U, .water_good = true};
+
+    CAN_Message_T frame = {};
+    CAN_Pack_Water_Good(&msg, &frame);
+
+    CAN_Msg_TDS_T tds;
+    CHECK_FALSE(CAN_Unpack_TDS(&frame, &tds));
+
+    frame.dlc = FDCAN_DLC_BYTES_8;
+    CAN_Msg_Water_Good_T out;
+    CHECK_FALSE(CAN_Unpack_Water_Good(&frame, &out));
+}
+
+TEST(CanMessagesTests, tunnel_segment_carries_its_data_bytes_after_the_header)
+{
+    CAN_Msg_Tunnel_Gauge_T msg = {
+        .sequence = 0xA5U,
+        .flags    = CAN_TRANSPORT_FIRST_BIT | CAN_TRANSPORT_LAST_BIT,
+        .length   = 0x0102U,
+        .data     = {},
+    };
+    for (uint32_t i = 0U; i < sizeof(msg.data); i++)
+    {
+        msg.data[i] = (uint8_t) (i + 1U);
+    }
+
+    CAN_Message_T frame = {};
+    CAN_Pack_Tunnel_Gauge(&msg, &frame);
+
+    CHECK_EQUAL(FDCAN_DLC_BYTES_64, frame.dlc);
+    CHECK_EQUAL(0xA5U, frame.data[0]);
+    CHECK_EQUAL(0x03U, frame.data[1]);
+    CHECK_EQUAL(0x02U, frame.data[2]);
+    CHECK_EQUAL(0x01U, frame.data[3]);
+    MEMCMP_EQUAL(msg.data, &frame.data[4], sizeof(msg.data));
+
+    CAN_Msg_Tunnel_Gauge_T out;
+    CHECK_TRUE(CAN_Unpack_Tunnel_Gauge(&frame, &out));
+    CHECK_EQUAL(msg.length, out.length);
+    MEMCMP_EQUAL(msg.data, out.data, sizeof(msg.data));
+
+    // same layout, but the other direction's ID
+    CAN_Msg_Tunnel_Motor_T other;
+    CHECK_FALSE(CAN_Unpack_Tunnel_Motor(&frame, &other));
+}
+
+TEST(CanMessagesTests, info_table_follows_the_registry)
+{
+    CHECK_EQUAL(11U, CAN_MSG_COUNT);
+    CHECK_EQUAL(CAN_MSG_TUNNEL_GAUGE_ACK_ID + 1U, CAN_MSG_ID_SPAN);
+
+    CHECK_EQUAL(CAN_MSG_MOTOR_DATA_ID, CAN_Msg_Info[CAN_MSG_INDEX_MOTOR_DATA].id);
+    CHECK_EQUAL(CAN_MSG_MOTOR_DATA_DLC, CAN_Msg_Info[CAN_MSG_INDEX_MOTOR_DATA].dlc);
+    CHECK_EQUAL(CAN_RX_GAUGE, CAN_Msg_Info[CAN_MSG_INDEX_MOTOR_DATA].rx_boards);
+    CHECK_EQUAL(CAN_RX_NONE, CAN_Msg_Info[CAN_MSG_INDEX_TEST1].rx_boards);
+    CHECK_EQUAL(CAN_RX_PRIO_HIGH, CAN_Msg_Info[CAN_MSG_INDEX_MOTOR_DATA_V2].rx_prio);
+    CHECK_EQUAL(CAN_RX_PRIO_LOW, CAN_Msg_Info[CAN_MSG_INDEX_WATER_GOOD].rx_prio);
+}
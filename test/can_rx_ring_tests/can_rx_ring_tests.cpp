@@ -0,0 +1,106 @@
+extern "C" {
+#include "can_rx_ring.h"
+}
+
+#include <cstdint>
+
+#include "CppUTest/TestHarness.h"
+
+TEST_GROUP(CanRxRingTests) {
+    void setup() final
+    {
+        CAN_Rx_Ring_Init();
+    }
+
+    void push(uint32_t id)
+    {
+        CAN_Message_T *frame = CAN_Rx_Ring_Reserve();
+        frame->id            = id;
+        frame->dlc           = 8U;
+        CAN_Rx_Ring_Commit();
+    }
+
+    CAN_Rx_Ring_Stats_T stats()
+    {
+        CAN_Rx_Ring_Stats_T stats;
+        CAN_Rx_Ring_Get_Stats(&stats);
+        return stats;
+    }
+};
+
+TEST(CanRxRingTests, empty_ring_pops_nothing)
+{
+    CAN_Message_T frame;
+    CHECK_FALSE(CAN_Rx_Ring_Pop(&frame));
+    CHECK_FALSE(CAN_Rx_Ring_Notify_Needed());
+}
+
+TEST(CanRxRingTests, frames_come_out_in_the_order_they_went_in)
+{
+    // more than the ring length in total, to go round the indices
+    for (uint32_t id = 0U; id < (2U * CAN_RX_RING_LENGTH); id++)
+    {
+        push(id);
+        push(id + 100U);
+
+        CAN_Message_T frame;
+        CHECK_TRUE(CAN_Rx_Ring_Pop(&frame));
+        CHECK_EQUAL(id, frame.id);
+        CHECK_TRUE(CAN_Rx_Ring_Pop(&frame));
+        CHECK_EQUAL(id + 100U, frame.id);
+    }
+
+    CHECK_EQUAL(4U * CAN_RX_RING_LENGTH, stats().frames);
+    CHECK_EQUAL(2U, stats().high_water);
+}
+
+TEST(CanRxRingTests, frames_past_the_ring_length_are_counted_as_overflows)
+{
+    for (uint32_t id = 0U; id < (CAN_RX_RING_LENGTH + 3U); id++)
+    {
+        push(id);
+    }
+
+    CHECK_EQUAL(CAN_RX_RING_LENGTH, stats().frames);
+    CHECK_EQUAL(3U, stats().overflows);
+    CHECK_EQUAL(CAN_RX_RING_LENGTH, stats().high_water);
+
+    // the oldest frames are kept
+    CAN_Message_T frame;
+    CHECK_TRUE(CAN_Rx_Ring_Pop(&frame));
+    CHECK_EQUAL(0U, frame.id);
+
+    push(42U);
+    CHECK_EQUAL(3U, stats().overflows);
+}
+
+TEST(CanRxRingTests, only_one_notification_is_outstanding_until_acked)
+{
+    push(1U);
+    CHECK_TRUE(CAN_Rx_Ring_Notify_Needed());
+
+    push(2U);
+    CHECK_FALSE(CAN_Rx_Ring_Notify_Needed());
+
+    CAN_Rx_Ring_Notify_Ack();
+    CHECK_TRUE(CAN_Rx_Ring_Notify_Needed());
+    CHECK_EQUAL(2U, stats().notifies);
+}
+
+TEST(CanRxRingTests, failed_notification_is_retried_with_the_next_frame)
+{
+    push(1U);
+    CHECK_TRUE(CAN_Rx_Ring_Notify_Needed());
+    CAN_Rx_Ring_Notify_Failed();
+    CHECK_EQUAL(0U, stats().notifies);
+
+    push(2U);
+    CHECK_TRUE(CAN_Rx_Ring_Notify_Needed());
+}
+
+TEST(CanRxRingTests, fifo_lost_is_counted)
+{
+    CAN_Rx_Ring_Fifo_Lost();
+    CAN_Rx_Ring_Fifo_Lost();
+    CHECK_EQUAL(2U, stats().fifo_lost);
+}
@@ -0,0 +1,135 @@
+extern "C" {
+#include "can_stats.h"
+}
+
+#include <cstdint>
+
+#include "CppUTest/TestHarness.h"
+
+static const CAN_Bit_Rates_T s_rates = {
+    .nominal_bps = 1000000U,
+    .data_bps    = 1000000U,
+    .brs         = false,
+};
+
+TEST_GROUP(CanStatsTests) {
+    void setup() final
+    {
+        CAN_Stats_Init();
+    }
+
+    CAN_Id_Stats_T id_stats(uint32_t id)
+    {
+        CAN_Id_Stats_T stats;
+        CAN_Stats_Get_Id(id, &stats);
+        return stats;
+    }
+
+    CAN_Error_Stats_T error_stats()
+    {
+        CAN_Error_Stats_T stats;
+        CAN_Stats_Get_Errors(&stats);
+        return stats;
+    }
+};
+
+TEST(CanStatsTests, frames_are_counted_per_id)
+{
+    CAN_Stats_Tx(CAN_MSG_MOTOR_DATA_V2_ID);
+    CAN_Stats_Tx(CAN_MSG_MOTOR_DATA_V2_ID);
+    CAN_Stats_Rx(CAN_MSG_TDS_ID);
+
+    // outside the registry, ignored
+    CAN_Stats_Tx(CAN_MSG_ID_SPAN);
+    CAN_Stats_Rx(0x7FFU);
+
+    CHECK_EQUAL(2U, id_stats(CAN_MSG_MOTOR_DATA_V2_ID).tx_frames);
+    CHECK_EQUAL(0U, id_stats(CAN_MSG_MOTOR_DATA_V2_ID).rx_frames);
+    CHECK_EQUAL(1U, id_stats(CAN_MSG_TDS_ID).rx_frames);
+    CHECK_EQUAL(0U, id_stats(CAN_MSG_ID_SPAN).tx_frames);
+}
+
+TEST(CanStatsTests, tx_latency_adds_the_frame_time_to_the_queued_time)
+{
+    // 8 bytes at 1 Mbit/s without BRS: 126 us on the wire
+    CAN_Tx_Event_T event = {.id = CAN_MSG_TEST1_ID, .dlc = 8U, .queued_us = 74U};
+    CAN_Stats_Tx_Event(&event, &s_rates);
+
+    CAN_Id_Stats_T stats = id_stats(CAN_MSG_TEST1_ID);
+    CHECK_EQUAL(1U, stats.tx_events);
+    CHECK_EQUAL(1U, stats.tx_latency_us.count);
+    CHECK_EQUAL(200U, stats.tx_latency_us.min);
+    CHECK_EQUAL(200U, stats.tx_latency_us.max);
+}
+
+TEST(CanStatsTests, tx_event_without_a_matching_write_is_counted_but_has_no_latency)
+{
+    CAN_Tx_Event_T event = {.id = CAN_MSG_TEST1_ID, .dlc = 8U, .queued_us = CAN_TX_QUEUED_UNKNOWN};
+    CAN_Stats_Tx_Event(&event, &s_rates);
+
+    CHECK_EQUAL(1U, id_stats(CAN_MSG_TEST1_ID).tx_events);
+    CHECK_EQUAL(0U, id_stats(CAN_MSG_TEST1_ID).tx_latency_us.count);
+    CHECK_EQUAL(1U, error_stats().tx_events_unmatched);
+}
+
+TEST(CanStatsTests, rx_age_on_a_synchronised_clock_is_taken_as_it_is)
+{
+    CAN_Stats_Rx_Age(CAN_MSG_MOTOR_DATA_ID, 1000000U, 1000250U);
+    CAN_Stats_Rx_Age(CAN_MSG_MOTOR_DATA_ID, 2000003U, 2000000U); // sync error, not negative
+
+    Histogram_T age = id_stats(CAN_MSG_MOTOR_DATA_ID).rx_age_us;
+    CHECK_EQUAL(2U, age.count);
+    CHECK_EQUAL(0U, age.min);
+    CHECK_EQUAL(250U, age.max);
+}
+
+TEST(CanStatsTests, rx_age_is_measured_from_the_quickest_frame)
+{
+    // sender's clock is 5000 ms behind ours
+    CAN_Stats_Rx_Tick(CAN_MSG_MOTOR_DATA_ID, 1000U, 6003U);
+    CAN_Stats_Rx_Tick(CAN_MSG_MOTOR_DATA_ID, 1100U, 6101U); // quicker, becomes the reference
+    CAN_Stats_Rx_Tick(CAN_MSG_MOTOR_DATA_ID, 1200U, 6204U);
+
+    Histogram_T age = id_stats(CAN_MSG_MOTOR_DATA_ID).rx_age_us;
+    CHECK_EQUAL(3U, age.count);
+    CHECK_EQUAL(0U, age.min);
+    CHECK_EQUAL(3000U, age.max);
+}
+
+TEST(CanStatsTests, rx_age_resyncs_when_the_sender_restarts)
+{
+    CAN_Stats_Rx_Tick(CAN_MSG_MOTOR_DATA_ID, 50000U, 60000U);
+
+    // sender rebooted, its tick started again from 0
+    CAN_Stats_Rx_Tick(CAN_MSG_MOTOR_DATA_ID, 100U, 70100U);
+    CAN_Stats_Rx_Tick(CAN_MSG_MOTOR_DATA_ID, 200U, 70202U);
+
+    Histogram_T age = id_stats(CAN_MSG_MOTOR_DATA_ID).rx_age_us;
+    CHECK_EQUAL(3U, age.count);
+    CHECK_EQUAL(2000U, age.max);
+}
+
+TEST(CanStatsTests, error_codes_and_error_log_accumulate)
+{
+    CAN_Bus_Status_T bus = {
+        .state           = CAN_BUS_STATE_ACTIVE,
+        .tx_errors       = 8U,
+        .rx_errors       = 1U,
+        .errors_logged   = 3U,
+        .last_error      = CAN_ERROR_ACK,
+        .data_last_error = CAN_ERROR_NO_CHANGE,
+    };
+    CAN_Stats_Bus_Status(&bus);
+
+    bus.errors_logged   = 2U;
+    bus.last_error      = CAN_ERROR_ACK;
+    bus.data_last_error = CAN_ERROR_BIT0;
+    CAN_Stats_Bus_Status(&bus);
+
+    CAN_Error_Stats_T stats = error_stats();
+    CHECK_EQUAL(8U, stats.bus.tx_errors);
+    CHECK_EQUAL(5U, stats.errors_logged);
+    CHECK_EQUAL(2U, stats.last_errors[CAN_ERROR_ACK]);
+    CHECK_EQUAL(1U, stats.data_last_errors[CAN_ERROR_NO_CHANGE]);
+    CHECK_EQUAL(1U, stats.data_last_errors[CAN_ERROR_BIT0]);
+}
@@ -0,0 +1,274 @@
+extern "C" {
+#include "can_bit_timing.h"
+#include "can_bus_load.h"
+#include "can_transport.h"
+#include "stm32g4xx.h"
+}
+
+#include <cstdint>
+#include <cstring>
+
+#include "CppUTest/TestHarness.h"
+
+// both boards, see MX_FDCAN2_Init() and can_bit_timing.h
+static const CAN_Bit_Rates_T s_rates = {
+    .nominal_bps = 2250000U,
+    .data_bps    = CAN_DATA_BITRATE_BPS,
+    .brs         = true,
+};
+
+static CAN_Transport_T s_sender;
+static CAN_Transport_T s_receiver;
+
+TEST_GROUP(CanTransportTests) {
+    uint8_t message[CAN_TRANSPORT_MAX_MESSAGE];
+    uint8_t received[CAN_TRANSPORT_MAX_MESSAGE];
+
+    void setup() final
+    {
+        CAN_Transport_Init(&s_sender);
+        CAN_Transport_Init(&s_receiver);
+
+        for (uint32_t i = 0U; i < sizeof(message); i++)
+        {
+            message[i] = (uint8_t) (i * 7U);
+        }
+    }
+
+    // hand the receiver's acknowledgement, if one is due, to the sender
+    bool deliver_ack(uint32_t now_ms)
+    {
+        CAN_Transport_Ack_T ack;
+        if (!CAN_Transport_Next_Ack(&s_receiver, &ack))
+        {
+            return false;
+        }
+
+        CAN_Transport_Rx_Ack(&s_sender, &ack, now_ms);
+        return true;
+    }
+
+    // One message after the other through a simulated bus, the sender's segments and the
+    // receiver's acknowledgements taking turns as their IDs would arbitrate, each taking the time
+    // of its frame. The receiver reads a message as soon as it completes. Every lose_every'th
+    // segment is lost (0 for none). Returns bytes per second.
+    uint32_t run_bus(uint16_t length, uint32_t messages, uint32_t lose_every)
+    {
+        uint64_t now_ns     = 0U;
+        uint32_t segments   = 0U;
+        uint32_t sent       = 0U;
+        uint32_t delivered  = 0U;
+        uint32_t frame64_ns = CAN_Frame_Time_Ns(FDCAN_DLC_BYTES_64, &s_rates);
+        uint32_t frame2_ns  = CAN_Frame_Time_Ns(FDCAN_DLC_BYTES_2, &s_rates);
+
+        while ((delivered < messages) && (now_ns < 60000000000ULL))
+        {
+            uint32_t now_ms = (uint32_t) (now_ns / 1000000U);
+            CAN_Transport_Segment_T segment;
+
+            if ((sent < messages) && CAN_Transport_Send(&s_sender, message, length))
+            {
+                sent++;
+            }
+
+            // an acknowledgement frame has the lower ID, so it wins arbitration
+            if (deliver_ack(now_ms))
+            {
+                now_ns += frame2_ns;
+            }
+            else if (CAN_Transport_Next_Segment(&s_sender, now_ms, &segment))
+            {
+                now_ns += frame64_ns;
+                segments++;
+                if ((lose_every != 0U) && ((segments % lose_every) == 0U))
+                {
+                    continue;
+                }
+
+                if (CAN_Transport_Rx_Segment(&s_receiver, &segment))
+                {
+                    CHECK_EQUAL(length, CAN_Transport_Receive(&s_receiver, received, length));
+                    MEMCMP_EQUAL(message, received, length);
+                    delivered++;
+                }
+            }
+            else
+            {
+                // bus idle until a retry is due
+                now_ns += 1000000U;
+            }
+        }
+
+        CHECK_EQUAL(messages, delivered);
+        return (uint32_t) (((uint64_t) length * delivered * 1000000000ULL) / now_ns);
+    }
+};
+
+TEST(CanTransportTests, short_message_is_one_first_last_segment)
+{
+    CAN_Transport_Segment_T segment;
+
+    CHECK_TRUE(CAN_Transport_Send(&s_sender, message, 10U));
+    CHECK_TRUE(CAN_Transport_Next_Segment(&s_sender, 0U, &segment));
+    CHECK_EQUAL(
+        CAN_TRANSPORT_FIRST_BIT | CAN_TRANSPORT_LAST_BIT | CAN_TRANSPORT_SYNC_BIT, segment.flags);
+    CHECK_EQUAL(10U, segment.length);
+    CHECK_EQUAL(0U, segment.data[10]);
+    CHECK_FALSE(CAN_Transport_Next_Segment(&s_sender, 0U, &segment));
+
+    CHECK_TRUE(CAN_Transport_Rx_Segment(&s_receiver, &segment));
+    CHECK_EQUAL(10U, CAN_Transport_Receive(&s_receiver, received, sizeof(received)));
+    MEMCMP_EQUAL(message, received, 10U);
+    CHECK_EQUAL(0U, CAN_Transport_Receive(&s_receiver, received, sizeof(received)));
+
+    CHECK_TRUE(deliver_ack(0U));
+    CHECK_EQUAL(1U, s_sender.stats.messages_sent);
+
+    // the peer has acknowledged us, later messages don't resynchronise
+    CHECK_TRUE(CAN_Transport_Send(&s_sender, message, 1U));
+    CHECK_TRUE(CAN_Transport_Next_Segment(&s_sender, 0U, &segment));
+    CHECK_EQUAL(1U, segment.sequence);
+    CHECK_EQUAL(CAN_TRANSPORT_FIRST_BIT | CAN_TRANSPORT_LAST_BIT, segment.flags);
+}
+
+TEST(CanTransportTests, send_refuses_what_doesnt_fit)
+{
+    CHECK_FALSE(CAN_Transport_Send(&s_sender, message, 0U));
+    CHECK_FALSE(CAN_Transport_Send(&s_sender, message, CAN_TRANSPORT_MAX_MESSAGE + 1U));
+    CHECK_TRUE(CAN_Transport_Send(&s_sender, message, CAN_TRANSPORT_MAX_MESSAGE));
+    CHECK_FALSE(CAN_Transport_Send(
+        &s_sender, message, CAN_TRANSPORT_TX_BUFFER - CAN_TRANSPORT_MAX_MESSAGE - 3U));
+    CHECK_EQUAL(3U, s_sender.stats.messages_refused);
+}
+
+TEST(CanTransportTests, sender_stops_at_the_window_until_acknowledged)
+{
+    CAN_Transport_Segment_T segment;
+    uint16_t length = (CAN_TRANSPORT_WINDOW + 1U) * CAN_TRANSPORT_SEGMENT_BYTES;
+
+    CHECK_TRUE(CAN_Transport_Send(&s_sender, message, length));
+    for (uint32_t i = 0U; i < CAN_TRANSPORT_WINDOW; i++)
+    {
+        CHECK_TRUE(CAN_Transport_Next_Segment(&s_sender, 0U, &segment));
+        CHECK_EQUAL(i, segment.sequence);
+        CHECK_FALSE(CAN_Transport_Rx_Segment(&s_receiver, &segment));
+    }
+    CHECK_FALSE(CAN_Transport_Next_Segment(&s_sender, 0U, &segment));
+
+    CHECK_TRUE(deliver_ack(1U));
+    CHECK_TRUE(CAN_Transport_Next_Segment(&s_sender, 1U, &segment));
+    CHECK_EQUAL(CAN_TRANSPORT_WINDOW, segment.sequence);
+    CHECK_EQUAL(CAN_TRANSPORT_LAST_BIT, segment.flags);
+
+    CHECK_TRUE(CAN_Transport_Rx_Segment(&s_receiver, &segment));
+    CHECK_EQUAL(length, CAN_Transport_Receive(&s_receiver, received, sizeof(received)));
+    MEMCMP_EQUAL(message, received, length);
+}
+
+TEST(CanTransportTests, unread_message_closes_the_window)
+{
+    CAN_Transport_Segment_T segment;
+
+    CHECK_TRUE(CAN_Transport_Send(&s_sender, message, 5U));
+    CHECK_TRUE(CAN_Transport_Send(&s_sender, message, 6U));
+    CHECK_TRUE(CAN_Transport_Next_Segment(&s_sender, 0U, &segment));
+    CHECK_TRUE(CAN_Transport_Rx_Segment(&s_receiver, &segment));
+    CHECK_TRUE(deliver_ack(0U));
+    CHECK_EQUAL(1U, s_sender.stats.messages_sent);
+
+    CHECK_FALSE(CAN_Transport_Next_Segment(&s_sender, 1U, &segment));
+
+    // reading it opens the window again
+    CHECK_EQUAL(5U, CAN_Transport_Receive(&s_receiver, received, sizeof(received)));
+    CHECK_TRUE(deliver_ack(2U));
+    CHECK_TRUE(CAN_Transport_Next_Segment(&s_sender, 2U, &segment));
+    CHECK_EQUAL(6U, segment.length);
+}
+
+TEST(CanTransportTests, lost_segment_is_sent_again_after_the_timeout)
+{
+    CAN_Transport_Segment_T segment;
+
+    CHECK_TRUE(CAN_Transport_Send(&s_sender, message, 3U * CAN_TRANSPORT_SEGMENT_BYTES));
+    CHECK_TRUE(CAN_Transport_Next_Segment(&s_sender, 0U, &segment)); // lost
+    CHECK_TRUE(CAN_Transport_Next_Segment(&s_sender, 0U, &segment));
+    CHECK_FALSE(CAN_Transport_Rx_Segment(&s_receiver, &segment));
+    CHECK_TRUE(CAN_Transport_Next_Segment(&s_sender, 0U, &segment));
+    CHECK_FALSE(CAN_Transport_Rx_Segment(&s_receiver, &segment));
+    CHECK_EQUAL(2U, s_receiver.stats.segments_ignored);
+
+    CHECK_FALSE(CAN_Transport_Next_Segment(&s_sender, CAN_TRANSPORT_RETRY_MS - 1U, &segment));
+    CHECK_TRUE(CAN_Transport_Next_Segment(&s_sender, CAN_TRANSPORT_RETRY_MS, &segment));
+    CHECK_EQUAL(0U, segment.sequence);
+    CHECK_EQUAL(1U, s_sender.stats.retransmits);
+
+    CHECK_FALSE(CAN_Transport_Rx_Segment(&s_receiver, &segment));
+    for (uint32_t i = 1U; i < 3U; i++)
+    {
+        CHECK_TRUE(CAN_Transport_Next_Segment(&s_sender, CAN_TRANSPORT_RETRY_MS, &segment));
+        CHECK_EQUAL(i == 2U, CAN_Transport_Rx_Segment(&s_receiver, &segment));
+    }
+    CHECK_TRUE(deliver_ack(CAN_TRANSPORT_RETRY_MS));
+    CHECK_EQUAL(1U, s_sender.stats.messages_sent);
+}
+
+TEST(CanTransportTests, message_is_dropped_after_the_retries_and_the_next_resynchronises)
+{
+    CAN_Transport_Segment_T segment;
+    uint32_t now_ms = 0U;
+
+    CHECK_TRUE(CAN_Transport_Send(&s_sender, message, 10U));
+    CHECK_TRUE(CAN_Transport_Send(&s_sender, message, 20U));
+    CHECK_TRUE(CAN_Transport_Next_Segment(&s_sender, now_ms, &segment));
+    CHECK_TRUE(CAN_Transport_Rx_Segment(&s_receiver, &segment));
+    CHECK_EQUAL(10U, CAN_Transport_Receive(&s_receiver, received, sizeof(received)));
+    CHECK_TRUE(deliver_ack(now_ms));
+
+    // the second message gets no answer, the receiver went away
+    CHECK_TRUE(CAN_Transport_Next_Segment(&s_sender, now_ms, &segment));
+    for (uint32_t i = 0U; i < CAN_TRANSPORT_MAX_RETRIES; i++)
+    {
+        now_ms += CAN_TRANSPORT_RETRY_MS;
+        CHECK_TRUE(CAN_Transport_Next_Segment(&s_sender, now_ms, &segment));
+    }
+    now_ms += CAN_TRANSPORT_RETRY_MS;
+    CHECK_FALSE(CAN_Transport_Next_Segment(&s_sender, now_ms, &segment));
+    CHECK_EQUAL(1U, s_sender.stats.messages_dropped);
+
+    // back after a restart
+    CAN_Transport_Init(&s_receiver);
+    s_receiver.rx_synced   = true;
+    s_receiver.rx_next_seq = 100U;
+
+    CHECK_TRUE(CAN_Transport_Send(&s_sender, message, 30U));
+    CHECK_TRUE(CAN_Transport_Next_Segment(&s_sender, now_ms, &segment));
+    CHECK_TRUE((segment.flags & CAN_TRANSPORT_SYNC_BIT) != 0U);
+    CHECK_TRUE(CAN_Transport_Rx_Segment(&s_receiver, &segment));
+    CHECK_EQUAL(30U, CAN_Transport_Receive(&s_receiver, received, sizeof(received)));
+}
+
+TEST(CanTransportTests, throughput_on_a_simulated_bus)
+{
+    // the largest pc_com packet, a CanStatsResp
+    uint32_t bytes_per_s = run_bus(2781U, 20U, 0U);
+
+    UT_PRINT(StringFromFormat("tunnel throughput: %u B/s", bytes_per_s).asCharString());
+
+    // 60 of every 64 byte frame, plus an acknowledgement every half window: about 400 kB/s at
+    // 2.25 / 4.5 Mbit
+    CHECK_TRUE(bytes_per_s > 350000U);
+    CHECK_EQUAL(0U, s_sender.stats.retransmits);
+}
+
+TEST(CanTransportTests, throughput_on_a_simulated_bus_losing_segments)
+{
+    uint32_t bytes_per_s = run_bus(2781U, 20U, 50U);
+
+    UT_PRINT(StringFromFormat("tunnel throughput, 2%% of segments lost: %u B/s", bytes_per_s)
+                 .asCharString());
+
+    // each loss waits out a retry timeout
+    CHECK_TRUE(s_sender.stats.retransmits > 0U);
+    CHECK_EQUAL(0U, s_sender.stats.messages_dropped);
+    CHECK_TRUE(bytes_per_s > 20000U);
+}
@@ -0,0 +1,89 @@
+extern "C" {
+#include "can_messages.h"
+#include "can_tx_queue.h"
+}
+
+#include <cstdint>
+
+#include "CppUTest/TestHarness.h"
+
+TEST_GROUP(CanTxQueueTests) {
+    void setup() final
+    {
+        CAN_Tx_Queue_Init();
+    }
+
+    void put(uint32_t id, uint8_t value)
+    {
+        CAN_Message_T frame = {};
+        frame.id            = id;
+        frame.dlc           = FDCAN_DLC_BYTES_8;
+        frame.data[0]       = value;
+        CAN_Tx_Queue_Put(&frame);
+    }
+
+    CAN_Tx_Queue_Stats_T stats()
+    {
+        CAN_Tx_Queue_Stats_T stats;
+        CAN_Tx_Queue_Get_Stats(&stats);
+        return stats;
+    }
+};
+
+TEST(CanTxQueueTests, empty_queue_has_no_front)
+{
+    POINTERS_EQUAL(nullptr, CAN_Tx_Queue_Front());
+    CHECK_EQUAL(0U, CAN_Tx_Queue_Count());
+}
+
+TEST(CanTxQueueTests, lowest_id_goes_first_like_on_the_bus)
+{
+    put(CAN_MSG_WATER_GOOD_ID, 1U);
+    put(CAN_MSG_MOTOR_DATA_V2_ID, 2U);
+    put(CAN_MSG_MOTOR_DATA_ID, 3U);
+
+    CHECK_EQUAL(3U, CAN_Tx_Queue_Count());
+    CHECK_EQUAL(CAN_MSG_MOTOR_DATA_ID, CAN_Tx_Queue_Front()->id);
+    CAN_Tx_Queue_Pop();
+    CHECK_EQUAL(CAN_MSG_WATER_GOOD_ID, CAN_Tx_Queue_Front()->id);
+    CAN_Tx_Queue_Pop();
+    CHECK_EQUAL(CAN_MSG_MOTOR_DATA_V2_ID, CAN_Tx_Queue_Front()->id);
+    CAN_Tx_Queue_Pop();
+    POINTERS_EQUAL(nullptr, CAN_Tx_Queue_Front());
+
+    CHECK_EQUAL(3U, stats().sent);
+    CHECK_EQUAL(3U, stats().high_water);
+}
+
+TEST(CanTxQueueTests, newer_frame_replaces_the_pending_one_with_the_same_id)
+{
+    put(CAN_MSG_MOTOR_DATA_V2_ID, 1U);
+    put(CAN_MSG_MOTOR_DATA_V2_ID, 2U);
+
+    CHECK_EQUAL(1U, CAN_Tx_Queue_Count());
+    CHECK_EQUAL(2U, CAN_Tx_Queue_Front()->data[0]);
+    CHECK_EQUAL(2U, stats().queued);
+    CHECK_EQUAL(1U, stats().replaced);
+}
+
+TEST(CanTxQueueTests, deferred_frame_stays_at_the_front)
+{
+    put(CAN_MSG_MOTOR_DATA_V2_ID, 1U);
+    CAN_Tx_Queue_Deferred();
+
+    CHECK_EQUAL(CAN_MSG_MOTOR_DATA_V2_ID, CAN_Tx_Queue_Front()->id);
+    CHECK_EQUAL(1U, stats().deferred);
+    CHECK_EQUAL(0U, stats().sent);
+}
+
+TEST(CanTxQueueTests, pending_is_per_id_until_popped)
+{
+    put(CAN_MSG_TUNNEL_MOTOR_ID, 1U);
+
+    CHECK_TRUE(CAN_Tx_Queue_Is_Pending(CAN_MSG_TUNNEL_MOTOR_ID));
+    CHECK_FALSE(CAN_Tx_Queue_Is_Pending(CAN_MSG_TUNNEL_GAUGE_ACK_ID));
+    CHECK_FALSE(CAN_Tx_Queue_Is_Pending(CAN_MSG_ID_SPAN));
+
+    CAN_Tx_Queue_Pop();
+    CHECK_FALSE(CAN_Tx_Queue_Is_Pending(CAN_MSG_TUNNEL_MOTOR_ID));
+}
@@ -0,0 +1,154 @@
+extern "C" {
+#include "bsp.h"
+#include "bsp_timestamp_fake.h"
+#include "cpu_load.h"
+}
+
+#include "CppUTest/TestHarness.h"
+
+// The fake cycle counter counts one cycle per microsecond. Each tick below is 1000 cycles, so one
+// busy cycle in each tick is 1 per mille of load.
+static constexpr uint32_t TICK_CYCLES = 1000U;
+
+// an idle loop that sleeps: the AOs run for busy cycles, longer than an idle loop gap, then the
+// core sleeps until the next tick
+static void run_sleeping_window(uint32_t busy)
+{
+    for (uint32_t i = 0U; i < CPU_LOAD_WINDOW_TICKS; i++)
+    {
+        BSP_TimestampFake_Advance_Microseconds(busy);
+        uint32_t start = BSP_Get_Cycle_Count();
+        BSP_TimestampFake_Advance_Microseconds(TICK_CYCLES - busy);
+        CPU_Load_Idle(start, BSP_Get_Cycle_Count());
+        CPU_Load_Tick();
+    }
+}
+
+static void run_sleeping_windows(uint32_t busy, uint32_t windows)
+{
+    for (uint32_t i = 0U; i < windows; i++)
+    {
+        run_sleeping_window(busy);
+    }
+}
+
+// one pass of an idle loop that spins, gap cycles after the last one
+static void spin(uint32_t gap)
+{
+    BSP_TimestampFake_Advance_Microseconds(gap);
+    uint32_t now = BSP_Get_Cycle_Count();
+    CPU_Load_Idle(now, now);
+}
+
+static CPU_Load_T get_load(void)
+{
+    CPU_Load_T load;
+    CPU_Load_Get(&load);
+    return load;
+}
+
+TEST_GROUP(CpuLoadTests) {
+    void setup() final
+    {
+        BSP_TimestampFake_Reset();
+        CPU_Load_Start();
+    }
+};
+
+TEST(CpuLoadTests, nothing_is_reported_before_the_first_window)
+{
+    CPU_Load_Tick();
+
+    CPU_Load_T load = get_load();
+    CHECK_EQUAL(0U, load.windows);
+    CHECK_EQUAL(0U, load.load_100ms);
+    CHECK_EQUAL(0U, load.load_1s);
+    CHECK_EQUAL(0U, load.load_10s);
+}
+
+TEST(CpuLoadTests, time_asleep_is_idle)
+{
+    run_sleeping_window(300U);
+
+    CPU_Load_T load = get_load();
+    CHECK_EQUAL(1U, load.windows);
+    CHECK_EQUAL(300U, load.load_100ms);
+    CHECK_EQUAL(300U, load.load_1s);
+    CHECK_EQUAL(300U, load.load_10s);
+}
+
+TEST(CpuLoadTests, short_gaps_between_spins_are_idle_and_long_ones_are_not)
+{
+    for (uint32_t i = 0U; i < CPU_LOAD_WINDOW_TICKS; i++)
+    {
+        for (uint32_t pass = 0U; pass < 100U; pass++)
+        {
+            spin(10U); // the idle loop going round
+        }
+        CPU_Load_Tick();
+    }
+    CHECK_EQUAL(0U, get_load().load_100ms);
+
+    CPU_Load_Start();
+    for (uint32_t i = 0U; i < CPU_LOAD_WINDOW_TICKS; i++)
+    {
+        spin(10U);
+        spin(10U);
+        spin(300U); // an AO ran in between
+        CPU_Load_Tick();
+    }
+    // 20 of every 320 cycles idle
+    CHECK_EQUAL(938U, get_load().load_100ms);
+}
+
+TEST(CpuLoadTests, a_window_with_no_idle_time_is_fully_loaded)
+{
+    for (uint32_t i = 0U; i < CPU_LOAD_WINDOW_TICKS; i++)
+    {
+        BSP_TimestampFake_Advance_Microseconds(TICK_CYCLES);
+        CPU_Load_Tick();
+    }
+
+    CHECK_EQUAL(1000U, get_load().load_100ms);
+}
+
+TEST(CpuLoadTests, longer_loads_average_the_last_windows)
+{
+    run_sleeping_windows(300U, CPU_LOAD_10S_WINDOWS - CPU_LOAD_1S_WINDOWS);
+    run_sleeping_windows(700U, CPU_LOAD_1S_WINDOWS);
+
+    CPU_Load_T load = get_load();
+    CHECK_EQUAL(CPU_LOAD_10S_WINDOWS, load.windows);
+    CHECK_EQUAL(700U, load.load_100ms);
+    CHECK_EQUAL(700U, load.load_1s);
+    CHECK_EQUAL(340U, load.load_10s);
+
+    // the oldest windows drop out
+    run_sleeping_windows(700U, CPU_LOAD_10S_WINDOWS - CPU_LOAD_1S_WINDOWS);
+    CHECK_EQUAL(700U, get_load().load_10s);
+}
+
+TEST(CpuLoadTests, fewer_windows_than_a_second_are_averaged_over_what_there_is)
+{
+    run_sleeping_window(300U);
+    run_sleeping_window(500U);
+
+    CPU_Load_T load = get_load();
+    CHECK_EQUAL(2U, load.windows);
+    CHECK_EQUAL(400U, load.load_1s);
+    CHECK_EQUAL(400U, load.load_10s);
+}
+
+TEST(CpuLoadTests, peak_is_the_busiest_window_until_reset)
+{
+    run_sleeping_window(300U);
+    run_sleeping_window(900U);
+    run_sleeping_window(400U);
+    CHECK_EQUAL(900U, get_load().peak_100ms);
+
+    CPU_Load_Reset_Peak();
+    CHECK_EQUAL(0U, get_load().peak_100ms);
+
+    run_sleeping_window(500U);
+    CHECK_EQUAL(500U, get_load().peak_100ms);
+}
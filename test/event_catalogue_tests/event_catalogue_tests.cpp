@@ -0,0 +1,61 @@
+extern "C" {
+#include "event_catalogue.h"
+}
+
+#include "CppUTest/TestHarness.h"
+
+// one event at each edge of the tiers, and one in the middle of the medium one
+typedef struct
+{
+    uint8_t bytes[EVENT_CATALOGUE_SMALL_MAX_SIZE];
+} Small_Edge_Event_T;
+
+typedef struct
+{
+    uint8_t bytes[EVENT_CATALOGUE_SMALL_MAX_SIZE + 1U];
+} Medium_Edge_Event_T;
+
+typedef struct
+{
+    uint8_t bytes[40];
+} Medium_Event_T;
+
+typedef struct
+{
+    uint8_t bytes[EVENT_CATALOGUE_MEDIUM_MAX_SIZE + 1U];
+} Large_Event_T;
+
+#define TEST_POOL_EVENTS(X)    \
+    X(Small_Edge_Event_T, 3U)  \
+    X(Medium_Edge_Event_T, 2U) \
+    X(Medium_Event_T, 5U)      \
+    X(Large_Event_T, 1U)
+
+#define TEST_SMALL_ONLY_EVENTS(X) X(Small_Edge_Event_T, 4U)
+
+typedef EVENT_CATALOGUE_TIER(TEST_POOL_EVENTS, SMALL) Small_Pool_Event_T;
+typedef EVENT_CATALOGUE_TIER(TEST_POOL_EVENTS, MEDIUM) Medium_Pool_Event_T;
+typedef EVENT_CATALOGUE_TIER(TEST_POOL_EVENTS, LARGE) Large_Pool_Event_T;
+
+TEST_GROUP(EventCatalogueTests){};
+
+TEST(EventCatalogueTests, each_tier_is_as_big_as_its_largest_event)
+{
+    CHECK_EQUAL(sizeof(Small_Edge_Event_T), sizeof(Small_Pool_Event_T));
+    CHECK_EQUAL(sizeof(Medium_Event_T), sizeof(Medium_Pool_Event_T));
+    CHECK_EQUAL(sizeof(Large_Event_T), sizeof(Large_Pool_Event_T));
+}
+
+TEST(EventCatalogueTests, each_tier_counts_only_its_own_events)
+{
+    CHECK_EQUAL(3U, EVENT_CATALOGUE_TIER_COUNT(TEST_POOL_EVENTS, SMALL));
+    CHECK_EQUAL(7U, EVENT_CATALOGUE_TIER_COUNT(TEST_POOL_EVENTS, MEDIUM));
+    CHECK_EQUAL(1U, EVENT_CATALOGUE_TIER_COUNT(TEST_POOL_EVENTS, LARGE));
+}
+
+TEST(EventCatalogueTests, an_empty_tier_counts_no_events)
+{
+    CHECK_EQUAL(4U, EVENT_CATALOGUE_TIER_COUNT(TEST_SMALL_ONLY_EVENTS, SMALL));
+    CHECK_EQUAL(0U, EVENT_CATALOGUE_TIER_COUNT(TEST_SMALL_ONLY_EVENTS, MEDIUM));
+    CHECK_EQUAL(0U, EVENT_CATALOGUE_TIER_COUNT(TEST_SMALL_ONLY_EVENTS, LARGE));
+}
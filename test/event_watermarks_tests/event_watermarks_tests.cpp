@@ -0,0 +1,247 @@
+extern "C" {
+#include "event_watermarks.h"
+#include "pubsub_signals.h"
+}
+
+#include "cms_cpputest_qf_ctrl.hpp"
+
+#include "CppUTest/TestHarness.h"
+
+#include <cstring>
+
+using namespace cms::test;
+
+// a pool of 4 small events and one of 8 large ones, and an AO with a queue of 4 that only takes
+// them in. The sizes are a multiple of QF's free block, so each pool holds as many events as it
+// is given room for.
+enum
+{
+    WORK_SIG = PUBSUB_MAX_SIG,
+};
+
+typedef struct
+{
+    QEvt super;
+    uint8_t payload[12];
+} Small_Event_T;
+
+typedef struct
+{
+    QEvt super;
+    uint8_t payload[44];
+} Large_Event_T;
+
+static QActive s_ao;
+static QEvt const *s_queue[4];
+
+static const char *const s_names[] = {nullptr, "test"};
+
+static char s_warnings[4][80];
+static size_t s_warning_count;
+
+static QState test_ao_active(QActive *const me, QEvt const *const e)
+{
+    (void) me;
+    return (e->sig == WORK_SIG) ? Q_HANDLED() : Q_SUPER(&QHsm_top);
+}
+
+static QState test_ao_initial(QActive *const me, void const *const par)
+{
+    (void) me;
+    (void) par;
+    return Q_TRAN(&test_ao_active);
+}
+
+static void record_warning(void *context, const char *warning)
+{
+    (void) context;
+    if (s_warning_count < Q_DIM(s_warnings))
+    {
+        strncpy(s_warnings[s_warning_count], warning, sizeof(s_warnings[0]) - 1U);
+    }
+    s_warning_count++;
+}
+
+static void update(uint32_t now_ms)
+{
+    s_warning_count = 0U;
+    memset(s_warnings, 0, sizeof(s_warnings));
+    Event_Watermarks_Update(now_ms, record_warning, nullptr);
+}
+
+// take count events of the large pool at once, then give them back
+static void hold_large_events(size_t count)
+{
+    QEvt *events[8];
+    for (size_t i = 0U; i < count; i++)
+    {
+        events[i] = &Q_NEW(Large_Event_T, WORK_SIG)->super;
+    }
+    for (size_t i = 0U; i < count; i++)
+    {
+        QF_gc(events[i]);
+    }
+}
+
+static Event_Pool_Stats_T get_pool(size_t index)
+{
+    Event_Pool_Stats_T stats;
+    CHECK_TRUE(Event_Watermarks_Get_Pool(index, &stats));
+    return stats;
+}
+
+TEST_GROUP(EventWatermarksTests) {
+    void setup() final
+    {
+        qf_ctrl::MemPoolConfigs configs = {
+            {sizeof(Small_Event_T), 4},
+            {sizeof(Large_Event_T), 8},
+        };
+        qf_ctrl::Setup(PUBSUB_MAX_SIG, 1000, configs);
+
+        QActive_ctor(&s_ao, Q_STATE_CAST(&test_ao_initial));
+        QACTIVE_START(
+            &s_ao, qf_ctrl::UNIT_UNDER_TEST_PRIORITY, s_queue, Q_DIM(s_queue), nullptr, 0U, nullptr);
+        qf_ctrl::ProcessEvents();
+
+        Event_Watermarks_Start(s_names, Q_DIM(s_names));
+    }
+
+    void teardown() final
+    {
+        qf_ctrl::Teardown();
+    }
+};
+
+TEST(EventWatermarksTests, pools_are_reported_smallest_events_first)
+{
+    Event_Pool_Stats_T small = get_pool(0U);
+    CHECK_EQUAL(sizeof(Small_Event_T), small.block_size);
+    CHECK_EQUAL(4U, small.blocks);
+    CHECK_EQUAL(4U, small.free);
+    CHECK_EQUAL(4U, small.min_free);
+    CHECK_EQUAL(0U, small.allocs);
+    CHECK_FALSE(small.low);
+
+    Event_Pool_Stats_T large = get_pool(1U);
+    CHECK_EQUAL(sizeof(Large_Event_T), large.block_size);
+    CHECK_EQUAL(8U, large.blocks);
+
+    Event_Pool_Stats_T none;
+    CHECK_FALSE(Event_Watermarks_Get_Pool(2U, &none));
+}
+
+TEST(EventWatermarksTests, allocations_are_counted_against_their_pool)
+{
+    QF_gc(Q_NEW(QEvt, WORK_SIG));
+    hold_large_events(3U);
+
+    CHECK_EQUAL(1U, get_pool(0U).allocs);
+    CHECK_EQUAL(3U, get_pool(1U).allocs);
+    CHECK_EQUAL(8U, get_pool(1U).free);
+    CHECK_EQUAL(5U, get_pool(1U).min_free);
+}
+
+TEST(EventWatermarksTests, an_event_is_counted_against_the_first_pool_it_fits_in)
+{
+    typedef struct
+    {
+        QEvt super;
+        uint8_t payload[20];
+    } Medium_Event_T;
+
+    QF_gc(&Q_NEW(Medium_Event_T, WORK_SIG)->super);
+
+    CHECK_EQUAL(0U, get_pool(0U).allocs);
+    CHECK_EQUAL(1U, get_pool(1U).allocs);
+}
+
+TEST(EventWatermarksTests, free_leaves_out_the_events_not_recycled_yet)
+{
+    QEvt *events[3];
+    for (size_t i = 0U; i < Q_DIM(events); i++)
+    {
+        events[i] = &Q_NEW(Large_Event_T, WORK_SIG)->super;
+    }
+    CHECK_EQUAL(5U, get_pool(1U).free);
+    CHECK_EQUAL(4U, get_pool(0U).free);
+
+    for (size_t i = 0U; i < Q_DIM(events); i++)
+    {
+        QF_gc(events[i]);
+    }
+    CHECK_EQUAL(8U, get_pool(1U).free);
+}
+
+TEST(EventWatermarksTests, allocation_rate_is_over_the_last_update_interval)
+{
+    update(1000U);
+    for (size_t i = 0U; i < 15U; i++)
+    {
+        hold_large_events(2U);
+    }
+    update(1500U);
+
+    CHECK_EQUAL(60U, get_pool(1U).allocs_per_s);
+    CHECK_EQUAL(60U, get_pool(1U).peak_allocs_per_s);
+    CHECK_EQUAL(0U, get_pool(0U).allocs_per_s);
+
+    hold_large_events(2U);
+    update(2500U);
+
+    CHECK_EQUAL(2U, get_pool(1U).allocs_per_s);
+    CHECK_EQUAL(60U, get_pool(1U).peak_allocs_per_s);
+}
+
+TEST(EventWatermarksTests, a_pool_is_warned_about_at_each_new_low_water_mark)
+{
+    hold_large_events(6U);
+    update(1000U);
+    CHECK_FALSE(get_pool(1U).low); // 2 of 8 free is 25 %
+    CHECK_EQUAL(0U, s_warning_count);
+
+    hold_large_events(7U);
+    update(2000U);
+    CHECK_TRUE(get_pool(1U).low);
+    CHECK_EQUAL(1U, s_warning_count);
+    CHECK_TRUE(strstr(s_warnings[0], "event pool 2") != nullptr);
+    CHECK_TRUE(strstr(s_warnings[0], "down to 1 free") != nullptr);
+
+    // no lower since
+    hold_large_events(7U);
+    update(3000U);
+    CHECK_EQUAL(0U, s_warning_count);
+
+    hold_large_events(8U);
+    update(4000U);
+    CHECK_EQUAL(1U, s_warning_count);
+    CHECK_TRUE(strstr(s_warnings[0], "down to 0 free") != nullptr);
+}
+
+TEST(EventWatermarksTests, queues_report_their_low_water_mark)
+{
+    static QEvt const work = QEVT_INITIALIZER(WORK_SIG);
+    Event_Queue_Stats_T stats;
+
+    CHECK_TRUE(Event_Watermarks_Get_Queue(0U, &stats));
+    STRCMP_EQUAL("test", stats.name);
+    CHECK_EQUAL(qf_ctrl::UNIT_UNDER_TEST_PRIORITY, stats.prio);
+    CHECK_EQUAL(5U, stats.length); // the 4 of the ring and the front event
+    CHECK_EQUAL(5U, stats.min_free);
+    CHECK_FALSE(Event_Watermarks_Get_Queue(1U, &stats));
+
+    for (size_t i = 0U; i < 4U; i++)
+    {
+        QACTIVE_POST(&s_ao, &work, nullptr);
+    }
+    qf_ctrl::ProcessEvents();
+    update(1000U);
+
+    Event_Watermarks_Get_Queue(0U, &stats);
+    CHECK_EQUAL(5U, stats.free);
+    CHECK_EQUAL(1U, stats.min_free);
+    CHECK_TRUE(stats.low);
+    CHECK_EQUAL(1U, s_warning_count);
+    CHECK_TRUE(strstr(s_warnings[0], "test queue") != nullptr);
+    CHECK_TRUE(strstr(s_warnings[0], "down to 1 free") != nullptr);
+}
@@ -0,0 +1,177 @@
+extern "C" {
+#include "filters.h"
+}
+
+#include <cstdint>
+
+#include "CppUTest/TestHarness.h"
+
+TEST_GROUP(FilterEmaF32Tests) {
+};
+
+TEST(FilterEmaF32Tests, ramps_from_zero_without_seeding)
+{
+    Filter_EMA_F32_T filter;
+    Filter_EMA_F32_Init(&filter, 0.1F, false);
+
+    DOUBLES_EQUAL(1.0, Filter_EMA_F32_Update(&filter, 10.0F), 0.0001);
+    DOUBLES_EQUAL(1.9, Filter_EMA_F32_Update(&filter, 10.0F), 0.0001);
+    DOUBLES_EQUAL(1.9, Filter_EMA_F32_Get(&filter), 0.0001);
+}
+
+TEST(FilterEmaF32Tests, first_sample_seeds_the_output)
+{
+    Filter_EMA_F32_T filter;
+    Filter_EMA_F32_Init(&filter, 0.05F, true);
+
+    DOUBLES_EQUAL(20.0, Filter_EMA_F32_Update(&filter, 20.0F), 0.0001);
+    DOUBLES_EQUAL(20.5, Filter_EMA_F32_Update(&filter, 30.0F), 0.0001);
+
+    Filter_EMA_F32_Reset(&filter);
+    DOUBLES_EQUAL(5.0, Filter_EMA_F32_Update(&filter, 5.0F), 0.0001);
+}
+
+TEST(FilterEmaF32Tests, changing_alpha_keeps_the_output)
+{
+    Filter_EMA_F32_T filter;
+    Filter_EMA_F32_Init(&filter, 0.1F, true);
+
+    Filter_EMA_F32_Update(&filter, 10.0F);
+    Filter_EMA_F32_Set_Alpha(&filter, 0.5F);
+
+    DOUBLES_EQUAL(10.0, Filter_EMA_F32_Get(&filter), 0.0001);
+    DOUBLES_EQUAL(15.0, Filter_EMA_F32_Update(&filter, 20.0F), 0.0001);
+}
+
+TEST(FilterEmaF32Tests, alpha_macro_matches_time_constant)
+{
+    // 1 s time constant at 100 Hz: dt / (tau + dt) = 0.01 / 1.01
+    DOUBLES_EQUAL(0.0099, FILTER_EMA_ALPHA(1.0F, 100U), 0.0001);
+}
+
+TEST_GROUP(FilterEmaQ15Tests) {
+};
+
+TEST(FilterEmaQ15Tests, converges_to_step_input_without_stalling)
+{
+    Filter_EMA_Q15_T filter;
+    Filter_EMA_Q15_Init(&filter, FILTER_FLOAT_TO_Q15(0.05F), false);
+
+    int16_t out = 0;
+    for (int i = 0; i < 400; i++)
+    {
+        out = Filter_EMA_Q15_Update(&filter, 1000);
+    }
+
+    CHECK_TRUE(out >= 999);
+    CHECK_TRUE(out <= 1000);
+}
+
+TEST(FilterEmaQ15Tests, handles_negative_samples_and_seeding)
+{
+    Filter_EMA_Q15_T filter;
+    Filter_EMA_Q15_Init(&filter, FILTER_FLOAT_TO_Q15(0.5F), true);
+
+    CHECK_EQUAL(-2000, Filter_EMA_Q15_Update(&filter, -2000));
+    int16_t out = Filter_EMA_Q15_Update(&filter, 0);
+    CHECK_TRUE(out >= -1001);
+    CHECK_TRUE(out <= -999);
+}
+
+TEST_GROUP(FilterBiquadTests) {
+};
+
+TEST(FilterBiquadTests, lowpass_has_unity_dc_gain)
+{
+    Filter_Biquad_Coeffs_T coeffs;
+    Filter_Biquad_Lowpass_Coeffs(&coeffs, 5.0F, 100.0F, 0.7071F);
+
+    Filter_Biquad_F32_T filter;
+    Filter_Biquad_F32_Init(&filter, &coeffs);
+
+    float out = 0.0F;
+    for (int i = 0; i < 500; i++)
+    {
+        out = Filter_Biquad_F32_Update(&filter, 3.0F);
+    }
+
+    DOUBLES_EQUAL(3.0, out, 0.001);
+}
+
+TEST(FilterBiquadTests, lowpass_attenuates_nyquist)
+{
+    Filter_Biquad_Coeffs_T coeffs;
+    Filter_Biquad_Lowpass_Coeffs(&coeffs, 5.0F, 100.0F, 0.7071F);
+
+    Filter_Biquad_F32_T filter;
+    Filter_Biquad_F32_Init(&filter, &coeffs);
+
+    float peak = 0.0F;
+    for (int i = 0; i < 500; i++)
+    {
+        float out = Filter_Biquad_F32_Update(&filter, (i % 2) ? 1.0F : -1.0F);
+        if ((i > 400) && (out > peak))
+        {
+            peak = out;
+        }
+    }
+
+    CHECK_TRUE(peak < 0.01F);
+}
+
+TEST(FilterBiquadTests, identity_coefficients_pass_through)
+{
+    const Filter_Biquad_Coeffs_T coeffs = {1.0F, 0.0F, 0.0F, 0.0F, 0.0F};
+
+    Filter_Biquad_F32_T filter;
+    Filter_Biquad_F32_Init(&filter, &coeffs);
+
+    DOUBLES_EQUAL(4.5, Filter_Biquad_F32_Update(&filter, 4.5F), 0.0001);
+    DOUBLES_EQUAL(-1.0, Filter_Biquad_F32_Update(&filter, -1.0F), 0.0001);
+}
+
+TEST_GROUP(FilterMedianTests) {
+};
+
+TEST(FilterMedianTests, rejects_single_sample_spike)
+{
+    Filter_Median_F32_T filter;
+    Filter_Median_F32_Init(&filter, 3U);
+
+    Filter_Median_F32_Update(&filter, 10.0F);
+    Filter_Median_F32_Update(&filter, 11.0F);
+    DOUBLES_EQUAL(11.0, Filter_Median_F32_Update(&filter, 500.0F), 0.0001);
+    DOUBLES_EQUAL(12.0, Filter_Median_F32_Update(&filter, 12.0F), 0.0001);
+}
+
+TEST(FilterMedianTests, partial_window_uses_samples_seen_so_far)
+{
+    Filter_Median_F32_T filter;
+    Filter_Median_F32_Init(&filter, 5U);
+
+    DOUBLES_EQUAL(4.0, Filter_Median_F32_Update(&filter, 4.0F), 0.0001);
+    DOUBLES_EQUAL(5.0, Filter_Median_F32_Update(&filter, 6.0F), 0.0001);
+}
+
+TEST(FilterMedianTests, window_length_is_clamped)
+{
+    Filter_Median_F32_T filter;
+    Filter_Median_F32_Init(&filter, 200U);
+
+    CHECK_EQUAL(FILTER_MEDIAN_MAX_N, filter.n);
+}
+
+TEST_GROUP(FilterRateLimitTests) {
+};
+
+TEST(FilterRateLimitTests, limits_rise_and_fall_separately)
+{
+    Filter_Rate_Limit_F32_T filter;
+    Filter_Rate_Limit_F32_Init(&filter, 1.0F, 2.0F);
+
+    DOUBLES_EQUAL(0.0, Filter_Rate_Limit_F32_Update(&filter, 0.0F), 0.0001);
+    DOUBLES_EQUAL(1.0, Filter_Rate_Limit_F32_Update(&filter, 10.0F), 0.0001);
+    DOUBLES_EQUAL(2.0, Filter_Rate_Limit_F32_Update(&filter, 10.0F), 0.0001);
+    DOUBLES_EQUAL(0.0, Filter_Rate_Limit_F32_Update(&filter, -10.0F), 0.0001);
+    DOUBLES_EQUAL(0.5, Filter_Rate_Limit_F32_Update(&filter, 0.5F), 0.0001);
+}
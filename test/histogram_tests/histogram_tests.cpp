@@ -0,0 +1,73 @@
+extern "C" {
+#include "histogram.h"
+}
+
+#include <cstdint>
+
+#include "CppUTest/TestHarness.h"
+
+TEST_GROUP(HistogramTests) {
+    Histogram_T histogram;
+
+    void setup() final
+    {
+        // bucket 0 below 16, bucket 1 below 32, bucket 2 below 64...
+        Histogram_Init(&histogram, 4U);
+    }
+};
+
+TEST(HistogramTests, empty_histogram_reports_zeros)
+{
+    CHECK_EQUAL(0U, histogram.count);
+    CHECK_EQUAL(0U, Histogram_Mean(&histogram));
+    CHECK_EQUAL(0U, Histogram_Percentile(&histogram, 50U));
+}
+
+TEST(HistogramTests, values_go_into_power_of_two_buckets)
+{
+    Histogram_Add(&histogram, 0U);
+    Histogram_Add(&histogram, 15U);
+    Histogram_Add(&histogram, 16U);
+    Histogram_Add(&histogram, 31U);
+    Histogram_Add(&histogram, 32U);
+    Histogram_Add(&histogram, 1000U);
+
+    CHECK_EQUAL(2U, histogram.buckets[0]);
+    CHECK_EQUAL(2U, histogram.buckets[1]);
+    CHECK_EQUAL(1U, histogram.buckets[2]);
+    CHECK_EQUAL(1U, histogram.buckets[6]); // 512 to 1024
+
+    CHECK_EQUAL(6U, histogram.count);
+    CHECK_EQUAL(0U, histogram.min);
+    CHECK_EQUAL(1000U, histogram.max);
+    CHECK_EQUAL(1094U / 6U, Histogram_Mean(&histogram));
+
+    CHECK_EQUAL(16U, Histogram_Bucket_Limit(&histogram, 0U));
+    CHECK_EQUAL(1024U, Histogram_Bucket_Limit(&histogram, 6U));
+}
+
+TEST(HistogramTests, large_values_all_land_in_the_last_bucket)
+{
+    Histogram_Add(&histogram, 1U << 20);
+    Histogram_Add(&histogram, UINT32_MAX);
+
+    CHECK_EQUAL(2U, histogram.buckets[HISTOGRAM_BUCKETS - 1U]);
+    CHECK_EQUAL(UINT32_MAX, Histogram_Bucket_Limit(&histogram, HISTOGRAM_BUCKETS - 1U));
+    CHECK_EQUAL(UINT32_MAX, Histogram_Percentile(&histogram, 100U));
+}
+
+TEST(HistogramTests, percentile_is_the_upper_limit_of_its_bucket_capped_at_the_max)
+{
+    // 98 fast values and 2 slow ones
+    for (uint32_t i = 0U; i < 98U; i++)
+    {
+        Histogram_Add(&histogram, 20U);
+    }
+    Histogram_Add(&histogram, 200U);
+    Histogram_Add(&histogram, 300U);
+
+    CHECK_EQUAL(32U, Histogram_Percentile(&histogram, 50U));
+    CHECK_EQUAL(32U, Histogram_Percentile(&histogram, 98U));
+    CHECK_EQUAL(256U, Histogram_Percentile(&histogram, 99U));
+    CHECK_EQUAL(300U, Histogram_Percentile(&histogram, 100U));
+}
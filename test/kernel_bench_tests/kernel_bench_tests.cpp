@@ -0,0 +1,110 @@
+extern "C" {
+#include "kernel_bench.h"
+}
+
+#include <cstdint>
+#include <cstring>
+
+#include "CppUTest/TestHarness.h"
+
+// Host stand-in for CYCCNT, moved only by the fake kernels below
+static uint32_t s_cycles;
+static uint32_t s_setups;
+
+extern "C" uint32_t BSP_Get_Cycle_Count(void)
+{
+    return s_cycles;
+}
+
+static void count_setup(void)
+{
+    s_setups++;
+}
+
+static size_t fifty_cycle_call(uint32_t i)
+{
+    (void) i;
+    s_cycles += 50U;
+    return 16U;
+}
+
+// the first call is hit by a 10000 cycle "interrupt"
+static size_t interrupted_call(uint32_t i)
+{
+    s_cycles += (i == 0U) ? 10050U : 50U;
+    return 0U;
+}
+
+static const Kernel_Bench_Result_T *find_common(const char *name, Kernel_Bench_Result_T *result)
+{
+    for (size_t i = 0U; i < Kernel_Bench_Common_Count; i++)
+    {
+        if (strcmp(Kernel_Bench_Common[i].name, name) == 0)
+        {
+            *result = Kernel_Bench_Measure(&Kernel_Bench_Common[i]);
+            return result;
+        }
+    }
+    return nullptr;
+}
+
+TEST_GROUP(KernelBenchTests) {
+    void setup() final
+    {
+        s_cycles = 1000U;
+        s_setups = 0U;
+    }
+};
+
+TEST(KernelBenchTests, reports_cycles_and_bytes_per_call)
+{
+    const Kernel_Bench_T kernel = {"fake", count_setup, fifty_cycle_call};
+
+    Kernel_Bench_Result_T result = Kernel_Bench_Measure(&kernel);
+
+    CHECK_EQUAL(50U, result.cycles_per_call);
+    CHECK_EQUAL(16U, result.bytes_per_call);
+    CHECK_EQUAL(1U, s_setups);
+}
+
+TEST(KernelBenchTests, keeps_the_fastest_run)
+{
+    const Kernel_Bench_T kernel = {"fake", nullptr, interrupted_call};
+
+    Kernel_Bench_Result_T result = Kernel_Bench_Measure(&kernel);
+
+    CHECK_EQUAL(50U, result.cycles_per_call);
+    CHECK_EQUAL(0U, result.bytes_per_call);
+}
+
+TEST(KernelBenchTests, cycle_counter_wrap_is_handled)
+{
+    const Kernel_Bench_T kernel = {"fake", nullptr, fifty_cycle_call};
+    s_cycles                    = UINT32_MAX - 1000U;
+
+    Kernel_Bench_Result_T result = Kernel_Bench_Measure(&kernel);
+
+    CHECK_EQUAL(50U, result.cycles_per_call);
+}
+
+TEST(KernelBenchTests, common_kernels_report_the_bytes_they_handle)
+{
+    Kernel_Bench_Result_T result;
+
+    CHECK_TRUE(find_common("crc16", &result) != nullptr);
+    CHECK_EQUAL(KERNEL_BENCH_PAYLOAD_SIZE, result.bytes_per_call);
+
+    CHECK_TRUE(find_common("hdlc-tx", &result) != nullptr);
+    CHECK_EQUAL(KERNEL_BENCH_PAYLOAD_SIZE, result.bytes_per_call);
+
+    // the frame: two flags, the payload and the escapes for its FLAG / DLE bytes
+    CHECK_TRUE(find_common("hdlc-rx", &result) != nullptr);
+    CHECK_TRUE(result.bytes_per_call > KERNEL_BENCH_PAYLOAD_SIZE + 2U);
+    CHECK_TRUE(result.bytes_per_call <= 2U * KERNEL_BENCH_PAYLOAD_SIZE + 2U);
+
+    CHECK_TRUE(find_common("pb-motor-data", &result) != nullptr);
+    CHECK_TRUE(result.bytes_per_call > 0U);
+
+    // the host cycle counter doesn't move
+    CHECK_EQUAL(0U, result.cycles_per_call);
+}
@@ -1,5 +1,6 @@
 extern "C" {
 #include "LMT01.h"
+#include "bsp_timestamp_fake.h"
 #include "private_signal_ranges.h"
 #include "pubsub_signals.h"
 #include "stm32g4xx_hal.h"
@@ -41,6 +42,7 @@ TEST_GROUP(Lmt01Tests) {
 
         htim8.counter           = 0U;
         s_hal_timer_start_count = 0U;
+        BSP_TimestampFake_Reset();
 
         qf_ctrl::Setup(PUBSUB_MAX_SIG, 1000, configs);
         recorder = PublishedEventRecorder::CreatePublishedEventRecorder(
@@ -95,6 +97,7 @@ TEST(Lmt01Tests, stable_pulse_count_over_deglitch_threshold_publishes_temperatur
     htim8.counter = 800U;
     postPollTimeout();
     htim8.counter = 800U;
+    BSP_TimestampFake_Set_Microseconds(2500000U);
     postPollTimeout();
 
     auto event = recorder->getRecordedEvent();
@@ -103,6 +106,7 @@ TEST(Lmt01Tests, stable_pulse_count_over_deglitch_threshold_publishes_temperatur
 
     FloatEvent_T const *temperature_event = reinterpret_cast<FloatEvent_T const *>(event.get());
     DOUBLES_EQUAL(0.0, temperature_event->num, 0.001);
+    CHECK_EQUAL(2500000U, temperature_event->timestamp_us);
     CHECK_EQUAL(0U, htim8.counter);
 }
 
@@ -1,4 +1,5 @@
 extern "C" {
+#include "bsp_timestamp_fake.h"
 #include "config.h"
 #include "director.h"
 #include "private_signal_ranges.h"
@@ -18,9 +19,8 @@ static bool s_start;
 static bool s_temp_good;
 static bool s_pres_good;
 static bool s_buzzer;
-static float s_vbat;
 static float s_flow_hz;
-static uint32_t s_engine_minutes;
+static uint32_t s_config_u32[CFG_ID_NUM_IDS];
 static uint32_t s_config_write_count;
 static uint32_t s_config_save_count;
 static ConfigID_T s_last_config_write_id;
@@ -31,15 +31,14 @@ extern "C" bool BSP_Get_Start(void) { return s_start; }
 extern "C" bool BSP_Get_Temp_Good(void) { return s_temp_good; }
 extern "C" bool BSP_Get_Pres_Good(void) { return s_pres_good; }
 extern "C" bool BSP_Get_Buzzer(void) { return s_buzzer; }
-extern "C" float BSP_ADC_Read_VBAT(void) { return s_vbat; }
 extern "C" float Flow_Sensor_Read_Hz(void) { return s_flow_hz; }
-extern "C" uint32_t Config_Read_U32(ConfigID_T) { return s_engine_minutes; }
+extern "C" uint32_t Config_Read_U32(ConfigID_T id) { return s_config_u32[id]; }
 extern "C" void Config_Write_U32(ConfigID_T id, uint32_t value)
 {
     s_config_write_count++;
     s_last_config_write_id    = id;
     s_last_config_write_value = value;
-    s_engine_minutes          = value;
+    s_config_u32[id]          = value;
 }
 extern "C" void Config_Save(void) { s_config_save_count++; }
 
@@ -49,6 +48,28 @@ static void postDirectorSignal(enum_t sig)
     qf_ctrl::PostAndProcess(&event, AO_Director);
 }
 
+static void publishConfigEntryChanged(ConfigID_T id, uint32_t value)
+{
+    s_config_u32[id] = value;
+
+    ConfigEntryChangedEvent_T event = {
+        .super = QEVT_INITIALIZER(PUBSUB_CONFIG_ENTRY_CHANGED_SIG),
+        .id    = id,
+    };
+    qf_ctrl::PublishAndProcess(&event.super);
+}
+
+static VbatEvent_T makeVbatEvent(float volts, float min_volts, float max_volts)
+{
+    VbatEvent_T event = {
+        .super     = QEVT_INITIALIZER(PUBSUB_VBAT_SIG),
+        .volts     = volts,
+        .min_volts = min_volts,
+        .max_volts = max_volts,
+    };
+    return event;
+}
+
 TEST_GROUP(MotorDirectorTests) {
     PublishedEventRecorder *recorder;
 
@@ -64,14 +85,21 @@ TEST_GROUP(MotorDirectorTests) {
         s_temp_good               = true;
         s_pres_good               = false;
         s_buzzer                  = true;
-        s_vbat                    = 12.0F;
         s_flow_hz                 = 66.66F;
-        s_engine_minutes          = 42U;
         s_config_write_count      = 0U;
         s_config_save_count       = 0U;
         s_last_config_write_id    = CFG_ID_INVALID;
         s_last_config_write_value = 0U;
 
+        s_config_u32[CFG_ID_ENGINE_MINUTES]             = 42U;
+        s_config_u32[CFG_ID_DIRECTOR_FLAGS_HZ]          = DIRECTOR_FLAGS_HZ;
+        s_config_u32[CFG_ID_DIRECTOR_RPM_HZ]            = DIRECTOR_RPM_HZ;
+        s_config_u32[CFG_ID_DIRECTOR_TEMPERATURE_HZ]    = DIRECTOR_TEMPERATURE_HZ;
+        s_config_u32[CFG_ID_DIRECTOR_PRESSURE_HZ]       = DIRECTOR_PRESSURE_HZ;
+        s_config_u32[CFG_ID_DIRECTOR_VBAT_HZ]           = DIRECTOR_VBAT_HZ;
+        s_config_u32[CFG_ID_DIRECTOR_ENGINE_MINUTES_HZ] = DIRECTOR_ENGINE_MINUTES_HZ;
+        BSP_TimestampFake_Reset();
+
         qf_ctrl::Setup(PUBSUB_MAX_SIG, 1000, configs);
         recorder = PublishedEventRecorder::CreatePublishedEventRecorder(
             qf_ctrl::RECORDER_PRIORITY, PUBSUB_FIRST_SIG, PUBSUB_MAX_SIG);
@@ -116,17 +144,24 @@ TEST(MotorDirectorTests, startup_publishes_box_to_box_startup)
 
 TEST(MotorDirectorTests, periodic_poll_publishes_aggregated_motor_data)
 {
+    BSP_TimestampFake_Set_Microseconds(5000000U);
+
     FloatEvent_T pressure_event = {
-        .super = QEVT_INITIALIZER(PUBSUB_PRESSURE_SIG),
-        .num   = 8.5F,
+        .super        = QEVT_INITIALIZER(PUBSUB_PRESSURE_SIG),
+        .num          = 8.5F,
+        .timestamp_us = 4990000U,
     };
     FloatEvent_T temperature_event = {
-        .super = QEVT_INITIALIZER(PUBSUB_TEMPERATURE_SIG),
-        .num   = 72.25F,
+        .super        = QEVT_INITIALIZER(PUBSUB_TEMPERATURE_SIG),
+        .num          = 72.25F,
+        .timestamp_us = 4900000U,
     };
 
+    VbatEvent_T vbat_event = makeVbatEvent(12.0F, 11.2F, 12.4F);
+
     qf_ctrl::PublishAndProcess(&pressure_event.super, recorder);
     qf_ctrl::PublishAndProcess(&temperature_event.super, recorder);
+    qf_ctrl::PublishAndProcess(&vbat_event.super, recorder);
     postDirectorSignal(PRIVATE_SIGNAL_DIRECTOR_START);
 
     auto event = getNextRecordedEventWithSig(PUBSUB_MOTOR_DATA_SIG);
@@ -138,11 +173,135 @@ TEST(MotorDirectorTests, periodic_poll_publishes_aggregated_motor_data)
     CHECK_EQUAL(s_temp_good, motor_event->temp_good);
     CHECK_EQUAL(s_pres_good, motor_event->pres_good);
     CHECK_EQUAL(s_buzzer, motor_event->buzzer);
-    DOUBLES_EQUAL(0.12, motor_event->vbat, 0.001);
+    DOUBLES_EQUAL(12.0, motor_event->vbat, 0.001);
+    DOUBLES_EQUAL(11.2, motor_event->vbat_min, 0.001);
+    DOUBLES_EQUAL(12.4, motor_event->vbat_max, 0.001);
     DOUBLES_EQUAL(72.25, motor_event->temperature, 0.001);
     DOUBLES_EQUAL(8.5, motor_event->pressure, 0.001);
     DOUBLES_EQUAL(59.994, motor_event->tachometer, 0.01);
     CHECK_EQUAL(42U, motor_event->engine_minutes);
+    CHECK_EQUAL(5000000U, motor_event->timestamp_us);
+    CHECK_EQUAL(100000U, motor_event->temperature_age_us);
+    CHECK_EQUAL(10000U, motor_event->pressure_age_us);
+    CHECK_EQUAL(MOTOR_DATA_UPDATED_ALL, motor_event->updated);
+}
+
+TEST(MotorDirectorTests, rate_groups_publish_only_the_fields_that_are_due)
+{
+    postDirectorSignal(PRIVATE_SIGNAL_DIRECTOR_START);
+    CHECK_TRUE(getNextRecordedEventWithSig(PUBSUB_MOTOR_DATA_SIG) != nullptr);
+
+    // scheduler tick 2 of 200 Hz: nothing is due, nothing is published
+    postDirectorSignal(PRIVATE_SIGNAL_DIRECTOR_START);
+    CHECK_TRUE(getNextRecordedEventWithSig(PUBSUB_MOTOR_DATA_SIG) == nullptr);
+
+    // tick 3: only the 100 Hz RPM group, the GPIO flags are sampled at 50 Hz
+    s_neutral = false;
+    postDirectorSignal(PRIVATE_SIGNAL_DIRECTOR_START);
+
+    auto event = getNextRecordedEventWithSig(PUBSUB_MOTOR_DATA_SIG);
+    CHECK_TRUE(event != nullptr);
+    MotorDataEvent_T const *motor_event = reinterpret_cast<MotorDataEvent_T const *>(event.get());
+    CHECK_EQUAL(MOTOR_DATA_UPDATED_TACHOMETER, motor_event->updated);
+    CHECK_TRUE(motor_event->neutral);
+
+    // tick 5: RPM and flags
+    postDirectorSignal(PRIVATE_SIGNAL_DIRECTOR_START);
+    postDirectorSignal(PRIVATE_SIGNAL_DIRECTOR_START);
+
+    event = getNextRecordedEventWithSig(PUBSUB_MOTOR_DATA_SIG);
+    CHECK_TRUE(event != nullptr);
+    motor_event = reinterpret_cast<MotorDataEvent_T const *>(event.get());
+    CHECK_EQUAL(MOTOR_DATA_UPDATED_TACHOMETER | MOTOR_DATA_UPDATED_FLAGS, motor_event->updated);
+    CHECK_FALSE(motor_event->neutral);
+}
+
+TEST(MotorDirectorTests, temperature_is_due_at_its_own_rate)
+{
+    unsigned temperature_count = 0U;
+
+    // one second of scheduler ticks
+    for (unsigned tick = 0U; tick < DIRECTOR_SCHEDULER_HZ; tick++)
+    {
+        postDirectorSignal(PRIVATE_SIGNAL_DIRECTOR_START);
+
+        auto event = getNextRecordedEventWithSig(PUBSUB_MOTOR_DATA_SIG);
+        if (event != nullptr)
+        {
+            MotorDataEvent_T const *motor_event =
+                reinterpret_cast<MotorDataEvent_T const *>(event.get());
+            if ((motor_event->updated & MOTOR_DATA_UPDATED_TEMPERATURE) != 0U)
+            {
+                temperature_count++;
+            }
+        }
+    }
+
+    CHECK_EQUAL(DIRECTOR_TEMPERATURE_HZ, temperature_count);
+}
+
+TEST(MotorDirectorTests, config_overrides_a_rate_once_config_is_ready)
+{
+    QEvt config_ready = QEVT_INITIALIZER(PUBSUB_CONFIG_READY_SIG);
+    qf_ctrl::PublishAndProcess(&config_ready, recorder);
+
+    postDirectorSignal(PRIVATE_SIGNAL_DIRECTOR_START);
+    CHECK_TRUE(getNextRecordedEventWithSig(PUBSUB_MOTOR_DATA_SIG) != nullptr);
+
+    // RPM on every scheduler tick
+    publishConfigEntryChanged(CFG_ID_DIRECTOR_RPM_HZ, DIRECTOR_SCHEDULER_HZ);
+
+    postDirectorSignal(PRIVATE_SIGNAL_DIRECTOR_START);
+
+    auto event = getNextRecordedEventWithSig(PUBSUB_MOTOR_DATA_SIG);
+    CHECK_TRUE(event != nullptr);
+    MotorDataEvent_T const *motor_event = reinterpret_cast<MotorDataEvent_T const *>(event.get());
+    CHECK_EQUAL(MOTOR_DATA_UPDATED_TACHOMETER, motor_event->updated);
+}
+
+TEST(MotorDirectorTests, invalid_rate_override_falls_back_to_the_default)
+{
+    QEvt config_ready = QEVT_INITIALIZER(PUBSUB_CONFIG_READY_SIG);
+    qf_ctrl::PublishAndProcess(&config_ready, recorder);
+
+    publishConfigEntryChanged(CFG_ID_DIRECTOR_RPM_HZ, 0U);
+
+    postDirectorSignal(PRIVATE_SIGNAL_DIRECTOR_START);
+    CHECK_TRUE(getNextRecordedEventWithSig(PUBSUB_MOTOR_DATA_SIG) != nullptr);
+
+    postDirectorSignal(PRIVATE_SIGNAL_DIRECTOR_START);
+    CHECK_TRUE(getNextRecordedEventWithSig(PUBSUB_MOTOR_DATA_SIG) == nullptr);
+}
+
+TEST(MotorDirectorTests, sample_ages_are_unknown_until_the_first_sample_arrives)
+{
+    postDirectorSignal(PRIVATE_SIGNAL_DIRECTOR_START);
+
+    auto event = getNextRecordedEventWithSig(PUBSUB_MOTOR_DATA_SIG);
+    CHECK_TRUE(event != nullptr);
+
+    MotorDataEvent_T const *motor_event = reinterpret_cast<MotorDataEvent_T const *>(event.get());
+    CHECK_EQUAL(BSP_Get_Microseconds(), motor_event->timestamp_us);
+    CHECK_EQUAL(SAMPLE_AGE_UNKNOWN_US, motor_event->temperature_age_us);
+    CHECK_EQUAL(SAMPLE_AGE_UNKNOWN_US, motor_event->pressure_age_us);
+}
+
+TEST(MotorDirectorTests, vbat_blocks_seed_then_filter_the_published_voltage)
+{
+    VbatEvent_T first_block  = makeVbatEvent(12.0F, 11.9F, 12.1F);
+    VbatEvent_T second_block = makeVbatEvent(13.0F, 9.5F, 13.5F);
+
+    qf_ctrl::PublishAndProcess(&first_block.super, recorder);
+    qf_ctrl::PublishAndProcess(&second_block.super, recorder);
+    postDirectorSignal(PRIVATE_SIGNAL_DIRECTOR_START);
+
+    auto event = getNextRecordedEventWithSig(PUBSUB_MOTOR_DATA_SIG);
+    CHECK_TRUE(event != nullptr);
+
+    MotorDataEvent_T const *motor_event = reinterpret_cast<MotorDataEvent_T const *>(event.get());
+    DOUBLES_EQUAL(12.05, motor_event->vbat, 0.001);
+    DOUBLES_EQUAL(9.5, motor_event->vbat_min, 0.001);
+    DOUBLES_EQUAL(13.5, motor_event->vbat_max, 0.001);
 }
 
 TEST(MotorDirectorTests, engine_minute_tick_updates_config_only_when_ready_and_running)
@@ -1,11 +1,17 @@
 extern "C" {
+#include "c/ConfigDB.pb.h"
+#include "c/CpuLoad.pb.h"
+#include "c/EventWatermarks.pb.h"
 #include "c/MessageType.pb.h"
 #include "c/MotorData.pb.h"
+#include "c/SensorTrace.pb.h"
+#include "event_watermarks.h"
 #include "pc_com.h"
 #include "pc_com/crc16.h"
 #include "pc_com/hdlc.h"
 #include "pb_decode.h"
 #include "pubsub_signals.h"
+#include "sensor_trace.h"
 }
 
 #include "cms_cpputest_qf_ctrl.hpp"
@@ -22,6 +28,14 @@ static size_t s_tx_len;
 static Serial_IO_Data_Ready_Callback s_data_ready_cb;
 static void *s_data_ready_cb_data;
 
+// the other board, a whole packet at a time
+static uint8_t s_tunnel_tx_packet[128];
+static size_t s_tunnel_tx_len;
+static uint8_t s_tunnel_rx_packet[64];
+static size_t s_tunnel_rx_len;
+static Serial_IO_Data_Ready_Callback s_tunnel_cb;
+static void *s_tunnel_cb_data;
+
 extern "C" uint32_t BSP_Get_Milliseconds_Tick(void)
 {
     return 4321U;
@@ -56,6 +70,43 @@ static const Serial_IO_T s_serial = {
     .register_cb_func = serial_register_cb,
 };
 
+static uint16_t tunnel_tx(const uint8_t *data_ptr, const uint16_t data_len)
+{
+    if (data_len > sizeof(s_tunnel_tx_packet))
+    {
+        return 0U;
+    }
+
+    memcpy(s_tunnel_tx_packet, data_ptr, data_len);
+    s_tunnel_tx_len = data_len;
+    return data_len;
+}
+
+static uint16_t tunnel_rx(uint8_t *data_ptr, const uint16_t max_data_len)
+{
+    if ((s_tunnel_rx_len == 0U) || (s_tunnel_rx_len > max_data_len))
+    {
+        return 0U;
+    }
+
+    uint16_t length = (uint16_t) s_tunnel_rx_len;
+    memcpy(data_ptr, s_tunnel_rx_packet, length);
+    s_tunnel_rx_len = 0U;
+    return length;
+}
+
+static void tunnel_register_cb(Serial_IO_Data_Ready_Callback cb, void *cb_data)
+{
+    s_tunnel_cb      = cb;
+    s_tunnel_cb_data = cb_data;
+}
+
+static const Serial_IO_T s_tunnel = {
+    .tx_func          = tunnel_tx,
+    .rx_func          = tunnel_rx,
+    .register_cb_func = tunnel_register_cb,
+};
+
 static size_t unpack_last_frame(uint8_t *packet, size_t packet_len)
 {
     HDLC_Unpacker_T unpacker;
@@ -71,6 +122,29 @@ static size_t unpack_last_frame(uint8_t *packet, size_t packet_len)
     return unpacker.packet_length;
 }
 
+static void receive_tunnel_request(uint8_t type)
+{
+    s_tunnel_rx_packet[2] = type;
+    uint16_t crc          = crc_calculate(&s_tunnel_rx_packet[2], 1U);
+    s_tunnel_rx_packet[0] = (uint8_t) crc;
+    s_tunnel_rx_packet[1] = (uint8_t) (crc >> 8U);
+    s_tunnel_rx_len       = 3U;
+
+    s_tunnel_cb(s_tunnel_cb_data);
+    qf_ctrl::ProcessEvents();
+}
+
+static SensorTraceData decode_tunnel_sensor_trace_data(void)
+{
+    CHECK_TRUE(s_tunnel_tx_len >= 3U);
+    CHECK_EQUAL(MessageType_SENSOR_TRACE_DATA, s_tunnel_tx_packet[2]);
+
+    SensorTraceData decoded = SensorTraceData_init_zero;
+    pb_istream_t stream = pb_istream_from_buffer(&s_tunnel_tx_packet[3], s_tunnel_tx_len - 3U);
+    CHECK_TRUE(pb_decode(&stream, SensorTraceData_fields, &decoded));
+    return decoded;
+}
+
 TEST_GROUP(PcComPacketTests) {
     void setup() final
     {
@@ -82,13 +156,17 @@ TEST_GROUP(PcComPacketTests) {
         s_tx_len           = 0;
         s_data_ready_cb    = nullptr;
         s_data_ready_cb_data = nullptr;
+        s_tunnel_tx_len    = 0;
+        s_tunnel_rx_len    = 0;
+        s_tunnel_cb        = nullptr;
+        s_tunnel_cb_data   = nullptr;
 
         qf_ctrl::Setup(
             PUBSUB_MAX_SIG,
             1000,
             configs,
             qf_ctrl::MemPoolTeardownOption::IGNORE);
-        PC_COM_ctor(&s_serial);
+        PC_COM_ctor(&s_serial, &s_tunnel);
         QACTIVE_START(
             AO_PC_COM,
             qf_ctrl::UNIT_UNDER_TEST_PRIORITY,
@@ -110,22 +188,51 @@ TEST(PcComPacketTests, startup_registers_serial_data_ready_callback)
 {
     CHECK_TRUE(s_data_ready_cb != nullptr);
     CHECK_TRUE(s_data_ready_cb_data != nullptr);
+    CHECK_TRUE(s_tunnel_cb != nullptr);
+}
+
+TEST(PcComPacketTests, tunnel_request_is_answered_through_the_tunnel)
+{
+    s_tunnel_rx_packet[2] = MessageType_CONFIG_DB_REQ_DATABASE_INFO_REQ;
+    uint16_t crc          = crc_calculate(&s_tunnel_rx_packet[2], 1U);
+    s_tunnel_rx_packet[0] = (uint8_t) crc;
+    s_tunnel_rx_packet[1] = (uint8_t) (crc >> 8U);
+    s_tunnel_rx_len       = 3U;
+
+    s_tunnel_cb(s_tunnel_cb_data);
+    qf_ctrl::ProcessEvents();
+
+    CHECK_EQUAL(0U, s_tx_len);
+    CHECK_TRUE(s_tunnel_tx_len >= 3U);
+
+    uint16_t packet_crc =
+        (uint16_t) s_tunnel_tx_packet[0] | ((uint16_t) s_tunnel_tx_packet[1] << 8U);
+    CHECK_EQUAL(
+        packet_crc, crc_calculate(&s_tunnel_tx_packet[2], (uint16_t) (s_tunnel_tx_len - 2U)));
+    CHECK_EQUAL(MessageType_CONFIG_DB_INFO_RESP, s_tunnel_tx_packet[2]);
+
+    ConfigDBInfoResp decoded = ConfigDBInfoResp_init_zero;
+    pb_istream_t stream = pb_istream_from_buffer(&s_tunnel_tx_packet[3], s_tunnel_tx_len - 3U);
+    CHECK_TRUE(pb_decode(&stream, ConfigDBInfoResp_fields, &decoded));
 }
 
 TEST(PcComPacketTests, motor_data_event_transmits_motor_data_protobuf_packet)
 {
     MotorDataEvent_T event = {
-        .super          = QEVT_INITIALIZER(PUBSUB_MOTOR_DATA_SIG),
-        .temperature    = 70.5F,
-        .pressure       = 9.75F,
-        .tachometer     = 1450.0F,
-        .vbat           = 12.4F,
-        .engine_minutes = 321U,
-        .start          = true,
-        .neutral        = false,
-        .buzzer         = true,
-        .temp_good      = false,
-        .pres_good      = true,
+        .super              = QEVT_INITIALIZER(PUBSUB_MOTOR_DATA_SIG),
+        .temperature        = 70.5F,
+        .pressure           = 9.75F,
+        .tachometer         = 1450.0F,
+        .vbat               = 12.4F,
+        .engine_minutes     = 321U,
+        .start              = true,
+        .neutral            = false,
+        .buzzer             = true,
+        .temp_good          = false,
+        .pres_good          = true,
+        .timestamp_us       = 0x100000002ULL,
+        .temperature_age_us = 75000U,
+        .pressure_age_us    = 5000U,
     };
 
     qf_ctrl::PublishAndProcess(&event.super);
@@ -154,4 +261,98 @@ TEST(PcComPacketTests, motor_data_event_transmits_motor_data_protobuf_packet)
     CHECK_EQUAL(event.buzzer, decoded.buzzer);
     CHECK_EQUAL(event.temp_good, decoded.temp_good);
     CHECK_EQUAL(event.pres_good, decoded.pres_good);
+    CHECK_EQUAL(event.timestamp_us, decoded.timestamp_us);
+    CHECK_EQUAL(event.temperature_age_us, decoded.temperature_age_us);
+    CHECK_EQUAL(event.pressure_age_us, decoded.pressure_age_us);
+}
+
+TEST(PcComPacketTests, sensor_trace_streams_to_the_port_that_started_it)
+{
+    receive_tunnel_request(MessageType_SENSOR_TRACE_START_REQ);
+    Sensor_Trace_Record(SENSOR_TRACE_TACH_PERIOD, 40000U);
+    Sensor_Trace_Record(SENSOR_TRACE_GPIO, SENSOR_TRACE_GPIO_NEUTRAL);
+
+    qf_ctrl::MoveTimeForward(std::chrono::milliseconds(50));
+
+    CHECK_EQUAL(0U, s_tx_len);
+    SensorTraceData decoded = decode_tunnel_sensor_trace_data();
+    CHECK_EQUAL(0U, decoded.sequence);
+    CHECK_EQUAL(0U, decoded.lost_records);
+    CHECK_FALSE(decoded.last);
+
+    Sensor_Trace_Reader_T reader;
+    Sensor_Trace_Record_T record;
+    CHECK_TRUE(Sensor_Trace_Reader_Init(&reader, decoded.data.bytes, decoded.data.size));
+    CHECK_TRUE(Sensor_Trace_Reader_Next(&reader, &record));
+    CHECK_EQUAL(SENSOR_TRACE_TACH_PERIOD, record.type);
+    CHECK_EQUAL(40000U, record.value);
+    CHECK_TRUE(Sensor_Trace_Reader_Next(&reader, &record));
+    CHECK_EQUAL(SENSOR_TRACE_GPIO, record.type);
+    CHECK_EQUAL(SENSOR_TRACE_GPIO_NEUTRAL, record.value);
+    CHECK_FALSE(Sensor_Trace_Reader_Next(&reader, &record));
+    CHECK_FALSE(reader.corrupt);
+
+    // nothing recorded since, nothing sent
+    s_tunnel_tx_len = 0U;
+    qf_ctrl::MoveTimeForward(std::chrono::milliseconds(50));
+    CHECK_EQUAL(0U, s_tunnel_tx_len);
+
+    receive_tunnel_request(MessageType_SENSOR_TRACE_STOP_REQ);
+    qf_ctrl::MoveTimeForward(std::chrono::milliseconds(50));
+
+    decoded = decode_tunnel_sensor_trace_data();
+    CHECK_EQUAL(1U, decoded.sequence);
+    CHECK_EQUAL(0U, decoded.data.size);
+    CHECK_TRUE(decoded.last);
+
+    // and the stream is over
+    s_tunnel_tx_len = 0U;
+    qf_ctrl::MoveTimeForward(std::chrono::milliseconds(100));
+    CHECK_EQUAL(0U, s_tunnel_tx_len);
+}
+
+TEST(PcComPacketTests, cpu_load_is_sent_once_a_second)
+{
+    // past the CLI prompt
+    qf_ctrl::MoveTimeForward(std::chrono::milliseconds(999));
+    s_tx_len = 0U;
+
+    qf_ctrl::MoveTimeForward(std::chrono::milliseconds(1));
+
+    uint8_t packet[64];
+    size_t packet_len = unpack_last_frame(packet, sizeof(packet));
+
+    CHECK_TRUE(packet_len > 3U);
+    CHECK_EQUAL(MessageType_CPU_LOAD, packet[2]);
+
+    CpuLoad decoded     = CpuLoad_init_zero;
+    pb_istream_t stream = pb_istream_from_buffer(&packet[3], packet_len - 3U);
+    CHECK_TRUE(pb_decode(&stream, CpuLoad_fields, &decoded));
+    CHECK_EQUAL(4321U, decoded.milliseconds_tick);
+}
+
+TEST(PcComPacketTests, event_watermarks_req_reports_each_pool_and_queue)
+{
+    const char *names[qf_ctrl::UNIT_UNDER_TEST_PRIORITY + 1U] = {};
+    names[qf_ctrl::UNIT_UNDER_TEST_PRIORITY]                  = "pc_com";
+    Event_Watermarks_Start(names, Q_DIM(names));
+
+    receive_tunnel_request(MessageType_EVENT_WATERMARKS_REQ);
+
+    CHECK_TRUE(s_tunnel_tx_len >= 3U);
+    CHECK_EQUAL(MessageType_EVENT_WATERMARKS_RESP, s_tunnel_tx_packet[2]);
+
+    EventWatermarksResp decoded = EventWatermarksResp_init_zero;
+    pb_istream_t stream = pb_istream_from_buffer(&s_tunnel_tx_packet[3], s_tunnel_tx_len - 3U);
+    CHECK_TRUE(pb_decode(&stream, EventWatermarksResp_fields, &decoded));
+
+    CHECK_EQUAL(4321U, decoded.milliseconds_tick);
+    CHECK_EQUAL(EVENT_WATERMARKS_WARN_PERCENT, decoded.warn_percent);
+    CHECK_EQUAL(2U, decoded.pools_count);
+    CHECK_TRUE(decoded.pools[0].block_size < decoded.pools[1].block_size);
+    CHECK_EQUAL(0U, decoded.pools[0].allocs);
+    CHECK_EQUAL(1U, decoded.queues_count);
+    STRCMP_EQUAL("pc_com", decoded.queues[0].name);
+    CHECK_EQUAL(qf_ctrl::UNIT_UNDER_TEST_PRIORITY, decoded.queues[0].prio);
+    CHECK_EQUAL(Q_DIM(s_queue_storage) + 1U, decoded.queues[0].length);
 }
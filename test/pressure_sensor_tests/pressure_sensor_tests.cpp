@@ -1,4 +1,5 @@
 extern "C" {
+#include "bsp_timestamp_fake.h"
 #include "pressure_sensor.h"
 #include "private_signal_ranges.h"
 #include "pubsub_signals.h"
@@ -91,6 +92,7 @@ TEST_GROUP(PressureSensorTests) {
         s_i2c_read_data[1] = 0x19U;
         s_i2c_read_data[2] = 0x99U;
         s_i2c_read_data[3] = 0x9aU;
+        BSP_TimestampFake_Reset();
 
         qf_ctrl::Setup(PUBSUB_MAX_SIG, 1000, configs);
         recorder = PublishedEventRecorder::CreatePublishedEventRecorder(
@@ -136,6 +138,7 @@ TEST(PressureSensorTests, successful_conversion_publishes_pressure)
     qf_ctrl::MoveTimeForward(std::chrono::milliseconds(10));
     CHECK_EQUAL(1U, s_i2c_read_count);
 
+    BSP_TimestampFake_Set_Microseconds(3000000U);
     postPressureSignal(PRIVATE_SIGNAL_PRESSURE_START + 2U);
 
     auto event = recorder->getRecordedEvent();
@@ -143,6 +146,7 @@ TEST(PressureSensorTests, successful_conversion_publishes_pressure)
     CHECK_EQUAL(PUBSUB_PRESSURE_SIG, event->sig);
     FloatEvent_T const *pressure_event = reinterpret_cast<FloatEvent_T const *>(event.get());
     DOUBLES_EQUAL(0.0, pressure_event->num, 0.001);
+    CHECK_EQUAL(3000000U, pressure_event->timestamp_us);
 }
 
 TEST(PressureSensorTests, watchdog_without_successful_reading_generates_pressure_i2c_fault)
@@ -0,0 +1,494 @@
+extern "C" {
+#include "c/ConfigDB.pb.h"
+#include "c/MessageType.pb.h"
+#include "c/MotorData.pb.h"
+#include "cli_commands.h"
+#include "config.h"
+#include "director.h"
+#include "pc_com.h"
+#include "pc_com/crc16.h"
+#include "pc_com/hdlc.h"
+#include "pb_decode.h"
+#include "pb_encode.h"
+#include "pubsub_signals.h"
+}
+
+#include "cms_cpputest_qf_ctrl.hpp"
+
+#include "CppUTest/TestHarness.h"
+#include "benchmark.h"
+
+#include <cstdio>
+#include <cstring>
+
+// Speed of the pc_com protocol path on the host, reported by the harness in benchmark.h
+
+using namespace cms::test;
+
+// results go here so the compiler can't drop the work
+static volatile uint32_t s_sink;
+
+/**************************************************************************************************\
+* Workloads
+\**************************************************************************************************/
+
+static uint8_t s_frame[2U * 256U + 2U]; // worst case framing of a 256 byte packet
+static size_t s_frame_len;
+
+static uint16_t frame_tx(const uint8_t *data_ptr, const uint16_t data_len)
+{
+    if ((s_frame_len + data_len) > sizeof(s_frame))
+    {
+        return 0U;
+    }
+
+    memcpy(&s_frame[s_frame_len], data_ptr, data_len);
+    s_frame_len += data_len;
+    return data_len;
+}
+
+static MotorData make_motor_data(void)
+{
+    MotorData message          = MotorData_init_zero;
+    message.milliseconds_tick  = 123456U;
+    message.temperature        = 71.5F;
+    message.pressure           = 42.25F;
+    message.tachometer         = 4480.0F;
+    message.vbat               = 13.9F;
+    message.engine_minutes     = 98765U;
+    message.start              = false;
+    message.neutral            = false;
+    message.buzzer             = false;
+    message.temp_good          = true;
+    message.pres_good          = true;
+    message.timestamp_us       = 123456789012ULL;
+    message.temperature_age_us = 75000U;
+    message.pressure_age_us    = 5000U;
+    return message;
+}
+
+static ConfigEntryDataResp make_config_entry_data_resp(void)
+{
+    ConfigEntryDataResp message               = ConfigEntryDataResp_init_zero;
+    message.entry_id                          = CFG_ID_CAN_TEMPERATURE_DEADBAND;
+    message.value.which_value                 = ConfigValue_value_float32_tag;
+    message.value.value.value_float32         = 0.75F;
+    message.default_value.which_value         = ConfigValue_value_float32_tag;
+    message.default_value.value.value_float32 = 0.5F;
+    strcpy(message.name, "can_temperature_deadband");
+    return message;
+}
+
+// a whole pc_com packet, CRC, type and message, as it goes into HDLC
+static size_t build_packet(
+    uint8_t *packet, size_t size, MessageType type, const pb_msgdesc_t *fields, const void *message)
+{
+    pb_ostream_t stream = pb_ostream_from_buffer(&packet[3], size - 3U);
+    CHECK_TRUE(pb_encode(&stream, fields, message));
+
+    packet[2]    = (uint8_t) type;
+    uint16_t crc = crc_calculate(&packet[2], (uint16_t) (stream.bytes_written + 1U));
+    packet[0]    = (uint8_t) crc;
+    packet[1]    = (uint8_t) (crc >> 8U);
+    return stream.bytes_written + 3U;
+}
+
+/**************************************************************************************************\
+* Fakes
+\**************************************************************************************************/
+
+extern "C" uint32_t BSP_Get_Milliseconds_Tick(void)
+{
+    return 4321U;
+}
+
+// the gauge Director's outputs, only its calibration tables are timed
+extern "C" void BSP_Gauge_SetPressure_V(float) {}
+extern "C" void BSP_Gauge_SetTemperature_V(float) {}
+extern "C" void BSP_Gauge_SetOpAmpRef_V(float) {}
+extern "C" void BSP_RpmGauge_SetPFM_RPM(uint32_t) {}
+extern "C" void BSP_Set_Backlight(bool) {}
+extern "C" bool BSP_Get_Backlight(void)
+{
+    return false;
+}
+
+extern "C" void CLI_AddCommands(EmbeddedCli *)
+{
+}
+
+// A config database held in RAM like config.c's, so the config benchmarks time pc_com
+extern "C" QActive *const AO_Config = nullptr;
+
+typedef union
+{
+    uint32_t u32_val;
+    int32_t i32_val;
+    float f32_val;
+    bool bool_val;
+} FakeConfigValue_T;
+
+static FakeConfigValue_T s_config_values[CFG_ID_NUM_IDS];
+
+static bool is_deadband(ConfigID_T id)
+{
+    return (id >= CFG_ID_CAN_TEMPERATURE_DEADBAND) && (id <= CFG_ID_CAN_VBAT_DEADBAND);
+}
+
+extern "C" uint32_t Config_Get_Num_Elements(void)
+{
+    return CFG_ID_NUM_IDS;
+}
+
+extern "C" uint32_t Config_Get_Version(void)
+{
+    return 0U;
+}
+
+extern "C" ConfigValueType_T Config_GetType(ConfigID_T id)
+{
+    return is_deadband(id) ? CFG_VAL_TYPE_F32 : CFG_VAL_TYPE_U32;
+}
+
+extern "C" const char *Config_GetName(ConfigID_T id)
+{
+    return is_deadband(id) ? "can_temperature_deadband" : "director_engine_minutes_hz";
+}
+
+extern "C" uint32_t Config_Read_U32(ConfigID_T id)
+{
+    return s_config_values[id].u32_val;
+}
+
+extern "C" uint32_t Config_Read_Default_U32(ConfigID_T)
+{
+    return 10U;
+}
+
+extern "C" void Config_Write_U32(ConfigID_T id, uint32_t value)
+{
+    s_config_values[id].u32_val = value;
+}
+
+extern "C" int32_t Config_Read_I32(ConfigID_T id)
+{
+    return s_config_values[id].i32_val;
+}
+
+extern "C" int32_t Config_Read_Default_I32(ConfigID_T)
+{
+    return 0;
+}
+
+extern "C" void Config_Write_I32(ConfigID_T id, int32_t value)
+{
+    s_config_values[id].i32_val = value;
+}
+
+extern "C" bool Config_Read_Bool(ConfigID_T id)
+{
+    return s_config_values[id].bool_val;
+}
+
+extern "C" bool Config_Read_Default_Bool(ConfigID_T)
+{
+    return false;
+}
+
+extern "C" void Config_Write_Bool(ConfigID_T id, bool value)
+{
+    s_config_values[id].bool_val = value;
+}
+
+extern "C" float Config_Read_F32(ConfigID_T id)
+{
+    return s_config_values[id].f32_val;
+}
+
+extern "C" float Config_Read_Default_F32(ConfigID_T)
+{
+    return 0.5F;
+}
+
+extern "C" void Config_Write_F32(ConfigID_T id, float value)
+{
+    s_config_values[id].f32_val = value;
+}
+
+// the PC's side of the serial port, one framed request waiting and the response frame counted
+static uint8_t s_request_frame[64];
+static size_t s_request_frame_len;
+static size_t s_request_frame_pos;
+static size_t s_response_frame_len;
+static Serial_IO_Data_Ready_Callback s_data_ready_cb;
+static void *s_data_ready_cb_data;
+
+static uint16_t serial_tx(const uint8_t *data_ptr, const uint16_t data_len)
+{
+    (void) frame_tx(data_ptr, data_len);
+    s_response_frame_len += data_len;
+    return data_len;
+}
+
+static uint16_t serial_rx(uint8_t *data_ptr, const uint16_t max_data_len)
+{
+    uint16_t length = 0U;
+    while ((length < max_data_len) && (s_request_frame_pos < s_request_frame_len))
+    {
+        data_ptr[length++] = s_request_frame[s_request_frame_pos++];
+    }
+    return length;
+}
+
+static void serial_register_cb(Serial_IO_Data_Ready_Callback cb, void *cb_data)
+{
+    s_data_ready_cb      = cb;
+    s_data_ready_cb_data = cb_data;
+}
+
+static const Serial_IO_T s_serial = {
+    .tx_func          = serial_tx,
+    .rx_func          = serial_rx,
+    .register_cb_func = serial_register_cb,
+};
+
+static void frame_request(MessageType type, const pb_msgdesc_t *fields, const void *message)
+{
+    uint8_t packet[32];
+    size_t packet_len = build_packet(packet, sizeof(packet), type, fields, message);
+
+    s_frame_len = 0U;
+    CHECK_EQUAL(0, hdlc_transmit_packet(frame_tx, packet, packet_len));
+    CHECK_TRUE(s_frame_len <= sizeof(s_request_frame));
+    memcpy(s_request_frame, s_frame, s_frame_len);
+    s_request_frame_len = s_frame_len;
+}
+
+// the request in, through the AO, the response out
+static void serve_request(void)
+{
+    s_request_frame_pos  = 0U;
+    s_response_frame_len = 0U;
+    s_frame_len          = 0U;
+    s_data_ready_cb(s_data_ready_cb_data);
+    qf_ctrl::ProcessEvents();
+}
+
+static ConfigEntryDataResp decode_response(void)
+{
+    uint8_t packet[256];
+    HDLC_Unpacker_T unpacker;
+    HDLC_Unpack_State_T state = FRAME_UNPACK_WAIT_SYNC;
+
+    hdlc_unpacker_init(&unpacker, packet, sizeof(packet));
+    for (size_t i = 0U; i < s_frame_len; i++)
+    {
+        state = hdlc_unpacker_add_byte(&unpacker, s_frame[i]);
+    }
+    CHECK_EQUAL(FRAME_UNPACK_COMPLETE, state);
+    CHECK_EQUAL(MessageType_CONFIG_DB_ENTRY_DATA_RESP, packet[2]);
+
+    ConfigEntryDataResp decoded = ConfigEntryDataResp_init_zero;
+    pb_istream_t stream = pb_istream_from_buffer(&packet[3], unpacker.packet_length - 3U);
+    CHECK_TRUE(pb_decode(&stream, ConfigEntryDataResp_fields, &decoded));
+    return decoded;
+}
+
+/**************************************************************************************************\
+* Benchmarks
+\**************************************************************************************************/
+
+TEST_GROUP(ProtocolBenchmarks) {
+};
+
+TEST(ProtocolBenchmarks, crc16)
+{
+    static uint8_t data[1024];
+    for (size_t i = 0U; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t) (i * 31U);
+    }
+
+    for (size_t length : {8U, 64U, 256U, 1024U})
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "crc16_%zuB", length);
+        Benchmark_Run(name, length, [&](uint64_t) {
+            s_sink = crc_calculate(data, (uint16_t) length);
+        });
+    }
+}
+
+TEST(ProtocolBenchmarks, hdlc_frame_and_unframe)
+{
+    uint8_t packet[MotorData_size + 3U];
+    MotorData message = make_motor_data();
+    size_t packet_len =
+        build_packet(packet, sizeof(packet), MessageType_MOTOR_DATA, MotorData_fields, &message);
+
+    Benchmark_Run("hdlc_frame_motor_data", packet_len, [&](uint64_t) {
+        s_frame_len = 0U;
+        s_sink      = (uint32_t) hdlc_transmit_packet(frame_tx, packet, packet_len);
+    });
+
+    // every byte escaped
+    static uint8_t flags[256];
+    memset(flags, 0x7E, sizeof(flags));
+    Benchmark_Run("hdlc_frame_worst_case_256B", sizeof(flags), [&](uint64_t) {
+        s_frame_len = 0U;
+        s_sink      = (uint32_t) hdlc_transmit_packet(frame_tx, flags, sizeof(flags));
+    });
+
+    s_frame_len = 0U;
+    CHECK_EQUAL(0, hdlc_transmit_packet(frame_tx, packet, packet_len));
+    size_t frame_len = s_frame_len;
+    uint8_t unpacked[sizeof(packet)];
+    HDLC_Unpacker_T unpacker;
+    hdlc_unpacker_init(&unpacker, unpacked, sizeof(unpacked));
+
+    Benchmark_Run("hdlc_unframe_motor_data", frame_len, [&](uint64_t) {
+        HDLC_Unpack_State_T state = FRAME_UNPACK_WAIT_SYNC;
+        for (size_t i = 0U; i < frame_len; i++)
+        {
+            state = hdlc_unpacker_add_byte(&unpacker, s_frame[i]);
+        }
+        s_sink = (uint32_t) state;
+    });
+    CHECK_EQUAL(packet_len, unpacker.packet_length);
+    MEMCMP_EQUAL(packet, unpacked, packet_len);
+}
+
+TEST(ProtocolBenchmarks, nanopb_motor_data)
+{
+    uint8_t buffer[MotorData_size];
+    MotorData message = make_motor_data();
+    pb_ostream_t sizing = PB_OSTREAM_SIZING;
+    CHECK_TRUE(pb_encode(&sizing, MotorData_fields, &message));
+    size_t encoded_len = sizing.bytes_written;
+
+    Benchmark_Run("nanopb_encode_motor_data", encoded_len, [&](uint64_t i) {
+        message.milliseconds_tick = (uint32_t) i;
+        pb_ostream_t stream       = pb_ostream_from_buffer(buffer, sizeof(buffer));
+        s_sink                    = pb_encode(&stream, MotorData_fields, &message);
+    });
+
+    message               = make_motor_data();
+    pb_ostream_t stream   = pb_ostream_from_buffer(buffer, sizeof(buffer));
+    CHECK_TRUE(pb_encode(&stream, MotorData_fields, &message));
+    MotorData decoded;
+
+    Benchmark_Run("nanopb_decode_motor_data", stream.bytes_written, [&](uint64_t) {
+        pb_istream_t istream = pb_istream_from_buffer(buffer, stream.bytes_written);
+        s_sink               = pb_decode(&istream, MotorData_fields, &decoded);
+    });
+    CHECK_EQUAL(message.timestamp_us, decoded.timestamp_us);
+}
+
+TEST(ProtocolBenchmarks, nanopb_config_entry_data_resp)
+{
+    uint8_t buffer[ConfigEntryDataResp_size];
+    ConfigEntryDataResp message = make_config_entry_data_resp();
+    pb_ostream_t sizing         = PB_OSTREAM_SIZING;
+    CHECK_TRUE(pb_encode(&sizing, ConfigEntryDataResp_fields, &message));
+
+    Benchmark_Run("nanopb_encode_config_entry_data_resp", sizing.bytes_written, [&](uint64_t i) {
+        message.value.value.value_float32 = (float) (i & 0xFFU);
+        pb_ostream_t stream               = pb_ostream_from_buffer(buffer, sizeof(buffer));
+        s_sink                            = pb_encode(&stream, ConfigEntryDataResp_fields, &message);
+    });
+
+    message             = make_config_entry_data_resp();
+    pb_ostream_t stream = pb_ostream_from_buffer(buffer, sizeof(buffer));
+    CHECK_TRUE(pb_encode(&stream, ConfigEntryDataResp_fields, &message));
+    ConfigEntryDataResp decoded;
+
+    Benchmark_Run("nanopb_decode_config_entry_data_resp", stream.bytes_written, [&](uint64_t) {
+        pb_istream_t istream = pb_istream_from_buffer(buffer, stream.bytes_written);
+        s_sink               = pb_decode(&istream, ConfigEntryDataResp_fields, &decoded);
+    });
+    STRCMP_EQUAL(message.name, decoded.name);
+}
+
+// inputs swept over each table and past both ends, so every segment is looked up
+TEST(ProtocolBenchmarks, lookup_gauge_voltage)
+{
+    volatile float sum = 0.0F;
+
+    Benchmark_Run("lookup_gauge_voltage_temperature", 0U, [&](uint64_t i) {
+        sum = sum + Director_Temperature_To_Gauge_Volts(10.0F + (float) (i % 1300U) * 0.1F);
+    });
+    Benchmark_Run("lookup_gauge_voltage_pressure", 0U, [&](uint64_t i) {
+        sum = sum + Director_Pressure_To_Gauge_Volts(-5.0F + (float) (i % 1600U) * 0.1F);
+    });
+
+    CHECK_TRUE(sum > 0.0F);
+}
+
+TEST_GROUP(PcComConfigBenchmarks) {
+    QEvt const *queue_storage[10];
+
+    void setup() final
+    {
+        qf_ctrl::MemPoolConfigs configs = {
+            {sizeof(MotorDataEvent_T), 4},
+            {sizeof(PCCOMCliDataEvent_T), 4},
+        };
+
+        memset(s_config_values, 0, sizeof(s_config_values));
+        s_data_ready_cb      = nullptr;
+        s_data_ready_cb_data = nullptr;
+
+        qf_ctrl::Setup(PUBSUB_MAX_SIG, 1000, configs, qf_ctrl::MemPoolTeardownOption::IGNORE);
+        PC_COM_ctor(&s_serial, nullptr);
+        QACTIVE_START(
+            AO_PC_COM,
+            qf_ctrl::UNIT_UNDER_TEST_PRIORITY,
+            queue_storage,
+            Q_DIM(queue_storage),
+            nullptr,
+            0,
+            nullptr);
+        qf_ctrl::ProcessEvents();
+    }
+
+    void teardown() final
+    {
+        qf_ctrl::Teardown();
+    }
+};
+
+// a framed ConfigDBGetEntryReq from the serial port to the framed ConfigEntryDataResp back
+TEST(PcComConfigBenchmarks, config_get_entry_round_trip)
+{
+    ConfigDBGetEntryReq request = ConfigDBGetEntryReq_init_zero;
+    request.entry_id            = CFG_ID_DIRECTOR_RPM_HZ;
+    Config_Write_U32(CFG_ID_DIRECTOR_RPM_HZ, 100U);
+    frame_request(MessageType_CONFIG_DB_GET_ENTRY_REQ, ConfigDBGetEntryReq_fields, &request);
+
+    serve_request();
+    size_t bytes = s_request_frame_len + s_response_frame_len;
+    CHECK_EQUAL(100U, decode_response().value.value.value_uint32);
+
+    Benchmark_Run("pc_com_config_get_entry_round_trip", bytes, [&](uint64_t) {
+        serve_request();
+    });
+    CHECK_EQUAL(bytes, s_request_frame_len + s_response_frame_len);
+}
+
+TEST(PcComConfigBenchmarks, config_set_entry_round_trip)
+{
+    ConfigDBSetEntryReq request       = ConfigDBSetEntryReq_init_zero;
+    request.entry_id                  = CFG_ID_CAN_PRESSURE_DEADBAND;
+    request.value.which_value         = ConfigValue_value_float32_tag;
+    request.value.value.value_float32 = 0.25F;
+    frame_request(MessageType_CONFIG_DB_SET_ENTRY_REQ, ConfigDBSetEntryReq_fields, &request);
+
+    serve_request();
+    size_t bytes = s_request_frame_len + s_response_frame_len;
+    DOUBLES_EQUAL(0.25, Config_Read_F32(CFG_ID_CAN_PRESSURE_DEADBAND), 0.0);
+    DOUBLES_EQUAL(0.25, decode_response().value.value.value_float32, 0.0);
+
+    Benchmark_Run("pc_com_config_set_entry_round_trip", bytes, [&](uint64_t) {
+        serve_request();
+    });
+}
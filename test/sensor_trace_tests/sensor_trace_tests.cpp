@@ -0,0 +1,266 @@
+extern "C" {
+#include "bsp_timestamp_fake.h"
+#include "filters.h"
+#include "sensor_trace.h"
+}
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "CppUTest/TestHarness.h"
+
+// the whole buffer, emptied a packet at a time the way PC_COM does
+static std::vector<uint8_t> read_all(void)
+{
+    std::vector<uint8_t> trace;
+    uint8_t chunk[192];
+    size_t length;
+
+    while ((length = Sensor_Trace_Read(chunk, sizeof(chunk))) > 0U)
+    {
+        trace.insert(trace.end(), chunk, chunk + length);
+    }
+    return trace;
+}
+
+TEST_GROUP(SensorTraceTests) {
+    Sensor_Trace_Reader_T reader;
+    Sensor_Trace_Record_T record;
+
+    void setup() final
+    {
+        BSP_TimestampFake_Reset();
+        Sensor_Trace_Start();
+    }
+
+    void teardown() final
+    {
+        Sensor_Trace_Stop();
+    }
+};
+
+TEST(SensorTraceTests, nothing_is_recorded_until_started)
+{
+    Sensor_Trace_Stop();
+    (void) read_all();
+
+    Sensor_Trace_Record(SENSOR_TRACE_TACH_PERIOD, 1234U);
+
+    CHECK_FALSE(Sensor_Trace_Is_Recording());
+    CHECK_TRUE(read_all().empty());
+}
+
+TEST(SensorTraceTests, records_read_back_with_their_time_since_the_start)
+{
+    BSP_TimestampFake_Advance_Microseconds(100U);
+    Sensor_Trace_Record(SENSOR_TRACE_TACH_PERIOD, 40000U);
+    BSP_TimestampFake_Advance_Microseconds(300000U);
+    Sensor_Trace_Record(SENSOR_TRACE_PRESSURE_COUNTS, 0xFFFFFFU);
+    Sensor_Trace_Record(SENSOR_TRACE_LMT01_COUNT, 1500U);
+    BSP_TimestampFake_Advance_Microseconds(5000000000ULL); // longer than 32 bits of us
+    Sensor_Trace_Record(SENSOR_TRACE_VBAT_MEAN, UINT32_MAX);
+
+    std::vector<uint8_t> trace = read_all();
+    CHECK_TRUE(Sensor_Trace_Reader_Init(&reader, trace.data(), trace.size()));
+
+    CHECK_TRUE(Sensor_Trace_Reader_Next(&reader, &record));
+    CHECK_EQUAL(SENSOR_TRACE_TACH_PERIOD, record.type);
+    CHECK_EQUAL(100U, record.timestamp_us);
+    CHECK_EQUAL(40000U, record.value);
+
+    CHECK_TRUE(Sensor_Trace_Reader_Next(&reader, &record));
+    CHECK_EQUAL(SENSOR_TRACE_PRESSURE_COUNTS, record.type);
+    CHECK_EQUAL(300100U, record.timestamp_us);
+    CHECK_EQUAL(0xFFFFFFU, record.value);
+
+    CHECK_TRUE(Sensor_Trace_Reader_Next(&reader, &record));
+    CHECK_EQUAL(SENSOR_TRACE_LMT01_COUNT, record.type);
+    CHECK_EQUAL(300100U, record.timestamp_us);
+    CHECK_EQUAL(1500U, record.value);
+
+    CHECK_TRUE(Sensor_Trace_Reader_Next(&reader, &record));
+    CHECK_EQUAL(SENSOR_TRACE_VBAT_MEAN, record.type);
+    CHECK_EQUAL(5000300100ULL, record.timestamp_us);
+    CHECK_EQUAL(UINT32_MAX, record.value);
+
+    CHECK_FALSE(Sensor_Trace_Reader_Next(&reader, &record));
+    CHECK_FALSE(reader.corrupt);
+}
+
+TEST(SensorTraceTests, gpio_is_only_recorded_when_it_changes)
+{
+    Sensor_Trace_Record(SENSOR_TRACE_GPIO, SENSOR_TRACE_GPIO_NEUTRAL);
+    Sensor_Trace_Record(SENSOR_TRACE_GPIO, SENSOR_TRACE_GPIO_NEUTRAL);
+    Sensor_Trace_Record(SENSOR_TRACE_GPIO, SENSOR_TRACE_GPIO_START);
+    Sensor_Trace_Record(SENSOR_TRACE_GPIO, SENSOR_TRACE_GPIO_START);
+
+    Sensor_Trace_Stats_T stats;
+    Sensor_Trace_Get_Stats(&stats);
+    CHECK_EQUAL(2U, stats.records);
+
+    // a new trace starts with the flags as they are
+    Sensor_Trace_Start();
+    Sensor_Trace_Record(SENSOR_TRACE_GPIO, SENSOR_TRACE_GPIO_START);
+
+    std::vector<uint8_t> trace = read_all();
+    CHECK_TRUE(Sensor_Trace_Reader_Init(&reader, trace.data(), trace.size()));
+    CHECK_TRUE(Sensor_Trace_Reader_Next(&reader, &record));
+    CHECK_EQUAL(SENSOR_TRACE_GPIO, record.type);
+    CHECK_EQUAL(SENSOR_TRACE_GPIO_START, record.value);
+    CHECK_FALSE(Sensor_Trace_Reader_Next(&reader, &record));
+}
+
+TEST(SensorTraceTests, records_dropped_while_full_are_counted_in_the_trace)
+{
+    Sensor_Trace_Stats_T stats;
+
+    do
+    {
+        BSP_TimestampFake_Advance_Microseconds(1000U);
+        Sensor_Trace_Record(SENSOR_TRACE_TACH_PERIOD, 40000U);
+        Sensor_Trace_Get_Stats(&stats);
+    } while (stats.lost < 3U);
+    uint32_t kept = stats.records;
+    CHECK_TRUE(stats.high_water > (SENSOR_TRACE_BUFFER_LENGTH - SENSOR_TRACE_RECORD_MAX_LEN));
+
+    std::vector<uint8_t> trace = read_all();
+    BSP_TimestampFake_Advance_Microseconds(1000U);
+    Sensor_Trace_Record(SENSOR_TRACE_LMT01_COUNT, 1500U);
+    std::vector<uint8_t> rest = read_all();
+    trace.insert(trace.end(), rest.begin(), rest.end());
+
+    CHECK_TRUE(Sensor_Trace_Reader_Init(&reader, trace.data(), trace.size()));
+    for (uint32_t i = 0U; i < kept; i++)
+    {
+        CHECK_TRUE(Sensor_Trace_Reader_Next(&reader, &record));
+        CHECK_EQUAL(SENSOR_TRACE_TACH_PERIOD, record.type);
+    }
+    uint64_t last_kept_us = record.timestamp_us;
+
+    CHECK_TRUE(Sensor_Trace_Reader_Next(&reader, &record));
+    CHECK_EQUAL(SENSOR_TRACE_LOST, record.type);
+    CHECK_EQUAL(3U, record.value);
+    CHECK_EQUAL(last_kept_us + 4000U, record.timestamp_us);
+
+    CHECK_TRUE(Sensor_Trace_Reader_Next(&reader, &record));
+    CHECK_EQUAL(SENSOR_TRACE_LMT01_COUNT, record.type);
+    CHECK_EQUAL(last_kept_us + 4000U, record.timestamp_us);
+
+    CHECK_FALSE(Sensor_Trace_Reader_Next(&reader, &record));
+    CHECK_FALSE(reader.corrupt);
+}
+
+TEST(SensorTraceTests, reader_rejects_a_foreign_file)
+{
+    const uint8_t other_version[] = {'B', 'M', 'S', 'T', SENSOR_TRACE_VERSION + 1U};
+    const uint8_t other_magic[]   = {'B', 'M', 'S', 'X', SENSOR_TRACE_VERSION};
+
+    CHECK_FALSE(Sensor_Trace_Reader_Init(&reader, other_version, sizeof(other_version)));
+    CHECK_FALSE(Sensor_Trace_Reader_Init(&reader, other_magic, 3U));
+    CHECK_FALSE(Sensor_Trace_Reader_Init(&reader, other_magic, sizeof(other_magic)));
+}
+
+TEST(SensorTraceTests, reader_stops_on_a_record_cut_short_or_of_an_unknown_type)
+{
+    uint8_t trace[SENSOR_TRACE_HEADER_LEN + 8U];
+    size_t length = Sensor_Trace_Encode_Header(trace);
+    trace[length++] = SENSOR_TRACE_TACH_PERIOD;
+    trace[length++] = 0x80U; // delta continues past the end
+
+    CHECK_TRUE(Sensor_Trace_Reader_Init(&reader, trace, length));
+    CHECK_FALSE(Sensor_Trace_Reader_Next(&reader, &record));
+    CHECK_TRUE(reader.corrupt);
+
+    length          = SENSOR_TRACE_HEADER_LEN;
+    trace[length++] = SENSOR_TRACE_TYPE_COUNT;
+    trace[length++] = 0U;
+    trace[length++] = 0U;
+
+    CHECK_TRUE(Sensor_Trace_Reader_Init(&reader, trace, length));
+    CHECK_FALSE(Sensor_Trace_Reader_Next(&reader, &record));
+    CHECK_TRUE(reader.corrupt);
+
+    // a value wider than 32 bits
+    length          = SENSOR_TRACE_HEADER_LEN;
+    trace[length++] = SENSOR_TRACE_VBAT_MEAN;
+    trace[length++] = 0U;
+    for (uint8_t i = 0U; i < 4U; i++)
+    {
+        trace[length++] = 0xFFU;
+    }
+    trace[length++] = 0x1FU;
+
+    CHECK_TRUE(Sensor_Trace_Reader_Init(&reader, trace, length));
+    CHECK_FALSE(Sensor_Trace_Reader_Next(&reader, &record));
+    CHECK_TRUE(reader.corrupt);
+}
+
+// A sea trial's worth of trace, the tach at 50 Hz, a VBAT block every 100 ms and a
+// temperature every second for 4 h, decoded and filtered the way a replay feeds the firmware
+TEST(SensorTraceTests, benchmark_decoding_a_four_hour_trace)
+{
+    static constexpr uint64_t TRACE_MS = 4ULL * 3600ULL * 1000ULL;
+
+    std::vector<uint8_t> trace(SENSOR_TRACE_HEADER_LEN);
+    uint8_t encoded[SENSOR_TRACE_RECORD_MAX_LEN];
+    uint64_t last_us = 0U;
+
+    (void) Sensor_Trace_Encode_Header(trace.data());
+    for (uint64_t ms = 0U; ms < TRACE_MS; ms += 20U)
+    {
+        uint64_t now_us = ms * 1000U;
+        size_t length   = Sensor_Trace_Encode_Record(
+            encoded, SENSOR_TRACE_TACH_PERIOD, now_us - last_us, 40000U + (uint32_t) (ms % 7U));
+        trace.insert(trace.end(), encoded, encoded + length);
+        last_us = now_us;
+
+        if ((ms % 100U) == 0U)
+        {
+            length = Sensor_Trace_Encode_Record(encoded, SENSOR_TRACE_VBAT_MEAN, 0U, 38400U);
+            trace.insert(trace.end(), encoded, encoded + length);
+        }
+        if ((ms % 1000U) == 0U)
+        {
+            length = Sensor_Trace_Encode_Record(encoded, SENSOR_TRACE_LMT01_COUNT, 0U, 1500U);
+            trace.insert(trace.end(), encoded, encoded + length);
+        }
+    }
+
+    Filter_EMA_F32_T rpm;
+    Filter_EMA_F32_Init(&rpm, 0.1F, true);
+    uint32_t records = 0U;
+
+    auto wall_start = std::chrono::steady_clock::now();
+    CHECK_TRUE(Sensor_Trace_Reader_Init(&reader, trace.data(), trace.size()));
+    while (Sensor_Trace_Reader_Next(&reader, &record))
+    {
+        records++;
+        if (record.type == SENSOR_TRACE_TACH_PERIOD)
+        {
+            // the period in ticks of the 2 MHz TIM15, to RPM as the Director does
+            float hz = 2000000.0F / (float) record.value;
+            (void) Filter_EMA_F32_Update(&rpm, hz * (60.0F / 6.666F));
+        }
+    }
+    auto wall_end = std::chrono::steady_clock::now();
+    double wall_s = std::chrono::duration<double>(wall_end - wall_start).count();
+
+    CHECK_FALSE(reader.corrupt);
+    CHECK_EQUAL((TRACE_MS / 20U) + (TRACE_MS / 100U) + (TRACE_MS / 1000U), records);
+    CHECK_EQUAL((TRACE_MS - 20U) * 1000U, reader.timestamp_us);
+    DOUBLES_EQUAL(50.0 * 60.0 / 6.666, Filter_EMA_F32_Get(&rpm), 1.0);
+
+    UT_PRINT(StringFromFormat(
+        "sensor trace: %u records, %.2f MB (%.1f B per record) decoded in %.3f s, "
+        "%.1f M records/s, %.0f x real time",
+        records,
+        (double) trace.size() / 1e6,
+        (double) trace.size() / records,
+        wall_s,
+        (double) records / wall_s / 1e6,
+        (TRACE_MS / 1000.0) / wall_s));
+
+    // generous for a debug build on a loaded CI machine, a replay must never be the bottleneck
+    CHECK_TRUE(wall_s < 2.0);
+}
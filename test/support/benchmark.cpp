@@ -0,0 +1,50 @@
+#include "benchmark.h"
+
+#include "CppUTest/TestHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+static constexpr double DEFAULT_MIN_BATCH_MS = 50.0;
+
+double Benchmark_Min_Seconds(void)
+{
+    const char *min_ms = getenv("BENCHMARKS_MIN_MS");
+    return ((min_ms != nullptr) ? atof(min_ms) : DEFAULT_MIN_BATCH_MS) / 1000.0;
+}
+
+void Benchmark_Report(
+    const char *name,
+    const Benchmark_Result_T &result,
+    size_t bytes_per_op,
+    const char *extra_fields)
+{
+    char json[512];
+    snprintf(
+        json,
+        sizeof(json),
+        "{\"benchmark\": \"%s\", \"ops\": %llu, \"ns_per_op\": %.2f, \"bytes_per_op\": %zu, "
+        "\"bytes_per_s\": %.0f%s%s}",
+        name,
+        (unsigned long long) result.ops,
+        result.elapsed_s * 1e9 / (double) result.ops,
+        bytes_per_op,
+        (double) bytes_per_op * (double) result.ops / result.elapsed_s,
+        (extra_fields != nullptr) ? ", " : "",
+        (extra_fields != nullptr) ? extra_fields : "");
+    Benchmark_Print_Json(json);
+}
+
+void Benchmark_Print_Json(const char *json)
+{
+    UT_PRINT(json);
+
+    const char *path = getenv("BENCHMARKS_JSON");
+    if (path != nullptr)
+    {
+        FILE *file = fopen(path, "a");
+        CHECK_TRUE(file != nullptr);
+        fprintf(file, "%s\n", json);
+        fclose(file);
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Host benchmark harness. A benchmark repeats its operation in doubling batches until one takes
+// at least BENCHMARKS_MIN_MS (50 ms by default), then reports one JSON object:
+//   {"benchmark": name, "ops": n, "ns_per_op": t, "bytes_per_op": b, "bytes_per_s": r, ...}
+// printed with the test output and, when BENCHMARKS_JSON names a file, appended to it one per
+// line, so runs can be kept and compared.
+
+typedef struct
+{
+    uint64_t ops;
+    double elapsed_s;
+} Benchmark_Result_T;
+
+double Benchmark_Min_Seconds(void);
+
+// extra_fields, when given, go at the end of the object, e.g. "\"frames_per_s\": 1234"
+void Benchmark_Report(
+    const char *name,
+    const Benchmark_Result_T &result,
+    size_t bytes_per_op,
+    const char *extra_fields = nullptr);
+
+// a JSON object of the benchmark's own, for what isn't a timing
+void Benchmark_Print_Json(const char *json);
+
+// operation(i) is called with i counting up, to vary its input
+template <typename Operation>
+Benchmark_Result_T Benchmark_Time(Operation operation)
+{
+    double min_s = Benchmark_Min_Seconds();
+    Benchmark_Result_T result = {1U, 0.0};
+
+    for (;;)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0U; i < result.ops; i++)
+        {
+            operation(i);
+        }
+        result.elapsed_s =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (result.elapsed_s >= min_s)
+        {
+            return result;
+        }
+        result.ops *= 2U;
+    }
+}
+
+template <typename Operation>
+void Benchmark_Run(const char *name, size_t bytes_per_op, Operation operation)
+{
+    Benchmark_Report(name, Benchmark_Time(operation), bytes_per_op);
+}
+
+#endif // BENCHMARK_H_
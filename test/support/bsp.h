@@ -14,15 +14,22 @@ extern "C" {
 #endif
 
 uint32_t BSP_Get_Milliseconds_Tick(void);
+uint64_t BSP_Get_Microseconds(void);
+uint32_t BSP_Get_Cycle_Count(void);
 void BSP_CAN_Bus_Init(void);
 int32_t BSP_CAN_Write_Msg(const CAN_Message_T *msg);
+void BSP_CAN_Get_Bus_Status(CAN_Bus_Status_T *status);
+bool BSP_CAN_Read_Tx_Event(CAN_Tx_Event_T *event);
+uint64_t BSP_CAN_Timestamp_To_Us(uint16_t timestamp);
+void BSP_CAN_Bus_Recover(void);
+void BSP_CAN_Get_Bit_Rates(CAN_Bit_Rates_T *rates);
+void BSP_CAN_Disable_Bit_Rate_Switch(void);
 
 bool BSP_Get_Neutral(void);
 bool BSP_Get_Start(void);
 bool BSP_Get_Temp_Good(void);
 bool BSP_Get_Pres_Good(void);
 bool BSP_Get_Buzzer(void);
-float BSP_ADC_Read_VBAT(void);
 
 void BSP_Gauge_SetPressure_V(float volts);
 void BSP_Gauge_SetTemperature_V(float volts);
@@ -1,5 +1,6 @@
 extern "C" {
 #include "interfaces/can_interface.h"
+#include "bsp.h"
 #include "fault_manager.h"
 }
 
@@ -9,6 +10,13 @@ static CAN_Message_T s_last_can_msg;
 static uint32_t s_can_write_count;
 static int32_t s_can_write_retval;
 static uint32_t s_can_bus_init_count;
+static uint32_t s_can_bus_recover_count;
+static CAN_Bus_State_T s_can_bus_state;
+static bool s_can_data_phase_error;
+static CAN_Tx_Event_T s_can_tx_events[3]; // the G4 TX event FIFO holds 3
+static uint32_t s_can_tx_event_count;
+static uint32_t s_can_tx_queued_us;
+static CAN_Bit_Rates_T s_can_bit_rates;
 static uint32_t s_milliseconds_tick;
 static Fault_ID_T s_last_fault_id;
 static uint32_t s_fault_count;
@@ -16,12 +24,18 @@ static uint32_t s_fault_count;
 extern "C" void BSP_BoxToBoxMock_Reset(void)
 {
     memset(&s_last_can_msg, 0, sizeof(s_last_can_msg));
-    s_can_write_count    = 0;
-    s_can_write_retval   = 0;
-    s_can_bus_init_count = 0;
-    s_milliseconds_tick  = 1234U;
-    s_last_fault_id      = FAULT_ID_NONE;
-    s_fault_count        = 0;
+    s_can_write_count       = 0;
+    s_can_write_retval      = 0;
+    s_can_bus_init_count    = 0;
+    s_can_bus_recover_count = 0;
+    s_can_bus_state         = CAN_BUS_STATE_ACTIVE;
+    s_can_data_phase_error  = false;
+    s_can_tx_event_count    = 0;
+    s_can_tx_queued_us      = 100U;
+    s_can_bit_rates         = {.nominal_bps = 1000000U, .data_bps = 4000000U, .brs = true};
+    s_milliseconds_tick     = 1234U;
+    s_last_fault_id         = FAULT_ID_NONE;
+    s_fault_count           = 0;
 }
 
 extern "C" void BSP_BoxToBoxMock_SetCanWriteRetval(int32_t retval)
@@ -29,6 +43,28 @@ extern "C" void BSP_BoxToBoxMock_SetCanWriteRetval(int32_t retval)
     s_can_write_retval = retval;
 }
 
+extern "C" void BSP_BoxToBoxMock_SetMillisecondsTick(uint32_t tick)
+{
+    s_milliseconds_tick = tick;
+}
+
+extern "C" void BSP_BoxToBoxMock_SetCanBusState(CAN_Bus_State_T state)
+{
+    s_can_bus_state = state;
+}
+
+// reported by the next bus status read only, like PSR.DLEC
+extern "C" void BSP_BoxToBoxMock_SetCanDataPhaseError(void)
+{
+    s_can_data_phase_error = true;
+}
+
+// how long each frame written from now on waited for the bus, reported by its TX event
+extern "C" void BSP_BoxToBoxMock_SetCanTxQueuedUs(uint32_t queued_us)
+{
+    s_can_tx_queued_us = queued_us;
+}
+
 extern "C" uint32_t BSP_BoxToBoxMock_GetCanWriteCount(void)
 {
     return s_can_write_count;
@@ -39,6 +75,11 @@ extern "C" uint32_t BSP_BoxToBoxMock_GetCanBusInitCount(void)
     return s_can_bus_init_count;
 }
 
+extern "C" uint32_t BSP_BoxToBoxMock_GetCanBusRecoverCount(void)
+{
+    return s_can_bus_recover_count;
+}
+
 extern "C" const CAN_Message_T *BSP_BoxToBoxMock_GetLastCanMsg(void)
 {
     return &s_last_can_msg;
@@ -68,9 +109,63 @@ extern "C" int32_t BSP_CAN_Write_Msg(const CAN_Message_T *msg)
 {
     s_can_write_count++;
     memcpy(&s_last_can_msg, msg, sizeof(s_last_can_msg));
+
+    // frames are sent as soon as they are written, a full event FIFO drops the event
+    uint32_t event_capacity = sizeof(s_can_tx_events) / sizeof(s_can_tx_events[0]);
+    if ((s_can_write_retval == 0) && (s_can_tx_event_count < event_capacity))
+    {
+        s_can_tx_events[s_can_tx_event_count++] = {
+            .id        = msg->id,
+            .dlc       = msg->dlc,
+            .queued_us = s_can_tx_queued_us,
+            .sent_us   = BSP_Get_Microseconds() + s_can_tx_queued_us,
+        };
+    }
+
     return s_can_write_retval;
 }
 
+extern "C" void BSP_CAN_Get_Bus_Status(CAN_Bus_Status_T *status)
+{
+    status->state     = s_can_bus_state;
+    status->tx_errors = (s_can_bus_state == CAN_BUS_STATE_ACTIVE) ? 0U : 128U;
+    status->rx_errors = 0U;
+
+    status->errors_logged   = 0U;
+    status->last_error      = CAN_ERROR_NO_CHANGE;
+    status->data_last_error = s_can_data_phase_error ? CAN_ERROR_BIT0 : CAN_ERROR_NO_CHANGE;
+    s_can_data_phase_error  = false;
+}
+
+extern "C" bool BSP_CAN_Read_Tx_Event(CAN_Tx_Event_T *event)
+{
+    if (s_can_tx_event_count == 0U)
+    {
+        return false;
+    }
+
+    *event = s_can_tx_events[0];
+    s_can_tx_event_count--;
+    memmove(&s_can_tx_events[0], &s_can_tx_events[1], s_can_tx_event_count * sizeof(*event));
+    return true;
+}
+
+extern "C" void BSP_CAN_Get_Bit_Rates(CAN_Bit_Rates_T *rates)
+{
+    *rates = s_can_bit_rates;
+}
+
+extern "C" void BSP_CAN_Disable_Bit_Rate_Switch(void)
+{
+    s_can_bit_rates.data_bps = s_can_bit_rates.nominal_bps;
+    s_can_bit_rates.brs      = false;
+}
+
+extern "C" void BSP_CAN_Bus_Recover(void)
+{
+    s_can_bus_recover_count++;
+}
+
 extern "C" void Fault_Manager_Generate_Fault(QActive *, Fault_ID_T id, const char *)
 {
     s_fault_count++;
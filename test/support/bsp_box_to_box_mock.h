@@ -11,8 +11,13 @@ extern "C" {
 
 void BSP_BoxToBoxMock_Reset(void);
 void BSP_BoxToBoxMock_SetCanWriteRetval(int32_t retval);
+void BSP_BoxToBoxMock_SetMillisecondsTick(uint32_t tick);
+void BSP_BoxToBoxMock_SetCanBusState(CAN_Bus_State_T state);
+void BSP_BoxToBoxMock_SetCanDataPhaseError(void);
+void BSP_BoxToBoxMock_SetCanTxQueuedUs(uint32_t queued_us);
 uint32_t BSP_BoxToBoxMock_GetCanWriteCount(void);
 uint32_t BSP_BoxToBoxMock_GetCanBusInitCount(void);
+uint32_t BSP_BoxToBoxMock_GetCanBusRecoverCount(void);
 const CAN_Message_T *BSP_BoxToBoxMock_GetLastCanMsg(void);
 uint32_t BSP_BoxToBoxMock_GetFaultCount(void);
 Fault_ID_T BSP_BoxToBoxMock_GetLastFaultId(void);
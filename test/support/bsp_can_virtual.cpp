@@ -0,0 +1,141 @@
+extern "C" {
+#include "box_to_box.h"
+#include "bsp.h"
+#include "bsp_can_virtual.h"
+#include "can_messages.h"
+#include "can_rx_ring.h"
+#include "posted_signals.h"
+#include "virtual_can_bus.h"
+}
+
+#include <cstring>
+
+// static events posted to Box_To_Box, as from the CAN interrupts
+static QEvt const s_can_frames_available_evt = QEVT_INITIALIZER(POSTED_CAN_FRAMES_AVAILABLE_SIG);
+static QEvt const s_can_tx_complete_evt      = QEVT_INITIALIZER(POSTED_CAN_TX_COMPLETE_SIG);
+static QEvt const s_can_bus_status_evt       = QEVT_INITIALIZER(POSTED_CAN_BUS_STATUS_SIG);
+
+static uint32_t s_node;
+static CAN_Tx_Event_T s_tx_events[3]; // the G4 TX event FIFO holds 3
+static uint32_t s_tx_event_count;
+static BSP_CAN_Virtual_Stats_T s_stats;
+
+// the FDCAN filters, from the message registry
+static bool filter_accepts(uint32_t id)
+{
+    for (uint32_t i = 0U; i < CAN_MSG_COUNT; i++)
+    {
+        if (CAN_Msg_Info[i].id == id)
+        {
+            return (CAN_Msg_Info[i].rx_boards & CAN_RX_THIS_BOARD) != 0U;
+        }
+    }
+    return false;
+}
+
+static void rx_callback(void *, const CAN_Message_T *frame)
+{
+    if (!filter_accepts(frame->id))
+    {
+        s_stats.rx_filtered++;
+        return;
+    }
+
+    *CAN_Rx_Ring_Reserve() = *frame;
+    CAN_Rx_Ring_Commit();
+
+    if (CAN_Rx_Ring_Notify_Needed())
+    {
+        if (!QACTIVE_POST_X(AO_BOX_TO_BOX, &s_can_frames_available_evt, 1U, nullptr))
+        {
+            CAN_Rx_Ring_Notify_Failed();
+        }
+    }
+}
+
+static void tx_callback(void *, const CAN_Tx_Event_T *event)
+{
+    if (s_tx_event_count < (sizeof(s_tx_events) / sizeof(s_tx_events[0])))
+    {
+        s_tx_events[s_tx_event_count++] = *event;
+        s_stats.tx_events++;
+    }
+    else
+    {
+        s_stats.tx_events_lost++;
+    }
+
+    (void) QACTIVE_POST_X(AO_BOX_TO_BOX, &s_can_tx_complete_evt, 2U, nullptr);
+}
+
+// a node on the bus for this board, after Virtual_CAN_Bus_Reset()
+extern "C" uint32_t BSP_CAN_Virtual_Attach(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_tx_event_count = 0U;
+    s_node           = Virtual_CAN_Bus_Add_Node(rx_callback, tx_callback, nullptr);
+    return s_node;
+}
+
+// the controller leaves the bus and raises its error status interrupt
+extern "C" void BSP_CAN_Virtual_Bus_Off(void)
+{
+    Virtual_CAN_Bus_Set_Bus_Off(s_node);
+    (void) QACTIVE_POST_X(AO_BOX_TO_BOX, &s_can_bus_status_evt, 2U, nullptr);
+}
+
+extern "C" void BSP_CAN_Virtual_Get_Stats(BSP_CAN_Virtual_Stats_T *stats)
+{
+    *stats = s_stats;
+}
+
+extern "C" void BSP_CAN_Bus_Init(void)
+{
+    s_stats.bus_inits++;
+}
+
+extern "C" int32_t BSP_CAN_Write_Msg(const CAN_Message_T *msg)
+{
+    return Virtual_CAN_Bus_Write(s_node, msg);
+}
+
+extern "C" void BSP_CAN_Get_Bus_Status(CAN_Bus_Status_T *status)
+{
+    bool bus_off = Virtual_CAN_Bus_Is_Bus_Off(s_node);
+
+    status->state           = bus_off ? CAN_BUS_STATE_OFF : CAN_BUS_STATE_ACTIVE;
+    status->tx_errors       = bus_off ? 255U : 0U;
+    status->rx_errors       = 0U;
+    status->errors_logged   = 0U;
+    status->last_error      = CAN_ERROR_NO_CHANGE;
+    status->data_last_error = CAN_ERROR_NO_CHANGE;
+}
+
+extern "C" bool BSP_CAN_Read_Tx_Event(CAN_Tx_Event_T *event)
+{
+    if (s_tx_event_count == 0U)
+    {
+        return false;
+    }
+
+    *event = s_tx_events[0];
+    s_tx_event_count--;
+    memmove(&s_tx_events[0], &s_tx_events[1], s_tx_event_count * sizeof(*event));
+    return true;
+}
+
+extern "C" void BSP_CAN_Get_Bit_Rates(CAN_Bit_Rates_T *rates)
+{
+    Virtual_CAN_Bus_Get_Bit_Rates(s_node, rates);
+}
+
+extern "C" void BSP_CAN_Disable_Bit_Rate_Switch(void)
+{
+    Virtual_CAN_Bus_Disable_Bit_Rate_Switch(s_node);
+}
+
+extern "C" void BSP_CAN_Bus_Recover(void)
+{
+    s_stats.bus_recoveries++;
+    Virtual_CAN_Bus_Recover(s_node);
+}
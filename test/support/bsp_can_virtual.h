@@ -0,0 +1,31 @@
+#ifndef BSP_CAN_VIRTUAL_H_
+#define BSP_CAN_VIRTUAL_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The BSP_CAN_* functions of one board on the virtual CAN bus, doing what its FDCAN interrupts do
+// with the frames: received ones its filters take go into the RX ring and Box_To_Box is told,
+// TX events go into a 3 deep FIFO. Compiled once per board, see motor_side_symbols.h.
+
+typedef struct
+{
+    uint32_t bus_inits;      // BSP_CAN_Bus_Init()
+    uint32_t bus_recoveries; // BSP_CAN_Bus_Recover()
+    uint32_t rx_filtered;    // frames the filters of this board don't take
+    uint32_t tx_events;      // TX events put in the FIFO
+    uint32_t tx_events_lost; // TX event FIFO full
+} BSP_CAN_Virtual_Stats_T;
+
+uint32_t BSP_CAN_Virtual_Attach(void);
+void BSP_CAN_Virtual_Bus_Off(void);
+void BSP_CAN_Virtual_Get_Stats(BSP_CAN_Virtual_Stats_T *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BSP_CAN_VIRTUAL_H_
@@ -0,0 +1,34 @@
+extern "C" {
+#include "bsp_timestamp_fake.h"
+}
+
+// start away from 0, which the firmware treats as "no sample yet"
+static constexpr uint64_t FAKE_START_US = 1000000U;
+
+static uint64_t s_now_us = FAKE_START_US;
+
+extern "C" void BSP_TimestampFake_Reset(void)
+{
+    s_now_us = FAKE_START_US;
+}
+
+extern "C" void BSP_TimestampFake_Set_Microseconds(uint64_t now_us)
+{
+    s_now_us = now_us;
+}
+
+extern "C" void BSP_TimestampFake_Advance_Microseconds(uint64_t delta_us)
+{
+    s_now_us += delta_us;
+}
+
+extern "C" uint64_t BSP_Get_Microseconds(void)
+{
+    return s_now_us;
+}
+
+// the CYCCNT stand-in, one cycle per microsecond so the tests can move it with the same calls
+extern "C" uint32_t BSP_Get_Cycle_Count(void)
+{
+    return (uint32_t) s_now_us;
+}
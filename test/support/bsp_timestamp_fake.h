@@ -0,0 +1,20 @@
+#ifndef BSP_TIMESTAMP_FAKE_H_
+#define BSP_TIMESTAMP_FAKE_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Host stand-in for the DWT based microsecond clock and cycle counter, time only moves when a test
+// moves it
+void BSP_TimestampFake_Reset(void);
+void BSP_TimestampFake_Set_Microseconds(uint64_t now_us);
+void BSP_TimestampFake_Advance_Microseconds(uint64_t delta_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BSP_TIMESTAMP_FAKE_H_
@@ -12,6 +12,18 @@ extern "C" {
 typedef enum
 {
     CFG_ID_ENGINE_MINUTES,
+    CFG_ID_DIRECTOR_FLAGS_HZ,
+    CFG_ID_DIRECTOR_RPM_HZ,
+    CFG_ID_DIRECTOR_TEMPERATURE_HZ,
+    CFG_ID_DIRECTOR_PRESSURE_HZ,
+    CFG_ID_DIRECTOR_VBAT_HZ,
+    CFG_ID_DIRECTOR_ENGINE_MINUTES_HZ,
+    CFG_ID_CAN_TEMPERATURE_DEADBAND,
+    CFG_ID_CAN_PRESSURE_DEADBAND,
+    CFG_ID_CAN_TACHOMETER_DEADBAND,
+    CFG_ID_CAN_VBAT_DEADBAND,
+    CFG_ID_CAN_HEARTBEAT_MS,
+    CFG_ID_CAN_MOTOR_DATA_VERSION,
     CFG_ID_NUM_IDS,
     CFG_ID_INVALID = CFG_ID_NUM_IDS
 } ConfigID_T;
@@ -0,0 +1,101 @@
+#ifndef MOTOR_SIDE_SYMBOLS_H_
+#define MOTOR_SIDE_SYMBOLS_H_
+
+// Both boards in one test executable. The motor's sources are compiled with MOTOR_SIDE_BUILD and
+// this header forced in first (-include), which puts Motor_ in front of every global symbol of
+// the modules that exist on both boards, so the motor's Box_To_Box, RX ring, TX queue, CAN stats
+// and BSP_CAN_* don't clash with the gauge's. The test includes it without MOTOR_SIDE_BUILD for
+// the prefixed declarations.
+//
+// The motor Director's motor data goes out on a signal of its own: the gauge only hears it over
+// CAN, and the motor's Box_To_Box doesn't send on what the gauge's republishes.
+
+#ifdef MOTOR_SIDE_BUILD
+#define AO_BOX_TO_BOX                    Motor_AO_BOX_TO_BOX
+#define Box_To_Box_ctor                  Motor_Box_To_Box_ctor
+#define Box_To_Box_Get_Stats             Motor_Box_To_Box_Get_Stats
+#define Box_To_Box_Get_Time_Sync         Motor_Box_To_Box_Get_Time_Sync
+#define Box_To_Box_Remote_To_Local_Time  Motor_Box_To_Box_Remote_To_Local_Time
+#define Box_To_Box_Get_Tunnel_IO         Motor_Box_To_Box_Get_Tunnel_IO
+#define Box_To_Box_Get_Tunnel_Stats      Motor_Box_To_Box_Get_Tunnel_Stats
+#define fault_bits                       Motor_fault_bits
+#define CAN_Rx_Ring_Init                 Motor_CAN_Rx_Ring_Init
+#define CAN_Rx_Ring_Reserve              Motor_CAN_Rx_Ring_Reserve
+#define CAN_Rx_Ring_Commit               Motor_CAN_Rx_Ring_Commit
+#define CAN_Rx_Ring_Fifo_Lost            Motor_CAN_Rx_Ring_Fifo_Lost
+#define CAN_Rx_Ring_Notify_Needed        Motor_CAN_Rx_Ring_Notify_Needed
+#define CAN_Rx_Ring_Notify_Failed        Motor_CAN_Rx_Ring_Notify_Failed
+#define CAN_Rx_Ring_Notify_Ack           Motor_CAN_Rx_Ring_Notify_Ack
+#define CAN_Rx_Ring_Pop                  Motor_CAN_Rx_Ring_Pop
+#define CAN_Rx_Ring_Get_Stats            Motor_CAN_Rx_Ring_Get_Stats
+#define CAN_Tx_Queue_Init                Motor_CAN_Tx_Queue_Init
+#define CAN_Tx_Queue_Put                 Motor_CAN_Tx_Queue_Put
+#define CAN_Tx_Queue_Front               Motor_CAN_Tx_Queue_Front
+#define CAN_Tx_Queue_Pop                 Motor_CAN_Tx_Queue_Pop
+#define CAN_Tx_Queue_Deferred            Motor_CAN_Tx_Queue_Deferred
+#define CAN_Tx_Queue_Count               Motor_CAN_Tx_Queue_Count
+#define CAN_Tx_Queue_Is_Pending          Motor_CAN_Tx_Queue_Is_Pending
+#define CAN_Tx_Queue_Get_Stats           Motor_CAN_Tx_Queue_Get_Stats
+#define CAN_Stats_Init                   Motor_CAN_Stats_Init
+#define CAN_Stats_Tx                     Motor_CAN_Stats_Tx
+#define CAN_Stats_Tx_Event               Motor_CAN_Stats_Tx_Event
+#define CAN_Stats_Rx                     Motor_CAN_Stats_Rx
+#define CAN_Stats_Rx_Age                 Motor_CAN_Stats_Rx_Age
+#define CAN_Stats_Rx_Tick                Motor_CAN_Stats_Rx_Tick
+#define CAN_Stats_Bus_Status             Motor_CAN_Stats_Bus_Status
+#define CAN_Stats_Get_Id                 Motor_CAN_Stats_Get_Id
+#define CAN_Stats_Get_Errors             Motor_CAN_Stats_Get_Errors
+#define AO_Director                      Motor_AO_Director
+#define Director_ctor                    Motor_Director_ctor
+#define BSP_CAN_Bus_Init                 Motor_BSP_CAN_Bus_Init
+#define BSP_CAN_Write_Msg                Motor_BSP_CAN_Write_Msg
+#define BSP_CAN_Get_Bus_Status           Motor_BSP_CAN_Get_Bus_Status
+#define BSP_CAN_Read_Tx_Event            Motor_BSP_CAN_Read_Tx_Event
+#define BSP_CAN_Bus_Recover              Motor_BSP_CAN_Bus_Recover
+#define BSP_CAN_Get_Bit_Rates            Motor_BSP_CAN_Get_Bit_Rates
+#define BSP_CAN_Disable_Bit_Rate_Switch  Motor_BSP_CAN_Disable_Bit_Rate_Switch
+#define BSP_CAN_Virtual_Attach           Motor_BSP_CAN_Virtual_Attach
+#define BSP_CAN_Virtual_Bus_Off          Motor_BSP_CAN_Virtual_Bus_Off
+#define BSP_CAN_Virtual_Get_Stats        Motor_BSP_CAN_Virtual_Get_Stats
+#define Fault_Manager_Generate_Fault     Motor_Fault_Manager_Generate_Fault
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// after the renames, fault_manager.h comes with it
+#include "pubsub_signals.h"
+
+enum MotorSideSignals
+{
+    MOTOR_SIDE_MOTOR_DATA_SIG = PUBSUB_MAX_SIG, // POSTED_FIRST_SIG is never sent
+    MOTOR_SIDE_MAX_PUB_SIG
+};
+
+#ifdef MOTOR_SIDE_BUILD
+#define PUBSUB_MOTOR_DATA_SIG MOTOR_SIDE_MOTOR_DATA_SIG
+#else
+#include "box_to_box.h"
+#include "bsp_can_virtual.h"
+
+extern QActive *const Motor_AO_BOX_TO_BOX;
+void Motor_Box_To_Box_ctor(void);
+void Motor_Box_To_Box_Get_Stats(Box_To_Box_Stats_T *stats);
+const Serial_IO_T *Motor_Box_To_Box_Get_Tunnel_IO(void);
+
+extern QActive *const Motor_AO_Director;
+void Motor_Director_ctor(void);
+
+uint32_t Motor_BSP_CAN_Virtual_Attach(void);
+void Motor_BSP_CAN_Virtual_Bus_Off(void);
+void Motor_BSP_CAN_Virtual_Get_Stats(BSP_CAN_Virtual_Stats_T *stats);
+
+void Motor_Fault_Manager_Generate_Fault(QActive *sender, Fault_ID_T id, const char *msg);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOTOR_SIDE_SYMBOLS_H_
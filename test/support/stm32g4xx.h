@@ -4,9 +4,15 @@
 #include "stm32g4xx_hal.h"
 #include <stdint.h>
 
+#define FDCAN_DLC_BYTES_1  1U
+#define FDCAN_DLC_BYTES_2  2U
 #define FDCAN_DLC_BYTES_5  5U
 #define FDCAN_DLC_BYTES_8  8U
+#define FDCAN_DLC_BYTES_12 9U
 #define FDCAN_DLC_BYTES_16 10U
+#define FDCAN_DLC_BYTES_20 11U
 #define FDCAN_DLC_BYTES_32 13U
+#define FDCAN_DLC_BYTES_48 14U
+#define FDCAN_DLC_BYTES_64 15U
 
 #endif // STM32G4XX_H_
@@ -0,0 +1,456 @@
+extern "C" {
+#include "virtual_can_bus.h"
+#include "can_bus_load.h"
+}
+
+#include <cstring>
+
+static constexpr uint64_t NO_EVENT_NS   = UINT64_MAX;
+static constexpr uint64_t NS_PER_SECOND = 1000000000U;
+
+struct Pending_Frame
+{
+    CAN_Message_T frame;
+    uint64_t written_ns;
+    uint32_t order; // write order, between equal IDs
+};
+
+struct Node
+{
+    Virtual_CAN_Bus_Rx_Cb_T rx_cb;
+    Virtual_CAN_Bus_Tx_Cb_T tx_cb;
+    void *context;
+    Pending_Frame tx[VIRTUAL_CAN_BUS_TX_BUFFERS];
+    uint32_t tx_count; // waiting, the one on the bus still takes a buffer
+    bool brs;
+    bool bus_off;
+    uint64_t rejoin_ns; // end of the recovery sequence, NO_EVENT_NS if none was started
+};
+
+struct Delivery
+{
+    CAN_Message_T frame;
+    uint32_t node;
+    uint64_t at_ns;
+};
+
+struct In_Flight
+{
+    bool active;
+    uint32_t node;
+    Pending_Frame pending;
+    uint64_t start_ns;
+    uint64_t end_ns;
+};
+
+static CAN_Bit_Rates_T s_rates;
+static uint64_t s_now_ns;
+static Node s_nodes[VIRTUAL_CAN_BUS_MAX_NODES];
+static uint32_t s_node_count;
+static Virtual_CAN_Bus_Hook_T s_hook;
+static In_Flight s_in_flight;
+static Delivery s_deliveries[VIRTUAL_CAN_BUS_MAX_DELIVERIES]; // in the order they were queued
+static uint32_t s_delivery_count;
+static uint32_t s_write_order;
+static uint32_t s_drop_next;
+static uint32_t s_drop_id;
+static uint32_t s_drop_id_count;
+static uint32_t s_rx_delay_ns;
+static Virtual_CAN_Bus_Stats_T s_stats;
+
+static CAN_Bit_Rates_T node_rates(uint32_t node)
+{
+    CAN_Bit_Rates_T rates = s_rates;
+    rates.brs             = s_rates.brs && s_nodes[node].brs;
+    if (!rates.brs)
+    {
+        rates.data_bps = rates.nominal_bps;
+    }
+    return rates;
+}
+
+static uint32_t tx_buffers_used(uint32_t node)
+{
+    bool on_bus = s_in_flight.active && (s_in_flight.node == node);
+    return s_nodes[node].tx_count + (on_bus ? 1U : 0U);
+}
+
+// lowest ID of the node's buffers, the FDCAN TX queue mode
+static int32_t node_next_frame(const Node *node)
+{
+    int32_t best = -1;
+
+    for (uint32_t i = 0U; i < node->tx_count; i++)
+    {
+        const Pending_Frame *pending = &node->tx[i];
+        if (
+            (best < 0) || (pending->frame.id < node->tx[best].frame.id) ||
+            ((pending->frame.id == node->tx[best].frame.id) &&
+             (pending->order < node->tx[best].order)))
+        {
+            best = (int32_t) i;
+        }
+    }
+
+    return best;
+}
+
+static void start_next_frame(void)
+{
+    if (s_in_flight.active)
+    {
+        return;
+    }
+
+    int32_t winner_node  = -1;
+    int32_t winner_frame = -1;
+    uint32_t contenders  = 0U;
+
+    for (uint32_t n = 0U; n < s_node_count; n++)
+    {
+        if (s_nodes[n].bus_off)
+        {
+            continue;
+        }
+
+        int32_t frame = node_next_frame(&s_nodes[n]);
+        if (frame < 0)
+        {
+            continue;
+        }
+
+        contenders++;
+        if (
+            (winner_node < 0) ||
+            (s_nodes[n].tx[frame].frame.id < s_nodes[winner_node].tx[winner_frame].frame.id))
+        {
+            winner_node  = (int32_t) n;
+            winner_frame = frame;
+        }
+    }
+
+    if (winner_node < 0)
+    {
+        return;
+    }
+
+    Node *node = &s_nodes[winner_node];
+    s_stats.arbitration_lost += contenders - 1U;
+
+    CAN_Bit_Rates_T rates = node_rates((uint32_t) winner_node);
+    s_in_flight.active    = true;
+    s_in_flight.node      = (uint32_t) winner_node;
+    s_in_flight.pending   = node->tx[winner_frame];
+    s_in_flight.start_ns  = s_now_ns;
+    s_in_flight.end_ns    = s_now_ns + CAN_Frame_Time_Ns(s_in_flight.pending.frame.dlc, &rates);
+
+    node->tx_count--;
+    memmove(
+        &node->tx[winner_frame],
+        &node->tx[winner_frame + 1],
+        (node->tx_count - (uint32_t) winner_frame) * sizeof(node->tx[0]));
+}
+
+static bool drop_frame(uint32_t id)
+{
+    if (s_drop_next > 0U)
+    {
+        s_drop_next--;
+        return true;
+    }
+    if ((s_drop_id_count > 0U) && (id == s_drop_id))
+    {
+        s_drop_id_count--;
+        return true;
+    }
+    return false;
+}
+
+static void finish_frame(void)
+{
+    const In_Flight sent = s_in_flight;
+    s_in_flight.active   = false;
+
+    s_stats.frames++;
+    s_stats.busy_ns += sent.end_ns - sent.start_ns;
+
+    if (drop_frame(sent.pending.frame.id))
+    {
+        s_stats.frames_dropped++;
+    }
+    else
+    {
+        for (uint32_t n = 0U; n < s_node_count; n++)
+        {
+            if ((n == sent.node) || s_nodes[n].bus_off)
+            {
+                continue;
+            }
+            if (s_delivery_count >= VIRTUAL_CAN_BUS_MAX_DELIVERIES)
+            {
+                s_stats.rx_overruns++;
+                continue;
+            }
+
+            Delivery *delivery           = &s_deliveries[s_delivery_count++];
+            delivery->frame              = sent.pending.frame;
+            delivery->frame.timestamp_us = sent.start_ns / 1000U;
+            delivery->node               = n;
+            delivery->at_ns              = sent.end_ns + s_rx_delay_ns;
+        }
+    }
+
+    // the sender sees its frame acknowledged whether or not the receivers kept it
+    CAN_Tx_Event_T event = {
+        .id        = sent.pending.frame.id,
+        .dlc       = sent.pending.frame.dlc,
+        .queued_us = (uint32_t) ((sent.start_ns - sent.pending.written_ns) / 1000U),
+        .sent_us   = sent.start_ns / 1000U,
+    };
+    Node *node = &s_nodes[sent.node];
+    if (node->tx_cb != nullptr)
+    {
+        node->tx_cb(node->context, &event);
+    }
+}
+
+static void deliver_due_frames(void)
+{
+    uint32_t i = 0U;
+
+    while (i < s_delivery_count)
+    {
+        if (s_deliveries[i].at_ns > s_now_ns)
+        {
+            i++;
+            continue;
+        }
+
+        Delivery delivery = s_deliveries[i];
+        s_delivery_count--;
+        memmove(&s_deliveries[i], &s_deliveries[i + 1], (s_delivery_count - i) * sizeof(delivery));
+
+        // the callback may queue more, which go to the end
+        Node *node = &s_nodes[delivery.node];
+        if (!node->bus_off && (node->rx_cb != nullptr))
+        {
+            node->rx_cb(node->context, &delivery.frame);
+        }
+    }
+}
+
+static uint64_t next_event_ns(void)
+{
+    uint64_t next_ns = s_in_flight.active ? s_in_flight.end_ns : NO_EVENT_NS;
+
+    for (uint32_t i = 0U; i < s_delivery_count; i++)
+    {
+        if (s_deliveries[i].at_ns < next_ns)
+        {
+            next_ns = s_deliveries[i].at_ns;
+        }
+    }
+    for (uint32_t n = 0U; n < s_node_count; n++)
+    {
+        if (s_nodes[n].rejoin_ns < next_ns)
+        {
+            next_ns = s_nodes[n].rejoin_ns;
+        }
+    }
+
+    return next_ns;
+}
+
+extern "C" void Virtual_CAN_Bus_Reset(const CAN_Bit_Rates_T *rates, uint64_t start_ns)
+{
+    memset(s_nodes, 0, sizeof(s_nodes));
+    memset(&s_in_flight, 0, sizeof(s_in_flight));
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_rates          = *rates;
+    s_now_ns         = start_ns;
+    s_node_count     = 0U;
+    s_hook           = nullptr;
+    s_delivery_count = 0U;
+    s_write_order    = 0U;
+    s_drop_next      = 0U;
+    s_drop_id        = 0U;
+    s_drop_id_count  = 0U;
+    s_rx_delay_ns    = 0U;
+}
+
+// returns the node number, VIRTUAL_CAN_BUS_MAX_NODES when the bus is full
+extern "C" uint32_t Virtual_CAN_Bus_Add_Node(
+    Virtual_CAN_Bus_Rx_Cb_T rx_cb, Virtual_CAN_Bus_Tx_Cb_T tx_cb, void *context)
+{
+    if (s_node_count >= VIRTUAL_CAN_BUS_MAX_NODES)
+    {
+        return VIRTUAL_CAN_BUS_MAX_NODES;
+    }
+
+    Node *node      = &s_nodes[s_node_count];
+    node->rx_cb     = rx_cb;
+    node->tx_cb     = tx_cb;
+    node->context   = context;
+    node->brs       = true;
+    node->rejoin_ns = NO_EVENT_NS;
+
+    return s_node_count++;
+}
+
+extern "C" void Virtual_CAN_Bus_Set_Hook(Virtual_CAN_Bus_Hook_T hook)
+{
+    s_hook = hook;
+}
+
+// 0 if the frame took a TX buffer, -1 like HAL_FDCAN_AddMessageToTxFifoQ() otherwise
+extern "C" int32_t Virtual_CAN_Bus_Write(uint32_t node, const CAN_Message_T *frame)
+{
+    Node *n = &s_nodes[node];
+
+    if (n->bus_off || (tx_buffers_used(node) >= VIRTUAL_CAN_BUS_TX_BUFFERS))
+    {
+        s_stats.writes_refused++;
+        return -1;
+    }
+
+    n->tx[n->tx_count++] = {
+        .frame      = *frame,
+        .written_ns = s_now_ns,
+        .order      = s_write_order++,
+    };
+    return 0;
+}
+
+extern "C" void Virtual_CAN_Bus_Get_Bit_Rates(uint32_t node, CAN_Bit_Rates_T *rates)
+{
+    *rates = node_rates(node);
+}
+
+extern "C" void Virtual_CAN_Bus_Disable_Bit_Rate_Switch(uint32_t node)
+{
+    s_nodes[node].brs = false;
+}
+
+/**
+ ***************************************************************************************************
+ * @brief   Move the bus to end_ns: frames start whenever it is idle, the callbacks run at the
+ *          instant they are due, then the hook. Frames written meanwhile join the next arbitration.
+ **************************************************************************************************/
+extern "C" void Virtual_CAN_Bus_Run_Until(uint64_t end_ns)
+{
+    for (;;)
+    {
+        start_next_frame();
+
+        uint64_t next_ns = next_event_ns();
+        if (next_ns > end_ns)
+        {
+            break;
+        }
+        s_now_ns = next_ns;
+
+        for (uint32_t n = 0U; n < s_node_count; n++)
+        {
+            if (s_nodes[n].rejoin_ns <= s_now_ns)
+            {
+                s_nodes[n].bus_off   = false;
+                s_nodes[n].rejoin_ns = NO_EVENT_NS;
+            }
+        }
+        if (s_in_flight.active && (s_in_flight.end_ns <= s_now_ns))
+        {
+            finish_frame();
+        }
+        deliver_due_frames();
+
+        if (s_hook != nullptr)
+        {
+            s_hook();
+        }
+    }
+
+    if (end_ns > s_now_ns)
+    {
+        s_now_ns = end_ns;
+    }
+}
+
+extern "C" uint64_t Virtual_CAN_Bus_Now_Ns(void)
+{
+    return s_now_ns;
+}
+
+extern "C" bool Virtual_CAN_Bus_Is_Idle(void)
+{
+    if (s_in_flight.active || (s_delivery_count > 0U))
+    {
+        return false;
+    }
+    for (uint32_t n = 0U; n < s_node_count; n++)
+    {
+        if (!s_nodes[n].bus_off && (s_nodes[n].tx_count > 0U))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// the next count frames on the bus are received by nobody, e.g. a full RX FIFO
+extern "C" void Virtual_CAN_Bus_Drop_Next(uint32_t count)
+{
+    s_drop_next = count;
+}
+
+extern "C" void Virtual_CAN_Bus_Drop_Id(uint32_t id, uint32_t count)
+{
+    s_drop_id       = id;
+    s_drop_id_count = count;
+}
+
+// from the end of a frame to its receivers' callbacks, e.g. a slow RX interrupt
+extern "C" void Virtual_CAN_Bus_Set_Rx_Delay_Ns(uint32_t delay_ns)
+{
+    s_rx_delay_ns = delay_ns;
+}
+
+// The node's controller leaves the bus: its waiting frames and the one it may be sending are
+// lost, it takes no writes and receives nothing until Virtual_CAN_Bus_Recover()
+extern "C" void Virtual_CAN_Bus_Set_Bus_Off(uint32_t node)
+{
+    Node *n      = &s_nodes[node];
+    n->bus_off   = true;
+    n->rejoin_ns = NO_EVENT_NS;
+
+    s_stats.frames_aborted += n->tx_count;
+    n->tx_count = 0U;
+
+    if (s_in_flight.active && (s_in_flight.node == node))
+    {
+        s_stats.frames_aborted++;
+        s_stats.busy_ns += s_now_ns - s_in_flight.start_ns;
+        s_in_flight.active = false;
+    }
+}
+
+// the recovery sequence, the node rejoins after VIRTUAL_CAN_BUS_RECOVERY_BITS at the nominal rate
+extern "C" void Virtual_CAN_Bus_Recover(uint32_t node)
+{
+    Node *n = &s_nodes[node];
+
+    if (n->bus_off && (n->rejoin_ns == NO_EVENT_NS))
+    {
+        n->rejoin_ns = s_now_ns + ((VIRTUAL_CAN_BUS_RECOVERY_BITS * NS_PER_SECOND) /
+                                   s_rates.nominal_bps);
+    }
+}
+
+extern "C" bool Virtual_CAN_Bus_Is_Bus_Off(uint32_t node)
+{
+    return s_nodes[node].bus_off;
+}
+
+extern "C" void Virtual_CAN_Bus_Get_Stats(Virtual_CAN_Bus_Stats_T *stats)
+{
+    *stats = s_stats;
+}
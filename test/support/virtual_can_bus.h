@@ -0,0 +1,67 @@
+#ifndef VIRTUAL_CAN_BUS_H_
+#define VIRTUAL_CAN_BUS_H_
+
+#include "interfaces/can_interface.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Host stand-in for the wires between the boards' FDCANs. Each node is one controller with the
+// TX buffers of the G4 in queue mode: when the bus is idle the lowest ID waiting on any node wins
+// arbitration and holds the bus for CAN_Frame_Time_Ns() at the bus rates, then every other node
+// receives it and the sender gets its TX event. Time only moves in Virtual_CAN_Bus_Run_Until().
+
+#define VIRTUAL_CAN_BUS_MAX_NODES      4U
+#define VIRTUAL_CAN_BUS_TX_BUFFERS     3U  // per node, like the FDCAN TX FIFO/queue
+#define VIRTUAL_CAN_BUS_MAX_DELIVERIES 64U // frames received and not handed to their node yet
+#define VIRTUAL_CAN_BUS_RECOVERY_BITS  (128U * 11U) // recessive bits before a bus-off node rejoins
+
+// called from within Virtual_CAN_Bus_Run_Until(), where the FDCAN interrupts would run
+typedef void (*Virtual_CAN_Bus_Rx_Cb_T)(void *context, const CAN_Message_T *frame);
+typedef void (*Virtual_CAN_Bus_Tx_Cb_T)(void *context, const CAN_Tx_Event_T *event);
+
+// after the callbacks of one instant, where QK would run the AOs the interrupts posted to
+typedef void (*Virtual_CAN_Bus_Hook_T)(void);
+
+typedef struct
+{
+    uint32_t frames;           // sent, including dropped ones
+    uint32_t arbitration_lost; // times a waiting frame lost to a lower ID on another node
+    uint32_t frames_dropped;   // sent but received by nobody, by fault injection
+    uint32_t writes_refused;   // TX buffers full or the node bus-off
+    uint32_t frames_aborted;   // waiting or on the bus when their node went bus-off
+    uint32_t rx_overruns;      // more than VIRTUAL_CAN_BUS_MAX_DELIVERIES waiting to be received
+    uint64_t busy_ns;          // bus time taken by frames
+} Virtual_CAN_Bus_Stats_T;
+
+void Virtual_CAN_Bus_Reset(const CAN_Bit_Rates_T *rates, uint64_t start_ns);
+uint32_t Virtual_CAN_Bus_Add_Node(
+    Virtual_CAN_Bus_Rx_Cb_T rx_cb, Virtual_CAN_Bus_Tx_Cb_T tx_cb, void *context);
+void Virtual_CAN_Bus_Set_Hook(Virtual_CAN_Bus_Hook_T hook);
+
+int32_t Virtual_CAN_Bus_Write(uint32_t node, const CAN_Message_T *frame);
+void Virtual_CAN_Bus_Get_Bit_Rates(uint32_t node, CAN_Bit_Rates_T *rates);
+void Virtual_CAN_Bus_Disable_Bit_Rate_Switch(uint32_t node);
+
+void Virtual_CAN_Bus_Run_Until(uint64_t end_ns);
+uint64_t Virtual_CAN_Bus_Now_Ns(void);
+bool Virtual_CAN_Bus_Is_Idle(void);
+
+// fault injection
+void Virtual_CAN_Bus_Drop_Next(uint32_t count);
+void Virtual_CAN_Bus_Drop_Id(uint32_t id, uint32_t count);
+void Virtual_CAN_Bus_Set_Rx_Delay_Ns(uint32_t delay_ns);
+void Virtual_CAN_Bus_Set_Bus_Off(uint32_t node);
+void Virtual_CAN_Bus_Recover(uint32_t node);
+bool Virtual_CAN_Bus_Is_Bus_Off(uint32_t node);
+
+void Virtual_CAN_Bus_Get_Stats(Virtual_CAN_Bus_Stats_T *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VIRTUAL_CAN_BUS_H_
@@ -0,0 +1,99 @@
+extern "C" {
+#include "time_sync.h"
+}
+
+#include <cstdint>
+
+#include "CppUTest/TestHarness.h"
+
+TEST_GROUP(TimeSyncTests) {
+    Time_Sync_T sync;
+
+    // the remote clock, started remote_start_us ahead and running drift_ppb fast
+    uint64_t remote_start_us = 5000000U;
+    int64_t drift_ppb        = 0;
+
+    void setup() final
+    {
+        Time_Sync_Init(&sync);
+    }
+
+    uint64_t remote(uint64_t local_us)
+    {
+        return remote_start_us + local_us + ((int64_t) local_us * drift_ppb) / 1000000000LL;
+    }
+
+    // request and response 200 us apart, both stamped at the start of frame on each side
+    bool exchange(uint64_t local_us)
+    {
+        uint64_t t1 = local_us;
+        uint64_t t4 = local_us + 200U;
+        return Time_Sync_Add_Exchange(&sync, t1, remote(t1), remote(t4), t4);
+    }
+};
+
+TEST(TimeSyncTests, not_synced_until_the_first_exchange)
+{
+    CHECK_FALSE(sync.synced);
+
+    CHECK_TRUE(exchange(1000000U));
+
+    CHECK_TRUE(sync.synced);
+    CHECK_EQUAL(5000000, sync.offset_us);
+    CHECK_EQUAL(0, sync.round_trip_us);
+    CHECK_EQUAL(2000000U, Time_Sync_Remote_To_Local(&sync, 7000000U));
+}
+
+TEST(TimeSyncTests, offset_is_the_mean_of_both_directions)
+{
+    // the request took 30 us longer to be stamped than the response, half of it shows as offset
+    CHECK_TRUE(Time_Sync_Add_Exchange(&sync, 1000U, 6030U, 6100U, 1100U));
+
+    CHECK_EQUAL(5015, sync.offset_us);
+    CHECK_EQUAL(30, sync.round_trip_us);
+}
+
+TEST(TimeSyncTests, exchange_with_a_wrong_stamp_is_rejected)
+{
+    CHECK_TRUE(exchange(1000000U));
+
+    // the remote turnaround is longer than the whole exchange
+    CHECK_FALSE(Time_Sync_Add_Exchange(&sync, 2000000U, 7000000U, 7000500U, 2000200U));
+
+    CHECK_EQUAL(1U, sync.exchanges);
+    CHECK_EQUAL(1U, sync.rejected);
+}
+
+TEST(TimeSyncTests, drift_is_tracked_across_exchanges)
+{
+    drift_ppb = 50000; // 50 ppm, a crystal on the wide side
+
+    for (uint64_t second = 1U; second <= 30U; second++)
+    {
+        exchange(second * 1000000U);
+    }
+
+    CHECK_EQUAL(0U, sync.steps);
+    CHECK(sync.drift_ppb > 45000);
+    CHECK(sync.drift_ppb < 55000);
+
+    // 10 s after the last exchange the remote clock is 500 us further ahead
+    uint64_t local_us = 40000000U;
+    int64_t error_us  = (int64_t) (Time_Sync_Remote_To_Local(&sync, remote(local_us)) - local_us);
+    CHECK(error_us > -10);
+    CHECK(error_us < 10);
+}
+
+TEST(TimeSyncTests, remote_restart_steps_the_offset)
+{
+    exchange(1000000U);
+    exchange(2000000U);
+
+    // the remote board reset, its clock restarted and now happens to read the same as ours
+    remote_start_us = 0U;
+    exchange(3000000U);
+
+    CHECK_EQUAL(1U, sync.steps);
+    CHECK_EQUAL(0, sync.offset_us);
+    CHECK_EQUAL(0, sync.drift_ppb);
+}
@@ -0,0 +1,284 @@
+extern "C" {
+#include "virtual_can_bus.h"
+}
+
+#include <cstdint>
+#include <vector>
+
+#include "CppUTest/TestHarness.h"
+
+static const CAN_Bit_Rates_T s_rates = {
+    .nominal_bps = 1000000U,
+    .data_bps    = 4000000U,
+    .brs         = true,
+};
+
+static constexpr uint64_t START_NS           = 1000000000U;
+static constexpr uint64_t FRAME_8_NS         = 54000U;  // 8 bytes with BRS, see can_bus_load_tests
+static constexpr uint64_t FRAME_8_NOMINAL_NS = 126000U; // 8 bytes without
+
+struct Received
+{
+    CAN_Message_T frame;
+    uint64_t at_ns;
+};
+
+struct Test_Node
+{
+    uint32_t node;
+    std::vector<Received> rx;
+    std::vector<CAN_Tx_Event_T> tx;
+    std::vector<uint64_t> tx_at_ns;
+    bool echo; // answer every frame with its ID + 1
+};
+
+static uint32_t s_hook_calls;
+
+static CAN_Message_T makeFrame(uint32_t id)
+{
+    CAN_Message_T frame = {};
+    frame.id            = id;
+    frame.dlc           = 8U;
+    frame.data[0]       = (uint8_t) id;
+    return frame;
+}
+
+static void rxCallback(void *context, const CAN_Message_T *frame)
+{
+    Test_Node *node = static_cast<Test_Node *>(context);
+    node->rx.push_back({*frame, Virtual_CAN_Bus_Now_Ns()});
+
+    if (node->echo)
+    {
+        CAN_Message_T answer = makeFrame(frame->id + 1U);
+        Virtual_CAN_Bus_Write(node->node, &answer);
+    }
+}
+
+static void txCallback(void *context, const CAN_Tx_Event_T *event)
+{
+    Test_Node *node = static_cast<Test_Node *>(context);
+    node->tx.push_back(*event);
+    node->tx_at_ns.push_back(Virtual_CAN_Bus_Now_Ns());
+}
+
+static void countHook(void)
+{
+    s_hook_calls++;
+}
+
+TEST_GROUP(VirtualCanBusTests) {
+    Test_Node a;
+    Test_Node b;
+    Test_Node c;
+
+    void setup() final
+    {
+        Virtual_CAN_Bus_Reset(&s_rates, START_NS);
+        a            = {};
+        b            = {};
+        c            = {};
+        a.node       = Virtual_CAN_Bus_Add_Node(rxCallback, txCallback, &a);
+        b.node       = Virtual_CAN_Bus_Add_Node(rxCallback, txCallback, &b);
+        c.node       = Virtual_CAN_Bus_Add_Node(rxCallback, txCallback, &c);
+        s_hook_calls = 0U;
+    }
+
+    int32_t write(Test_Node const &node, uint32_t id)
+    {
+        CAN_Message_T frame = makeFrame(id);
+        return Virtual_CAN_Bus_Write(node.node, &frame);
+    }
+
+    Virtual_CAN_Bus_Stats_T stats()
+    {
+        Virtual_CAN_Bus_Stats_T stats;
+        Virtual_CAN_Bus_Get_Stats(&stats);
+        return stats;
+    }
+};
+
+TEST(VirtualCanBusTests, frame_reaches_the_other_nodes_at_its_end_stamped_with_its_start)
+{
+    CHECK_EQUAL(0, write(a, 5U));
+    Virtual_CAN_Bus_Run_Until(START_NS + 1000000U);
+
+    CHECK_EQUAL(0U, a.rx.size());
+    CHECK_EQUAL(1U, b.rx.size());
+    CHECK_EQUAL(1U, c.rx.size());
+    CHECK_EQUAL(5U, b.rx[0].frame.id);
+    CHECK_EQUAL(5U, b.rx[0].frame.data[0]);
+    CHECK_EQUAL(START_NS + FRAME_8_NS, b.rx[0].at_ns);
+    CHECK_EQUAL(START_NS / 1000U, b.rx[0].frame.timestamp_us);
+
+    CHECK_EQUAL(1U, a.tx.size());
+    CHECK_EQUAL(5U, a.tx[0].id);
+    CHECK_EQUAL(0U, a.tx[0].queued_us);
+    CHECK_EQUAL(START_NS / 1000U, a.tx[0].sent_us);
+    CHECK_EQUAL(START_NS + FRAME_8_NS, a.tx_at_ns[0]);
+
+    CHECK_EQUAL(1U, stats().frames);
+    CHECK_EQUAL(FRAME_8_NS, stats().busy_ns);
+    CHECK_EQUAL(START_NS + 1000000U, Virtual_CAN_Bus_Now_Ns());
+    CHECK_TRUE(Virtual_CAN_Bus_Is_Idle());
+}
+
+TEST(VirtualCanBusTests, lowest_id_wins_arbitration_whatever_node_it_is_on)
+{
+    write(a, 7U);
+    write(a, 5U);
+    write(b, 6U);
+    Virtual_CAN_Bus_Run_Until(START_NS + 1000000U);
+
+    CHECK_EQUAL(3U, c.rx.size());
+    CHECK_EQUAL(5U, c.rx[0].frame.id);
+    CHECK_EQUAL(6U, c.rx[1].frame.id);
+    CHECK_EQUAL(7U, c.rx[2].frame.id);
+
+    // back to back, each starts at the end of the one before
+    CHECK_EQUAL((START_NS + FRAME_8_NS) / 1000U, c.rx[1].frame.timestamp_us);
+    CHECK_EQUAL(START_NS + (3U * FRAME_8_NS), c.rx[2].at_ns);
+
+    // 6 lost to 5, then 7 to 6
+    CHECK_EQUAL(2U, stats().arbitration_lost);
+}
+
+TEST(VirtualCanBusTests, frame_written_during_another_waits_and_reports_how_long)
+{
+    write(a, 1U);
+    Virtual_CAN_Bus_Run_Until(START_NS + 10000U);
+    write(b, 0U);
+    Virtual_CAN_Bus_Run_Until(START_NS + 1000000U);
+
+    CHECK_EQUAL(1U, b.tx.size());
+    CHECK_EQUAL((FRAME_8_NS - 10000U) / 1000U, b.tx[0].queued_us);
+    CHECK_EQUAL((START_NS + FRAME_8_NS) / 1000U, b.tx[0].sent_us);
+}
+
+TEST(VirtualCanBusTests, frame_on_the_bus_keeps_its_tx_buffer_until_it_is_sent)
+{
+    CHECK_EQUAL(0, write(a, 1U));
+    CHECK_EQUAL(0, write(a, 2U));
+    CHECK_EQUAL(0, write(a, 3U));
+    CHECK_EQUAL(-1, write(a, 4U));
+
+    Virtual_CAN_Bus_Run_Until(START_NS);
+    CHECK_FALSE(Virtual_CAN_Bus_Is_Idle());
+    CHECK_EQUAL(-1, write(a, 4U));
+
+    Virtual_CAN_Bus_Run_Until(START_NS + FRAME_8_NS);
+    CHECK_EQUAL(0, write(a, 4U));
+    CHECK_EQUAL(2U, stats().writes_refused);
+
+    // other nodes have their own buffers
+    CHECK_EQUAL(0, write(b, 5U));
+}
+
+TEST(VirtualCanBusTests, dropped_frames_are_acknowledged_but_received_by_nobody)
+{
+    Virtual_CAN_Bus_Drop_Next(1U);
+    write(a, 1U);
+    write(a, 2U);
+    Virtual_CAN_Bus_Run_Until(START_NS + 1000000U);
+
+    CHECK_EQUAL(1U, b.rx.size());
+    CHECK_EQUAL(2U, b.rx[0].frame.id);
+    CHECK_EQUAL(2U, a.tx.size());
+
+    Virtual_CAN_Bus_Drop_Id(6U, 2U);
+    write(a, 6U);
+    write(a, 7U);
+    Virtual_CAN_Bus_Run_Until(START_NS + 2000000U);
+    write(a, 6U);
+    Virtual_CAN_Bus_Run_Until(START_NS + 3000000U);
+    write(a, 6U);
+    Virtual_CAN_Bus_Run_Until(START_NS + 4000000U);
+
+    CHECK_EQUAL(3U, b.rx.size());
+    CHECK_EQUAL(7U, b.rx[1].frame.id);
+    CHECK_EQUAL(6U, b.rx[2].frame.id);
+    CHECK_EQUAL(3U, stats().frames_dropped);
+    CHECK_EQUAL(6U, stats().frames);
+}
+
+TEST(VirtualCanBusTests, rx_delay_holds_frames_back_from_their_receivers_only)
+{
+    Virtual_CAN_Bus_Set_Rx_Delay_Ns(300000U);
+    write(a, 1U);
+    Virtual_CAN_Bus_Run_Until(START_NS + FRAME_8_NS + 299999U);
+
+    CHECK_EQUAL(0U, b.rx.size());
+    CHECK_EQUAL(START_NS + FRAME_8_NS, a.tx_at_ns[0]);
+
+    Virtual_CAN_Bus_Run_Until(START_NS + 1000000U);
+    CHECK_EQUAL(1U, b.rx.size());
+    CHECK_EQUAL(START_NS + FRAME_8_NS + 300000U, b.rx[0].at_ns);
+    CHECK_EQUAL(START_NS / 1000U, b.rx[0].frame.timestamp_us);
+}
+
+TEST(VirtualCanBusTests, bus_off_node_loses_its_frames_until_it_has_recovered)
+{
+    write(a, 1U);
+    write(a, 2U);
+    Virtual_CAN_Bus_Run_Until(START_NS + 10000U);
+
+    Virtual_CAN_Bus_Set_Bus_Off(a.node);
+    CHECK_TRUE(Virtual_CAN_Bus_Is_Bus_Off(a.node));
+    CHECK_EQUAL(2U, stats().frames_aborted);
+    CHECK_EQUAL(-1, write(a, 3U));
+
+    // the bus is free for the others straight away, a hears none of it
+    write(b, 9U);
+    Virtual_CAN_Bus_Run_Until(START_NS + 1000000U);
+    CHECK_EQUAL(0U, a.rx.size());
+    CHECK_EQUAL(1U, c.rx.size());
+    CHECK_EQUAL(9U, c.rx[0].frame.id);
+    CHECK_EQUAL((START_NS + 10000U) / 1000U, c.rx[0].frame.timestamp_us);
+
+    // 128 x 11 recessive bits at 1 Mbit/s
+    Virtual_CAN_Bus_Recover(a.node);
+    Virtual_CAN_Bus_Run_Until(START_NS + 1000000U + 1407999U);
+    CHECK_TRUE(Virtual_CAN_Bus_Is_Bus_Off(a.node));
+    Virtual_CAN_Bus_Run_Until(START_NS + 1000000U + 1408000U);
+    CHECK_FALSE(Virtual_CAN_Bus_Is_Bus_Off(a.node));
+
+    CHECK_EQUAL(0, write(a, 3U));
+    Virtual_CAN_Bus_Run_Until(START_NS + 4000000U);
+    CHECK_EQUAL(1U, b.rx.size());
+    CHECK_EQUAL(3U, b.rx[0].frame.id);
+}
+
+TEST(VirtualCanBusTests, frames_written_from_a_callback_join_the_next_arbitration)
+{
+    Virtual_CAN_Bus_Set_Hook(countHook);
+    b.echo = true;
+
+    write(a, 10U);
+    Virtual_CAN_Bus_Run_Until(START_NS + 1000000U);
+
+    CHECK_EQUAL(1U, a.rx.size());
+    CHECK_EQUAL(11U, a.rx[0].frame.id);
+    CHECK_EQUAL(START_NS + (2U * FRAME_8_NS), a.rx[0].at_ns);
+
+    // the end of each frame is one instant
+    CHECK_EQUAL(2U, s_hook_calls);
+}
+
+TEST(VirtualCanBusTests, bit_rate_switch_can_be_turned_off_per_node)
+{
+    Virtual_CAN_Bus_Disable_Bit_Rate_Switch(a.node);
+
+    CAN_Bit_Rates_T rates;
+    Virtual_CAN_Bus_Get_Bit_Rates(a.node, &rates);
+    CHECK_FALSE(rates.brs);
+    CHECK_EQUAL(rates.nominal_bps, rates.data_bps);
+    Virtual_CAN_Bus_Get_Bit_Rates(b.node, &rates);
+    CHECK_TRUE(rates.brs);
+
+    write(a, 1U);
+    write(b, 2U);
+    Virtual_CAN_Bus_Run_Until(START_NS + 1000000U);
+
+    CHECK_EQUAL(START_NS + FRAME_8_NOMINAL_NS, c.rx[0].at_ns);
+    CHECK_EQUAL(START_NS + FRAME_8_NOMINAL_NS + FRAME_8_NS, c.rx[1].at_ns);
+}